@@ -0,0 +1,205 @@
+/*!
+ * \file      bench-frag.c
+ *
+ * \brief     FragDecoderProcess microbenchmarks
+ *
+ *            One operation decodes a whole fragmentation session: the
+ *            decoder initialization and the processing of the received
+ *            fragments until the file is reconstructed. The lost fragments,
+ *            uncoded or parity ones, are drawn once per session parameters.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <string.h>
+#include "utilities.h"
+#include "FragDecoder.h"
+#include "bench.h"
+
+/*!
+ * Fragments processed per batch, split into sessions
+ */
+#define BENCH_FRAG_ITERATIONS                       8000
+
+/*!
+ * Size of the fragments
+ */
+#define BENCH_FRAG_SIZE                             FRAG_MAX_SIZE
+
+static const uint16_t FragNbs[] = { 20, 100, 400 };
+
+static const int16_t LossRates[] = { 0, 5, 10, 20 };
+
+/*!
+ * Benchmark context
+ */
+typedef struct sBenchFrag
+{
+    FragDecoder_t Decoder;
+    FragDecoderCallbacks_t Callbacks;
+    uint16_t FragNb;
+    uint16_t Redundancy;
+    /*!
+     * Sent file and fragments, uncoded ones followed by the parity ones
+     */
+    uint8_t File[FRAG_MAX_NB * BENCH_FRAG_SIZE];
+    uint8_t Frags[FRAG_MAX_NB + FRAG_MAX_REDUNDANCY][BENCH_FRAG_SIZE];
+    bool IsLost[FRAG_MAX_NB + FRAG_MAX_REDUNDANCY];
+    /*!
+     * Received file
+     */
+    uint8_t RxFile[FRAG_MAX_NB * BENCH_FRAG_SIZE];
+}BenchFrag_t;
+
+static BenchFrag_t Bench;
+
+static uint8_t FragWrite( uint32_t addr, uint8_t *data, uint32_t size )
+{
+    memcpy1( Bench.RxFile + addr, data, size );
+    return 0;
+}
+
+static uint8_t FragRead( uint32_t addr, uint8_t *data, uint32_t size )
+{
+    memcpy1( data, Bench.RxFile + addr, size );
+    return 0;
+}
+
+/*
+ * Parity matrix of the fragmentation transport, as computed by the
+ * FragDecoder.c static functions
+ */
+static void SetParity( uint16_t index, uint8_t *matrixRow )
+{
+    matrixRow[index >> 3] |= 1 << ( 7 - ( index % 8 ) );
+}
+
+static bool GetParity( uint16_t index, const uint8_t *matrixRow )
+{
+    return ( ( matrixRow[index >> 3] >> ( 7 - ( index % 8 ) ) ) & 0x01 ) != 0;
+}
+
+static int32_t FragPrbs23( int32_t value )
+{
+    int32_t b0 = value & 0x01;
+    int32_t b1 = ( value & 0x20 ) >> 5;
+
+    return ( value >> 1 ) + ( ( b0 ^ b1 ) << 22 );
+}
+
+static void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t *matrixRow )
+{
+    int32_t mTemp = ( ( m & ( m - 1 ) ) == 0 ) ? 1 : 0;
+    int32_t x = 1 + ( 1001 * n );
+    int32_t r;
+
+    memset1( matrixRow, 0, ( m >> 3 ) + 1 );
+    for( int32_t nbCoeff = 0; nbCoeff < ( m >> 1 ); nbCoeff++ )
+    {
+        r = 1 << 16;
+        while( r >= m )
+        {
+            x = FragPrbs23( x );
+            r = x % ( m + mTemp );
+        }
+        SetParity( r, matrixRow );
+    }
+}
+
+/*!
+ * \brief Builds the fragments of a session and draws the lost ones
+ */
+static void BuildSession( uint16_t fragNb, int16_t lossRate )
+{
+    uint8_t matrixRow[( FRAG_MAX_NB >> 3 ) + 1];
+    RandState_t rand;
+
+    // Enough parity fragments to recover the lost ones with a margin
+    Bench.FragNb = fragNb;
+    Bench.Redundancy = ( fragNb * lossRate * 2 ) / 100 + 8;
+
+    RandInit( &rand, fragNb * 100 + lossRate );
+    for( uint32_t i = 0; i < ( fragNb * BENCH_FRAG_SIZE ); i++ )
+    {
+        Bench.File[i] = ( uint8_t )RandNext( &rand );
+    }
+    for( uint16_t i = 0; i < fragNb; i++ )
+    {
+        memcpy1( Bench.Frags[i], Bench.File + i * BENCH_FRAG_SIZE, BENCH_FRAG_SIZE );
+    }
+    for( uint16_t n = 1; n <= Bench.Redundancy; n++ )
+    {
+        uint8_t* parity = Bench.Frags[fragNb + n - 1];
+
+        FragGetParityMatrixRow( n, fragNb, matrixRow );
+        memset1( parity, 0, BENCH_FRAG_SIZE );
+        for( uint16_t i = 0; i < fragNb; i++ )
+        {
+            if( GetParity( i, matrixRow ) == true )
+            {
+                for( uint8_t j = 0; j < BENCH_FRAG_SIZE; j++ )
+                {
+                    parity[j] ^= Bench.Frags[i][j];
+                }
+            }
+        }
+    }
+    for( uint16_t i = 0; i < ( fragNb + Bench.Redundancy ); i++ )
+    {
+        Bench.IsLost[i] = RandRange( &rand, 0, 99 ) < lossRate;
+    }
+}
+
+static bool ProcessOperation( void* context, uint32_t index )
+{
+    int32_t status = FRAG_SESSION_ONGOING;
+    uint8_t frag[BENCH_FRAG_SIZE];
+
+    FragDecoderInit( &Bench.Decoder, Bench.FragNb, BENCH_FRAG_SIZE, &Bench.Callbacks );
+    for( uint16_t i = 0; ( i < ( Bench.FragNb + Bench.Redundancy ) ) && ( status < 0 ); i++ )
+    {
+        if( Bench.IsLost[i] == false )
+        {
+            // The decoder works in place on the parity fragments
+            memcpy1( frag, Bench.Frags[i], BENCH_FRAG_SIZE );
+            status = FragDecoderProcess( &Bench.Decoder, i + 1, frag );
+        }
+    }
+    return ( status >= 0 ) && ( Bench.Decoder.Status.MatrixError == 0 ) &&
+           ( memcmp( Bench.RxFile, Bench.File, Bench.FragNb * BENCH_FRAG_SIZE ) == 0 );
+}
+
+void BenchFragRun( void )
+{
+    Bench.Callbacks.FragDecoderWrite = FragWrite;
+    Bench.Callbacks.FragDecoderRead = FragRead;
+
+    for( uint8_t n = 0; n < sizeof( FragNbs ) / sizeof( FragNbs[0] ); n++ )
+    {
+        for( uint8_t l = 0; l < sizeof( LossRates ) / sizeof( LossRates[0] ); l++ )
+        {
+            BenchParams_t params =
+            {
+                .Region = NULL,
+                .Datarate = BENCH_NONE,
+                .PayloadSize = FragNbs[n] * BENCH_FRAG_SIZE,
+                .LossRate = LossRates[l],
+            };
+
+            BuildSession( FragNbs[n], LossRates[l] );
+            BenchRun( "FragDecoderProcess", &params, ProcessOperation, NULL, BenchGetIterations( BENCH_FRAG_ITERATIONS / FragNbs[n] ) );
+        }
+    }
+}
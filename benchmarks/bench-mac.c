@@ -0,0 +1,253 @@
+/*!
+ * \file      bench-mac.c
+ *
+ * \brief     Parser, serializer and frame crypto microbenchmarks
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdlib.h>
+#include "utilities.h"
+#include "aes.h"
+#include "cmac.h"
+#include "secure-element.h"
+#include "soft-se-hal.h"
+#include "LoRaMacParser.h"
+#include "LoRaMacSerializer.h"
+#include "LoRaMacCrypto.h"
+#include "bench.h"
+
+/*!
+ * Iterations of a batch
+ */
+#define BENCH_MAC_ITERATIONS                        20000
+
+#define BENCH_CRYPTO_ITERATIONS                     2000
+
+/*!
+ * Device address and session key of the benchmarked frames
+ */
+#define BENCH_DEV_ADDR                              0x26011234
+
+#define BENCH_SESSION_KEY                           { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, \
+                                                      0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C }
+
+/*!
+ * Maximum PHY layer payload size, as in LoRaMac.c
+ */
+#define BENCH_PHY_MAXPAYLOAD                        255
+
+/*!
+ * Frame payload sizes, up to the largest FRMPayload without FOpts
+ */
+static const int16_t PayloadSizes[] = { 0, 16, 51, 115, 222, 242 };
+
+#define BENCH_NB_PAYLOAD_SIZES                      ( sizeof( PayloadSizes ) / sizeof( PayloadSizes[0] ) )
+
+static const uint8_t SessionKey[16] = BENCH_SESSION_KEY;
+
+/*!
+ * Benchmark context
+ */
+typedef struct sBenchMac
+{
+    LoRaMacMessageData_t Msg;
+    uint8_t Frame[BENCH_PHY_MAXPAYLOAD];
+    uint8_t Payload[BENCH_PHY_MAXPAYLOAD];
+    uint8_t PayloadSize;
+    /*!
+     * Downlinks of the unsecure benchmark, one per operation
+     */
+    uint8_t ( *Downlinks )[BENCH_PHY_MAXPAYLOAD];
+    uint8_t DownlinkSize;
+    uint32_t FCntBase;
+}BenchMac_t;
+
+static BenchMac_t Bench;
+
+/*!
+ * Frame counters, increasing through all the benchmarks
+ */
+static uint32_t FCntUp = 0;
+static uint32_t FCntDown = 0;
+
+/*
+ * soft-se HAL, the unique identifier and random numbers are not used by the
+ * benchmarks
+ */
+void SoftSeHalGetUniqueId( uint8_t *id )
+{
+    memset1( id, 0, SE_EUI_SIZE );
+}
+
+uint32_t SoftSeHalGetRandomNumber( void )
+{
+    return 0;
+}
+
+static void PutUint32( uint8_t* buffer, uint32_t value )
+{
+    buffer[0] = ( uint8_t )value;
+    buffer[1] = ( uint8_t )( value >> 8 );
+    buffer[2] = ( uint8_t )( value >> 16 );
+    buffer[3] = ( uint8_t )( value >> 24 );
+}
+
+/*!
+ * \brief Fills the message fields of an unconfirmed data frame
+ */
+static void SetDataMessage( LoRaMacMessageData_t* msg, LoRaMacFrameType_t type, uint32_t fCnt, uint8_t* payload, uint8_t size )
+{
+    memset1( ( uint8_t* )msg, 0, sizeof( LoRaMacMessageData_t ) );
+    msg->Buffer = Bench.Frame;
+    msg->BufSize = BENCH_PHY_MAXPAYLOAD;
+    msg->MHDR.Bits.MType = type;
+    msg->FHDR.DevAddr = BENCH_DEV_ADDR;
+    msg->FHDR.FCnt = ( uint16_t )fCnt;
+    msg->FPort = 2;
+    msg->FRMPayload = payload;
+    msg->FRMPayloadSize = size;
+}
+
+/*!
+ * \brief Builds a downlink secured as by the network server, LoRaWAN 1.0.x
+ */
+static void BuildDownlink( uint32_t fCnt, uint8_t* frame )
+{
+    uint8_t payload[BENCH_PHY_MAXPAYLOAD];
+    uint8_t a[16] = { 0x01, 0, 0, 0, 0, 0x01 };
+    uint8_t b0[16] = { 0x49, 0, 0, 0, 0, 0x01 };
+    uint8_t s[16];
+    uint8_t cmac[AES_CMAC_DIGEST_LENGTH];
+    AES_CMAC_CTX cmacCtx;
+    aes_context aesCtx;
+    LoRaMacMessageData_t msg;
+
+    for( uint8_t i = 0; i < Bench.PayloadSize; i++ )
+    {
+        payload[i] = i;
+    }
+    aes_set_key( SessionKey, 16, &aesCtx );
+    PutUint32( a + 6, BENCH_DEV_ADDR );
+    PutUint32( a + 10, fCnt );
+    for( uint16_t i = 0; i < Bench.PayloadSize; i += 16 )
+    {
+        a[15] = ( i / 16 ) + 1;
+        aes_encrypt( a, s, &aesCtx );
+        for( uint8_t j = 0; ( j < 16 ) && ( ( i + j ) < Bench.PayloadSize ); j++ )
+        {
+            payload[i + j] ^= s[j];
+        }
+    }
+
+    SetDataMessage( &msg, FRAME_TYPE_DATA_UNCONFIRMED_DOWN, fCnt, payload, Bench.PayloadSize );
+    msg.Buffer = frame;
+    LoRaMacSerializerData( &msg );
+
+    PutUint32( b0 + 6, BENCH_DEV_ADDR );
+    PutUint32( b0 + 10, fCnt );
+    b0[15] = msg.BufSize - LORAMAC_MIC_FIELD_SIZE;
+    AES_CMAC_Init( &cmacCtx );
+    AES_CMAC_SetKey( &cmacCtx, SessionKey );
+    AES_CMAC_Update( &cmacCtx, b0, 16 );
+    AES_CMAC_Update( &cmacCtx, frame, msg.BufSize - LORAMAC_MIC_FIELD_SIZE );
+    AES_CMAC_Final( cmac, &cmacCtx );
+    memcpy1( frame + msg.BufSize - LORAMAC_MIC_FIELD_SIZE, cmac, LORAMAC_MIC_FIELD_SIZE );
+    Bench.DownlinkSize = msg.BufSize;
+}
+
+static bool ParserOperation( void* context, uint32_t index )
+{
+    Bench.Msg.Buffer = Bench.Frame;
+    Bench.Msg.BufSize = Bench.DownlinkSize;
+    Bench.Msg.FRMPayload = Bench.Payload;
+    return LoRaMacParserData( &Bench.Msg ) == LORAMAC_PARSER_SUCCESS;
+}
+
+static bool SerializerOperation( void* context, uint32_t index )
+{
+    SetDataMessage( &Bench.Msg, FRAME_TYPE_DATA_UNCONFIRMED_UP, index, Bench.Payload, Bench.PayloadSize );
+    return LoRaMacSerializerData( &Bench.Msg ) == LORAMAC_SERIALIZER_SUCCESS;
+}
+
+static bool SecureOperation( void* context, uint32_t index )
+{
+    SetDataMessage( &Bench.Msg, FRAME_TYPE_DATA_UNCONFIRMED_UP, FCntUp, Bench.Payload, Bench.PayloadSize );
+    return LoRaMacCryptoSecureMessage( FCntUp++, 0, 0, &Bench.Msg ) == LORAMAC_CRYPTO_SUCCESS;
+}
+
+static bool UnsecureOperation( void* context, uint32_t index )
+{
+    memset1( ( uint8_t* )&Bench.Msg, 0, sizeof( LoRaMacMessageData_t ) );
+    Bench.Msg.Buffer = Bench.Downlinks[index];
+    Bench.Msg.BufSize = Bench.DownlinkSize;
+    Bench.Msg.FRMPayload = Bench.Payload;
+    return LoRaMacCryptoUnsecureMessage( UNICAST_DEV_ADDR, BENCH_DEV_ADDR, FCNT_DOWN, Bench.FCntBase + index, &Bench.Msg ) == LORAMAC_CRYPTO_SUCCESS;
+}
+
+static void InitCrypto( void )
+{
+    Version_t version = { .Fields.Major = 1, .Fields.Minor = 0, .Fields.Patch = 4 };
+    static const KeyIdentifier_t sessionKeys[] = { F_NWK_S_INT_KEY, S_NWK_S_INT_KEY, NWK_S_ENC_KEY, APP_S_KEY };
+
+    SecureElementInit( NULL );
+    LoRaMacCryptoInit( NULL );
+    LoRaMacCryptoSetLrWanVersion( version );
+    for( uint8_t i = 0; i < sizeof( sessionKeys ) / sizeof( sessionKeys[0] ); i++ )
+    {
+        LoRaMacCryptoSetKey( sessionKeys[i], ( uint8_t* )SessionKey );
+    }
+}
+
+void BenchMacRun( void )
+{
+    uint32_t macIterations = BenchGetIterations( BENCH_MAC_ITERATIONS );
+    uint32_t cryptoIterations = BenchGetIterations( BENCH_CRYPTO_ITERATIONS );
+
+    InitCrypto( );
+    Bench.Downlinks = malloc( ( size_t )BENCH_NB_BATCHES * cryptoIterations * BENCH_PHY_MAXPAYLOAD );
+
+    for( uint8_t p = 0; p < BENCH_NB_PAYLOAD_SIZES; p++ )
+    {
+        BenchParams_t params =
+        {
+            .Region = NULL,
+            .Datarate = BENCH_NONE,
+            .PayloadSize = PayloadSizes[p],
+            .LossRate = BENCH_NONE,
+        };
+
+        Bench.PayloadSize = ( uint8_t )PayloadSizes[p];
+        for( uint8_t i = 0; i < Bench.PayloadSize; i++ )
+        {
+            Bench.Payload[i] = i;
+        }
+
+        BuildDownlink( 1, Bench.Frame );
+        BenchRun( "LoRaMacParserData", &params, ParserOperation, NULL, macIterations );
+        BenchRun( "LoRaMacSerializerData", &params, SerializerOperation, NULL, macIterations );
+        BenchRun( "LoRaMacCryptoSecureMessage", &params, SecureOperation, NULL, cryptoIterations );
+
+        // The downlink counter must increase, one frame per operation
+        Bench.FCntBase = FCntDown + 1;
+        for( uint32_t i = 0; i < ( BENCH_NB_BATCHES * cryptoIterations ); i++ )
+        {
+            BuildDownlink( Bench.FCntBase + i, Bench.Downlinks[i] );
+        }
+        FCntDown += BENCH_NB_BATCHES * cryptoIterations;
+        BenchRun( "LoRaMacCryptoUnsecureMessage", &params, UnsecureOperation, NULL, cryptoIterations );
+    }
+    free( Bench.Downlinks );
+}
@@ -0,0 +1,183 @@
+/*!
+ * \file      bench-region.c
+ *
+ * \brief     Channel selection and time on air microbenchmarks
+ *
+ *            RegionNextChannel is the entry point of
+ *            RegionCommonIdentifyChannels. It runs with the default channels
+ *            of each region, joined and without duty cycle restriction.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "utilities.h"
+#include "rtc-board.h"
+#include "radio.h"
+#include "Region.h"
+#include "bench.h"
+
+/*!
+ * Iterations of a batch
+ */
+#define BENCH_NEXT_CHANNEL_ITERATIONS               100000
+
+#define BENCH_TIME_ON_AIR_ITERATIONS                1000000
+
+/*!
+ * Frame size of the channel selection, MAC header and 7 bytes payload
+ */
+#define BENCH_NEXT_CHANNEL_PKT_LEN                  20
+
+/*!
+ * Benchmarked regions. KR920 is left out, its channel selection performs
+ * the listen before talk. The datarates run from DR0 to the highest LoRa
+ * datarate of the default channels.
+ */
+static const struct
+{
+    LoRaMacRegion_t Region;
+    const char* Name;
+    int8_t MaxDatarate;
+}Regions[] =
+{
+    { LORAMAC_REGION_AS923, "AS923", DR_5 },
+    { LORAMAC_REGION_AU915, "AU915", DR_6 },
+    { LORAMAC_REGION_CN470, "CN470", DR_5 },
+    { LORAMAC_REGION_EU868, "EU868", DR_5 },
+    { LORAMAC_REGION_IN865, "IN865", DR_5 },
+    { LORAMAC_REGION_RU864, "RU864", DR_5 },
+    { LORAMAC_REGION_US915, "US915", DR_4 },
+};
+
+static const int16_t PayloadSizes[] = { 0, 16, 51, 115, 222, 242 };
+
+/*!
+ * Benchmark context
+ */
+typedef struct sBenchRegion
+{
+    LoRaMacRegion_t Region;
+    NextChanParams_t NextChan;
+    uint32_t SpreadingFactor;
+    uint8_t PayloadSize;
+    /*!
+     * Accumulated results, keep the compiler from discarding the operations
+     */
+    volatile uint32_t Sum;
+}BenchRegion_t;
+
+static BenchRegion_t Bench;
+
+/*
+ * RTC calendar and backup registers, completing the simulated board of
+ * tools/sx126x-bench. The system time stays at 0.
+ */
+uint32_t RtcGetCalendarTime( uint16_t *milliseconds )
+{
+    *milliseconds = 0;
+    return 0;
+}
+
+void RtcBkupWrite( uint32_t data0, uint32_t data1 )
+{
+}
+
+void RtcBkupRead( uint32_t* data0, uint32_t* data1 )
+{
+    *data0 = 0;
+    *data1 = 0;
+}
+
+static bool NextChannelOperation( void* context, uint32_t index )
+{
+    uint8_t channel = 0;
+    TimerTime_t time = 0;
+    TimerTime_t aggregatedTimeOff = 0;
+
+    if( RegionNextChannel( Bench.Region, &Bench.NextChan, &channel, &time, &aggregatedTimeOff ) != LORAMAC_STATUS_OK )
+    {
+        return false;
+    }
+    Bench.Sum += channel;
+    return true;
+}
+
+static bool TimeOnAirOperation( void* context, uint32_t index )
+{
+    // Bandwidth 125 kHz, coding rate 4/5, 8 symbols preamble, explicit header
+    Bench.Sum += Radio.TimeOnAir( MODEM_LORA, 0, Bench.SpreadingFactor, 1, 8, false, Bench.PayloadSize, true );
+    return true;
+}
+
+static void RunNextChannel( void )
+{
+    uint32_t iterations = BenchGetIterations( BENCH_NEXT_CHANNEL_ITERATIONS );
+
+    for( uint8_t r = 0; r < sizeof( Regions ) / sizeof( Regions[0] ); r++ )
+    {
+        InitDefaultsParams_t initDefaults = { .NvmCtx = NULL, .Type = INIT_TYPE_DEFAULTS };
+
+        Bench.Region = Regions[r].Region;
+        RegionInitDefaults( Bench.Region, &initDefaults );
+
+        for( int8_t dr = DR_0; dr <= Regions[r].MaxDatarate; dr++ )
+        {
+            BenchParams_t params =
+            {
+                .Region = Regions[r].Name,
+                .Datarate = dr,
+                .PayloadSize = BENCH_NEXT_CHANNEL_PKT_LEN,
+                .LossRate = BENCH_NONE,
+            };
+
+            memset1( ( uint8_t* )&Bench.NextChan, 0, sizeof( NextChanParams_t ) );
+            Bench.NextChan.Datarate = dr;
+            Bench.NextChan.Joined = true;
+            Bench.NextChan.DutyCycleEnabled = false;
+            Bench.NextChan.PktLen = BENCH_NEXT_CHANNEL_PKT_LEN;
+            BenchRun( "RegionNextChannel", &params, NextChannelOperation, NULL, iterations );
+        }
+    }
+}
+
+static void RunTimeOnAir( void )
+{
+    uint32_t iterations = BenchGetIterations( BENCH_TIME_ON_AIR_ITERATIONS );
+
+    // EU868 DR0 to DR5, SF12 to SF7
+    for( int8_t dr = 0; dr <= 5; dr++ )
+    {
+        for( uint8_t p = 0; p < sizeof( PayloadSizes ) / sizeof( PayloadSizes[0] ); p++ )
+        {
+            BenchParams_t params =
+            {
+                .Region = "EU868",
+                .Datarate = dr,
+                .PayloadSize = PayloadSizes[p],
+                .LossRate = BENCH_NONE,
+            };
+
+            Bench.SpreadingFactor = 12 - dr;
+            Bench.PayloadSize = ( uint8_t )PayloadSizes[p];
+            BenchRun( "RadioTimeOnAir", &params, TimeOnAirOperation, NULL, iterations );
+        }
+    }
+}
+
+void BenchRegionRun( void )
+{
+    RunNextChannel( );
+    RunTimeOnAir( );
+}
@@ -0,0 +1,112 @@
+/*!
+ * \file      bench.h
+ *
+ * \brief     Host microbenchmarks runner
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Number of measured batches. The median batch is reported.
+ */
+#define BENCH_NB_BATCHES                            5
+
+/*!
+ * Parameter not applicable to a benchmark
+ */
+#define BENCH_NONE                                  -1
+
+/*!
+ * Benchmark parameters
+ */
+typedef struct sBenchParams
+{
+    /*!
+     * Region name, NULL when not applicable
+     */
+    const char* Region;
+    int16_t Datarate;
+    int16_t PayloadSize;
+    /*!
+     * Lost fragments, percent
+     */
+    int16_t LossRate;
+}BenchParams_t;
+
+/*!
+ * Measured operation
+ *
+ * \param [IN] context Benchmark context
+ * \param [IN] index   Index of the operation in the whole measurement, from 0
+ *                     to BENCH_NB_BATCHES * iterations - 1
+ *
+ * \retval status [true: success, false: the operation failed]
+ */
+typedef bool ( *BenchOperation_t )( void* context, uint32_t index );
+
+/*!
+ * \brief Gets the number of iterations of a batch
+ *
+ * \param [IN] iterations Default number of iterations of the benchmark
+ *
+ * \retval iterations Number of iterations scaled by the command line factor
+ */
+uint32_t BenchGetIterations( uint32_t iterations );
+
+/*!
+ * \brief Measures an operation and prints the result
+ *
+ * \param [IN] name       Benchmark name
+ * \param [IN] params     Benchmark parameters
+ * \param [IN] operation  Measured operation
+ * \param [IN] context    Operation context
+ * \param [IN] iterations Number of operations per batch, see
+ *                        \ref BenchGetIterations
+ */
+void BenchRun( const char* name, const BenchParams_t* params, BenchOperation_t operation, void* context, uint32_t iterations );
+
+/*!
+ * \brief Runs the LoRaMacParserData, LoRaMacSerializerData,
+ *        LoRaMacCryptoSecureMessage and LoRaMacCryptoUnsecureMessage
+ *        benchmarks
+ */
+void BenchMacRun( void );
+
+/*!
+ * \brief Runs the RegionNextChannel and RadioTimeOnAir benchmarks
+ */
+void BenchRegionRun( void );
+
+/*!
+ * \brief Runs the FragDecoderProcess benchmarks
+ */
+void BenchFragRun( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __BENCH_H__
@@ -0,0 +1,182 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host microbenchmarks of the LoRaMAC hot paths.
+ *
+ *            Measures the parser, the serializer, the frame crypto, the region
+ *            channel selection, the radio time on air and the fragmentation
+ *            decoder for several payload sizes, regions, data rates and loss
+ *            rates. Each benchmark runs BENCH_NB_BATCHES batches and reports
+ *            the median time per operation in ns, as CSV or JSON, for
+ *            regression tracking.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+/*!
+ * Output formats
+ */
+typedef enum eBenchFormat
+{
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON,
+}BenchFormat_t;
+
+static BenchFormat_t Format = BENCH_FORMAT_CSV;
+
+/*!
+ * Iterations scale factor, percent
+ */
+static uint32_t Scale = 100;
+
+/*!
+ * Number of printed results
+ */
+static uint32_t NbResults = 0;
+
+/*!
+ * Number of benchmarks whose operation failed
+ */
+static uint32_t NbFailures = 0;
+
+static uint64_t GetTimeNs( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( uint64_t )now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static int CompareDouble( const void* a, const void* b )
+{
+    double x = *( const double* )a;
+    double y = *( const double* )b;
+
+    return ( x > y ) - ( x < y );
+}
+
+static void PrintParam( int16_t value, bool isLast )
+{
+    const char* separator = ( Format == BENCH_FORMAT_JSON ) ? ", " : ",";
+
+    if( value == BENCH_NONE )
+    {
+        printf( "%s%s", ( Format == BENCH_FORMAT_JSON ) ? "null" : "", isLast ? "" : separator );
+    }
+    else
+    {
+        printf( "%d%s", value, isLast ? "" : separator );
+    }
+}
+
+uint32_t BenchGetIterations( uint32_t iterations )
+{
+    iterations = ( uint32_t )( ( uint64_t )iterations * Scale / 100 );
+    return ( iterations == 0 ) ? 1 : iterations;
+}
+
+void BenchRun( const char* name, const BenchParams_t* params, BenchOperation_t operation, void* context, uint32_t iterations )
+{
+    double batches[BENCH_NB_BATCHES];
+    bool isSuccess = true;
+
+    for( uint8_t b = 0; b < BENCH_NB_BATCHES; b++ )
+    {
+        uint64_t start = GetTimeNs( );
+
+        for( uint32_t i = 0; i < iterations; i++ )
+        {
+            if( operation( context, b * iterations + i ) == false )
+            {
+                isSuccess = false;
+            }
+        }
+        batches[b] = ( double )( GetTimeNs( ) - start ) / iterations;
+    }
+    qsort( batches, BENCH_NB_BATCHES, sizeof( double ), CompareDouble );
+    if( isSuccess == false )
+    {
+        NbFailures++;
+    }
+
+    if( Format == BENCH_FORMAT_JSON )
+    {
+        printf( "%s  { \"benchmark\": \"%s\", \"region\": ", ( NbResults == 0 ) ? "" : ",\n", name );
+        printf( ( params->Region != NULL ) ? "\"%s\"" : "null", ( params->Region != NULL ) ? params->Region : "" );
+        printf( ", \"dr\": " );
+        PrintParam( params->Datarate, false );
+        printf( "\"payload\": " );
+        PrintParam( params->PayloadSize, false );
+        printf( "\"loss_pct\": " );
+        PrintParam( params->LossRate, false );
+        printf( "\"iterations\": %u, \"ns_per_op\": %.1f, \"ok\": %s }", iterations, batches[BENCH_NB_BATCHES / 2],
+                isSuccess ? "true" : "false" );
+    }
+    else
+    {
+        printf( "%s,%s,", name, ( params->Region != NULL ) ? params->Region : "" );
+        PrintParam( params->Datarate, false );
+        PrintParam( params->PayloadSize, false );
+        PrintParam( params->LossRate, false );
+        printf( "%u,%.1f,%u\n", iterations, batches[BENCH_NB_BATCHES / 2], isSuccess ? 1 : 0 );
+    }
+    NbResults++;
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: benchmarks [csv|json] [iterations scale, percent]
+ */
+int main( int argc, char *argv[] )
+{
+    if( ( argc > 1 ) && ( strcmp( argv[1], "json" ) == 0 ) )
+    {
+        Format = BENCH_FORMAT_JSON;
+    }
+    if( argc > 2 )
+    {
+        Scale = strtoul( argv[2], NULL, 0 );
+    }
+
+    if( Format == BENCH_FORMAT_JSON )
+    {
+        printf( "[\n" );
+    }
+    else
+    {
+        printf( "benchmark,region,dr,payload,loss_pct,iterations,ns_per_op,ok\n" );
+    }
+    BenchMacRun( );
+    BenchRegionRun( );
+    BenchFragRun( );
+    if( Format == BENCH_FORMAT_JSON )
+    {
+        printf( "\n]\n" );
+    }
+
+    if( NbFailures != 0 )
+    {
+        fprintf( stderr, "%u benchmarks failed\n", NbFailures );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -621,6 +621,7 @@ static void McpsConfirm( McpsConfirm_t *mcpsConfirm )
         TimerStart( &Led1Timer );
     }
     MibRequestConfirm_t mibGet;
+    ChannelParams_t channel;
     MibRequestConfirm_t mibReq;
 
     mibReq.Type = MIB_DEVICE_CLASS;
@@ -650,10 +651,9 @@ static void McpsConfirm( McpsConfirm_t *mcpsConfirm )
     printf( "\n" );
     printf( "DATA RATE   : DR_%d\n", mcpsConfirm->Datarate );
 
-    mibGet.Type  = MIB_CHANNELS;
-    if( LoRaMacMibGetRequestConfirm( &mibGet ) == LORAMAC_STATUS_OK )
+    if( LoRaMacChannelGet( mcpsConfirm->Channel, &channel ) == LORAMAC_STATUS_OK )
     {
-        printf( "U/L FREQ    : %lu\n", mibGet.Param.ChannelList[mcpsConfirm->Channel].Frequency );
+        printf( "U/L FREQ    : %lu\n", channel.Frequency );
     }
 
     printf( "TX POWER    : %d\n", mcpsConfirm->TxPower );
@@ -27,6 +27,7 @@
 #include <stdbool.h>
 #include "utilities.h"
 #include "timer.h"
+#include "lpm-board.h"
 #include "Commissioning.h"
 #include "NvmCtxMgmt.h"
 #include "LmHandler.h"
@@ -137,6 +138,32 @@ static LoRaMAcHandlerBeaconParams_t BeaconParams =
  */
 static bool IsClassBSwitchPending = false;
 
+/*!
+ * Rate control engine used while the ADR is off
+ */
+static const LoRaMacRateControl_t *RateControl = NULL;
+
+/*!
+ * Context of the rate control engine instance
+ */
+static void *RateControlCtx = NULL;
+
+/*!
+ * Set while the TX power selected by the rate control engine is applied
+ */
+static bool IsRateControlTxPowerSet = false;
+
+/*!
+ * TX power to restore when the rate control engine stops selecting it
+ */
+static int8_t RateControlSavedTxPower = 0;
+
+/*!
+ * \brief   Restores the TX power in use before the rate control engine
+ *          selected it
+ */
+static void RateControlRestoreTxPower( void );
+
 /*!
  * \brief   MCPS-Confirm event function
  *
@@ -183,6 +210,15 @@ static LmHandlerErrorStatus_t LmHandlerDeviceTimeReq( void );
  */
 static LmHandlerErrorStatus_t LmHandlerBeaconReq( void );
 
+/*!
+ * Gets the next LoRaMac deadline for the low power manager
+ *
+ * \param [OUT] deadline Next deadline
+ *
+ * \retval status Returns false when the LoRaMac has no deadline
+ */
+static bool LmHandlerGetNextDeadline( LpmDeadline_t* deadline );
+
 /*
  *=============================================================================
  * PACKAGES HANDLING
@@ -194,8 +230,52 @@ typedef enum PackageNotifyTypes_e
     PACKAGE_MCPS_INDICATION,
     PACKAGE_MLME_CONFIRM,
     PACKAGE_MLME_INDICATION,
+    PACKAGE_NOTIFY_TYPES_NB,
 }PackageNotifyTypes_t;
 
+/*!
+ * Packages subscribed to a notification type, in package identifier order
+ */
+typedef struct PackageSubscribers_s
+{
+    /*!
+     * Identifiers of the packages implementing the notification callback
+     */
+    uint8_t Ids[PKG_MAX_NUMBER];
+    /*!
+     * Ports of the packages, only used by PACKAGE_MCPS_INDICATION
+     */
+    uint8_t Ports[PKG_MAX_NUMBER];
+    uint8_t NbIds;
+}PackageSubscribers_t;
+
+/*!
+ * Subscribers of each notification type. Rebuilt when a package is registered.
+ */
+static PackageSubscribers_t PackageSubscribers[PACKAGE_NOTIFY_TYPES_NB];
+
+#if( PKG_MAX_NUMBER > 32 )
+#error "PKG_MAX_NUMBER must not exceed 32"
+#endif
+
+/*!
+ * Packages having requested a Process call, one bit per package identifier
+ */
+static volatile uint32_t PackagesProcessPending = 0;
+
+/*!
+ * Rebuilds the subscribers of each notification type from the registered
+ * packages.
+ */
+static void LmHandlerPackagesUpdateSubscribers( void );
+
+/*!
+ * Requests LmHandlerProcess to call the Process function of a package.
+ *
+ * \param [IN] id Package identifier
+ */
+static void LmHandlerPackageProcessRequest( uint8_t id );
+
 /*!
  * Notifies the package to process the LoRaMac callbacks.
  *
@@ -217,6 +297,9 @@ LmHandlerErrorStatus_t LmHandlerInit( LmHandlerCallbacks_t *handlerCallbacks,
     MibRequestConfirm_t mibReq;
     LmHandlerParams = handlerParams;
     LmHandlerCallbacks = handlerCallbacks;
+    RateControl = NULL;
+    RateControlCtx = NULL;
+    IsRateControlTxPowerSet = false;
 
     LoRaMacPrimitives.MacMcpsConfirm = McpsConfirm;
     LoRaMacPrimitives.MacMcpsIndication = McpsIndication;
@@ -288,6 +371,9 @@ LmHandlerErrorStatus_t LmHandlerInit( LmHandlerCallbacks_t *handlerCallbacks,
 
     LoRaMacStart( );
 
+    // Let the low power manager select the deepest mode meeting the LoRaMac timing
+    LpmSetDeadlineCallback( LmHandlerGetNextDeadline );
+
     mibReq.Type = MIB_NETWORK_ACTIVATION;
     if( LoRaMacMibGetRequestConfirm( &mibReq ) == LORAMAC_STATUS_OK )
     {
@@ -414,6 +500,9 @@ LmHandlerErrorStatus_t LmHandlerSend( LmHandlerAppData_t *appData, LmHandlerMsgT
     LoRaMacStatus_t status;
     McpsReq_t mcpsReq;
     LoRaMacTxInfo_t txInfo;
+    MibRequestConfirm_t mibReq;
+    int8_t datarate = LmHandlerParams->TxDatarate;
+    int8_t txPower = 0;
 
     if( LmHandlerJoinStatus( ) != LORAMAC_HANDLER_SET )
     {
@@ -427,7 +516,32 @@ LmHandlerErrorStatus_t LmHandlerSend( LmHandlerAppData_t *appData, LmHandlerMsgT
         return LORAMAC_HANDLER_ERROR;
     }
 
-    mcpsReq.Req.Unconfirmed.Datarate = LmHandlerParams->TxDatarate;
+    if( ( LmHandlerParams->AdrEnable == false ) && ( RateControl != NULL ) &&
+        ( RateControl->GetNext( RateControlCtx, &datarate, &txPower ) == true ) )
+    {
+        // Applied ahead of the request for LoRaMacQueryTxPossible
+        mibReq.Type = MIB_CHANNELS_DATARATE;
+        mibReq.Param.ChannelsDatarate = datarate;
+        LoRaMacMibSetRequestConfirm( &mibReq );
+
+        if( IsRateControlTxPowerSet == false )
+        {
+            mibReq.Type = MIB_CHANNELS_TX_POWER;
+            LoRaMacMibGetRequestConfirm( &mibReq );
+            RateControlSavedTxPower = mibReq.Param.ChannelsTxPower;
+            IsRateControlTxPowerSet = true;
+        }
+        mibReq.Type = MIB_CHANNELS_TX_POWER;
+        mibReq.Param.ChannelsTxPower = txPower;
+        LoRaMacMibSetRequestConfirm( &mibReq );
+    }
+    else
+    {
+        // The engine doesn't select the TX power of this uplink
+        RateControlRestoreTxPower( );
+    }
+
+    mcpsReq.Req.Unconfirmed.Datarate = datarate;
     if( LoRaMacQueryTxPossible( appData->BufferSize, &txInfo ) != LORAMAC_STATUS_OK )
     {
         // Send empty frame in order to flush MAC commands
@@ -454,7 +568,7 @@ LmHandlerErrorStatus_t LmHandlerSend( LmHandlerAppData_t *appData, LmHandlerMsgT
     }
 
     TxParams.AppData = *appData;
-    TxParams.Datarate = LmHandlerParams->TxDatarate;
+    TxParams.Datarate = datarate;
 
     status = LoRaMacMcpsRequest( &mcpsReq );
     LmHandlerCallbacks->OnMacMcpsRequest( status, &mcpsReq, mcpsReq.ReqReturn.DutyCycleWaitTime );
@@ -509,6 +623,21 @@ static LmHandlerErrorStatus_t LmHandlerBeaconReq( void )
     }
 }
 
+static bool LmHandlerGetNextDeadline( LpmDeadline_t* deadline )
+{
+    LoRaMacDeadline_t macDeadline;
+
+    if( ( LoRaMacGetNextDeadline( &macDeadline ) != LORAMAC_STATUS_OK ) ||
+        ( macDeadline.Owner == LORAMAC_DEADLINE_NONE ) )
+    {
+        return false;
+    }
+    deadline->Time = macDeadline.Time;
+    deadline->LeadTime = macDeadline.LeadTime;
+    deadline->CanRunLate = macDeadline.CanRunLate;
+    return true;
+}
+
 LmHandlerErrorStatus_t LmHandlerPingSlotReq( uint8_t periodicity )
 {
     LoRaMacStatus_t status;
@@ -644,6 +773,37 @@ LmHandlerErrorStatus_t LmHandlerSetSystemMaxRxError( uint32_t maxErrorInMs )
     return LORAMAC_HANDLER_SUCCESS;
 }
 
+LmHandlerErrorStatus_t LmHandlerSetRateControl( const LoRaMacRateControl_t *rateControl, void *ctx )
+{
+    if( ( LmHandlerParams == NULL ) || ( ( rateControl != NULL ) && ( ctx == NULL ) ) )
+    {
+        return LORAMAC_HANDLER_ERROR;
+    }
+    // The TX power of the previous engine isn't kept
+    RateControlRestoreTxPower( );
+    if( rateControl != NULL )
+    {
+        rateControl->Init( ctx, LmHandlerParams->Region );
+    }
+    RateControl = rateControl;
+    RateControlCtx = ctx;
+    return LORAMAC_HANDLER_SUCCESS;
+}
+
+static void RateControlRestoreTxPower( void )
+{
+    MibRequestConfirm_t mibReq;
+
+    if( IsRateControlTxPowerSet == false )
+    {
+        return;
+    }
+    mibReq.Type = MIB_CHANNELS_TX_POWER;
+    mibReq.Param.ChannelsTxPower = RateControlSavedTxPower;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+    IsRateControlTxPowerSet = false;
+}
+
 /*
  *=============================================================================
  * LORAMAC NOTIFICATIONS HANDLING
@@ -660,6 +820,13 @@ static void McpsConfirm( McpsConfirm_t *mcpsConfirm )
     TxParams.Channel = mcpsConfirm->Channel;
     TxParams.AckReceived = mcpsConfirm->AckReceived;
 
+    if( ( RateControl != NULL ) &&
+        ( ( mcpsConfirm->Status == LORAMAC_EVENT_INFO_STATUS_OK ) || ( mcpsConfirm->Status == LORAMAC_EVENT_INFO_STATUS_ERROR ) ) )
+    {
+        RateControl->OnUplinkDone( RateControlCtx, mcpsConfirm->Datarate, mcpsConfirm->TxPower, mcpsConfirm->McpsRequest == MCPS_CONFIRMED,
+                                   mcpsConfirm->AckReceived, mcpsConfirm->NbRetries );
+    }
+
     LmHandlerCallbacks->OnTxData( &TxParams );
 
     LmHandlerPackagesNotify( PACKAGE_MCPS_CONFIRM, mcpsConfirm );
@@ -680,6 +847,11 @@ static void McpsIndication( McpsIndication_t *mcpsIndication )
     RxParams.Datarate = mcpsIndication->RxDatarate;
     RxParams.Rssi = mcpsIndication->Rssi;
     RxParams.Snr = mcpsIndication->Snr;
+
+    if( RateControl != NULL )
+    {
+        RateControl->OnDownlink( RateControlCtx, mcpsIndication->RxDatarate, mcpsIndication->Rssi, mcpsIndication->Snr );
+    }
     RxParams.DownlinkCounter = mcpsIndication->DownLinkCounter;
     RxParams.RxSlot = mcpsIndication->RxSlot;
 
@@ -908,23 +1080,28 @@ LmHandlerErrorStatus_t LmHandlerPackageRegister( uint8_t id, void *params )
             break;
         }
     }
-    if( package != NULL )
-    {
-        LmHandlerPackages[id] = package;
-        LmHandlerPackages[id]->OnMacMcpsRequest = LmHandlerCallbacks->OnMacMcpsRequest;
-        LmHandlerPackages[id]->OnMacMlmeRequest = LmHandlerCallbacks->OnMacMlmeRequest;
-        LmHandlerPackages[id]->OnJoinRequest = LmHandlerJoinRequest;
-        LmHandlerPackages[id]->OnSendRequest = LmHandlerSend;
-        LmHandlerPackages[id]->OnDeviceTimeRequest = LmHandlerDeviceTimeReq;
-        LmHandlerPackages[id]->OnSysTimeUpdate = LmHandlerCallbacks->OnSysTimeUpdate;
-        LmHandlerPackages[id]->Init( params, LmHandlerParams->DataBuffer, LmHandlerParams->DataBufferMaxSize );
+    return LmHandlerPackageAdd( id, package, params );
+}
 
-        return LORAMAC_HANDLER_SUCCESS;
-    }
-    else
+LmHandlerErrorStatus_t LmHandlerPackageAdd( uint8_t id, LmhPackage_t *package, void *params )
+{
+    if( ( id >= PKG_MAX_NUMBER ) || ( package == NULL ) )
     {
         return LORAMAC_HANDLER_ERROR;
     }
+    LmHandlerPackages[id] = package;
+    LmHandlerPackages[id]->OnMacMcpsRequest = LmHandlerCallbacks->OnMacMcpsRequest;
+    LmHandlerPackages[id]->OnMacMlmeRequest = LmHandlerCallbacks->OnMacMlmeRequest;
+    LmHandlerPackages[id]->OnJoinRequest = LmHandlerJoinRequest;
+    LmHandlerPackages[id]->OnSendRequest = LmHandlerSend;
+    LmHandlerPackages[id]->OnDeviceTimeRequest = LmHandlerDeviceTimeReq;
+    LmHandlerPackages[id]->OnSysTimeUpdate = LmHandlerCallbacks->OnSysTimeUpdate;
+    LmHandlerPackages[id]->OnProcessRequest = LmHandlerPackageProcessRequest;
+    LmHandlerPackages[id]->Init( params, LmHandlerParams->DataBuffer, LmHandlerParams->DataBufferMaxSize );
+    // Init may set the package port and callbacks
+    LmHandlerPackagesUpdateSubscribers( );
+
+    return LORAMAC_HANDLER_SUCCESS;
 }
 
 bool LmHandlerPackageIsInitialized( uint8_t id )
@@ -951,47 +1128,86 @@ bool LmHandlerPackageIsRunning( uint8_t id )
     }
 }
 
+static void LmHandlerPackagesUpdateSubscribers( void )
+{
+    for( uint8_t type = 0; type < PACKAGE_NOTIFY_TYPES_NB; type++ )
+    {
+        PackageSubscribers[type].NbIds = 0;
+    }
+    for( uint8_t i = 0; i < PKG_MAX_NUMBER; i++ )
+    {
+        LmhPackage_t *package = LmHandlerPackages[i];
+        bool isSubscribed[PACKAGE_NOTIFY_TYPES_NB];
+
+        if( package == NULL )
+        {
+            continue;
+        }
+        isSubscribed[PACKAGE_MCPS_CONFIRM] = package->OnMcpsConfirmProcess != NULL;
+        isSubscribed[PACKAGE_MCPS_INDICATION] = package->OnMcpsIndicationProcess != NULL;
+        isSubscribed[PACKAGE_MLME_CONFIRM] = package->OnMlmeConfirmProcess != NULL;
+        isSubscribed[PACKAGE_MLME_INDICATION] = package->OnMlmeIndicationProcess != NULL;
+
+        for( uint8_t type = 0; type < PACKAGE_NOTIFY_TYPES_NB; type++ )
+        {
+            if( isSubscribed[type] == true )
+            {
+                PackageSubscribers_t *subscribers = &PackageSubscribers[type];
+
+                subscribers->Ids[subscribers->NbIds] = i;
+                subscribers->Ports[subscribers->NbIds] = package->Port;
+                subscribers->NbIds++;
+            }
+        }
+    }
+}
+
+static void LmHandlerPackageProcessRequest( uint8_t id )
+{
+    if( id < PKG_MAX_NUMBER )
+    {
+        CRITICAL_SECTION_BEGIN( );
+        PackagesProcessPending |= ( uint32_t )1 << id;
+        CRITICAL_SECTION_END( );
+    }
+}
+
 static void LmHandlerPackagesNotify( PackageNotifyTypes_t notifyType, void *params )
 {
-    for( int8_t i = 0; i < PKG_MAX_NUMBER; i++ )
+    PackageSubscribers_t *subscribers = &PackageSubscribers[notifyType];
+
+    for( uint8_t i = 0; i < subscribers->NbIds; i++ )
     {
-        if( LmHandlerPackages[i] != NULL )
+        LmhPackage_t *package = LmHandlerPackages[subscribers->Ids[i]];
+
+        switch( notifyType )
         {
-            switch( notifyType )
+            case PACKAGE_MCPS_CONFIRM:
             {
-                case PACKAGE_MCPS_CONFIRM:
-                {
-                    if( LmHandlerPackages[i]->OnMcpsConfirmProcess != NULL )
-                    {
-                        LmHandlerPackages[i]->OnMcpsConfirmProcess( params );
-                    }
-                    break;
-                }
-                case PACKAGE_MCPS_INDICATION:
-                {
-                    if( ( LmHandlerPackages[i]->OnMcpsIndicationProcess != NULL ) &&
-                        ( LmHandlerPackages[i]->Port == ( ( McpsIndication_t* )params )->Port ) )
-                    {
-                        LmHandlerPackages[i]->OnMcpsIndicationProcess( params );
-                    }
-                    break;
-                }
-                case PACKAGE_MLME_CONFIRM:
-                {
-                    if( LmHandlerPackages[i]->OnMlmeConfirmProcess != NULL )
-                    {
-                        LmHandlerPackages[i]->OnMlmeConfirmProcess( params );
-                    }
-                    break;
-                }
-                case PACKAGE_MLME_INDICATION:
+                package->OnMcpsConfirmProcess( params );
+                break;
+            }
+            case PACKAGE_MCPS_INDICATION:
+            {
+                if( subscribers->Ports[i] == ( ( McpsIndication_t* )params )->Port )
                 {
-                    if( LmHandlerPackages[i]->OnMlmeIndicationProcess != NULL )
-                    {
-                        LmHandlerPackages[i]->OnMlmeIndicationProcess( params );
-                    }
-                    break;
+                    package->OnMcpsIndicationProcess( params );
                 }
+                break;
+            }
+            case PACKAGE_MLME_CONFIRM:
+            {
+                package->OnMlmeConfirmProcess( params );
+                break;
+            }
+            case PACKAGE_MLME_INDICATION:
+            {
+                package->OnMlmeIndicationProcess( params );
+                break;
+            }
+            default:
+            {
+                break;
             }
         }
     }
@@ -999,8 +1215,20 @@ static void LmHandlerPackagesNotify( PackageNotifyTypes_t notifyType, void *para
 
 static void LmHandlerPackagesProcess( void )
 {
-    for( int8_t i = 0; i < PKG_MAX_NUMBER; i++ )
+    uint32_t pending;
+
+    CRITICAL_SECTION_BEGIN( );
+    pending = PackagesProcessPending;
+    PackagesProcessPending = 0;
+    CRITICAL_SECTION_END( );
+
+    for( uint8_t i = 0; ( i < PKG_MAX_NUMBER ) && ( pending != 0 ); i++ )
     {
+        if( ( pending & ( ( uint32_t )1 << i ) ) == 0 )
+        {
+            continue;
+        }
+        pending &= ~( ( uint32_t )1 << i );
         if( ( LmHandlerPackages[i] != NULL ) &&
             ( LmHandlerPackages[i]->Process != NULL ) &&
             ( LmHandlerPackageIsInitialized( i ) != false ) )
@@ -32,6 +32,7 @@ extern "C"
 
 #include "LmHandlerTypes.h"
 #include "LmhpCompliance.h"
+#include "LoRaMacRateControl.h"
 
 
 typedef struct LmHandlerJoinParams_s
@@ -319,12 +320,47 @@ LoRaMacRegion_t LmHandlerGetActiveRegion( void );
  */
 LmHandlerErrorStatus_t LmHandlerSetSystemMaxRxError( uint32_t maxErrorInMs );
 
+/*!
+ * Sets the rate control engine selecting the uplink datarate and TX power
+ * while the ADR is off. To be called after \ref LmHandlerInit.
+ *
+ * The TX power in use before the engine selected one is restored when the
+ * engine is removed or doesn't select the TX power of an uplink.
+ *
+ * \param [IN] rateControl Rate control engine, e.g.
+ *                         \ref LoRaMacRateControlLinkMargin. NULL to use
+ *                         \ref LmHandlerParams_t.TxDatarate again.
+ * \param [IN] ctx         Context of the engine instance, e.g. a
+ *                         \ref RateControlLinkMarginCtx_t. Must stay valid
+ *                         while the engine is set.
+ *
+ * \retval status Returns \ref LORAMAC_HANDLER_SUCCESS if request has been
+ *                processed else \ref LORAMAC_HANDLER_ERROR
+ */
+LmHandlerErrorStatus_t LmHandlerSetRateControl( const LoRaMacRateControl_t *rateControl, void *ctx );
+
 /*
  *=============================================================================
  * PACKAGES HANDLING
  *=============================================================================
  */
 LmHandlerErrorStatus_t LmHandlerPackageRegister( uint8_t id, void *params );
+
+/*!
+ * Registers a package not provided with the stack. The LmHandler callbacks of
+ * the package are initialized before its Init function is called.
+ *
+ * \param [IN] id      Package identifier [4..PKG_MAX_NUMBER-1], the lower
+ *                     identifiers being used by the packages provided with
+ *                     the stack
+ * \param [IN] package Package to be registered
+ * \param [IN] params  Package Init parameters
+ *
+ * \retval status Returns \ref LORAMAC_HANDLER_SUCCESS if request has been
+ *                processed else \ref LORAMAC_HANDLER_ERROR
+ */
+LmHandlerErrorStatus_t LmHandlerPackageAdd( uint8_t id, LmhPackage_t *package, void *params );
+
 bool LmHandlerPackageIsInitialized( uint8_t id );
 bool LmHandlerPackageIsRunning( uint8_t id );
 
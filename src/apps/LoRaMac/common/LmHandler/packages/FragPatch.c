@@ -0,0 +1,527 @@
+/*!
+ * \file      patch->c
+ *
+ * \brief     Streaming delta patch applier for the fragmentation decoder
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include <stdbool.h>
+#include "utilities.h"
+#include "FragPatch.h"
+
+#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
+
+/*!
+ * Shortest match of the "LPD2" patches
+ */
+#define FRAG_PATCH_MIN_MATCH                        3
+
+/*
+ *=============================================================================
+ * Patch applier utilities
+ *=============================================================================
+ */
+
+/*!
+ * \brief Accumulates a LEB128 varint byte
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] byte  Varint byte
+ *
+ * \retval complete True when the varint is complete. The value is available
+ *                  in patch->Varint
+ */
+static bool VarintPush( FragPatch_t *patch, uint8_t byte );
+
+/*!
+ * \brief Writes the buffered new image bytes
+ *
+ * \param [IN] patch Patch applier instance
+ */
+static void FlushOut( FragPatch_t *patch );
+
+/*!
+ * \brief Appends a byte to the new image
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] byte  New image byte
+ */
+static void PushOut( FragPatch_t *patch, uint8_t byte );
+
+/*!
+ * \brief Appends the next reference byte plus delta to the new image
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] delta Difference to the reference byte
+ */
+static void PushDiff( FragPatch_t *patch, uint8_t delta );
+
+/*!
+ * \brief Moves to the next record part once the diff bytes are consumed
+ *
+ * \param [IN] patch Patch applier instance
+ */
+static void EndOfDiff( FragPatch_t *patch );
+
+/*!
+ * \brief Applies the seek and moves to the next record
+ *
+ * \param [IN] patch Patch applier instance
+ */
+static void EndOfRecord( FragPatch_t *patch );
+
+/*!
+ * \brief Parses a patch byte
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] byte  Patch byte
+ */
+static void ParseByte( FragPatch_t *patch, uint8_t byte );
+
+/*!
+ * \brief Parses a decompressed patch byte and keeps it in the window
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] byte  Decompressed patch byte
+ */
+static void PushWindow( FragPatch_t *patch, uint8_t byte );
+
+/*!
+ * \brief Decompresses a byte of an "LPD2" patch
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] byte  Compressed patch byte
+ */
+static void DecompressByte( FragPatch_t *patch, uint8_t byte );
+
+/*!
+ * \brief Applies the stored patch data up to the given address
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] end   Patch address to stop at
+ */
+static void ApplyStoredPatch( FragPatch_t *patch, uint32_t end );
+
+/*
+ *=============================================================================
+ * Patch applier API
+ *=============================================================================
+ */
+
+void FragPatchInit( FragPatch_t *patch, FragPatchParams_t *params )
+{
+    patch->Params = params;
+    FragPatchReset( patch );
+}
+
+void FragPatchReset( FragPatch_t *patch )
+{
+    FragPatchParams_t *params = patch->Params;
+
+    memset1( ( uint8_t* )patch, 0, sizeof( FragPatch_t ) );
+    patch->Params = params;
+    patch->Status = FRAG_PATCH_ONGOING;
+    patch->State = FRAG_PATCH_STATE_HEADER;
+}
+
+void FragPatchOnProgress( FragPatch_t *patch, uint8_t fragIndex, uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost )
+{
+    if( ( patch->Params == NULL ) || ( fragIndex != patch->Params->FragIndex ) )
+    {
+        // Another fragmentation session
+        return;
+    }
+    if( ( fragNbLost != 0 ) || ( fragCounter > fragNb ) )
+    {
+        // Lost fragments are only final once the session is finished.
+        return;
+    }
+    ApplyStoredPatch( patch, ( uint32_t )fragCounter * fragSize );
+}
+
+int32_t FragPatchFinalize( FragPatch_t *patch, uint32_t size )
+{
+    ApplyStoredPatch( patch, size );
+
+    if( patch->Status == FRAG_PATCH_ONGOING )
+    {
+        // Truncated patch
+        patch->Status = FRAG_PATCH_ERROR_FORMAT;
+    }
+    return patch->Status;
+}
+
+int32_t FragPatchGetStatus( FragPatch_t *patch )
+{
+    return patch->Status;
+}
+
+/*
+ *=============================================================================
+ * Patch applier utilities implementation
+ *=============================================================================
+ */
+
+static bool VarintPush( FragPatch_t *patch, uint8_t byte )
+{
+    if( patch->VarintShift > 28 )
+    {
+        patch->Status = FRAG_PATCH_ERROR_FORMAT;
+        return false;
+    }
+    patch->Varint |= ( uint32_t )( byte & 0x7F ) << patch->VarintShift;
+    patch->VarintShift += 7;
+
+    if( ( byte & 0x80 ) != 0 )
+    {
+        return false;
+    }
+    patch->VarintShift = 0;
+    return true;
+}
+
+static void FlushOut( FragPatch_t *patch )
+{
+    if( patch->OutLen == 0 )
+    {
+        return;
+    }
+    if( patch->Params->ImageWrite( patch->OutPos - patch->OutLen, patch->Out, patch->OutLen ) != 0 )
+    {
+        patch->Status = FRAG_PATCH_ERROR_STORAGE;
+    }
+    patch->OutLen = 0;
+}
+
+static void PushOut( FragPatch_t *patch, uint8_t byte )
+{
+    patch->Out[patch->OutLen++] = byte;
+    patch->OutPos++;
+    if( patch->OutLen == FRAG_PATCH_BUFFER_SIZE )
+    {
+        FlushOut( patch );
+    }
+}
+
+static void PushDiff( FragPatch_t *patch, uint8_t delta )
+{
+    if( patch->RefPos >= patch->Params->ReferenceSize )
+    {
+        patch->Status = FRAG_PATCH_ERROR_FORMAT;
+        return;
+    }
+    if( ( patch->RefPos < patch->RefAddr ) || ( patch->RefPos >= ( patch->RefAddr + patch->RefLen ) ) )
+    {
+        patch->RefAddr = patch->RefPos;
+        patch->RefLen = MIN( FRAG_PATCH_BUFFER_SIZE, patch->Params->ReferenceSize - patch->RefPos );
+        if( patch->Params->ReferenceRead( patch->RefAddr, patch->Ref, patch->RefLen ) != 0 )
+        {
+            patch->RefLen = 0;
+            patch->Status = FRAG_PATCH_ERROR_REFERENCE;
+            return;
+        }
+    }
+    PushOut( patch, patch->Ref[patch->RefPos - patch->RefAddr] + delta );
+    patch->RefPos++;
+    patch->DiffLen--;
+}
+
+static void EndOfDiff( FragPatch_t *patch )
+{
+    if( patch->ExtraLen > 0 )
+    {
+        patch->State = FRAG_PATCH_STATE_EXTRA;
+    }
+    else
+    {
+        EndOfRecord( patch );
+    }
+}
+
+static void EndOfRecord( FragPatch_t *patch )
+{
+    int64_t refPos = ( int64_t )patch->RefPos + patch->Seek;
+
+    if( ( refPos < 0 ) || ( refPos > patch->Params->ReferenceSize ) )
+    {
+        patch->Status = FRAG_PATCH_ERROR_FORMAT;
+        return;
+    }
+    patch->RefPos = ( uint32_t )refPos;
+
+    if( patch->OutPos == patch->NewSize )
+    {
+        FlushOut( patch );
+        patch->State = FRAG_PATCH_STATE_DONE;
+        if( patch->Status == FRAG_PATCH_ONGOING )
+        {
+            patch->Status = ( int32_t )patch->NewSize;
+        }
+    }
+    else
+    {
+        patch->State = FRAG_PATCH_STATE_DIFF_LEN;
+    }
+}
+
+static void ParseByte( FragPatch_t *patch, uint8_t byte )
+{
+    switch( patch->State )
+    {
+        case FRAG_PATCH_STATE_HEADER:
+        {
+            patch->Header[patch->HeaderLen++] = byte;
+            if( patch->HeaderLen < FRAG_PATCH_HEADER_SIZE )
+            {
+                break;
+            }
+            if( ( patch->Header[0] != 'L' ) || ( patch->Header[1] != 'P' ) ||
+                ( patch->Header[2] != 'D' ) || ( ( patch->Header[3] != '1' ) && ( patch->Header[3] != '2' ) ) )
+            {
+                patch->Status = FRAG_PATCH_ERROR_FORMAT;
+                break;
+            }
+            patch->IsCompressed = ( patch->Header[3] == '2' );
+            patch->NewSize = ( ( uint32_t )patch->Header[4] ) | ( ( uint32_t )patch->Header[5] << 8 ) |
+                                ( ( uint32_t )patch->Header[6] << 16 ) | ( ( uint32_t )patch->Header[7] << 24 );
+            uint32_t refSize = ( ( uint32_t )patch->Header[8] ) | ( ( uint32_t )patch->Header[9] << 8 ) |
+                               ( ( uint32_t )patch->Header[10] << 16 ) | ( ( uint32_t )patch->Header[11] << 24 );
+
+            if( refSize != patch->Params->ReferenceSize )
+            {
+                // Patch generated against another image
+                patch->Status = FRAG_PATCH_ERROR_REFERENCE;
+            }
+            else if( ( patch->NewSize > patch->Params->ImageMaxSize ) || ( patch->NewSize > INT32_MAX ) )
+            {
+                patch->Status = FRAG_PATCH_ERROR_STORAGE;
+            }
+            else if( patch->NewSize == 0 )
+            {
+                patch->State = FRAG_PATCH_STATE_DONE;
+                patch->Status = 0;
+            }
+            else
+            {
+                patch->State = FRAG_PATCH_STATE_DIFF_LEN;
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_DIFF_LEN:
+        {
+            if( VarintPush( patch, byte ) == true )
+            {
+                patch->DiffLen = patch->Varint;
+                patch->Varint = 0;
+                patch->State = FRAG_PATCH_STATE_EXTRA_LEN;
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_EXTRA_LEN:
+        {
+            if( VarintPush( patch, byte ) == true )
+            {
+                patch->ExtraLen = patch->Varint;
+                patch->Varint = 0;
+                if( ( patch->DiffLen > ( patch->NewSize - patch->OutPos ) ) ||
+                    ( patch->ExtraLen > ( patch->NewSize - patch->OutPos - patch->DiffLen ) ) )
+                {
+                    patch->Status = FRAG_PATCH_ERROR_FORMAT;
+                    break;
+                }
+                patch->State = FRAG_PATCH_STATE_SEEK;
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_SEEK:
+        {
+            if( VarintPush( patch, byte ) == true )
+            {
+                // Zig-zag decoding
+                patch->Seek = ( int32_t )( patch->Varint >> 1 ) ^ -( int32_t )( patch->Varint & 1 );
+                patch->Varint = 0;
+                if( patch->DiffLen > 0 )
+                {
+                    patch->State = FRAG_PATCH_STATE_DIFF;
+                }
+                else
+                {
+                    EndOfDiff( patch );
+                }
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_DIFF:
+        {
+            if( byte == 0x00 )
+            {
+                patch->State = FRAG_PATCH_STATE_DIFF_RUN;
+                break;
+            }
+            PushDiff( patch, byte );
+            if( patch->DiffLen == 0 )
+            {
+                EndOfDiff( patch );
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_DIFF_RUN:
+        {
+            if( VarintPush( patch, byte ) == true )
+            {
+                uint32_t run = patch->Varint;
+
+                patch->Varint = 0;
+                if( ( run == 0 ) || ( run > patch->DiffLen ) )
+                {
+                    patch->Status = FRAG_PATCH_ERROR_FORMAT;
+                    break;
+                }
+                while( ( run-- > 0 ) && ( patch->Status == FRAG_PATCH_ONGOING ) )
+                {
+                    PushDiff( patch, 0x00 );
+                }
+                if( patch->DiffLen == 0 )
+                {
+                    EndOfDiff( patch );
+                }
+                else
+                {
+                    patch->State = FRAG_PATCH_STATE_DIFF;
+                }
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_EXTRA:
+        {
+            PushOut( patch, byte );
+            patch->ExtraLen--;
+            if( patch->ExtraLen == 0 )
+            {
+                EndOfRecord( patch );
+            }
+            break;
+        }
+        case FRAG_PATCH_STATE_DONE:
+        default:
+        {
+            // Fragmentation padding
+            break;
+        }
+    }
+}
+
+static void PushWindow( FragPatch_t *patch, uint8_t byte )
+{
+    patch->Window[patch->LzPos % FRAG_PATCH_WINDOW_SIZE] = byte;
+    patch->LzPos++;
+    ParseByte( patch, byte );
+}
+
+static void DecompressByte( FragPatch_t *patch, uint8_t byte )
+{
+    if( patch->State == FRAG_PATCH_STATE_DONE )
+    {
+        // Fragmentation padding
+        return;
+    }
+    switch( patch->LzState )
+    {
+        case FRAG_PATCH_LZ_STATE_FLAGS:
+        {
+            patch->LzFlags = byte;
+            patch->LzNbFlags = 8;
+            break;
+        }
+        case FRAG_PATCH_LZ_STATE_LITERAL:
+        {
+            PushWindow( patch, byte );
+            break;
+        }
+        case FRAG_PATCH_LZ_STATE_DISTANCE:
+        {
+            patch->LzDistance = ( uint16_t )byte + 1;
+            if( patch->LzDistance > patch->LzPos )
+            {
+                patch->Status = FRAG_PATCH_ERROR_FORMAT;
+                return;
+            }
+            patch->LzState = FRAG_PATCH_LZ_STATE_LENGTH;
+            return;
+        }
+        case FRAG_PATCH_LZ_STATE_LENGTH:
+        {
+            uint16_t length = ( uint16_t )byte + FRAG_PATCH_MIN_MATCH;
+
+            // The copy may overlap the bytes it produces
+            while( ( length-- > 0 ) && ( patch->Status == FRAG_PATCH_ONGOING ) &&
+                   ( patch->State != FRAG_PATCH_STATE_DONE ) )
+            {
+                PushWindow( patch, patch->Window[( patch->LzPos - patch->LzDistance ) % FRAG_PATCH_WINDOW_SIZE] );
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    // Next token
+    if( patch->LzNbFlags == 0 )
+    {
+        patch->LzState = FRAG_PATCH_LZ_STATE_FLAGS;
+        return;
+    }
+    patch->LzState = ( ( patch->LzFlags & 0x01 ) != 0 ) ? FRAG_PATCH_LZ_STATE_LITERAL : FRAG_PATCH_LZ_STATE_DISTANCE;
+    patch->LzFlags >>= 1;
+    patch->LzNbFlags--;
+}
+
+static void ApplyStoredPatch( FragPatch_t *patch, uint32_t end )
+{
+    uint8_t buffer[FRAG_PATCH_BUFFER_SIZE];
+
+    if( ( patch->Params == NULL ) || ( patch->Params->PatchCallbacks.FragDecoderRead == NULL ) ||
+        ( patch->Params->ReferenceRead == NULL ) || ( patch->Params->ImageWrite == NULL ) )
+    {
+        return;
+    }
+    while( ( patch->PatchPos < end ) && ( patch->Status == FRAG_PATCH_ONGOING ) )
+    {
+        uint32_t size = MIN( FRAG_PATCH_BUFFER_SIZE, end - patch->PatchPos );
+
+        if( patch->Params->PatchCallbacks.FragDecoderRead( patch->PatchPos, buffer, size ) != 0 )
+        {
+            patch->Status = FRAG_PATCH_ERROR_STORAGE;
+            break;
+        }
+        for( uint32_t i = 0; ( i < size ) && ( patch->Status == FRAG_PATCH_ONGOING ); i++ )
+        {
+            if( patch->IsCompressed == true )
+            {
+                DecompressByte( patch, buffer[i] );
+            }
+            else
+            {
+                ParseByte( patch, buffer[i] );
+            }
+        }
+        patch->PatchPos += size;
+    }
+}
+
+#endif
@@ -0,0 +1,276 @@
+/*!
+ * \file      FragPatch.h
+ *
+ * \brief     Streaming delta patch applier for the fragmentation decoder
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \remark    The received session file is a delta patch against the
+ *            currently installed image instead of the new image itself.
+ *            The patch is stored through the \ref FragDecoderCallbacks_t
+ *            of the fragmentation session. \ref FragPatchReset restarts the
+ *            applier when the session is set up. \ref FragPatchOnProgress
+ *            applies the patch while the fragments are received without
+ *            loss. \ref FragPatchFinalize applies the remaining part once
+ *            the session is finished. The new image is written
+ *            sequentially, from address 0 upwards.
+ *
+ *            Patch format (integers are little endian, varints are LEB128):
+ *
+ *            | Field      | Size | Description                              |
+ *            |------------|------|------------------------------------------|
+ *            | Magic      | 4    | "LPD1" or "LPD2"                         |
+ *            | NewSize    | 4    | Size of the new image                    |
+ *            | RefSize    | 4    | Size of the reference image              |
+ *            | Records    | ...  | Records until NewSize bytes are produced |
+ *
+ *            Each record is made of
+ *
+ *            | Field      | Size   | Description                            |
+ *            |------------|--------|----------------------------------------|
+ *            | DiffLen    | varint | Bytes added to the reference           |
+ *            | ExtraLen   | varint | Bytes copied verbatim                  |
+ *            | Seek       | varint | Zig-zag encoded reference offset       |
+ *            | Diff       | ...    | DiffLen bytes, zero runs compressed    |
+ *            | Extra      | ...    | ExtraLen bytes                         |
+ *
+ *            In the Diff field a 0x00 byte is followed by a varint giving the
+ *            length of a run of zero bytes. Any other byte is a literal.
+ *
+ *            With the "LPD2" magic the records are compressed with a sliding
+ *            window of \ref FRAG_PATCH_WINDOW_SIZE bytes. A flags byte
+ *            precedes each group of 8 tokens, least significant bit first.
+ *            A 1 bit is a literal byte. A 0 bit is a match made of 2 bytes,
+ *            the distance minus 1 and the length minus 3 of a copy of the
+ *            previously decompressed bytes.
+ *
+ *            The tools/fragpatch.py host script generates patches.
+ */
+#ifndef __FRAG_PATCH_H__
+#define __FRAG_PATCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FragDecoder.h"
+
+#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
+
+/*!
+ * Size of the new image and reference image buffers.
+ *
+ * \remark This parameter has an impact on the memory footprint.
+ */
+#define FRAG_PATCH_BUFFER_SIZE                      64
+
+/*!
+ * Size of the decompression window of "LPD2" patches. Set by the patch
+ * format.
+ *
+ * \remark This parameter has an impact on the memory footprint.
+ */
+#define FRAG_PATCH_WINDOW_SIZE                      256
+
+/*!
+ * Patch header size
+ */
+#define FRAG_PATCH_HEADER_SIZE                      12
+
+#define FRAG_PATCH_ONGOING                          ( int32_t )-1
+#define FRAG_PATCH_ERROR_FORMAT                     ( int32_t )-2
+#define FRAG_PATCH_ERROR_REFERENCE                  ( int32_t )-3
+#define FRAG_PATCH_ERROR_STORAGE                    ( int32_t )-4
+
+/*!
+ * Patch applier parameters
+ */
+typedef struct sFragPatchParams
+{
+    /*!
+     * Storage of the received patch. Same callbacks as the DecoderCallbacks
+     * of the fragmentation session.
+     */
+    FragDecoderCallbacks_t PatchCallbacks;
+    /*!
+     * Index of the fragmentation session receiving the patch
+     */
+    uint8_t FragIndex;
+    /*!
+     * Reads `data` buffer of `size` starting at address `addr` of the
+     * currently installed image
+     *
+     * \param [IN] addr Address start index to read from.
+     * \param [IN] data Data buffer to be read.
+     * \param [IN] size Size of data buffer to be read.
+     *
+     * \retval status Read operation status [0: Success, -1 Fail]
+     */
+    uint8_t ( *ReferenceRead )( uint32_t addr, uint8_t *data, uint32_t size );
+    /*!
+     * Size of the currently installed image
+     */
+    uint32_t ReferenceSize;
+    /*!
+     * Writes `data` buffer of `size` starting at address `addr` of the new
+     * image. Called with increasing addresses only.
+     *
+     * \param [IN] addr Address start index to write to.
+     * \param [IN] data Data buffer to be written.
+     * \param [IN] size Size of data buffer to be written.
+     *
+     * \retval status Write operation status [0: Success, -1 Fail]
+     */
+    uint8_t ( *ImageWrite )( uint32_t addr, uint8_t *data, uint32_t size );
+    /*!
+     * Memory available for the new image
+     */
+    uint32_t ImageMaxSize;
+}FragPatchParams_t;
+
+/*!
+ * Patch parser states
+ */
+typedef enum eFragPatchState
+{
+    FRAG_PATCH_STATE_HEADER,
+    FRAG_PATCH_STATE_DIFF_LEN,
+    FRAG_PATCH_STATE_EXTRA_LEN,
+    FRAG_PATCH_STATE_SEEK,
+    FRAG_PATCH_STATE_DIFF,
+    FRAG_PATCH_STATE_DIFF_RUN,
+    FRAG_PATCH_STATE_EXTRA,
+    FRAG_PATCH_STATE_DONE,
+}FragPatchState_t;
+
+/*!
+ * Decompressor states of the "LPD2" patches
+ */
+typedef enum eFragPatchLzState
+{
+    FRAG_PATCH_LZ_STATE_FLAGS,
+    FRAG_PATCH_LZ_STATE_LITERAL,
+    FRAG_PATCH_LZ_STATE_DISTANCE,
+    FRAG_PATCH_LZ_STATE_LENGTH,
+}FragPatchLzState_t;
+
+/*!
+ * Patch applier instance
+ */
+typedef struct sFragPatch
+{
+    FragPatchParams_t *Params;
+    int32_t Status;
+    FragPatchState_t State;
+    /*!
+     * Number of patch bytes already applied
+     */
+    uint32_t PatchPos;
+    uint8_t Header[FRAG_PATCH_HEADER_SIZE];
+    uint8_t HeaderLen;
+    uint32_t Varint;
+    uint8_t VarintShift;
+    uint32_t NewSize;
+    uint32_t DiffLen;
+    uint32_t ExtraLen;
+    int32_t Seek;
+    uint32_t RefPos;
+    /*!
+     * Number of new image bytes produced, including the buffered ones
+     */
+    uint32_t OutPos;
+    uint8_t Out[FRAG_PATCH_BUFFER_SIZE];
+    uint8_t OutLen;
+    uint8_t Ref[FRAG_PATCH_BUFFER_SIZE];
+    uint32_t RefAddr;
+    uint8_t RefLen;
+    /*!
+     * Set when the records are compressed ("LPD2" patch)
+     */
+    bool IsCompressed;
+    FragPatchLzState_t LzState;
+    uint8_t LzFlags;
+    uint8_t LzNbFlags;
+    uint16_t LzDistance;
+    /*!
+     * Number of decompressed bytes
+     */
+    uint32_t LzPos;
+    uint8_t Window[FRAG_PATCH_WINDOW_SIZE];
+}FragPatch_t;
+
+/*!
+ * \brief Initializes the patch applier
+ *
+ * \param [IN] patch  Patch applier instance
+ * \param [IN] params Patch applier parameters
+ */
+void FragPatchInit( FragPatch_t *patch, FragPatchParams_t *params );
+
+/*!
+ * \brief Restarts the patch applier. To be called when the fragmentation
+ *        session receiving the patch is set up.
+ *
+ * \param [IN] patch Patch applier instance
+ */
+void FragPatchReset( FragPatch_t *patch );
+
+/*!
+ * \brief Applies the patch data received so far. To be called from the
+ *        fragmentation package OnProgress callback.
+ *
+ * \remark The progress of the other fragmentation sessions is ignored. The
+ *         patch is applied as long as no fragment is lost. Afterwards the
+ *         fragments recovered by the decoder are only final once the
+ *         session is finished.
+ *
+ * \param [IN] patch       Patch applier instance
+ * \param [IN] fragIndex   Fragmentation session index
+ * \param [IN] fragCounter Fragment counter
+ * \param [IN] fragNb      Number of fragments
+ * \param [IN] fragSize    Size of fragments
+ * \param [IN] fragNbLost  Number of lost fragments
+ */
+void FragPatchOnProgress( FragPatch_t *patch, uint8_t fragIndex, uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost );
+
+/*!
+ * \brief Applies the part of the patch that could not be streamed because
+ *        of lost fragments. To be called once the fragmentation session is
+ *        finished.
+ *
+ * \param [IN] patch Patch applier instance
+ * \param [IN] size  Received patch size
+ *
+ * \retval status New image size or [FRAG_PATCH_ONGOING,
+ *                                   FRAG_PATCH_ERROR_FORMAT,
+ *                                   FRAG_PATCH_ERROR_REFERENCE,
+ *                                   FRAG_PATCH_ERROR_STORAGE]
+ */
+int32_t FragPatchFinalize( FragPatch_t *patch, uint32_t size );
+
+/*!
+ * \brief Gets the patch applier status
+ *
+ * \param [IN] patch Patch applier instance
+ *
+ * \retval status New image size or [FRAG_PATCH_ONGOING,
+ *                                   FRAG_PATCH_ERROR_FORMAT,
+ *                                   FRAG_PATCH_ERROR_REFERENCE,
+ *                                   FRAG_PATCH_ERROR_STORAGE]
+ */
+int32_t FragPatchGetStatus( FragPatch_t *patch );
+
+#endif
+
+#endif // __FRAG_PATCH_H__
@@ -26,9 +26,15 @@
 #include "LmHandlerTypes.h"
 
 /*!
- * Maximum number of packages
+ * Maximum number of packages. Package identifiers range from 0 to
+ * PKG_MAX_NUMBER - 1, the identifiers of the packages provided with the stack
+ * range from 0 to 3.
+ *
+ * \remark At most 32 packages, see \ref LmhPackage_s.OnProcessRequest
  */
-#define PKG_MAX_NUMBER                              4
+#ifndef PKG_MAX_NUMBER
+#define PKG_MAX_NUMBER                              8
+#endif
 
 typedef struct LmhPackage_s
 {
@@ -62,7 +68,8 @@ typedef struct LmhPackage_s
      */
     bool ( *IsRunning )( void );
     /*!
-     * Processes the internal package events.
+     * Processes the internal package events. Only called by LmHandlerProcess
+     * after the package called \ref LmhPackage_s.OnProcessRequest.
      */
     void ( *Process )( void );
     /*!
@@ -151,6 +158,13 @@ typedef struct LmhPackage_s
      */
     void ( *OnSysTimeUpdate )( void );
 #endif
+    /*!
+     * Requests LmHandlerProcess to call the package Process function. May be
+     * called from an interrupt.
+     *
+     * \param [IN] id Package identifier
+     */
+    void ( *OnProcessRequest )( uint8_t id );
 }LmhPackage_t;
 
 #endif // __LMH_PACKAGE_H__
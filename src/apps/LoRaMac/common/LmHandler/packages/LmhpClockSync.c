@@ -145,6 +145,7 @@ static LmhPackage_t LmhpClockSyncPackage =
     .OnSendRequest = NULL,                                     // To be initialized by LmHandler
     .OnDeviceTimeRequest = NULL,                               // To be initialized by LmHandler
     .OnSysTimeUpdate = NULL,                                   // To be initialized by LmHandler
+    .OnProcessRequest = NULL,                                  // To be initialized by LmHandler
 };
 
 LmhPackage_t *LmphClockSyncPackageFactory( void )
@@ -192,6 +193,11 @@ static void LmhpClockSyncProcess( void )
             LmhpClockSyncState.NbTransmissions--;
         }
     }
+    if( LmhpClockSyncState.NbTransmissions > 0 )
+    {
+        // Retry or send the remaining requests on the next call
+        LmhpClockSyncPackage.OnProcessRequest( PACKAGE_ID_CLOCK_SYNC );
+    }
 }
 
 static void LmhpClockSyncOnMcpsConfirm( McpsConfirm_t *mcpsConfirm )
@@ -295,6 +301,7 @@ static void LmhpClockSyncOnMcpsIndication( McpsIndication_t *mcpsIndication )
             case CLOCK_SYNC_FORCE_RESYNC_REQ:
             {
                 LmhpClockSyncState.NbTransmissions = mcpsIndication->Buffer[cmdIndex++] & 0X07;
+                LmhpClockSyncPackage.OnProcessRequest( PACKAGE_ID_CLOCK_SYNC );
                 break;
             }
         }
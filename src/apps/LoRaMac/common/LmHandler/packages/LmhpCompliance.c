@@ -168,6 +168,7 @@ LmhPackage_t LmhpCompliancePackage =
     .OnSendRequest = NULL,                                     // To be initialized by LmHandler
     .OnDeviceTimeRequest = NULL,                               // To be initialized by LmHandler
     .OnSysTimeUpdate = NULL,                                   // To be initialized by LmHandler
+    .OnProcessRequest = NULL,                                  // To be initialized by LmHandler
 };
 
 LmhPackage_t *LmphCompliancePackageFactory( void )
@@ -326,6 +327,7 @@ static void LmhpComplianceOnMcpsIndication( McpsIndication_t* mcpsIndication )
             CRITICAL_SECTION_BEGIN( );
             ComplianceTestState.TxPending = true; //LmhpComplianceTxProcess( );
             CRITICAL_SECTION_END( );
+            LmhpCompliancePackage.OnProcessRequest( PACKAGE_ID_COMPLIANCE );
         }
     }
     else
@@ -488,4 +490,5 @@ static void LmhpComplianceProcess( void )
 static void OnComplianceTxNextPacketTimerEvent( void* context )
 {
     ComplianceTestState.TxPending = true;
+    LmhpCompliancePackage.OnProcessRequest( PACKAGE_ID_COMPLIANCE );
 }
@@ -22,6 +22,9 @@
 #include "LmHandler.h"
 #include "LmhpFragmentation.h"
 #include "FragDecoder.h"
+#include "sha256.h"
+#include "secure-element.h"
+#include "tracepoint.h"
 
 /*!
  * LoRaWAN Application Layer Fragmented Data Block Transport Specification
@@ -31,8 +34,6 @@
 #define FRAGMENTATION_ID                            3
 #define FRAGMENTATION_VERSION                       1
 
-#define FRAGMENTATION_MAX_SESSIONS                  4
-
 // Fragmentation Tx delay state
 typedef enum LmhpFragmentationTxDelayStates_e
 {
@@ -55,6 +56,10 @@ typedef struct LmhpFragmentationState_s
     uint8_t DataBufferMaxSize;
     uint8_t *DataBuffer;
     uint8_t *file;
+    /*!
+     * Class C continuous reception forced for the ongoing sessions
+     */
+    bool IsRxCContinuousForced;
 }LmhpFragmentationState_t;
 
 typedef enum LmhpFragmentationMoteCmd_e
@@ -116,6 +121,39 @@ static void LmhpFragmentationProcess( void );
  */
 static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication );
 
+/*!
+ * Hashes the received fragment when it extends the in order received part
+ * of the session file
+ *
+ * \param [IN] fragIndex   Fragmentation session index
+ * \param [IN] fragCounter Fragment counter
+ * \param [IN] rawData     Fragment data
+ */
+static void FragSessionDigestUpdate( uint8_t fragIndex, uint16_t fragCounter, uint8_t *rawData );
+
+/*!
+ * Adds session file data to the SHA-256 digest and to the AES-CMAC
+ *
+ * \param [IN] fragIndex   Fragmentation session index
+ * \param [IN] data        Session file data
+ * \param [IN] size        Size of the data
+ */
+static void FragSessionDigestAdd( uint8_t fragIndex, uint8_t *data, uint32_t size );
+
+/*!
+ * Hashes the fragments recovered by the decoder and computes the session
+ * file digest
+ *
+ * \param [IN] fragIndex   Fragmentation session index
+ */
+static void FragSessionDigestFinalize( uint8_t fragIndex );
+
+/*!
+ * Forces the class C continuous reception while a session is ongoing, the
+ * reception duty cycle could miss fragments sent with a short preamble
+ */
+static void FragSessionUpdateRxCMode( void );
+
 static LmhpFragmentationState_t LmhpFragmentationState =
 {
     .Initialized = false,
@@ -157,6 +195,24 @@ typedef struct FragSessionData_s
     FragGroupData_t FragGroupData;
     FragDecoderStatus_t FragDecoderStatus;
     int32_t FragDecoderPorcessStatus;
+    FragDecoder_t FragDecoder;
+    /*!
+     * Hash of the session file. Updated while the uncoded fragments are
+     * received in order.
+     */
+    Sha256Ctx_t DigestCtx;
+    /*!
+     * Number of fragments already hashed
+     */
+    uint16_t DigestFragNb;
+    uint8_t Digest[SHA256_DIGEST_SIZE];
+    /*!
+     * AES-CMAC of the session file, computed along with the digest when
+     * IsCmacValid is set
+     */
+    SecureElementCmacCtx_t CmacCtx;
+    bool IsCmacValid;
+    uint8_t Cmac[SE_CMAC_SIZE];
 }FragSessionData_t;
 
 FragSessionData_t FragSessionData[FRAGMENTATION_MAX_SESSIONS];
@@ -181,6 +237,7 @@ static LmhPackage_t LmhpFragmentationPackage =
     .OnSendRequest = NULL,                                     // To be initialized by LmHandler
     .OnDeviceTimeRequest = NULL,                               // To be initialized by LmHandler
     .OnSysTimeUpdate = NULL,                                   // To be initialized by LmHandler
+    .OnProcessRequest = NULL,                                  // To be initialized by LmHandler
 };
 
 // Delay value.
@@ -198,6 +255,7 @@ static void OnFragmentTxDelay( void* context )
     TimerStop( &FragmentTxDelayTimer );
     // Set the state.
     LmhpFragmentationState.TxDelayState = FRAGMENTATION_TX_DELAY_STATE_STOP;
+    LmhpFragmentationPackage.OnProcessRequest( PACKAGE_ID_FRAGMENTATION );
 }
 
 LmhPackage_t *LmhpFragmentationPackageFactory( void )
@@ -218,6 +276,12 @@ static void LmhpFragmentationInit( void *params, uint8_t *dataBuffer, uint8_t da
         TxDelayTime = 0;
         // Initialize Fragmentation delay timer.
         TimerInit( &FragmentTxDelayTimer, OnFragmentTxDelay );
+        // No fragmentation session is set up yet
+        for( uint8_t i = 0; i < FRAGMENTATION_MAX_SESSIONS; i++ )
+        {
+            FragSessionData[i].FragGroupData.IsActive = false;
+            FragSessionData[i].FragDecoderPorcessStatus = FRAG_SESSION_NOT_STARTED;
+        }
     }
     else
     {
@@ -305,7 +369,12 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
                 uint8_t participants = fragIndex & 0x01;
 
                 fragIndex >>= 1;
-                FragSessionData[fragIndex].FragDecoderStatus = FragDecoderGetStatus( );
+                if( fragIndex >= FRAGMENTATION_MAX_SESSIONS )
+                {
+                    // Unknown fragmentation session. Don't process command.
+                    break;
+                }
+                FragSessionData[fragIndex].FragDecoderStatus = FragDecoderGetStatus( &FragSessionData[fragIndex].FragDecoder );
 
                 if( ( participants == 1 ) ||
                     ( ( participants == 0 ) && ( FragSessionData[fragIndex].FragDecoderStatus.FragNbLost > 0 ) ) )
@@ -330,55 +399,69 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
                     // Multicast channel. Don't process command.
                     break;
                 }
-                FragSessionData_t fragSessionData;
+                FragGroupData_t fragGroupData;
+                uint8_t fragIndex = 0;
+                uint32_t maxFileSize = 0;
                 uint8_t status = 0x00;
 
-                fragSessionData.FragGroupData.FragSession.Value = mcpsIndication->Buffer[cmdIndex++];
+                fragGroupData.FragSession.Value = mcpsIndication->Buffer[cmdIndex++];
                 
-                fragSessionData.FragGroupData.FragNb =  ( mcpsIndication->Buffer[cmdIndex++] << 0 ) & 0x00FF;
-                fragSessionData.FragGroupData.FragNb |= ( mcpsIndication->Buffer[cmdIndex++] << 8 ) & 0xFF00;
+                fragGroupData.FragNb =  ( mcpsIndication->Buffer[cmdIndex++] << 0 ) & 0x00FF;
+                fragGroupData.FragNb |= ( mcpsIndication->Buffer[cmdIndex++] << 8 ) & 0xFF00;
 
-                fragSessionData.FragGroupData.FragSize = mcpsIndication->Buffer[cmdIndex++];
+                fragGroupData.FragSize = mcpsIndication->Buffer[cmdIndex++];
 
-                fragSessionData.FragGroupData.Control.Value = mcpsIndication->Buffer[cmdIndex++];
+                fragGroupData.Control.Value = mcpsIndication->Buffer[cmdIndex++];
 
-                fragSessionData.FragGroupData.Padding = mcpsIndication->Buffer[cmdIndex++];
+                fragGroupData.Padding = mcpsIndication->Buffer[cmdIndex++];
 
-                fragSessionData.FragGroupData.Descriptor =  ( mcpsIndication->Buffer[cmdIndex++] << 0  ) & 0x000000FF;
-                fragSessionData.FragGroupData.Descriptor += ( mcpsIndication->Buffer[cmdIndex++] << 8  ) & 0x0000FF00;
-                fragSessionData.FragGroupData.Descriptor += ( mcpsIndication->Buffer[cmdIndex++] << 16 ) & 0x00FF0000;
-                fragSessionData.FragGroupData.Descriptor += ( mcpsIndication->Buffer[cmdIndex++] << 24 ) & 0xFF000000;
+                fragGroupData.Descriptor =  ( mcpsIndication->Buffer[cmdIndex++] << 0  ) & 0x000000FF;
+                fragGroupData.Descriptor += ( mcpsIndication->Buffer[cmdIndex++] << 8  ) & 0x0000FF00;
+                fragGroupData.Descriptor += ( mcpsIndication->Buffer[cmdIndex++] << 16 ) & 0x00FF0000;
+                fragGroupData.Descriptor += ( mcpsIndication->Buffer[cmdIndex++] << 24 ) & 0xFF000000;
 
-                if( fragSessionData.FragGroupData.Control.Fields.FragAlgo > 0 )
+                if( fragGroupData.Control.Fields.FragAlgo > 0 )
                 {
                     status |= 0x01; // Encoding unsupported
                 }
 
-#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
-                if( ( fragSessionData.FragGroupData.FragNb > FRAG_MAX_NB ) || 
-                    ( fragSessionData.FragGroupData.FragSize > FRAG_MAX_SIZE ) ||
-                    ( ( fragSessionData.FragGroupData.FragNb * fragSessionData.FragGroupData.FragSize ) > FragDecoderGetMaxFileSize( ) ) )
+                fragIndex = fragGroupData.FragSession.Fields.FragIndex;
+                status |= ( fragIndex << 6 ) & 0xC0;
+                if( fragIndex >= FRAGMENTATION_MAX_SESSIONS )
                 {
-                    status |= 0x02; // Not enough Memory
+                    status |= 0x04; // FragSession index not supported
                 }
-#else
-                if( ( fragSessionData.FragGroupData.FragNb > FRAG_MAX_NB ) || 
-                    ( fragSessionData.FragGroupData.FragSize > FRAG_MAX_SIZE ) ||
-                    ( ( fragSessionData.FragGroupData.FragNb * fragSessionData.FragGroupData.FragSize ) > LmhpFragmentationParams->BufferSize ) )
+                else
                 {
-                    status |= 0x02; // Not enough Memory
-                }
+#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
+                    if( LmhpFragmentationParams->Sessions[fragIndex].DecoderCallbacks.FragDecoderWrite == NULL )
+                    {
+                        status |= 0x04; // No storage for this FragSession index
+                    }
+                    maxFileSize = FragDecoderGetMaxFileSize( );
+                    if( LmhpFragmentationParams->Sessions[fragIndex].MaxFileSize != 0 )
+                    {
+                        maxFileSize = MIN( maxFileSize, LmhpFragmentationParams->Sessions[fragIndex].MaxFileSize );
+                    }
+#else
+                    if( LmhpFragmentationParams->Sessions[fragIndex].Buffer == NULL )
+                    {
+                        status |= 0x04; // No storage for this FragSession index
+                    }
+                    maxFileSize = LmhpFragmentationParams->Sessions[fragIndex].BufferSize;
 #endif
-                status |= ( fragSessionData.FragGroupData.FragSession.Fields.FragIndex << 6 ) & 0xC0;
-                if( fragSessionData.FragGroupData.FragSession.Fields.FragIndex >= FRAGMENTATION_MAX_SESSIONS )
-                {
-                    status |= 0x04; // FragSession index not supported
+                    if( ( fragGroupData.FragNb > FRAG_MAX_NB ) || 
+                        ( fragGroupData.FragSize > FRAG_MAX_SIZE ) ||
+                        ( ( fragGroupData.FragNb * fragGroupData.FragSize ) > maxFileSize ) )
+                    {
+                        status |= 0x02; // Not enough Memory
+                    }
                 }
 
                 // Descriptor is not really defined in the specification
                 // Not clear how to handle this.
                 // Currently the descriptor is always correct
-                if( fragSessionData.FragGroupData.Descriptor != 0x01020304 )
+                if( fragGroupData.Descriptor != 0x01020304 )
                 {
                     //status |= 0x08; // Wrong Descriptor
                 }
@@ -386,19 +469,29 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
                 if( ( status & 0x0F ) == 0 )
                 {
                     // The FragSessionSetup is accepted
-                    fragSessionData.FragGroupData.IsActive = true;
-                    fragSessionData.FragDecoderPorcessStatus = FRAG_SESSION_ONGOING;
-                    FragSessionData[fragSessionData.FragGroupData.FragSession.Fields.FragIndex] = fragSessionData;
+                    FragSessionData[fragIndex].FragGroupData = fragGroupData;
+                    FragSessionData[fragIndex].FragGroupData.IsActive = true;
+                    FragSessionData[fragIndex].FragDecoderPorcessStatus = FRAG_SESSION_ONGOING;
+                    FragSessionData[fragIndex].DigestFragNb = 0;
+                    Sha256Init( &FragSessionData[fragIndex].DigestCtx );
+                    FragSessionData[fragIndex].IsCmacValid = ( LmhpFragmentationParams->IsCmacEnabled == true ) &&
+                        ( SecureElementCmacInit( &FragSessionData[fragIndex].CmacCtx, LmhpFragmentationParams->CmacKeyID ) == SECURE_ELEMENT_SUCCESS );
 #if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
-                    FragDecoderInit( fragSessionData.FragGroupData.FragNb,
-                                     fragSessionData.FragGroupData.FragSize,
-                                     &LmhpFragmentationParams->DecoderCallbacks );
+                    FragDecoderInit( &FragSessionData[fragIndex].FragDecoder,
+                                     fragGroupData.FragNb,
+                                     fragGroupData.FragSize,
+                                     &LmhpFragmentationParams->Sessions[fragIndex].DecoderCallbacks );
 #else
-                    FragDecoderInit( fragSessionData.FragGroupData.FragNb,
-                                     fragSessionData.FragGroupData.FragSize,
-                                     LmhpFragmentationParams->Buffer,
-                                     LmhpFragmentationParams->BufferSize );
+                    FragDecoderInit( &FragSessionData[fragIndex].FragDecoder,
+                                     fragGroupData.FragNb,
+                                     fragGroupData.FragSize,
+                                     LmhpFragmentationParams->Sessions[fragIndex].Buffer,
+                                     LmhpFragmentationParams->Sessions[fragIndex].BufferSize );
 #endif
+                    if( LmhpFragmentationParams->OnSetup != NULL )
+                    {
+                        LmhpFragmentationParams->OnSetup( fragIndex, fragGroupData.FragNb, fragGroupData.FragSize );
+                    }
                 }
                 LmhpFragmentationState.DataBuffer[dataBufferIndex++] = FRAGMENTATION_FRAG_SESSION_SETUP_ANS;
                 LmhpFragmentationState.DataBuffer[dataBufferIndex++] = status;
@@ -459,11 +552,19 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
 
                 if( FragSessionData[fragIndex].FragDecoderPorcessStatus == FRAG_SESSION_ONGOING )
                 {
-                    FragSessionData[fragIndex].FragDecoderPorcessStatus = FragDecoderProcess( fragCounter, &mcpsIndication->Buffer[cmdIndex] );
-                    FragSessionData[fragIndex].FragDecoderStatus = FragDecoderGetStatus( );
+                    TRACE_POINT_BEGIN( TRACE_POINT_FRAG_DECODER );
+                    FragSessionData[fragIndex].FragDecoderPorcessStatus = FragDecoderProcess( &FragSessionData[fragIndex].FragDecoder, fragCounter, &mcpsIndication->Buffer[cmdIndex] );
+                    TRACE_POINT_END( TRACE_POINT_FRAG_DECODER );
+                    FragSessionData[fragIndex].FragDecoderStatus = FragDecoderGetStatus( &FragSessionData[fragIndex].FragDecoder );
+                    FragSessionDigestUpdate( fragIndex, fragCounter, &mcpsIndication->Buffer[cmdIndex] );
+                    if( FragSessionData[fragIndex].FragDecoderPorcessStatus >= 0 )
+                    {
+                        FragSessionDigestFinalize( fragIndex );
+                    }
                     if( LmhpFragmentationParams->OnProgress != NULL )
                     {
-                        LmhpFragmentationParams->OnProgress( FragSessionData[fragIndex].FragDecoderStatus.FragNbRx,
+                        LmhpFragmentationParams->OnProgress( fragIndex,
+                                                             FragSessionData[fragIndex].FragDecoderStatus.FragNbRx,
                                                              FragSessionData[fragIndex].FragGroupData.FragNb,
                                                              FragSessionData[fragIndex].FragGroupData.FragSize,
                                                              FragSessionData[fragIndex].FragDecoderStatus.FragNbLost );
@@ -478,12 +579,18 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
                         if( LmhpFragmentationParams->OnDone != NULL )
                         {
 #if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
-                            LmhpFragmentationParams->OnDone( FragSessionData[fragIndex].FragDecoderPorcessStatus,
-                                                            ( FragSessionData[fragIndex].FragGroupData.FragNb * FragSessionData[fragIndex].FragGroupData.FragSize ) - FragSessionData[fragIndex].FragGroupData.Padding );
+                            LmhpFragmentationParams->OnDone( fragIndex,
+                                                            FragSessionData[fragIndex].FragDecoderPorcessStatus,
+                                                            ( FragSessionData[fragIndex].FragGroupData.FragNb * FragSessionData[fragIndex].FragGroupData.FragSize ) - FragSessionData[fragIndex].FragGroupData.Padding,
+                                                            FragSessionData[fragIndex].Digest,
+                                                            ( FragSessionData[fragIndex].IsCmacValid == true ) ? FragSessionData[fragIndex].Cmac : NULL );
 #else
-                            LmhpFragmentationParams->OnDone( FragSessionData[fragIndex].FragDecoderPorcessStatus,
-                                                            LmhpFragmentationParams->Buffer,
-                                                            ( FragSessionData[fragIndex].FragGroupData.FragNb * FragSessionData[fragIndex].FragGroupData.FragSize ) - FragSessionData[fragIndex].FragGroupData.Padding );
+                            LmhpFragmentationParams->OnDone( fragIndex,
+                                                            FragSessionData[fragIndex].FragDecoderPorcessStatus,
+                                                            LmhpFragmentationParams->Sessions[fragIndex].Buffer,
+                                                            ( FragSessionData[fragIndex].FragGroupData.FragNb * FragSessionData[fragIndex].FragGroupData.FragSize ) - FragSessionData[fragIndex].FragGroupData.Padding,
+                                                            FragSessionData[fragIndex].Digest,
+                                                            ( FragSessionData[fragIndex].IsCmacValid == true ) ? FragSessionData[fragIndex].Cmac : NULL );
 #endif
                         }
                     }
@@ -498,6 +605,8 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
         }
     }
 
+    FragSessionUpdateRxCMode( );
+
     // After processing the commands, if the end-node has to reply back then a flag is checked if the
     // reply is to be sent immediately or with a delay.
     // In some scenarios it is not desired that multiple end-notes send uplinks at the same time to
@@ -521,6 +630,7 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
             TxDelayTime = randr( 0, 1000 ) * ( 1 << ( blockAckDelay + 4 ) );
             DelayedReplyAppData = cmdReplyAppData;
             LmhpFragmentationState.TxDelayState = FRAGMENTATION_TX_DELAY_STATE_START;
+            LmhpFragmentationPackage.OnProcessRequest( PACKAGE_ID_FRAGMENTATION );
         }
         else
         {
@@ -529,3 +639,90 @@ static void LmhpFragmentationOnMcpsIndication( McpsIndication_t *mcpsIndication
         }
     }
 }
+
+static void FragSessionDigestUpdate( uint8_t fragIndex, uint16_t fragCounter, uint8_t *rawData )
+{
+    FragSessionData_t *session = &FragSessionData[fragIndex];
+    uint32_t fileSize = ( session->FragGroupData.FragNb * session->FragGroupData.FragSize ) - session->FragGroupData.Padding;
+
+    // Only the fragments received in order, without any loss before them,
+    // are known to be final at this point.
+    if( ( session->FragDecoderStatus.FragNbLost != 0 ) ||
+        ( fragCounter != ( session->DigestFragNb + 1 ) ) ||
+        ( fragCounter > session->FragGroupData.FragNb ) )
+    {
+        return;
+    }
+    FragSessionDigestAdd( fragIndex, rawData,
+                          MIN( session->FragGroupData.FragSize, fileSize - ( session->DigestFragNb * session->FragGroupData.FragSize ) ) );
+    session->DigestFragNb++;
+}
+
+static void FragSessionDigestAdd( uint8_t fragIndex, uint8_t *data, uint32_t size )
+{
+    FragSessionData_t *session = &FragSessionData[fragIndex];
+
+    Sha256Update( &session->DigestCtx, data, size );
+    if( ( session->IsCmacValid == true ) &&
+        ( SecureElementCmacUpdate( &session->CmacCtx, data, size ) != SECURE_ELEMENT_SUCCESS ) )
+    {
+        session->IsCmacValid = false;
+    }
+}
+
+static void FragSessionDigestFinalize( uint8_t fragIndex )
+{
+    FragSessionData_t *session = &FragSessionData[fragIndex];
+    uint32_t fileSize = ( session->FragGroupData.FragNb * session->FragGroupData.FragSize ) - session->FragGroupData.Padding;
+#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
+    uint8_t row[FRAG_MAX_SIZE];
+#endif
+
+    // Hash the fragments recovered by the decoder
+    for( ; session->DigestFragNb < session->FragGroupData.FragNb; session->DigestFragNb++ )
+    {
+        uint32_t addr = session->DigestFragNb * session->FragGroupData.FragSize;
+        uint32_t size = MIN( session->FragGroupData.FragSize, fileSize - addr );
+
+#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
+        if( LmhpFragmentationParams->Sessions[fragIndex].DecoderCallbacks.FragDecoderRead == NULL )
+        {
+            break;
+        }
+        LmhpFragmentationParams->Sessions[fragIndex].DecoderCallbacks.FragDecoderRead( addr, row, size );
+        FragSessionDigestAdd( fragIndex, row, size );
+#else
+        FragSessionDigestAdd( fragIndex, &LmhpFragmentationParams->Sessions[fragIndex].Buffer[addr], size );
+#endif
+    }
+    Sha256Final( &session->DigestCtx, session->Digest );
+    if( ( session->IsCmacValid == true ) &&
+        ( SecureElementCmacFinal( &session->CmacCtx, session->Cmac ) != SECURE_ELEMENT_SUCCESS ) )
+    {
+        session->IsCmacValid = false;
+    }
+}
+
+static void FragSessionUpdateRxCMode( void )
+{
+    MibRequestConfirm_t mibReq;
+    bool isOngoing = false;
+
+    for( uint8_t i = 0; i < FRAGMENTATION_MAX_SESSIONS; i++ )
+    {
+        if( ( FragSessionData[i].FragGroupData.IsActive == true ) &&
+            ( FragSessionData[i].FragDecoderPorcessStatus == FRAG_SESSION_ONGOING ) )
+        {
+            isOngoing = true;
+        }
+    }
+    if( isOngoing != LmhpFragmentationState.IsRxCContinuousForced )
+    {
+        mibReq.Type = MIB_RXC_FORCE_CONTINUOUS;
+        mibReq.Param.RxCForceContinuous = isOngoing;
+        if( LoRaMacMibSetRequestConfirm( &mibReq ) == LORAMAC_STATUS_OK )
+        {
+            LmhpFragmentationState.IsRxCContinuousForced = isOngoing;
+        }
+    }
+}
@@ -26,6 +26,8 @@
 #include "LmHandlerTypes.h"
 #include "LmhPackage.h"
 #include "FragDecoder.h"
+#include "sha256.h"
+#include "secure-element.h"
 
 /*!
  * Fragmentation data block transport package identifier.
@@ -35,15 +37,28 @@
 #define PACKAGE_ID_FRAGMENTATION                    3
 
 /*!
- * Fragmentation package parameters
+ * Maximum number of concurrent fragmentation sessions.
+ *
+ * \remark The FragIndex field used to address a session is 2 bits wide.
  */
-typedef struct LmhpFragmentationParams_s
+#define FRAGMENTATION_MAX_SESSIONS                  4
+
+/*!
+ * Fragmentation session storage parameters
+ */
+typedef struct LmhpFragmentationSessionParams_s
 {
 #if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
     /*!
-     * FragDecoder Write/Read function callbacks
+     * FragDecoder Write/Read function callbacks. Addresses are relative to
+     * the start of the session file.
      */
     FragDecoderCallbacks_t DecoderCallbacks;
+    /*!
+     * Memory available for the session file. Set to 0 to use
+     * \ref FragDecoderGetMaxFileSize.
+     */
+    uint32_t MaxFileSize;
 #else
     /*!
      * Pointer to the un-fragmented received buffer.
@@ -54,36 +69,78 @@ typedef struct LmhpFragmentationParams_s
      */
     uint32_t BufferSize;
 #endif
+}LmhpFragmentationSessionParams_t;
+
+/*!
+ * Fragmentation package parameters
+ */
+typedef struct LmhpFragmentationParams_s
+{
+    /*!
+     * Storage of each fragmentation session, indexed by FragIndex.
+     *
+     * \remark A session setup is refused for indexes without storage.
+     */
+    LmhpFragmentationSessionParams_t Sessions[FRAGMENTATION_MAX_SESSIONS];
+    /*!
+     * Set to also compute the AES-CMAC of the session files
+     */
+    bool IsCmacEnabled;
+    /*!
+     * Secure element key of the session files AES-CMAC
+     */
+    KeyIdentifier_t CmacKeyID;
+    /*!
+     * Notifies that a fragmentation session is set up
+     *
+     * \param [IN] fragIndex Fragmentation session index
+     * \param [IN] fragNb    Number of fragments
+     * \param [IN] fragSize  Size of fragments
+     */
+    void ( *OnSetup )( uint8_t fragIndex, uint16_t fragNb, uint8_t fragSize );
     /*!
-     * Notifies the progress of the current fragmentation session
+     * Notifies the progress of a fragmentation session
      *
+     * \param [IN] fragIndex   Fragmentation session index
      * \param [IN] fragCounter Fragment counter
      * \param [IN] fragNb      Number of fragments
      * \param [IN] fragSize    Size of fragments
      * \param [IN] fragNbLost  Number of lost fragments
      */
-    void ( *OnProgress )( uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost );
+    void ( *OnProgress )( uint8_t fragIndex, uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost );
 #if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
     /*!
-     * Notifies that the fragmentation session is finished
+     * Notifies that a fragmentation session is finished
      *
-     * \param [IN] status Fragmentation session status [FRAG_SESSION_ONGOING,
-     *                                                  FRAG_SESSION_FINISHED or
-     *                                                  FragDecoder.Status.FragNbLost]
-     * \param [IN] size   Received file size
+     * \param [IN] fragIndex Fragmentation session index
+     * \param [IN] status    Fragmentation session status [FRAG_SESSION_ONGOING,
+     *                                                     FRAG_SESSION_FINISHED or
+     *                                                     FragDecoder.Status.FragNbLost]
+     * \param [IN] size      Received file size
+     * \param [IN] digest    SHA-256 digest of the received file
+     *                       [SHA256_DIGEST_SIZE bytes]
+     * \param [IN] cmac      AES-CMAC of the received file [SE_CMAC_SIZE bytes].
+     *                       NULL when IsCmacEnabled is not set or the secure
+     *                       element failed.
      */
-    void ( *OnDone )( int32_t status, uint32_t size );
+    void ( *OnDone )( uint8_t fragIndex, int32_t status, uint32_t size, uint8_t *digest, uint8_t *cmac );
 #else
     /*!
-     * Notifies that the fragmentation session is finished
+     * Notifies that a fragmentation session is finished
      *
-     * \param [IN] status Fragmentation session status [FRAG_SESSION_ONGOING,
-     *                                                  FRAG_SESSION_FINISHED or
-     *                                                  FragDecoder.Status.FragNbLost]
-     * \param [IN] file   Pointer to the reception file buffer
-     * \param [IN] size   Received file size
+     * \param [IN] fragIndex Fragmentation session index
+     * \param [IN] status    Fragmentation session status [FRAG_SESSION_ONGOING,
+     *                                                     FRAG_SESSION_FINISHED or
+     *                                                     FragDecoder.Status.FragNbLost]
+     * \param [IN] file      Pointer to the reception file buffer
+     * \param [IN] size      Received file size
+     * \param [IN] digest    SHA-256 digest of the received file
+     *                       [SHA256_DIGEST_SIZE bytes]
+     * \param [IN] cmac      AES-CMAC of the received file [SE_CMAC_SIZE bytes].
+     *                       NULL when IsCmacEnabled is not set or the secure
+     *                       element failed.
      */
-    void ( *OnDone )( int32_t status, uint8_t *file, uint32_t size );
+    void ( *OnDone )( uint8_t fragIndex, int32_t status, uint8_t *file, uint32_t size, uint8_t *digest, uint8_t *cmac );
 #endif
 }LmhpFragmentationParams_t;
 
@@ -194,6 +194,7 @@ static LmhPackage_t LmhpRemoteMcastSetupPackage =
     .OnSendRequest = NULL,                                     // To be initialized by LmHandler
     .OnDeviceTimeRequest = NULL,                               // To be initialized by LmHandler
     .OnSysTimeUpdate = NULL,                                   // To be initialized by LmHandler
+    .OnProcessRequest = NULL,                                  // To be initialized by LmHandler
 };
 
 LmhPackage_t *LmhpRemoteMcastSetupPackageFactory( void )
@@ -449,6 +450,7 @@ static void OnSessionStartTimer( void *context )
     TimerStop( &SessionStartTimer );
 
     LmhpRemoteMcastSetupState.SessionState = REMOTE_MCAST_SETUP_SESSION_STATE_START;
+    LmhpRemoteMcastSetupPackage.OnProcessRequest( PACKAGE_ID_REMOTE_MCAST_SETUP );
 }
 
 static void OnSessionStopTimer( void *context )
@@ -456,4 +458,5 @@ static void OnSessionStopTimer( void *context )
     TimerStop( &SessionStopTimer );
 
     LmhpRemoteMcastSetupState.SessionState = REMOTE_MCAST_SETUP_SESSION_STATE_STOP;
+    LmhpRemoteMcastSetupPackage.OnProcessRequest( PACKAGE_ID_REMOTE_MCAST_SETUP );
 }
@@ -25,6 +25,8 @@
 #include <stdio.h>
 #include "utilities.h"
 #include "timer.h"
+#include "sha256.h"
+#include "secure-element.h"
 
 #include "LmHandlerMsgDisplay.h"
 
@@ -56,6 +58,7 @@ const char* MacStatusStrings[] =
     "ClassB error",                  // LORAMAC_STATUS_CLASS_B_ERROR
     "Confirm queue error",           // LORAMAC_STATUS_CONFIRM_QUEUE_ERROR
     "Multicast group undefined",     // LORAMAC_STATUS_MC_GROUP_UNDEFINED
+    "Carrier sense ongoing",         // LORAMAC_STATUS_CARRIER_SENSE_ONGOING
     "Unknown error",                 // LORAMAC_STATUS_ERROR
 };
 
@@ -266,6 +269,7 @@ void DisplayJoinRequestUpdate( LmHandlerJoinParams_t *params )
 void DisplayTxUpdate( LmHandlerTxParams_t *params )
 {
     MibRequestConfirm_t mibGet;
+    ChannelParams_t channel;
 
     if( params->IsMcpsConfirm == 0 )
     {
@@ -301,10 +305,9 @@ void DisplayTxUpdate( LmHandlerTxParams_t *params )
     printf( "\n" );
     printf( "DATA RATE   : DR_%d\n", params->Datarate );
 
-    mibGet.Type  = MIB_CHANNELS;
-    if( LoRaMacMibGetRequestConfirm( &mibGet ) == LORAMAC_STATUS_OK )
+    if( LoRaMacChannelGet( params->Channel, &channel ) == LORAMAC_STATUS_OK )
     {
-        printf( "U/L FREQ    : %lu\n", mibGet.Param.ChannelList[params->Channel].Frequency );
+        printf( "U/L FREQ    : %lu\n", channel.Frequency );
     }
 
     printf( "TX POWER    : %d\n", params->TxPower );
@@ -424,6 +427,25 @@ void DisplayClassUpdate( DeviceClass_t deviceClass )
     printf( "\n\n###### ===== Switch to Class %c done.  ===== ######\n\n", "ABC"[deviceClass] );
 }
 
+void DisplayFileDigest( uint8_t* digest, uint8_t* cmac )
+{
+    printf( "SHA-256     : " );
+    for( uint8_t i = 0; i < SHA256_DIGEST_SIZE; i++ )
+    {
+        printf( "%02X", digest[i] );
+    }
+    printf( "\n" );
+    if( cmac != NULL )
+    {
+        printf( "AES-CMAC    : " );
+        for( uint8_t i = 0; i < SE_CMAC_SIZE; i++ )
+        {
+            printf( "%02X", cmac[i] );
+        }
+        printf( "\n" );
+    }
+}
+
 void DisplayAppInfo( const char* appName, const Version_t* appVersion, const Version_t* gitHubVersion )
 {
     printf( "\n###### ===================================== ######\n\n" );
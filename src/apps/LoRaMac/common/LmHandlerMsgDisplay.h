@@ -94,6 +94,15 @@ void DisplayBeaconUpdate( LoRaMAcHandlerBeaconParams_t* params );
  */
 void DisplayClassUpdate( DeviceClass_t deviceClass );
 
+/*!
+ * \brief Displays the digest of a received file
+ *
+ * \param [IN] digest SHA-256 digest of the file [SHA256_DIGEST_SIZE bytes]
+ * \param [IN] cmac   AES-CMAC of the file [SE_CMAC_SIZE bytes]. Not displayed
+ *                    when NULL.
+ */
+void DisplayFileDigest( uint8_t* digest, uint8_t* cmac );
+
 /*!
  * \brief Displays application information
  */
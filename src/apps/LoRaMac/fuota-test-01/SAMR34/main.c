@@ -132,11 +132,11 @@ static void OnSysTimeUpdate( void );
 static uint8_t FragDecoderWrite( uint32_t addr, uint8_t *data, uint32_t size );
 static uint8_t FragDecoderRead( uint32_t addr, uint8_t *data, uint32_t size );
 #endif
-static void OnFragProgress( uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost );
+static void OnFragProgress( uint8_t fragIndex, uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost );
 #if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
-static void OnFragDone( int32_t status, uint32_t size );
+static void OnFragDone( uint8_t fragIndex, int32_t status, uint32_t size, uint8_t *digest, uint8_t *cmac );
 #else
-static void OnFragDone( int32_t status, uint8_t *file, uint32_t size );
+static void OnFragDone( uint8_t fragIndex, int32_t status, uint8_t *file, uint32_t size, uint8_t *digest, uint8_t *cmac );
 #endif
 static void StartTxProcess( LmHandlerTxEvents_t txEvent );
 static void UplinkProcess( void );
@@ -219,16 +219,24 @@ static uint8_t UnfragmentedData[UNFRAGMENTED_DATA_SIZE];
 
 static LmhpFragmentationParams_t FragmentationParams =
 {
-#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
-    .DecoderCallbacks = 
+    // The test campaign uses fragmentation session 0 only
+    .Sessions[0] =
     {
-        .FragDecoderWrite = FragDecoderWrite,
-        .FragDecoderRead = FragDecoderRead,
-    },
+#if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
+        .DecoderCallbacks =
+        {
+            .FragDecoderWrite = FragDecoderWrite,
+            .FragDecoderRead = FragDecoderRead,
+        },
+        .MaxFileSize = UNFRAGMENTED_DATA_SIZE,
 #else
-    .Buffer = UnfragmentedData,
-    .BufferSize = UNFRAGMENTED_DATA_SIZE,
+        .Buffer = UnfragmentedData,
+        .BufferSize = UNFRAGMENTED_DATA_SIZE,
 #endif
+    },
+    // Printed along with the SHA-256 digest once the file is received
+    .IsCmacEnabled = true,
+    .CmacKeyID = FILE_CMAC_KEY,
     .OnProgress = OnFragProgress,
     .OnDone = OnFragDone
 };
@@ -481,7 +489,7 @@ static uint8_t FragDecoderRead( uint32_t addr, uint8_t *data, uint32_t size )
 }
 #endif
 
-static void OnFragProgress( uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost )
+static void OnFragProgress( uint8_t fragIndex, uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost )
 {
     // Switch LED 1 OFF for each received downlink
     GpioWrite( &Led1, 0 );
@@ -496,7 +504,7 @@ static void OnFragProgress( uint16_t fragCounter, uint16_t fragNb, uint8_t fragS
 }
 
 #if( FRAG_DECODER_FILE_HANDLING_NEW_API == 1 )
-static void OnFragDone( int32_t status, uint32_t size )
+static void OnFragDone( uint8_t fragIndex, int32_t status, uint32_t size, uint8_t *digest, uint8_t *cmac )
 {
     FileRxCrc = Crc32( UnfragmentedData, size );
     IsFileTransferDone = true;
@@ -507,10 +515,12 @@ static void OnFragDone( int32_t status, uint32_t size )
     printf( "######               FINISHED                ######\n");
     printf( "###### ===================================== ######\n");
     printf( "STATUS      : %ld\n", status );
-    printf( "CRC         : %08lX\n\n", FileRxCrc );
+    printf( "CRC         : %08lX\n", FileRxCrc );
+    DisplayFileDigest( digest, cmac );
+    printf( "\n" );
 }
 #else
-static void OnFragDone( int32_t status, uint8_t *file, uint32_t size )
+static void OnFragDone( uint8_t fragIndex, int32_t status, uint8_t *file, uint32_t size, uint8_t *digest, uint8_t *cmac )
 {
     FileRxCrc = Crc32( file, size );
     IsFileTransferDone = true;
@@ -521,7 +531,9 @@ static void OnFragDone( int32_t status, uint8_t *file, uint32_t size )
     printf( "######               FINISHED                ######\n");
     printf( "###### ===================================== ######\n");
     printf( "STATUS      : %ld\n", status );
-    printf( "CRC         : %08lX\n\n", FileRxCrc );
+    printf( "CRC         : %08lX\n", FileRxCrc );
+    DisplayFileDigest( digest, cmac );
+    printf( "\n" );
 }
 #endif
 
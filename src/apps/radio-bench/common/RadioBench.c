@@ -0,0 +1,668 @@
+/*!
+ * \file      RadioBench.c
+ *
+ * \brief     Radio link throughput, latency and packet error rate benchmark
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include "utilities.h"
+#include "delay.h"
+#include "timer.h"
+#include "RadioBench.h"
+
+/*!
+ * Preamble length of the LoRa configurations, symbols
+ */
+#define RADIO_BENCH_LORA_PREAMBLE_LENGTH            8
+
+/*!
+ * Preamble length of the FSK configurations, bytes
+ */
+#define RADIO_BENCH_FSK_PREAMBLE_LENGTH             5
+
+#if defined( RADIO_BENCH_FSK_SSB )
+/*!
+ * The sx127x drivers take the single side bandwidth
+ */
+#define RADIO_BENCH_FSK_BANDWIDTH( bw )             ( ( bw ) / 2 )
+#else
+#define RADIO_BENCH_FSK_BANDWIDTH( bw )             ( bw )
+#endif
+
+/*!
+ * Reception margin in ms added to the time on air of the awaited frame
+ */
+#define RADIO_BENCH_RX_MARGIN                       50
+
+/*!
+ * Time in ms the master waits after the setup acknowledgement so that the
+ * slave switches to the new configuration
+ */
+#define RADIO_BENCH_SETUP_GUARD                     20
+
+/*!
+ * Time in ms the master keeps announcing a configuration after the slave
+ * reception window of the previous one. The configuration is skipped after.
+ */
+#define RADIO_BENCH_SETUP_TIMEOUT                   2000
+
+/*!
+ * Number of echo reception windows without any ping after which the slave
+ * returns to the control configuration
+ */
+#define RADIO_BENCH_SLAVE_WINDOWS                   3
+
+/*!
+ * Frame types, first payload byte
+ */
+#define RADIO_BENCH_FRAME_SETUP                     'S'
+#define RADIO_BENCH_FRAME_SETUP_ACK                 'A'
+#define RADIO_BENCH_FRAME_PING                      'P'
+#define RADIO_BENCH_FRAME_ECHO                      'E'
+
+/*!
+ * Ping and echo header size: type, sequence number, pings received by the
+ * slave
+ */
+#define RADIO_BENCH_HEADER_SIZE                     5
+
+/*!
+ * Configuration used to announce the benchmarked ones: LoRa SF7 125 kHz 4/5
+ */
+static const RadioBenchConfig_t ControlConfig = { MODEM_LORA, 0, 7, 1, RADIO_BENCH_HEADER_SIZE };
+
+/*!
+ * Benchmarked configurations
+ */
+static const RadioBenchConfig_t Configs[] =
+{
+    // Spreading factors
+    { MODEM_LORA, 0, 7, 1, 16 },
+    { MODEM_LORA, 0, 8, 1, 16 },
+    { MODEM_LORA, 0, 9, 1, 16 },
+    { MODEM_LORA, 0, 10, 1, 16 },
+    { MODEM_LORA, 0, 11, 1, 16 },
+    { MODEM_LORA, 0, 12, 1, 16 },
+    // Payload lengths
+    { MODEM_LORA, 0, 7, 1, 64 },
+    { MODEM_LORA, 0, 7, 1, 255 },
+    // Bandwidths
+    { MODEM_LORA, 1, 7, 1, 64 },
+    { MODEM_LORA, 2, 7, 1, 64 },
+    // Coding rates
+    { MODEM_LORA, 0, 7, 4, 64 },
+    // FSK
+    { MODEM_FSK, 100000, 50000, 0, 16 },
+    { MODEM_FSK, 100000, 50000, 0, 64 },
+    { MODEM_FSK, 100000, 50000, 0, 255 },
+};
+
+#define RADIO_BENCH_NB_CONFIGS                      ( sizeof( Configs ) / sizeof( Configs[0] ) )
+
+/*!
+ * Radio events, set from the radio interrupts
+ */
+typedef enum eRadioBenchEvent
+{
+    RADIO_BENCH_EVENT_NONE,
+    RADIO_BENCH_EVENT_TX_DONE,
+    RADIO_BENCH_EVENT_TX_TIMEOUT,
+    RADIO_BENCH_EVENT_RX_DONE,
+    RADIO_BENCH_EVENT_RX_TIMEOUT,
+    RADIO_BENCH_EVENT_RX_ERROR,
+}RadioBenchEvent_t;
+
+/*!
+ * Benchmark phases
+ */
+typedef enum eRadioBenchPhase
+{
+    /*!
+     * Configuration announcement on the control configuration
+     */
+    RADIO_BENCH_PHASE_SETUP,
+    /*!
+     * Pings and echoes on the benchmarked configuration
+     */
+    RADIO_BENCH_PHASE_RUN,
+    /*!
+     * Sweep completed
+     */
+    RADIO_BENCH_PHASE_DONE,
+}RadioBenchPhase_t;
+
+/*!
+ * Benchmark context
+ */
+typedef struct sRadioBenchCtx
+{
+    bool IsMaster;
+    int8_t Power;
+    RadioBenchPhase_t Phase;
+    /*!
+     * Benchmarked configuration index
+     */
+    uint8_t Index;
+    /*!
+     * Configuration index announced by the master and to be used by the slave
+     * once the acknowledgement is sent
+     */
+    int16_t PendingIndex;
+    volatile RadioBenchEvent_t Event;
+    /*!
+     * Time in RTC ticks of the last radio event
+     */
+    volatile TimerTicks_t EventTime;
+    uint8_t Frame[UINT8_MAX];
+    uint8_t FrameSize;
+    /*!
+     * Reception timeout in ms of the echo, or of the setup acknowledgement
+     */
+    uint32_t RxTimeout;
+    /*!
+     * Slave reception window in ms of the benchmarked configuration
+     */
+    uint32_t SlaveWindow;
+    /*!
+     * Time in ms at which the master skips the announced configuration
+     */
+    TimerTime_t SetupDeadline;
+    uint16_t Sequence;
+    /*!
+     * Pings received, slave side
+     */
+    uint16_t PingsReceived;
+    TimerTicks_t PingTime;
+    TimerTicks_t StartTime;
+    uint64_t TurnaroundSum;
+    uint32_t RoundTrips[RADIO_BENCH_NB_PACKETS];
+    RadioBenchResult_t Results[RADIO_BENCH_NB_CONFIGS];
+    uint8_t NbResults;
+}RadioBenchCtx_t;
+
+static RadioBenchCtx_t Ctx;
+
+/*!
+ * Radio events function pointer
+ */
+static RadioEvents_t RadioEvents;
+
+static void OnRadioEvent( RadioBenchEvent_t event )
+{
+    Ctx.EventTime = TimerGetCurrentTicks( );
+    Ctx.Event = event;
+}
+
+static void OnTxDone( void )
+{
+    OnRadioEvent( RADIO_BENCH_EVENT_TX_DONE );
+}
+
+static void OnTxTimeout( void )
+{
+    Radio.Standby( );
+    OnRadioEvent( RADIO_BENCH_EVENT_TX_TIMEOUT );
+}
+
+static void OnRxDone( uint8_t *payload, uint16_t size, int16_t rssi, int8_t snr )
+{
+    // Continuous reception
+    Radio.Standby( );
+    Ctx.FrameSize = MIN( size, sizeof( Ctx.Frame ) );
+    memcpy1( Ctx.Frame, payload, Ctx.FrameSize );
+    OnRadioEvent( RADIO_BENCH_EVENT_RX_DONE );
+}
+
+static void OnRxTimeout( void )
+{
+    Radio.Standby( );
+    OnRadioEvent( RADIO_BENCH_EVENT_RX_TIMEOUT );
+}
+
+static void OnRxError( void )
+{
+    Radio.Standby( );
+    OnRadioEvent( RADIO_BENCH_EVENT_RX_ERROR );
+}
+
+static uint32_t GetTimeOnAir( const RadioBenchConfig_t* config, uint8_t size )
+{
+    if( config->Modem == MODEM_LORA )
+    {
+        return Radio.TimeOnAir( MODEM_LORA, config->Bandwidth, config->Datarate, config->Coderate,
+                                RADIO_BENCH_LORA_PREAMBLE_LENGTH, false, size, true );
+    }
+    return Radio.TimeOnAir( MODEM_FSK, RADIO_BENCH_FSK_BANDWIDTH( config->Bandwidth ), config->Datarate, 0,
+                            RADIO_BENCH_FSK_PREAMBLE_LENGTH, false, size, true );
+}
+
+/*!
+ * \brief Gets the slave reception window of a configuration: a few ping and
+ *        echo exchanges
+ */
+static uint32_t GetSlaveWindow( const RadioBenchConfig_t* config )
+{
+    uint32_t timeOnAir = GetTimeOnAir( config, config->PayloadSize );
+
+    return RADIO_BENCH_SLAVE_WINDOWS * ( ( 2 * timeOnAir ) + RADIO_BENCH_RX_MARGIN );
+}
+
+/*!
+ * \brief Configures the radio and computes the reception timeouts of a
+ *        configuration
+ */
+static void SetConfig( const RadioBenchConfig_t* config )
+{
+    uint32_t timeOnAir = GetTimeOnAir( config, config->PayloadSize );
+    uint32_t txTimeout = ( 2 * timeOnAir ) + 1000;
+
+    if( config->Modem == MODEM_LORA )
+    {
+        Radio.SetTxConfig( MODEM_LORA, Ctx.Power, 0, config->Bandwidth,
+                           config->Datarate, config->Coderate,
+                           RADIO_BENCH_LORA_PREAMBLE_LENGTH, false,
+                           true, 0, 0, false, txTimeout );
+
+        Radio.SetRxConfig( MODEM_LORA, config->Bandwidth, config->Datarate,
+                           config->Coderate, 0, RADIO_BENCH_LORA_PREAMBLE_LENGTH,
+                           0, false, 0, true, 0, 0, false, true );
+    }
+    else
+    {
+        Radio.SetTxConfig( MODEM_FSK, Ctx.Power, config->Datarate / 2, 0,
+                           config->Datarate, 0,
+                           RADIO_BENCH_FSK_PREAMBLE_LENGTH, false,
+                           true, 0, 0, 0, txTimeout );
+
+        Radio.SetRxConfig( MODEM_FSK, RADIO_BENCH_FSK_BANDWIDTH( config->Bandwidth ), config->Datarate,
+                           0, RADIO_BENCH_FSK_BANDWIDTH( ( config->Bandwidth * 5 ) / 3 ), RADIO_BENCH_FSK_PREAMBLE_LENGTH,
+                           0, false, 0, true, 0, 0, false, true );
+    }
+    Radio.SetMaxPayloadLength( config->Modem, UINT8_MAX );
+
+    // The echo has the same size as the ping
+    Ctx.RxTimeout = timeOnAir + RADIO_BENCH_RX_MARGIN;
+    Ctx.SlaveWindow = GetSlaveWindow( config );
+}
+
+static void Send( uint8_t type, uint8_t size )
+{
+    Ctx.Frame[0] = type;
+    for( uint8_t i = RADIO_BENCH_HEADER_SIZE; i < size; i++ )
+    {
+        Ctx.Frame[i] = i;
+    }
+    Radio.Send( Ctx.Frame, size );
+}
+
+static void SendSetup( void )
+{
+    Ctx.Frame[1] = Ctx.Index;
+    Send( RADIO_BENCH_FRAME_SETUP, 2 );
+}
+
+static void SendPing( void )
+{
+    Ctx.Frame[1] = Ctx.Sequence & 0xFF;
+    Ctx.Frame[2] = Ctx.Sequence >> 8;
+    Ctx.Frame[3] = 0;
+    Ctx.Frame[4] = 0;
+    Ctx.PingTime = TimerGetCurrentTicks( );
+    Send( RADIO_BENCH_FRAME_PING, Configs[Ctx.Index].PayloadSize );
+}
+
+/*!
+ * \brief Master: announces the current configuration
+ */
+static void StartSetup( uint32_t previousSlaveWindow )
+{
+    Ctx.Phase = RADIO_BENCH_PHASE_SETUP;
+    SetConfig( &ControlConfig );
+    // The slave may still listen on the previous configuration, or already on
+    // the announced one if the acknowledgement is lost
+    Ctx.SetupDeadline = TimerGetCurrentTime( ) + MAX( previousSlaveWindow, GetSlaveWindow( &Configs[Ctx.Index] ) ) +
+                        RADIO_BENCH_SETUP_TIMEOUT;
+    SendSetup( );
+}
+
+/*!
+ * \brief Master: starts the pings of the current configuration
+ */
+static void StartRun( void )
+{
+    RadioBenchResult_t* result = &Ctx.Results[Ctx.Index];
+
+    memset1( ( uint8_t* )result, 0, sizeof( RadioBenchResult_t ) );
+    result->Index = Ctx.Index;
+    Ctx.TurnaroundSum = 0;
+    Ctx.Sequence = 0;
+
+    Ctx.Phase = RADIO_BENCH_PHASE_RUN;
+    SetConfig( &Configs[Ctx.Index] );
+    DelayMs( RADIO_BENCH_SETUP_GUARD );
+    Ctx.StartTime = TimerGetCurrentTicks( );
+    SendPing( );
+}
+
+static void SortRoundTrips( uint16_t count )
+{
+    for( uint16_t i = 1; i < count; i++ )
+    {
+        uint32_t value = Ctx.RoundTrips[i];
+        uint16_t j = i;
+
+        while( ( j > 0 ) && ( Ctx.RoundTrips[j - 1] > value ) )
+        {
+            Ctx.RoundTrips[j] = Ctx.RoundTrips[j - 1];
+            j--;
+        }
+        Ctx.RoundTrips[j] = value;
+    }
+}
+
+/*!
+ * \brief Gets a nearest rank percentile of the sorted round trips
+ */
+static uint32_t GetPercentile( uint16_t count, uint8_t percent )
+{
+    uint32_t rank = ( ( ( uint32_t )count * percent ) + 99 ) / 100;
+
+    return Ctx.RoundTrips[MAX( rank, 1 ) - 1];
+}
+
+/*!
+ * \brief Prints the permille of lost packets, '-' when nothing was sent
+ */
+static void PrintPer( uint16_t sent, uint16_t received )
+{
+    uint32_t per = 0;
+
+    if( sent == 0 )
+    {
+        printf( "     -" );
+        return;
+    }
+    per = ( ( uint32_t )( sent - MIN( received, sent ) ) * 1000 ) / sent;
+    printf( " %3lu.%lu", ( unsigned long )( per / 10 ), ( unsigned long )( per % 10 ) );
+}
+
+static void PrintResult( const RadioBenchResult_t* result )
+{
+    const RadioBenchConfig_t* config = &Configs[result->Index];
+    uint32_t duration = MAX( result->Duration, 1 );
+    uint32_t packets = result->PeerReceived + result->Received;
+    uint32_t rate = ( packets * 100000 ) / duration;
+
+    if( config->Modem == MODEM_LORA )
+    {
+        printf( "%2u LoRa SF%-2lu BW%-3u CR4/%u %3u", result->Index, ( unsigned long )config->Datarate,
+                125 << config->Bandwidth, config->Coderate + 4, config->PayloadSize );
+    }
+    else
+    {
+        printf( "%2u FSK  %3lukbps %-7s %3u", result->Index, ( unsigned long )( config->Datarate / 1000 ), "", config->PayloadSize );
+    }
+    if( result->Sent == 0 )
+    {
+        printf( " skipped, no setup acknowledgement\n" );
+        return;
+    }
+    printf( " %4lu.%02lu %7lu", ( unsigned long )( rate / 100 ), ( unsigned long )( rate % 100 ),
+            ( unsigned long )( ( ( uint64_t )packets * config->PayloadSize * 8000 ) / duration ) );
+    printf( " %7lu %7lu %7lu %7lu", ( unsigned long )result->RoundTripP50, ( unsigned long )result->RoundTripP90,
+            ( unsigned long )result->RoundTripP99, ( unsigned long )result->RoundTripMax );
+    PrintPer( result->Sent, result->PeerReceived );
+    PrintPer( result->PeerReceived, result->Received );
+    printf( " %6lu %6lu\n", ( unsigned long )result->TurnaroundAvg, ( unsigned long )result->TurnaroundMax );
+}
+
+/*!
+ * \brief Master: completes the current configuration and starts the next one
+ */
+static void NextConfig( void )
+{
+    RadioBenchResult_t* result = &Ctx.Results[Ctx.Index];
+    uint32_t slaveWindow = Ctx.SlaveWindow;
+
+    if( result->Received > 0 )
+    {
+        SortRoundTrips( result->Received );
+        result->RoundTripP50 = GetPercentile( result->Received, 50 );
+        result->RoundTripP90 = GetPercentile( result->Received, 90 );
+        result->RoundTripP99 = GetPercentile( result->Received, 99 );
+        result->RoundTripMax = Ctx.RoundTrips[result->Received - 1];
+    }
+    if( result->Sent > 0 )
+    {
+        result->TurnaroundAvg = Ctx.TurnaroundSum / result->Sent;
+    }
+    Ctx.NbResults = Ctx.Index + 1;
+    PrintResult( result );
+
+    Ctx.Index++;
+    if( Ctx.Index >= RADIO_BENCH_NB_CONFIGS )
+    {
+        Ctx.Phase = RADIO_BENCH_PHASE_DONE;
+        Radio.Sleep( );
+        printf( "\n###### ========== SWEEP COMPLETED ========== ######\n" );
+        return;
+    }
+    StartSetup( slaveWindow );
+}
+
+static void NextPing( void )
+{
+    RadioBenchResult_t* result = &Ctx.Results[Ctx.Index];
+
+    Ctx.Sequence++;
+    if( Ctx.Sequence < RADIO_BENCH_NB_PACKETS )
+    {
+        SendPing( );
+        return;
+    }
+    result->Duration = ( uint32_t )TimerTicks2Ms( TimerGetCurrentTicks( ) - Ctx.StartTime );
+    NextConfig( );
+}
+
+static void MasterProcess( RadioBenchEvent_t event, TimerTicks_t eventTime )
+{
+    RadioBenchResult_t* result = &Ctx.Results[Ctx.Index];
+
+    if( Ctx.Phase == RADIO_BENCH_PHASE_SETUP )
+    {
+        if( event == RADIO_BENCH_EVENT_TX_DONE )
+        {
+            Radio.Rx( Ctx.RxTimeout );
+        }
+        else if( ( event == RADIO_BENCH_EVENT_RX_DONE ) && ( Ctx.FrameSize >= 2 ) &&
+                 ( Ctx.Frame[0] == RADIO_BENCH_FRAME_SETUP_ACK ) && ( Ctx.Frame[1] == Ctx.Index ) )
+        {
+            StartRun( );
+        }
+        else if( ( int32_t )( TimerGetCurrentTime( ) - Ctx.SetupDeadline ) < 0 )
+        {
+            SendSetup( );
+        }
+        else
+        {
+            // No slave, the configuration is skipped
+            memset1( ( uint8_t* )result, 0, sizeof( RadioBenchResult_t ) );
+            result->Index = Ctx.Index;
+            Ctx.SlaveWindow = 0;
+            NextConfig( );
+        }
+        return;
+    }
+
+    switch( event )
+    {
+    case RADIO_BENCH_EVENT_TX_DONE:
+        {
+            uint32_t turnaround = 0;
+
+            result->Sent++;
+            Radio.Rx( Ctx.RxTimeout );
+            turnaround = ( uint32_t )TimerTicks2Us( TimerGetCurrentTicks( ) - eventTime );
+            Ctx.TurnaroundSum += turnaround;
+            result->TurnaroundMax = MAX( result->TurnaroundMax, turnaround );
+        }
+        break;
+    case RADIO_BENCH_EVENT_RX_DONE:
+        if( ( Ctx.FrameSize < RADIO_BENCH_HEADER_SIZE ) || ( Ctx.Frame[0] != RADIO_BENCH_FRAME_ECHO ) ||
+            ( ( Ctx.Frame[1] | ( Ctx.Frame[2] << 8 ) ) != Ctx.Sequence ) )
+        {
+            // Stale echo, the ping is considered lost
+            NextPing( );
+            break;
+        }
+        Ctx.RoundTrips[result->Received++] = ( uint32_t )TimerTicks2Us( eventTime - Ctx.PingTime );
+        result->PeerReceived = Ctx.Frame[3] | ( Ctx.Frame[4] << 8 );
+        NextPing( );
+        break;
+    default:
+        NextPing( );
+        break;
+    }
+}
+
+static void SlaveProcess( RadioBenchEvent_t event )
+{
+    if( Ctx.Phase == RADIO_BENCH_PHASE_SETUP )
+    {
+        if( ( event == RADIO_BENCH_EVENT_RX_DONE ) && ( Ctx.FrameSize >= 2 ) &&
+            ( Ctx.Frame[0] == RADIO_BENCH_FRAME_SETUP ) && ( Ctx.Frame[1] < RADIO_BENCH_NB_CONFIGS ) )
+        {
+            Ctx.PendingIndex = Ctx.Frame[1];
+            Send( RADIO_BENCH_FRAME_SETUP_ACK, 2 );
+        }
+        else if( ( event == RADIO_BENCH_EVENT_TX_DONE ) && ( Ctx.PendingIndex >= 0 ) )
+        {
+            Ctx.Index = Ctx.PendingIndex;
+            Ctx.PendingIndex = -1;
+            Ctx.PingsReceived = 0;
+            Ctx.Phase = RADIO_BENCH_PHASE_RUN;
+            SetConfig( &Configs[Ctx.Index] );
+            Radio.Rx( Ctx.SlaveWindow );
+        }
+        else
+        {
+            Radio.Rx( 0 );
+        }
+        return;
+    }
+
+    switch( event )
+    {
+    case RADIO_BENCH_EVENT_RX_DONE:
+        if( ( Ctx.FrameSize >= RADIO_BENCH_HEADER_SIZE ) && ( Ctx.Frame[0] == RADIO_BENCH_FRAME_PING ) )
+        {
+            Ctx.PingsReceived++;
+            // The echo keeps the sequence number
+            Ctx.Frame[3] = Ctx.PingsReceived & 0xFF;
+            Ctx.Frame[4] = Ctx.PingsReceived >> 8;
+            Send( RADIO_BENCH_FRAME_ECHO, Ctx.FrameSize );
+        }
+        else
+        {
+            Radio.Rx( Ctx.SlaveWindow );
+        }
+        break;
+    case RADIO_BENCH_EVENT_TX_DONE:
+    case RADIO_BENCH_EVENT_RX_ERROR:
+        Radio.Rx( Ctx.SlaveWindow );
+        break;
+    default:
+        // The master moved to the next configuration
+        Ctx.Phase = RADIO_BENCH_PHASE_SETUP;
+        SetConfig( &ControlConfig );
+        Radio.Rx( 0 );
+        break;
+    }
+}
+
+void RadioBenchInit( bool isMaster, uint32_t frequency, int8_t power )
+{
+    memset1( ( uint8_t* )&Ctx, 0, sizeof( Ctx ) );
+    Ctx.IsMaster = isMaster;
+    Ctx.Power = power;
+    Ctx.PendingIndex = -1;
+
+    RadioEvents.TxDone = OnTxDone;
+    RadioEvents.RxDone = OnRxDone;
+    RadioEvents.TxTimeout = OnTxTimeout;
+    RadioEvents.RxTimeout = OnRxTimeout;
+    RadioEvents.RxError = OnRxError;
+
+    Radio.Init( &RadioEvents );
+    Radio.SetChannel( frequency );
+
+    if( isMaster == true )
+    {
+        printf( "\n###### ===== RADIO BENCH %3u PINGS/CONFIG ===== ######\n\n", RADIO_BENCH_NB_PACKETS );
+        printf( "        config           size  pkt/s goodput     rtt p50/p90/p99/max [us]   per [%%] up/down turnaround [us]\n" );
+        StartSetup( 0 );
+    }
+    else
+    {
+        Ctx.Phase = RADIO_BENCH_PHASE_SETUP;
+        SetConfig( &ControlConfig );
+        Radio.Rx( 0 );
+    }
+}
+
+bool RadioBenchProcess( void )
+{
+    RadioBenchEvent_t event = RADIO_BENCH_EVENT_NONE;
+    TimerTicks_t eventTime = 0;
+
+    CRITICAL_SECTION_BEGIN( );
+    event = Ctx.Event;
+    eventTime = Ctx.EventTime;
+    Ctx.Event = RADIO_BENCH_EVENT_NONE;
+    CRITICAL_SECTION_END( );
+
+    if( ( event != RADIO_BENCH_EVENT_NONE ) && ( Ctx.Phase != RADIO_BENCH_PHASE_DONE ) )
+    {
+        if( Ctx.IsMaster == true )
+        {
+            MasterProcess( event, eventTime );
+        }
+        else
+        {
+            SlaveProcess( event );
+        }
+    }
+    return Ctx.Phase != RADIO_BENCH_PHASE_DONE;
+}
+
+const RadioBenchResult_t* RadioBenchGetResult( uint8_t index )
+{
+    if( index >= Ctx.NbResults )
+    {
+        return NULL;
+    }
+    return &Ctx.Results[index];
+}
+
+const RadioBenchConfig_t* RadioBenchGetConfig( uint8_t index )
+{
+    if( index >= RADIO_BENCH_NB_CONFIGS )
+    {
+        return NULL;
+    }
+    return &Configs[index];
+}
@@ -0,0 +1,166 @@
+/*!
+ * \file      RadioBench.h
+ *
+ * \brief     Radio link throughput, latency and packet error rate benchmark
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \defgroup  RADIOBENCH Radio link benchmark
+ *            Sweeps a table of modem configurations between a master and a
+ *            slave node using the generic Radio driver API only.
+ *
+ *            For each configuration the master announces the configuration
+ *            index on the control configuration, the slave acknowledges it and
+ *            both nodes switch to it. The master then sends
+ *            \ref RADIO_BENCH_NB_PACKETS pings, each of them echoed by the
+ *            slave, and prints:
+ *            - pkt/s and goodput: packets and payload bits delivered in both
+ *              directions per second
+ *            - round trip latency percentiles, from the Radio.Send call to the
+ *              echo RxDone event
+ *            - PER of each direction. The echo carries the number of pings
+ *              received by the slave.
+ *            - radio turnaround time, from the TxDone event to the return of
+ *              Radio.Rx
+ *
+ *            The slave returns to the control configuration when it doesn't
+ *            receive any ping for a while.
+ * \{
+ */
+#ifndef __RADIO_BENCH_H__
+#define __RADIO_BENCH_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "radio.h"
+
+/*!
+ * Number of pings sent per configuration
+ */
+#ifndef RADIO_BENCH_NB_PACKETS
+#define RADIO_BENCH_NB_PACKETS                      50
+#endif
+
+/*!
+ * Benchmarked modem configuration
+ */
+typedef struct sRadioBenchConfig
+{
+    RadioModems_t Modem;
+    /*!
+     * LoRa: [0: 125 kHz, 1: 250 kHz, 2: 500 kHz], FSK: double side bandwidth
+     * in Hz
+     */
+    uint32_t Bandwidth;
+    /*!
+     * LoRa: spreading factor [6..12], FSK: bitrate in bps
+     */
+    uint32_t Datarate;
+    /*!
+     * LoRa: [1: 4/5, 2: 4/6, 3: 4/7, 4: 4/8], FSK: unused
+     */
+    uint8_t Coderate;
+    /*!
+     * Ping and echo payload size
+     */
+    uint8_t PayloadSize;
+}RadioBenchConfig_t;
+
+/*!
+ * Results of a configuration
+ */
+typedef struct sRadioBenchResult
+{
+    /*!
+     * Index of the configuration in the sweep
+     */
+    uint8_t Index;
+    /*!
+     * Number of pings sent
+     */
+    uint16_t Sent;
+    /*!
+     * Number of pings received by the slave, as reported by the last echo
+     */
+    uint16_t PeerReceived;
+    /*!
+     * Number of echoes received
+     */
+    uint16_t Received;
+    /*!
+     * Duration of the configuration in ms
+     */
+    uint32_t Duration;
+    /*!
+     * Round trip latency percentiles in us. 0 without any echo.
+     */
+    uint32_t RoundTripP50;
+    uint32_t RoundTripP90;
+    uint32_t RoundTripP99;
+    uint32_t RoundTripMax;
+    /*!
+     * TX done to RX ready turnaround in us
+     */
+    uint32_t TurnaroundAvg;
+    uint32_t TurnaroundMax;
+}RadioBenchResult_t;
+
+/*!
+ * \brief Initializes the radio and starts the benchmark
+ *
+ * \param [IN] isMaster  [true: master node, false: slave node]
+ * \param [IN] frequency RF frequency in Hz
+ * \param [IN] power     TX power in dBm
+ */
+void RadioBenchInit( bool isMaster, uint32_t frequency, int8_t power );
+
+/*!
+ * \brief Runs the benchmark state machine. To be called from the main loop.
+ *
+ * \retval status [true: running, false: the master completed the sweep]
+ */
+bool RadioBenchProcess( void );
+
+/*!
+ * \brief Gets the results of a configuration of the sweep
+ *
+ * \param [IN] index Configuration index
+ *
+ * \retval result Results, NULL when the configuration wasn't benchmarked yet
+ */
+const RadioBenchResult_t* RadioBenchGetResult( uint8_t index );
+
+/*!
+ * \brief Gets a configuration of the sweep
+ *
+ * \param [IN] index Configuration index
+ *
+ * \retval config Configuration, NULL past the end of the sweep
+ */
+const RadioBenchConfig_t* RadioBenchGetConfig( uint8_t index );
+
+/*! \} defgroup RADIOBENCH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RADIO_BENCH_H__
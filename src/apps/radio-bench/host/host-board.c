@@ -0,0 +1,183 @@
+/*!
+ * \file      host-board.c
+ *
+ * \brief     Host board of the radio benchmark: virtual RTC, delays and
+ *            critical sections
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "utilities.h"
+#include "board.h"
+#include "delay-board.h"
+#include "rtc-board.h"
+#include "host-board.h"
+
+/*!
+ * Virtual RTC. The timer value only moves when the main loop waits for an
+ * event or a delay elapses, the benchmark runs faster than real time.
+ */
+static struct
+{
+    uint32_t Now;
+    uint32_t Context;
+    uint32_t Alarm;
+    bool IsAlarmArmed;
+    uint32_t Backup[2];
+}Rtc;
+
+bool HostBoardWaitForEvent( void )
+{
+    uint32_t radioTime = 0;
+    bool isRadioIrq = SimRadioGetPendingIrq( &radioTime );
+
+    if( ( isRadioIrq == true ) &&
+        ( ( Rtc.IsAlarmArmed == false ) || ( ( int32_t )( radioTime - Rtc.Alarm ) <= 0 ) ) )
+    {
+        if( ( int32_t )( radioTime - Rtc.Now ) > 0 )
+        {
+            Rtc.Now = radioTime;
+        }
+        SimRadioIrq( );
+        return true;
+    }
+    if( Rtc.IsAlarmArmed == false )
+    {
+        return false;
+    }
+    if( ( int32_t )( Rtc.Alarm - Rtc.Now ) > 0 )
+    {
+        Rtc.Now = Rtc.Alarm;
+    }
+    Rtc.IsAlarmArmed = false;
+    TimerIrqHandler( );
+    return true;
+}
+
+void HostBoardAdvance( uint32_t ticks )
+{
+    Rtc.Now += ticks;
+}
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+void DelayMsMcu( uint32_t ms )
+{
+    Rtc.Now += RtcMs2Tick( ms );
+}
+
+void RtcInit( void )
+{
+}
+
+uint32_t RtcGetMinimumTimeout( void )
+{
+    return 1;
+}
+
+uint32_t RtcMs2Tick( TimerTime_t milliseconds )
+{
+    return ( uint32_t )( ( ( uint64_t )milliseconds * HOST_RTC_FREQUENCY ) / 1000 );
+}
+
+TimerTime_t RtcTick2Ms( uint32_t tick )
+{
+    return ( TimerTime_t )( ( ( uint64_t )tick * 1000 ) / HOST_RTC_FREQUENCY );
+}
+
+void RtcDelayMs( TimerTime_t milliseconds )
+{
+    DelayMsMcu( milliseconds );
+}
+
+void RtcSetMcuWakeUpTime( void )
+{
+}
+
+int16_t RtcGetMcuWakeUpTime( void )
+{
+    return 0;
+}
+
+void RtcSetAlarm( uint32_t timeout )
+{
+    RtcStartAlarm( timeout );
+}
+
+void RtcStopAlarm( void )
+{
+    Rtc.IsAlarmArmed = false;
+}
+
+void RtcStartAlarm( uint32_t timeout )
+{
+    Rtc.Alarm = Rtc.Context + timeout;
+    Rtc.IsAlarmArmed = true;
+}
+
+uint32_t RtcSetTimerContext( void )
+{
+    Rtc.Context = Rtc.Now;
+    return Rtc.Context;
+}
+
+uint32_t RtcGetTimerContext( void )
+{
+    return Rtc.Context;
+}
+
+uint32_t RtcGetCalendarTime( uint16_t *milliseconds )
+{
+    *milliseconds = ( Rtc.Now % HOST_RTC_FREQUENCY ) / ( HOST_RTC_FREQUENCY / 1000 );
+    return Rtc.Now / HOST_RTC_FREQUENCY;
+}
+
+uint32_t RtcGetTimerValue( void )
+{
+    return Rtc.Now;
+}
+
+uint32_t RtcGetTimerElapsedTime( void )
+{
+    return Rtc.Now - Rtc.Context;
+}
+
+void RtcBkupWrite( uint32_t data0, uint32_t data1 )
+{
+    Rtc.Backup[0] = data0;
+    Rtc.Backup[1] = data1;
+}
+
+void RtcBkupRead( uint32_t* data0, uint32_t* data1 )
+{
+    *data0 = Rtc.Backup[0];
+    *data1 = Rtc.Backup[1];
+}
+
+void RtcProcess( void )
+{
+}
+
+TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
+{
+    return period;
+}
@@ -0,0 +1,81 @@
+/*!
+ * \file      host-board.h
+ *
+ * \brief     Host board of the radio benchmark: virtual RTC and simulated radio
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __HOST_BOARD_H__
+#define __HOST_BOARD_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Virtual RTC ticks per second
+ */
+#define HOST_RTC_FREQUENCY                          1000000
+
+/*!
+ * \brief Waits for the next event: moves the virtual RTC to the earliest of
+ *        the pending alarm and simulated radio interrupt, and runs it
+ *
+ * \retval status [true: interrupt run, false: nothing will ever happen]
+ */
+bool HostBoardWaitForEvent( void );
+
+/*!
+ * \brief Moves the virtual RTC forward, e.g. to account for the time spent by
+ *        a simulated peripheral
+ *
+ * \param [IN] ticks Number of RTC ticks
+ */
+void HostBoardAdvance( uint32_t ticks );
+
+/*!
+ * \brief Gets the time of the next simulated radio interrupt
+ *
+ * \param [OUT] time RTC timer value of the interrupt
+ *
+ * \retval status [true: pending interrupt, false: none]
+ */
+bool SimRadioGetPendingIrq( uint32_t *time );
+
+/*!
+ * \brief Runs the pending simulated radio interrupt
+ */
+void SimRadioIrq( void );
+
+/*!
+ * \brief Sets the link model of the simulated radio
+ *
+ * \param [IN] bitErrorRate  Probability of a bit error. A packet is lost when
+ *                           any of its bits is in error.
+ * \param [IN] peerTurnaround Time in us the simulated peer takes to answer
+ * \param [IN] rxStartup     Time in us Radio.Rx takes to start the receiver
+ */
+void SimRadioSetLink( double bitErrorRate, uint32_t peerTurnaround, uint32_t rxStartup );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HOST_BOARD_H__
@@ -0,0 +1,65 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host build of the radio link benchmark. The master node runs
+ *            against a simulated radio and peer, on a virtual clock.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "RadioBench.h"
+#include "host-board.h"
+
+#define RF_FREQUENCY                                868000000 // Hz
+
+#define TX_OUTPUT_POWER                             14        // dBm
+
+/*!
+ * Default link model: bit error rate, peer turnaround and receiver startup
+ * times in us
+ */
+#define SIM_BIT_ERROR_RATE                          0.00002
+#define SIM_PEER_TURNAROUND                         1000
+#define SIM_RX_STARTUP                              200
+
+/**
+ * Main application entry point.
+ *
+ * Usage: radio-bench-host [bit error rate]
+ */
+int main( int argc, char *argv[] )
+{
+    double bitErrorRate = SIM_BIT_ERROR_RATE;
+
+    if( argc > 1 )
+    {
+        bitErrorRate = strtod( argv[1], NULL );
+    }
+    SimRadioSetLink( bitErrorRate, SIM_PEER_TURNAROUND, SIM_RX_STARTUP );
+
+    RadioBenchInit( true, RF_FREQUENCY, TX_OUTPUT_POWER );
+
+    while( RadioBenchProcess( ) == true )
+    {
+        if( HostBoardWaitForEvent( ) == false )
+        {
+            printf( "Benchmark stalled\n" );
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,449 @@
+/*!
+ * \file      sim-radio.c
+ *
+ * \brief     Simulated radio of the host radio benchmark. The simulated peer
+ *            answers the benchmark setup frames and pings as the slave does.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <math.h>
+#include "utilities.h"
+#include "rtc-board.h"
+#include "radio.h"
+#include "host-board.h"
+
+/*!
+ * Simulated radio interrupts
+ */
+typedef enum eSimRadioIrq
+{
+    SIM_RADIO_IRQ_NONE,
+    SIM_RADIO_IRQ_TX_DONE,
+    SIM_RADIO_IRQ_RX_DONE,
+    SIM_RADIO_IRQ_RX_TIMEOUT,
+}SimRadioIrq_t;
+
+/*!
+ * Simulated radio and peer
+ */
+static struct
+{
+    RadioEvents_t *Events;
+    RadioState_t State;
+    /*!
+     * Modem parameters of the last TX configuration, the benchmark uses the
+     * same ones for the reception
+     */
+    RadioModems_t Modem;
+    uint32_t Bandwidth;
+    uint32_t Datarate;
+    uint8_t Coderate;
+    uint16_t PreambleLen;
+    /*!
+     * Frame being sent
+     */
+    uint8_t Frame[UINT8_MAX];
+    uint8_t FrameSize;
+    /*!
+     * Peer answer to the last frame sent
+     */
+    struct
+    {
+        bool IsPending;
+        bool IsLost;
+        uint8_t Frame[UINT8_MAX];
+        uint8_t Size;
+        uint32_t Start;
+        uint32_t End;
+    }Reply;
+    /*!
+     * Pings received by the peer since the last setup frame
+     */
+    uint16_t PeerReceived;
+    SimRadioIrq_t Irq;
+    uint32_t IrqTime;
+    double BitErrorRate;
+    uint32_t PeerTurnaround;
+    uint32_t RxStartup;
+    uint32_t Seed;
+}Sim =
+{
+    .BitErrorRate = 0.00002,
+    .PeerTurnaround = 1000,
+    .RxStartup = 200,
+    .Seed = 0x2545F491,
+};
+
+/*!
+ * \brief Computes the time on air in us, as the SX126x driver does
+ */
+static uint32_t GetTimeOnAirUs( RadioModems_t modem, uint32_t bandwidth, uint32_t datarate, uint8_t coderate,
+                                uint16_t preambleLen, bool fixLen, uint8_t payloadLen, bool crcOn )
+{
+    uint64_t numerator = 0;
+    uint64_t denominator = 1;
+
+    if( modem == MODEM_FSK )
+    {
+        // Preamble, length field, 3 bytes sync word, payload and CRC
+        numerator = 1000000ULL * ( ( preambleLen << 3 ) + ( ( fixLen == false ) ? 8 : 0 ) + ( 3 << 3 ) +
+                                   ( ( payloadLen + ( ( crcOn == true ) ? 2 : 0 ) ) << 3 ) );
+        denominator = datarate;
+    }
+    else
+    {
+        int32_t crDenom = coderate + 4;
+        bool lowDatareOptimize = ( ( bandwidth == 0 ) && ( ( datarate == 11 ) || ( datarate == 12 ) ) ) ||
+                                 ( ( bandwidth == 1 ) && ( datarate == 12 ) );
+        int32_t ceilDenominator = 4 * datarate;
+        int32_t ceilNumerator = ( payloadLen << 3 ) + ( crcOn ? 16 : 0 ) - ( 4 * datarate ) + ( fixLen ? 0 : 20 );
+        int32_t intermediate = 0;
+
+        if( ( ( datarate == 5 ) || ( datarate == 6 ) ) && ( preambleLen < 12 ) )
+        {
+            preambleLen = 12;
+        }
+        if( datarate > 6 )
+        {
+            ceilNumerator += 8;
+            if( lowDatareOptimize == true )
+            {
+                ceilDenominator = 4 * ( datarate - 2 );
+            }
+        }
+        if( ceilNumerator < 0 )
+        {
+            ceilNumerator = 0;
+        }
+        intermediate = ( ( ceilNumerator + ceilDenominator - 1 ) / ceilDenominator ) * crDenom + preambleLen + 12;
+        if( datarate <= 6 )
+        {
+            intermediate += 2;
+        }
+        numerator = 1000000ULL * ( uint32_t )( ( 4 * intermediate + 1 ) * ( 1 << ( datarate - 2 ) ) );
+        denominator = 125000UL << MIN( bandwidth, 2 );
+    }
+    return ( uint32_t )( ( numerator + denominator - 1 ) / denominator );
+}
+
+static uint32_t GetFrameTimeOnAir( uint8_t size )
+{
+    return GetTimeOnAirUs( Sim.Modem, Sim.Bandwidth, Sim.Datarate, Sim.Coderate, Sim.PreambleLen, false, size, true );
+}
+
+/*!
+ * \brief Draws whether a frame is lost
+ */
+static bool IsFrameLost( uint8_t size )
+{
+    double per = 1.0 - pow( 1.0 - Sim.BitErrorRate, 8.0 * size );
+
+    // xorshift32
+    Sim.Seed ^= Sim.Seed << 13;
+    Sim.Seed ^= Sim.Seed >> 17;
+    Sim.Seed ^= Sim.Seed << 5;
+    return ( ( double )Sim.Seed / 4294967296.0 ) < per;
+}
+
+static void SetIrq( SimRadioIrq_t irq, uint32_t time )
+{
+    Sim.Irq = irq;
+    Sim.IrqTime = time;
+}
+
+/*!
+ * \brief Builds the peer answer to the frame just sent, as the benchmark slave
+ *        does
+ */
+static void SetReply( void )
+{
+    Sim.Reply.IsPending = false;
+    if( ( Sim.FrameSize < 2 ) || ( IsFrameLost( Sim.FrameSize ) == true ) )
+    {
+        return;
+    }
+
+    memcpy1( Sim.Reply.Frame, Sim.Frame, Sim.FrameSize );
+    Sim.Reply.Size = Sim.FrameSize;
+    if( Sim.Frame[0] == 'S' )
+    {
+        Sim.PeerReceived = 0;
+        Sim.Reply.Frame[0] = 'A';
+    }
+    else if( ( Sim.Frame[0] == 'P' ) && ( Sim.FrameSize >= 5 ) )
+    {
+        Sim.PeerReceived++;
+        Sim.Reply.Frame[0] = 'E';
+        Sim.Reply.Frame[3] = Sim.PeerReceived & 0xFF;
+        Sim.Reply.Frame[4] = Sim.PeerReceived >> 8;
+    }
+    else
+    {
+        return;
+    }
+    Sim.Reply.IsPending = true;
+    Sim.Reply.IsLost = IsFrameLost( Sim.Reply.Size );
+    Sim.Reply.Start = RtcGetTimerValue( ) + Sim.PeerTurnaround;
+    Sim.Reply.End = Sim.Reply.Start + GetFrameTimeOnAir( Sim.Reply.Size );
+}
+
+bool SimRadioGetPendingIrq( uint32_t *time )
+{
+    *time = Sim.IrqTime;
+    return Sim.Irq != SIM_RADIO_IRQ_NONE;
+}
+
+void SimRadioIrq( void )
+{
+    SimRadioIrq_t irq = Sim.Irq;
+
+    Sim.Irq = SIM_RADIO_IRQ_NONE;
+    switch( irq )
+    {
+    case SIM_RADIO_IRQ_TX_DONE:
+        Sim.State = RF_IDLE;
+        SetReply( );
+        if( ( Sim.Events != NULL ) && ( Sim.Events->TxDone != NULL ) )
+        {
+            Sim.Events->TxDone( );
+        }
+        break;
+    case SIM_RADIO_IRQ_RX_DONE:
+        if( ( Sim.Events != NULL ) && ( Sim.Events->RxDone != NULL ) )
+        {
+            Sim.Events->RxDone( Sim.Reply.Frame, Sim.Reply.Size, -60, 8 );
+        }
+        break;
+    case SIM_RADIO_IRQ_RX_TIMEOUT:
+        if( ( Sim.Events != NULL ) && ( Sim.Events->RxTimeout != NULL ) )
+        {
+            Sim.Events->RxTimeout( );
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void SimRadioSetLink( double bitErrorRate, uint32_t peerTurnaround, uint32_t rxStartup )
+{
+    Sim.BitErrorRate = bitErrorRate;
+    Sim.PeerTurnaround = peerTurnaround;
+    Sim.RxStartup = rxStartup;
+}
+
+static void RadioInit( RadioEvents_t *events )
+{
+    Sim.Events = events;
+    Sim.State = RF_IDLE;
+}
+
+static RadioState_t RadioGetStatus( void )
+{
+    return Sim.State;
+}
+
+static void RadioSetModem( RadioModems_t modem )
+{
+    Sim.Modem = modem;
+}
+
+static void RadioSetChannel( uint32_t freq )
+{
+}
+
+static bool RadioIsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime )
+{
+    return true;
+}
+
+static uint32_t RadioRandom( void )
+{
+    return Sim.Seed;
+}
+
+static void RadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth,
+                              uint32_t datarate, uint8_t coderate,
+                              uint32_t bandwidthAfc, uint16_t preambleLen,
+                              uint16_t symbTimeout, bool fixLen,
+                              uint8_t payloadLen,
+                              bool crcOn, bool freqHopOn, uint8_t hopPeriod,
+                              bool iqInverted, bool rxContinuous )
+{
+}
+
+static void RadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
+                              uint32_t bandwidth, uint32_t datarate,
+                              uint8_t coderate, uint16_t preambleLen,
+                              bool fixLen, bool crcOn, bool freqHopOn,
+                              uint8_t hopPeriod, bool iqInverted, uint32_t timeout )
+{
+    Sim.Modem = modem;
+    Sim.Bandwidth = bandwidth;
+    Sim.Datarate = datarate;
+    Sim.Coderate = coderate;
+    Sim.PreambleLen = preambleLen;
+}
+
+static bool RadioCheckRfFrequency( uint32_t frequency )
+{
+    return true;
+}
+
+static uint32_t RadioTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
+                                uint32_t datarate, uint8_t coderate,
+                                uint16_t preambleLen, bool fixLen, uint8_t payloadLen,
+                                bool crcOn )
+{
+    return ( GetTimeOnAirUs( modem, bandwidth, datarate, coderate, preambleLen, fixLen, payloadLen, crcOn ) + 999 ) / 1000;
+}
+
+static void RadioSend( uint8_t *buffer, uint8_t size )
+{
+    memcpy1( Sim.Frame, buffer, size );
+    Sim.FrameSize = size;
+    Sim.State = RF_TX_RUNNING;
+    SetIrq( SIM_RADIO_IRQ_TX_DONE, RtcGetTimerValue( ) + GetFrameTimeOnAir( size ) );
+}
+
+static void RadioSleep( void )
+{
+    Sim.State = RF_IDLE;
+    Sim.Irq = SIM_RADIO_IRQ_NONE;
+}
+
+static void RadioStandby( void )
+{
+    Sim.State = RF_IDLE;
+    Sim.Irq = SIM_RADIO_IRQ_NONE;
+}
+
+static void RadioRx( uint32_t timeout )
+{
+    uint32_t start = 0;
+    uint32_t end = 0;
+
+    // Receiver startup: SPI transfers, PLL lock
+    HostBoardAdvance( Sim.RxStartup );
+    start = RtcGetTimerValue( );
+    end = start + RtcMs2Tick( timeout );
+    Sim.State = RF_RX_RUNNING;
+    Sim.Irq = SIM_RADIO_IRQ_NONE;
+
+    if( ( Sim.Reply.IsPending == true ) && ( Sim.Reply.IsLost == false ) &&
+        ( ( int32_t )( Sim.Reply.Start - start ) >= 0 ) &&
+        ( ( timeout == 0 ) || ( ( int32_t )( Sim.Reply.Start - end ) < 0 ) ) )
+    {
+        SetIrq( SIM_RADIO_IRQ_RX_DONE, Sim.Reply.End );
+    }
+    else if( timeout != 0 )
+    {
+        SetIrq( SIM_RADIO_IRQ_RX_TIMEOUT, end );
+    }
+    Sim.Reply.IsPending = false;
+}
+
+static void RadioStartCad( void )
+{
+}
+
+static void RadioSetTxContinuousWave( uint32_t freq, int8_t power, uint16_t time )
+{
+}
+
+static int16_t RadioRssi( RadioModems_t modem )
+{
+    return -120;
+}
+
+static void RadioWrite( uint32_t addr, uint8_t data )
+{
+}
+
+static uint8_t RadioRead( uint32_t addr )
+{
+    return 0;
+}
+
+static void RadioWriteBuffer( uint32_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void RadioReadBuffer( uint32_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void RadioSetMaxPayloadLength( RadioModems_t modem, uint8_t max )
+{
+}
+
+static void RadioSetPublicNetwork( bool enable )
+{
+}
+
+static uint32_t RadioGetWakeupTime( void )
+{
+    return 0;
+}
+
+static void RadioIrqProcess( void )
+{
+}
+
+static void RadioRxBoosted( uint32_t timeout )
+{
+    RadioRx( timeout );
+}
+
+static void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime )
+{
+}
+
+static void RadioStartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+{
+}
+
+const struct Radio_s Radio =
+{
+    .Init = RadioInit,
+    .GetStatus = RadioGetStatus,
+    .SetModem = RadioSetModem,
+    .SetChannel = RadioSetChannel,
+    .IsChannelFree = RadioIsChannelFree,
+    .Random = RadioRandom,
+    .SetRxConfig = RadioSetRxConfig,
+    .SetTxConfig = RadioSetTxConfig,
+    .CheckRfFrequency = RadioCheckRfFrequency,
+    .TimeOnAir = RadioTimeOnAir,
+    .Send = RadioSend,
+    .Sleep = RadioSleep,
+    .Standby = RadioStandby,
+    .Rx = RadioRx,
+    .StartCad = RadioStartCad,
+    .SetTxContinuousWave = RadioSetTxContinuousWave,
+    .Rssi = RadioRssi,
+    .Write = RadioWrite,
+    .Read = RadioRead,
+    .WriteBuffer = RadioWriteBuffer,
+    .ReadBuffer = RadioReadBuffer,
+    .SetMaxPayloadLength = RadioSetMaxPayloadLength,
+    .SetPublicNetwork = RadioSetPublicNetwork,
+    .GetWakeupTime = RadioGetWakeupTime,
+    .IrqProcess = RadioIrqProcess,
+    .RxBoosted = RadioRxBoosted,
+    .SetRxDutyCycle = RadioSetRxDutyCycle,
+    .StartChannelFree = RadioStartChannelFree,
+};
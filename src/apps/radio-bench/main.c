@@ -0,0 +1,114 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Radio link benchmark application
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include "utilities.h"
+#include "board.h"
+#include "radio.h"
+#include "RadioBench.h"
+
+#if defined( REGION_AS923 )
+
+#define RF_FREQUENCY                                923000000 // Hz
+
+#elif defined( REGION_AU915 )
+
+#define RF_FREQUENCY                                915000000 // Hz
+
+#elif defined( REGION_CN470 )
+
+#define RF_FREQUENCY                                470000000 // Hz
+
+#elif defined( REGION_CN779 )
+
+#define RF_FREQUENCY                                779000000 // Hz
+
+#elif defined( REGION_EU433 )
+
+#define RF_FREQUENCY                                433000000 // Hz
+
+#elif defined( REGION_EU868 )
+
+#define RF_FREQUENCY                                868000000 // Hz
+
+#elif defined( REGION_KR920 )
+
+#define RF_FREQUENCY                                920000000 // Hz
+
+#elif defined( REGION_IN865 )
+
+#define RF_FREQUENCY                                865000000 // Hz
+
+#elif defined( REGION_US915 )
+
+#define RF_FREQUENCY                                915000000 // Hz
+
+#elif defined( REGION_RU864 )
+
+#define RF_FREQUENCY                                864000000 // Hz
+
+#else
+    #error "Please define a frequency band in the compiler options."
+#endif
+
+#define TX_OUTPUT_POWER                             14        // dBm
+
+/*!
+ * Node role, the slave node is built with RADIO_BENCH_SLAVE defined
+ */
+#if defined( RADIO_BENCH_SLAVE )
+#define RADIO_BENCH_IS_MASTER                       false
+#else
+#define RADIO_BENCH_IS_MASTER                       true
+#endif
+
+/**
+ * Main application entry point.
+ */
+int main( void )
+{
+    bool isRunning = true;
+
+    // Target board initialization
+    BoardInitMcu( );
+    BoardInitPeriph( );
+
+    RadioBenchInit( RADIO_BENCH_IS_MASTER, RF_FREQUENCY, TX_OUTPUT_POWER );
+
+    while( 1 )
+    {
+        if( ( isRunning == true ) && ( RadioBenchProcess( ) == false ) )
+        {
+            // Sweep completed
+            isRunning = false;
+            Radio.Sleep( );
+        }
+
+        CRITICAL_SECTION_BEGIN( );
+        BoardLowPowerHandler( );
+        CRITICAL_SECTION_END( );
+
+        // Process Radio IRQ
+        if( Radio.IrqProcess != NULL )
+        {
+            Radio.IrqProcess( );
+        }
+    }
+}
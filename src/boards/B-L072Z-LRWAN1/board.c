@@ -28,6 +28,7 @@
 #include "i2c.h"
 #include "uart.h"
 #include "timer.h"
+#include "tracepoint.h"
 #include "board-config.h"
 #include "lpm-board.h"
 #include "rtc-board.h"
@@ -144,8 +145,8 @@ void BoardInitMcu( void )
 
         UsbIsConnected = true;
 
-        FifoInit( &Uart2.FifoTx, Uart2TxBuffer, UART2_FIFO_TX_SIZE );
-        FifoInit( &Uart2.FifoRx, Uart2RxBuffer, UART2_FIFO_RX_SIZE );
+        RingBufferInit( &Uart2.FifoTx, Uart2TxBuffer, UART2_FIFO_TX_SIZE );
+        RingBufferInit( &Uart2.FifoRx, Uart2RxBuffer, UART2_FIFO_RX_SIZE );
         // Configure your terminal for 8 Bits data (7 data bit + 1 parity bit), no parity and no flow ctrl
         UartInit( &Uart2, UART_2, UART_TX, UART_RX );
         UartConfig( &Uart2, RX_TX, 921600, UART_8_BIT, UART_1_STOP_BIT, NO_PARITY, NO_FLOW_CTRL );
@@ -334,6 +335,7 @@ void SysTick_Handler( void )
 {
     HAL_IncTick( );
     HAL_SYSTICK_IRQHandler( );
+    TracePointSysTickHandler( );
 }
 
 uint8_t GetBoardPowerSource( void )
@@ -199,13 +199,10 @@ uint8_t UartMcuPutChar( Uart_t *obj, uint8_t data )
     }
     else
     {
+        // Several contexts may print, serialize the producers
         CRITICAL_SECTION_BEGIN( );
-        TxData = data;
-
-        if( IsFifoFull( &obj->FifoTx ) == false )
+        if( RingBufferPush( &obj->FifoTx, data ) == true )
         {
-            FifoPush( &obj->FifoTx, TxData );
-
             // Trig UART Tx interrupt to start sending the FIFO contents.
             __HAL_UART_ENABLE_IT( &UartHandle, UART_IT_TC );
 
@@ -229,15 +226,11 @@ uint8_t UartMcuGetChar( Uart_t *obj, uint8_t *data )
     }
     else
     {
-        CRITICAL_SECTION_BEGIN( );
-
-        if( IsFifoEmpty( &obj->FifoRx ) == false )
+        // Lock-free, the UART interrupt is the only producer
+        if( RingBufferPop( &obj->FifoRx, data ) == true )
         {
-            *data = FifoPop( &obj->FifoRx );
-            CRITICAL_SECTION_END( );
             return 0;
         }
-        CRITICAL_SECTION_END( );
         return 1;
     }
 }
@@ -302,9 +295,8 @@ uint8_t UartMcuGetBuffer( Uart_t *obj, uint8_t *buffer, uint16_t size, uint16_t
 
 void HAL_UART_TxCpltCallback( UART_HandleTypeDef *handle )
 {
-    if( IsFifoEmpty( &Uart2.FifoTx ) == false )
+    if( RingBufferPop( &Uart2.FifoTx, &TxData ) == true )
     {
-        TxData = FifoPop( &Uart2.FifoTx );
         //  Write one byte to the transmit data register
         HAL_UART_Transmit_IT( &UartHandle, &TxData, 1 );
     }
@@ -317,11 +309,8 @@ void HAL_UART_TxCpltCallback( UART_HandleTypeDef *handle )
 
 void HAL_UART_RxCpltCallback( UART_HandleTypeDef *handle )
 {
-    if( IsFifoFull( &Uart2.FifoRx ) == false )
-    {
-        // Read one byte from the receive data register
-        FifoPush( &Uart2.FifoRx, RxData );
-    }
+    // Read one byte from the receive data register. Dropped when the buffer is full.
+    RingBufferPush( &Uart2.FifoRx, RxData );
 
     if( Uart2.IrqNotify != NULL )
     {
@@ -38,16 +38,6 @@
 //uint8_t TxBuffer[FIFO_TX_SIZE];
 static uint8_t RxBuffer[FIFO_RX_SIZE];
 
-/*!
- * \brief Buffer holding the  raw data received from the gps
- */
-static uint8_t NmeaString[128];
-
-/*!
- * \brief Maximum number of data byte that we will accept from the GPS
- */
-static volatile uint8_t NmeaStringSize = 0;
-
 static Gpio_t GpsPowerEn;
 static Gpio_t GpsPps;
 
@@ -78,8 +68,6 @@ void GpsMcuInvertPpsTrigger( void )
 
 void GpsMcuInit( void )
 {
-    NmeaStringSize = 0;
-
     switch( BoardGetVersion( ).Fields.Major )
     {
         case 2:
@@ -96,7 +84,7 @@ void GpsMcuInit( void )
     GpioInit( &GpsPps, GPS_PPS, PIN_INPUT, PIN_PUSH_PULL, PIN_NO_PULL, 0 );
     GpioSetInterrupt( &GpsPps, IRQ_FALLING_EDGE, IRQ_VERY_LOW_PRIORITY, &GpsMcuOnPpsSignal );
 
-    FifoInit( &Uart1.FifoRx, RxBuffer, FIFO_RX_SIZE );
+    RingBufferInit( &Uart1.FifoRx, RxBuffer, FIFO_RX_SIZE );
     Uart1.IrqNotify = GpsMcuIrqNotify;
 
     GpsMcuStart( );
@@ -134,24 +122,21 @@ void GpsMcuProcess( void )
 void GpsMcuIrqNotify( UartNotifyId_t id )
 {
     uint8_t data;
+    NmeaSentence_t sentence;
+
     if( id == UART_NOTIFY_RX )
     {
-        if( UartGetChar( &Uart1, &data ) == 0 )
+        while( UartGetChar( &Uart1, &data ) == 0 )
         {
-            if( ( data == '$' ) || ( NmeaStringSize >= 127 ) )
-            {
-                NmeaStringSize = 0;
-            }
-
-            NmeaString[NmeaStringSize++] = ( int8_t )data;
+            sentence = GpsParseByte( data );
 
-            if( data == '\n' )
+            // Stop once a sentence holding a position has been decoded
+            if( ( sentence == NMEA_SENTENCE_GGA ) || ( sentence == NMEA_SENTENCE_RMC ) )
             {
-                NmeaString[NmeaStringSize++] = '\0';
-                GpsParseGpsData( ( int8_t* )NmeaString, NmeaStringSize );
                 UartDeInit( &Uart1 );
                 // Enables lowest power modes
                 LpmSetStopMode( LPM_GPS_ID , LPM_ENABLE );
+                break;
             }
         }
     }
@@ -84,6 +84,12 @@ void LpmSetStopMode( LpmId_t id, LpmSetMode_t mode )
 
 void LpmEnterLowPower( void )
 {
+    if( LpmApplyDeadline( ) == false )
+    {
+        // Pending work has to be processed first
+        return;
+    }
+
     if( StopModeDisable != 0 )
     {
         /*!
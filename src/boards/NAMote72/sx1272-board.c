@@ -25,6 +25,7 @@
 #include "board-config.h"
 #include "delay.h"
 #include "radio.h"
+#include "radio-filter.h"
 #include "sx1272-board.h"
 
 /*!
@@ -61,9 +62,12 @@ const struct Radio_s Radio =
     SX1272SetMaxPayloadLength,
     SX1272SetPublicNetwork,
     SX1272GetWakeupTime,
-    NULL, // void ( *IrqProcess )( void )
+    SX1272IrqProcess,
     NULL, // void ( *RxBoosted )( uint32_t timeout ) - SX126x Only
     NULL, // void ( *SetRxDutyCycle )( uint32_t rxTime, uint32_t sleepTime ) - SX126x Only
+    SX1272StartChannelFree,
+    RadioRxFilterSet,
+    RadioRxFilterGetStats,
 };
 
 /*!
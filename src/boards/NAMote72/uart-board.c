@@ -238,13 +238,10 @@ uint8_t UartMcuPutChar( Uart_t *obj, uint8_t data )
     }
     else
     {
+        // Several contexts may print, serialize the producers
         CRITICAL_SECTION_BEGIN( );
-        UartContext[obj->UartId].TxData = data;
-
-        if( IsFifoFull( &obj->FifoTx ) == false )
+        if( RingBufferPush( &obj->FifoTx, data ) == true )
         {
-            FifoPush( &obj->FifoTx, UartContext[obj->UartId].TxData );
-
             // Trig UART Tx interrupt to start sending the FIFO contents.
             __HAL_UART_ENABLE_IT( &UartContext[obj->UartId].UartHandle, UART_IT_TC );
 
@@ -268,15 +265,11 @@ uint8_t UartMcuGetChar( Uart_t *obj, uint8_t *data )
     }
     else
     {
-        CRITICAL_SECTION_BEGIN( );
-
-        if( IsFifoEmpty( &obj->FifoRx ) == false )
+        // Lock-free, the UART interrupt is the only producer
+        if( RingBufferPop( &obj->FifoRx, data ) == true )
         {
-            *data = FifoPop( &obj->FifoRx );
-            CRITICAL_SECTION_END( );
             return 0;
         }
-        CRITICAL_SECTION_END( );
         return 1;
     }
 }
@@ -359,9 +352,8 @@ void HAL_UART_TxCpltCallback( UART_HandleTypeDef *handle )
         // Unknown UART peripheral skip processing
         return;
     }
-    if( IsFifoEmpty( &uart->FifoTx ) == false )
+    if( RingBufferPop( &uart->FifoTx, &UartContext[uartId].TxData ) == true )
     {
-        UartContext[uartId].TxData = FifoPop( &uart->FifoTx );
         //  Write one byte to the transmit data register
         HAL_UART_Transmit_IT( &UartContext[uartId].UartHandle, &UartContext[uartId].TxData, 1 );
     }
@@ -392,11 +384,8 @@ void HAL_UART_RxCpltCallback( UART_HandleTypeDef *handle )
         // Unknown UART peripheral skip processing
         return;
     }
-    if( IsFifoFull( &uart->FifoRx ) == false )
-    {
-        // Read one byte from the receive data register
-        FifoPush( &uart->FifoRx, UartContext[uartId].RxData );
-    }
+    // Read one byte from the receive data register. Dropped when the buffer is full.
+    RingBufferPush( &uart->FifoRx, UartContext[uartId].RxData );
 
     if( uart->IrqNotify != NULL )
     {
@@ -79,6 +79,18 @@ void SX126xIoIrqInit( DioIrqHandler dioIrq )
     GpioSetInterrupt( &SX126x.DIO1, IRQ_RISING_EDGE, IRQ_HIGH_PRIORITY, dioIrq );
 }
 
+void SX126xIoBusyIrqInit( DioIrqHandler busyIrq )
+{
+    if( busyIrq != NULL )
+    {
+        GpioSetInterrupt( &SX126x.BUSY, IRQ_FALLING_EDGE, IRQ_HIGH_PRIORITY, busyIrq );
+    }
+    else
+    {
+        GpioRemoveInterrupt( &SX126x.BUSY );
+    }
+}
+
 void SX126xIoDeInit( void )
 {
     GpioInit( &SX126x.Spi.Nss, RADIO_NSS, PIN_OUTPUT, PIN_PUSH_PULL, PIN_NO_PULL, 1 );
@@ -187,7 +199,7 @@ void SX126xWriteCommand( RadioCommands_t command, uint8_t *buffer, uint16_t size
 
     GpioWrite( &SX126x.Spi.Nss, 1 );
 
-    if( command != RADIO_SET_SLEEP )
+    if( ( command != RADIO_SET_SLEEP ) && ( SX126xCmdQueueIsActive( ) == false ) )
     {
         SX126xWaitOnBusy( );
     }
@@ -232,7 +244,10 @@ void SX126xWriteRegisters( uint16_t address, uint8_t *buffer, uint16_t size )
 
     GpioWrite( &SX126x.Spi.Nss, 1 );
 
-    SX126xWaitOnBusy( );
+    if( SX126xCmdQueueIsActive( ) == false )
+    {
+        SX126xWaitOnBusy( );
+    }
 }
 
 void SX126xWriteRegister( uint16_t address, uint8_t value )
@@ -280,7 +295,10 @@ void SX126xWriteBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
     }
     GpioWrite( &SX126x.Spi.Nss, 1 );
 
-    SX126xWaitOnBusy( );
+    if( SX126xCmdQueueIsActive( ) == false )
+    {
+        SX126xWaitOnBusy( );
+    }
 }
 
 void SX126xReadBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
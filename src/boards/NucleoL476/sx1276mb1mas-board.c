@@ -25,6 +25,7 @@
 #include "board-config.h"
 #include "delay.h"
 #include "radio.h"
+#include "radio-filter.h"
 #include "sx1276-board.h"
 
 /*!
@@ -69,9 +70,12 @@ const struct Radio_s Radio =
     SX1276SetMaxPayloadLength,
     SX1276SetPublicNetwork,
     SX1276GetWakeupTime,
-    NULL, // void ( *IrqProcess )( void )
+    SX1276IrqProcess,
     NULL, // void ( *RxBoosted )( uint32_t timeout ) - SX126x Only
     NULL, // void ( *SetRxDutyCycle )( uint32_t rxTime, uint32_t sleepTime ) - SX126x Only
+    SX1276StartChannelFree,
+    RadioRxFilterSet,
+    RadioRxFilterGetStats,
 };
 
 /*!
@@ -40,6 +40,7 @@
 #include "timer.h"
 #include "gps.h"
 #include "rtc-board.h"
+#include "lpm-board.h"
 #include "sx1276-board.h"
 #include "board.h"
 
@@ -139,6 +140,12 @@ void BoardLowPowerHandler( void )
     __enable_irq( );
 }
 
+void LpmSetDeadlineCallback( bool ( *getNextDeadline )( LpmDeadline_t* deadline ) )
+{
+    // The board doesn't implement the low power modes
+    ( void )getNextDeadline;
+}
+
 #if !defined ( __CC_ARM )
 
 /*
@@ -196,13 +196,10 @@ uint8_t UartMcuPutChar( Uart_t *obj, uint8_t data )
     }
     else
     {
+        // Several contexts may print, serialize the producers
         CRITICAL_SECTION_BEGIN( );
-        TxData = data;
-
-        if( IsFifoFull( &obj->FifoTx ) == false )
+        if( RingBufferPush( &obj->FifoTx, data ) == true )
         {
-            FifoPush( &obj->FifoTx, TxData );
-
             // Trig UART Tx interrupt to start sending the FIFO contents.
             __HAL_UART_ENABLE_IT( &UartHandle, UART_IT_TC );
 
@@ -226,15 +223,11 @@ uint8_t UartMcuGetChar( Uart_t *obj, uint8_t *data )
     }
     else
     {
-        CRITICAL_SECTION_BEGIN( );
-
-        if( IsFifoEmpty( &obj->FifoRx ) == false )
+        // Lock-free, the UART interrupt is the only producer
+        if( RingBufferPop( &obj->FifoRx, data ) == true )
         {
-            *data = FifoPop( &obj->FifoRx );
-            CRITICAL_SECTION_END( );
             return 0;
         }
-        CRITICAL_SECTION_END( );
         return 1;
     }
 }
@@ -299,9 +292,8 @@ uint8_t UartMcuGetBuffer( Uart_t *obj, uint8_t *buffer, uint16_t size, uint16_t
 
 void HAL_UART_TxCpltCallback( UART_HandleTypeDef *handle )
 {
-    if( IsFifoEmpty( &Uart1.FifoTx ) == false )
+    if( RingBufferPop( &Uart1.FifoTx, &TxData ) == true )
     {
-        TxData = FifoPop( &Uart1.FifoTx );
         //  Write one byte to the transmit data register
         HAL_UART_Transmit_IT( &UartHandle, &TxData, 1 );
     }
@@ -314,11 +306,8 @@ void HAL_UART_TxCpltCallback( UART_HandleTypeDef *handle )
 
 void HAL_UART_RxCpltCallback( UART_HandleTypeDef *handle )
 {
-    if( IsFifoFull( &Uart1.FifoRx ) == false )
-    {
-        // Read one byte from the receive data register
-        FifoPush( &Uart1.FifoRx, RxData );
-    }
+    // Read one byte from the receive data register. Dropped when the buffer is full.
+    RingBufferPush( &Uart1.FifoRx, RxData );
 
     if( Uart1.IrqNotify != NULL )
     {
@@ -30,6 +30,7 @@
 #include "i2c.h"
 #include "uart.h"
 #include "timer.h"
+#include "tracepoint.h"
 #include "board-config.h"
 #include "lpm-board.h"
 #include "rtc-board.h"
@@ -145,8 +146,8 @@ void BoardInitMcu( void )
 
         SystemClockConfig( );
 
-        FifoInit( &Uart1.FifoTx, Uart1TxBuffer, UART1_FIFO_TX_SIZE );
-        FifoInit( &Uart1.FifoRx, Uart1RxBuffer, UART1_FIFO_RX_SIZE );
+        RingBufferInit( &Uart1.FifoTx, Uart1TxBuffer, UART1_FIFO_TX_SIZE );
+        RingBufferInit( &Uart1.FifoRx, Uart1RxBuffer, UART1_FIFO_RX_SIZE );
         // Configure your terminal for 8 Bits data (7 data bit + 1 parity bit), no parity and no flow ctrl
         UartInit( &Uart1, UART_1, UART_TX, UART_RX );
         UartConfig( &Uart1, RX_TX, 921600, UART_8_BIT, UART_1_STOP_BIT, NO_PARITY, NO_FLOW_CTRL );
@@ -440,6 +441,7 @@ void SysTick_Handler( void )
 {
     HAL_IncTick( );
     HAL_SYSTICK_IRQHandler( );
+    TracePointSysTickHandler( );
 }
 
 uint8_t GetBoardPowerSource( void )
@@ -31,8 +31,25 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
 #include "board-config.h"
 
+/*!
+ * Time in ms needed to restore the clocks and peripherals when leaving Stop
+ * mode. May be overridden in board-config.h.
+ */
+#ifndef LPM_STOP_MODE_WAKEUP_TIME
+#define LPM_STOP_MODE_WAKEUP_TIME                   2
+#endif
+
+/*!
+ * Time in ms needed to restore the clocks and peripherals when leaving Off
+ * mode. May be overridden in board-config.h.
+ */
+#ifndef LPM_OFF_MODE_WAKEUP_TIME
+#define LPM_OFF_MODE_WAKEUP_TIME                    10
+#endif
+
 /*!
  * Low power manager configuration
  */
@@ -62,6 +79,42 @@ typedef enum
     LPM_OFF_MODE,
 } LpmGetMode_t;
 
+/*!
+ * Next time a user of the low power manager needs the CPU
+ */
+typedef struct sLpmDeadline
+{
+    /*!
+     * Time until the deadline in ms. 0 when work is pending.
+     */
+    uint32_t Time;
+    /*!
+     * Time in ms the CPU must be running ahead of the deadline
+     */
+    uint32_t LeadTime;
+    /*!
+     * The deadline tolerates the wake up latency of any low power mode
+     */
+    bool CanRunLate;
+}LpmDeadline_t;
+
+/*!
+ * \brief  This API registers the function the low power manager consults before entering low power mode. The
+ *         Stop and Off modes are disallowed when their wake up latency doesn't meet the next deadline and the low
+ *         power mode isn't entered at all while work is pending.
+ *
+ * \param [IN] getNextDeadline Function returning the next deadline, false when there is none. NULL to unregister.
+ */
+void LpmSetDeadlineCallback( bool ( *getNextDeadline )( LpmDeadline_t* deadline ) );
+
+/*!
+ * \brief  This API allows the Stop and Off modes only when their wake up latency meets the next deadline registered
+ *         with \ref LpmSetDeadlineCallback. The boards call it from LpmEnterLowPower( ).
+ *
+ * \retval status [true: Low power mode may be entered, false: Work is pending]
+ */
+bool LpmApplyDeadline( void );
+
 /*!
  * \brief  This API returns the Low Power Mode selected that will be applied when the system will enter low power mode
  *         if there is no update between the time the mode is read with this API and the time the system enters
@@ -95,8 +148,8 @@ void LpmSetOffMode(LpmId_t id, LpmSetMode_t mode );
 
 /*!
  * \brief  This API shall be used by the application when there is no more code to execute so that the system may
- *         enter low-power mode. The mode selected depends on the information received from LpmOffModeSelection( ) and
- *         LpmSysclockRequest( )
+ *         enter low-power mode. The mode selected depends on the information received from LpmOffModeSelection( ),
+ *         LpmSysclockRequest( ) and on the next deadline, see \ref LpmSetDeadlineCallback
  *         This function shall be called in critical section
  */
 void LpmEnterLowPower( void );
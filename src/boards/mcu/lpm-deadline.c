@@ -0,0 +1,64 @@
+/*!
+ * \file      lpm-deadline.c
+ *
+ * \brief     Low power modes selection from the next deadline, common to the
+ *            boards
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2017 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include "lpm-board.h"
+
+/*!
+ * Function returning the next deadline
+ */
+static bool ( *LpmGetNextDeadline )( LpmDeadline_t* deadline ) = NULL;
+
+void LpmSetDeadlineCallback( bool ( *getNextDeadline )( LpmDeadline_t* deadline ) )
+{
+    LpmGetNextDeadline = getNextDeadline;
+}
+
+bool LpmApplyDeadline( void )
+{
+    LpmDeadline_t deadline;
+    uint32_t timeToWakeup = 0;
+
+    if( ( LpmGetNextDeadline == NULL ) || ( LpmGetNextDeadline( &deadline ) == false ) )
+    {
+        LpmSetStopMode( LPM_LIB_ID, LPM_ENABLE );
+        LpmSetOffMode( LPM_LIB_ID, LPM_ENABLE );
+        return true;
+    }
+    if( deadline.Time == 0 )
+    {
+        return false;
+    }
+    if( deadline.CanRunLate == true )
+    {
+        LpmSetStopMode( LPM_LIB_ID, LPM_ENABLE );
+        LpmSetOffMode( LPM_LIB_ID, LPM_ENABLE );
+        return true;
+    }
+
+    if( deadline.Time > deadline.LeadTime )
+    {
+        timeToWakeup = deadline.Time - deadline.LeadTime;
+    }
+    LpmSetStopMode( LPM_LIB_ID, ( timeToWakeup > LPM_STOP_MODE_WAKEUP_TIME ) ? LPM_ENABLE : LPM_DISABLE );
+    LpmSetOffMode( LPM_LIB_ID, ( timeToWakeup > LPM_OFF_MODE_WAKEUP_TIME ) ? LPM_ENABLE : LPM_DISABLE );
+    return true;
+}
@@ -24,34 +24,189 @@
 #include <stdio.h>
 #include "utilities.h"
 
+/*!
+ * Rotates a 32-bit value to the left
+ */
+#define ROTL32( x, n )                              ( ( ( x ) << ( n ) ) | ( ( x ) >> ( 32 - ( n ) ) ) )
+
+/*!
+ * \brief SplitMix32 generator, expands a seed into well distributed words
+ *
+ * \param [IN/OUT] x Generator counter
+ * \retval value Next word
+ */
+static uint32_t SplitMix32( uint32_t *x )
+{
+    uint32_t z = ( *x += 0x9E3779B9 );
+
+    z = ( z ^ ( z >> 16 ) ) * 0x85EBCA6B;
+    z = ( z ^ ( z >> 13 ) ) * 0xC2B2AE35;
+    return z ^ ( z >> 16 );
+}
+
+void RandInit( RandState_t *state, uint32_t seed )
+{
+    // Consecutive SplitMix32 outputs are never all 0, the only state
+    // xoshiro128** can't leave
+    for( uint8_t i = 0; i < 4; i++ )
+    {
+        state->S[i] = SplitMix32( &seed );
+    }
+}
+
+void RandMix( RandState_t *state, uint32_t entropy )
+{
+    for( uint8_t i = 0; i < 4; i++ )
+    {
+        state->S[i] ^= SplitMix32( &entropy );
+    }
+    if( ( state->S[0] | state->S[1] | state->S[2] | state->S[3] ) == 0 )
+    {
+        RandInit( state, entropy );
+    }
+}
+
+uint32_t RandNext( RandState_t *state )
+{
+    uint32_t *s = state->S;
+    uint32_t result = ROTL32( s[1] * 5, 7 ) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = ROTL32( s[3], 11 );
+    return result;
+}
+
+uint32_t RandBelow( RandState_t *state, uint32_t range )
+{
+    if( range == 0 )
+    {
+        return RandNext( state );
+    }
+
+    // Lemire's multiply and shift reduction. The few low products biasing the
+    // result are rejected, the division only runs when close to them.
+    uint64_t m = ( uint64_t )RandNext( state ) * range;
+    uint32_t low = ( uint32_t )m;
+
+    if( low < range )
+    {
+        uint32_t threshold = ( uint32_t )( -range ) % range;
+
+        while( low < threshold )
+        {
+            m = ( uint64_t )RandNext( state ) * range;
+            low = ( uint32_t )m;
+        }
+    }
+    return ( uint32_t )( m >> 32 );
+}
+
+int32_t RandRange( RandState_t *state, int32_t min, int32_t max )
+{
+    uint32_t range = ( uint32_t )max - ( uint32_t )min + 1;
+
+    return ( int32_t )( ( uint32_t )min + RandBelow( state, range ) );
+}
+
 /*!
  * Redefinition of rand() and srand() standard C functions.
  * These functions are redefined in order to get the same behavior across
  * different compiler toolchains implementations.
  */
 // Standard random functions redefinition start
-#define RAND_LOCAL_MAX 2147483647L
-
-static uint32_t next = 1;
+// Initial value of srand1( 1 )
+static RandState_t RandState =
+{
+    .S = { 0x96A0F96B, 0x12BC8390, 0x971E9964, 0x79ADC7E7 }
+};
 
 int32_t rand1( void )
 {
-    return ( ( next = next * 1103515245L + 12345L ) % RAND_LOCAL_MAX );
+    return ( int32_t )( RandNext( &RandState ) >> 1 );
 }
 
 void srand1( uint32_t seed )
 {
-    next = seed;
+    RandInit( &RandState, seed );
 }
 // Standard random functions redefinition end
 
+void srand1Mix( uint32_t entropy )
+{
+    RandMix( &RandState, entropy );
+}
+
 int32_t randr( int32_t min, int32_t max )
 {
-    return ( int32_t )rand1( ) % ( max - min + 1 ) + min;
+    return RandRange( &RandState, min, max );
+}
+
+/*!
+ * Word moved by the memory functions. It may alias any other type, the arrays
+ * are often structures cast to uint8_t pointers.
+ */
+#if defined( __GNUC__ )
+typedef uint32_t __attribute__( ( __may_alias__ ) ) MemWord_t;
+#else
+typedef uint32_t MemWord_t;
+#endif
+
+#define MEM_WORD_MASK                               ( sizeof( MemWord_t ) - 1 )
+
+/*!
+ * Below this size the memory functions move bytes, aligning the pointers
+ * costs more than it saves.
+ */
+#define MEM_WORD_MIN_SIZE                           8
+
+/*!
+ * \brief Reverses the byte order of a word. Compiled to a single REV
+ *        instruction on Cortex-M cores.
+ */
+static uint32_t ReverseWord( uint32_t word )
+{
+    return ( word >> 24 ) | ( ( word >> 8 ) & 0x0000FF00 ) | ( ( word << 8 ) & 0x00FF0000 ) | ( word << 24 );
 }
 
 void memcpy1( uint8_t *dst, const uint8_t *src, uint16_t size )
 {
+    // Cortex-M0+ cores don't support unaligned accesses: words are only moved
+    // when both arrays have the same alignment.
+    if( ( size >= MEM_WORD_MIN_SIZE ) && ( ( ( ( uintptr_t )dst ^ ( uintptr_t )src ) & MEM_WORD_MASK ) == 0 ) )
+    {
+        MemWord_t *dstWord;
+        const MemWord_t *srcWord;
+
+        while( ( ( uintptr_t )dst & MEM_WORD_MASK ) != 0 )
+        {
+            *dst++ = *src++;
+            size--;
+        }
+        dstWord = ( MemWord_t* )dst;
+        srcWord = ( const MemWord_t* )src;
+        while( size >= ( 4 * sizeof( MemWord_t ) ) )
+        {
+            dstWord[0] = srcWord[0];
+            dstWord[1] = srcWord[1];
+            dstWord[2] = srcWord[2];
+            dstWord[3] = srcWord[3];
+            dstWord += 4;
+            srcWord += 4;
+            size -= 4 * sizeof( MemWord_t );
+        }
+        while( size >= sizeof( MemWord_t ) )
+        {
+            *dstWord++ = *srcWord++;
+            size -= sizeof( MemWord_t );
+        }
+        dst = ( uint8_t* )dstWord;
+        src = ( const uint8_t* )srcWord;
+    }
     while( size-- )
     {
         *dst++ = *src++;
@@ -61,6 +216,23 @@ void memcpy1( uint8_t *dst, const uint8_t *src, uint16_t size )
 void memcpyr( uint8_t *dst, const uint8_t *src, uint16_t size )
 {
     dst = dst + ( size - 1 );
+    // dst moves backwards: once src is aligned, the word ending at dst is
+    // aligned when src + dst + 1 is a multiple of the word size.
+    if( ( size >= MEM_WORD_MIN_SIZE ) && ( ( ( ( uintptr_t )dst + ( uintptr_t )src + 1 ) & MEM_WORD_MASK ) == 0 ) )
+    {
+        while( ( ( uintptr_t )src & MEM_WORD_MASK ) != 0 )
+        {
+            *dst-- = *src++;
+            size--;
+        }
+        while( size >= sizeof( MemWord_t ) )
+        {
+            *( MemWord_t* )( dst - ( sizeof( MemWord_t ) - 1 ) ) = ReverseWord( *( const MemWord_t* )src );
+            dst -= sizeof( MemWord_t );
+            src += sizeof( MemWord_t );
+            size -= sizeof( MemWord_t );
+        }
+    }
     while( size-- )
     {
         *dst-- = *src++;
@@ -69,6 +241,33 @@ void memcpyr( uint8_t *dst, const uint8_t *src, uint16_t size )
 
 void memset1( uint8_t *dst, uint8_t value, uint16_t size )
 {
+    if( size >= MEM_WORD_MIN_SIZE )
+    {
+        MemWord_t word = value * 0x01010101UL;
+        MemWord_t *dstWord;
+
+        while( ( ( uintptr_t )dst & MEM_WORD_MASK ) != 0 )
+        {
+            *dst++ = value;
+            size--;
+        }
+        dstWord = ( MemWord_t* )dst;
+        while( size >= ( 4 * sizeof( MemWord_t ) ) )
+        {
+            dstWord[0] = word;
+            dstWord[1] = word;
+            dstWord[2] = word;
+            dstWord[3] = word;
+            dstWord += 4;
+            size -= 4 * sizeof( MemWord_t );
+        }
+        while( size >= sizeof( MemWord_t ) )
+        {
+            *dstWord++ = word;
+            size -= sizeof( MemWord_t );
+        }
+        dst = ( uint8_t* )dstWord;
+    }
     while( size-- )
     {
         *dst++ = value;
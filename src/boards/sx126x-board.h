@@ -44,6 +44,13 @@ void SX126xIoInit( void );
  */
 void SX126xIoIrqInit( DioIrqHandler dioIrq );
 
+/*!
+ * \brief Initializes the BUSY pin falling edge IRQ handler
+ *
+ * \param [IN] busyIrq BUSY pin IRQ callback function. NULL disables the IRQ.
+ */
+void SX126xIoBusyIrqInit( DioIrqHandler busyIrq );
+
 /*!
  * \brief De-initializes the radio I/Os pins interface.
  *
@@ -86,6 +86,59 @@ typedef union Version_u
     uint32_t Value;
 }Version_t;
 
+/*!
+ * Pseudo random generator state (xoshiro128**). Each instance produces its own
+ * sequence, e.g. one instance per simulated device.
+ */
+typedef struct sRandState
+{
+    uint32_t S[4];
+}RandState_t;
+
+/*!
+ * \brief Initializes a pseudo random generator instance
+ *
+ * \param [IN] state Generator instance
+ * \param [IN] seed  Pseudo random generator initial value
+ */
+void RandInit( RandState_t *state, uint32_t seed );
+
+/*!
+ * \brief Mixes entropy into a pseudo random generator instance without
+ *        restarting its sequence
+ *
+ * \param [IN] state   Generator instance
+ * \param [IN] entropy Entropy, e.g. Radio.Random value or received packet RSSI
+ */
+void RandMix( RandState_t *state, uint32_t entropy );
+
+/*!
+ * \brief Computes the next 32-bit random value of an instance
+ *
+ * \param [IN] state Generator instance
+ * \retval random Random value
+ */
+uint32_t RandNext( RandState_t *state );
+
+/*!
+ * \brief Computes an unbiased random value lower than range
+ *
+ * \param [IN] state Generator instance
+ * \param [IN] range Number of possible values. 0 stands for 2^32.
+ * \retval random Random value in range 0..range-1
+ */
+uint32_t RandBelow( RandState_t *state, uint32_t range );
+
+/*!
+ * \brief Computes an unbiased random value between min and max
+ *
+ * \param [IN] state Generator instance
+ * \param [IN] min   range minimum value
+ * \param [IN] max   range maximum value, greater or equal to min
+ * \retval random random value in range min..max
+ */
+int32_t RandRange( RandState_t *state, int32_t min, int32_t max );
+
 /*!
  * \brief Initializes the pseudo random generator initial value
  *
@@ -93,9 +146,25 @@ typedef union Version_u
  */
 void srand1( uint32_t seed );
 
+/*!
+ * \brief Mixes entropy into the pseudo random generator
+ *
+ * \param [IN] entropy Entropy, e.g. Radio.Random value
+ */
+void srand1Mix( uint32_t entropy );
+
+/*!
+ * \brief Computes a random number between 0 and 2^31 - 1
+ *
+ * \retval random random value
+ */
+int32_t rand1( void );
+
 /*!
  * \brief Computes a random number between min and max
  *
+ * \remark Unbiased, unlike rand1( ) % ( max - min + 1 ) + min
+ *
  * \param [IN] min range minimum value
  * \param [IN] max range maximum value
  * \retval random random value in range min..max
@@ -107,6 +176,9 @@ int32_t randr( int32_t min, int32_t max );
  *
  * \remark STM32 Standard memcpy function only works on pointers that are aligned
  *
+ * \remark The arrays are copied from the first to the last byte, 32-bit words
+ *         at a time when they have the same alignment
+ *
  * \param [OUT] dst  Destination array
  * \param [IN]  src  Source array
  * \param [IN]  size Number of bytes to be copied
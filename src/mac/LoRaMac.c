@@ -44,9 +44,15 @@
 #include "LoRaMacCommands.h"
 #include "LoRaMacAdr.h"
 #include "LoRaMacSerializer.h"
+#include "tracepoint.h"
+#include "eventlog.h"
 
 #include "LoRaMac.h"
 
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED ) && defined( SECURE_ELEMENT_ASYNC_ENABLED )
+#error "The asynchronous secure element jobs and downlink unsecure aren't bound to a LoRaMac instance"
+#endif
+
 #ifndef LORAMAC_VERSION
 /*!
  * LORaWAN version definition.
@@ -84,6 +90,12 @@
  */
 #define BACKOFF_DC_24_HOURS                         10000
 
+/*!
+ * Number of uplinks between two reseeds of the channel and timing
+ * randomization with Radio.Random
+ */
+#define LORAMAC_RAND_RESEED_PERIOD                  16
+
 /*!
  * LoRaMac internal states
  */
@@ -97,6 +109,7 @@ enum eLoRaMacState
     LORAMAC_TX_DELAYED    = 0x00000020,
     LORAMAC_TX_CONFIG     = 0x00000040,
     LORAMAC_RX_ABORT      = 0x00000080,
+    LORAMAC_CARRIER_SENSE = 0x00000100,
 };
 
 /*
@@ -199,6 +212,25 @@ typedef struct sLoRaMacNvmCtx
     uint32_t LastRxMic;
 }LoRaMacNvmCtx_t;
 
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+/*
+ * Downlink data frame waiting for the completion of its unsecure
+ */
+typedef struct sLoRaMacRxUnsecureCtx
+{
+    bool IsPending;
+    /*
+     * Copy of the received frame, MacMsg.Buffer points to it
+     */
+    uint8_t Buffer[LORAMAC_PHY_MAXPAYLOAD];
+    LoRaMacHeader_t MacHdr;
+    LoRaMacMessageData_t MacMsg;
+    FType_t FType;
+    uint8_t Multicast;
+    uint32_t DownLinkCounter;
+}LoRaMacRxUnsecureCtx_t;
+#endif
+
 typedef struct sLoRaMacCtx
 {
     /*
@@ -246,18 +278,57 @@ typedef struct sLoRaMacCtx
     * LoRaMac duty cycle delayed Tx timer
     */
     TimerEvent_t TxDelayedTimer;
+    /*
+    * Secure the uplinks as soon as they are requested
+    */
+    bool TxAheadOfTime;
+    /*
+    * Class C reception duty cycle parameters
+    */
+    RxCDutyCycleParams_t RxCDutyCycle;
+    /*
+    * Class C continuous reception forced
+    */
+    bool RxCForceContinuous;
+    /*
+    * Set while the class C reception duty cycle runs, until the next radio
+    * event
+    */
+    bool IsRxCDutyCycleRunning;
+    /*
+    * Uplinks sent since the last reseed of the randomization
+    */
+    uint16_t UplinksSinceReseed;
+    /*
+    * Reception filter installed in the radio driver
+    */
+    bool RxFilterEnabled;
+    /*
+    * Carrier sense mode of the listen before talk procedure
+    */
+    RadioCarrierSenseModes_t CarrierSenseMode;
+    /*
+    * Current uplink secured ahead of its transmission
+    */
+    LoRaMacCryptoPreparedMsg_t TxPreparedMsg;
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+    /*
+    * Downlink unsecured by the secure element in the background
+    */
+    LoRaMacRxUnsecureCtx_t RxUnsecure;
+#endif
     /*
     * LoRaMac reception windows timers
     */
     TimerEvent_t RxWindowTimer1;
     TimerEvent_t RxWindowTimer2;
     /*
-    * LoRaMac reception windows delay
+    * LoRaMac reception windows delay from the Tx done, in RTC ticks
     * \remark normal frame: RxWindowXDelay = ReceiveDelayX - RADIO_WAKEUP_TIME
     *         join frame  : RxWindowXDelay = JoinAcceptDelayX - RADIO_WAKEUP_TIME
     */
-    uint32_t RxWindow1Delay;
-    uint32_t RxWindow2Delay;
+    TimerTicks_t RxWindow1Delay;
+    TimerTicks_t RxWindow2Delay;
     /*
     * LoRaMac Rx windows configuration
     */
@@ -342,17 +413,90 @@ typedef struct sLoRaMacCtx
     * Duty cycle wait time
     */
     TimerTime_t DutyCycleWaitTime;
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    /*
+     * Timer events waiting for LoRaMacProcess, one bit per
+     * LoRaMacDeadlineOwner_t
+     */
+    uint8_t PendingTimerEvents;
+#endif
 }LoRaMacCtx_t;
 
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+#ifndef LORAMAC_INSTANCE_MODULE_CTXS_SIZE
+/*!
+ * Storage reserved in each instance for the contexts of the other MAC modules
+ */
+#define LORAMAC_INSTANCE_MODULE_CTXS_SIZE           2048
+#endif
+
+/*!
+ * Contexts of the other MAC modules bound while an instance is selected.
+ * NULL binds the storage of the module itself.
+ */
+typedef struct sLoRaMacModuleCtxs
+{
+    void* RegionNvmCtx;
+    void* CryptoNvmCtx;
+    void* SecureElementNvmCtx;
+    void* CommandsNvmCtx;
+    void* ClassBCtx;
+    void* ClassBNvmCtx;
+    void* ConfirmQueueCtx;
+    void* ConfirmQueueNvmCtx;
+}LoRaMacModuleCtxs_t;
+#endif
+
+/*!
+ * LoRaMac instance. Holds the complete state of one end-device
+ */
+struct sLoRaMacInstance
+{
+    /*
+     * Module context.
+     */
+    LoRaMacCtx_t MacCtx;
+    /*
+     * Non-volatile module context.
+     */
+    LoRaMacNvmCtx_t NvmMacCtx;
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    /*
+     * Set to true once the module contexts are assigned
+     */
+    bool HasModuleCtxs;
+    /*
+     * Contexts of the region, crypto, secure element, commands, class b and
+     * confirm queue modules. Point into ModuleCtxsStorage, all NULL for the
+     * default instance.
+     */
+    LoRaMacModuleCtxs_t ModuleCtxs;
+    /*
+     * Storage of the module contexts, 8-byte aligned
+     */
+    uint64_t ModuleCtxsStorage[( LORAMAC_INSTANCE_MODULE_CTXS_SIZE + 7 ) / 8];
+#endif
+};
+
+/*
+ * Instance used by the API until another one is selected.
+ */
+static LoRaMacInstance_t DefaultInstance;
+
 /*
- * Module context.
+ * Selected instance.
  */
-static LoRaMacCtx_t MacCtx;
+static LoRaMacInstance_t* Instance = &DefaultInstance;
 
 /*
- * Non-volatile module context.
+ * Module context of the selected instance.
  */
-static LoRaMacNvmCtx_t NvmMacCtx;
+static LoRaMacCtx_t* MacCtx = &DefaultInstance.MacCtx;
+
+/*
+ * Instance driving the radio. Owns the radio events.
+ */
+static LoRaMacInstance_t* RadioInstance = &DefaultInstance;
 
 
 
@@ -374,6 +518,7 @@ typedef union uLoRaMacRadioEvents
         uint32_t TxTimeout : 1;
         uint32_t RxDone    : 1;
         uint32_t TxDone    : 1;
+        uint32_t ChannelFreeDone : 1;
     }Events;
 }LoRaMacRadioEvents_t;
 
@@ -393,6 +538,31 @@ static void OnRadioTxDone( void );
  */
 static void PrepareRxDoneAbort( void );
 
+/*!
+ * \brief Processes a downlink data frame once it has been unsecured
+ *
+ * \param [IN] macCryptoStatus Status of the frame unsecure
+ * \param [IN] macHdr          MAC header of the frame
+ * \param [IN] macMsgData      Unsecured data message object
+ * \param [IN] fType           Frame type
+ * \param [IN] multicast       Set when the frame has been received on a multicast address
+ * \param [IN] downLinkCounter Downlink frame counter of the frame
+ */
+static void ProcessRadioRxDoneData( LoRaMacCryptoStatus_t macCryptoStatus, LoRaMacHeader_t macHdr, LoRaMacMessageData_t* macMsgData,
+                                    FType_t fType, uint8_t multicast, uint32_t downLinkCounter );
+
+/*!
+ * \brief Completes the processing of a received frame
+ */
+static void ProcessRadioRxDoneEnd( void );
+
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+/*!
+ * \brief Function executed when the asynchronous unsecure of a downlink completes
+ */
+static void OnRxUnsecureDone( LoRaMacCryptoStatus_t status, void* context );
+#endif
+
 /*!
  * \brief Function to be executed on Radio Rx Done event
  */
@@ -413,6 +583,11 @@ static void OnRadioRxError( void );
  */
 static void OnRadioRxTimeout( void );
 
+/*!
+ * \brief Function executed on Radio channel free done event
+ */
+static void OnRadioChannelFreeDone( bool channelIsFree );
+
 /*!
  * \brief Function executed on duty cycle delayed Tx  timer event
  */
@@ -428,11 +603,68 @@ static void OnRxWindow1TimerEvent( void* context );
  */
 static void OnRxWindow2TimerEvent( void* context );
 
+#if defined( TRACE_POINT_ENABLED )
+/*!
+ * \brief Records how late a RX window opens compared to its expected time
+ *        after the end of the transmission
+ *
+ * \param [IN] id    Tracepoint identifier
+ * \param [IN] delay Expected RX window delay in ms
+ */
+static void TraceRxWindowLatency( TracePointId_t id, uint64_t delay );
+#endif
+
+#if defined( EVENT_LOG_ENABLED )
+/*!
+ * \brief Records a MCPS request for the replay
+ *
+ * \param [IN] mcpsRequest MCPS request
+ */
+static void EventLogMcpsRequest( McpsReq_t* mcpsRequest );
+
+/*!
+ * \brief Records a MLME request for the replay
+ *
+ * \param [IN] mlmeRequest MLME request
+ */
+static void EventLogMlmeRequest( MlmeReq_t* mlmeRequest );
+#endif
+
 /*!
  * \brief Function executed on AckTimeout timer event
  */
 static void OnAckTimeoutTimerEvent( void* context );
 
+/*!
+ * \brief Converts a reception window delay to RTC ticks
+ *
+ * \param [IN] receiveDelay Receive delay from the Tx done [ms]
+ * \param [IN] windowOffset Window offset computed by the region [us]
+ *
+ * \retval delay Window opening delay from the Tx done in RTC ticks
+ */
+static TimerTicks_t GetRxWindowDelay( uint32_t receiveDelay, int32_t windowOffset );
+
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+/*!
+ * \brief Records a MAC timer event for LoRaMacProcess of the instance owning
+ *        the timer. The main loop selects the instances, thus the timer
+ *        interrupt doesn't handle the event itself.
+ *
+ * \param [IN] context Instance owning the timer. NULL when LoRaMacProcess
+ *                     handles the event.
+ * \param [IN] owner   Timer raising the event
+ *
+ * \retval Returns true if the event has been recorded for later.
+ */
+static bool DeferTimerEvent( void* context, LoRaMacDeadlineOwner_t owner );
+#endif
+
+/*!
+ * \brief Function executed when class b starts a reception
+ */
+static void OnClassBRadioRxStart( void );
+
 /*!
  * \brief Configures the events to trigger an MLME-Indication with
  *        a MLME type of MLME_SCHEDULE_UPLINK.
@@ -542,6 +774,21 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
  */
 static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx );
 
+/*!
+ * \brief Mixes a Radio.Random value into the channel and timing randomization
+ *
+ * \remark Blocks the radio, for about 32 ms on SX1276, and leaves it in sleep
+ *         mode
+ */
+static void ReseedRandom( void );
+
+/*!
+ * \brief Sends the frame on the channel selected by ScheduleTx
+ *
+ * \retval LoRaMacStatus_t Status of the operation
+ */
+static LoRaMacStatus_t ScheduleTxOnChannel( void );
+
 /*
  * \brief Secures the current processed frame ( TxMsg )
  * \param[IN]     txDr      Data rate used for the transmission
@@ -550,6 +797,13 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx );
  */
 static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh );
 
+/*
+ * \brief Secures the current processed frame ( TxMsg ) ahead of its transmission.
+ *        Only the data rate and channel dependent parts are left to SecureFrame.
+ * \retval status           Status of the operation
+ */
+static LoRaMacStatus_t PrepareSecureFrame( void );
+
 /*
  * \brief Calculates the aggregated back off time.
  */
@@ -613,9 +867,36 @@ static void RxWindowSetup( TimerEvent_t* rxTimer, RxConfigParams_t* rxConfig );
 /*!
  * \brief Opens up a continuous RX C window. This is used for
  *        class c devices.
+ *
+ * \remark The radio listens in reception duty cycle when
+ *         \ref GetRxCDutyCycle allows it.
  */
 static void OpenContinuousRxCWindow( void );
 
+/*!
+ * \brief Installs the reception filter matching the current device address
+ *        and multicast channels in the radio driver, when the instance drives
+ *        the radio
+ */
+static void UpdateRxFilter( void );
+
+/*!
+ * \brief Computes the class C reception duty cycle
+ *
+ * \param [OUT] rxTime    Reception window duration [us]
+ * \param [OUT] sleepTime Sleep period duration [us]
+ *
+ * \retval [true: duty cycle possible, false: continuous reception required]
+ */
+static bool GetRxCDutyCycle( uint32_t* rxTime, uint32_t* sleepTime );
+
+/*!
+ * \brief Restarts the running class C reception, so that
+ *        \ref GetRxCDutyCycle decides again between the reception duty cycle
+ *        and the continuous reception
+ */
+static void RestartRxCWindow( void );
+
 /*!
  * \brief   Returns a pointer to the internal contexts structure.
  *
@@ -778,6 +1059,13 @@ static void LoRaMacHandleIndicationEvents( void );
 struct
 {
     TimerTime_t CurTime;
+    /*!
+     * Tx done time in RTC ticks, reference of the RX windows
+     */
+    TimerTicks_t CurTicks;
+#if defined( TRACE_POINT_ENABLED )
+    uint32_t TraceTicks;
+#endif
 }TxDoneParams;
 
 /*!
@@ -792,21 +1080,41 @@ struct
     int8_t Snr;
 }RxDoneParams;
 
+/*!
+ * Structure used to store the radio channel free event data
+ */
+struct
+{
+    bool IsFree;
+}ChannelFreeDoneParams;
+
 static void OnRadioTxDone( void )
 {
+    RadioInstance->MacCtx.IsRxCDutyCycleRunning = false;
+    TxDoneParams.CurTicks = TimerGetCurrentTicks( );
     TxDoneParams.CurTime = TimerGetCurrentTime( );
-    MacCtx.LastTxSysTime = SysTimeGet( );
+    RadioInstance->MacCtx.LastTxSysTime = SysTimeGet( );
+#if defined( TRACE_POINT_ENABLED )
+    TxDoneParams.TraceTicks = TracePointGetTicks( );
+#endif
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_TX_DONE, NULL, 0, NULL, 0 );
 
     LoRaMacRadioEvents.Events.TxDone = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( RadioInstance->MacCtx.MacCallbacks != NULL ) && ( RadioInstance->MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        RadioInstance->MacCtx.MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioRxDone( uint8_t *payload, uint16_t size, int16_t rssi, int8_t snr )
 {
+    RadioInstance->MacCtx.IsRxCDutyCycleRunning = false;
+#if defined( EVENT_LOG_ENABLED )
+    uint8_t eventLogHeader[3] = { ( uint8_t )rssi, ( uint8_t )( rssi >> 8 ), ( uint8_t )snr };
+
+    EventLogRecord( EVENT_LOG_RADIO_RX_DONE, eventLogHeader, sizeof( eventLogHeader ), payload, size );
+#endif
     RxDoneParams.LastRxDone = TimerGetCurrentTime( );
     RxDoneParams.Payload = payload;
     RxDoneParams.Size = size;
@@ -815,51 +1123,69 @@ static void OnRadioRxDone( uint8_t *payload, uint16_t size, int16_t rssi, int8_t
 
     LoRaMacRadioEvents.Events.RxDone = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( RadioInstance->MacCtx.MacCallbacks != NULL ) && ( RadioInstance->MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        RadioInstance->MacCtx.MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioTxTimeout( void )
 {
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_TX_TIMEOUT, NULL, 0, NULL, 0 );
     LoRaMacRadioEvents.Events.TxTimeout = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( RadioInstance->MacCtx.MacCallbacks != NULL ) && ( RadioInstance->MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        RadioInstance->MacCtx.MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioRxError( void )
 {
+    RadioInstance->MacCtx.IsRxCDutyCycleRunning = false;
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_RX_ERROR, NULL, 0, NULL, 0 );
     LoRaMacRadioEvents.Events.RxError = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( RadioInstance->MacCtx.MacCallbacks != NULL ) && ( RadioInstance->MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        RadioInstance->MacCtx.MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void OnRadioRxTimeout( void )
 {
+    RadioInstance->MacCtx.IsRxCDutyCycleRunning = false;
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_RX_TIMEOUT, NULL, 0, NULL, 0 );
     LoRaMacRadioEvents.Events.RxTimeout = 1;
 
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( RadioInstance->MacCtx.MacCallbacks != NULL ) && ( RadioInstance->MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        RadioInstance->MacCtx.MacCallbacks->MacProcessNotify( );
+    }
+}
+
+static void OnRadioChannelFreeDone( bool channelIsFree )
+{
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_CHANNEL_FREE_DONE, ( uint8_t[] ){ channelIsFree }, 1, NULL, 0 );
+    ChannelFreeDoneParams.IsFree = channelIsFree;
+
+    LoRaMacRadioEvents.Events.ChannelFreeDone = 1;
+
+    if( ( RadioInstance->MacCtx.MacCallbacks != NULL ) && ( RadioInstance->MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    {
+        RadioInstance->MacCtx.MacCallbacks->MacProcessNotify( );
     }
 }
 
 static void UpdateRxSlotIdleState( void )
 {
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
-        MacCtx.RxSlot = RX_SLOT_NONE;
+        MacCtx->RxSlot = RX_SLOT_NONE;
     }
     else
     {
-        MacCtx.RxSlot = RX_SLOT_WIN_CLASS_C;
+        MacCtx->RxSlot = RX_SLOT_WIN_CLASS_C;
     }
 }
 
@@ -869,57 +1195,55 @@ static void ProcessRadioTxDone( void )
     PhyParam_t phyParam;
     SetBandTxDoneParams_t txDone;
 
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
         Radio.Sleep( );
     }
-    // Setup timers
-    TimerSetValue( &MacCtx.RxWindowTimer1, MacCtx.RxWindow1Delay );
-    TimerStart( &MacCtx.RxWindowTimer1 );
-    TimerSetValue( &MacCtx.RxWindowTimer2, MacCtx.RxWindow2Delay );
-    TimerStart( &MacCtx.RxWindowTimer2 );
+    // Setup timers. The windows are relative to the Tx done interrupt, not to
+    // its processing which may have been delayed.
+    TimerStartAt( &MacCtx->RxWindowTimer1, TxDoneParams.CurTicks + MacCtx->RxWindow1Delay );
+    TimerStartAt( &MacCtx->RxWindowTimer2, TxDoneParams.CurTicks + MacCtx->RxWindow2Delay );
 
-    if( ( MacCtx.NvmCtx->DeviceClass == CLASS_C ) || ( MacCtx.NodeAckRequested == true ) )
+    if( ( MacCtx->NvmCtx->DeviceClass == CLASS_C ) || ( MacCtx->NodeAckRequested == true ) )
     {
         getPhy.Attribute = PHY_ACK_TIMEOUT;
-        phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-        TimerSetValue( &MacCtx.AckTimeoutTimer, MacCtx.RxWindow2Delay + phyParam.Value );
-        TimerStart( &MacCtx.AckTimeoutTimer );
+        phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+        TimerStartAt( &MacCtx->AckTimeoutTimer, TxDoneParams.CurTicks + MacCtx->RxWindow2Delay + TimerMs2Ticks( phyParam.Value ) );
     }
 
     // Update Aggregated last tx done time
-    MacCtx.NvmCtx->LastTxDoneTime = TxDoneParams.CurTime;
+    MacCtx->NvmCtx->LastTxDoneTime = TxDoneParams.CurTime;
 
     // Update last tx done time for the current channel
-    txDone.Channel = MacCtx.Channel;
+    txDone.Channel = MacCtx->Channel;
     txDone.LastTxDoneTime = TxDoneParams.CurTime;
-    txDone.ElapsedTimeSinceStartUp = SysTimeSub( SysTimeGetMcuTime( ), MacCtx.NvmCtx->InitializationTime );
-    txDone.LastTxAirTime = MacCtx.TxTimeOnAir;
+    txDone.ElapsedTimeSinceStartUp = SysTimeSub( SysTimeGetMcuTime( ), MacCtx->NvmCtx->InitializationTime );
+    txDone.LastTxAirTime = MacCtx->TxTimeOnAir;
     txDone.Joined  = true;
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         txDone.Joined  = false;
     }
 
-    RegionSetBandTxDone( MacCtx.NvmCtx->Region, &txDone );
+    RegionSetBandTxDone( MacCtx->NvmCtx->Region, &txDone );
 
-    if( MacCtx.NodeAckRequested == false )
+    if( MacCtx->NodeAckRequested == false )
     {
-        MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+        MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
     }
 }
 
 static void PrepareRxDoneAbort( void )
 {
-    MacCtx.MacState |= LORAMAC_RX_ABORT;
+    MacCtx->MacState |= LORAMAC_RX_ABORT;
 
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
         OnAckTimeoutTimerEvent( NULL );
     }
 
-    MacCtx.MacFlags.Bits.McpsInd = 1;
-    MacCtx.MacFlags.Bits.MacDone = 1;
+    MacCtx->MacFlags.Bits.McpsInd = 1;
+    MacCtx->MacFlags.Bits.MacDone = 1;
 
     UpdateRxSlotIdleState( );
 }
@@ -942,54 +1266,67 @@ static void ProcessRadioRxDone( void )
     uint8_t pktHeaderLen = 0;
 
     uint32_t downLinkCounter = 0;
-    uint32_t address = MacCtx.NvmCtx->DevAddr;
+    uint32_t address = MacCtx->NvmCtx->DevAddr;
     uint8_t multicast = 0;
     AddressIdentifier_t addrID = UNICAST_DEV_ADDR;
     FCntIdentifier_t fCntID;
-
-    MacCtx.McpsConfirm.AckReceived = false;
-    MacCtx.McpsIndication.Rssi = rssi;
-    MacCtx.McpsIndication.Snr = snr;
-    MacCtx.McpsIndication.RxSlot = MacCtx.RxSlot;
-    MacCtx.McpsIndication.Port = 0;
-    MacCtx.McpsIndication.Multicast = 0;
-    MacCtx.McpsIndication.FramePending = 0;
-    MacCtx.McpsIndication.Buffer = NULL;
-    MacCtx.McpsIndication.BufferSize = 0;
-    MacCtx.McpsIndication.RxData = false;
-    MacCtx.McpsIndication.AckReceived = false;
-    MacCtx.McpsIndication.DownLinkCounter = 0;
-    MacCtx.McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
-    MacCtx.McpsIndication.DevAddress = 0;
-    MacCtx.McpsIndication.DeviceTimeAnsReceived = false;
+    LoRaMacRxSlot_t rxSlot = MacCtx->RxSlot;
 
     Radio.Sleep( );
-    TimerStop( &MacCtx.RxWindowTimer2 );
+    TimerStop( &MacCtx->RxWindowTimer2 );
+
+    // The RSSI, SNR and reception time of the downlinks are device specific
+    srand1Mix( ( ( uint32_t )( uint16_t )rssi << 16 ) ^ ( ( uint32_t )( uint8_t )snr << 8 ) ^ RxDoneParams.LastRxDone );
 
     // This function must be called even if we are not in class b mode yet.
     if( LoRaMacClassBRxBeacon( payload, size ) == true )
     {
-        MacCtx.MlmeIndication.BeaconInfo.Rssi = rssi;
-        MacCtx.MlmeIndication.BeaconInfo.Snr = snr;
+        MacCtx->MlmeIndication.BeaconInfo.Rssi = rssi;
+        MacCtx->MlmeIndication.BeaconInfo.Snr = snr;
         return;
     }
     // Check if we expect a ping or a multicast slot.
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         if( LoRaMacClassBIsPingExpected( ) == true )
         {
             LoRaMacClassBSetPingSlotState( PINGSLOT_STATE_CALC_PING_OFFSET );
             LoRaMacClassBPingSlotTimerEvent( NULL );
-            MacCtx.McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_B_PING_SLOT;
+            rxSlot = RX_SLOT_WIN_CLASS_B_PING_SLOT;
         }
         else if( LoRaMacClassBIsMulticastExpected( ) == true )
         {
             LoRaMacClassBSetMulticastSlotState( PINGSLOT_STATE_CALC_PING_OFFSET );
             LoRaMacClassBMulticastSlotTimerEvent( NULL );
-            MacCtx.McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT;
+            rxSlot = RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT;
         }
     }
 
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+    if( MacCtx->RxUnsecure.IsPending == true )
+    {
+        // A single downlink is unsecured at a time and the indication still
+        // belongs to it. Drop the frame.
+        return;
+    }
+#endif
+
+    MacCtx->McpsConfirm.AckReceived = false;
+    MacCtx->McpsIndication.Rssi = rssi;
+    MacCtx->McpsIndication.Snr = snr;
+    MacCtx->McpsIndication.RxSlot = rxSlot;
+    MacCtx->McpsIndication.Port = 0;
+    MacCtx->McpsIndication.Multicast = 0;
+    MacCtx->McpsIndication.FramePending = 0;
+    MacCtx->McpsIndication.Buffer = NULL;
+    MacCtx->McpsIndication.BufferSize = 0;
+    MacCtx->McpsIndication.RxData = false;
+    MacCtx->McpsIndication.AckReceived = false;
+    MacCtx->McpsIndication.DownLinkCounter = 0;
+    MacCtx->McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
+    MacCtx->McpsIndication.DevAddress = 0;
+    MacCtx->McpsIndication.DeviceTimeAnsReceived = false;
+
     macHdr.Value = payload[pktHeaderLen++];
 
     switch( macHdr.Bits.MType )
@@ -998,7 +1335,7 @@ static void ProcessRadioRxDone( void )
             // Check if the received frame size is valid
             if( size < LORAMAC_JOIN_ACCEPT_FRAME_MIN_SIZE )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
@@ -1006,9 +1343,9 @@ static void ProcessRadioRxDone( void )
             macMsgJoinAccept.BufSize = size;
 
             // Abort in case if the device isn't joined yet and no rejoin request is ongoing.
-            if( MacCtx.NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE )
+            if( MacCtx->NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
@@ -1017,37 +1354,39 @@ static void ProcessRadioRxDone( void )
             if( LORAMAC_CRYPTO_SUCCESS == macCryptoStatus )
             {
                 // Network ID
-                MacCtx.NvmCtx->NetID = ( uint32_t ) macMsgJoinAccept.NetID[0];
-                MacCtx.NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[1] << 8 );
-                MacCtx.NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[2] << 16 );
+                MacCtx->NvmCtx->NetID = ( uint32_t ) macMsgJoinAccept.NetID[0];
+                MacCtx->NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[1] << 8 );
+                MacCtx->NvmCtx->NetID |= ( ( uint32_t ) macMsgJoinAccept.NetID[2] << 16 );
 
                 // Device Address
-                MacCtx.NvmCtx->DevAddr = macMsgJoinAccept.DevAddr;
+                MacCtx->NvmCtx->DevAddr = macMsgJoinAccept.DevAddr;
+                UpdateRxFilter( );
 
                 // DLSettings
-                MacCtx.NvmCtx->MacParams.Rx1DrOffset = macMsgJoinAccept.DLSettings.Bits.RX1DRoffset;
-                MacCtx.NvmCtx->MacParams.Rx2Channel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
-                MacCtx.NvmCtx->MacParams.RxCChannel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
+                MacCtx->NvmCtx->MacParams.Rx1DrOffset = macMsgJoinAccept.DLSettings.Bits.RX1DRoffset;
+                MacCtx->NvmCtx->MacParams.Rx2Channel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
+                MacCtx->NvmCtx->MacParams.RxCChannel.Datarate = macMsgJoinAccept.DLSettings.Bits.RX2DataRate;
 
                 // RxDelay
-                MacCtx.NvmCtx->MacParams.ReceiveDelay1 = macMsgJoinAccept.RxDelay;
-                if( MacCtx.NvmCtx->MacParams.ReceiveDelay1 == 0 )
+                MacCtx->NvmCtx->MacParams.ReceiveDelay1 = macMsgJoinAccept.RxDelay;
+                if( MacCtx->NvmCtx->MacParams.ReceiveDelay1 == 0 )
                 {
-                    MacCtx.NvmCtx->MacParams.ReceiveDelay1 = 1;
+                    MacCtx->NvmCtx->MacParams.ReceiveDelay1 = 1;
                 }
-                MacCtx.NvmCtx->MacParams.ReceiveDelay1 *= 1000;
-                MacCtx.NvmCtx->MacParams.ReceiveDelay2 = MacCtx.NvmCtx->MacParams.ReceiveDelay1 + 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay1 *= 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay2 = MacCtx->NvmCtx->MacParams.ReceiveDelay1 + 1000;
 
-                MacCtx.NvmCtx->Version.Fields.Minor = 0;
+                MacCtx->NvmCtx->Version.Fields.Minor = 0;
 
                 // Apply CF list
                 applyCFList.Payload = macMsgJoinAccept.CFList;
                 // Size of the regular payload is 12. Plus 1 byte MHDR and 4 bytes MIC
                 applyCFList.Size = size - 17;
+                applyCFList.JoinChannel = MacCtx->Channel;
 
-                RegionApplyCFList( MacCtx.NvmCtx->Region, &applyCFList );
+                RegionApplyCFList( MacCtx->NvmCtx->Region, &applyCFList );
 
-                MacCtx.NvmCtx->NetworkActivation = ACTIVATION_TYPE_OTAA;
+                MacCtx->NvmCtx->NetworkActivation = ACTIVATION_TYPE_OTAA;
 
                 // MLME handling
                 if( LoRaMacConfirmQueueIsCmdActive( MLME_JOIN ) == true )
@@ -1065,40 +1404,44 @@ static void ProcessRadioRxDone( void )
             }
             break;
         case FRAME_TYPE_DATA_CONFIRMED_DOWN:
-            MacCtx.McpsIndication.McpsIndication = MCPS_CONFIRMED;
+            MacCtx->McpsIndication.McpsIndication = MCPS_CONFIRMED;
             // Intentional fall through
         case FRAME_TYPE_DATA_UNCONFIRMED_DOWN:
             // Check if the received payload size is valid
-            getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-            getPhy.Datarate = MacCtx.McpsIndication.RxDatarate;
+            getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+            getPhy.Datarate = MacCtx->McpsIndication.RxDatarate;
             getPhy.Attribute = PHY_MAX_PAYLOAD;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
             if( ( MAX( 0, ( int16_t )( ( int16_t ) size - ( int16_t ) LORAMAC_FRAME_PAYLOAD_OVERHEAD_SIZE ) ) > ( int16_t )phyParam.Value ) ||
                 ( size < LORAMAC_FRAME_PAYLOAD_MIN_SIZE ) )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
             macMsgData.Buffer = payload;
             macMsgData.BufSize = size;
-            macMsgData.FRMPayload = MacCtx.RxPayload;
+            macMsgData.FRMPayload = MacCtx->RxPayload;
             macMsgData.FRMPayloadSize = LORAMAC_PHY_MAXPAYLOAD;
 
-            if( LORAMAC_PARSER_SUCCESS != LoRaMacParserData( &macMsgData ) )
+            TRACE_POINT_BEGIN( TRACE_POINT_PARSER_DATA );
+            LoRaMacParserStatus_t parserStatus = LoRaMacParserData( &macMsgData );
+            TRACE_POINT_END( TRACE_POINT_PARSER_DATA );
+
+            if( LORAMAC_PARSER_SUCCESS != parserStatus )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
 
             // Store device address
-            MacCtx.McpsIndication.DevAddress = macMsgData.FHDR.DevAddr;
+            MacCtx->McpsIndication.DevAddress = macMsgData.FHDR.DevAddr;
 
             FType_t fType;
             if( LORAMAC_STATUS_OK != DetermineFrameType( &macMsgData, &fType ) )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
@@ -1108,16 +1451,16 @@ static void ProcessRadioRxDone( void )
             downLinkCounter = 0;
             for( uint8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
             {
-                if( ( MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.Address == macMsgData.FHDR.DevAddr ) &&
-                    ( MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true ) )
+                if( ( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address == macMsgData.FHDR.DevAddr ) &&
+                    ( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true ) )
                 {
                     multicast = 1;
-                    addrID = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.GroupID;
-                    downLinkCounter = *( MacCtx.NvmCtx->MulticastChannelList[i].DownLinkCounter );
-                    address = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.Address;
-                    if( MacCtx.NvmCtx->DeviceClass == CLASS_C )
+                    addrID = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.GroupID;
+                    downLinkCounter = *( MacCtx->NvmCtx->MulticastChannelList[i].DownLinkCounter );
+                    address = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address;
+                    if( MacCtx->NvmCtx->DeviceClass == CLASS_C )
                     {
-                        MacCtx.McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
+                        MacCtx->McpsIndication.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
                     }
                     break;
                 }
@@ -1128,232 +1471,279 @@ static void ProcessRadioRxDone( void )
                                         ( macMsgData.FHDR.FCtrl.Bits.Ack != 0 ) ||
                                         ( macMsgData.FHDR.FCtrl.Bits.AdrAckReq != 0 ) ) )
             {
-                MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 PrepareRxDoneAbort( );
                 return;
             }
 
             // Get maximum allowed counter difference
             getPhy.Attribute = PHY_MAX_FCNT_GAP;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             // Get downlink frame counter value
-            macCryptoStatus = GetFCntDown( addrID, fType, &macMsgData, MacCtx.NvmCtx->Version, phyParam.Value, &fCntID, &downLinkCounter );
+            macCryptoStatus = GetFCntDown( addrID, fType, &macMsgData, MacCtx->NvmCtx->Version, phyParam.Value, &fCntID, &downLinkCounter );
             if( macCryptoStatus != LORAMAC_CRYPTO_SUCCESS )
             {
                 if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_FCNT_DUPLICATED )
                 {
                     // Catch the case of repeated downlink frame counter
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_REPEATED;
-                    if( ( MacCtx.NvmCtx->Version.Fields.Minor == 0 ) && ( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN ) && ( MacCtx.NvmCtx->LastRxMic == macMsgData.MIC ) )
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_REPEATED;
+                    if( ( MacCtx->NvmCtx->Version.Fields.Minor == 0 ) && ( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN ) && ( MacCtx->NvmCtx->LastRxMic == macMsgData.MIC ) )
                     {
-                        MacCtx.NvmCtx->SrvAckRequested = true;
+                        MacCtx->NvmCtx->SrvAckRequested = true;
                     }
                 }
                 else if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_MAX_GAP_FCNT )
                 {
                     // Lost too many frames
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_TOO_MANY_FRAMES_LOSS;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_DOWNLINK_TOO_MANY_FRAMES_LOSS;
                 }
                 else
                 {
                     // Other errors
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+                    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
                 }
-                MacCtx.McpsIndication.DownLinkCounter = downLinkCounter;
+                MacCtx->McpsIndication.DownLinkCounter = downLinkCounter;
                 PrepareRxDoneAbort( );
                 return;
             }
 
-            macCryptoStatus = LoRaMacCryptoUnsecureMessage( addrID, address, fCntID, downLinkCounter, &macMsgData );
-            if( macCryptoStatus != LORAMAC_CRYPTO_SUCCESS )
-            {
-                if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_ADDRESS )
-                {
-                    // We are not the destination of this frame.
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ADDRESS_FAIL;
-                }
-                else
-                {
-                    // MIC calculation fail
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_MIC_FAIL;
-                }
-                PrepareRxDoneAbort( );
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+            // The processing continues in OnRxUnsecureDone once the secure element is done.
+            // The frame is copied as the radio driver buffer is reused by the next reception.
+            memcpy1( MacCtx->RxUnsecure.Buffer, payload, size );
+            MacCtx->RxUnsecure.MacHdr = macHdr;
+            MacCtx->RxUnsecure.MacMsg = macMsgData;
+            MacCtx->RxUnsecure.MacMsg.Buffer = MacCtx->RxUnsecure.Buffer;
+            MacCtx->RxUnsecure.FType = fType;
+            MacCtx->RxUnsecure.Multicast = multicast;
+            MacCtx->RxUnsecure.DownLinkCounter = downLinkCounter;
+            macCryptoStatus = LoRaMacCryptoUnsecureMessageAsync( addrID, address, fCntID, downLinkCounter, &MacCtx->RxUnsecure.MacMsg, OnRxUnsecureDone, NULL );
+            if( macCryptoStatus == LORAMAC_CRYPTO_SUCCESS )
+            {
+                MacCtx->RxUnsecure.IsPending = true;
                 return;
             }
+#else
+            TRACE_POINT_BEGIN( TRACE_POINT_UNSECURE_MESSAGE );
+            macCryptoStatus = LoRaMacCryptoUnsecureMessage( addrID, address, fCntID, downLinkCounter, &macMsgData );
+            TRACE_POINT_END( TRACE_POINT_UNSECURE_MESSAGE );
+#endif
+            ProcessRadioRxDoneData( macCryptoStatus, macHdr, &macMsgData, fType, multicast, downLinkCounter );
+            return;
+        case FRAME_TYPE_PROPRIETARY:
+            memcpy1( MacCtx->RxPayload, &payload[pktHeaderLen], size - pktHeaderLen );
 
-            // Frame is valid
-            MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
-            MacCtx.McpsIndication.Multicast = multicast;
-            MacCtx.McpsIndication.FramePending = macMsgData.FHDR.FCtrl.Bits.FPending;
-            MacCtx.McpsIndication.Buffer = NULL;
-            MacCtx.McpsIndication.BufferSize = 0;
-            MacCtx.McpsIndication.DownLinkCounter = downLinkCounter;
-            MacCtx.McpsIndication.AckReceived = macMsgData.FHDR.FCtrl.Bits.Ack;
+            MacCtx->McpsIndication.McpsIndication = MCPS_PROPRIETARY;
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+            MacCtx->McpsIndication.Buffer = MacCtx->RxPayload;
+            MacCtx->McpsIndication.BufferSize = size - pktHeaderLen;
 
-            MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
-            MacCtx.McpsConfirm.AckReceived = macMsgData.FHDR.FCtrl.Bits.Ack;
+            MacCtx->MacFlags.Bits.McpsInd = 1;
+            break;
+        default:
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+            PrepareRxDoneAbort( );
+            break;
+    }
 
-            // Reset ADR ACK Counter only, when RX1 or RX2 slot
-            if( ( MacCtx.McpsIndication.RxSlot == RX_SLOT_WIN_1 ) ||
-                ( MacCtx.McpsIndication.RxSlot == RX_SLOT_WIN_2 ) )
-            {
-                MacCtx.NvmCtx->AdrAckCounter = 0;
-            }
+    ProcessRadioRxDoneEnd( );
+}
 
-            // MCPS Indication and ack requested handling
-            if( multicast == 1 )
-            {
-                MacCtx.McpsIndication.McpsIndication = MCPS_MULTICAST;
-            }
-            else
-            {
-                if( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN )
-                {
-                    MacCtx.NvmCtx->SrvAckRequested = true;
-                    if( MacCtx.NvmCtx->Version.Fields.Minor == 0 )
-                    {
-                        MacCtx.NvmCtx->LastRxMic = macMsgData.MIC;
-                    }
-                    MacCtx.McpsIndication.McpsIndication = MCPS_CONFIRMED;
-                }
-                else
-                {
-                    MacCtx.NvmCtx->SrvAckRequested = false;
-                    MacCtx.McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
-                }
-            }
+static void ProcessRadioRxDoneData( LoRaMacCryptoStatus_t macCryptoStatus, LoRaMacHeader_t macHdr, LoRaMacMessageData_t* macMsgData,
+                                    FType_t fType, uint8_t multicast, uint32_t downLinkCounter )
+{
+    if( macCryptoStatus != LORAMAC_CRYPTO_SUCCESS )
+    {
+        if( macCryptoStatus == LORAMAC_CRYPTO_FAIL_ADDRESS )
+        {
+            // We are not the destination of this frame.
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ADDRESS_FAIL;
+        }
+        else
+        {
+            // MIC calculation fail
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_MIC_FAIL;
+        }
+        PrepareRxDoneAbort( );
+        return;
+    }
 
-            RemoveMacCommands( MacCtx.McpsIndication.RxSlot, macMsgData.FHDR.FCtrl, MacCtx.McpsConfirm.McpsRequest );
+    // Frame is valid
+    MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+    MacCtx->McpsIndication.Multicast = multicast;
+    MacCtx->McpsIndication.FramePending = macMsgData->FHDR.FCtrl.Bits.FPending;
+    MacCtx->McpsIndication.Buffer = NULL;
+    MacCtx->McpsIndication.BufferSize = 0;
+    MacCtx->McpsIndication.DownLinkCounter = downLinkCounter;
+    MacCtx->McpsIndication.AckReceived = macMsgData->FHDR.FCtrl.Bits.Ack;
 
-            switch( fType )
-            {
-                case FRAME_TYPE_A:
-                {  /* +----------+------+-------+--------------+
-                    * | FOptsLen | Fopt | FPort |  FRMPayload  |
-                    * +----------+------+-------+--------------+
-                    * |    > 0   |   X  |  > 0  |       X      |
-                    * +----------+------+-------+--------------+
-                    */
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_OK;
+    MacCtx->McpsConfirm.AckReceived = macMsgData->FHDR.FCtrl.Bits.Ack;
 
-                    // Decode MAC commands in FOpts field
-                    ProcessMacCommands( macMsgData.FHDR.FOpts, 0, macMsgData.FHDR.FCtrl.Bits.FOptsLen, snr, MacCtx.McpsIndication.RxSlot );
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
-                    MacCtx.McpsIndication.Buffer = macMsgData.FRMPayload;
-                    MacCtx.McpsIndication.BufferSize = macMsgData.FRMPayloadSize;
-                    MacCtx.McpsIndication.RxData = true;
-                    break;
-                }
-                case FRAME_TYPE_B:
-                {  /* +----------+------+-------+--------------+
-                    * | FOptsLen | Fopt | FPort |  FRMPayload  |
-                    * +----------+------+-------+--------------+
-                    * |    > 0   |   X  |   -   |       -      |
-                    * +----------+------+-------+--------------+
-                    */
-
-                    // Decode MAC commands in FOpts field
-                    ProcessMacCommands( macMsgData.FHDR.FOpts, 0, macMsgData.FHDR.FCtrl.Bits.FOptsLen, snr, MacCtx.McpsIndication.RxSlot );
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
-                    break;
-                }
-                case FRAME_TYPE_C:
-                {  /* +----------+------+-------+--------------+
-                    * | FOptsLen | Fopt | FPort |  FRMPayload  |
-                    * +----------+------+-------+--------------+
-                    * |    = 0   |   -  |  = 0  | MAC commands |
-                    * +----------+------+-------+--------------+
-                    */
-
-                    // Decode MAC commands in FRMPayload
-                    ProcessMacCommands( macMsgData.FRMPayload, 0, macMsgData.FRMPayloadSize, snr, MacCtx.McpsIndication.RxSlot );
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
-                    break;
-                }
-                case FRAME_TYPE_D:
-                {  /* +----------+------+-------+--------------+
-                    * | FOptsLen | Fopt | FPort |  FRMPayload  |
-                    * +----------+------+-------+--------------+
-                    * |    = 0   |   -  |  > 0  |       X      |
-                    * +----------+------+-------+--------------+
-                    */
-
-                    // No MAC commands just application payload
-                    MacCtx.McpsIndication.Port = macMsgData.FPort;
-                    MacCtx.McpsIndication.Buffer = macMsgData.FRMPayload;
-                    MacCtx.McpsIndication.BufferSize = macMsgData.FRMPayloadSize;
-                    MacCtx.McpsIndication.RxData = true;
-                    break;
-                }
-                default:
-                    MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
-                    PrepareRxDoneAbort( );
-                    break;
-            }
+    // Reset ADR ACK Counter only, when RX1 or RX2 slot
+    if( ( MacCtx->McpsIndication.RxSlot == RX_SLOT_WIN_1 ) ||
+        ( MacCtx->McpsIndication.RxSlot == RX_SLOT_WIN_2 ) )
+    {
+        MacCtx->NvmCtx->AdrAckCounter = 0;
+    }
 
-            // Provide always an indication, skip the callback to the user application,
-            // in case of a confirmed downlink retransmission.
-            MacCtx.MacFlags.Bits.McpsInd = 1;
+    // MCPS Indication and ack requested handling
+    if( multicast == 1 )
+    {
+        MacCtx->McpsIndication.McpsIndication = MCPS_MULTICAST;
+    }
+    else
+    {
+        if( macHdr.Bits.MType == FRAME_TYPE_DATA_CONFIRMED_DOWN )
+        {
+            MacCtx->NvmCtx->SrvAckRequested = true;
+            if( MacCtx->NvmCtx->Version.Fields.Minor == 0 )
+            {
+                MacCtx->NvmCtx->LastRxMic = macMsgData->MIC;
+            }
+            MacCtx->McpsIndication.McpsIndication = MCPS_CONFIRMED;
+        }
+        else
+        {
+            MacCtx->NvmCtx->SrvAckRequested = false;
+            MacCtx->McpsIndication.McpsIndication = MCPS_UNCONFIRMED;
+        }
+    }
 
-            break;
-        case FRAME_TYPE_PROPRIETARY:
-            memcpy1( MacCtx.RxPayload, &payload[pktHeaderLen], size - pktHeaderLen );
+    RemoveMacCommands( MacCtx->McpsIndication.RxSlot, macMsgData->FHDR.FCtrl, MacCtx->McpsConfirm.McpsRequest );
 
-            MacCtx.McpsIndication.McpsIndication = MCPS_PROPRIETARY;
-            MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
-            MacCtx.McpsIndication.Buffer = MacCtx.RxPayload;
-            MacCtx.McpsIndication.BufferSize = size - pktHeaderLen;
+    switch( fType )
+    {
+        case FRAME_TYPE_A:
+        {  /* +----------+------+-------+--------------+
+            * | FOptsLen | Fopt | FPort |  FRMPayload  |
+            * +----------+------+-------+--------------+
+            * |    > 0   |   X  |  > 0  |       X      |
+            * +----------+------+-------+--------------+
+            */
 
-            MacCtx.MacFlags.Bits.McpsInd = 1;
+            // Decode MAC commands in FOpts field
+            TRACE_POINT_BEGIN( TRACE_POINT_MAC_COMMANDS );
+            ProcessMacCommands( macMsgData->FHDR.FOpts, 0, macMsgData->FHDR.FCtrl.Bits.FOptsLen, MacCtx->McpsIndication.Snr, MacCtx->McpsIndication.RxSlot );
+            TRACE_POINT_END( TRACE_POINT_MAC_COMMANDS );
+            MacCtx->McpsIndication.Port = macMsgData->FPort;
+            MacCtx->McpsIndication.Buffer = macMsgData->FRMPayload;
+            MacCtx->McpsIndication.BufferSize = macMsgData->FRMPayloadSize;
+            MacCtx->McpsIndication.RxData = true;
+            break;
+        }
+        case FRAME_TYPE_B:
+        {  /* +----------+------+-------+--------------+
+            * | FOptsLen | Fopt | FPort |  FRMPayload  |
+            * +----------+------+-------+--------------+
+            * |    > 0   |   X  |   -   |       -      |
+            * +----------+------+-------+--------------+
+            */
+
+            // Decode MAC commands in FOpts field
+            TRACE_POINT_BEGIN( TRACE_POINT_MAC_COMMANDS );
+            ProcessMacCommands( macMsgData->FHDR.FOpts, 0, macMsgData->FHDR.FCtrl.Bits.FOptsLen, MacCtx->McpsIndication.Snr, MacCtx->McpsIndication.RxSlot );
+            TRACE_POINT_END( TRACE_POINT_MAC_COMMANDS );
+            MacCtx->McpsIndication.Port = macMsgData->FPort;
+            break;
+        }
+        case FRAME_TYPE_C:
+        {  /* +----------+------+-------+--------------+
+            * | FOptsLen | Fopt | FPort |  FRMPayload  |
+            * +----------+------+-------+--------------+
+            * |    = 0   |   -  |  = 0  | MAC commands |
+            * +----------+------+-------+--------------+
+            */
+
+            // Decode MAC commands in FRMPayload
+            TRACE_POINT_BEGIN( TRACE_POINT_MAC_COMMANDS );
+            ProcessMacCommands( macMsgData->FRMPayload, 0, macMsgData->FRMPayloadSize, MacCtx->McpsIndication.Snr, MacCtx->McpsIndication.RxSlot );
+            TRACE_POINT_END( TRACE_POINT_MAC_COMMANDS );
+            MacCtx->McpsIndication.Port = macMsgData->FPort;
             break;
+        }
+        case FRAME_TYPE_D:
+        {  /* +----------+------+-------+--------------+
+            * | FOptsLen | Fopt | FPort |  FRMPayload  |
+            * +----------+------+-------+--------------+
+            * |    = 0   |   -  |  > 0  |       X      |
+            * +----------+------+-------+--------------+
+            */
+
+            // No MAC commands just application payload
+            MacCtx->McpsIndication.Port = macMsgData->FPort;
+            MacCtx->McpsIndication.Buffer = macMsgData->FRMPayload;
+            MacCtx->McpsIndication.BufferSize = macMsgData->FRMPayloadSize;
+            MacCtx->McpsIndication.RxData = true;
+            break;
+        }
         default:
-            MacCtx.McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+            MacCtx->McpsIndication.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
             PrepareRxDoneAbort( );
             break;
     }
 
+    // Provide always an indication, skip the callback to the user application,
+    // in case of a confirmed downlink retransmission.
+    MacCtx->MacFlags.Bits.McpsInd = 1;
+
+    ProcessRadioRxDoneEnd( );
+}
+
+static void ProcessRadioRxDoneEnd( void )
+{
     // Verify if we need to disable the AckTimeoutTimer
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
-        if( MacCtx.McpsConfirm.AckReceived == true )
+        if( MacCtx->McpsConfirm.AckReceived == true )
         {
             OnAckTimeoutTimerEvent( NULL );
         }
     }
     else
     {
-        if( MacCtx.NvmCtx->DeviceClass == CLASS_C )
+        if( MacCtx->NvmCtx->DeviceClass == CLASS_C )
         {
             OnAckTimeoutTimerEvent( NULL );
         }
     }
-    MacCtx.MacFlags.Bits.MacDone = 1;
+    MacCtx->MacFlags.Bits.MacDone = 1;
 
     UpdateRxSlotIdleState( );
 }
 
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+static void OnRxUnsecureDone( LoRaMacCryptoStatus_t status, void* context )
+{
+    MacCtx->RxUnsecure.IsPending = false;
+    ProcessRadioRxDoneData( status, MacCtx->RxUnsecure.MacHdr, &MacCtx->RxUnsecure.MacMsg, MacCtx->RxUnsecure.FType,
+                            MacCtx->RxUnsecure.Multicast, MacCtx->RxUnsecure.DownLinkCounter );
+}
+#endif
+
 static void ProcessRadioTxTimeout( void )
 {
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
         Radio.Sleep( );
     }
     UpdateRxSlotIdleState( );
 
-    MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT;
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT;
     LoRaMacConfirmQueueSetStatusCmn( LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT );
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
-        MacCtx.AckTimeoutRetry = true;
+        MacCtx->AckTimeoutRetry = true;
     }
-    MacCtx.MacFlags.Bits.MacDone = 1;
+    MacCtx->MacFlags.Bits.MacDone = 1;
 }
 
 static void HandleRadioRxErrorTimeout( LoRaMacEventInfoStatus_t rx1EventInfoStatus, LoRaMacEventInfoStatus_t rx2EventInfoStatus )
 {
     bool classBRx = false;
 
-    if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
     {
         Radio.Sleep( );
     }
@@ -1364,7 +1754,7 @@ static void HandleRadioRxErrorTimeout( LoRaMacEventInfoStatus_t rx1EventInfoStat
         LoRaMacClassBBeaconTimerEvent( NULL );
         classBRx = true;
     }
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         if( LoRaMacClassBIsPingExpected( ) == true )
         {
@@ -1382,31 +1772,31 @@ static void HandleRadioRxErrorTimeout( LoRaMacEventInfoStatus_t rx1EventInfoStat
 
     if( classBRx == false )
     {
-        if( MacCtx.RxSlot == RX_SLOT_WIN_1 )
+        if( MacCtx->RxSlot == RX_SLOT_WIN_1 )
         {
-            if( MacCtx.NodeAckRequested == true )
+            if( MacCtx->NodeAckRequested == true )
             {
-                MacCtx.McpsConfirm.Status = rx1EventInfoStatus;
+                MacCtx->McpsConfirm.Status = rx1EventInfoStatus;
             }
             LoRaMacConfirmQueueSetStatusCmn( rx1EventInfoStatus );
 
-            if( TimerGetElapsedTime( MacCtx.NvmCtx->LastTxDoneTime ) >= MacCtx.RxWindow2Delay )
+            if( TimerGetElapsedTime( MacCtx->NvmCtx->LastTxDoneTime ) >= TimerTicks2Ms( MacCtx->RxWindow2Delay ) )
             {
-                TimerStop( &MacCtx.RxWindowTimer2 );
-                MacCtx.MacFlags.Bits.MacDone = 1;
+                TimerStop( &MacCtx->RxWindowTimer2 );
+                MacCtx->MacFlags.Bits.MacDone = 1;
             }
         }
         else
         {
-            if( MacCtx.NodeAckRequested == true )
+            if( MacCtx->NodeAckRequested == true )
             {
-                MacCtx.McpsConfirm.Status = rx2EventInfoStatus;
+                MacCtx->McpsConfirm.Status = rx2EventInfoStatus;
             }
             LoRaMacConfirmQueueSetStatusCmn( rx2EventInfoStatus );
 
-            if( MacCtx.NvmCtx->DeviceClass != CLASS_C )
+            if( MacCtx->NvmCtx->DeviceClass != CLASS_C )
             {
-                MacCtx.MacFlags.Bits.MacDone = 1;
+                MacCtx->MacFlags.Bits.MacDone = 1;
             }
         }
     }
@@ -1424,10 +1814,51 @@ static void ProcessRadioRxTimeout( void )
     HandleRadioRxErrorTimeout( LORAMAC_EVENT_INFO_STATUS_RX1_TIMEOUT, LORAMAC_EVENT_INFO_STATUS_RX2_TIMEOUT );
 }
 
+static void ProcessRadioChannelFreeDone( void )
+{
+    LoRaMacStatus_t status = LORAMAC_STATUS_ERROR;
+
+    if( ( MacCtx->MacState & LORAMAC_CARRIER_SENSE ) != LORAMAC_CARRIER_SENSE )
+    {
+        // No listen before talk procedure pending
+        return;
+    }
+
+    status = RegionCarrierSenseDone( MacCtx->NvmCtx->Region, ChannelFreeDoneParams.IsFree, &MacCtx->Channel );
+    if( status == LORAMAC_STATUS_CARRIER_SENSE_ONGOING )
+    {
+        // The next channel is being sensed
+        return;
+    }
+    MacCtx->MacState &= ~LORAMAC_CARRIER_SENSE;
+
+    if( status == LORAMAC_STATUS_OK )
+    {
+        status = ScheduleTxOnChannel( );
+    }
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        // No free channel found or the frame can't be sent. Stop the transmission attempt
+        MacCtx->McpsConfirm.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+        MacCtx->McpsConfirm.NbRetries = MacCtx->AckTimeoutRetriesCounter;
+        MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+        LoRaMacConfirmQueueSetStatusCmn( LORAMAC_EVENT_INFO_STATUS_ERROR );
+        StopRetransmission( );
+        LoRaMacHandleRequestEvents( );
+    }
+}
+
 static void LoRaMacHandleIrqEvents( void )
 {
     LoRaMacRadioEvents_t events;
 
+    if( Instance != RadioInstance )
+    {
+        // The events belong to the instance driving the radio
+        return;
+    }
+
     CRITICAL_SECTION_BEGIN( );
     events = LoRaMacRadioEvents;
     LoRaMacRadioEvents.Value = 0;
@@ -1441,7 +1872,9 @@ static void LoRaMacHandleIrqEvents( void )
         }
         if( events.Events.RxDone == 1 )
         {
+            TRACE_POINT_BEGIN( TRACE_POINT_RADIO_RX_DONE );
             ProcessRadioRxDone( );
+            TRACE_POINT_END( TRACE_POINT_RADIO_RX_DONE );
         }
         if( events.Events.TxTimeout == 1 )
         {
@@ -1455,41 +1888,122 @@ static void LoRaMacHandleIrqEvents( void )
         {
             ProcessRadioRxTimeout( );
         }
+        if( events.Events.ChannelFreeDone == 1 )
+        {
+            ProcessRadioChannelFreeDone( );
+        }
     }
 }
 
 bool LoRaMacIsBusy( void )
 {
-    if( ( MacCtx.MacState == LORAMAC_IDLE ) &&
-        ( MacCtx.AllowRequests == LORAMAC_REQUEST_HANDLING_ON ) )
+    if( ( MacCtx->MacState == LORAMAC_IDLE ) &&
+        ( MacCtx->AllowRequests == LORAMAC_REQUEST_HANDLING_ON ) )
     {
         return false;
     }
     return true;
 }
 
+/*!
+ * \brief Replaces the deadline when the given timer expires before it
+ *
+ * \param [IN/OUT] deadline   Next deadline
+ * \param [IN] timer          Timer of the candidate deadline
+ * \param [IN] owner          Owner of the candidate deadline
+ * \param [IN] leadTime       Time the timer expires ahead of the deadline
+ * \param [IN] canRunLate     The candidate deadline tolerates to be served late
+ */
+static void UpdateNextDeadline( LoRaMacDeadline_t* deadline, TimerEvent_t* timer, LoRaMacDeadlineOwner_t owner, uint32_t leadTime, bool canRunLate )
+{
+    TimerTime_t remainingTime = TimerGetRemainingTime( timer );
+
+    if( ( remainingTime != TIMERTIME_T_MAX ) &&
+        ( ( deadline->Owner == LORAMAC_DEADLINE_NONE ) || ( remainingTime < ( deadline->Time - deadline->LeadTime ) ) ) )
+    {
+        deadline->Owner = owner;
+        deadline->Time = remainingTime + leadTime;
+        deadline->LeadTime = leadTime;
+        deadline->CanRunLate = canRunLate;
+    }
+}
+
+LoRaMacStatus_t LoRaMacGetNextDeadline( LoRaMacDeadline_t* deadline )
+{
+    TimerEvent_t* nextTimer = NULL;
+    uint32_t wakeupTime = 0;
+
+    if( deadline == NULL )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    deadline->Owner = LORAMAC_DEADLINE_NONE;
+    deadline->Time = TIMERTIME_T_MAX;
+    deadline->LeadTime = 0;
+    deadline->CanRunLate = true;
+
+    // Events which LoRaMacProcess hasn't handled yet
+    if( ( ( LoRaMacRadioEvents.Value != 0 ) && ( Instance == RadioInstance ) ) ||
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+        ( MacCtx->PendingTimerEvents != 0 ) ||
+#endif
+        ( MacCtx->MacFlags.Bits.McpsInd == 1 ) ||
+        ( MacCtx->MacFlags.Bits.MlmeInd == 1 ) ||
+        ( MacCtx->MacFlags.Bits.MlmeSchedUplinkInd == 1 ) ||
+        ( SecureElementIsJobPending( ) == true ) )
+    {
+        deadline->Owner = LORAMAC_DEADLINE_PROCESS;
+        deadline->Time = 0;
+        deadline->CanRunLate = false;
+        return LORAMAC_STATUS_OK;
+    }
+
+    // The RX window timers already expire the radio wake up time ahead of the windows
+    wakeupTime = Radio.GetWakeupTime( );
+    UpdateNextDeadline( deadline, &MacCtx->RxWindowTimer1, LORAMAC_DEADLINE_RX_WINDOW_1, wakeupTime, false );
+    UpdateNextDeadline( deadline, &MacCtx->RxWindowTimer2, LORAMAC_DEADLINE_RX_WINDOW_2, wakeupTime, false );
+    UpdateNextDeadline( deadline, &MacCtx->TxDelayedTimer, LORAMAC_DEADLINE_TX_DELAYED, 0, true );
+    UpdateNextDeadline( deadline, &MacCtx->AckTimeoutTimer, LORAMAC_DEADLINE_ACK_TIMEOUT, 0, true );
+    LoRaMacClassBGetNextDeadline( deadline );
+
+    if( deadline->Owner == LORAMAC_DEADLINE_PROCESS )
+    {
+        return LORAMAC_STATUS_OK;
+    }
+
+    // Any other timer, e.g. from the application or a package
+    TimerGetNextExpiry( &nextTimer );
+    if( ( nextTimer != NULL ) &&
+        ( nextTimer != &MacCtx->RxWindowTimer1 ) && ( nextTimer != &MacCtx->RxWindowTimer2 ) &&
+        ( nextTimer != &MacCtx->TxDelayedTimer ) && ( nextTimer != &MacCtx->AckTimeoutTimer ) )
+    {
+        UpdateNextDeadline( deadline, nextTimer, LORAMAC_DEADLINE_TIMER, 0, true );
+    }
+    return LORAMAC_STATUS_OK;
+}
 
 static void LoRaMacEnableRequests( LoRaMacRequestHandling_t requestState )
 {
-    MacCtx.AllowRequests = requestState;
+    MacCtx->AllowRequests = requestState;
 }
 
 static void LoRaMacHandleRequestEvents( void )
 {
     // Handle events
-    LoRaMacFlags_t reqEvents = MacCtx.MacFlags;
+    LoRaMacFlags_t reqEvents = MacCtx->MacFlags;
 
-    if( MacCtx.MacState == LORAMAC_IDLE )
+    if( MacCtx->MacState == LORAMAC_IDLE )
     {
         // Update event bits
-        if( MacCtx.MacFlags.Bits.McpsReq == 1 )
+        if( MacCtx->MacFlags.Bits.McpsReq == 1 )
         {
-            MacCtx.MacFlags.Bits.McpsReq = 0;
+            MacCtx->MacFlags.Bits.McpsReq = 0;
         }
 
-        if( MacCtx.MacFlags.Bits.MlmeReq == 1 )
+        if( MacCtx->MacFlags.Bits.MlmeReq == 1 )
         {
-            MacCtx.MacFlags.Bits.MlmeReq = 0;
+            MacCtx->MacFlags.Bits.MlmeReq = 0;
         }
 
         // Allow requests again
@@ -1498,15 +2012,15 @@ static void LoRaMacHandleRequestEvents( void )
         // Handle callbacks
         if( reqEvents.Bits.McpsReq == 1 )
         {
-            MacCtx.MacPrimitives->MacMcpsConfirm( &MacCtx.McpsConfirm );
+            MacCtx->MacPrimitives->MacMcpsConfirm( &MacCtx->McpsConfirm );
         }
 
         if( reqEvents.Bits.MlmeReq == 1 )
         {
-            LoRaMacConfirmQueueHandleCb( &MacCtx.MlmeConfirm );
+            LoRaMacConfirmQueueHandleCb( &MacCtx->MlmeConfirm );
             if( LoRaMacConfirmQueueGetCnt( ) > 0 )
             {
-                MacCtx.MacFlags.Bits.MlmeReq = 1;
+                MacCtx->MacFlags.Bits.MlmeReq = 1;
             }
         }
 
@@ -1514,14 +2028,14 @@ static void LoRaMacHandleRequestEvents( void )
         LoRaMacClassBResumeBeaconing( );
 
         // Procedure done. Reset variables.
-        MacCtx.MacFlags.Bits.MacDone = 0;
+        MacCtx->MacFlags.Bits.MacDone = 0;
     }
 }
 
 static void LoRaMacHandleScheduleUplinkEvent( void )
 {
     // Handle events
-    if( MacCtx.MacState == LORAMAC_IDLE )
+    if( MacCtx->MacState == LORAMAC_IDLE )
     {
         // Verify if sticky MAC commands are pending or not
         bool isStickyMacCommandPending = false;
@@ -1536,50 +2050,50 @@ static void LoRaMacHandleScheduleUplinkEvent( void )
 static void LoRaMacHandleIndicationEvents( void )
 {
     // Handle MLME indication
-    if( MacCtx.MacFlags.Bits.MlmeInd == 1 )
+    if( MacCtx->MacFlags.Bits.MlmeInd == 1 )
     {
-        MacCtx.MacFlags.Bits.MlmeInd = 0;
-        MacCtx.MacPrimitives->MacMlmeIndication( &MacCtx.MlmeIndication );
+        MacCtx->MacFlags.Bits.MlmeInd = 0;
+        MacCtx->MacPrimitives->MacMlmeIndication( &MacCtx->MlmeIndication );
     }
 
-    if( MacCtx.MacFlags.Bits.MlmeSchedUplinkInd == 1 )
+    if( MacCtx->MacFlags.Bits.MlmeSchedUplinkInd == 1 )
     {
         MlmeIndication_t schduleUplinkIndication;
         schduleUplinkIndication.MlmeIndication = MLME_SCHEDULE_UPLINK;
         schduleUplinkIndication.Status = LORAMAC_EVENT_INFO_STATUS_OK;
 
-        MacCtx.MacPrimitives->MacMlmeIndication( &schduleUplinkIndication );
-        MacCtx.MacFlags.Bits.MlmeSchedUplinkInd = 0;
+        MacCtx->MacPrimitives->MacMlmeIndication( &schduleUplinkIndication );
+        MacCtx->MacFlags.Bits.MlmeSchedUplinkInd = 0;
     }
 
     // Handle MCPS indication
-    if( MacCtx.MacFlags.Bits.McpsInd == 1 )
+    if( MacCtx->MacFlags.Bits.McpsInd == 1 )
     {
-        MacCtx.MacFlags.Bits.McpsInd = 0;
-        MacCtx.MacPrimitives->MacMcpsIndication( &MacCtx.McpsIndication );
+        MacCtx->MacFlags.Bits.McpsInd = 0;
+        MacCtx->MacPrimitives->MacMcpsIndication( &MacCtx->McpsIndication );
     }
 }
 
 static void LoRaMacHandleMcpsRequest( void )
 {
     // Handle MCPS uplinks
-    if( MacCtx.MacFlags.Bits.McpsReq == 1 )
+    if( MacCtx->MacFlags.Bits.McpsReq == 1 )
     {
         bool stopRetransmission = false;
         bool waitForRetransmission = false;
 
-        if( ( MacCtx.McpsConfirm.McpsRequest == MCPS_UNCONFIRMED ) ||
-            ( MacCtx.McpsConfirm.McpsRequest == MCPS_PROPRIETARY ) )
+        if( ( MacCtx->McpsConfirm.McpsRequest == MCPS_UNCONFIRMED ) ||
+            ( MacCtx->McpsConfirm.McpsRequest == MCPS_PROPRIETARY ) )
         {
             stopRetransmission = CheckRetransUnconfirmedUplink( );
         }
-        else if( MacCtx.McpsConfirm.McpsRequest == MCPS_CONFIRMED )
+        else if( MacCtx->McpsConfirm.McpsRequest == MCPS_CONFIRMED )
         {
-            if( MacCtx.AckTimeoutRetry == true )
+            if( MacCtx->AckTimeoutRetry == true )
             {
                 stopRetransmission = CheckRetransConfirmedUplink( );
 
-                if( MacCtx.NvmCtx->Version.Fields.Minor == 0 )
+                if( MacCtx->NvmCtx->Version.Fields.Minor == 0 )
                 {
                     if( stopRetransmission == false )
                     {
@@ -1599,15 +2113,15 @@ static void LoRaMacHandleMcpsRequest( void )
 
         if( stopRetransmission == true )
         {// Stop retransmission
-            TimerStop( &MacCtx.TxDelayedTimer );
-            MacCtx.MacState &= ~LORAMAC_TX_DELAYED;
+            TimerStop( &MacCtx->TxDelayedTimer );
+            MacCtx->MacState &= ~LORAMAC_TX_DELAYED;
             StopRetransmission( );
         }
         else if( waitForRetransmission == false )
         {// Arrange further retransmission
-            MacCtx.MacFlags.Bits.MacDone = 0;
+            MacCtx->MacFlags.Bits.MacDone = 0;
             // Reset the state of the AckTimeout
-            MacCtx.AckTimeoutRetry = false;
+            MacCtx->AckTimeoutRetry = false;
             // Sends the same frame again
             OnTxDelayedTimerEvent( NULL );
         }
@@ -1617,20 +2131,20 @@ static void LoRaMacHandleMcpsRequest( void )
 static void LoRaMacHandleMlmeRequest( void )
 {
     // Handle join request
-    if( MacCtx.MacFlags.Bits.MlmeReq == 1 )
+    if( MacCtx->MacFlags.Bits.MlmeReq == 1 )
     {
         if( LoRaMacConfirmQueueIsCmdActive( MLME_JOIN ) == true )
         {
             if( LoRaMacConfirmQueueGetStatus( MLME_JOIN ) == LORAMAC_EVENT_INFO_STATUS_OK )
             {// Node joined successfully
-                MacCtx.ChannelsNbTransCounter = 0;
+                MacCtx->ChannelsNbTransCounter = 0;
             }
-            MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+            MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
         }
         else if( ( LoRaMacConfirmQueueIsCmdActive( MLME_TXCW ) == true ) ||
                  ( LoRaMacConfirmQueueIsCmdActive( MLME_TXCW_1 ) == true ) )
         {
-            MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+            MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
         }
     }
 }
@@ -1638,11 +2152,11 @@ static void LoRaMacHandleMlmeRequest( void )
 static uint8_t LoRaMacCheckForBeaconAcquisition( void )
 {
     if( ( LoRaMacConfirmQueueIsCmdActive( MLME_BEACON_ACQUISITION ) == true ) &&
-        ( MacCtx.MacFlags.Bits.McpsReq == 0 ) )
+        ( MacCtx->MacFlags.Bits.McpsReq == 0 ) )
     {
-        if( MacCtx.MacFlags.Bits.MlmeReq == 1 )
+        if( MacCtx->MacFlags.Bits.MlmeReq == 1 )
         {
-            MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+            MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
             return 0x01;
         }
     }
@@ -1652,23 +2166,55 @@ static uint8_t LoRaMacCheckForBeaconAcquisition( void )
 static void LoRaMacCheckForRxAbort( void )
 {
     // A error occurs during receiving
-    if( ( MacCtx.MacState & LORAMAC_RX_ABORT ) == LORAMAC_RX_ABORT )
+    if( ( MacCtx->MacState & LORAMAC_RX_ABORT ) == LORAMAC_RX_ABORT )
     {
-        MacCtx.MacState &= ~LORAMAC_RX_ABORT;
-        MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+        MacCtx->MacState &= ~LORAMAC_RX_ABORT;
+        MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
     }
 }
 
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+static void LoRaMacHandleTimerEvents( void )
+{
+    uint8_t events;
+
+    CRITICAL_SECTION_BEGIN( );
+    events = MacCtx->PendingTimerEvents;
+    MacCtx->PendingTimerEvents = 0;
+    CRITICAL_SECTION_END( );
+
+    if( ( events & ( 1 << LORAMAC_DEADLINE_TX_DELAYED ) ) != 0 )
+    {
+        OnTxDelayedTimerEvent( NULL );
+    }
+    if( ( events & ( 1 << LORAMAC_DEADLINE_RX_WINDOW_1 ) ) != 0 )
+    {
+        OnRxWindow1TimerEvent( NULL );
+    }
+    if( ( events & ( 1 << LORAMAC_DEADLINE_RX_WINDOW_2 ) ) != 0 )
+    {
+        OnRxWindow2TimerEvent( NULL );
+    }
+    if( ( events & ( 1 << LORAMAC_DEADLINE_ACK_TIMEOUT ) ) != 0 )
+    {
+        OnAckTimeoutTimerEvent( NULL );
+    }
+}
+#endif
 
 void LoRaMacProcess( void )
 {
     uint8_t noTx = false;
 
     LoRaMacHandleIrqEvents( );
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    LoRaMacHandleTimerEvents( );
+#endif
+    SecureElementProcess( );
     LoRaMacClassBProcess( );
 
     // MAC proceeded a state and is ready to check
-    if( MacCtx.MacFlags.Bits.MacDone == 1 )
+    if( MacCtx->MacFlags.Bits.MacDone == 1 )
     {
         LoRaMacEnableRequests( LORAMAC_REQUEST_HANDLING_OFF );
         LoRaMacCheckForRxAbort( );
@@ -1689,7 +2235,7 @@ void LoRaMacProcess( void )
         LoRaMacEnableRequests( LORAMAC_REQUEST_HANDLING_ON );
     }
     LoRaMacHandleIndicationEvents( );
-    if( MacCtx.RxSlot == RX_SLOT_WIN_CLASS_C )
+    if( MacCtx->RxSlot == RX_SLOT_WIN_CLASS_C )
     {
         OpenContinuousRxCWindow( );
     }
@@ -1697,11 +2243,22 @@ void LoRaMacProcess( void )
 
 static void OnTxDelayedTimerEvent( void* context )
 {
-    TimerStop( &MacCtx.TxDelayedTimer );
-    MacCtx.MacState &= ~LORAMAC_TX_DELAYED;
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    if( DeferTimerEvent( context, LORAMAC_DEADLINE_TX_DELAYED ) == true )
+    {
+        return;
+    }
+#endif
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_TX_DELAYED }, 1, NULL, 0 );
+    TimerStop( &MacCtx->TxDelayedTimer );
+    MacCtx->MacState &= ~LORAMAC_TX_DELAYED;
 
     // Schedule frame, allow delayed frame transmissions
-    switch( ScheduleTx( true ) )
+    TRACE_POINT_BEGIN( TRACE_POINT_SCHEDULE_TX );
+    LoRaMacStatus_t status = ScheduleTx( true );
+    TRACE_POINT_END( TRACE_POINT_SCHEDULE_TX );
+
+    switch( status )
     {
         case LORAMAC_STATUS_OK:
         case LORAMAC_STATUS_DUTYCYCLE_RESTRICTED:
@@ -1711,9 +2268,9 @@ static void OnTxDelayedTimerEvent( void* context )
         default:
         {
             // Stop retransmission attempt
-            MacCtx.McpsConfirm.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-            MacCtx.McpsConfirm.NbRetries = MacCtx.AckTimeoutRetriesCounter;
-            MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_DR_PAYLOAD_SIZE_ERROR;
+            MacCtx->McpsConfirm.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+            MacCtx->McpsConfirm.NbRetries = MacCtx->AckTimeoutRetriesCounter;
+            MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_TX_DR_PAYLOAD_SIZE_ERROR;
             LoRaMacConfirmQueueSetStatusCmn( LORAMAC_EVENT_INFO_STATUS_TX_DR_PAYLOAD_SIZE_ERROR );
             StopRetransmission( );
             break;
@@ -1723,50 +2280,114 @@ static void OnTxDelayedTimerEvent( void* context )
 
 static void OnRxWindow1TimerEvent( void* context )
 {
-    MacCtx.RxWindow1Config.Channel = MacCtx.Channel;
-    MacCtx.RxWindow1Config.DrOffset = MacCtx.NvmCtx->MacParams.Rx1DrOffset;
-    MacCtx.RxWindow1Config.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindow1Config.RxContinuous = false;
-    MacCtx.RxWindow1Config.RxSlot = RX_SLOT_WIN_1;
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    if( DeferTimerEvent( context, LORAMAC_DEADLINE_RX_WINDOW_1 ) == true )
+    {
+        return;
+    }
+#endif
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_RX_WINDOW_1 }, 1, NULL, 0 );
+#if defined( TRACE_POINT_ENABLED )
+    TraceRxWindowLatency( TRACE_POINT_RX_WINDOW_1_LATENCY, TimerTicks2Us( MacCtx->RxWindow1Delay ) );
+#endif
+    MacCtx->RxWindow1Config.Channel = MacCtx->Channel;
+    MacCtx->RxWindow1Config.DrOffset = MacCtx->NvmCtx->MacParams.Rx1DrOffset;
+    MacCtx->RxWindow1Config.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindow1Config.RxContinuous = false;
+    MacCtx->RxWindow1Config.RxSlot = RX_SLOT_WIN_1;
 
-    RxWindowSetup( &MacCtx.RxWindowTimer1, &MacCtx.RxWindow1Config );
+    RxWindowSetup( &MacCtx->RxWindowTimer1, &MacCtx->RxWindow1Config );
 }
 
+#if defined( TRACE_POINT_ENABLED )
+static void TraceRxWindowLatency( TracePointId_t id, uint64_t delay )
+{
+    uint32_t elapsed = TracePointGetTicks( ) - TxDoneParams.TraceTicks;
+    uint32_t expected = ( uint32_t )( ( delay * TracePointGetFrequency( ) ) / 1000000 );
+
+    // Windows opening early are recorded as 0
+    TRACE_POINT_VALUE( id, ( elapsed > expected ) ? ( elapsed - expected ) : 0 );
+}
+#endif
+
 static void OnRxWindow2TimerEvent( void* context )
 {
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    if( DeferTimerEvent( context, LORAMAC_DEADLINE_RX_WINDOW_2 ) == true )
+    {
+        return;
+    }
+#endif
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_RX_WINDOW_2 }, 1, NULL, 0 );
     // Check if we are processing Rx1 window.
     // If yes, we don't setup the Rx2 window.
-    if( MacCtx.RxSlot == RX_SLOT_WIN_1 )
+    if( MacCtx->RxSlot == RX_SLOT_WIN_1 )
     {
         return;
     }
-    MacCtx.RxWindow2Config.Channel = MacCtx.Channel;
-    MacCtx.RxWindow2Config.Frequency = MacCtx.NvmCtx->MacParams.Rx2Channel.Frequency;
-    MacCtx.RxWindow2Config.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindow2Config.RxContinuous = false;
-    MacCtx.RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
+#if defined( TRACE_POINT_ENABLED )
+    TraceRxWindowLatency( TRACE_POINT_RX_WINDOW_2_LATENCY, TimerTicks2Us( MacCtx->RxWindow2Delay ) );
+#endif
+    MacCtx->RxWindow2Config.Channel = MacCtx->Channel;
+    MacCtx->RxWindow2Config.Frequency = MacCtx->NvmCtx->MacParams.Rx2Channel.Frequency;
+    MacCtx->RxWindow2Config.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindow2Config.RxContinuous = false;
+    MacCtx->RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
 
-    RxWindowSetup( &MacCtx.RxWindowTimer2, &MacCtx.RxWindow2Config );
+    RxWindowSetup( &MacCtx->RxWindowTimer2, &MacCtx->RxWindow2Config );
 }
 
 static void OnAckTimeoutTimerEvent( void* context )
 {
-    TimerStop( &MacCtx.AckTimeoutTimer );
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    if( DeferTimerEvent( context, LORAMAC_DEADLINE_ACK_TIMEOUT ) == true )
+    {
+        return;
+    }
+#endif
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_ACK_TIMEOUT }, 1, NULL, 0 );
+    TimerStop( &MacCtx->AckTimeoutTimer );
 
-    if( MacCtx.NodeAckRequested == true )
+    if( MacCtx->NodeAckRequested == true )
     {
-        MacCtx.AckTimeoutRetry = true;
+        MacCtx->AckTimeoutRetry = true;
     }
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_C )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_C )
     {
-        MacCtx.MacFlags.Bits.MacDone = 1;
+        MacCtx->MacFlags.Bits.MacDone = 1;
     }
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->MacProcessNotify != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->MacProcessNotify != NULL ) )
     {
-        MacCtx.MacCallbacks->MacProcessNotify( );
+        MacCtx->MacCallbacks->MacProcessNotify( );
     }
 }
 
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+static bool DeferTimerEvent( void* context, LoRaMacDeadlineOwner_t owner )
+{
+    LoRaMacCtx_t* ctx;
+
+    if( context == NULL )
+    {
+        return false;
+    }
+    ctx = &( ( LoRaMacInstance_t* )context )->MacCtx;
+    ctx->PendingTimerEvents |= 1 << owner;
+
+    if( ( ctx->MacCallbacks != NULL ) && ( ctx->MacCallbacks->MacProcessNotify != NULL ) )
+    {
+        ctx->MacCallbacks->MacProcessNotify( );
+    }
+    return true;
+}
+#endif
+
+static void OnClassBRadioRxStart( void )
+{
+    RadioInstance = Instance;
+    UpdateRxFilter( );
+}
+
 static LoRaMacCryptoStatus_t GetFCntDown( AddressIdentifier_t addrID, FType_t fType, LoRaMacMessageData_t* macMsg, Version_t lrWanVersion,
                                           uint16_t maxFCntGap, FCntIdentifier_t* fCntID, uint32_t* currentDown )
 {
@@ -1819,50 +2440,50 @@ static LoRaMacStatus_t SwitchClass( DeviceClass_t deviceClass )
 {
     LoRaMacStatus_t status = LORAMAC_STATUS_PARAMETER_INVALID;
 
-    switch( MacCtx.NvmCtx->DeviceClass )
+    switch( MacCtx->NvmCtx->DeviceClass )
     {
         case CLASS_A:
         {
             if( deviceClass == CLASS_A )
             {
                 // Revert back RxC parameters
-                MacCtx.NvmCtx->MacParams.RxCChannel = MacCtx.NvmCtx->MacParams.Rx2Channel;
+                MacCtx->NvmCtx->MacParams.RxCChannel = MacCtx->NvmCtx->MacParams.Rx2Channel;
             }
             if( deviceClass == CLASS_B )
             {
                 status = LoRaMacClassBSwitchClass( deviceClass );
                 if( status == LORAMAC_STATUS_OK )
                 {
-                    MacCtx.NvmCtx->DeviceClass = deviceClass;
+                    MacCtx->NvmCtx->DeviceClass = deviceClass;
                 }
             }
 
             if( deviceClass == CLASS_C )
             {
-                MacCtx.NvmCtx->DeviceClass = deviceClass;
+                MacCtx->NvmCtx->DeviceClass = deviceClass;
 
-                MacCtx.RxWindowCConfig = MacCtx.RxWindow2Config;
-                MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+                MacCtx->RxWindowCConfig = MacCtx->RxWindow2Config;
+                MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
 
                 for( int8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
                 {
-                    if( MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true )
+                    if( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true )
                     // TODO: Check multicast channel device class.
                     {
-                        MacCtx.NvmCtx->MacParams.RxCChannel.Frequency = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Frequency;
-                        MacCtx.NvmCtx->MacParams.RxCChannel.Datarate = MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Datarate;
-
-                        MacCtx.RxWindowCConfig.Channel = MacCtx.Channel;
-                        MacCtx.RxWindowCConfig.Frequency = MacCtx.NvmCtx->MacParams.RxCChannel.Frequency;
-                        MacCtx.RxWindowCConfig.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-                        MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
-                        MacCtx.RxWindowCConfig.RxContinuous = true;
+                        MacCtx->NvmCtx->MacParams.RxCChannel.Frequency = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Frequency;
+                        MacCtx->NvmCtx->MacParams.RxCChannel.Datarate = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.RxParams.ClassC.Datarate;
+
+                        MacCtx->RxWindowCConfig.Channel = MacCtx->Channel;
+                        MacCtx->RxWindowCConfig.Frequency = MacCtx->NvmCtx->MacParams.RxCChannel.Frequency;
+                        MacCtx->RxWindowCConfig.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+                        MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C_MULTICAST;
+                        MacCtx->RxWindowCConfig.RxContinuous = true;
                         break;
                     }
                 }
 
                 // Set the NodeAckRequested indicator to default
-                MacCtx.NodeAckRequested = false;
+                MacCtx->NodeAckRequested = false;
                 // Set the radio into sleep mode in case we are still in RX mode
                 Radio.Sleep( );
 
@@ -1877,7 +2498,7 @@ static LoRaMacStatus_t SwitchClass( DeviceClass_t deviceClass )
             status = LoRaMacClassBSwitchClass( deviceClass );
             if( status == LORAMAC_STATUS_OK )
             {
-                MacCtx.NvmCtx->DeviceClass = deviceClass;
+                MacCtx->NvmCtx->DeviceClass = deviceClass;
             }
             break;
         }
@@ -1885,7 +2506,7 @@ static LoRaMacStatus_t SwitchClass( DeviceClass_t deviceClass )
         {
             if( deviceClass == CLASS_A )
             {
-                MacCtx.NvmCtx->DeviceClass = deviceClass;
+                MacCtx->NvmCtx->DeviceClass = deviceClass;
 
                 // Set the radio into sleep to setup a defined state
                 Radio.Sleep( );
@@ -1905,10 +2526,10 @@ static uint8_t GetMaxAppPayloadWithoutFOptsLength( int8_t datarate )
     PhyParam_t phyParam;
 
     // Setup PHY request
-    getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
+    getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
     getPhy.Datarate = datarate;
     getPhy.Attribute = PHY_MAX_PAYLOAD;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
     return phyParam.Value;
 }
@@ -1933,7 +2554,7 @@ static bool ValidatePayloadLength( uint8_t lenN, int8_t datarate, uint8_t fOptsL
 
 static void SetMlmeScheduleUplinkIndication( void )
 {
-    MacCtx.MacFlags.Bits.MlmeSchedUplinkInd = 1;
+    MacCtx->MacFlags.Bits.MlmeSchedUplinkInd = 1;
 }
 
 static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t commandsSize, int8_t snr, LoRaMacRxSlot_t rxSlot )
@@ -1958,8 +2579,8 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 if( LoRaMacConfirmQueueIsCmdActive( MLME_LINK_CHECK ) == true )
                 {
                     LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_LINK_CHECK );
-                    MacCtx.MlmeConfirm.DemodMargin = payload[macIndex++];
-                    MacCtx.MlmeConfirm.NbGateways = payload[macIndex++];
+                    MacCtx->MlmeConfirm.DemodMargin = payload[macIndex++];
+                    MacCtx->MlmeConfirm.NbGateways = payload[macIndex++];
                 }
                 break;
             }
@@ -1978,22 +2599,22 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                     // Fill parameter structure
                     linkAdrReq.Payload = &payload[macIndex - 1];
                     linkAdrReq.PayloadSize = commandsSize - ( macIndex - 1 );
-                    linkAdrReq.AdrEnabled = MacCtx.NvmCtx->AdrCtrlOn;
-                    linkAdrReq.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-                    linkAdrReq.CurrentDatarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-                    linkAdrReq.CurrentTxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-                    linkAdrReq.CurrentNbRep = MacCtx.NvmCtx->MacParams.ChannelsNbTrans;
-                    linkAdrReq.Version = MacCtx.NvmCtx->Version;
+                    linkAdrReq.AdrEnabled = MacCtx->NvmCtx->AdrCtrlOn;
+                    linkAdrReq.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+                    linkAdrReq.CurrentDatarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+                    linkAdrReq.CurrentTxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+                    linkAdrReq.CurrentNbRep = MacCtx->NvmCtx->MacParams.ChannelsNbTrans;
+                    linkAdrReq.Version = MacCtx->NvmCtx->Version;
 
                     // Process the ADR requests
-                    status = RegionLinkAdrReq( MacCtx.NvmCtx->Region, &linkAdrReq, &linkAdrDatarate,
+                    status = RegionLinkAdrReq( MacCtx->NvmCtx->Region, &linkAdrReq, &linkAdrDatarate,
                                                &linkAdrTxPower, &linkAdrNbRep, &linkAdrNbBytesParsed );
 
                     if( ( status & 0x07 ) == 0x07 )
                     {
-                        MacCtx.NvmCtx->MacParams.ChannelsDatarate = linkAdrDatarate;
-                        MacCtx.NvmCtx->MacParams.ChannelsTxPower = linkAdrTxPower;
-                        MacCtx.NvmCtx->MacParams.ChannelsNbTrans = linkAdrNbRep;
+                        MacCtx->NvmCtx->MacParams.ChannelsDatarate = linkAdrDatarate;
+                        MacCtx->NvmCtx->MacParams.ChannelsTxPower = linkAdrTxPower;
+                        MacCtx->NvmCtx->MacParams.ChannelsNbTrans = linkAdrNbRep;
                     }
 
                     // Add the answers to the buffer
@@ -2008,8 +2629,8 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
             }
             case SRV_MAC_DUTY_CYCLE_REQ:
             {
-                MacCtx.NvmCtx->MaxDCycle = payload[macIndex++] & 0x0F;
-                MacCtx.NvmCtx->AggregatedDCycle = 1 << MacCtx.NvmCtx->MaxDCycle;
+                MacCtx->NvmCtx->MaxDCycle = payload[macIndex++] & 0x0F;
+                MacCtx->NvmCtx->AggregatedDCycle = 1 << MacCtx->NvmCtx->MaxDCycle;
                 LoRaMacCommandsAddCmd( MOTE_MAC_DUTY_CYCLE_ANS, macCmdPayload, 0 );
                 break;
             }
@@ -2028,15 +2649,15 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 rxParamSetupReq.Frequency *= 100;
 
                 // Perform request on region
-                status = RegionRxParamSetupReq( MacCtx.NvmCtx->Region, &rxParamSetupReq );
+                status = RegionRxParamSetupReq( MacCtx->NvmCtx->Region, &rxParamSetupReq );
 
                 if( ( status & 0x07 ) == 0x07 )
                 {
-                    MacCtx.NvmCtx->MacParams.Rx2Channel.Datarate = rxParamSetupReq.Datarate;
-                    MacCtx.NvmCtx->MacParams.RxCChannel.Datarate = rxParamSetupReq.Datarate;
-                    MacCtx.NvmCtx->MacParams.Rx2Channel.Frequency = rxParamSetupReq.Frequency;
-                    MacCtx.NvmCtx->MacParams.RxCChannel.Frequency = rxParamSetupReq.Frequency;
-                    MacCtx.NvmCtx->MacParams.Rx1DrOffset = rxParamSetupReq.DrOffset;
+                    MacCtx->NvmCtx->MacParams.Rx2Channel.Datarate = rxParamSetupReq.Datarate;
+                    MacCtx->NvmCtx->MacParams.RxCChannel.Datarate = rxParamSetupReq.Datarate;
+                    MacCtx->NvmCtx->MacParams.Rx2Channel.Frequency = rxParamSetupReq.Frequency;
+                    MacCtx->NvmCtx->MacParams.RxCChannel.Frequency = rxParamSetupReq.Frequency;
+                    MacCtx->NvmCtx->MacParams.Rx1DrOffset = rxParamSetupReq.DrOffset;
                 }
                 macCmdPayload[0] = status;
                 LoRaMacCommandsAddCmd( MOTE_MAC_RX_PARAM_SETUP_ANS, macCmdPayload, 1 );
@@ -2047,9 +2668,9 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
             case SRV_MAC_DEV_STATUS_REQ:
             {
                 uint8_t batteryLevel = BAT_LEVEL_NO_MEASURE;
-                if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->GetBatteryLevel != NULL ) )
+                if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->GetBatteryLevel != NULL ) )
                 {
-                    batteryLevel = MacCtx.MacCallbacks->GetBatteryLevel( );
+                    batteryLevel = MacCtx->MacCallbacks->GetBatteryLevel( );
                 }
                 macCmdPayload[0] = batteryLevel;
                 macCmdPayload[1] = ( uint8_t )( snr & 0x3F );
@@ -2072,7 +2693,7 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 chParam.Rx1Frequency = 0;
                 chParam.DrRange.Value = payload[macIndex++];
 
-                status = RegionNewChannelReq( MacCtx.NvmCtx->Region, &newChannelReq );
+                status = RegionNewChannelReq( MacCtx->NvmCtx->Region, &newChannelReq );
 
                 macCmdPayload[0] = status;
                 LoRaMacCommandsAddCmd( MOTE_MAC_NEW_CHANNEL_ANS, macCmdPayload, 1 );
@@ -2086,8 +2707,8 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 {
                     delay++;
                 }
-                MacCtx.NvmCtx->MacParams.ReceiveDelay1 = delay * 1000;
-                MacCtx.NvmCtx->MacParams.ReceiveDelay2 = MacCtx.NvmCtx->MacParams.ReceiveDelay1 + 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay1 = delay * 1000;
+                MacCtx->NvmCtx->MacParams.ReceiveDelay2 = MacCtx->NvmCtx->MacParams.ReceiveDelay1 + 1000;
                 LoRaMacCommandsAddCmd( MOTE_MAC_RX_TIMING_SETUP_ANS, macCmdPayload, 0 );
                 // Setup indication to inform the application
                 SetMlmeScheduleUplinkIndication( );
@@ -2114,17 +2735,17 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 txParamSetupReq.MaxEirp = eirpDwellTime & 0x0F;
 
                 // Check the status for correctness
-                if( RegionTxParamSetupReq( MacCtx.NvmCtx->Region, &txParamSetupReq ) != -1 )
+                if( RegionTxParamSetupReq( MacCtx->NvmCtx->Region, &txParamSetupReq ) != -1 )
                 {
                     // Accept command
-                    MacCtx.NvmCtx->MacParams.UplinkDwellTime = txParamSetupReq.UplinkDwellTime;
-                    MacCtx.NvmCtx->MacParams.DownlinkDwellTime = txParamSetupReq.DownlinkDwellTime;
-                    MacCtx.NvmCtx->MacParams.MaxEirp = LoRaMacMaxEirpTable[txParamSetupReq.MaxEirp];
+                    MacCtx->NvmCtx->MacParams.UplinkDwellTime = txParamSetupReq.UplinkDwellTime;
+                    MacCtx->NvmCtx->MacParams.DownlinkDwellTime = txParamSetupReq.DownlinkDwellTime;
+                    MacCtx->NvmCtx->MacParams.MaxEirp = LoRaMacMaxEirpTable[txParamSetupReq.MaxEirp];
                     // Update the datarate in case of the new configuration limits it
                     getPhy.Attribute = PHY_MIN_TX_DR;
-                    getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-                    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-                    MacCtx.NvmCtx->MacParams.ChannelsDatarate = MAX( MacCtx.NvmCtx->MacParams.ChannelsDatarate, ( int8_t )phyParam.Value );
+                    getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+                    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+                    MacCtx->NvmCtx->MacParams.ChannelsDatarate = MAX( MacCtx->NvmCtx->MacParams.ChannelsDatarate, ( int8_t )phyParam.Value );
 
                     // Add command response
                     LoRaMacCommandsAddCmd( MOTE_MAC_TX_PARAM_SETUP_ANS, macCmdPayload, 0 );
@@ -2142,7 +2763,7 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                 dlChannelReq.Rx1Frequency |= ( uint32_t ) payload[macIndex++] << 16;
                 dlChannelReq.Rx1Frequency *= 100;
 
-                status = RegionDlChannelReq( MacCtx.NvmCtx->Region, &dlChannelReq );
+                status = RegionDlChannelReq( MacCtx->NvmCtx->Region, &dlChannelReq );
                 macCmdPayload[0] = status;
                 LoRaMacCommandsAddCmd( MOTE_MAC_DL_CHANNEL_ANS, macCmdPayload, 1 );
                 // Setup indication to inform the application
@@ -2175,12 +2796,12 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
 
                     // Compensate time difference between Tx Done time and now
                     sysTimeCurrent = SysTimeGet( );
-                    sysTime = SysTimeAdd( sysTimeCurrent, SysTimeSub( sysTime, MacCtx.LastTxSysTime ) );
+                    sysTime = SysTimeAdd( sysTimeCurrent, SysTimeSub( sysTime, MacCtx->LastTxSysTime ) );
 
                     // Apply the new system time.
                     SysTimeSet( sysTime );
                     LoRaMacClassBDeviceTimeAns( );
-                    MacCtx.McpsIndication.DeviceTimeAnsReceived = true;
+                    MacCtx->McpsIndication.DeviceTimeAnsReceived = true;
                 }
                 break;
             }
@@ -2191,7 +2812,7 @@ static void ProcessMacCommands( uint8_t *payload, uint8_t macIndex, uint8_t comm
                     LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_PING_SLOT_INFO );
                     // According to the specification, it is not allowed to process this answer in
                     // a ping or multicast slot
-                    if( ( MacCtx.RxSlot != RX_SLOT_WIN_CLASS_B_PING_SLOT ) && ( MacCtx.RxSlot != RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT ) )
+                    if( ( MacCtx->RxSlot != RX_SLOT_WIN_CLASS_B_PING_SLOT ) && ( MacCtx->RxSlot != RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT ) )
                     {
                         LoRaMacClassBPingSlotInfoAns( );
                     }
@@ -2262,27 +2883,27 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
 {
     LoRaMacFrameCtrl_t fCtrl;
     LoRaMacStatus_t status = LORAMAC_STATUS_PARAMETER_INVALID;
-    int8_t datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    int8_t txPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    uint32_t adrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
+    int8_t datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    int8_t txPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    uint32_t adrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
     CalcNextAdrParams_t adrNext;
 
     // Check if we are joined
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         return LORAMAC_STATUS_NO_NETWORK_JOINED;
     }
-    if( MacCtx.NvmCtx->MaxDCycle == 0 )
+    if( MacCtx->NvmCtx->MaxDCycle == 0 )
     {
-        MacCtx.NvmCtx->AggregatedTimeOff = 0;
+        MacCtx->NvmCtx->AggregatedTimeOff = 0;
     }
 
     fCtrl.Value = 0;
     fCtrl.Bits.FOptsLen      = 0;
-    fCtrl.Bits.Adr           = MacCtx.NvmCtx->AdrCtrlOn;
+    fCtrl.Bits.Adr           = MacCtx->NvmCtx->AdrCtrlOn;
 
     // Check class b
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         fCtrl.Bits.FPending      = 1;
     }
@@ -2292,25 +2913,25 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
     }
 
     // Check server ack
-    if( MacCtx.NvmCtx->SrvAckRequested == true )
+    if( MacCtx->NvmCtx->SrvAckRequested == true )
     {
         fCtrl.Bits.Ack = 1;
     }
 
     // ADR next request
-    adrNext.Version = MacCtx.NvmCtx->Version;
+    adrNext.Version = MacCtx->NvmCtx->Version;
     adrNext.UpdateChanMask = true;
     adrNext.AdrEnabled = fCtrl.Bits.Adr;
-    adrNext.AdrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
-    adrNext.AdrAckLimit = MacCtx.AdrAckLimit;
-    adrNext.AdrAckDelay = MacCtx.AdrAckDelay;
-    adrNext.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    adrNext.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    adrNext.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-    adrNext.Region = MacCtx.NvmCtx->Region;
+    adrNext.AdrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
+    adrNext.AdrAckLimit = MacCtx->AdrAckLimit;
+    adrNext.AdrAckDelay = MacCtx->AdrAckDelay;
+    adrNext.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    adrNext.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    adrNext.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+    adrNext.Region = MacCtx->NvmCtx->Region;
 
-    fCtrl.Bits.AdrAckReq = LoRaMacAdrCalcNext( &adrNext, &MacCtx.NvmCtx->MacParams.ChannelsDatarate,
-                                               &MacCtx.NvmCtx->MacParams.ChannelsTxPower, &adrAckCounter );
+    fCtrl.Bits.AdrAckReq = LoRaMacAdrCalcNext( &adrNext, &MacCtx->NvmCtx->MacParams.ChannelsDatarate,
+                                               &MacCtx->NvmCtx->MacParams.ChannelsTxPower, &adrAckCounter );
 
     // Prepare the frame
     status = PrepareFrame( macHdr, &fCtrl, fPort, fBuffer, fBufferSize );
@@ -2318,8 +2939,20 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
     // Validate status
     if( ( status == LORAMAC_STATUS_OK ) || ( status == LORAMAC_STATUS_SKIPPED_APP_DATA ) )
     {
-        // Schedule frame, do not allow delayed transmissions
-        status = ScheduleTx( false );
+        status = LORAMAC_STATUS_OK;
+        if( MacCtx->TxAheadOfTime == true )
+        {
+            // Secure the frame right away. Only the data rate and channel
+            // dependent parts are left for the transmission.
+            status = PrepareSecureFrame( );
+        }
+        if( status == LORAMAC_STATUS_OK )
+        {
+            // Schedule frame, do not allow delayed transmissions
+            TRACE_POINT_BEGIN( TRACE_POINT_SCHEDULE_TX );
+            status = ScheduleTx( false );
+            TRACE_POINT_END( TRACE_POINT_SCHEDULE_TX );
+        }
     }
 
     // Post processing
@@ -2327,14 +2960,14 @@ LoRaMacStatus_t Send( LoRaMacHeader_t* macHdr, uint8_t fPort, void* fBuffer, uin
     {
         // Bad case - restore
         // Store local variables
-        MacCtx.NvmCtx->MacParams.ChannelsDatarate = datarate;
-        MacCtx.NvmCtx->MacParams.ChannelsTxPower = txPower;
+        MacCtx->NvmCtx->MacParams.ChannelsDatarate = datarate;
+        MacCtx->NvmCtx->MacParams.ChannelsTxPower = txPower;
     }
     else
     {
         // Good case
-        MacCtx.NvmCtx->SrvAckRequested = false;
-        MacCtx.NvmCtx->AdrAckCounter = adrAckCounter;
+        MacCtx->NvmCtx->SrvAckRequested = false;
+        MacCtx->NvmCtx->AdrAckCounter = adrAckCounter;
         // Remove all none sticky MAC commands
         if( LoRaMacCommandsRemoveNoneStickyCmds( ) != LORAMAC_COMMANDS_SUCCESS )
         {
@@ -2351,6 +2984,8 @@ LoRaMacStatus_t SendReJoinReq( JoinReqIdentifier_t joinReqType )
     macHdr.Value = 0;
     bool allowDelayedTx = true;
 
+    MacCtx->TxPreparedMsg.IsValid = false;
+
     // Setup join/rejoin message
     switch( joinReqType )
     {
@@ -2358,15 +2993,19 @@ LoRaMacStatus_t SendReJoinReq( JoinReqIdentifier_t joinReqType )
         {
             SwitchClass( CLASS_A );
 
-            MacCtx.TxMsg.Type = LORAMAC_MSG_TYPE_JOIN_REQUEST;
-            MacCtx.TxMsg.Message.JoinReq.Buffer = MacCtx.PktBuffer;
-            MacCtx.TxMsg.Message.JoinReq.BufSize = LORAMAC_PHY_MAXPAYLOAD;
+            // Reseed the channel and timing randomization before each join
+            // attempt, devices joining together mustn't stay synchronized
+            ReseedRandom( );
+
+            MacCtx->TxMsg.Type = LORAMAC_MSG_TYPE_JOIN_REQUEST;
+            MacCtx->TxMsg.Message.JoinReq.Buffer = MacCtx->PktBuffer;
+            MacCtx->TxMsg.Message.JoinReq.BufSize = LORAMAC_PHY_MAXPAYLOAD;
 
             macHdr.Bits.MType = FRAME_TYPE_JOIN_REQ;
-            MacCtx.TxMsg.Message.JoinReq.MHDR.Value = macHdr.Value;
+            MacCtx->TxMsg.Message.JoinReq.MHDR.Value = macHdr.Value;
 
-            memcpy1( MacCtx.TxMsg.Message.JoinReq.JoinEUI, SecureElementGetJoinEui( ), LORAMAC_JOIN_EUI_FIELD_SIZE );
-            memcpy1( MacCtx.TxMsg.Message.JoinReq.DevEUI, SecureElementGetDevEui( ), LORAMAC_DEV_EUI_FIELD_SIZE );
+            memcpy1( MacCtx->TxMsg.Message.JoinReq.JoinEUI, SecureElementGetJoinEui( ), LORAMAC_JOIN_EUI_FIELD_SIZE );
+            memcpy1( MacCtx->TxMsg.Message.JoinReq.DevEUI, SecureElementGetDevEui( ), LORAMAC_DEV_EUI_FIELD_SIZE );
 
             allowDelayedTx = false;
 
@@ -2378,7 +3017,9 @@ LoRaMacStatus_t SendReJoinReq( JoinReqIdentifier_t joinReqType )
     }
 
     // Schedule frame
+    TRACE_POINT_BEGIN( TRACE_POINT_SCHEDULE_TX );
     status = ScheduleTx( allowDelayedTx );
+    TRACE_POINT_END( TRACE_POINT_SCHEDULE_TX );
     return status;
 }
 
@@ -2389,7 +3030,7 @@ static LoRaMacStatus_t CheckForClassBCollision( void )
         return LORAMAC_STATUS_BUSY_BEACON_RESERVED_TIME;
     }
 
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         if( LoRaMacClassBIsPingExpected( ) == true )
         {
@@ -2406,44 +3047,49 @@ static LoRaMacStatus_t CheckForClassBCollision( void )
 static void ComputeRxWindowParameters( void )
 {
     // Compute Rx1 windows parameters
-    RegionComputeRxWindowParameters( MacCtx.NvmCtx->Region,
-                                     RegionApplyDrOffset( MacCtx.NvmCtx->Region,
-                                                          MacCtx.NvmCtx->MacParams.DownlinkDwellTime,
-                                                          MacCtx.NvmCtx->MacParams.ChannelsDatarate,
-                                                          MacCtx.NvmCtx->MacParams.Rx1DrOffset ),
-                                     MacCtx.NvmCtx->MacParams.MinRxSymbols,
-                                     MacCtx.NvmCtx->MacParams.SystemMaxRxError,
-                                     &MacCtx.RxWindow1Config );
+    RegionComputeRxWindowParameters( MacCtx->NvmCtx->Region,
+                                     RegionApplyDrOffset( MacCtx->NvmCtx->Region,
+                                                          MacCtx->NvmCtx->MacParams.DownlinkDwellTime,
+                                                          MacCtx->NvmCtx->MacParams.ChannelsDatarate,
+                                                          MacCtx->NvmCtx->MacParams.Rx1DrOffset ),
+                                     MacCtx->NvmCtx->MacParams.MinRxSymbols,
+                                     MacCtx->NvmCtx->MacParams.SystemMaxRxError,
+                                     &MacCtx->RxWindow1Config );
     // Compute Rx2 windows parameters
-    RegionComputeRxWindowParameters( MacCtx.NvmCtx->Region,
-                                     MacCtx.NvmCtx->MacParams.Rx2Channel.Datarate,
-                                     MacCtx.NvmCtx->MacParams.MinRxSymbols,
-                                     MacCtx.NvmCtx->MacParams.SystemMaxRxError,
-                                     &MacCtx.RxWindow2Config );
+    RegionComputeRxWindowParameters( MacCtx->NvmCtx->Region,
+                                     MacCtx->NvmCtx->MacParams.Rx2Channel.Datarate,
+                                     MacCtx->NvmCtx->MacParams.MinRxSymbols,
+                                     MacCtx->NvmCtx->MacParams.SystemMaxRxError,
+                                     &MacCtx->RxWindow2Config );
 
     // Default setup, in case the device joined
-    MacCtx.RxWindow1Delay = MacCtx.NvmCtx->MacParams.ReceiveDelay1 + MacCtx.RxWindow1Config.WindowOffset;
-    MacCtx.RxWindow2Delay = MacCtx.NvmCtx->MacParams.ReceiveDelay2 + MacCtx.RxWindow2Config.WindowOffset;
+    MacCtx->RxWindow1Delay = GetRxWindowDelay( MacCtx->NvmCtx->MacParams.ReceiveDelay1, MacCtx->RxWindow1Config.WindowOffset );
+    MacCtx->RxWindow2Delay = GetRxWindowDelay( MacCtx->NvmCtx->MacParams.ReceiveDelay2, MacCtx->RxWindow2Config.WindowOffset );
 
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
-        MacCtx.RxWindow1Delay = MacCtx.NvmCtx->MacParams.JoinAcceptDelay1 + MacCtx.RxWindow1Config.WindowOffset;
-        MacCtx.RxWindow2Delay = MacCtx.NvmCtx->MacParams.JoinAcceptDelay2 + MacCtx.RxWindow2Config.WindowOffset;
+        MacCtx->RxWindow1Delay = GetRxWindowDelay( MacCtx->NvmCtx->MacParams.JoinAcceptDelay1, MacCtx->RxWindow1Config.WindowOffset );
+        MacCtx->RxWindow2Delay = GetRxWindowDelay( MacCtx->NvmCtx->MacParams.JoinAcceptDelay2, MacCtx->RxWindow2Config.WindowOffset );
     }
 }
 
+static TimerTicks_t GetRxWindowDelay( uint32_t receiveDelay, int32_t windowOffset )
+{
+    return TimerUs2Ticks( ( uint64_t )( ( ( int64_t )receiveDelay * 1000 ) + windowOffset ) );
+}
+
 static LoRaMacStatus_t VerifyTxFrame( void )
 {
     size_t macCmdsSize = 0;
 
-    if( MacCtx.NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE )
     {
         if( LoRaMacCommandsGetSizeSerializedCmds( &macCmdsSize ) != LORAMAC_COMMANDS_SUCCESS )
         {
             return LORAMAC_STATUS_MAC_COMMAD_ERROR;
         }
 
-        if( ValidatePayloadLength( MacCtx.AppDataSize, MacCtx.NvmCtx->MacParams.ChannelsDatarate, macCmdsSize ) == false )
+        if( ValidatePayloadLength( MacCtx->AppDataSize, MacCtx->NvmCtx->MacParams.ChannelsDatarate, macCmdsSize ) == false )
         {
             return LORAMAC_STATUS_LENGTH_ERROR;
         }
@@ -2455,24 +3101,28 @@ static LoRaMacStatus_t SerializeTxFrame( void )
 {
     LoRaMacSerializerStatus_t serializeStatus;
 
-    switch( MacCtx.TxMsg.Type )
+    switch( MacCtx->TxMsg.Type )
     {
         case LORAMAC_MSG_TYPE_JOIN_REQUEST:
-            serializeStatus = LoRaMacSerializerJoinRequest( &MacCtx.TxMsg.Message.JoinReq );
+            serializeStatus = LoRaMacSerializerJoinRequest( &MacCtx->TxMsg.Message.JoinReq );
             if( LORAMAC_SERIALIZER_SUCCESS != serializeStatus )
             {
                 return LORAMAC_STATUS_CRYPTO_ERROR;
             }
-            MacCtx.PktBufferLen = MacCtx.TxMsg.Message.JoinReq.BufSize;
+            MacCtx->PktBufferLen = MacCtx->TxMsg.Message.JoinReq.BufSize;
             break;
         case LORAMAC_MSG_TYPE_DATA:
-            serializeStatus = LoRaMacSerializerData( &MacCtx.TxMsg.Message.Data );
+        {
+            TRACE_POINT_BEGIN( TRACE_POINT_SERIALIZER_DATA );
+            serializeStatus = LoRaMacSerializerData( &MacCtx->TxMsg.Message.Data );
+            TRACE_POINT_END( TRACE_POINT_SERIALIZER_DATA );
             if( LORAMAC_SERIALIZER_SUCCESS != serializeStatus )
             {
                 return LORAMAC_STATUS_CRYPTO_ERROR;
             }
-            MacCtx.PktBufferLen = MacCtx.TxMsg.Message.Data.BufSize;
+            MacCtx->PktBufferLen = MacCtx->TxMsg.Message.Data.BufSize;
             break;
+        }
         case LORAMAC_MSG_TYPE_JOIN_ACCEPT:
         case LORAMAC_MSG_TYPE_UNDEF:
         default:
@@ -2481,6 +3131,16 @@ static LoRaMacStatus_t SerializeTxFrame( void )
     return LORAMAC_STATUS_OK;
 }
 
+static void ReseedRandom( void )
+{
+    uint32_t seed = Radio.Random( );
+
+    EVENT_LOG_RECORD_RANDOM( seed );
+    srand1Mix( seed );
+    Radio.Sleep( );
+    MacCtx->UplinksSinceReseed = 0;
+}
+
 static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
 {
     LoRaMacStatus_t status = LORAMAC_STATUS_PARAMETER_INVALID;
@@ -2496,31 +3156,54 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
     // Update back-off
     CalculateBackOff( );
 
-    // Serialize frame
-    status = SerializeTxFrame( );
-    if( status != LORAMAC_STATUS_OK )
+    // Serialize frame, unless it has already been secured
+    if( MacCtx->TxPreparedMsg.IsValid == false )
     {
-        return status;
+        status = SerializeTxFrame( );
+        if( status != LORAMAC_STATUS_OK )
+        {
+            return status;
+        }
     }
 
-    nextChan.AggrTimeOff = MacCtx.NvmCtx->AggregatedTimeOff;
-    nextChan.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    nextChan.DutyCycleEnabled = MacCtx.NvmCtx->DutyCycleOn;
-    nextChan.ElapsedTimeSinceStartUp = SysTimeSub( SysTimeGetMcuTime( ), MacCtx.NvmCtx->InitializationTime );
-    nextChan.LastAggrTx = MacCtx.NvmCtx->LastTxDoneTime;
+    nextChan.AggrTimeOff = MacCtx->NvmCtx->AggregatedTimeOff;
+    nextChan.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    nextChan.DutyCycleEnabled = MacCtx->NvmCtx->DutyCycleOn;
+    nextChan.ElapsedTimeSinceStartUp = SysTimeSub( SysTimeGetMcuTime( ), MacCtx->NvmCtx->InitializationTime );
+    nextChan.LastAggrTx = MacCtx->NvmCtx->LastTxDoneTime;
     nextChan.LastTxIsJoinRequest = false;
     nextChan.Joined = true;
-    nextChan.PktLen = MacCtx.PktBufferLen;
+    nextChan.PktLen = MacCtx->PktBufferLen;
+    nextChan.CarrierSenseMode = MacCtx->CarrierSenseMode;
 
     // Setup the parameters based on the join status
-    if( MacCtx.NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
+    if( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE )
     {
         nextChan.LastTxIsJoinRequest = true;
         nextChan.Joined = false;
     }
 
-    // Select channel
-    status = RegionNextChannel( MacCtx.NvmCtx->Region, &nextChan, &MacCtx.Channel, &MacCtx.DutyCycleWaitTime, &MacCtx.NvmCtx->AggregatedTimeOff );
+    // Reseed the channel and timing randomization every few uplinks. The
+    // radio is only borrowed while idle and owned by this instance.
+    if( ( MacCtx->UplinksSinceReseed >= LORAMAC_RAND_RESEED_PERIOD ) &&
+        ( Instance == RadioInstance ) && ( Radio.GetStatus( ) == RF_IDLE ) )
+    {
+        ReseedRandom( );
+    }
+
+    // Select channel, the carrier sense may already use the radio
+    RadioInstance = Instance;
+    TRACE_POINT_BEGIN( TRACE_POINT_NEXT_CHANNEL );
+    status = RegionNextChannel( MacCtx->NvmCtx->Region, &nextChan, &MacCtx->Channel, &MacCtx->DutyCycleWaitTime, &MacCtx->NvmCtx->AggregatedTimeOff );
+    TRACE_POINT_END( TRACE_POINT_NEXT_CHANNEL );
+
+    if( status == LORAMAC_STATUS_CARRIER_SENSE_ONGOING )
+    {
+        // Listen before talk is running. The transmission continues
+        // once the radio signals a free channel.
+        MacCtx->MacState |= LORAMAC_CARRIER_SENSE;
+        return LORAMAC_STATUS_OK;
+    }
 
     if( status != LORAMAC_STATUS_OK )
     {
@@ -2529,11 +3212,11 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
         {
             // Allow delayed transmissions. We have to allow it in case
             // the MAC must retransmit a frame with the frame repetitions
-            if( MacCtx.DutyCycleWaitTime != 0 )
+            if( MacCtx->DutyCycleWaitTime != 0 )
             {// Send later - prepare timer
-                MacCtx.MacState |= LORAMAC_TX_DELAYED;
-                TimerSetValue( &MacCtx.TxDelayedTimer, MacCtx.DutyCycleWaitTime );
-                TimerStart( &MacCtx.TxDelayedTimer );
+                MacCtx->MacState |= LORAMAC_TX_DELAYED;
+                TimerSetValue( &MacCtx->TxDelayedTimer, MacCtx->DutyCycleWaitTime );
+                TimerStart( &MacCtx->TxDelayedTimer );
             }
             return LORAMAC_STATUS_OK;
         }
@@ -2542,6 +3225,12 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
             return status;
         }
     }
+    return ScheduleTxOnChannel( );
+}
+
+static LoRaMacStatus_t ScheduleTxOnChannel( void )
+{
+    LoRaMacStatus_t status = LORAMAC_STATUS_PARAMETER_INVALID;
 
     // Compute window parameters, offsets, rx symbols, system errors etc.
     ComputeRxWindowParameters( );
@@ -2554,7 +3243,7 @@ static LoRaMacStatus_t ScheduleTx( bool allowDelayedTx )
     }
 
     // Try to send now
-    return SendFrameOnChannel( MacCtx.Channel );
+    return SendFrameOnChannel( MacCtx->Channel );
 }
 
 static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
@@ -2562,15 +3251,15 @@ static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
     LoRaMacCryptoStatus_t macCryptoStatus = LORAMAC_CRYPTO_ERROR;
     uint32_t fCntUp = 0;
 
-    switch( MacCtx.TxMsg.Type )
+    switch( MacCtx->TxMsg.Type )
     {
         case LORAMAC_MSG_TYPE_JOIN_REQUEST:
-            macCryptoStatus = LoRaMacCryptoPrepareJoinRequest( &MacCtx.TxMsg.Message.JoinReq );
+            macCryptoStatus = LoRaMacCryptoPrepareJoinRequest( &MacCtx->TxMsg.Message.JoinReq );
             if( LORAMAC_CRYPTO_SUCCESS != macCryptoStatus )
             {
                 return LORAMAC_STATUS_CRYPTO_ERROR;
             }
-            MacCtx.PktBufferLen = MacCtx.TxMsg.Message.JoinReq.BufSize;
+            MacCtx->PktBufferLen = MacCtx->TxMsg.Message.JoinReq.BufSize;
             break;
         case LORAMAC_MSG_TYPE_DATA:
 
@@ -2579,17 +3268,26 @@ static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
                 return LORAMAC_STATUS_FCNT_HANDLER_ERROR;
             }
 
-            if( ( MacCtx.ChannelsNbTransCounter >= 1 ) || ( MacCtx.AckTimeoutRetriesCounter > 1 ) )
+            if( ( MacCtx->ChannelsNbTransCounter >= 1 ) || ( MacCtx->AckTimeoutRetriesCounter > 1 ) )
             {
                 fCntUp -= 1;
             }
 
-            macCryptoStatus = LoRaMacCryptoSecureMessage( fCntUp, txDr, txCh, &MacCtx.TxMsg.Message.Data );
+            TRACE_POINT_BEGIN( TRACE_POINT_SECURE_MESSAGE );
+            if( MacCtx->TxPreparedMsg.IsValid == true )
+            {
+                macCryptoStatus = LoRaMacCryptoSecurePreparedMessage( fCntUp, txDr, txCh, &MacCtx->TxMsg.Message.Data, &MacCtx->TxPreparedMsg );
+            }
+            else
+            {
+                macCryptoStatus = LoRaMacCryptoSecureMessage( fCntUp, txDr, txCh, &MacCtx->TxMsg.Message.Data );
+            }
+            TRACE_POINT_END( TRACE_POINT_SECURE_MESSAGE );
             if( LORAMAC_CRYPTO_SUCCESS != macCryptoStatus )
             {
                 return LORAMAC_STATUS_CRYPTO_ERROR;
             }
-            MacCtx.PktBufferLen = MacCtx.TxMsg.Message.Data.BufSize;
+            MacCtx->PktBufferLen = MacCtx->TxMsg.Message.Data.BufSize;
             break;
         case LORAMAC_MSG_TYPE_JOIN_ACCEPT:
         case LORAMAC_MSG_TYPE_UNDEF:
@@ -2599,15 +3297,40 @@ static LoRaMacStatus_t SecureFrame( uint8_t txDr, uint8_t txCh )
     return LORAMAC_STATUS_OK;
 }
 
+static LoRaMacStatus_t PrepareSecureFrame( void )
+{
+    LoRaMacCryptoStatus_t macCryptoStatus = LORAMAC_CRYPTO_ERROR;
+    uint32_t fCntUp = 0;
+
+    if( MacCtx->TxMsg.Type != LORAMAC_MSG_TYPE_DATA )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    if( LORAMAC_CRYPTO_SUCCESS != LoRaMacCryptoGetFCntUp( &fCntUp ) )
+    {
+        return LORAMAC_STATUS_FCNT_HANDLER_ERROR;
+    }
+
+    // The channel dependent MIC part is precomputed for the last used channel
+    macCryptoStatus = LoRaMacCryptoPrepareSecureMessage( fCntUp, MacCtx->NvmCtx->MacParams.ChannelsDatarate, MacCtx->Channel, &MacCtx->TxMsg.Message.Data, &MacCtx->TxPreparedMsg );
+    if( LORAMAC_CRYPTO_SUCCESS != macCryptoStatus )
+    {
+        return LORAMAC_STATUS_CRYPTO_ERROR;
+    }
+    MacCtx->PktBufferLen = MacCtx->TxMsg.Message.Data.BufSize;
+    return LORAMAC_STATUS_OK;
+}
+
 static void CalculateBackOff( void )
 {
     // Make sure that the calculation of the backoff time for the aggregated time off will only be done in
     // case the value is zero. It will be set to zero in the function RegionNextChannel.
-    if( MacCtx.NvmCtx->AggregatedTimeOff == 0 )
+    if( MacCtx->NvmCtx->AggregatedTimeOff == 0 )
     {
         // Update aggregated time-off. This must be an assignment and no incremental
         // update as we do only calculate the time-off based on the last transmission
-        MacCtx.NvmCtx->AggregatedTimeOff = ( MacCtx.TxTimeOnAir * MacCtx.NvmCtx->AggregatedDCycle - MacCtx.TxTimeOnAir );
+        MacCtx->NvmCtx->AggregatedTimeOff = ( MacCtx->TxTimeOnAir * MacCtx->NvmCtx->AggregatedDCycle - MacCtx->TxTimeOnAir );
     }
 }
 
@@ -2634,52 +3357,52 @@ static void RemoveMacCommands( LoRaMacRxSlot_t rxSlot, LoRaMacFrameCtrl_t fCtrl,
 
 static void ResetMacParameters( void )
 {
-    MacCtx.NvmCtx->NetworkActivation = ACTIVATION_TYPE_NONE;
+    MacCtx->NvmCtx->NetworkActivation = ACTIVATION_TYPE_NONE;
 
     // ADR counter
-    MacCtx.NvmCtx->AdrAckCounter = 0;
+    MacCtx->NvmCtx->AdrAckCounter = 0;
 
-    MacCtx.ChannelsNbTransCounter = 0;
-    MacCtx.AckTimeoutRetries = 1;
-    MacCtx.AckTimeoutRetriesCounter = 1;
-    MacCtx.AckTimeoutRetry = false;
+    MacCtx->ChannelsNbTransCounter = 0;
+    MacCtx->AckTimeoutRetries = 1;
+    MacCtx->AckTimeoutRetriesCounter = 1;
+    MacCtx->AckTimeoutRetry = false;
 
-    MacCtx.NvmCtx->MaxDCycle = 0;
-    MacCtx.NvmCtx->AggregatedDCycle = 1;
+    MacCtx->NvmCtx->MaxDCycle = 0;
+    MacCtx->NvmCtx->AggregatedDCycle = 1;
 
-    MacCtx.NvmCtx->MacParams.ChannelsTxPower = MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower;
-    MacCtx.NvmCtx->MacParams.ChannelsDatarate = MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate;
-    MacCtx.NvmCtx->MacParams.Rx1DrOffset = MacCtx.NvmCtx->MacParamsDefaults.Rx1DrOffset;
-    MacCtx.NvmCtx->MacParams.Rx2Channel = MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel;
-    MacCtx.NvmCtx->MacParams.RxCChannel = MacCtx.NvmCtx->MacParamsDefaults.RxCChannel;
-    MacCtx.NvmCtx->MacParams.UplinkDwellTime = MacCtx.NvmCtx->MacParamsDefaults.UplinkDwellTime;
-    MacCtx.NvmCtx->MacParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParamsDefaults.DownlinkDwellTime;
-    MacCtx.NvmCtx->MacParams.MaxEirp = MacCtx.NvmCtx->MacParamsDefaults.MaxEirp;
-    MacCtx.NvmCtx->MacParams.AntennaGain = MacCtx.NvmCtx->MacParamsDefaults.AntennaGain;
+    MacCtx->NvmCtx->MacParams.ChannelsTxPower = MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower;
+    MacCtx->NvmCtx->MacParams.ChannelsDatarate = MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate;
+    MacCtx->NvmCtx->MacParams.Rx1DrOffset = MacCtx->NvmCtx->MacParamsDefaults.Rx1DrOffset;
+    MacCtx->NvmCtx->MacParams.Rx2Channel = MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel;
+    MacCtx->NvmCtx->MacParams.RxCChannel = MacCtx->NvmCtx->MacParamsDefaults.RxCChannel;
+    MacCtx->NvmCtx->MacParams.UplinkDwellTime = MacCtx->NvmCtx->MacParamsDefaults.UplinkDwellTime;
+    MacCtx->NvmCtx->MacParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParamsDefaults.DownlinkDwellTime;
+    MacCtx->NvmCtx->MacParams.MaxEirp = MacCtx->NvmCtx->MacParamsDefaults.MaxEirp;
+    MacCtx->NvmCtx->MacParams.AntennaGain = MacCtx->NvmCtx->MacParamsDefaults.AntennaGain;
 
-    MacCtx.NodeAckRequested = false;
-    MacCtx.NvmCtx->SrvAckRequested = false;
+    MacCtx->NodeAckRequested = false;
+    MacCtx->NvmCtx->SrvAckRequested = false;
 
     // Reset to application defaults
     InitDefaultsParams_t params;
     params.Type = INIT_TYPE_RESET_TO_DEFAULT_CHANNELS;
     params.NvmCtx = NULL;
-    RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+    RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
     // Initialize channel index.
-    MacCtx.Channel = 0;
+    MacCtx->Channel = 0;
 
     // Initialize Rx2 config parameters.
-    MacCtx.RxWindow2Config.Channel = MacCtx.Channel;
-    MacCtx.RxWindow2Config.Frequency = MacCtx.NvmCtx->MacParams.Rx2Channel.Frequency;
-    MacCtx.RxWindow2Config.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindow2Config.RxContinuous = false;
-    MacCtx.RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
+    MacCtx->RxWindow2Config.Channel = MacCtx->Channel;
+    MacCtx->RxWindow2Config.Frequency = MacCtx->NvmCtx->MacParams.Rx2Channel.Frequency;
+    MacCtx->RxWindow2Config.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindow2Config.RxContinuous = false;
+    MacCtx->RxWindow2Config.RxSlot = RX_SLOT_WIN_2;
 
     // Initialize RxC config parameters.
-    MacCtx.RxWindowCConfig = MacCtx.RxWindow2Config;
-    MacCtx.RxWindowCConfig.RxContinuous = true;
-    MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+    MacCtx->RxWindowCConfig = MacCtx->RxWindow2Config;
+    MacCtx->RxWindowCConfig.RxContinuous = true;
+    MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
 
 }
 
@@ -2695,40 +3418,156 @@ static void RxWindowSetup( TimerEvent_t* rxTimer, RxConfigParams_t* rxConfig )
 
     // Ensure the radio is Idle
     Radio.Standby( );
+    RadioInstance = Instance;
 
-    if( RegionRxConfig( MacCtx.NvmCtx->Region, rxConfig, ( int8_t* )&MacCtx.McpsIndication.RxDatarate ) == true )
+    UpdateRxFilter( );
+    if( RegionRxConfig( MacCtx->NvmCtx->Region, rxConfig, ( int8_t* )&MacCtx->McpsIndication.RxDatarate ) == true )
     {
-        Radio.Rx( MacCtx.NvmCtx->MacParams.MaxRxWindow );
-        MacCtx.RxSlot = rxConfig->RxSlot;
+        Radio.Rx( MacCtx->NvmCtx->MacParams.MaxRxWindow );
+        MacCtx->RxSlot = rxConfig->RxSlot;
+    }
+}
+
+static void UpdateRxFilter( void )
+{
+    RadioRxFilter_t filter;
+
+    if( Radio.SetRxFilter == NULL )
+    {
+        return;
+    }
+    if( Instance != RadioInstance )
+    {
+        // The radio filters for the instance driving it. The filter of this
+        // instance is installed when it opens its next reception window.
+        return;
+    }
+    if( MacCtx->RxFilterEnabled == false )
+    {
+        Radio.SetRxFilter( NULL );
+        return;
+    }
+
+    // Downlinks only. Data frames must be sent to the device address or to an
+    // enabled multicast address. MinSize only applies to the data frames, the
+    // join accepts and proprietary frames of any size are passed.
+    filter.MTypeMask = ( 1 << FRAME_TYPE_JOIN_ACCEPT ) | ( 1 << FRAME_TYPE_DATA_UNCONFIRMED_DOWN ) |
+                       ( 1 << FRAME_TYPE_DATA_CONFIRMED_DOWN ) | ( 1 << FRAME_TYPE_PROPRIETARY );
+    filter.AddressMTypeMask = ( 1 << FRAME_TYPE_DATA_UNCONFIRMED_DOWN ) | ( 1 << FRAME_TYPE_DATA_CONFIRMED_DOWN );
+    filter.MinSize = LORAMAC_FRAME_PAYLOAD_MIN_SIZE;
+    filter.NbAddresses = 0;
+    filter.Addresses[filter.NbAddresses++] = MacCtx->NvmCtx->DevAddr;
+    for( uint8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
+    {
+        if( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true )
+        {
+            filter.Addresses[filter.NbAddresses++] = MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address;
+        }
+    }
+    Radio.SetRxFilter( &filter );
+}
+
+static bool GetRxCDutyCycle( uint32_t* rxTime, uint32_t* sleepTime )
+{
+    uint32_t preambleTime = 0;
+    uint32_t wakeupTime = 0;
+
+    if( ( MacCtx->RxCDutyCycle.Enabled == false ) || ( MacCtx->RxCForceContinuous == true ) ||
+        ( Radio.SetRxDutyCycle == NULL ) || ( MacCtx->RxWindowCConfig.RxSlot != RX_SLOT_WIN_CLASS_C ) )
+    {
+        return false;
+    }
+    for( int8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
+    {
+        if( MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.IsEnabled == true )
+        {
+            // Multicast sessions keep the continuous reception
+            return false;
+        }
+    }
+
+    // The radio detects a preamble when a reception window sees at least
+    // MinRxSymbols of it. A window may end just before that, the next one must
+    // then start at least MinRxSymbols before the end of the preamble.
+    preambleTime = MacCtx->RxCDutyCycle.PreambleLength * MacCtx->RxWindowCConfig.SymbolTime;
+    *rxTime = MacCtx->NvmCtx->MacParams.MinRxSymbols * MacCtx->RxWindowCConfig.SymbolTime;
+    wakeupTime = Radio.GetWakeupTime( ) * 1000;
+    if( preambleTime <= ( ( 2 * *rxTime ) + wakeupTime ) )
+    {
+        return false;
+    }
+    *sleepTime = preambleTime - ( 2 * *rxTime ) - wakeupTime;
+    return true;
+}
+
+static void RestartRxCWindow( void )
+{
+    if( ( MacCtx->NvmCtx->DeviceClass != CLASS_C ) || ( MacCtx->NvmCtx->NetworkActivation == ACTIVATION_TYPE_NONE ) ||
+        ( Instance != RadioInstance ) )
+    {
+        return;
+    }
+    if( ( MacCtx->RxSlot == RX_SLOT_WIN_CLASS_C ) || ( MacCtx->RxSlot == RX_SLOT_WIN_CLASS_C_MULTICAST ) )
+    {
+        // Restart the reception in the new mode
+        Radio.Sleep( );
+        OpenContinuousRxCWindow( );
     }
 }
 
 static void OpenContinuousRxCWindow( void )
 {
+    uint32_t rxTime = 0;
+    uint32_t sleepTime = 0;
+
+    RadioInstance = Instance;
+
     // Compute RxC windows parameters
-    RegionComputeRxWindowParameters( MacCtx.NvmCtx->Region,
-                                     MacCtx.NvmCtx->MacParams.RxCChannel.Datarate,
-                                     MacCtx.NvmCtx->MacParams.MinRxSymbols,
-                                     MacCtx.NvmCtx->MacParams.SystemMaxRxError,
-                                     &MacCtx.RxWindowCConfig );
+    RegionComputeRxWindowParameters( MacCtx->NvmCtx->Region,
+                                     MacCtx->NvmCtx->MacParams.RxCChannel.Datarate,
+                                     MacCtx->NvmCtx->MacParams.MinRxSymbols,
+                                     MacCtx->NvmCtx->MacParams.SystemMaxRxError,
+                                     &MacCtx->RxWindowCConfig );
 
-    MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+    MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
     // Setup continuous listening
-    MacCtx.RxWindowCConfig.RxContinuous = true;
+    MacCtx->RxWindowCConfig.RxContinuous = true;
+
+    UpdateRxFilter( );
 
     // At this point the Radio should be idle.
     // Thus, there is no need to set the radio in standby mode.
-    if( RegionRxConfig( MacCtx.NvmCtx->Region, &MacCtx.RxWindowCConfig, ( int8_t* )&MacCtx.McpsIndication.RxDatarate ) == true )
+    if( GetRxCDutyCycle( &rxTime, &sleepTime ) == true )
+    {
+        if( ( MacCtx->IsRxCDutyCycleRunning == true ) && ( Radio.GetStatus( ) == RF_RX_RUNNING ) )
+        {
+            // Restarting the duty cycle would drop a frame whose preamble
+            // was already detected
+            MacCtx->RxSlot = MacCtx->RxWindowCConfig.RxSlot;
+            return;
+        }
+        if( RegionRxConfig( MacCtx->NvmCtx->Region, &MacCtx->RxWindowCConfig, ( int8_t* )&MacCtx->McpsIndication.RxDatarate ) == true )
+        {
+            Radio.SetRxDutyCycle( rxTime, sleepTime );
+            MacCtx->IsRxCDutyCycleRunning = true;
+            MacCtx->RxSlot = MacCtx->RxWindowCConfig.RxSlot;
+        }
+        return;
+    }
+
+    MacCtx->IsRxCDutyCycleRunning = false;
+    if( RegionRxConfig( MacCtx->NvmCtx->Region, &MacCtx->RxWindowCConfig, ( int8_t* )&MacCtx->McpsIndication.RxDatarate ) == true )
     {
         Radio.Rx( 0 ); // Continuous mode
-        MacCtx.RxSlot = MacCtx.RxWindowCConfig.RxSlot;
+        MacCtx->RxSlot = MacCtx->RxWindowCConfig.RxSlot;
     }
 }
 
 LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl, uint8_t fPort, void* fBuffer, uint16_t fBufferSize )
 {
-    MacCtx.PktBufferLen = 0;
-    MacCtx.NodeAckRequested = false;
+    MacCtx->PktBufferLen = 0;
+    MacCtx->NodeAckRequested = false;
+    MacCtx->TxPreparedMsg.IsValid = false;
     uint32_t fCntUp = 0;
     size_t macCmdsSize = 0;
     uint8_t availableSize = 0;
@@ -2738,36 +3577,36 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
         fBufferSize = 0;
     }
 
-    memcpy1( MacCtx.AppData, ( uint8_t* ) fBuffer, fBufferSize );
-    MacCtx.AppDataSize = fBufferSize;
-    MacCtx.PktBuffer[0] = macHdr->Value;
+    memcpy1( MacCtx->AppData, ( uint8_t* ) fBuffer, fBufferSize );
+    MacCtx->AppDataSize = fBufferSize;
+    MacCtx->PktBuffer[0] = macHdr->Value;
 
     switch( macHdr->Bits.MType )
     {
         case FRAME_TYPE_DATA_CONFIRMED_UP:
-            MacCtx.NodeAckRequested = true;
+            MacCtx->NodeAckRequested = true;
             // Intentional fall through
         case FRAME_TYPE_DATA_UNCONFIRMED_UP:
-            MacCtx.TxMsg.Type = LORAMAC_MSG_TYPE_DATA;
-            MacCtx.TxMsg.Message.Data.Buffer = MacCtx.PktBuffer;
-            MacCtx.TxMsg.Message.Data.BufSize = LORAMAC_PHY_MAXPAYLOAD;
-            MacCtx.TxMsg.Message.Data.MHDR.Value = macHdr->Value;
-            MacCtx.TxMsg.Message.Data.FPort = fPort;
-            MacCtx.TxMsg.Message.Data.FHDR.DevAddr = MacCtx.NvmCtx->DevAddr;
-            MacCtx.TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
-            MacCtx.TxMsg.Message.Data.FRMPayloadSize = MacCtx.AppDataSize;
-            MacCtx.TxMsg.Message.Data.FRMPayload = MacCtx.AppData;
+            MacCtx->TxMsg.Type = LORAMAC_MSG_TYPE_DATA;
+            MacCtx->TxMsg.Message.Data.Buffer = MacCtx->PktBuffer;
+            MacCtx->TxMsg.Message.Data.BufSize = LORAMAC_PHY_MAXPAYLOAD;
+            MacCtx->TxMsg.Message.Data.MHDR.Value = macHdr->Value;
+            MacCtx->TxMsg.Message.Data.FPort = fPort;
+            MacCtx->TxMsg.Message.Data.FHDR.DevAddr = MacCtx->NvmCtx->DevAddr;
+            MacCtx->TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
+            MacCtx->TxMsg.Message.Data.FRMPayloadSize = MacCtx->AppDataSize;
+            MacCtx->TxMsg.Message.Data.FRMPayload = MacCtx->AppData;
 
             if( LORAMAC_CRYPTO_SUCCESS != LoRaMacCryptoGetFCntUp( &fCntUp ) )
             {
                 return LORAMAC_STATUS_FCNT_HANDLER_ERROR;
             }
-            MacCtx.TxMsg.Message.Data.FHDR.FCnt = ( uint16_t )fCntUp;
+            MacCtx->TxMsg.Message.Data.FHDR.FCnt = ( uint16_t )fCntUp;
 
             // Reset confirm parameters
-            MacCtx.McpsConfirm.NbRetries = 0;
-            MacCtx.McpsConfirm.AckReceived = false;
-            MacCtx.McpsConfirm.UpLinkCounter = fCntUp;
+            MacCtx->McpsConfirm.NbRetries = 0;
+            MacCtx->McpsConfirm.AckReceived = false;
+            MacCtx->McpsConfirm.UpLinkCounter = fCntUp;
 
             // Handle the MAC commands if there are any available
             if( LoRaMacCommandsGetSizeSerializedCmds( &macCmdsSize ) != LORAMAC_COMMANDS_SUCCESS )
@@ -2777,24 +3616,24 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
 
             if( macCmdsSize > 0 )
             {
-                availableSize = GetMaxAppPayloadWithoutFOptsLength( MacCtx.NvmCtx->MacParams.ChannelsDatarate );
+                availableSize = GetMaxAppPayloadWithoutFOptsLength( MacCtx->NvmCtx->MacParams.ChannelsDatarate );
 
                 // There is application payload available and the MAC commands fit into FOpts field.
-                if( ( MacCtx.AppDataSize > 0 ) && ( macCmdsSize <= LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
+                if( ( MacCtx->AppDataSize > 0 ) && ( macCmdsSize <= LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
                 {
-                    if( LoRaMacCommandsSerializeCmds( LORA_MAC_COMMAND_MAX_FOPTS_LENGTH, &macCmdsSize, MacCtx.TxMsg.Message.Data.FHDR.FOpts ) != LORAMAC_COMMANDS_SUCCESS )
+                    if( LoRaMacCommandsSerializeCmds( LORA_MAC_COMMAND_MAX_FOPTS_LENGTH, &macCmdsSize, MacCtx->TxMsg.Message.Data.FHDR.FOpts ) != LORAMAC_COMMANDS_SUCCESS )
                     {
                         return LORAMAC_STATUS_MAC_COMMAD_ERROR;
                     }
                     fCtrl->Bits.FOptsLen = macCmdsSize;
                     // Update FCtrl field with new value of FOptionsLength
-                    MacCtx.TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
+                    MacCtx->TxMsg.Message.Data.FHDR.FCtrl.Value = fCtrl->Value;
                 }
                 // There is application payload available but the MAC commands does NOT fit into FOpts field.
-                else if( ( MacCtx.AppDataSize > 0 ) && ( macCmdsSize > LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
+                else if( ( MacCtx->AppDataSize > 0 ) && ( macCmdsSize > LORA_MAC_COMMAND_MAX_FOPTS_LENGTH ) )
                 {
 
-                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx.NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
+                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx->NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
                     {
                         return LORAMAC_STATUS_MAC_COMMAD_ERROR;
                     }
@@ -2803,24 +3642,24 @@ LoRaMacStatus_t PrepareFrame( LoRaMacHeader_t* macHdr, LoRaMacFrameCtrl_t* fCtrl
                 // No application payload available therefore add all mac commands to the FRMPayload.
                 else
                 {
-                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx.NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
+                    if( LoRaMacCommandsSerializeCmds( availableSize, &macCmdsSize, MacCtx->NvmCtx->MacCommandsBuffer ) != LORAMAC_COMMANDS_SUCCESS )
                     {
                         return LORAMAC_STATUS_MAC_COMMAD_ERROR;
                     }
                     // Force FPort to be zero
-                    MacCtx.TxMsg.Message.Data.FPort = 0;
+                    MacCtx->TxMsg.Message.Data.FPort = 0;
 
-                    MacCtx.TxMsg.Message.Data.FRMPayload = MacCtx.NvmCtx->MacCommandsBuffer;
-                    MacCtx.TxMsg.Message.Data.FRMPayloadSize = macCmdsSize;
+                    MacCtx->TxMsg.Message.Data.FRMPayload = MacCtx->NvmCtx->MacCommandsBuffer;
+                    MacCtx->TxMsg.Message.Data.FRMPayloadSize = macCmdsSize;
                 }
             }
 
             break;
         case FRAME_TYPE_PROPRIETARY:
-            if( ( fBuffer != NULL ) && ( MacCtx.AppDataSize > 0 ) )
+            if( ( fBuffer != NULL ) && ( MacCtx->AppDataSize > 0 ) )
             {
-                memcpy1( MacCtx.PktBuffer + LORAMAC_MHDR_FIELD_SIZE, ( uint8_t* ) fBuffer, MacCtx.AppDataSize );
-                MacCtx.PktBufferLen = LORAMAC_MHDR_FIELD_SIZE + MacCtx.AppDataSize;
+                memcpy1( MacCtx->PktBuffer + LORAMAC_MHDR_FIELD_SIZE, ( uint8_t* ) fBuffer, MacCtx->AppDataSize );
+                MacCtx->PktBufferLen = LORAMAC_MHDR_FIELD_SIZE + MacCtx->AppDataSize;
             }
             break;
         default:
@@ -2837,28 +3676,28 @@ LoRaMacStatus_t SendFrameOnChannel( uint8_t channel )
     int8_t txPower = 0;
 
     txConfig.Channel = channel;
-    txConfig.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    txConfig.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    txConfig.MaxEirp = MacCtx.NvmCtx->MacParams.MaxEirp;
-    txConfig.AntennaGain = MacCtx.NvmCtx->MacParams.AntennaGain;
-    txConfig.PktLen = MacCtx.PktBufferLen;
+    txConfig.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    txConfig.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    txConfig.MaxEirp = MacCtx->NvmCtx->MacParams.MaxEirp;
+    txConfig.AntennaGain = MacCtx->NvmCtx->MacParams.AntennaGain;
+    txConfig.PktLen = MacCtx->PktBufferLen;
 
-    RegionTxConfig( MacCtx.NvmCtx->Region, &txConfig, &txPower, &MacCtx.TxTimeOnAir );
+    RegionTxConfig( MacCtx->NvmCtx->Region, &txConfig, &txPower, &MacCtx->TxTimeOnAir );
 
-    MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
-    MacCtx.McpsConfirm.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    MacCtx.McpsConfirm.TxPower = txPower;
-    MacCtx.McpsConfirm.Channel = channel;
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    MacCtx->McpsConfirm.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    MacCtx->McpsConfirm.TxPower = txPower;
+    MacCtx->McpsConfirm.Channel = channel;
 
     // Store the time on air
-    MacCtx.McpsConfirm.TxTimeOnAir = MacCtx.TxTimeOnAir;
-    MacCtx.MlmeConfirm.TxTimeOnAir = MacCtx.TxTimeOnAir;
+    MacCtx->McpsConfirm.TxTimeOnAir = MacCtx->TxTimeOnAir;
+    MacCtx->MlmeConfirm.TxTimeOnAir = MacCtx->TxTimeOnAir;
 
     if( LoRaMacClassBIsBeaconModeActive( ) == true )
     {
         // Currently, the Time-On-Air can only be computed when the radio is configured with
         // the TX configuration
-        TimerTime_t collisionTime = LoRaMacClassBIsUplinkCollision( MacCtx.TxTimeOnAir );
+        TimerTime_t collisionTime = LoRaMacClassBIsUplinkCollision( MacCtx->TxTimeOnAir );
 
         if( collisionTime > 0 )
         {
@@ -2866,7 +3705,7 @@ LoRaMacStatus_t SendFrameOnChannel( uint8_t channel )
         }
     }
 
-    if( MacCtx.NvmCtx->DeviceClass == CLASS_B )
+    if( MacCtx->NvmCtx->DeviceClass == CLASS_B )
     {
         // Stop slots for class b
         LoRaMacClassBStopRxSlots( );
@@ -2875,20 +3714,28 @@ LoRaMacStatus_t SendFrameOnChannel( uint8_t channel )
     LoRaMacClassBHaltBeaconing( );
 
     // Secure frame
-    status = SecureFrame( MacCtx.NvmCtx->MacParams.ChannelsDatarate, MacCtx.Channel );
+    TRACE_POINT_BEGIN( TRACE_POINT_SECURE_FRAME );
+    status = SecureFrame( MacCtx->NvmCtx->MacParams.ChannelsDatarate, MacCtx->Channel );
+    TRACE_POINT_END( TRACE_POINT_SECURE_FRAME );
     if( status != LORAMAC_STATUS_OK )
     {
         return status;
     }
 
-    MacCtx.MacState |= LORAMAC_TX_RUNNING;
-    if( MacCtx.NodeAckRequested == false )
+    MacCtx->MacState |= LORAMAC_TX_RUNNING;
+    if( MacCtx->NodeAckRequested == false )
+    {
+        MacCtx->ChannelsNbTransCounter++;
+    }
+    if( MacCtx->UplinksSinceReseed < UINT16_MAX )
     {
-        MacCtx.ChannelsNbTransCounter++;
+        MacCtx->UplinksSinceReseed++;
     }
 
     // Send now
-    Radio.Send( MacCtx.PktBuffer, MacCtx.PktBufferLen );
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_SEND, ( ( uint8_t[] ){ channel, MacCtx->NvmCtx->MacParams.ChannelsDatarate, txPower } ), 3,
+                      MacCtx->PktBuffer, MacCtx->PktBufferLen );
+    Radio.Send( MacCtx->PktBuffer, MacCtx->PktBufferLen );
 
     return LORAMAC_STATUS_OK;
 }
@@ -2897,36 +3744,38 @@ LoRaMacStatus_t SetTxContinuousWave( uint16_t timeout )
 {
     ContinuousWaveParams_t continuousWave;
 
-    continuousWave.Channel = MacCtx.Channel;
-    continuousWave.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    continuousWave.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    continuousWave.MaxEirp = MacCtx.NvmCtx->MacParams.MaxEirp;
-    continuousWave.AntennaGain = MacCtx.NvmCtx->MacParams.AntennaGain;
+    continuousWave.Channel = MacCtx->Channel;
+    continuousWave.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    continuousWave.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    continuousWave.MaxEirp = MacCtx->NvmCtx->MacParams.MaxEirp;
+    continuousWave.AntennaGain = MacCtx->NvmCtx->MacParams.AntennaGain;
     continuousWave.Timeout = timeout;
 
-    RegionSetContinuousWave( MacCtx.NvmCtx->Region, &continuousWave );
+    RadioInstance = Instance;
+    RegionSetContinuousWave( MacCtx->NvmCtx->Region, &continuousWave );
 
-    MacCtx.MacState |= LORAMAC_TX_RUNNING;
+    MacCtx->MacState |= LORAMAC_TX_RUNNING;
 
     return LORAMAC_STATUS_OK;
 }
 
 LoRaMacStatus_t SetTxContinuousWave1( uint16_t timeout, uint32_t frequency, uint8_t power )
 {
+    RadioInstance = Instance;
     Radio.SetTxContinuousWave( frequency, power, timeout );
 
-    MacCtx.MacState |= LORAMAC_TX_RUNNING;
+    MacCtx->MacState |= LORAMAC_TX_RUNNING;
 
     return LORAMAC_STATUS_OK;
 }
 
 LoRaMacCtxs_t* GetCtxs( void )
 {
-    Contexts.MacNvmCtx = &NvmMacCtx;
-    Contexts.MacNvmCtxSize = sizeof( NvmMacCtx );
+    Contexts.MacNvmCtx = &Instance->NvmMacCtx;
+    Contexts.MacNvmCtxSize = sizeof( LoRaMacNvmCtx_t );
     Contexts.CryptoNvmCtx = LoRaMacCryptoGetNvmCtx( &Contexts.CryptoNvmCtxSize );
     GetNvmCtxParams_t params ={ 0 };
-    Contexts.RegionNvmCtx = RegionGetNvmCtx( MacCtx.NvmCtx->Region, &params );
+    Contexts.RegionNvmCtx = RegionGetNvmCtx( MacCtx->NvmCtx->Region, &params );
     Contexts.RegionNvmCtxSize = params.nvmCtxSize;
     Contexts.SecureElementNvmCtx = SecureElementGetNvmCtx( &Contexts.SecureElementNvmCtxSize );
     Contexts.CommandsNvmCtx = LoRaMacCommandsGetNvmCtx( &Contexts.CommandsNvmCtxSize );
@@ -2941,27 +3790,27 @@ LoRaMacStatus_t RestoreCtxs( LoRaMacCtxs_t* contexts )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
-    if( MacCtx.MacState != LORAMAC_STOPPED )
+    if( MacCtx->MacState != LORAMAC_STOPPED )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
     if( contexts->MacNvmCtx != NULL )
     {
-        memcpy1( ( uint8_t* ) &NvmMacCtx, ( uint8_t* ) contexts->MacNvmCtx, contexts->MacNvmCtxSize );
+        memcpy1( ( uint8_t* ) &Instance->NvmMacCtx, ( uint8_t* ) contexts->MacNvmCtx, contexts->MacNvmCtxSize );
     }
 
     InitDefaultsParams_t params;
     params.Type = INIT_TYPE_RESTORE_CTX;
     params.NvmCtx = contexts->RegionNvmCtx;
-    RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+    RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
     // Initialize RxC config parameters.
-    MacCtx.RxWindowCConfig.Channel = MacCtx.Channel;
-    MacCtx.RxWindowCConfig.Frequency = MacCtx.NvmCtx->MacParams.RxCChannel.Frequency;
-    MacCtx.RxWindowCConfig.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
-    MacCtx.RxWindowCConfig.RxContinuous = true;
-    MacCtx.RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
+    MacCtx->RxWindowCConfig.Channel = MacCtx->Channel;
+    MacCtx->RxWindowCConfig.Frequency = MacCtx->NvmCtx->MacParams.RxCChannel.Frequency;
+    MacCtx->RxWindowCConfig.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
+    MacCtx->RxWindowCConfig.RxContinuous = true;
+    MacCtx->RxWindowCConfig.RxSlot = RX_SLOT_WIN_CLASS_C;
 
     if( SecureElementRestoreNvmCtx( contexts->SecureElementNvmCtx ) != SECURE_ELEMENT_SUCCESS )
     {
@@ -3046,21 +3895,21 @@ LoRaMacStatus_t DetermineFrameType( LoRaMacMessageData_t* macMsg, FType_t* fType
 static bool CheckRetransUnconfirmedUplink( void )
 {
     // Unconfirmed uplink, when all retransmissions are done.
-    if( MacCtx.ChannelsNbTransCounter >=
-        MacCtx.NvmCtx->MacParams.ChannelsNbTrans )
+    if( MacCtx->ChannelsNbTransCounter >=
+        MacCtx->NvmCtx->MacParams.ChannelsNbTrans )
     {
         return true;
     }
-    else if( MacCtx.MacFlags.Bits.McpsInd == 1 )
+    else if( MacCtx->MacFlags.Bits.McpsInd == 1 )
     {
         // For Class A stop in each case
-        if( MacCtx.NvmCtx->DeviceClass == CLASS_A )
+        if( MacCtx->NvmCtx->DeviceClass == CLASS_A )
         {
             return true;
         }
         else
         {// For Class B & C stop only if the frame was received in RX1 window
-            if( MacCtx.McpsIndication.RxSlot == RX_SLOT_WIN_1 )
+            if( MacCtx->McpsIndication.RxSlot == RX_SLOT_WIN_1 )
             {
                 return true;
             }
@@ -3072,14 +3921,14 @@ static bool CheckRetransUnconfirmedUplink( void )
 static bool CheckRetransConfirmedUplink( void )
 {
     // Confirmed uplink, when all retransmissions ( tries to get a ack ) are done.
-    if( MacCtx.AckTimeoutRetriesCounter >=
-        MacCtx.AckTimeoutRetries )
+    if( MacCtx->AckTimeoutRetriesCounter >=
+        MacCtx->AckTimeoutRetries )
     {
         return true;
     }
-    else if( MacCtx.MacFlags.Bits.McpsInd == 1 )
+    else if( MacCtx->MacFlags.Bits.McpsInd == 1 )
     {
-        if( MacCtx.McpsConfirm.AckReceived == true )
+        if( MacCtx->McpsConfirm.AckReceived == true )
         {
             return true;
         }
@@ -3089,64 +3938,64 @@ static bool CheckRetransConfirmedUplink( void )
 
 static bool StopRetransmission( void )
 {
-    if( ( MacCtx.MacFlags.Bits.McpsInd == 0 ) ||
-        ( ( MacCtx.McpsIndication.RxSlot != RX_SLOT_WIN_1 ) &&
-          ( MacCtx.McpsIndication.RxSlot != RX_SLOT_WIN_2 ) ) )
+    if( ( MacCtx->MacFlags.Bits.McpsInd == 0 ) ||
+        ( ( MacCtx->McpsIndication.RxSlot != RX_SLOT_WIN_1 ) &&
+          ( MacCtx->McpsIndication.RxSlot != RX_SLOT_WIN_2 ) ) )
     {   // Maximum repetitions without downlink. Increase ADR Ack counter.
         // Only process the case when the MAC did not receive a downlink.
-        if( MacCtx.NvmCtx->AdrCtrlOn == true )
+        if( MacCtx->NvmCtx->AdrCtrlOn == true )
         {
-            MacCtx.NvmCtx->AdrAckCounter++;
+            MacCtx->NvmCtx->AdrAckCounter++;
         }
     }
 
-    MacCtx.ChannelsNbTransCounter = 0;
-    MacCtx.NodeAckRequested = false;
-    MacCtx.AckTimeoutRetry = false;
-    MacCtx.MacState &= ~LORAMAC_TX_RUNNING;
+    MacCtx->ChannelsNbTransCounter = 0;
+    MacCtx->NodeAckRequested = false;
+    MacCtx->AckTimeoutRetry = false;
+    MacCtx->MacState &= ~LORAMAC_TX_RUNNING;
 
     return true;
 }
 
 static void AckTimeoutRetriesProcess( void )
 {
-    if( MacCtx.AckTimeoutRetriesCounter < MacCtx.AckTimeoutRetries )
+    if( MacCtx->AckTimeoutRetriesCounter < MacCtx->AckTimeoutRetries )
     {
-        MacCtx.AckTimeoutRetriesCounter++;
-        if( ( MacCtx.AckTimeoutRetriesCounter % 2 ) == 1 )
+        MacCtx->AckTimeoutRetriesCounter++;
+        if( ( MacCtx->AckTimeoutRetriesCounter % 2 ) == 1 )
         {
             GetPhyParams_t getPhy;
             PhyParam_t phyParam;
 
             getPhy.Attribute = PHY_NEXT_LOWER_TX_DR;
-            getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-            getPhy.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-            MacCtx.NvmCtx->MacParams.ChannelsDatarate = phyParam.Value;
+            getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+            getPhy.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+            MacCtx->NvmCtx->MacParams.ChannelsDatarate = phyParam.Value;
         }
     }
 }
 
 static void AckTimeoutRetriesFinalize( void )
 {
-    if( MacCtx.McpsConfirm.AckReceived == false )
+    if( MacCtx->McpsConfirm.AckReceived == false )
     {
         InitDefaultsParams_t params;
         params.Type = INIT_TYPE_ACTIVATE_DEFAULT_CHANNELS;
         params.NvmCtx = Contexts.RegionNvmCtx;
-        RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+        RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
-        MacCtx.NodeAckRequested = false;
-        MacCtx.McpsConfirm.AckReceived = false;
+        MacCtx->NodeAckRequested = false;
+        MacCtx->McpsConfirm.AckReceived = false;
     }
-    MacCtx.McpsConfirm.NbRetries = MacCtx.AckTimeoutRetriesCounter;
+    MacCtx->McpsConfirm.NbRetries = MacCtx->AckTimeoutRetriesCounter;
 }
 
 static void CallNvmCtxCallback( LoRaMacNvmCtxModule_t module )
 {
-    if( ( MacCtx.MacCallbacks != NULL ) && ( MacCtx.MacCallbacks->NvmContextChange != NULL ) )
+    if( ( MacCtx->MacCallbacks != NULL ) && ( MacCtx->MacCallbacks->NvmContextChange != NULL ) )
     {
-        MacCtx.MacCallbacks->NvmContextChange( module );
+        MacCtx->MacCallbacks->NvmContextChange( module );
     }
 }
 
@@ -3185,16 +4034,99 @@ static void EventConfirmQueueNvmCtxChanged( void )
     CallNvmCtxCallback( LORAMAC_NVMCTXMODULE_CONFIRM_QUEUE );
 }
 
-static uint8_t IsRequestPending( void )
+static uint8_t IsRequestPending( void )
+{
+    if( ( MacCtx->MacFlags.Bits.MlmeReq == 1 ) ||
+        ( MacCtx->MacFlags.Bits.McpsReq == 1 ) )
+    {
+        return 1;
+    }
+    return 0;
+}
+
+
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+/*!
+ * \brief Carves the contexts of the other MAC modules out of the storage of
+ *        the given instance.
+ *
+ * \param [IN] instance Instance owning the module contexts
+ *
+ * \param [IN] region LoRaWAN region of the instance
+ *
+ * \retval Returns false if the instance storage is too small.
+ */
+static bool AssignModuleCtxs( LoRaMacInstance_t* instance, LoRaMacRegion_t region )
+{
+    GetNvmCtxParams_t params = { 0 };
+    void** moduleCtxs[] =
+    {
+        &instance->ModuleCtxs.RegionNvmCtx, &instance->ModuleCtxs.CryptoNvmCtx, &instance->ModuleCtxs.SecureElementNvmCtx,
+        &instance->ModuleCtxs.CommandsNvmCtx, &instance->ModuleCtxs.ClassBCtx, &instance->ModuleCtxs.ClassBNvmCtx,
+        &instance->ModuleCtxs.ConfirmQueueCtx, &instance->ModuleCtxs.ConfirmQueueNvmCtx
+    };
+    size_t moduleCtxSizes[sizeof( moduleCtxs ) / sizeof( moduleCtxs[0] )];
+    size_t offset = 0;
+
+    RegionGetNvmCtx( region, &params );
+    moduleCtxSizes[0] = params.nvmCtxSize;
+    LoRaMacCryptoGetNvmCtx( &moduleCtxSizes[1] );
+    SecureElementGetNvmCtx( &moduleCtxSizes[2] );
+    LoRaMacCommandsGetNvmCtx( &moduleCtxSizes[3] );
+    LoRaMacClassBGetCtx( &moduleCtxSizes[4] );
+    LoRaMacClassBGetNvmCtx( &moduleCtxSizes[5] );
+    LoRaMacConfirmQueueGetCtx( &moduleCtxSizes[6] );
+    LoRaMacConfirmQueueGetNvmCtx( &moduleCtxSizes[7] );
+
+    for( uint8_t i = 0; i < ( sizeof( moduleCtxs ) / sizeof( moduleCtxs[0] ) ); i++ )
+    {
+        *moduleCtxs[i] = NULL;
+        if( moduleCtxSizes[i] == 0 )
+        {
+            continue;
+        }
+        if( ( offset + moduleCtxSizes[i] ) > sizeof( instance->ModuleCtxsStorage ) )
+        {
+            return false;
+        }
+        *moduleCtxs[i] = ( uint8_t* )instance->ModuleCtxsStorage + offset;
+        // Keep the next context 8-byte aligned
+        offset += ( moduleCtxSizes[i] + 7 ) & ~( ( size_t )7 );
+    }
+    return true;
+}
+
+/*!
+ * \brief Binds the contexts of the given instance to the other MAC modules.
+ *        Only the module pointers change, nothing is copied.
+ *
+ * \param [IN] instance Instance owning the module contexts
+ *
+ * \param [IN] region LoRaWAN region of the instance
+ *
+ * \retval LoRaMacStatus_t Status of the operation. Nothing is bound on error.
+ */
+static LoRaMacStatus_t BindModuleCtxs( LoRaMacInstance_t* instance, LoRaMacRegion_t region )
 {
-    if( ( MacCtx.MacFlags.Bits.MlmeReq == 1 ) ||
-        ( MacCtx.MacFlags.Bits.McpsReq == 1 ) )
+    InitDefaultsParams_t params;
+
+    // A secure element storing the keys itself can't be bound
+    if( SecureElementBindNvmCtx( instance->ModuleCtxs.SecureElementNvmCtx ) != SECURE_ELEMENT_SUCCESS )
     {
-        return 1;
+        return LORAMAC_STATUS_CRYPTO_ERROR;
     }
-    return 0;
-}
 
+    params.Type = INIT_TYPE_BIND_CTX;
+    params.NvmCtx = instance->ModuleCtxs.RegionNvmCtx;
+    RegionInitDefaults( region, &params );
+
+    LoRaMacCryptoBindNvmCtx( instance->ModuleCtxs.CryptoNvmCtx );
+    LoRaMacCommandsBindNvmCtx( instance->ModuleCtxs.CommandsNvmCtx );
+    LoRaMacClassBBindCtxs( instance->ModuleCtxs.ClassBCtx, instance->ModuleCtxs.ClassBNvmCtx );
+    LoRaMacConfirmQueueBindCtxs( instance->ModuleCtxs.ConfirmQueueCtx, instance->ModuleCtxs.ConfirmQueueNvmCtx );
+    return LORAMAC_STATUS_OK;
+}
+#endif
 
 LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks, LoRaMacRegion_t region )
 {
@@ -3226,138 +4158,150 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     LoRaMacConfirmQueueInit( primitives, EventConfirmQueueNvmCtxChanged );
 
     // Initialize the module context with zeros
-    memset1( ( uint8_t* ) &NvmMacCtx, 0x00, sizeof( LoRaMacNvmCtx_t ) );
-    memset1( ( uint8_t* ) &MacCtx, 0x00, sizeof( LoRaMacCtx_t ) );
-    MacCtx.NvmCtx = &NvmMacCtx;
+    memset1( ( uint8_t* ) &Instance->NvmMacCtx, 0x00, sizeof( LoRaMacNvmCtx_t ) );
+    memset1( ( uint8_t* ) MacCtx, 0x00, sizeof( LoRaMacCtx_t ) );
+    MacCtx->NvmCtx = &Instance->NvmMacCtx;
 
     // Set non zero variables to its default value
-    MacCtx.AckTimeoutRetriesCounter = 1;
-    MacCtx.AckTimeoutRetries = 1;
-    MacCtx.NvmCtx->Region = region;
-    MacCtx.NvmCtx->DeviceClass = CLASS_A;
+    MacCtx->AckTimeoutRetriesCounter = 1;
+    MacCtx->AckTimeoutRetries = 1;
+    MacCtx->NvmCtx->Region = region;
+    MacCtx->NvmCtx->DeviceClass = CLASS_A;
+    MacCtx->RxFilterEnabled = true;
+    MacCtx->CarrierSenseMode = RADIO_CARRIER_SENSE_RSSI;
 
     // Setup version
-    MacCtx.NvmCtx->Version.Value = LORAMAC_VERSION;
+    MacCtx->NvmCtx->Version.Value = LORAMAC_VERSION;
 
     // Reset to defaults
     getPhy.Attribute = PHY_DUTY_CYCLE;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->DutyCycleOn = ( bool ) phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->DutyCycleOn = ( bool ) phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_TX_POWER;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_TX_DR;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate = phyParam.Value;
 
     getPhy.Attribute = PHY_MAX_RX_WINDOW;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.MaxRxWindow = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.MaxRxWindow = phyParam.Value;
 
     getPhy.Attribute = PHY_RECEIVE_DELAY1;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay1 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay1 = phyParam.Value;
 
     getPhy.Attribute = PHY_RECEIVE_DELAY2;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay2 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay2 = phyParam.Value;
 
     getPhy.Attribute = PHY_JOIN_ACCEPT_DELAY1;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay1 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay1 = phyParam.Value;
 
     getPhy.Attribute = PHY_JOIN_ACCEPT_DELAY2;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay2 = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay2 = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_DR1_OFFSET;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.Rx1DrOffset = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.Rx1DrOffset = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_RX2_FREQUENCY;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel.Frequency = phyParam.Value;
-    MacCtx.NvmCtx->MacParamsDefaults.RxCChannel.Frequency = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel.Frequency = phyParam.Value;
+    MacCtx->NvmCtx->MacParamsDefaults.RxCChannel.Frequency = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_RX2_DR;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel.Datarate = phyParam.Value;
-    MacCtx.NvmCtx->MacParamsDefaults.RxCChannel.Datarate = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel.Datarate = phyParam.Value;
+    MacCtx->NvmCtx->MacParamsDefaults.RxCChannel.Datarate = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_UPLINK_DWELL_TIME;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.UplinkDwellTime = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.UplinkDwellTime = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_DOWNLINK_DWELL_TIME;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.DownlinkDwellTime = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.DownlinkDwellTime = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_MAX_EIRP;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.MaxEirp = phyParam.fValue;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.MaxEirp = phyParam.fValue;
 
     getPhy.Attribute = PHY_DEF_ANTENNA_GAIN;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.NvmCtx->MacParamsDefaults.AntennaGain = phyParam.fValue;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->NvmCtx->MacParamsDefaults.AntennaGain = phyParam.fValue;
 
     getPhy.Attribute = PHY_DEF_ADR_ACK_LIMIT;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.AdrAckLimit = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->AdrAckLimit = phyParam.Value;
 
     getPhy.Attribute = PHY_DEF_ADR_ACK_DELAY;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
-    MacCtx.AdrAckDelay = phyParam.Value;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    MacCtx->AdrAckDelay = phyParam.Value;
 
     // Init parameters which are not set in function ResetMacParameters
-    MacCtx.NvmCtx->MacParamsDefaults.ChannelsNbTrans = 1;
-    MacCtx.NvmCtx->MacParamsDefaults.SystemMaxRxError = 10;
-    MacCtx.NvmCtx->MacParamsDefaults.MinRxSymbols = 6;
-
-    MacCtx.NvmCtx->MacParams.SystemMaxRxError = MacCtx.NvmCtx->MacParamsDefaults.SystemMaxRxError;
-    MacCtx.NvmCtx->MacParams.MinRxSymbols = MacCtx.NvmCtx->MacParamsDefaults.MinRxSymbols;
-    MacCtx.NvmCtx->MacParams.MaxRxWindow = MacCtx.NvmCtx->MacParamsDefaults.MaxRxWindow;
-    MacCtx.NvmCtx->MacParams.ReceiveDelay1 = MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay1;
-    MacCtx.NvmCtx->MacParams.ReceiveDelay2 = MacCtx.NvmCtx->MacParamsDefaults.ReceiveDelay2;
-    MacCtx.NvmCtx->MacParams.JoinAcceptDelay1 = MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay1;
-    MacCtx.NvmCtx->MacParams.JoinAcceptDelay2 = MacCtx.NvmCtx->MacParamsDefaults.JoinAcceptDelay2;
-    MacCtx.NvmCtx->MacParams.ChannelsNbTrans = MacCtx.NvmCtx->MacParamsDefaults.ChannelsNbTrans;
+    MacCtx->NvmCtx->MacParamsDefaults.ChannelsNbTrans = 1;
+    MacCtx->NvmCtx->MacParamsDefaults.SystemMaxRxError = 10;
+    MacCtx->NvmCtx->MacParamsDefaults.MinRxSymbols = 6;
+
+    MacCtx->NvmCtx->MacParams.SystemMaxRxError = MacCtx->NvmCtx->MacParamsDefaults.SystemMaxRxError;
+    MacCtx->NvmCtx->MacParams.MinRxSymbols = MacCtx->NvmCtx->MacParamsDefaults.MinRxSymbols;
+    MacCtx->NvmCtx->MacParams.MaxRxWindow = MacCtx->NvmCtx->MacParamsDefaults.MaxRxWindow;
+    MacCtx->NvmCtx->MacParams.ReceiveDelay1 = MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay1;
+    MacCtx->NvmCtx->MacParams.ReceiveDelay2 = MacCtx->NvmCtx->MacParamsDefaults.ReceiveDelay2;
+    MacCtx->NvmCtx->MacParams.JoinAcceptDelay1 = MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay1;
+    MacCtx->NvmCtx->MacParams.JoinAcceptDelay2 = MacCtx->NvmCtx->MacParamsDefaults.JoinAcceptDelay2;
+    MacCtx->NvmCtx->MacParams.ChannelsNbTrans = MacCtx->NvmCtx->MacParamsDefaults.ChannelsNbTrans;
 
     InitDefaultsParams_t params;
     params.Type = INIT_TYPE_DEFAULTS;
     params.NvmCtx = NULL;
-    RegionInitDefaults( MacCtx.NvmCtx->Region, &params );
+    RegionInitDefaults( MacCtx->NvmCtx->Region, &params );
 
     ResetMacParameters( );
 
-    MacCtx.NvmCtx->PublicNetwork = true;
+    MacCtx->NvmCtx->PublicNetwork = true;
 
-    MacCtx.MacPrimitives = primitives;
-    MacCtx.MacCallbacks = callbacks;
-    MacCtx.MacFlags.Value = 0;
-    MacCtx.MacState = LORAMAC_STOPPED;
+    MacCtx->MacPrimitives = primitives;
+    MacCtx->MacCallbacks = callbacks;
+    MacCtx->MacFlags.Value = 0;
+    MacCtx->MacState = LORAMAC_STOPPED;
 
     // Reset duty cycle times
-    MacCtx.NvmCtx->LastTxDoneTime = 0;
-    MacCtx.NvmCtx->AggregatedTimeOff = 0;
+    MacCtx->NvmCtx->LastTxDoneTime = 0;
+    MacCtx->NvmCtx->AggregatedTimeOff = 0;
+
+#if defined( TRACE_POINT_ENABLED )
+    // Start the trace ticks counter
+    TracePointInit( );
+#endif
 
     // Initialize timers
-    TimerInit( &MacCtx.TxDelayedTimer, OnTxDelayedTimerEvent );
-    TimerInit( &MacCtx.RxWindowTimer1, OnRxWindow1TimerEvent );
-    TimerInit( &MacCtx.RxWindowTimer2, OnRxWindow2TimerEvent );
-    TimerInit( &MacCtx.AckTimeoutTimer, OnAckTimeoutTimerEvent );
+    TimerInit( &MacCtx->TxDelayedTimer, OnTxDelayedTimerEvent );
+    TimerInit( &MacCtx->RxWindowTimer1, OnRxWindow1TimerEvent );
+    TimerInit( &MacCtx->RxWindowTimer2, OnRxWindow2TimerEvent );
+    TimerInit( &MacCtx->AckTimeoutTimer, OnAckTimeoutTimerEvent );
+    TimerSetContext( &MacCtx->TxDelayedTimer, Instance );
+    TimerSetContext( &MacCtx->RxWindowTimer1, Instance );
+    TimerSetContext( &MacCtx->RxWindowTimer2, Instance );
+    TimerSetContext( &MacCtx->AckTimeoutTimer, Instance );
 
     // Store the current initialization time
-    MacCtx.NvmCtx->InitializationTime = SysTimeGetMcuTime( );
+    MacCtx->NvmCtx->InitializationTime = SysTimeGetMcuTime( );
 
     // Initialize Radio driver
-    MacCtx.RadioEvents.TxDone = OnRadioTxDone;
-    MacCtx.RadioEvents.RxDone = OnRadioRxDone;
-    MacCtx.RadioEvents.RxError = OnRadioRxError;
-    MacCtx.RadioEvents.TxTimeout = OnRadioTxTimeout;
-    MacCtx.RadioEvents.RxTimeout = OnRadioRxTimeout;
-    Radio.Init( &MacCtx.RadioEvents );
+    MacCtx->RadioEvents.TxDone = OnRadioTxDone;
+    MacCtx->RadioEvents.RxDone = OnRadioRxDone;
+    MacCtx->RadioEvents.RxError = OnRadioRxError;
+    MacCtx->RadioEvents.TxTimeout = OnRadioTxTimeout;
+    MacCtx->RadioEvents.RxTimeout = OnRadioRxTimeout;
+    MacCtx->RadioEvents.ChannelFreeDone = OnRadioChannelFreeDone;
+    Radio.Init( &MacCtx->RadioEvents );
 
     // Initialize the Secure Element driver
     if( SecureElementInit( EventSecureElementNvmCtxChanged ) != SECURE_ELEMENT_SUCCESS )
@@ -3378,21 +4322,30 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     }
 
     // Set multicast downlink counter reference
-    if( LoRaMacCryptoSetMulticastReference( MacCtx.NvmCtx->MulticastChannelList ) != LORAMAC_CRYPTO_SUCCESS )
+    if( LoRaMacCryptoSetMulticastReference( MacCtx->NvmCtx->MulticastChannelList ) != LORAMAC_CRYPTO_SUCCESS )
     {
         return LORAMAC_STATUS_CRYPTO_ERROR;
     }
 
     // Random seed initialization
-    srand1( Radio.Random( ) );
+    uint32_t seed = Radio.Random( );
+#if defined( EVENT_LOG_ENABLED )
+    uint32_t wakeupTime = Radio.GetWakeupTime( );
+    uint8_t eventLogHeader[8] = { ( uint8_t )seed, ( uint8_t )( seed >> 8 ), ( uint8_t )( seed >> 16 ), ( uint8_t )( seed >> 24 ),
+                                  ( uint8_t )wakeupTime, ( uint8_t )( wakeupTime >> 8 ), ( uint8_t )( wakeupTime >> 16 ), ( uint8_t )( wakeupTime >> 24 ) };
+
+    EventLogRecord( EVENT_LOG_MAC_INIT, eventLogHeader, sizeof( eventLogHeader ), NULL, 0 );
+#endif
+    srand1( seed );
 
-    Radio.SetPublicNetwork( MacCtx.NvmCtx->PublicNetwork );
+    Radio.SetPublicNetwork( MacCtx->NvmCtx->PublicNetwork );
     Radio.Sleep( );
 
     // Initialize class b
     // Apply callback
     classBCallbacks.GetTemperatureLevel = NULL;
     classBCallbacks.MacProcessNotify = NULL;
+    classBCallbacks.RadioRxStart = OnClassBRadioRxStart;
     if( callbacks != NULL )
     {
         classBCallbacks.GetTemperatureLevel = callbacks->GetTemperatureLevel;
@@ -3400,14 +4353,14 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
     }
 
     // Must all be static. Don't use local references.
-    classBParams.MlmeIndication = &MacCtx.MlmeIndication;
-    classBParams.McpsIndication = &MacCtx.McpsIndication;
-    classBParams.MlmeConfirm = &MacCtx.MlmeConfirm;
-    classBParams.LoRaMacFlags = &MacCtx.MacFlags;
-    classBParams.LoRaMacDevAddr = &MacCtx.NvmCtx->DevAddr;
-    classBParams.LoRaMacRegion = &MacCtx.NvmCtx->Region;
-    classBParams.LoRaMacParams = &MacCtx.NvmCtx->MacParams;
-    classBParams.MulticastChannels = &MacCtx.NvmCtx->MulticastChannelList[0];
+    classBParams.MlmeIndication = &MacCtx->MlmeIndication;
+    classBParams.McpsIndication = &MacCtx->McpsIndication;
+    classBParams.MlmeConfirm = &MacCtx->MlmeConfirm;
+    classBParams.LoRaMacFlags = &MacCtx->MacFlags;
+    classBParams.LoRaMacDevAddr = &MacCtx->NvmCtx->DevAddr;
+    classBParams.LoRaMacRegion = &MacCtx->NvmCtx->Region;
+    classBParams.LoRaMacParams = &MacCtx->NvmCtx->MacParams;
+    classBParams.MulticastChannels = &MacCtx->NvmCtx->MulticastChannelList[0];
 
     LoRaMacClassBInit( &classBParams, &classBCallbacks, &EventClassBNvmCtxChanged );
 
@@ -3418,7 +4371,7 @@ LoRaMacStatus_t LoRaMacInitialization( LoRaMacPrimitives_t* primitives, LoRaMacC
 
 LoRaMacStatus_t LoRaMacStart( void )
 {
-    MacCtx.MacState = LORAMAC_IDLE;
+    MacCtx->MacState = LORAMAC_IDLE;
     return LORAMAC_STATUS_OK;
 }
 
@@ -3426,10 +4379,10 @@ LoRaMacStatus_t LoRaMacStop( void )
 {
     if( LoRaMacIsBusy( ) == false )
     {
-        MacCtx.MacState = LORAMAC_STOPPED;
+        MacCtx->MacState = LORAMAC_STOPPED;
         return LORAMAC_STATUS_OK;
     }
-    else if(  MacCtx.MacState == LORAMAC_STOPPED )
+    else if(  MacCtx->MacState == LORAMAC_STOPPED )
     {
         return LORAMAC_STATUS_OK;
     }
@@ -3439,9 +4392,9 @@ LoRaMacStatus_t LoRaMacStop( void )
 LoRaMacStatus_t LoRaMacQueryTxPossible( uint8_t size, LoRaMacTxInfo_t* txInfo )
 {
     CalcNextAdrParams_t adrNext;
-    uint32_t adrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
-    int8_t datarate = MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate;
-    int8_t txPower = MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower;
+    uint32_t adrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
+    int8_t datarate = MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate;
+    int8_t txPower = MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower;
     size_t macCmdsSize = 0;
 
     if( txInfo == NULL )
@@ -3450,16 +4403,16 @@ LoRaMacStatus_t LoRaMacQueryTxPossible( uint8_t size, LoRaMacTxInfo_t* txInfo )
     }
 
     // Setup ADR request
-    adrNext.Version = MacCtx.NvmCtx->Version;
+    adrNext.Version = MacCtx->NvmCtx->Version;
     adrNext.UpdateChanMask = false;
-    adrNext.AdrEnabled = MacCtx.NvmCtx->AdrCtrlOn;
-    adrNext.AdrAckCounter = MacCtx.NvmCtx->AdrAckCounter;
-    adrNext.AdrAckLimit = MacCtx.AdrAckLimit;
-    adrNext.AdrAckDelay = MacCtx.AdrAckDelay;
-    adrNext.Datarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
-    adrNext.TxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
-    adrNext.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-    adrNext.Region = MacCtx.NvmCtx->Region;
+    adrNext.AdrEnabled = MacCtx->NvmCtx->AdrCtrlOn;
+    adrNext.AdrAckCounter = MacCtx->NvmCtx->AdrAckCounter;
+    adrNext.AdrAckLimit = MacCtx->AdrAckLimit;
+    adrNext.AdrAckDelay = MacCtx->AdrAckDelay;
+    adrNext.Datarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
+    adrNext.TxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
+    adrNext.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+    adrNext.Region = MacCtx->NvmCtx->Region;
 
     // We call the function for information purposes only. We don't want to
     // apply the datarate, the tx power and the ADR ack counter.
@@ -3509,12 +4462,12 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
     {
         case MIB_DEVICE_CLASS:
         {
-            mibGet->Param.Class = MacCtx.NvmCtx->DeviceClass;
+            mibGet->Param.Class = MacCtx->NvmCtx->DeviceClass;
             break;
         }
         case MIB_NETWORK_ACTIVATION:
         {
-            mibGet->Param.NetworkActivation = MacCtx.NvmCtx->NetworkActivation;
+            mibGet->Param.NetworkActivation = MacCtx->NvmCtx->NetworkActivation;
             break;
         }
         case MIB_DEV_EUI:
@@ -3534,56 +4487,61 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
         }
         case MIB_ADR:
         {
-            mibGet->Param.AdrEnable = MacCtx.NvmCtx->AdrCtrlOn;
+            mibGet->Param.AdrEnable = MacCtx->NvmCtx->AdrCtrlOn;
             break;
         }
         case MIB_NET_ID:
         {
-            mibGet->Param.NetID = MacCtx.NvmCtx->NetID;
+            mibGet->Param.NetID = MacCtx->NvmCtx->NetID;
             break;
         }
         case MIB_DEV_ADDR:
         {
-            mibGet->Param.DevAddr = MacCtx.NvmCtx->DevAddr;
+            mibGet->Param.DevAddr = MacCtx->NvmCtx->DevAddr;
             break;
         }
         case MIB_PUBLIC_NETWORK:
         {
-            mibGet->Param.EnablePublicNetwork = MacCtx.NvmCtx->PublicNetwork;
+            mibGet->Param.EnablePublicNetwork = MacCtx->NvmCtx->PublicNetwork;
             break;
         }
         case MIB_CHANNELS:
         {
             getPhy.Attribute = PHY_CHANNELS;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             mibGet->Param.ChannelList = phyParam.Channels;
+            if( phyParam.Channels == NULL )
+            {
+                // The region computes its channels, use LoRaMacChannelGet
+                status = LORAMAC_STATUS_SERVICE_UNKNOWN;
+            }
             break;
         }
         case MIB_RX2_CHANNEL:
         {
-            mibGet->Param.Rx2Channel = MacCtx.NvmCtx->MacParams.Rx2Channel;
+            mibGet->Param.Rx2Channel = MacCtx->NvmCtx->MacParams.Rx2Channel;
             break;
         }
         case MIB_RX2_DEFAULT_CHANNEL:
         {
-            mibGet->Param.Rx2Channel = MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel;
+            mibGet->Param.Rx2Channel = MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel;
             break;
         }
         case MIB_RXC_CHANNEL:
         {
-            mibGet->Param.RxCChannel = MacCtx.NvmCtx->MacParams.RxCChannel;
+            mibGet->Param.RxCChannel = MacCtx->NvmCtx->MacParams.RxCChannel;
             break;
         }
         case MIB_RXC_DEFAULT_CHANNEL:
         {
-            mibGet->Param.RxCChannel = MacCtx.NvmCtx->MacParamsDefaults.RxCChannel;
+            mibGet->Param.RxCChannel = MacCtx->NvmCtx->MacParamsDefaults.RxCChannel;
             break;
         }
         case MIB_CHANNELS_DEFAULT_MASK:
         {
             getPhy.Attribute = PHY_CHANNELS_DEFAULT_MASK;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             mibGet->Param.ChannelsDefaultMask = phyParam.ChannelsMask;
             break;
@@ -3591,74 +4549,74 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
         case MIB_CHANNELS_MASK:
         {
             getPhy.Attribute = PHY_CHANNELS_MASK;
-            phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+            phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
 
             mibGet->Param.ChannelsMask = phyParam.ChannelsMask;
             break;
         }
         case MIB_CHANNELS_NB_TRANS:
         {
-            mibGet->Param.ChannelsNbTrans = MacCtx.NvmCtx->MacParams.ChannelsNbTrans;
+            mibGet->Param.ChannelsNbTrans = MacCtx->NvmCtx->MacParams.ChannelsNbTrans;
             break;
         }
         case MIB_MAX_RX_WINDOW_DURATION:
         {
-            mibGet->Param.MaxRxWindow = MacCtx.NvmCtx->MacParams.MaxRxWindow;
+            mibGet->Param.MaxRxWindow = MacCtx->NvmCtx->MacParams.MaxRxWindow;
             break;
         }
         case MIB_RECEIVE_DELAY_1:
         {
-            mibGet->Param.ReceiveDelay1 = MacCtx.NvmCtx->MacParams.ReceiveDelay1;
+            mibGet->Param.ReceiveDelay1 = MacCtx->NvmCtx->MacParams.ReceiveDelay1;
             break;
         }
         case MIB_RECEIVE_DELAY_2:
         {
-            mibGet->Param.ReceiveDelay2 = MacCtx.NvmCtx->MacParams.ReceiveDelay2;
+            mibGet->Param.ReceiveDelay2 = MacCtx->NvmCtx->MacParams.ReceiveDelay2;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_1:
         {
-            mibGet->Param.JoinAcceptDelay1 = MacCtx.NvmCtx->MacParams.JoinAcceptDelay1;
+            mibGet->Param.JoinAcceptDelay1 = MacCtx->NvmCtx->MacParams.JoinAcceptDelay1;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_2:
         {
-            mibGet->Param.JoinAcceptDelay2 = MacCtx.NvmCtx->MacParams.JoinAcceptDelay2;
+            mibGet->Param.JoinAcceptDelay2 = MacCtx->NvmCtx->MacParams.JoinAcceptDelay2;
             break;
         }
         case MIB_CHANNELS_DEFAULT_DATARATE:
         {
-            mibGet->Param.ChannelsDefaultDatarate = MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate;
+            mibGet->Param.ChannelsDefaultDatarate = MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate;
             break;
         }
         case MIB_CHANNELS_DATARATE:
         {
-            mibGet->Param.ChannelsDatarate = MacCtx.NvmCtx->MacParams.ChannelsDatarate;
+            mibGet->Param.ChannelsDatarate = MacCtx->NvmCtx->MacParams.ChannelsDatarate;
             break;
         }
         case MIB_CHANNELS_DEFAULT_TX_POWER:
         {
-            mibGet->Param.ChannelsDefaultTxPower = MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower;
+            mibGet->Param.ChannelsDefaultTxPower = MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower;
             break;
         }
         case MIB_CHANNELS_TX_POWER:
         {
-            mibGet->Param.ChannelsTxPower = MacCtx.NvmCtx->MacParams.ChannelsTxPower;
+            mibGet->Param.ChannelsTxPower = MacCtx->NvmCtx->MacParams.ChannelsTxPower;
             break;
         }
         case MIB_SYSTEM_MAX_RX_ERROR:
         {
-            mibGet->Param.SystemMaxRxError = MacCtx.NvmCtx->MacParams.SystemMaxRxError;
+            mibGet->Param.SystemMaxRxError = MacCtx->NvmCtx->MacParams.SystemMaxRxError;
             break;
         }
         case MIB_MIN_RX_SYMBOLS:
         {
-            mibGet->Param.MinRxSymbols = MacCtx.NvmCtx->MacParams.MinRxSymbols;
+            mibGet->Param.MinRxSymbols = MacCtx->NvmCtx->MacParams.MinRxSymbols;
             break;
         }
         case MIB_ANTENNA_GAIN:
         {
-            mibGet->Param.AntennaGain = MacCtx.NvmCtx->MacParams.AntennaGain;
+            mibGet->Param.AntennaGain = MacCtx->NvmCtx->MacParams.AntennaGain;
             break;
         }
         case MIB_NVM_CTXS:
@@ -3668,15 +4626,61 @@ LoRaMacStatus_t LoRaMacMibGetRequestConfirm( MibRequestConfirm_t* mibGet )
         }
         case MIB_DEFAULT_ANTENNA_GAIN:
         {
-            mibGet->Param.DefaultAntennaGain = MacCtx.NvmCtx->MacParamsDefaults.AntennaGain;
+            mibGet->Param.DefaultAntennaGain = MacCtx->NvmCtx->MacParamsDefaults.AntennaGain;
             break;
         }
         case MIB_LORAWAN_VERSION:
         {
-            mibGet->Param.LrWanVersion.LoRaWan = MacCtx.NvmCtx->Version;
+            mibGet->Param.LrWanVersion.LoRaWan = MacCtx->NvmCtx->Version;
             mibGet->Param.LrWanVersion.LoRaWanRegion = RegionGetVersion( );
             break;
         }
+        case MIB_TRACE_POINTS:
+        {
+#if defined( TRACE_POINT_ENABLED )
+            mibGet->Param.TracePointStats = TracePointGetStats( );
+#else
+            status = LORAMAC_STATUS_SERVICE_UNKNOWN;
+#endif
+            break;
+        }
+        case MIB_TX_AHEAD_OF_TIME:
+        {
+            mibGet->Param.TxAheadOfTime = MacCtx->TxAheadOfTime;
+            break;
+        }
+        case MIB_RXC_DUTY_CYCLE:
+        {
+            mibGet->Param.RxCDutyCycle = MacCtx->RxCDutyCycle;
+            break;
+        }
+        case MIB_RXC_FORCE_CONTINUOUS:
+        {
+            mibGet->Param.RxCForceContinuous = MacCtx->RxCForceContinuous;
+            break;
+        }
+        case MIB_RX_FILTER:
+        {
+            mibGet->Param.RxFilter = MacCtx->RxFilterEnabled;
+            break;
+        }
+        case MIB_CARRIER_SENSE_MODE:
+        {
+            mibGet->Param.CarrierSenseMode = MacCtx->CarrierSenseMode;
+            break;
+        }
+        case MIB_RX_FILTER_STATS:
+        {
+            if( Radio.GetRxFilterStats != NULL )
+            {
+                Radio.GetRxFilterStats( &mibGet->Param.RxFilterStats );
+            }
+            else
+            {
+                memset1( ( uint8_t* )&mibGet->Param.RxFilterStats, 0, sizeof( RadioRxFilterStats_t ) );
+            }
+            break;
+        }
         default:
         {
             status = LoRaMacClassBMibGetRequestConfirm( mibGet );
@@ -3696,7 +4700,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
@@ -3712,7 +4716,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             if( mibSet->Param.NetworkActivation != ACTIVATION_TYPE_OTAA  )
             {
-                MacCtx.NvmCtx->NetworkActivation = mibSet->Param.NetworkActivation;
+                MacCtx->NvmCtx->NetworkActivation = mibSet->Param.NetworkActivation;
             }
             else
             {   // Do not allow to set ACTIVATION_TYPE_OTAA since the MAC will set it automatically after a successful join process.
@@ -3746,17 +4750,18 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_ADR:
         {
-            MacCtx.NvmCtx->AdrCtrlOn = mibSet->Param.AdrEnable;
+            MacCtx->NvmCtx->AdrCtrlOn = mibSet->Param.AdrEnable;
             break;
         }
         case MIB_NET_ID:
         {
-            MacCtx.NvmCtx->NetID = mibSet->Param.NetID;
+            MacCtx->NvmCtx->NetID = mibSet->Param.NetID;
             break;
         }
         case MIB_DEV_ADDR:
         {
-            MacCtx.NvmCtx->DevAddr = mibSet->Param.DevAddr;
+            MacCtx->NvmCtx->DevAddr = mibSet->Param.DevAddr;
+            UpdateRxFilter( );
             break;
         }
         case MIB_APP_KEY:
@@ -4076,18 +5081,18 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_PUBLIC_NETWORK:
         {
-            MacCtx.NvmCtx->PublicNetwork = mibSet->Param.EnablePublicNetwork;
-            Radio.SetPublicNetwork( MacCtx.NvmCtx->PublicNetwork );
+            MacCtx->NvmCtx->PublicNetwork = mibSet->Param.EnablePublicNetwork;
+            Radio.SetPublicNetwork( MacCtx->NvmCtx->PublicNetwork );
             break;
         }
         case MIB_RX2_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.Rx2Channel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.Rx2Channel = mibSet->Param.Rx2Channel;
+                MacCtx->NvmCtx->MacParams.Rx2Channel = mibSet->Param.Rx2Channel;
             }
             else
             {
@@ -4098,11 +5103,11 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_RX2_DEFAULT_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.Rx2Channel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.Rx2Channel = mibSet->Param.Rx2DefaultChannel;
+                MacCtx->NvmCtx->MacParamsDefaults.Rx2Channel = mibSet->Param.Rx2DefaultChannel;
             }
             else
             {
@@ -4113,13 +5118,13 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_RXC_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.RxCChannel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.RxCChannel = mibSet->Param.RxCChannel;
+                MacCtx->NvmCtx->MacParams.RxCChannel = mibSet->Param.RxCChannel;
 
-                if( ( MacCtx.NvmCtx->DeviceClass == CLASS_C ) && ( MacCtx.NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE ) )
+                if( ( MacCtx->NvmCtx->DeviceClass == CLASS_C ) && ( MacCtx->NvmCtx->NetworkActivation != ACTIVATION_TYPE_NONE ) )
                 {
                     // We can only compute the RX window parameters directly, if we are already
                     // in class c mode and joined. We cannot setup an RX window in case of any other
@@ -4139,11 +5144,11 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_RXC_DEFAULT_CHANNEL:
         {
             verify.DatarateParams.Datarate = mibSet->Param.RxCChannel.Datarate;
-            verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+            verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.RxCChannel = mibSet->Param.RxCDefaultChannel;
+                MacCtx->NvmCtx->MacParamsDefaults.RxCChannel = mibSet->Param.RxCDefaultChannel;
             }
             else
             {
@@ -4156,7 +5161,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             chanMaskSet.ChannelsMaskIn = mibSet->Param.ChannelsDefaultMask;
             chanMaskSet.ChannelsMaskType = CHANNELS_DEFAULT_MASK;
 
-            if( RegionChanMaskSet( MacCtx.NvmCtx->Region, &chanMaskSet ) == false )
+            if( RegionChanMaskSet( MacCtx->NvmCtx->Region, &chanMaskSet ) == false )
             {
                 status = LORAMAC_STATUS_PARAMETER_INVALID;
             }
@@ -4167,7 +5172,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             chanMaskSet.ChannelsMaskIn = mibSet->Param.ChannelsMask;
             chanMaskSet.ChannelsMaskType = CHANNELS_MASK;
 
-            if( RegionChanMaskSet( MacCtx.NvmCtx->Region, &chanMaskSet ) == false )
+            if( RegionChanMaskSet( MacCtx->NvmCtx->Region, &chanMaskSet ) == false )
             {
                 status = LORAMAC_STATUS_PARAMETER_INVALID;
             }
@@ -4178,7 +5183,7 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             if( ( mibSet->Param.ChannelsNbTrans >= 1 ) &&
                 ( mibSet->Param.ChannelsNbTrans <= 15 ) )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsNbTrans = mibSet->Param.ChannelsNbTrans;
+                MacCtx->NvmCtx->MacParams.ChannelsNbTrans = mibSet->Param.ChannelsNbTrans;
             }
             else
             {
@@ -4188,36 +5193,36 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_MAX_RX_WINDOW_DURATION:
         {
-            MacCtx.NvmCtx->MacParams.MaxRxWindow = mibSet->Param.MaxRxWindow;
+            MacCtx->NvmCtx->MacParams.MaxRxWindow = mibSet->Param.MaxRxWindow;
             break;
         }
         case MIB_RECEIVE_DELAY_1:
         {
-            MacCtx.NvmCtx->MacParams.ReceiveDelay1 = mibSet->Param.ReceiveDelay1;
+            MacCtx->NvmCtx->MacParams.ReceiveDelay1 = mibSet->Param.ReceiveDelay1;
             break;
         }
         case MIB_RECEIVE_DELAY_2:
         {
-            MacCtx.NvmCtx->MacParams.ReceiveDelay2 = mibSet->Param.ReceiveDelay2;
+            MacCtx->NvmCtx->MacParams.ReceiveDelay2 = mibSet->Param.ReceiveDelay2;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_1:
         {
-            MacCtx.NvmCtx->MacParams.JoinAcceptDelay1 = mibSet->Param.JoinAcceptDelay1;
+            MacCtx->NvmCtx->MacParams.JoinAcceptDelay1 = mibSet->Param.JoinAcceptDelay1;
             break;
         }
         case MIB_JOIN_ACCEPT_DELAY_2:
         {
-            MacCtx.NvmCtx->MacParams.JoinAcceptDelay2 = mibSet->Param.JoinAcceptDelay2;
+            MacCtx->NvmCtx->MacParams.JoinAcceptDelay2 = mibSet->Param.JoinAcceptDelay2;
             break;
         }
         case MIB_CHANNELS_DEFAULT_DATARATE:
         {
             verify.DatarateParams.Datarate = mibSet->Param.ChannelsDefaultDatarate;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_DEF_TX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_DEF_TX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.ChannelsDatarate = verify.DatarateParams.Datarate;
+                MacCtx->NvmCtx->MacParamsDefaults.ChannelsDatarate = verify.DatarateParams.Datarate;
             }
             else
             {
@@ -4228,11 +5233,11 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         case MIB_CHANNELS_DATARATE:
         {
             verify.DatarateParams.Datarate = mibSet->Param.ChannelsDatarate;
-            verify.DatarateParams.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
+            verify.DatarateParams.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_TX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_TX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
+                MacCtx->NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
             }
             else
             {
@@ -4244,9 +5249,9 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             verify.TxPower = mibSet->Param.ChannelsDefaultTxPower;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_DEF_TX_POWER ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_DEF_TX_POWER ) == true )
             {
-                MacCtx.NvmCtx->MacParamsDefaults.ChannelsTxPower = verify.TxPower;
+                MacCtx->NvmCtx->MacParamsDefaults.ChannelsTxPower = verify.TxPower;
             }
             else
             {
@@ -4258,9 +5263,9 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         {
             verify.TxPower = mibSet->Param.ChannelsTxPower;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_TX_POWER ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_TX_POWER ) == true )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsTxPower = verify.TxPower;
+                MacCtx->NvmCtx->MacParams.ChannelsTxPower = verify.TxPower;
             }
             else
             {
@@ -4270,22 +5275,22 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
         }
         case MIB_SYSTEM_MAX_RX_ERROR:
         {
-            MacCtx.NvmCtx->MacParams.SystemMaxRxError = MacCtx.NvmCtx->MacParamsDefaults.SystemMaxRxError = mibSet->Param.SystemMaxRxError;
+            MacCtx->NvmCtx->MacParams.SystemMaxRxError = MacCtx->NvmCtx->MacParamsDefaults.SystemMaxRxError = mibSet->Param.SystemMaxRxError;
             break;
         }
         case MIB_MIN_RX_SYMBOLS:
         {
-            MacCtx.NvmCtx->MacParams.MinRxSymbols = MacCtx.NvmCtx->MacParamsDefaults.MinRxSymbols = mibSet->Param.MinRxSymbols;
+            MacCtx->NvmCtx->MacParams.MinRxSymbols = MacCtx->NvmCtx->MacParamsDefaults.MinRxSymbols = mibSet->Param.MinRxSymbols;
             break;
         }
         case MIB_ANTENNA_GAIN:
         {
-            MacCtx.NvmCtx->MacParams.AntennaGain = mibSet->Param.AntennaGain;
+            MacCtx->NvmCtx->MacParams.AntennaGain = mibSet->Param.AntennaGain;
             break;
         }
         case MIB_DEFAULT_ANTENNA_GAIN:
         {
-            MacCtx.NvmCtx->MacParamsDefaults.AntennaGain = mibSet->Param.DefaultAntennaGain;
+            MacCtx->NvmCtx->MacParamsDefaults.AntennaGain = mibSet->Param.DefaultAntennaGain;
             break;
         }
         case MIB_NVM_CTXS:
@@ -4300,11 +5305,57 @@ LoRaMacStatus_t LoRaMacMibSetRequestConfirm( MibRequestConfirm_t* mibSet )
             }
             break;
         }
+        case MIB_TRACE_POINTS:
+        {
+#if defined( TRACE_POINT_ENABLED )
+            TracePointInit( );
+#else
+            status = LORAMAC_STATUS_SERVICE_UNKNOWN;
+#endif
+            break;
+        }
+        case MIB_TX_AHEAD_OF_TIME:
+        {
+            MacCtx->TxAheadOfTime = mibSet->Param.TxAheadOfTime;
+            break;
+        }
+        case MIB_RXC_DUTY_CYCLE:
+        case MIB_RXC_FORCE_CONTINUOUS:
+        {
+            if( mibSet->Type == MIB_RXC_DUTY_CYCLE )
+            {
+                MacCtx->RxCDutyCycle = mibSet->Param.RxCDutyCycle;
+            }
+            else
+            {
+                MacCtx->RxCForceContinuous = mibSet->Param.RxCForceContinuous;
+            }
+            RestartRxCWindow( );
+            break;
+        }
+        case MIB_RX_FILTER:
+        {
+            MacCtx->RxFilterEnabled = mibSet->Param.RxFilter;
+            UpdateRxFilter( );
+            break;
+        }
+        case MIB_CARRIER_SENSE_MODE:
+        {
+            if( mibSet->Param.CarrierSenseMode <= RADIO_CARRIER_SENSE_CAD )
+            {
+                MacCtx->CarrierSenseMode = mibSet->Param.CarrierSenseMode;
+            }
+            else
+            {
+                status = LORAMAC_STATUS_PARAMETER_INVALID;
+            }
+            break;
+        }
         case MIB_ABP_LORAWAN_VERSION:
         {
             if( mibSet->Param.AbpLrWanVersion.Fields.Minor <= 1 )
             {
-                MacCtx.NvmCtx->Version = mibSet->Param.AbpLrWanVersion;
+                MacCtx->NvmCtx->Version = mibSet->Param.AbpLrWanVersion;
 
                 if( LORAMAC_CRYPTO_SUCCESS != LoRaMacCryptoSetLrWanVersion( mibSet->Param.AbpLrWanVersion ) )
                 {
@@ -4333,9 +5384,9 @@ LoRaMacStatus_t LoRaMacChannelAdd( uint8_t id, ChannelParams_t params )
     ChannelAddParams_t channelAdd;
 
     // Validate if the MAC is in a correct state
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
-        if( ( MacCtx.MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
+        if( ( MacCtx->MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
         {
             return LORAMAC_STATUS_BUSY;
         }
@@ -4345,16 +5396,16 @@ LoRaMacStatus_t LoRaMacChannelAdd( uint8_t id, ChannelParams_t params )
     channelAdd.ChannelId = id;
 
     EventRegionNvmCtxChanged( );
-    return RegionChannelAdd( MacCtx.NvmCtx->Region, &channelAdd );
+    return RegionChannelAdd( MacCtx->NvmCtx->Region, &channelAdd );
 }
 
 LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id )
 {
     ChannelRemoveParams_t channelRemove;
 
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
-        if( ( MacCtx.MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
+        if( ( MacCtx->MacState & LORAMAC_TX_CONFIG ) != LORAMAC_TX_CONFIG )
         {
             return LORAMAC_STATUS_BUSY;
         }
@@ -4362,7 +5413,7 @@ LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id )
 
     channelRemove.ChannelId = id;
 
-    if( RegionChannelsRemove( MacCtx.NvmCtx->Region, &channelRemove ) == false )
+    if( RegionChannelsRemove( MacCtx->NvmCtx->Region, &channelRemove ) == false )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
@@ -4371,9 +5422,34 @@ LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id )
     return LORAMAC_STATUS_OK;
 }
 
+LoRaMacStatus_t LoRaMacChannelGet( uint8_t id, ChannelParams_t* params )
+{
+    GetPhyParams_t getPhy;
+    PhyParam_t phyParam;
+
+    if( params == NULL )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    getPhy.Attribute = PHY_MAX_NB_CHANNELS;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+    if( id >= phyParam.Value )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    getPhy.Attribute = PHY_CHANNEL;
+    getPhy.Channel = id;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
+
+    *params = phyParam.Channel;
+    return LORAMAC_STATUS_OK;
+}
+
 LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
 {
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
@@ -4383,7 +5459,7 @@ LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
         return LORAMAC_STATUS_MC_GROUP_UNDEFINED;
     }
 
-    MacCtx.NvmCtx->MulticastChannelList[channel->GroupID].ChannelParams = *channel;
+    MacCtx->NvmCtx->MulticastChannelList[channel->GroupID].ChannelParams = *channel;
 
     if( channel->IsRemotelySetup == true )
     {
@@ -4415,11 +5491,15 @@ LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
     if( channel->Class == CLASS_B )
     {
         // Calculate class b parameters
-        LoRaMacClassBSetMulticastPeriodicity( &MacCtx.NvmCtx->MulticastChannelList[channel->GroupID] );
+        LoRaMacClassBSetMulticastPeriodicity( &MacCtx->NvmCtx->MulticastChannelList[channel->GroupID] );
     }
 
     // Reset multicast channel downlink counter to initial value.
-    *MacCtx.NvmCtx->MulticastChannelList[channel->GroupID].DownLinkCounter = FCNT_DOWN_INITAL_VALUE;
+    *MacCtx->NvmCtx->MulticastChannelList[channel->GroupID].DownLinkCounter = FCNT_DOWN_INITAL_VALUE;
+
+    UpdateRxFilter( );
+    // Multicast sessions keep the continuous reception
+    RestartRxCWindow( );
 
     EventMacNvmCtxChanged( );
     EventRegionNvmCtxChanged( );
@@ -4428,13 +5508,13 @@ LoRaMacStatus_t LoRaMacMcChannelSetup( McChannelParams_t *channel )
 
 LoRaMacStatus_t LoRaMacMcChannelDelete( AddressIdentifier_t groupID )
 {
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
     if( ( groupID >= LORAMAC_MAX_MC_CTX ) ||
-        ( MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
+        ( MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
     {
         return LORAMAC_STATUS_MC_GROUP_UNDEFINED;
     }
@@ -4444,7 +5524,11 @@ LoRaMacStatus_t LoRaMacMcChannelDelete( AddressIdentifier_t groupID )
     // Set all channel fields with 0
     memset1( ( uint8_t* )&channel, 0, sizeof( McChannelParams_t ) );
 
-    MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams = channel;
+    MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams = channel;
+
+    UpdateRxFilter( );
+    // The reception duty cycle may resume without multicast session
+    RestartRxCWindow( );
 
     EventMacNvmCtxChanged( );
     EventRegionNvmCtxChanged( );
@@ -4455,7 +5539,7 @@ uint8_t LoRaMacMcChannelGetGroupId( uint32_t mcAddress )
 {
     for( uint8_t i = 0; i < LORAMAC_MAX_MC_CTX; i++ )
     {
-        if( mcAddress == MacCtx.NvmCtx->MulticastChannelList[i].ChannelParams.Address )
+        if( mcAddress == MacCtx->NvmCtx->MulticastChannelList[i].ChannelParams.Address )
         {
             return i;
         }
@@ -4467,19 +5551,19 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
 {
    *status = 0x1C + ( groupID & 0x03 );
 
-    if( ( MacCtx.MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
+    if( ( MacCtx->MacState & LORAMAC_TX_RUNNING ) == LORAMAC_TX_RUNNING )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
-    DeviceClass_t devClass = MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.Class;
+    DeviceClass_t devClass = MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.Class;
     if( ( devClass == CLASS_A ) || ( devClass > CLASS_C ) )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
 
     if( ( groupID >= LORAMAC_MAX_MC_CTX ) ||
-        ( MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
+        ( MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.IsEnabled == false ) )
     {
         return LORAMAC_STATUS_MC_GROUP_UNDEFINED;
     }
@@ -4495,9 +5579,9 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     {
         verify.DatarateParams.Datarate = rxParams->ClassC.Datarate;
     }
-    verify.DatarateParams.DownlinkDwellTime = MacCtx.NvmCtx->MacParams.DownlinkDwellTime;
+    verify.DatarateParams.DownlinkDwellTime = MacCtx->NvmCtx->MacParams.DownlinkDwellTime;
 
-    if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_RX_DR ) == true )
+    if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_RX_DR ) == true )
     {
         *status &= 0xFB; // datarate OK
     }
@@ -4511,7 +5595,7 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     {
         verify.Frequency = rxParams->ClassC.Frequency;
     }
-    if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_FREQUENCY ) == true )
+    if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_FREQUENCY ) == true )
     {
         *status &= 0xF7; // frequency OK
     }
@@ -4519,7 +5603,7 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     if( *status == ( groupID & 0x03 ) )
     {
         // Apply parameters
-        MacCtx.NvmCtx->MulticastChannelList[groupID].ChannelParams.RxParams = *rxParams;
+        MacCtx->NvmCtx->MulticastChannelList[groupID].ChannelParams.RxParams = *rxParams;
     }
 
     EventMacNvmCtxChanged( );
@@ -4527,6 +5611,101 @@ LoRaMacStatus_t LoRaMacMcChannelSetupRxParams( AddressIdentifier_t groupID, McRx
     return LORAMAC_STATUS_OK;
 }
 
+#if defined( EVENT_LOG_ENABLED )
+static void EventLogMcpsRequest( McpsReq_t* mcpsRequest )
+{
+    uint8_t header[4] = { mcpsRequest->Type, 0, 0, 0 };
+    void* fBuffer = NULL;
+    uint16_t fBufferSize = 0;
+
+    switch( mcpsRequest->Type )
+    {
+        case MCPS_UNCONFIRMED:
+        {
+            header[1] = mcpsRequest->Req.Unconfirmed.fPort;
+            header[2] = mcpsRequest->Req.Unconfirmed.Datarate;
+            fBuffer = mcpsRequest->Req.Unconfirmed.fBuffer;
+            fBufferSize = mcpsRequest->Req.Unconfirmed.fBufferSize;
+            break;
+        }
+        case MCPS_CONFIRMED:
+        {
+            header[1] = mcpsRequest->Req.Confirmed.fPort;
+            header[2] = mcpsRequest->Req.Confirmed.Datarate;
+            header[3] = mcpsRequest->Req.Confirmed.NbTrials;
+            fBuffer = mcpsRequest->Req.Confirmed.fBuffer;
+            fBufferSize = mcpsRequest->Req.Confirmed.fBufferSize;
+            break;
+        }
+        case MCPS_PROPRIETARY:
+        {
+            header[2] = mcpsRequest->Req.Proprietary.Datarate;
+            fBuffer = mcpsRequest->Req.Proprietary.fBuffer;
+            fBufferSize = mcpsRequest->Req.Proprietary.fBufferSize;
+            break;
+        }
+        default:
+            break;
+    }
+    if( fBuffer == NULL )
+    {
+        fBufferSize = 0;
+    }
+    EventLogRecord( EVENT_LOG_MCPS_REQUEST, header, sizeof( header ), fBuffer, fBufferSize );
+}
+
+static void EventLogMlmeRequest( MlmeReq_t* mlmeRequest )
+{
+    uint8_t header[12] = { mlmeRequest->Type };
+    uint8_t headerSize = 1;
+
+    switch( mlmeRequest->Type )
+    {
+        case MLME_JOIN:
+        {
+            header[headerSize++] = mlmeRequest->Req.Join.Datarate;
+            break;
+        }
+        case MLME_TXCW:
+        {
+            header[headerSize++] = mlmeRequest->Req.TxCw.Timeout & 0xFF;
+            header[headerSize++] = ( mlmeRequest->Req.TxCw.Timeout >> 8 ) & 0xFF;
+            header[headerSize++] = mlmeRequest->Req.TxCw.Frequency & 0xFF;
+            header[headerSize++] = ( mlmeRequest->Req.TxCw.Frequency >> 8 ) & 0xFF;
+            header[headerSize++] = ( mlmeRequest->Req.TxCw.Frequency >> 16 ) & 0xFF;
+            header[headerSize++] = ( mlmeRequest->Req.TxCw.Frequency >> 24 ) & 0xFF;
+            header[headerSize++] = mlmeRequest->Req.TxCw.Power;
+            break;
+        }
+        case MLME_PING_SLOT_INFO:
+        {
+            header[headerSize++] = mlmeRequest->Req.PingSlotInfo.PingSlot.Value;
+            break;
+        }
+        case MLME_DERIVE_MC_KE_KEY:
+        {
+            header[headerSize++] = mlmeRequest->Req.DeriveMcKEKey.KeyID;
+            header[headerSize++] = mlmeRequest->Req.DeriveMcKEKey.Nonce & 0xFF;
+            header[headerSize++] = ( mlmeRequest->Req.DeriveMcKEKey.Nonce >> 8 ) & 0xFF;
+            if( mlmeRequest->Req.DeriveMcKEKey.DevEUI != NULL )
+            {
+                EventLogRecord( EVENT_LOG_MLME_REQUEST, header, headerSize, mlmeRequest->Req.DeriveMcKEKey.DevEUI, SE_EUI_SIZE );
+                return;
+            }
+            break;
+        }
+        case MLME_DERIVE_MC_KEY_PAIR:
+        {
+            header[headerSize++] = mlmeRequest->Req.DeriveMcSessionKeyPair.GroupID;
+            break;
+        }
+        default:
+            break;
+    }
+    EventLogRecord( EVENT_LOG_MLME_REQUEST, header, headerSize, NULL, 0 );
+}
+#endif
+
 LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
 {
     LoRaMacStatus_t status = LORAMAC_STATUS_SERVICE_UNKNOWN;
@@ -4537,6 +5716,9 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
+#if defined( EVENT_LOG_ENABLED )
+    EventLogMlmeRequest( mlmeRequest );
+#endif
     if( LoRaMacIsBusy( ) == true )
     {
         return LORAMAC_STATUS_BUSY;
@@ -4548,11 +5730,11 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
 
     if( LoRaMacConfirmQueueGetCnt( ) == 0 )
     {
-        memset1( ( uint8_t* ) &MacCtx.MlmeConfirm, 0, sizeof( MacCtx.MlmeConfirm ) );
+        memset1( ( uint8_t* ) &MacCtx->MlmeConfirm, 0, sizeof( MacCtx->MlmeConfirm ) );
     }
-    MacCtx.MlmeConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    MacCtx->MlmeConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
 
-    MacCtx.MacFlags.Bits.MlmeReq = 1;
+    MacCtx->MacFlags.Bits.MlmeReq = 1;
     queueElement.Request = mlmeRequest->Type;
     queueElement.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
     queueElement.RestrictCommonReadyToHandle = false;
@@ -4561,14 +5743,15 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
     {
         case MLME_JOIN:
         {
-            if( ( MacCtx.MacState & LORAMAC_TX_DELAYED ) == LORAMAC_TX_DELAYED )
+            if( ( ( MacCtx->MacState & LORAMAC_TX_DELAYED ) == LORAMAC_TX_DELAYED ) ||
+                ( ( MacCtx->MacState & LORAMAC_CARRIER_SENSE ) == LORAMAC_CARRIER_SENSE ) )
             {
                 return LORAMAC_STATUS_BUSY;
             }
 
             ResetMacParameters( );
 
-            MacCtx.NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx.NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR );
+            MacCtx->NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx->NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR );
 
             queueElement.Status = LORAMAC_EVENT_INFO_STATUS_JOIN_FAIL;
 
@@ -4577,7 +5760,7 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
             if( status != LORAMAC_STATUS_OK )
             {
                 // Revert back the previous datarate ( mainly used for US915 like regions )
-                MacCtx.NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx.NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR_RESTORE );
+                MacCtx->NvmCtx->MacParams.ChannelsDatarate = RegionAlternateDr( MacCtx->NvmCtx->Region, mlmeRequest->Req.Join.Datarate, ALTERNATE_DR_RESTORE );
             }
             break;
         }
@@ -4614,7 +5797,7 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
         }
         case MLME_PING_SLOT_INFO:
         {
-            if( MacCtx.NvmCtx->DeviceClass == CLASS_A )
+            if( MacCtx->NvmCtx->DeviceClass == CLASS_A )
             {
                 uint8_t value = mlmeRequest->Req.PingSlotInfo.PingSlot.Value;
 
@@ -4663,14 +5846,14 @@ LoRaMacStatus_t LoRaMacMlmeRequest( MlmeReq_t* mlmeRequest )
     }
 
     // Fill return structure
-    mlmeRequest->ReqReturn.DutyCycleWaitTime = MacCtx.DutyCycleWaitTime;
+    mlmeRequest->ReqReturn.DutyCycleWaitTime = MacCtx->DutyCycleWaitTime;
 
     if( status != LORAMAC_STATUS_OK )
     {
         if( LoRaMacConfirmQueueGetCnt( ) == 0 )
         {
-            MacCtx.NodeAckRequested = false;
-            MacCtx.MacFlags.Bits.MlmeReq = 0;
+            MacCtx->NodeAckRequested = false;
+            MacCtx->MacFlags.Bits.MlmeReq = 0;
         }
     }
     else
@@ -4698,24 +5881,27 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
     {
         return LORAMAC_STATUS_PARAMETER_INVALID;
     }
+#if defined( EVENT_LOG_ENABLED )
+    EventLogMcpsRequest( mcpsRequest );
+#endif
     if( LoRaMacIsBusy( ) == true )
     {
         return LORAMAC_STATUS_BUSY;
     }
 
     macHdr.Value = 0;
-    memset1( ( uint8_t* ) &MacCtx.McpsConfirm, 0, sizeof( MacCtx.McpsConfirm ) );
-    MacCtx.McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    memset1( ( uint8_t* ) &MacCtx->McpsConfirm, 0, sizeof( MacCtx->McpsConfirm ) );
+    MacCtx->McpsConfirm.Status = LORAMAC_EVENT_INFO_STATUS_ERROR;
 
     // AckTimeoutRetriesCounter must be reset every time a new request (unconfirmed or confirmed) is performed.
-    MacCtx.AckTimeoutRetriesCounter = 1;
+    MacCtx->AckTimeoutRetriesCounter = 1;
 
     switch( mcpsRequest->Type )
     {
         case MCPS_UNCONFIRMED:
         {
             readyToSend = true;
-            MacCtx.AckTimeoutRetries = 1;
+            MacCtx->AckTimeoutRetries = 1;
 
             macHdr.Bits.MType = FRAME_TYPE_DATA_UNCONFIRMED_UP;
             fPort = mcpsRequest->Req.Unconfirmed.fPort;
@@ -4727,7 +5913,7 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
         case MCPS_CONFIRMED:
         {
             readyToSend = true;
-            MacCtx.AckTimeoutRetries = MIN( mcpsRequest->Req.Confirmed.NbTrials, MAX_ACK_RETRIES );
+            MacCtx->AckTimeoutRetries = MIN( mcpsRequest->Req.Confirmed.NbTrials, MAX_ACK_RETRIES );
 
             macHdr.Bits.MType = FRAME_TYPE_DATA_CONFIRMED_UP;
             fPort = mcpsRequest->Req.Confirmed.fPort;
@@ -4739,7 +5925,7 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
         case MCPS_PROPRIETARY:
         {
             readyToSend = true;
-            MacCtx.AckTimeoutRetries = 1;
+            MacCtx->AckTimeoutRetries = 1;
 
             macHdr.Bits.MType = FRAME_TYPE_PROPRIETARY;
             fBuffer = mcpsRequest->Req.Proprietary.fBuffer;
@@ -4753,22 +5939,22 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
 
     // Get the minimum possible datarate
     getPhy.Attribute = PHY_MIN_TX_DR;
-    getPhy.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
-    phyParam = RegionGetPhyParam( MacCtx.NvmCtx->Region, &getPhy );
+    getPhy.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
+    phyParam = RegionGetPhyParam( MacCtx->NvmCtx->Region, &getPhy );
     // Apply the minimum possible datarate.
     // Some regions have limitations for the minimum datarate.
     datarate = MAX( datarate, ( int8_t )phyParam.Value );
 
     if( readyToSend == true )
     {
-        if( MacCtx.NvmCtx->AdrCtrlOn == false )
+        if( MacCtx->NvmCtx->AdrCtrlOn == false )
         {
             verify.DatarateParams.Datarate = datarate;
-            verify.DatarateParams.UplinkDwellTime = MacCtx.NvmCtx->MacParams.UplinkDwellTime;
+            verify.DatarateParams.UplinkDwellTime = MacCtx->NvmCtx->MacParams.UplinkDwellTime;
 
-            if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_TX_DR ) == true )
+            if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_TX_DR ) == true )
             {
-                MacCtx.NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
+                MacCtx->NvmCtx->MacParams.ChannelsDatarate = verify.DatarateParams.Datarate;
             }
             else
             {
@@ -4779,18 +5965,18 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest )
         status = Send( &macHdr, fPort, fBuffer, fBufferSize );
         if( status == LORAMAC_STATUS_OK )
         {
-            MacCtx.McpsConfirm.McpsRequest = mcpsRequest->Type;
-            MacCtx.MacFlags.Bits.McpsReq = 1;
+            MacCtx->McpsConfirm.McpsRequest = mcpsRequest->Type;
+            MacCtx->MacFlags.Bits.McpsReq = 1;
             EventMacNvmCtxChanged( );
         }
         else
         {
-            MacCtx.NodeAckRequested = false;
+            MacCtx->NodeAckRequested = false;
         }
     }
 
     // Fill return structure
-    mcpsRequest->ReqReturn.DutyCycleWaitTime = MacCtx.DutyCycleWaitTime;
+    mcpsRequest->ReqReturn.DutyCycleWaitTime = MacCtx->DutyCycleWaitTime;
 
     return status;
 }
@@ -4801,9 +5987,9 @@ void LoRaMacTestSetDutyCycleOn( bool enable )
 
     verify.DutyCycle = enable;
 
-    if( RegionVerify( MacCtx.NvmCtx->Region, &verify, PHY_DUTY_CYCLE ) == true )
+    if( RegionVerify( MacCtx->NvmCtx->Region, &verify, PHY_DUTY_CYCLE ) == true )
     {
-        MacCtx.NvmCtx->DutyCycleOn = enable;
+        MacCtx->NvmCtx->DutyCycleOn = enable;
     }
 }
 
@@ -4813,10 +5999,10 @@ LoRaMacStatus_t LoRaMacDeInitialization( void )
     if ( LoRaMacStop( ) == LORAMAC_STATUS_OK )
     {
         // Stop Timers
-        TimerStop( &MacCtx.TxDelayedTimer );
-        TimerStop( &MacCtx.RxWindowTimer1 );
-        TimerStop( &MacCtx.RxWindowTimer2 );
-        TimerStop( &MacCtx.AckTimeoutTimer );
+        TimerStop( &MacCtx->TxDelayedTimer );
+        TimerStop( &MacCtx->RxWindowTimer1 );
+        TimerStop( &MacCtx->RxWindowTimer2 );
+        TimerStop( &MacCtx->AckTimeoutTimer );
 
         // Take care about class B
         LoRaMacClassBHaltBeaconing( );
@@ -4835,3 +6021,149 @@ LoRaMacStatus_t LoRaMacDeInitialization( void )
         return LORAMAC_STATUS_BUSY;
     }
 }
+
+size_t LoRaMacInstanceGetSize( void )
+{
+    return sizeof( LoRaMacInstance_t );
+}
+
+LoRaMacStatus_t LoRaMacInstanceSelect( LoRaMacInstance_t* instance )
+{
+    if( instance == NULL )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+    if( instance == Instance )
+    {
+        return LORAMAC_STATUS_OK;
+    }
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    LoRaMacStatus_t status;
+
+    // An instance gets its module contexts from LoRaMacInstanceInitialization
+    if( ( instance != &DefaultInstance ) && ( instance->HasModuleCtxs == false ) )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    status = BindModuleCtxs( instance, instance->NvmMacCtx.Region );
+    if( status == LORAMAC_STATUS_OK )
+    {
+        Instance = instance;
+        MacCtx = &instance->MacCtx;
+    }
+    return status;
+#else
+    // Only the default instance is available
+    return LORAMAC_STATUS_PARAMETER_INVALID;
+#endif
+}
+
+LoRaMacInstance_t* LoRaMacInstanceGetSelected( void )
+{
+    return Instance;
+}
+
+LoRaMacStatus_t LoRaMacInstanceInitialization( LoRaMacInstance_t* instance, LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks, LoRaMacRegion_t region )
+{
+    LoRaMacStatus_t status;
+
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    if( ( instance != NULL ) && ( instance != &DefaultInstance ) )
+    {
+        if( AssignModuleCtxs( instance, region ) == false )
+        {
+            return LORAMAC_STATUS_ERROR;
+        }
+        instance->HasModuleCtxs = true;
+    }
+#endif
+    status = LoRaMacInstanceSelect( instance );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+#if defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+    // The instance may have been selected with another region
+    status = BindModuleCtxs( instance, region );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+#endif
+    return LoRaMacInitialization( primitives, callbacks, region );
+}
+
+LoRaMacStatus_t LoRaMacInstanceStart( LoRaMacInstance_t* instance )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceSelect( instance );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return LoRaMacStart( );
+}
+
+LoRaMacStatus_t LoRaMacInstanceStop( LoRaMacInstance_t* instance )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceSelect( instance );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return LoRaMacStop( );
+}
+
+void LoRaMacInstanceProcess( LoRaMacInstance_t* instance )
+{
+    if( LoRaMacInstanceSelect( instance ) == LORAMAC_STATUS_OK )
+    {
+        LoRaMacProcess( );
+    }
+}
+
+LoRaMacStatus_t LoRaMacInstanceMibGetRequestConfirm( LoRaMacInstance_t* instance, MibRequestConfirm_t* mibGet )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceSelect( instance );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return LoRaMacMibGetRequestConfirm( mibGet );
+}
+
+LoRaMacStatus_t LoRaMacInstanceMibSetRequestConfirm( LoRaMacInstance_t* instance, MibRequestConfirm_t* mibSet )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceSelect( instance );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return LoRaMacMibSetRequestConfirm( mibSet );
+}
+
+LoRaMacStatus_t LoRaMacInstanceMlmeRequest( LoRaMacInstance_t* instance, MlmeReq_t* mlmeRequest )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceSelect( instance );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return LoRaMacMlmeRequest( mlmeRequest );
+}
+
+LoRaMacStatus_t LoRaMacInstanceMcpsRequest( LoRaMacInstance_t* instance, McpsReq_t* mcpsRequest )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceSelect( instance );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return LoRaMacMcpsRequest( mcpsRequest );
+}
@@ -132,6 +132,7 @@ extern "C"
 #include "timer.h"
 #include "systime.h"
 #include "radio.h"
+#include "tracepoint.h"
 #include "LoRaMacTypes.h"
 
 /*!
@@ -356,6 +357,15 @@ typedef struct sLoRaMacCtxs
     size_t ConfirmQueueNvmCtxSize;
 }LoRaMacCtxs_t;
 
+/*!
+ * LoRaMAC instance. Holds the complete state of one end-device.
+ *
+ * \remark The structure is opaque. Use \ref LoRaMacInstanceGetSize to
+ *         allocate instances. Additional instances require
+ *         LORAMAC_MULTI_INSTANCE_ENABLED to be defined.
+ */
+typedef struct sLoRaMacInstance LoRaMacInstance_t;
+
 /*!
  * Global MAC layer parameters
  */
@@ -1216,6 +1226,24 @@ typedef struct sMlmeIndication
     BeaconInfo_t BeaconInfo;
 }MlmeIndication_t;
 
+/*!
+ * Class C reception duty cycle parameters
+ */
+typedef struct sRxCDutyCycleParams
+{
+    /*!
+     * Listen in reception duty cycle instead of continuously, when the radio
+     * supports it
+     */
+    bool Enabled;
+    /*!
+     * Preamble length in symbols the network uses for the class C downlinks.
+     * The longer the preamble, the longer the radio sleeps between two
+     * reception windows.
+     */
+    uint16_t PreambleLength;
+}RxCDutyCycleParams_t;
+
 /*!
  * LoRa Mac Information Base (MIB)
  *
@@ -1289,6 +1317,13 @@ typedef struct sMlmeIndication
  * \ref MIB_NVM_CTXS                             | YES | YES
  * \ref MIB_ABP_LORAWAN_VERSION                  | NO  | YES
  * \ref MIB_LORAWAN_VERSION                      | YES | NO
+ * \ref MIB_TRACE_POINTS                         | YES | YES
+ * \ref MIB_TX_AHEAD_OF_TIME                     | YES | YES
+ * \ref MIB_RXC_DUTY_CYCLE                       | YES | YES
+ * \ref MIB_RXC_FORCE_CONTINUOUS                 | YES | YES
+ * \ref MIB_RX_FILTER                            | YES | YES
+ * \ref MIB_RX_FILTER_STATS                      | YES | NO
+ * \ref MIB_CARRIER_SENSE_MODE                   | YES | YES
  *
  * The following table provides links to the function implementations of the
  * related MIB primitives:
@@ -1487,6 +1522,11 @@ typedef enum eMib
      * pointer which references the first entry of the channel list. The
      * list is of size LORA_MAX_NB_CHANNELS
      *
+     * \remark US915, AU915 and CN470 have fixed channels, computed from the
+     *         channel index. The get request returns
+     *         \ref LORAMAC_STATUS_SERVICE_UNKNOWN for these regions, use
+     *         \ref LoRaMacChannelGet instead.
+     *
      * LoRaWAN Regional Parameters V1.0.2rB
      */
     MIB_CHANNELS,
@@ -1697,6 +1737,61 @@ typedef enum eMib
      * The allowed ranges are region specific. Please refer to \ref DR_0 to \ref DR_15 for details.
      */
      MIB_PING_SLOT_DATARATE,
+    /*!
+     * Hot path execution time statistics. Setting the attribute clears the
+     * statistics.
+     *
+     * \remark Only available when TRACE_POINT_ENABLED is defined.
+     */
+    MIB_TRACE_POINTS,
+    /*!
+     * Secure the uplinks as soon as they are requested instead of right
+     * before their transmission. Only the LoRaWAN 1.1.x data rate and channel
+     * dependent MIC part and the region TX configuration are left for the
+     * transmission.
+     */
+    MIB_TX_AHEAD_OF_TIME,
+    /*!
+     * Class C reception duty cycle. The radio alternates reception windows
+     * sized after the RXC datarate and \ref MIB_MIN_RX_SYMBOLS, and sleep
+     * periods short enough to catch the network preamble.
+     *
+     * \remark The MAC listens continuously when the radio has no reception
+     *         duty cycle, when a multicast channel is enabled, when
+     *         \ref MIB_RXC_FORCE_CONTINUOUS is set or when the preamble is too
+     *         short to sleep at all. The running class C reception switches
+     *         mode when these change, e.g. on \ref LoRaMacMcChannelSetup and
+     *         \ref LoRaMacMcChannelDelete.
+     */
+    MIB_RXC_DUTY_CYCLE,
+    /*!
+     * Forces the class C continuous reception regardless of
+     * \ref MIB_RXC_DUTY_CYCLE, e.g. during a fragmented data block transport
+     */
+    MIB_RXC_FORCE_CONTINUOUS,
+    /*!
+     * Reception filter of the radio driver. Drops the uplinks of the other
+     * devices and the downlinks sent to other addresses before they reach
+     * the MAC. Enabled by default.
+     *
+     * \remark Not available when the radio driver doesn't implement
+     *         Radio.SetRxFilter.
+     */
+    MIB_RX_FILTER,
+    /*!
+     * Counters of the frames accepted and dropped by the reception filter
+     */
+    MIB_RX_FILTER_STATS,
+    /*!
+     * Carrier sense mode of the listen before talk procedure, e.g. AS923
+     * in Japan or KR920. RSSI by default.
+     *
+     * \remark Only the radio drivers implementing Radio.StartChannelFree
+     *         support \ref RADIO_CARRIER_SENSE_CAD. The CAD senses the LoRa
+     *         modulation of the uplink datarate, the FSK datarate falls back
+     *         to \ref RADIO_CARRIER_SENSE_RSSI.
+     */
+    MIB_CARRIER_SENSE_MODE,
 }Mib_t;
 
 /*!
@@ -2118,6 +2213,49 @@ typedef union uMibParam
      * Related MIB type: \ref MIB_PING_SLOT_DATARATE
      */
     int8_t PingSlotDatarate;
+    /*!
+     * Array of TRACE_POINT_MAX tracepoint statistics, indexed by
+     * \ref TracePointId_t
+     *
+     * Related MIB type: \ref MIB_TRACE_POINTS
+     */
+    const TracePointStats_t* TracePointStats;
+    /*!
+     * Secure the uplinks ahead of their transmission
+     *
+     * Related MIB type: \ref MIB_TX_AHEAD_OF_TIME
+     */
+    bool TxAheadOfTime;
+    /*!
+     * Class C reception duty cycle
+     *
+     * Related MIB type: \ref MIB_RXC_DUTY_CYCLE
+     */
+    RxCDutyCycleParams_t RxCDutyCycle;
+    /*!
+     * Class C continuous reception forced
+     *
+     * Related MIB type: \ref MIB_RXC_FORCE_CONTINUOUS
+     */
+    bool RxCForceContinuous;
+    /*!
+     * Reception filter enabled
+     *
+     * Related MIB type: \ref MIB_RX_FILTER
+     */
+    bool RxFilter;
+    /*!
+     * Reception filter counters
+     *
+     * Related MIB type: \ref MIB_RX_FILTER_STATS
+     */
+    RadioRxFilterStats_t RxFilterStats;
+    /*!
+     * Carrier sense mode
+     *
+     * Related MIB type: \ref MIB_CARRIER_SENSE_MODE
+     */
+    RadioCarrierSenseModes_t CarrierSenseMode;
 }MibParam_t;
 
 /*!
@@ -2152,6 +2290,81 @@ typedef struct sLoRaMacTxInfo
     uint8_t CurrentPossiblePayloadSize;
 }LoRaMacTxInfo_t;
 
+/*!
+ * Owner of the next deadline of the LoRaMAC
+ */
+typedef enum eLoRaMacDeadlineOwner
+{
+    /*!
+     * No deadline. The LoRaMAC only waits for radio interrupts.
+     */
+    LORAMAC_DEADLINE_NONE,
+    /*!
+     * Events are pending. \ref LoRaMacProcess must be called right away.
+     */
+    LORAMAC_DEADLINE_PROCESS,
+    /*!
+     * Opening of the RX1 window
+     */
+    LORAMAC_DEADLINE_RX_WINDOW_1,
+    /*!
+     * Opening of the RX2 window
+     */
+    LORAMAC_DEADLINE_RX_WINDOW_2,
+    /*!
+     * Transmission delayed by the duty cycle or by a class B beacon
+     */
+    LORAMAC_DEADLINE_TX_DELAYED,
+    /*!
+     * Retransmission of an unacknowledged confirmed uplink
+     */
+    LORAMAC_DEADLINE_ACK_TIMEOUT,
+    /*!
+     * Class B beacon reception or acquisition
+     */
+    LORAMAC_DEADLINE_CLASS_B_BEACON,
+    /*!
+     * Class B unicast ping slot
+     */
+    LORAMAC_DEADLINE_CLASS_B_PING_SLOT,
+    /*!
+     * Class B multicast ping slot
+     */
+    LORAMAC_DEADLINE_CLASS_B_MULTICAST_SLOT,
+    /*!
+     * Timer which doesn't belong to the LoRaMAC, e.g. an application or
+     * LmHandler package timer
+     */
+    LORAMAC_DEADLINE_TIMER,
+}LoRaMacDeadlineOwner_t;
+
+/*!
+ * Next time the LoRaMAC needs the CPU
+ */
+typedef struct sLoRaMacDeadline
+{
+    /*!
+     * Owner of the deadline
+     */
+    LoRaMacDeadlineOwner_t Owner;
+    /*!
+     * Time until the deadline in ms. 0 for \ref LORAMAC_DEADLINE_PROCESS.
+     * TIMERTIME_T_MAX for \ref LORAMAC_DEADLINE_NONE.
+     */
+    TimerTime_t Time;
+    /*!
+     * Time in ms the CPU must be running ahead of the deadline, e.g. to wake
+     * up the radio and its TCXO. The timer of the deadline expires at
+     * Time - LeadTime.
+     */
+    uint32_t LeadTime;
+    /*!
+     * The deadline tolerates to be served late, e.g. by the wake up latency
+     * of a deep low power mode. RX windows and class B slots don't.
+     */
+    bool CanRunLate;
+}LoRaMacDeadline_t;
+
 /*!
  * LoRaMAC Status
  */
@@ -2261,6 +2474,10 @@ typedef enum eLoRaMacStatus
      * The multicast group doesn't exist
      */
     LORAMAC_STATUS_MC_GROUP_UNDEFINED,
+    /*!
+     * Listen before talk is in progress. The result is reported asynchronously
+     */
+    LORAMAC_STATUS_CARRIER_SENSE_ONGOING,
     /*!
      * Undefined error occurred
      */
@@ -2479,6 +2696,25 @@ bool LoRaMacIsBusy( void );
  */
 void LoRaMacProcess( void );
 
+/*!
+ * \brief   Gets the next time the LoRaMAC needs the CPU
+ *
+ * \details Considers the RX windows, the delayed transmission, the
+ *          acknowledgement timeout, the class B beacon and ping slots and the
+ *          pending LoRaMAC events. Any other timer, e.g. a package timer, is
+ *          reported as \ref LORAMAC_DEADLINE_TIMER when it expires first.
+ *
+ *          To be called before entering a low power mode, to select the
+ *          deepest mode whose wake up latency still meets the deadline.
+ *
+ * \param   [OUT] deadline - Next deadline.
+ *
+ * \retval  LoRaMacStatus_t Status of the operation. Possible returns are:
+ *          \ref LORAMAC_STATUS_OK,
+ *          \ref LORAMAC_STATUS_PARAMETER_INVALID.
+ */
+LoRaMacStatus_t LoRaMacGetNextDeadline( LoRaMacDeadline_t* deadline );
+
 /*!
  * \brief   Queries the LoRaMAC if it is possible to send the next frame with
  *          a given application data payload size. The LoRaMAC takes scheduled
@@ -2538,6 +2774,22 @@ LoRaMacStatus_t LoRaMacChannelAdd( uint8_t id, ChannelParams_t params );
  */
 LoRaMacStatus_t LoRaMacChannelRemove( uint8_t id );
 
+/*!
+ * \brief   LoRaMAC channel get service
+ *
+ * \details Gets the parameters of a channel. Available on all regions,
+ *          including the ones with channels computed from the channel index.
+ *
+ * \param   [IN] id - Id of the channel.
+ *
+ * \param   [OUT] params - Channel parameters.
+ *
+ * \retval  LoRaMacStatus_t Status of the operation. Possible returns are:
+ *          \ref LORAMAC_STATUS_OK,
+ *          \ref LORAMAC_STATUS_PARAMETER_INVALID.
+ */
+LoRaMacStatus_t LoRaMacChannelGet( uint8_t id, ChannelParams_t* params );
+
 /*!
  * \brief   LoRaMAC multicast channel setup service
  *
@@ -2732,6 +2984,102 @@ LoRaMacStatus_t LoRaMacMcpsRequest( McpsReq_t* mcpsRequest );
  */
 LoRaMacStatus_t LoRaMacDeInitialization( void );
 
+/*!
+ * \brief   Returns the amount of memory required by one LoRaMAC instance
+ *
+ * \retval  Size of \ref LoRaMacInstance_t in bytes
+ */
+size_t LoRaMacInstanceGetSize( void );
+
+/*!
+ * \brief   Selects the instance all other LoRaMAC functions operate on
+ *
+ * \details The functions without an instance parameter always operate on the
+ *          selected instance. Until another instance is selected this is the
+ *          default instance, which keeps the single device API unchanged.
+ *
+ *          Selecting binds the region, crypto, secure element, commands,
+ *          class B and confirm queue contexts of the instance to these modules.
+ *          Only pointers change, no context is copied. Call it from the main
+ *          loop only, never from an interrupt.
+ *
+ *          Radio events belong to the instance which last started a radio
+ *          operation. The MAC timers of an instance only record their event
+ *          and call its MacProcessNotify. The main loop then has to call
+ *          \ref LoRaMacInstanceProcess for the notified instance. The RX
+ *          windows of the instances open from the main loop, thus its latency
+ *          adds to the RX window timing error.
+ *
+ *          The MCPS/MLME primitives are called while the instance they belong
+ *          to is selected. Use \ref LoRaMacInstanceGetSelected to identify it.
+ *
+ * \remark  Additional instances require a secure element storing its keys in
+ *          its context, e.g. the soft secure element, and can't be used with
+ *          SECURE_ELEMENT_ASYNC_ENABLED.
+ *
+ * \param   [IN] instance - Instance to select.
+ *
+ * \retval  LoRaMacStatus_t Status of the operation. Possible returns are:
+ *          \ref LORAMAC_STATUS_OK,
+ *          \ref LORAMAC_STATUS_PARAMETER_INVALID,
+ *          \ref LORAMAC_STATUS_CRYPTO_ERROR.
+ */
+LoRaMacStatus_t LoRaMacInstanceSelect( LoRaMacInstance_t* instance );
+
+/*!
+ * \brief   Returns the selected instance
+ *
+ * \retval  Pointer to the selected instance
+ */
+LoRaMacInstance_t* LoRaMacInstanceGetSelected( void );
+
+/*!
+ * \brief   Initializes the given instance. Refer to \ref LoRaMacInitialization.
+ *
+ * \details Reserves the contexts of the other MAC modules in the instance.
+ *          Fails with \ref LORAMAC_STATUS_ERROR when they don't fit into
+ *          LORAMAC_INSTANCE_MODULE_CTXS_SIZE bytes.
+ *
+ * \param   [IN] instance - Instance to initialize. 8-byte aligned memory of at
+ *                         least \ref LoRaMacInstanceGetSize bytes.
+ */
+LoRaMacStatus_t LoRaMacInstanceInitialization( LoRaMacInstance_t* instance, LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks, LoRaMacRegion_t region );
+
+/*!
+ * \brief   Starts the given instance. Refer to \ref LoRaMacStart.
+ */
+LoRaMacStatus_t LoRaMacInstanceStart( LoRaMacInstance_t* instance );
+
+/*!
+ * \brief   Stops the given instance. Refer to \ref LoRaMacStop.
+ */
+LoRaMacStatus_t LoRaMacInstanceStop( LoRaMacInstance_t* instance );
+
+/*!
+ * \brief   Processes the events of the given instance. Refer to \ref LoRaMacProcess.
+ */
+void LoRaMacInstanceProcess( LoRaMacInstance_t* instance );
+
+/*!
+ * \brief   MIB-Get on the given instance. Refer to \ref LoRaMacMibGetRequestConfirm.
+ */
+LoRaMacStatus_t LoRaMacInstanceMibGetRequestConfirm( LoRaMacInstance_t* instance, MibRequestConfirm_t* mibGet );
+
+/*!
+ * \brief   MIB-Set on the given instance. Refer to \ref LoRaMacMibSetRequestConfirm.
+ */
+LoRaMacStatus_t LoRaMacInstanceMibSetRequestConfirm( LoRaMacInstance_t* instance, MibRequestConfirm_t* mibSet );
+
+/*!
+ * \brief   MLME-Request on the given instance. Refer to \ref LoRaMacMlmeRequest.
+ */
+LoRaMacStatus_t LoRaMacInstanceMlmeRequest( LoRaMacInstance_t* instance, MlmeReq_t* mlmeRequest );
+
+/*!
+ * \brief   MCPS-Request on the given instance. Refer to \ref LoRaMacMcpsRequest.
+ */
+LoRaMacStatus_t LoRaMacInstanceMcpsRequest( LoRaMacInstance_t* instance, McpsReq_t* mcpsRequest );
+
 /*!
  * Automatically add the Region.h file at the end of LoRaMac.h file.
  * This is required because Region.h uses definitions from LoRaMac.h
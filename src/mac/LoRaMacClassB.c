@@ -25,6 +25,7 @@ Maintainer: Miguel Luis ( Semtech ), Gregory Cristian ( Semtech ) and Daniel Jae
 #include "LoRaMacClassBConfig.h"
 #include "LoRaMacCrypto.h"
 #include "LoRaMacConfirmQueue.h"
+#include "eventlog.h"
 
 #ifdef LORAMAC_CLASSB_ENABLED
 
@@ -98,6 +99,20 @@ typedef struct sLoRaMacClassBNvmCtx
     LoRaMacClassBBeaconNvmCtx_t BeaconCtx;
 } LoRaMacClassBNvmCtx_t;
 
+/*!
+ * Defines the LoRaMac radio events status
+ */
+typedef union uLoRaMacClassBEvents
+{
+    uint32_t Value;
+    struct sEvents
+    {
+        uint32_t Beacon        : 1;
+        uint32_t PingSlot      : 1;
+        uint32_t MulticastSlot : 1;
+    }Events;
+}LoRaMacClassBEvents_t;
+
 /*
  * LoRaMac Class B Context structure
  */
@@ -152,33 +167,27 @@ typedef struct sLoRaMacClassBCtx
     * Non-volatile module context.
     */
     LoRaMacClassBNvmCtx_t* NvmCtx;
+    /*!
+    * Timer events waiting for LoRaMacClassBProcess
+    */
+    LoRaMacClassBEvents_t Events;
 } LoRaMacClassBCtx_t;
 
-/*!
- * Defines the LoRaMac radio events status
- */
-typedef union uLoRaMacClassBEvents
-{
-    uint32_t Value;
-    struct sEvents
-    {
-        uint32_t Beacon        : 1;
-        uint32_t PingSlot      : 1;
-        uint32_t MulticastSlot : 1;
-    }Events;
-}LoRaMacClassBEvents_t;
-
-LoRaMacClassBEvents_t LoRaMacClassBEvents = { .Value = 0 };
-
 /*
  * Non-volatile module context.
  */
-static LoRaMacClassBNvmCtx_t NvmCtx;
+static LoRaMacClassBNvmCtx_t DefaultNvmCtx;
 
 /*
  * Module context.
  */
-static LoRaMacClassBCtx_t Ctx;
+static LoRaMacClassBCtx_t DefaultCtx = { .NvmCtx = &DefaultNvmCtx };
+
+/*
+ * Module context in use. Bound to the contexts of the selected LoRaMac
+ * instance by LoRaMacClassBBindCtxs.
+ */
+static LoRaMacClassBCtx_t* Ctx = &DefaultCtx;
 
 /*!
  * Computes the Ping Offset
@@ -240,7 +249,7 @@ static uint32_t CalcDownlinkFrequency( uint8_t channel, bool isBeacon )
         getPhy.Attribute = PHY_BEACON_CHANNEL_FREQ;
     }
     getPhy.Channel = channel;
-    phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+    phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
 
     return phyParam.Value;
 }
@@ -276,7 +285,7 @@ static uint32_t CalcDownlinkChannelAndFrequency( uint32_t devAddr, TimerTime_t b
         // Beacon channels
         getPhy.Attribute = PHY_BEACON_NB_CHANNELS;
     }
-    phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+    phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
     nbChannels = ( uint8_t ) phyParam.Value;
 
     // nbChannels is > 1, when the channel plan requires more than one possible channel
@@ -307,7 +316,7 @@ static void RxBeaconSetup( TimerTime_t rxTime, bool activateDefaultChannel )
     RxConfigParams_t beaconRxConfig;
     GetPhyParams_t getPhy;
     PhyParam_t phyParam;
-    uint16_t windowTimeout = Ctx.BeaconCtx.SymbolTimeout;
+    uint16_t windowTimeout = Ctx->BeaconCtx.SymbolTimeout;
 
     if( activateDefaultChannel == true )
     {
@@ -318,36 +327,36 @@ static void RxBeaconSetup( TimerTime_t rxTime, bool activateDefaultChannel )
     else
     {
         // This is the frequency according to the channel plan
-        frequency = CalcDownlinkChannelAndFrequency( 0, Ctx.BeaconCtx.BeaconTime.Seconds + ( CLASSB_BEACON_INTERVAL / 1000 ),
+        frequency = CalcDownlinkChannelAndFrequency( 0, Ctx->BeaconCtx.BeaconTime.Seconds + ( CLASSB_BEACON_INTERVAL / 1000 ),
                                                      CLASSB_BEACON_INTERVAL, true );
     }
 
-    if( Ctx.NvmCtx->BeaconCtx.Ctrl.CustomFreq == 1 )
+    if( Ctx->NvmCtx->BeaconCtx.Ctrl.CustomFreq == 1 )
     {
         // Set the frequency from the BeaconFreqReq
-        frequency = Ctx.NvmCtx->BeaconCtx.Frequency;
+        frequency = Ctx->NvmCtx->BeaconCtx.Frequency;
     }
 
-    if( Ctx.BeaconCtx.Ctrl.BeaconChannelSet == 1 )
+    if( Ctx->BeaconCtx.Ctrl.BeaconChannelSet == 1 )
     {
         // Set the frequency which was provided by BeaconTimingAns MAC command
-        Ctx.BeaconCtx.Ctrl.BeaconChannelSet = 0;
-        frequency = CalcDownlinkFrequency( Ctx.BeaconCtx.BeaconTimingChannel, true );
+        Ctx->BeaconCtx.Ctrl.BeaconChannelSet = 0;
+        frequency = CalcDownlinkFrequency( Ctx->BeaconCtx.BeaconTimingChannel, true );
     }
 
-    if( ( Ctx.BeaconCtx.Ctrl.BeaconAcquired == 1 ) || ( Ctx.BeaconCtx.Ctrl.AcquisitionPending == 1 ) )
+    if( ( Ctx->BeaconCtx.Ctrl.BeaconAcquired == 1 ) || ( Ctx->BeaconCtx.Ctrl.AcquisitionPending == 1 ) )
     {
         // Apply the symbol timeout only if we have acquired the beacon
         // Otherwise, take the window enlargement into account
         // Read beacon datarate
         getPhy.Attribute = PHY_BEACON_CHANNEL_DR;
-        phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+        phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
 
         // Calculate downlink symbols
-        RegionComputeRxWindowParameters( *Ctx.LoRaMacClassBParams.LoRaMacRegion,
+        RegionComputeRxWindowParameters( *Ctx->LoRaMacClassBParams.LoRaMacRegion,
                                         ( int8_t )phyParam.Value, // datarate
-                                        Ctx.LoRaMacClassBParams.LoRaMacParams->MinRxSymbols,
-                                        Ctx.LoRaMacClassBParams.LoRaMacParams->SystemMaxRxError,
+                                        Ctx->LoRaMacClassBParams.LoRaMacParams->MinRxSymbols,
+                                        Ctx->LoRaMacClassBParams.LoRaMacParams->SystemMaxRxError,
                                         &beaconRxConfig );
         windowTimeout = beaconRxConfig.WindowTimeout;
     }
@@ -356,58 +365,101 @@ static void RxBeaconSetup( TimerTime_t rxTime, bool activateDefaultChannel )
     rxBeaconSetup.RxTime = rxTime;
     rxBeaconSetup.Frequency = frequency;
 
-    RegionRxBeaconSetup( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &rxBeaconSetup, &Ctx.LoRaMacClassBParams.McpsIndication->RxDatarate );
+    if( Ctx->LoRaMacClassBCallbacks.RadioRxStart != NULL )
+    {
+        Ctx->LoRaMacClassBCallbacks.RadioRxStart( );
+    }
+    RegionRxBeaconSetup( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &rxBeaconSetup, &Ctx->LoRaMacClassBParams.McpsIndication->RxDatarate );
 
-    Ctx.LoRaMacClassBParams.MlmeIndication->BeaconInfo.Frequency = frequency;
-    Ctx.LoRaMacClassBParams.MlmeIndication->BeaconInfo.Datarate = Ctx.LoRaMacClassBParams.McpsIndication->RxDatarate;
+    Ctx->LoRaMacClassBParams.MlmeIndication->BeaconInfo.Frequency = frequency;
+    Ctx->LoRaMacClassBParams.MlmeIndication->BeaconInfo.Datarate = Ctx->LoRaMacClassBParams.McpsIndication->RxDatarate;
 }
 
 /*!
  * \brief Calculates the next ping slot time.
  *
+ * \remark The slot time is computed in us from the last beacon, whose time
+ *         is kept as a SysTime with a ms resolution.
+ *
  * \param [IN] slotOffset The ping slot offset
  * \param [IN] pingPeriod The ping period
- * \param [OUT] timeOffset Time offset of the next slot, based on current time
+ * \param [OUT] slotTicks Time of the next slot in RTC ticks, see \ref TimerGetCurrentTicks
  *
  * \retval [true: ping slot found, false: no ping slot found]
  */
-static bool CalcNextSlotTime( uint16_t slotOffset, uint16_t pingPeriod, uint16_t pingNb, TimerTime_t* timeOffset )
+static bool CalcNextSlotTime( uint16_t slotOffset, uint16_t pingPeriod, uint16_t pingNb, TimerTicks_t* slotTicks )
 {
     uint8_t currentPingSlot = 0;
-    TimerTime_t slotTime = 0;
+    uint64_t slotTime = 0;
+    uint64_t elapsedTime = 0;
+    uint64_t slotLimit = 0;
+    uint64_t wakeupTime = ( uint64_t )Radio.GetWakeupTime( ) * 1000;
+    TimerTicks_t currentTicks = TimerGetCurrentTicks( );
     TimerTime_t currentTime = TimerGetCurrentTime( );
+    TimerTime_t beaconPeriodStart = 0;
 
-    // Calculate the point in time of the last beacon even if we missed it
-    slotTime = ( ( currentTime - SysTimeToMs( Ctx.BeaconCtx.LastBeaconRx ) ) % CLASSB_BEACON_INTERVAL );
-    slotTime = currentTime - slotTime;
+    // Calculate the time elapsed since the last beacon even if we missed it
+    elapsedTime = ( currentTime - SysTimeToMs( Ctx->BeaconCtx.LastBeaconRx ) ) % CLASSB_BEACON_INTERVAL;
+    beaconPeriodStart = currentTime - ( TimerTime_t )elapsedTime;
+    elapsedTime *= 1000;
 
     // Add the reserved time and the ping offset
-    slotTime += CLASSB_BEACON_RESERVED;
-    slotTime += slotOffset * CLASSB_PING_SLOT_WINDOW;
+    slotTime = ( uint64_t )CLASSB_BEACON_RESERVED * 1000;
+    slotTime += ( uint64_t )slotOffset * CLASSB_PING_SLOT_WINDOW * 1000;
 
-    if( slotTime < currentTime )
+    if( slotTime < elapsedTime )
     {
-        currentPingSlot = ( ( currentTime - slotTime ) /
-                          ( pingPeriod * CLASSB_PING_SLOT_WINDOW ) ) + 1;
-        slotTime += ( ( TimerTime_t )( currentPingSlot * pingPeriod ) *
-                    CLASSB_PING_SLOT_WINDOW );
+        currentPingSlot = ( ( elapsedTime - slotTime ) /
+                          ( ( uint64_t )pingPeriod * CLASSB_PING_SLOT_WINDOW * 1000 ) ) + 1;
+        slotTime += ( ( uint64_t )currentPingSlot * pingPeriod *
+                    CLASSB_PING_SLOT_WINDOW * 1000 );
     }
 
     if( currentPingSlot < pingNb )
     {
-        if( slotTime <= ( SysTimeToMs( Ctx.BeaconCtx.NextBeaconRx ) - CLASSB_BEACON_GUARD - CLASSB_PING_SLOT_WINDOW ) )
+        slotLimit = ( TimerTime_t )( SysTimeToMs( Ctx->BeaconCtx.NextBeaconRx ) - CLASSB_BEACON_GUARD - CLASSB_PING_SLOT_WINDOW - beaconPeriodStart );
+        if( slotTime <= ( slotLimit * 1000 ) )
         {
             // Calculate the relative ping slot time
-            slotTime -= currentTime;
-            slotTime -= Radio.GetWakeupTime( );
-            slotTime = TimerTempCompensation( slotTime, Ctx.BeaconCtx.Temperature );
-            *timeOffset = slotTime;
+            slotTime -= elapsedTime;
+            slotTime = ( slotTime > wakeupTime ) ? ( slotTime - wakeupTime ) : 0;
+            // The compensation is a ratio, it applies to a period in us
+            slotTime = TimerTempCompensation( ( TimerTime_t )slotTime, Ctx->BeaconCtx.Temperature );
+            *slotTicks = currentTicks + TimerUs2Ticks( slotTime );
             return true;
         }
     }
     return false;
 }
 
+/*!
+ * \brief Applies the reception window offset to a slot time
+ *
+ * \remark A negative offset isn't applied to a slot too close to be opened
+ *         earlier.
+ *
+ * \param [IN] slotTicks    Time of the slot in RTC ticks
+ * \param [IN] windowOffset Window offset computed by the region [us]
+ *
+ * \retval slotTicks Time of the reception window in RTC ticks
+ */
+static TimerTicks_t ApplyWindowOffset( TimerTicks_t slotTicks, int32_t windowOffset )
+{
+    TimerTicks_t offsetTicks = 0;
+
+    if( windowOffset >= 0 )
+    {
+        return slotTicks + TimerUs2Ticks( windowOffset );
+    }
+
+    offsetTicks = TimerUs2Ticks( -( int64_t )windowOffset );
+    if( slotTicks > ( TimerGetCurrentTicks( ) + offsetTicks ) )
+    {
+        return slotTicks - offsetTicks;
+    }
+    return slotTicks;
+}
+
 /*!
  * \brief Calculates CRC's of the beacon frame
  *
@@ -455,73 +507,73 @@ static void InitClassB( void )
     PhyParam_t phyParam;
 
     // Init events
-    LoRaMacClassBEvents.Value = 0;
+    Ctx->Events.Value = 0;
 
     // Init variables to default
-    memset1( ( uint8_t* ) &NvmCtx, 0, sizeof( LoRaMacClassBNvmCtx_t ) );
-    memset1( ( uint8_t* ) &Ctx.PingSlotCtx, 0, sizeof( PingSlotContext_t ) );
-    memset1( ( uint8_t* ) &Ctx.BeaconCtx, 0, sizeof( BeaconContext_t ) );
+    memset1( ( uint8_t* ) Ctx->NvmCtx, 0, sizeof( LoRaMacClassBNvmCtx_t ) );
+    memset1( ( uint8_t* ) &Ctx->PingSlotCtx, 0, sizeof( PingSlotContext_t ) );
+    memset1( ( uint8_t* ) &Ctx->BeaconCtx, 0, sizeof( BeaconContext_t ) );
 
     // Setup default temperature
-    Ctx.BeaconCtx.Temperature = 25.0;
-    GetTemperatureLevel( &Ctx.LoRaMacClassBCallbacks, &Ctx.BeaconCtx );
+    Ctx->BeaconCtx.Temperature = 25.0;
+    GetTemperatureLevel( &Ctx->LoRaMacClassBCallbacks, &Ctx->BeaconCtx );
 
     // Setup default ping slot datarate
     getPhy.Attribute = PHY_PING_SLOT_CHANNEL_DR;
-    phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
-    Ctx.NvmCtx->PingSlotCtx.Datarate = (int8_t)( phyParam.Value );
+    phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+    Ctx->NvmCtx->PingSlotCtx.Datarate = (int8_t)( phyParam.Value );
 
     // Setup default states
-    Ctx.BeaconState = BEACON_STATE_ACQUISITION;
-    Ctx.PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
-    Ctx.MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+    Ctx->BeaconState = BEACON_STATE_ACQUISITION;
+    Ctx->PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+    Ctx->MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
 }
 
 static void InitClassBDefaults( void )
 {
     // This function shall reset the Class B settings to default,
     // but should keep important configurations
-    LoRaMacClassBBeaconNvmCtx_t beaconCtx = Ctx.NvmCtx->BeaconCtx;
-    LoRaMacClassBPingSlotNvmCtx_t pingSlotCtx = Ctx.NvmCtx->PingSlotCtx;
+    LoRaMacClassBBeaconNvmCtx_t beaconCtx = Ctx->NvmCtx->BeaconCtx;
+    LoRaMacClassBPingSlotNvmCtx_t pingSlotCtx = Ctx->NvmCtx->PingSlotCtx;
 
     InitClassB( );
 
     // Parameters from BeaconFreqReq
-    Ctx.NvmCtx->BeaconCtx.Frequency = beaconCtx.Frequency;
-    Ctx.NvmCtx->BeaconCtx.Ctrl.CustomFreq = beaconCtx.Ctrl.CustomFreq;
+    Ctx->NvmCtx->BeaconCtx.Frequency = beaconCtx.Frequency;
+    Ctx->NvmCtx->BeaconCtx.Ctrl.CustomFreq = beaconCtx.Ctrl.CustomFreq;
 
     // Parameters from PingSlotChannelReq
-    Ctx.NvmCtx->PingSlotCtx.Ctrl.CustomFreq = pingSlotCtx.Ctrl.CustomFreq;
-    Ctx.NvmCtx->PingSlotCtx.Frequency = pingSlotCtx.Frequency;
-    Ctx.NvmCtx->PingSlotCtx.Datarate = pingSlotCtx.Datarate;
+    Ctx->NvmCtx->PingSlotCtx.Ctrl.CustomFreq = pingSlotCtx.Ctrl.CustomFreq;
+    Ctx->NvmCtx->PingSlotCtx.Frequency = pingSlotCtx.Frequency;
+    Ctx->NvmCtx->PingSlotCtx.Datarate = pingSlotCtx.Datarate;
 }
 
 static void EnlargeWindowTimeout( void )
 {
     // Update beacon movement
-    Ctx.BeaconCtx.BeaconWindowMovement *= CLASSB_WINDOW_MOVE_EXPANSION_FACTOR;
-    if( Ctx.BeaconCtx.BeaconWindowMovement > CLASSB_WINDOW_MOVE_EXPANSION_MAX )
+    Ctx->BeaconCtx.BeaconWindowMovement *= CLASSB_WINDOW_MOVE_EXPANSION_FACTOR;
+    if( Ctx->BeaconCtx.BeaconWindowMovement > CLASSB_WINDOW_MOVE_EXPANSION_MAX )
     {
-        Ctx.BeaconCtx.BeaconWindowMovement = CLASSB_WINDOW_MOVE_EXPANSION_MAX;
+        Ctx->BeaconCtx.BeaconWindowMovement = CLASSB_WINDOW_MOVE_EXPANSION_MAX;
     }
     // Update symbol timeout
-    Ctx.BeaconCtx.SymbolTimeout *= CLASSB_BEACON_SYMBOL_TO_EXPANSION_FACTOR;
-    if( Ctx.BeaconCtx.SymbolTimeout > CLASSB_BEACON_SYMBOL_TO_EXPANSION_MAX )
+    Ctx->BeaconCtx.SymbolTimeout *= CLASSB_BEACON_SYMBOL_TO_EXPANSION_FACTOR;
+    if( Ctx->BeaconCtx.SymbolTimeout > CLASSB_BEACON_SYMBOL_TO_EXPANSION_MAX )
     {
-        Ctx.BeaconCtx.SymbolTimeout = CLASSB_BEACON_SYMBOL_TO_EXPANSION_MAX;
+        Ctx->BeaconCtx.SymbolTimeout = CLASSB_BEACON_SYMBOL_TO_EXPANSION_MAX;
     }
-    Ctx.PingSlotCtx.SymbolTimeout *= CLASSB_BEACON_SYMBOL_TO_EXPANSION_FACTOR;
-    if( Ctx.PingSlotCtx.SymbolTimeout > CLASSB_PING_SLOT_SYMBOL_TO_EXPANSION_MAX )
+    Ctx->PingSlotCtx.SymbolTimeout *= CLASSB_BEACON_SYMBOL_TO_EXPANSION_FACTOR;
+    if( Ctx->PingSlotCtx.SymbolTimeout > CLASSB_PING_SLOT_SYMBOL_TO_EXPANSION_MAX )
     {
-        Ctx.PingSlotCtx.SymbolTimeout = CLASSB_PING_SLOT_SYMBOL_TO_EXPANSION_MAX;
+        Ctx->PingSlotCtx.SymbolTimeout = CLASSB_PING_SLOT_SYMBOL_TO_EXPANSION_MAX;
     }
 }
 
 static void ResetWindowTimeout( void )
 {
-    Ctx.BeaconCtx.SymbolTimeout = CLASSB_BEACON_SYMBOL_TO_DEFAULT;
-    Ctx.PingSlotCtx.SymbolTimeout = CLASSB_BEACON_SYMBOL_TO_DEFAULT;
-    Ctx.BeaconCtx.BeaconWindowMovement  = CLASSB_WINDOW_MOVE_DEFAULT;
+    Ctx->BeaconCtx.SymbolTimeout = CLASSB_BEACON_SYMBOL_TO_DEFAULT;
+    Ctx->PingSlotCtx.SymbolTimeout = CLASSB_BEACON_SYMBOL_TO_DEFAULT;
+    Ctx->BeaconCtx.BeaconWindowMovement  = CLASSB_WINDOW_MOVE_DEFAULT;
 }
 
 static TimerTime_t CalcDelayForNextBeacon( TimerTime_t currentTime, TimerTime_t lastBeaconRx )
@@ -535,15 +587,15 @@ static TimerTime_t CalcDelayForNextBeacon( TimerTime_t currentTime, TimerTime_t
 
 static void IndicateBeaconStatus( LoRaMacEventInfoStatus_t status )
 {
-    if( Ctx.BeaconCtx.Ctrl.ResumeBeaconing == 0 )
+    if( Ctx->BeaconCtx.Ctrl.ResumeBeaconing == 0 )
     {
-        Ctx.LoRaMacClassBParams.MlmeIndication->MlmeIndication = MLME_BEACON;
-        Ctx.LoRaMacClassBParams.MlmeIndication->Status = status;
-        Ctx.LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeInd = 1;
+        Ctx->LoRaMacClassBParams.MlmeIndication->MlmeIndication = MLME_BEACON;
+        Ctx->LoRaMacClassBParams.MlmeIndication->Status = status;
+        Ctx->LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeInd = 1;
 
-        Ctx.LoRaMacClassBParams.LoRaMacFlags->Bits.MacDone = 1;
+        Ctx->LoRaMacClassBParams.LoRaMacFlags->Bits.MacDone = 1;
     }
-    Ctx.BeaconCtx.Ctrl.ResumeBeaconing = 0;
+    Ctx->BeaconCtx.Ctrl.ResumeBeaconing = 0;
 }
 
 static TimerTime_t ApplyGuardTime( TimerTime_t beaconEventTime )
@@ -564,18 +616,18 @@ static TimerTime_t UpdateBeaconState( LoRaMacEventInfoStatus_t status,
     TimerTime_t beaconEventTime = 0;
 
     // Calculate the next beacon RX time
-    beaconEventTime = CalcDelayForNextBeacon( currentTime, SysTimeToMs( Ctx.BeaconCtx.LastBeaconRx ) );
-    Ctx.BeaconCtx.NextBeaconRx = SysTimeFromMs( currentTime + beaconEventTime );
+    beaconEventTime = CalcDelayForNextBeacon( currentTime, SysTimeToMs( Ctx->BeaconCtx.LastBeaconRx ) );
+    Ctx->BeaconCtx.NextBeaconRx = SysTimeFromMs( currentTime + beaconEventTime );
 
     // Take temperature compensation into account
-    beaconEventTime = TimerTempCompensation( beaconEventTime, Ctx.BeaconCtx.Temperature );
+    beaconEventTime = TimerTempCompensation( beaconEventTime, Ctx->BeaconCtx.Temperature );
 
     // Move the window
     if( beaconEventTime > windowMovement )
     {
         beaconEventTime -= windowMovement;
     }
-    Ctx.BeaconCtx.NextBeaconRxAdjusted = currentTime + beaconEventTime;
+    Ctx->BeaconCtx.NextBeaconRxAdjusted = currentTime + beaconEventTime;
 
     // Start the RX slot state machine for ping and multicast slots
     LoRaMacClassBStartRxSlots( );
@@ -602,9 +654,9 @@ static uint16_t CalcPingPeriod( uint8_t pingNb )
  */
 static void NvmContextChange( void )
 {
-    if( Ctx.LoRaMacClassBNvmEvent != NULL )
+    if( Ctx->LoRaMacClassBNvmEvent != NULL )
     {
-        Ctx.LoRaMacClassBNvmEvent( );
+        Ctx->LoRaMacClassBNvmEvent( );
     }
 }
 
@@ -614,21 +666,21 @@ void LoRaMacClassBInit( LoRaMacClassBParams_t *classBParams, LoRaMacClassBCallba
 {
 #ifdef LORAMAC_CLASSB_ENABLED
     // Store callbacks
-    Ctx.LoRaMacClassBCallbacks = *callbacks;
+    Ctx->LoRaMacClassBCallbacks = *callbacks;
 
     // Store parameter pointers
-    Ctx.LoRaMacClassBParams = *classBParams;
-
-    // Assign non-volatile context
-    Ctx.NvmCtx = &NvmCtx;
+    Ctx->LoRaMacClassBParams = *classBParams;
 
     // Assign callback
-    Ctx.LoRaMacClassBNvmEvent = classBNvmCtxChanged;
+    Ctx->LoRaMacClassBNvmEvent = classBNvmCtxChanged;
 
     // Initialize timers
-    TimerInit( &Ctx.BeaconTimer, LoRaMacClassBBeaconTimerEvent );
-    TimerInit( &Ctx.PingSlotTimer, LoRaMacClassBPingSlotTimerEvent );
-    TimerInit( &Ctx.MulticastSlotTimer, LoRaMacClassBMulticastSlotTimerEvent );
+    TimerInit( &Ctx->BeaconTimer, LoRaMacClassBBeaconTimerEvent );
+    TimerInit( &Ctx->PingSlotTimer, LoRaMacClassBPingSlotTimerEvent );
+    TimerInit( &Ctx->MulticastSlotTimer, LoRaMacClassBMulticastSlotTimerEvent );
+    TimerSetContext( &Ctx->BeaconTimer, Ctx );
+    TimerSetContext( &Ctx->PingSlotTimer, Ctx );
+    TimerSetContext( &Ctx->MulticastSlotTimer, Ctx );
 
     InitClassB( );
 #endif // LORAMAC_CLASSB_ENABLED
@@ -640,7 +692,7 @@ bool LoRaMacClassBRestoreNvmCtx( void* classBNvmCtx )
     // Restore module context
     if( classBNvmCtx != NULL )
     {
-        memcpy1( ( uint8_t* ) &NvmCtx, ( uint8_t* ) classBNvmCtx, sizeof( NvmCtx ) );
+        memcpy1( ( uint8_t* ) Ctx->NvmCtx, ( uint8_t* ) classBNvmCtx, sizeof( LoRaMacClassBNvmCtx_t ) );
         return true;
     }
     else
@@ -655,14 +707,40 @@ bool LoRaMacClassBRestoreNvmCtx( void* classBNvmCtx )
 void* LoRaMacClassBGetNvmCtx( size_t* classBNvmCtxSize )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    *classBNvmCtxSize = sizeof( NvmCtx );
-    return &NvmCtx;
+    *classBNvmCtxSize = sizeof( LoRaMacClassBNvmCtx_t );
+    return Ctx->NvmCtx;
 #else
     *classBNvmCtxSize = 0;
     return NULL;
 #endif // LORAMAC_CLASSB_ENABLED
 }
 
+void* LoRaMacClassBGetCtx( size_t* classBCtxSize )
+{
+#ifdef LORAMAC_CLASSB_ENABLED
+    *classBCtxSize = sizeof( LoRaMacClassBCtx_t );
+    return Ctx;
+#else
+    *classBCtxSize = 0;
+    return NULL;
+#endif // LORAMAC_CLASSB_ENABLED
+}
+
+void LoRaMacClassBBindCtxs( void* classBCtx, void* classBNvmCtx )
+{
+#ifdef LORAMAC_CLASSB_ENABLED
+    if( ( classBCtx != NULL ) && ( classBNvmCtx != NULL ) )
+    {
+        Ctx = ( LoRaMacClassBCtx_t* )classBCtx;
+        Ctx->NvmCtx = ( LoRaMacClassBNvmCtx_t* )classBNvmCtx;
+    }
+    else
+    {
+        Ctx = &DefaultCtx;
+    }
+#endif // LORAMAC_CLASSB_ENABLED
+}
+
 void LoRaMacClassBSetBeaconState( BeaconState_t beaconState )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
@@ -670,22 +748,22 @@ void LoRaMacClassBSetBeaconState( BeaconState_t beaconState )
     {
         // If the MAC has received a time reference for the beacon,
         // apply the state BEACON_STATE_ACQUISITION_BY_TIME.
-        if( ( Ctx.BeaconCtx.Ctrl.BeaconDelaySet == 1 ) &&
+        if( ( Ctx->BeaconCtx.Ctrl.BeaconDelaySet == 1 ) &&
             ( LoRaMacClassBIsAcquisitionPending( ) == false ) )
         {
-            Ctx.BeaconState = BEACON_STATE_ACQUISITION_BY_TIME;
+            Ctx->BeaconState = BEACON_STATE_ACQUISITION_BY_TIME;
         }
         else
         {
-           Ctx.BeaconState = beaconState;
+           Ctx->BeaconState = beaconState;
         }
     }
     else
     {
-        if( ( Ctx.BeaconState != BEACON_STATE_ACQUISITION ) &&
-            ( Ctx.BeaconState != BEACON_STATE_ACQUISITION_BY_TIME ) )
+        if( ( Ctx->BeaconState != BEACON_STATE_ACQUISITION ) &&
+            ( Ctx->BeaconState != BEACON_STATE_ACQUISITION_BY_TIME ) )
         {
-            Ctx.BeaconState = beaconState;
+            Ctx->BeaconState = beaconState;
         }
     }
 #endif // LORAMAC_CLASSB_ENABLED
@@ -694,21 +772,21 @@ void LoRaMacClassBSetBeaconState( BeaconState_t beaconState )
 void LoRaMacClassBSetPingSlotState( PingSlotState_t pingSlotState )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    Ctx.PingSlotState = pingSlotState;
+    Ctx->PingSlotState = pingSlotState;
 #endif // LORAMAC_CLASSB_ENABLED
 }
 
 void LoRaMacClassBSetMulticastSlotState( PingSlotState_t multicastSlotState )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    Ctx.MulticastSlotState = multicastSlotState;
+    Ctx->MulticastSlotState = multicastSlotState;
 #endif // LORAMAC_CLASSB_ENABLED
 }
 
 bool LoRaMacClassBIsAcquisitionInProgress( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.BeaconState == BEACON_STATE_ACQUISITION_BY_TIME )
+    if( Ctx->BeaconState == BEACON_STATE_ACQUISITION_BY_TIME )
     {
         // In this case the acquisition is in progress, as the MAC has
         // a time reference for the next beacon RX.
@@ -729,13 +807,17 @@ bool LoRaMacClassBIsAcquisitionInProgress( void )
 void LoRaMacClassBBeaconTimerEvent( void* context )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    Ctx.BeaconCtx.TimeStamp = TimerGetCurrentTime( );
-    TimerStop( &Ctx.BeaconTimer );
-    LoRaMacClassBEvents.Events.Beacon = 1;
+    // The timer may belong to a LoRaMac instance which isn't selected
+    LoRaMacClassBCtx_t* ctx = ( context != NULL ) ? ( LoRaMacClassBCtx_t* )context : Ctx;
+
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_CLASS_B_BEACON }, 1, NULL, 0 );
+    ctx->BeaconCtx.TimeStamp = TimerGetCurrentTime( );
+    TimerStop( &ctx->BeaconTimer );
+    ctx->Events.Events.Beacon = 1;
 
-    if( Ctx.LoRaMacClassBCallbacks.MacProcessNotify != NULL )
+    if( ctx->LoRaMacClassBCallbacks.MacProcessNotify != NULL )
     {
-        Ctx.LoRaMacClassBCallbacks.MacProcessNotify( );
+        ctx->LoRaMacClassBCallbacks.MacProcessNotify( );
     }
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -745,50 +827,50 @@ static void LoRaMacClassBProcessBeacon( void )
 {
     bool activateTimer = false;
     TimerTime_t beaconEventTime = 1;
-    TimerTime_t currentTime = Ctx.BeaconCtx.TimeStamp;
+    TimerTime_t currentTime = Ctx->BeaconCtx.TimeStamp;
 
     // Beacon state machine
-    switch( Ctx.BeaconState )
+    switch( Ctx->BeaconState )
     {
         case BEACON_STATE_ACQUISITION_BY_TIME:
         {
             activateTimer = true;
 
-            if( Ctx.BeaconCtx.Ctrl.AcquisitionPending == 1 )
+            if( Ctx->BeaconCtx.Ctrl.AcquisitionPending == 1 )
             {
                 Radio.Sleep();
-                Ctx.BeaconState = BEACON_STATE_LOST;
+                Ctx->BeaconState = BEACON_STATE_LOST;
             }
             else
             {
                 // Default symbol timeouts
                 ResetWindowTimeout( );
 
-                if( Ctx.BeaconCtx.Ctrl.BeaconDelaySet == 1 )
+                if( Ctx->BeaconCtx.Ctrl.BeaconDelaySet == 1 )
                 {
-                    if( Ctx.BeaconCtx.BeaconTimingDelay > 0 )
+                    if( Ctx->BeaconCtx.BeaconTimingDelay > 0 )
                     {
-                        if( SysTimeToMs( Ctx.BeaconCtx.NextBeaconRx ) > currentTime )
+                        if( SysTimeToMs( Ctx->BeaconCtx.NextBeaconRx ) > currentTime )
                         {
-                            beaconEventTime = TimerTempCompensation( SysTimeToMs( Ctx.BeaconCtx.NextBeaconRx ) - currentTime, Ctx.BeaconCtx.Temperature );
+                            beaconEventTime = TimerTempCompensation( SysTimeToMs( Ctx->BeaconCtx.NextBeaconRx ) - currentTime, Ctx->BeaconCtx.Temperature );
                         }
                         else
                         {
                             // Reset status provides by BeaconTimingAns
-                            Ctx.BeaconCtx.Ctrl.BeaconDelaySet = 0;
-                            Ctx.BeaconCtx.Ctrl.BeaconChannelSet = 0;
-                            Ctx.BeaconState = BEACON_STATE_ACQUISITION;
+                            Ctx->BeaconCtx.Ctrl.BeaconDelaySet = 0;
+                            Ctx->BeaconCtx.Ctrl.BeaconChannelSet = 0;
+                            Ctx->BeaconState = BEACON_STATE_ACQUISITION;
                         }
-                        Ctx.BeaconCtx.BeaconTimingDelay = 0;
+                        Ctx->BeaconCtx.BeaconTimingDelay = 0;
                     }
                     else
                     {
                         activateTimer = false;
 
                         // Reset status provides by BeaconTimingAns
-                        Ctx.BeaconCtx.Ctrl.BeaconDelaySet = 0;
+                        Ctx->BeaconCtx.Ctrl.BeaconDelaySet = 0;
                         // Set the node into acquisition mode
-                        Ctx.BeaconCtx.Ctrl.AcquisitionPending = 1;
+                        Ctx->BeaconCtx.Ctrl.AcquisitionPending = 1;
 
                         // Don't use the default channel. We know on which
                         // channel the next beacon will be transmitted
@@ -797,11 +879,11 @@ static void LoRaMacClassBProcessBeacon( void )
                 }
                 else
                 {
-                    Ctx.BeaconCtx.NextBeaconRx.Seconds = 0;
-                    Ctx.BeaconCtx.NextBeaconRx.SubSeconds = 0;
-                    Ctx.BeaconCtx.BeaconTimingDelay = 0;
+                    Ctx->BeaconCtx.NextBeaconRx.Seconds = 0;
+                    Ctx->BeaconCtx.NextBeaconRx.SubSeconds = 0;
+                    Ctx->BeaconCtx.BeaconTimingDelay = 0;
 
-                    Ctx.BeaconState = BEACON_STATE_ACQUISITION;
+                    Ctx->BeaconState = BEACON_STATE_ACQUISITION;
                 }
             }
             break;
@@ -810,17 +892,17 @@ static void LoRaMacClassBProcessBeacon( void )
         {
             activateTimer = true;
 
-            if( Ctx.BeaconCtx.Ctrl.AcquisitionPending == 1 )
+            if( Ctx->BeaconCtx.Ctrl.AcquisitionPending == 1 )
             {
                 Radio.Sleep();
-                Ctx.BeaconState = BEACON_STATE_LOST;
+                Ctx->BeaconState = BEACON_STATE_LOST;
             }
             else
             {
                 // Default symbol timeouts
                 ResetWindowTimeout( );
 
-                Ctx.BeaconCtx.Ctrl.AcquisitionPending = 1;
+                Ctx->BeaconCtx.Ctrl.AcquisitionPending = 1;
                 beaconEventTime = CLASSB_BEACON_INTERVAL;
 
                 // Start the beacon acquisition. When the MAC has received a beacon in function
@@ -835,14 +917,14 @@ static void LoRaMacClassBProcessBeacon( void )
         case BEACON_STATE_TIMEOUT:
         {
             // We have to update the beacon time, since we missed a beacon
-            Ctx.BeaconCtx.BeaconTime.Seconds += ( CLASSB_BEACON_INTERVAL / 1000 );
-            Ctx.BeaconCtx.BeaconTime.SubSeconds = 0;
+            Ctx->BeaconCtx.BeaconTime.Seconds += ( CLASSB_BEACON_INTERVAL / 1000 );
+            Ctx->BeaconCtx.BeaconTime.SubSeconds = 0;
 
             // Enlarge window timeouts to increase the chance to receive the next beacon
             EnlargeWindowTimeout( );
 
             // Setup next state
-            Ctx.BeaconState = BEACON_STATE_REACQUISITION;
+            Ctx->BeaconState = BEACON_STATE_REACQUISITION;
         }
             // Intentional fall through
         case BEACON_STATE_REACQUISITION:
@@ -850,21 +932,21 @@ static void LoRaMacClassBProcessBeacon( void )
             activateTimer = true;
 
             // The beacon is no longer acquired
-            Ctx.BeaconCtx.Ctrl.BeaconAcquired = 0;
+            Ctx->BeaconCtx.Ctrl.BeaconAcquired = 0;
 
             // Verify if the maximum beacon less period has been elapsed
-            if( ( currentTime - SysTimeToMs( Ctx.BeaconCtx.LastBeaconRx ) ) > CLASSB_MAX_BEACON_LESS_PERIOD )
+            if( ( currentTime - SysTimeToMs( Ctx->BeaconCtx.LastBeaconRx ) ) > CLASSB_MAX_BEACON_LESS_PERIOD )
             {
-                Ctx.BeaconState = BEACON_STATE_LOST;
+                Ctx->BeaconState = BEACON_STATE_LOST;
             }
             else
             {
                 // Handle beacon miss
                 beaconEventTime = UpdateBeaconState( LORAMAC_EVENT_INFO_STATUS_BEACON_LOST,
-                                                     Ctx.BeaconCtx.BeaconWindowMovement, currentTime );
+                                                     Ctx->BeaconCtx.BeaconWindowMovement, currentTime );
 
                 // Setup next state
-                Ctx.BeaconState = BEACON_STATE_IDLE;
+                Ctx->BeaconState = BEACON_STATE_IDLE;
             }
             break;
         }
@@ -873,49 +955,49 @@ static void LoRaMacClassBProcessBeacon( void )
             activateTimer = true;
 
             // We have received a beacon. Acquisition is no longer pending.
-            Ctx.BeaconCtx.Ctrl.AcquisitionPending = 0;
+            Ctx->BeaconCtx.Ctrl.AcquisitionPending = 0;
 
             // Handle beacon reception
             beaconEventTime = UpdateBeaconState( LORAMAC_EVENT_INFO_STATUS_BEACON_LOCKED,
                                                  0, currentTime );
 
             // Setup the MLME confirm for the MLME_BEACON_ACQUISITION
-            if( Ctx.LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeReq == 1 )
+            if( Ctx->LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeReq == 1 )
             {
                 if( LoRaMacConfirmQueueIsCmdActive( MLME_BEACON_ACQUISITION ) == true )
                 {
                     LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_BEACON_ACQUISITION );
-                    Ctx.LoRaMacClassBParams.MlmeConfirm->TxTimeOnAir = 0;
+                    Ctx->LoRaMacClassBParams.MlmeConfirm->TxTimeOnAir = 0;
                 }
             }
 
             // Setup next state
-            Ctx.BeaconState = BEACON_STATE_IDLE;
+            Ctx->BeaconState = BEACON_STATE_IDLE;
             break;
         }
         case BEACON_STATE_IDLE:
         {
             activateTimer = true;
-            GetTemperatureLevel( &Ctx.LoRaMacClassBCallbacks, &Ctx.BeaconCtx );
-            beaconEventTime = Ctx.BeaconCtx.NextBeaconRxAdjusted - Radio.GetWakeupTime( );
+            GetTemperatureLevel( &Ctx->LoRaMacClassBCallbacks, &Ctx->BeaconCtx );
+            beaconEventTime = Ctx->BeaconCtx.NextBeaconRxAdjusted - Radio.GetWakeupTime( );
             currentTime = TimerGetCurrentTime( );
 
             if( beaconEventTime > currentTime )
             {
-                Ctx.BeaconState = BEACON_STATE_GUARD;
+                Ctx->BeaconState = BEACON_STATE_GUARD;
                 beaconEventTime -= currentTime;
-                beaconEventTime = TimerTempCompensation( beaconEventTime, Ctx.BeaconCtx.Temperature );
+                beaconEventTime = TimerTempCompensation( beaconEventTime, Ctx->BeaconCtx.Temperature );
             }
             else
             {
-                Ctx.BeaconState = BEACON_STATE_REACQUISITION;
+                Ctx->BeaconState = BEACON_STATE_REACQUISITION;
                 beaconEventTime = 1;
             }
             break;
         }
         case BEACON_STATE_GUARD:
         {
-            Ctx.BeaconState = BEACON_STATE_RX;
+            Ctx->BeaconState = BEACON_STATE_RX;
 
             // Stop slot timers
             LoRaMacClassBStopRxSlots( );
@@ -928,7 +1010,7 @@ static void LoRaMacClassBProcessBeacon( void )
         case BEACON_STATE_LOST:
         {
             // Handle events
-            if( Ctx.LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeReq == 1 )
+            if( Ctx->LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeReq == 1 )
             {
                 if( LoRaMacConfirmQueueIsCmdActive( MLME_BEACON_ACQUISITION ) == true )
                 {
@@ -937,9 +1019,9 @@ static void LoRaMacClassBProcessBeacon( void )
             }
             else
             {
-                Ctx.LoRaMacClassBParams.MlmeIndication->MlmeIndication = MLME_BEACON_LOST;
-                Ctx.LoRaMacClassBParams.MlmeIndication->Status = LORAMAC_EVENT_INFO_STATUS_OK;
-                Ctx.LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeInd = 1;
+                Ctx->LoRaMacClassBParams.MlmeIndication->MlmeIndication = MLME_BEACON_LOST;
+                Ctx->LoRaMacClassBParams.MlmeIndication->Status = LORAMAC_EVENT_INFO_STATUS_OK;
+                Ctx->LoRaMacClassBParams.LoRaMacFlags->Bits.MlmeInd = 1;
             }
 
             // Stop slot timers
@@ -948,21 +1030,21 @@ static void LoRaMacClassBProcessBeacon( void )
             // Initialize default state for class b
             InitClassBDefaults( );
 
-            Ctx.LoRaMacClassBParams.LoRaMacFlags->Bits.MacDone = 1;
+            Ctx->LoRaMacClassBParams.LoRaMacFlags->Bits.MacDone = 1;
 
             break;
         }
         default:
         {
-            Ctx.BeaconState = BEACON_STATE_ACQUISITION;
+            Ctx->BeaconState = BEACON_STATE_ACQUISITION;
             break;
         }
     }
 
     if( activateTimer == true )
     {
-        TimerSetValue( &Ctx.BeaconTimer, beaconEventTime );
-        TimerStart( &Ctx.BeaconTimer );
+        TimerSetValue( &Ctx->BeaconTimer, beaconEventTime );
+        TimerStart( &Ctx->BeaconTimer );
     }
 }
 #endif // LORAMAC_CLASSB_ENABLED
@@ -970,11 +1052,15 @@ static void LoRaMacClassBProcessBeacon( void )
 void LoRaMacClassBPingSlotTimerEvent( void* context )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    LoRaMacClassBEvents.Events.PingSlot = 1;
+    // The timer may belong to a LoRaMac instance which isn't selected
+    LoRaMacClassBCtx_t* ctx = ( context != NULL ) ? ( LoRaMacClassBCtx_t* )context : Ctx;
 
-    if( Ctx.LoRaMacClassBCallbacks.MacProcessNotify != NULL )
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_CLASS_B_PING_SLOT }, 1, NULL, 0 );
+    ctx->Events.Events.PingSlot = 1;
+
+    if( ctx->LoRaMacClassBCallbacks.MacProcessNotify != NULL )
     {
-        Ctx.LoRaMacClassBCallbacks.MacProcessNotify( );
+        ctx->LoRaMacClassBCallbacks.MacProcessNotify( );
     }
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -983,76 +1069,77 @@ void LoRaMacClassBPingSlotTimerEvent( void* context )
 static void LoRaMacClassBProcessPingSlot( void )
 {
     static RxConfigParams_t pingSlotRxConfig;
-    TimerTime_t pingSlotTime = 0;
+    TimerTicks_t pingSlotTime = 0;
 
-    switch( Ctx.PingSlotState )
+    switch( Ctx->PingSlotState )
     {
         case PINGSLOT_STATE_CALC_PING_OFFSET:
         {
-            ComputePingOffset( Ctx.BeaconCtx.BeaconTime.Seconds,
-                               *Ctx.LoRaMacClassBParams.LoRaMacDevAddr,
-                               Ctx.NvmCtx->PingSlotCtx.PingPeriod,
-                               &( Ctx.PingSlotCtx.PingOffset ) );
-            Ctx.PingSlotState = PINGSLOT_STATE_SET_TIMER;
+            ComputePingOffset( Ctx->BeaconCtx.BeaconTime.Seconds,
+                               *Ctx->LoRaMacClassBParams.LoRaMacDevAddr,
+                               Ctx->NvmCtx->PingSlotCtx.PingPeriod,
+                               &( Ctx->PingSlotCtx.PingOffset ) );
+            Ctx->PingSlotState = PINGSLOT_STATE_SET_TIMER;
         }
             // Intentional fall through
         case PINGSLOT_STATE_SET_TIMER:
         {
-            if( CalcNextSlotTime( Ctx.PingSlotCtx.PingOffset, Ctx.NvmCtx->PingSlotCtx.PingPeriod, Ctx.NvmCtx->PingSlotCtx.PingNb, &pingSlotTime ) == true )
+            if( CalcNextSlotTime( Ctx->PingSlotCtx.PingOffset, Ctx->NvmCtx->PingSlotCtx.PingPeriod, Ctx->NvmCtx->PingSlotCtx.PingNb, &pingSlotTime ) == true )
             {
-                if( Ctx.BeaconCtx.Ctrl.BeaconAcquired == 1 )
+                if( Ctx->BeaconCtx.Ctrl.BeaconAcquired == 1 )
                 {
                     // Compute the symbol timeout. Apply it only, if the beacon is acquired
                     // Otherwise, take the enlargement of the symbols into account.
-                    RegionComputeRxWindowParameters( *Ctx.LoRaMacClassBParams.LoRaMacRegion,
-                                                     Ctx.NvmCtx->PingSlotCtx.Datarate,
-                                                     Ctx.LoRaMacClassBParams.LoRaMacParams->MinRxSymbols,
-                                                     Ctx.LoRaMacClassBParams.LoRaMacParams->SystemMaxRxError,
+                    RegionComputeRxWindowParameters( *Ctx->LoRaMacClassBParams.LoRaMacRegion,
+                                                     Ctx->NvmCtx->PingSlotCtx.Datarate,
+                                                     Ctx->LoRaMacClassBParams.LoRaMacParams->MinRxSymbols,
+                                                     Ctx->LoRaMacClassBParams.LoRaMacParams->SystemMaxRxError,
                                                      &pingSlotRxConfig );
-                    Ctx.PingSlotCtx.SymbolTimeout = pingSlotRxConfig.WindowTimeout;
+                    Ctx->PingSlotCtx.SymbolTimeout = pingSlotRxConfig.WindowTimeout;
 
-                    if( ( int32_t )pingSlotTime > pingSlotRxConfig.WindowOffset )
-                    {// Apply the window offset
-                        pingSlotTime += pingSlotRxConfig.WindowOffset;
-                    }
+                    // Apply the window offset
+                    pingSlotTime = ApplyWindowOffset( pingSlotTime, pingSlotRxConfig.WindowOffset );
                 }
 
                 // Start the timer if the ping slot time is in range
-                Ctx.PingSlotState = PINGSLOT_STATE_IDLE;
-                TimerSetValue( &Ctx.PingSlotTimer, pingSlotTime );
-                TimerStart( &Ctx.PingSlotTimer );
+                Ctx->PingSlotState = PINGSLOT_STATE_IDLE;
+                TimerStartAt( &Ctx->PingSlotTimer, pingSlotTime );
             }
             break;
         }
         case PINGSLOT_STATE_IDLE:
         {
-            uint32_t frequency = Ctx.NvmCtx->PingSlotCtx.Frequency;
+            uint32_t frequency = Ctx->NvmCtx->PingSlotCtx.Frequency;
 
             // Apply a custom frequency if the following bit is set
-            if( Ctx.NvmCtx->PingSlotCtx.Ctrl.CustomFreq == 0 )
+            if( Ctx->NvmCtx->PingSlotCtx.Ctrl.CustomFreq == 0 )
             {
                 // Restore floor plan
-                frequency = CalcDownlinkChannelAndFrequency( *Ctx.LoRaMacClassBParams.LoRaMacDevAddr, Ctx.BeaconCtx.BeaconTime.Seconds,
+                frequency = CalcDownlinkChannelAndFrequency( *Ctx->LoRaMacClassBParams.LoRaMacDevAddr, Ctx->BeaconCtx.BeaconTime.Seconds,
                                                              CLASSB_BEACON_INTERVAL, false );
             }
 
             // Open the ping slot window only, if there is no multicast ping slot
             // open. Multicast ping slots have always priority
-            if( Ctx.MulticastSlotState != PINGSLOT_STATE_RX )
+            if( Ctx->MulticastSlotState != PINGSLOT_STATE_RX )
             {
-                Ctx.PingSlotState = PINGSLOT_STATE_RX;
+                Ctx->PingSlotState = PINGSLOT_STATE_RX;
 
-                pingSlotRxConfig.Datarate = Ctx.NvmCtx->PingSlotCtx.Datarate;
-                pingSlotRxConfig.DownlinkDwellTime = Ctx.LoRaMacClassBParams.LoRaMacParams->DownlinkDwellTime;
+                pingSlotRxConfig.Datarate = Ctx->NvmCtx->PingSlotCtx.Datarate;
+                pingSlotRxConfig.DownlinkDwellTime = Ctx->LoRaMacClassBParams.LoRaMacParams->DownlinkDwellTime;
                 pingSlotRxConfig.Frequency = frequency;
                 pingSlotRxConfig.RxContinuous = false;
                 pingSlotRxConfig.RxSlot = RX_SLOT_WIN_CLASS_B_PING_SLOT;
 
-                RegionRxConfig( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &pingSlotRxConfig, ( int8_t* )&Ctx.LoRaMacClassBParams.McpsIndication->RxDatarate );
+                if( Ctx->LoRaMacClassBCallbacks.RadioRxStart != NULL )
+                {
+                    Ctx->LoRaMacClassBCallbacks.RadioRxStart( );
+                }
+                RegionRxConfig( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &pingSlotRxConfig, ( int8_t* )&Ctx->LoRaMacClassBParams.McpsIndication->RxDatarate );
 
                 if( pingSlotRxConfig.RxContinuous == false )
                 {
-                    Radio.Rx( Ctx.LoRaMacClassBParams.LoRaMacParams->MaxRxWindow );
+                    Radio.Rx( Ctx->LoRaMacClassBParams.LoRaMacParams->MaxRxWindow );
                 }
                 else
                 {
@@ -1062,15 +1149,15 @@ static void LoRaMacClassBProcessPingSlot( void )
             else
             {
                 // Multicast slots have priority. Skip Rx
-                Ctx.PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
-                TimerSetValue( &Ctx.PingSlotTimer, CLASSB_PING_SLOT_WINDOW );
-                TimerStart( &Ctx.PingSlotTimer );
+                Ctx->PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+                TimerSetValue( &Ctx->PingSlotTimer, CLASSB_PING_SLOT_WINDOW );
+                TimerStart( &Ctx->PingSlotTimer );
             }
             break;
         }
         default:
         {
-            Ctx.PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+            Ctx->PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
             break;
         }
     }
@@ -1080,11 +1167,15 @@ static void LoRaMacClassBProcessPingSlot( void )
 void LoRaMacClassBMulticastSlotTimerEvent( void* context )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    LoRaMacClassBEvents.Events.MulticastSlot = 1;
+    // The timer may belong to a LoRaMac instance which isn't selected
+    LoRaMacClassBCtx_t* ctx = ( context != NULL ) ? ( LoRaMacClassBCtx_t* )context : Ctx;
+
+    EVENT_LOG_RECORD( EVENT_LOG_TIMER, ( uint8_t[] ){ LORAMAC_DEADLINE_CLASS_B_MULTICAST_SLOT }, 1, NULL, 0 );
+    ctx->Events.Events.MulticastSlot = 1;
 
-    if( Ctx.LoRaMacClassBCallbacks.MacProcessNotify != NULL )
+    if( ctx->LoRaMacClassBCallbacks.MacProcessNotify != NULL )
     {
-        Ctx.LoRaMacClassBCallbacks.MacProcessNotify( );
+        ctx->LoRaMacClassBCallbacks.MacProcessNotify( );
     }
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -1093,9 +1184,9 @@ void LoRaMacClassBMulticastSlotTimerEvent( void* context )
 static void LoRaMacClassBProcessMulticastSlot( void )
 {
     static RxConfigParams_t multicastSlotRxConfig;
-    TimerTime_t multicastSlotTime = 0;
-    TimerTime_t slotTime = 0;
-    MulticastCtx_t *cur = Ctx.LoRaMacClassBParams.MulticastChannels;
+    TimerTicks_t multicastSlotTime = 0;
+    TimerTicks_t slotTime = 0;
+    MulticastCtx_t *cur = Ctx->LoRaMacClassBParams.MulticastChannels;
 
 
     if( cur == NULL )
@@ -1103,32 +1194,32 @@ static void LoRaMacClassBProcessMulticastSlot( void )
         return;
     }
 
-    if( Ctx.MulticastSlotState == PINGSLOT_STATE_RX )
+    if( Ctx->MulticastSlotState == PINGSLOT_STATE_RX )
     {
         // A multicast slot is already open
         return;
     }
 
-    switch( Ctx.MulticastSlotState )
+    switch( Ctx->MulticastSlotState )
     {
         case PINGSLOT_STATE_CALC_PING_OFFSET:
         {
             // Compute all offsets for every multicast slots
             for( uint8_t i = 0; i < 4; i++ )
             {
-                ComputePingOffset( Ctx.BeaconCtx.BeaconTime.Seconds,
+                ComputePingOffset( Ctx->BeaconCtx.BeaconTime.Seconds,
                                    cur->ChannelParams.Address,
                                    cur->PingPeriod,
                                    &( cur->PingOffset ) );
                 cur++;
             }
-            Ctx.MulticastSlotState = PINGSLOT_STATE_SET_TIMER;
+            Ctx->MulticastSlotState = PINGSLOT_STATE_SET_TIMER;
         }
             // Intentional fall through
         case PINGSLOT_STATE_SET_TIMER:
         {
-            cur = Ctx.LoRaMacClassBParams.MulticastChannels;
-            Ctx.PingSlotCtx.NextMulticastChannel = NULL;
+            cur = Ctx->LoRaMacClassBParams.MulticastChannels;
+            Ctx->PingSlotCtx.NextMulticastChannel = NULL;
 
             for( uint8_t i = 0; i < 4; i++ )
             {
@@ -1139,34 +1230,31 @@ static void LoRaMacClassBProcessMulticastSlot( void )
                     {
                         // Update the slot time and the next multicast channel
                         multicastSlotTime = slotTime;
-                        Ctx.PingSlotCtx.NextMulticastChannel = cur;
+                        Ctx->PingSlotCtx.NextMulticastChannel = cur;
                     }
                 }
                 cur++;
             }
 
             // Schedule the next multicast slot
-            if( Ctx.PingSlotCtx.NextMulticastChannel != NULL )
+            if( Ctx->PingSlotCtx.NextMulticastChannel != NULL )
             {
-                if( Ctx.BeaconCtx.Ctrl.BeaconAcquired == 1 )
+                if( Ctx->BeaconCtx.Ctrl.BeaconAcquired == 1 )
                 {
-                    RegionComputeRxWindowParameters( *Ctx.LoRaMacClassBParams.LoRaMacRegion,
-                                                    Ctx.NvmCtx->PingSlotCtx.Datarate,
-                                                    Ctx.LoRaMacClassBParams.LoRaMacParams->MinRxSymbols,
-                                                    Ctx.LoRaMacClassBParams.LoRaMacParams->SystemMaxRxError,
+                    RegionComputeRxWindowParameters( *Ctx->LoRaMacClassBParams.LoRaMacRegion,
+                                                    Ctx->NvmCtx->PingSlotCtx.Datarate,
+                                                    Ctx->LoRaMacClassBParams.LoRaMacParams->MinRxSymbols,
+                                                    Ctx->LoRaMacClassBParams.LoRaMacParams->SystemMaxRxError,
                                                     &multicastSlotRxConfig );
-                    Ctx.PingSlotCtx.SymbolTimeout = multicastSlotRxConfig.WindowTimeout;
+                    Ctx->PingSlotCtx.SymbolTimeout = multicastSlotRxConfig.WindowTimeout;
                 }
 
-                if( ( int32_t )multicastSlotTime > multicastSlotRxConfig.WindowOffset )
-                {// Apply the window offset
-                    multicastSlotTime += multicastSlotRxConfig.WindowOffset;
-                }
+                // Apply the window offset
+                multicastSlotTime = ApplyWindowOffset( multicastSlotTime, multicastSlotRxConfig.WindowOffset );
 
                 // Start the timer if the ping slot time is in range
-                Ctx.MulticastSlotState = PINGSLOT_STATE_IDLE;
-                TimerSetValue( &Ctx.MulticastSlotTimer, multicastSlotTime );
-                TimerStart( &Ctx.MulticastSlotTimer );
+                Ctx->MulticastSlotState = PINGSLOT_STATE_IDLE;
+                TimerStartAt( &Ctx->MulticastSlotTimer, multicastSlotTime );
             }
             break;
         }
@@ -1175,47 +1263,51 @@ static void LoRaMacClassBProcessMulticastSlot( void )
             uint32_t frequency = 0;
 
             // Verify if the multicast channel is valid
-            if( Ctx.PingSlotCtx.NextMulticastChannel == NULL )
+            if( Ctx->PingSlotCtx.NextMulticastChannel == NULL )
             {
-                Ctx.MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
-                TimerSetValue( &Ctx.MulticastSlotTimer, 1 );
-                TimerStart( &Ctx.MulticastSlotTimer );
+                Ctx->MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+                TimerSetValue( &Ctx->MulticastSlotTimer, 1 );
+                TimerStart( &Ctx->MulticastSlotTimer );
                 break;
             }
 
             // Apply frequency
-            frequency = Ctx.PingSlotCtx.NextMulticastChannel->ChannelParams.RxParams.ClassB.Frequency;
+            frequency = Ctx->PingSlotCtx.NextMulticastChannel->ChannelParams.RxParams.ClassB.Frequency;
 
             // Restore the floor plan frequency if there is no individual frequency assigned
             if( frequency == 0 )
             {
                 // Restore floor plan
-                frequency = CalcDownlinkChannelAndFrequency( Ctx.PingSlotCtx.NextMulticastChannel->ChannelParams.Address,
-                                                             Ctx.BeaconCtx.BeaconTime.Seconds, CLASSB_BEACON_INTERVAL, false );
+                frequency = CalcDownlinkChannelAndFrequency( Ctx->PingSlotCtx.NextMulticastChannel->ChannelParams.Address,
+                                                             Ctx->BeaconCtx.BeaconTime.Seconds, CLASSB_BEACON_INTERVAL, false );
             }
 
-            Ctx.MulticastSlotState = PINGSLOT_STATE_RX;
+            Ctx->MulticastSlotState = PINGSLOT_STATE_RX;
 
-            multicastSlotRxConfig.Datarate = Ctx.PingSlotCtx.NextMulticastChannel->ChannelParams.RxParams.ClassB.Datarate;
-            multicastSlotRxConfig.DownlinkDwellTime = Ctx.LoRaMacClassBParams.LoRaMacParams->DownlinkDwellTime;
+            multicastSlotRxConfig.Datarate = Ctx->PingSlotCtx.NextMulticastChannel->ChannelParams.RxParams.ClassB.Datarate;
+            multicastSlotRxConfig.DownlinkDwellTime = Ctx->LoRaMacClassBParams.LoRaMacParams->DownlinkDwellTime;
             multicastSlotRxConfig.Frequency = frequency;
             multicastSlotRxConfig.RxContinuous = false;
             multicastSlotRxConfig.RxSlot = RX_SLOT_WIN_CLASS_B_MULTICAST_SLOT;
 
-            RegionRxConfig( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &multicastSlotRxConfig, ( int8_t* )&Ctx.LoRaMacClassBParams.McpsIndication->RxDatarate );
+            if( Ctx->LoRaMacClassBCallbacks.RadioRxStart != NULL )
+            {
+                Ctx->LoRaMacClassBCallbacks.RadioRxStart( );
+            }
+            RegionRxConfig( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &multicastSlotRxConfig, ( int8_t* )&Ctx->LoRaMacClassBParams.McpsIndication->RxDatarate );
 
-            if( Ctx.PingSlotState == PINGSLOT_STATE_RX )
+            if( Ctx->PingSlotState == PINGSLOT_STATE_RX )
             {
                 // Close ping slot window, if necessary. Multicast slots have priority
                 Radio.Standby( );
-                Ctx.PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
-                TimerSetValue( &Ctx.PingSlotTimer, CLASSB_PING_SLOT_WINDOW );
-                TimerStart( &Ctx.PingSlotTimer );
+                Ctx->PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+                TimerSetValue( &Ctx->PingSlotTimer, CLASSB_PING_SLOT_WINDOW );
+                TimerStart( &Ctx->PingSlotTimer );
             }
 
             if( multicastSlotRxConfig.RxContinuous == false )
             {
-                Radio.Rx( Ctx.LoRaMacClassBParams.LoRaMacParams->MaxRxWindow );
+                Radio.Rx( Ctx->LoRaMacClassBParams.LoRaMacParams->MaxRxWindow );
             }
             else
             {
@@ -1225,7 +1317,7 @@ static void LoRaMacClassBProcessMulticastSlot( void )
         }
         default:
         {
-            Ctx.MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+            Ctx->MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
             break;
         }
     }
@@ -1244,10 +1336,10 @@ bool LoRaMacClassBRxBeacon( uint8_t *payload, uint16_t size )
     uint16_t beaconCrc1 = 0;
 
     getPhy.Attribute = PHY_BEACON_FORMAT;
-    phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+    phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
 
     // Verify if we are in the state where we expect a beacon
-    if( ( Ctx.BeaconState == BEACON_STATE_RX ) || ( Ctx.BeaconCtx.Ctrl.AcquisitionPending == 1 ) )
+    if( ( Ctx->BeaconState == BEACON_STATE_RX ) || ( Ctx->BeaconCtx.Ctrl.AcquisitionPending == 1 ) )
     {
         if( size == phyParam.BeaconFormat.BeaconSize )
         {
@@ -1267,12 +1359,12 @@ bool LoRaMacClassBRxBeacon( uint8_t *payload, uint16_t size )
             if( crc0 == beaconCrc0 )
             {
                 // Read Time field from the frame
-                Ctx.BeaconCtx.BeaconTime.Seconds  = ( ( uint32_t )payload[phyParam.BeaconFormat.Rfu1Size] ) & 0x000000FF;
-                Ctx.BeaconCtx.BeaconTime.Seconds |= ( ( uint32_t )( payload[phyParam.BeaconFormat.Rfu1Size + 1] << 8 ) ) & 0x0000FF00;
-                Ctx.BeaconCtx.BeaconTime.Seconds |= ( ( uint32_t )( payload[phyParam.BeaconFormat.Rfu1Size + 2] << 16 ) ) & 0x00FF0000;
-                Ctx.BeaconCtx.BeaconTime.Seconds |= ( ( uint32_t )( payload[phyParam.BeaconFormat.Rfu1Size + 3] << 24 ) ) & 0xFF000000;
-                Ctx.BeaconCtx.BeaconTime.SubSeconds = 0;
-                Ctx.LoRaMacClassBParams.MlmeIndication->BeaconInfo.Time = Ctx.BeaconCtx.BeaconTime;
+                Ctx->BeaconCtx.BeaconTime.Seconds  = ( ( uint32_t )payload[phyParam.BeaconFormat.Rfu1Size] ) & 0x000000FF;
+                Ctx->BeaconCtx.BeaconTime.Seconds |= ( ( uint32_t )( payload[phyParam.BeaconFormat.Rfu1Size + 1] << 8 ) ) & 0x0000FF00;
+                Ctx->BeaconCtx.BeaconTime.Seconds |= ( ( uint32_t )( payload[phyParam.BeaconFormat.Rfu1Size + 2] << 16 ) ) & 0x00FF0000;
+                Ctx->BeaconCtx.BeaconTime.Seconds |= ( ( uint32_t )( payload[phyParam.BeaconFormat.Rfu1Size + 3] << 24 ) ) & 0xFF000000;
+                Ctx->BeaconCtx.BeaconTime.SubSeconds = 0;
+                Ctx->LoRaMacClassBParams.MlmeIndication->BeaconInfo.Time = Ctx->BeaconCtx.BeaconTime;
                 beaconProcessed = true;
             }
 
@@ -1286,8 +1378,8 @@ bool LoRaMacClassBRxBeacon( uint8_t *payload, uint16_t size )
             {
                 // Read GwSpecific field from the frame
                 // The GwSpecific field contains 1 byte InfoDesc and 6 bytes Info
-                Ctx.LoRaMacClassBParams.MlmeIndication->BeaconInfo.GwSpecific.InfoDesc = payload[phyParam.BeaconFormat.Rfu1Size + 4 + 2];
-                memcpy1( Ctx.LoRaMacClassBParams.MlmeIndication->BeaconInfo.GwSpecific.Info, &payload[phyParam.BeaconFormat.Rfu1Size + 4 + 2 + 1], 6 );
+                Ctx->LoRaMacClassBParams.MlmeIndication->BeaconInfo.GwSpecific.InfoDesc = payload[phyParam.BeaconFormat.Rfu1Size + 4 + 2];
+                memcpy1( Ctx->LoRaMacClassBParams.MlmeIndication->BeaconInfo.GwSpecific.Info, &payload[phyParam.BeaconFormat.Rfu1Size + 4 + 2 + 1], 6 );
             }
 
             // Reset beacon variables, if one of the crc is valid
@@ -1297,15 +1389,15 @@ bool LoRaMacClassBRxBeacon( uint8_t *payload, uint16_t size )
                 uint32_t bandwith = 0;
 
                 getPhy.Attribute = PHY_BEACON_CHANNEL_DR;
-                phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+                phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
 
                 getPhy.Attribute = PHY_SF_FROM_DR;
                 getPhy.Datarate = phyParam.Value;
-                phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+                phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
                 spreadingFactor = phyParam.Value;
 
                 getPhy.Attribute = PHY_BW_FROM_DR;
-                phyParam = RegionGetPhyParam( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &getPhy );
+                phyParam = RegionGetPhyParam( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &getPhy );
                 bandwith = phyParam.Value;
 
                 TimerTime_t time = Radio.TimeOnAir( MODEM_LORA, bandwith, spreadingFactor, 1, 10, true, size, false );
@@ -1313,24 +1405,24 @@ bool LoRaMacClassBRxBeacon( uint8_t *payload, uint16_t size )
                 timeOnAir.Seconds = time / 1000;
                 timeOnAir.SubSeconds = time - timeOnAir.Seconds * 1000;
 
-                Ctx.BeaconCtx.LastBeaconRx = Ctx.BeaconCtx.BeaconTime;
-                Ctx.BeaconCtx.LastBeaconRx.Seconds += UNIX_GPS_EPOCH_OFFSET;
+                Ctx->BeaconCtx.LastBeaconRx = Ctx->BeaconCtx.BeaconTime;
+                Ctx->BeaconCtx.LastBeaconRx.Seconds += UNIX_GPS_EPOCH_OFFSET;
 
                 // Update system time.
-                SysTimeSet( SysTimeAdd( Ctx.BeaconCtx.LastBeaconRx, timeOnAir ) );
+                SysTimeSet( SysTimeAdd( Ctx->BeaconCtx.LastBeaconRx, timeOnAir ) );
 
-                Ctx.BeaconCtx.Ctrl.BeaconAcquired = 1;
-                Ctx.BeaconCtx.Ctrl.BeaconMode = 1;
+                Ctx->BeaconCtx.Ctrl.BeaconAcquired = 1;
+                Ctx->BeaconCtx.Ctrl.BeaconMode = 1;
                 ResetWindowTimeout( );
-                Ctx.BeaconState = BEACON_STATE_LOCKED;
+                Ctx->BeaconState = BEACON_STATE_LOCKED;
 
                 LoRaMacClassBBeaconTimerEvent( NULL );
             }
         }
 
-        if( Ctx.BeaconState == BEACON_STATE_RX )
+        if( Ctx->BeaconState == BEACON_STATE_RX )
         {
-            Ctx.BeaconState = BEACON_STATE_TIMEOUT;
+            Ctx->BeaconState = BEACON_STATE_TIMEOUT;
             LoRaMacClassBBeaconTimerEvent( NULL );
         }
         // When the MAC listens for a beacon, it is not allowed to process any other
@@ -1351,8 +1443,8 @@ bool LoRaMacClassBRxBeacon( uint8_t *payload, uint16_t size )
 bool LoRaMacClassBIsBeaconExpected( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( ( Ctx.BeaconCtx.Ctrl.AcquisitionPending == 1 ) ||
-        ( Ctx.BeaconState == BEACON_STATE_RX ) )
+    if( ( Ctx->BeaconCtx.Ctrl.AcquisitionPending == 1 ) ||
+        ( Ctx->BeaconState == BEACON_STATE_RX ) )
     {
         return true;
     }
@@ -1365,7 +1457,7 @@ bool LoRaMacClassBIsBeaconExpected( void )
 bool LoRaMacClassBIsPingExpected( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.PingSlotState == PINGSLOT_STATE_RX )
+    if( Ctx->PingSlotState == PINGSLOT_STATE_RX )
     {
         return true;
     }
@@ -1378,7 +1470,7 @@ bool LoRaMacClassBIsPingExpected( void )
 bool LoRaMacClassBIsMulticastExpected( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.MulticastSlotState == PINGSLOT_STATE_RX )
+    if( Ctx->MulticastSlotState == PINGSLOT_STATE_RX )
     {
         return true;
     }
@@ -1391,7 +1483,7 @@ bool LoRaMacClassBIsMulticastExpected( void )
 bool LoRaMacClassBIsAcquisitionPending( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.BeaconCtx.Ctrl.AcquisitionPending == 1 )
+    if( Ctx->BeaconCtx.Ctrl.AcquisitionPending == 1 )
     {
         return true;
     }
@@ -1404,8 +1496,8 @@ bool LoRaMacClassBIsAcquisitionPending( void )
 bool LoRaMacClassBIsBeaconModeActive( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( ( Ctx.BeaconCtx.Ctrl.BeaconMode == 1 ) ||
-        ( Ctx.BeaconState == BEACON_STATE_ACQUISITION_BY_TIME ) )
+    if( ( Ctx->BeaconCtx.Ctrl.BeaconMode == 1 ) ||
+        ( Ctx->BeaconState == BEACON_STATE_ACQUISITION_BY_TIME ) )
     {
         return true;
     }
@@ -1418,8 +1510,8 @@ bool LoRaMacClassBIsBeaconModeActive( void )
 void LoRaMacClassBSetPingSlotInfo( uint8_t periodicity )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    Ctx.NvmCtx->PingSlotCtx.PingNb = CalcPingNb( periodicity );
-    Ctx.NvmCtx->PingSlotCtx.PingPeriod = CalcPingPeriod( Ctx.NvmCtx->PingSlotCtx.PingNb );
+    Ctx->NvmCtx->PingSlotCtx.PingNb = CalcPingNb( periodicity );
+    Ctx->NvmCtx->PingSlotCtx.PingPeriod = CalcPingPeriod( Ctx->NvmCtx->PingSlotCtx.PingNb );
     NvmContextChange( );
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -1427,24 +1519,24 @@ void LoRaMacClassBSetPingSlotInfo( uint8_t periodicity )
 void LoRaMacClassBHaltBeaconing( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.BeaconCtx.Ctrl.BeaconMode == 1 )
+    if( Ctx->BeaconCtx.Ctrl.BeaconMode == 1 )
     {
-        if( ( Ctx.BeaconState == BEACON_STATE_TIMEOUT ) ||
-            ( Ctx.BeaconState == BEACON_STATE_LOST ) )
+        if( ( Ctx->BeaconState == BEACON_STATE_TIMEOUT ) ||
+            ( Ctx->BeaconState == BEACON_STATE_LOST ) )
         {
             // Update the state machine before halt
             LoRaMacClassBBeaconTimerEvent( NULL );
         }
 
         CRITICAL_SECTION_BEGIN( );
-        LoRaMacClassBEvents.Events.Beacon = 0;
+        Ctx->Events.Events.Beacon = 0;
         CRITICAL_SECTION_END( );
 
         // Halt ping slot state machine
-        TimerStop( &Ctx.BeaconTimer );
+        TimerStop( &Ctx->BeaconTimer );
 
         // Halt beacon state machine
-        Ctx.BeaconState = BEACON_STATE_HALT;
+        Ctx->BeaconState = BEACON_STATE_HALT;
 
         // Halt ping and multicast slot state machines
         LoRaMacClassBStopRxSlots( );
@@ -1455,17 +1547,17 @@ void LoRaMacClassBHaltBeaconing( void )
 void LoRaMacClassBResumeBeaconing( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.BeaconState == BEACON_STATE_HALT )
+    if( Ctx->BeaconState == BEACON_STATE_HALT )
     {
-        Ctx.BeaconCtx.Ctrl.ResumeBeaconing = 1;
+        Ctx->BeaconCtx.Ctrl.ResumeBeaconing = 1;
 
         // Set default state
-        Ctx.BeaconState = BEACON_STATE_LOCKED;
+        Ctx->BeaconState = BEACON_STATE_LOCKED;
 
-        if( Ctx.BeaconCtx.Ctrl.BeaconAcquired == 0 )
+        if( Ctx->BeaconCtx.Ctrl.BeaconAcquired == 0 )
         {
             // Set the default state for beacon less operation
-            Ctx.BeaconState = BEACON_STATE_REACQUISITION;
+            Ctx->BeaconState = BEACON_STATE_REACQUISITION;
         }
 
         LoRaMacClassBBeaconTimerEvent( NULL );
@@ -1478,7 +1570,7 @@ LoRaMacStatus_t LoRaMacClassBSwitchClass( DeviceClass_t nextClass )
 #ifdef LORAMAC_CLASSB_ENABLED
     if( nextClass == CLASS_B )
     {// Switch to from class a to class b
-        if( ( Ctx.BeaconCtx.Ctrl.BeaconMode == 1 ) && ( Ctx.NvmCtx->PingSlotCtx.Ctrl.Assigned == 1 ) )
+        if( ( Ctx->BeaconCtx.Ctrl.BeaconMode == 1 ) && ( Ctx->NvmCtx->PingSlotCtx.Ctrl.Assigned == 1 ) )
         {
             return LORAMAC_STATUS_OK;
         }
@@ -1507,7 +1599,7 @@ LoRaMacStatus_t LoRaMacClassBMibGetRequestConfirm( MibRequestConfirm_t *mibGet )
     {
         case MIB_PING_SLOT_DATARATE:
         {
-            mibGet->Param.PingSlotDatarate = Ctx.NvmCtx->PingSlotCtx.Datarate;
+            mibGet->Param.PingSlotDatarate = Ctx->NvmCtx->PingSlotCtx.Datarate;
             break;
         }
         default:
@@ -1531,7 +1623,7 @@ LoRaMacStatus_t LoRaMacMibClassBSetRequestConfirm( MibRequestConfirm_t *mibSet )
     {
         case MIB_PING_SLOT_DATARATE:
         {
-            Ctx.NvmCtx->PingSlotCtx.Datarate = mibSet->Param.PingSlotDatarate;
+            Ctx->NvmCtx->PingSlotCtx.Datarate = mibSet->Param.PingSlotDatarate;
             NvmContextChange( );
             break;
         }
@@ -1553,7 +1645,7 @@ void LoRaMacClassBPingSlotInfoAns( void )
     if( LoRaMacConfirmQueueIsCmdActive( MLME_PING_SLOT_INFO ) == true )
     {
         LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_PING_SLOT_INFO );
-        Ctx.NvmCtx->PingSlotCtx.Ctrl.Assigned = 1;
+        Ctx->NvmCtx->PingSlotCtx.Ctrl.Assigned = 1;
         NvmContextChange( );
     }
 #endif // LORAMAC_CLASSB_ENABLED
@@ -1570,16 +1662,16 @@ uint8_t LoRaMacClassBPingSlotChannelReq( uint8_t datarate, uint32_t frequency )
     {
         isCustomFreq = true;
         verify.Frequency = frequency;
-        if( RegionVerify( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &verify, PHY_FREQUENCY ) == false )
+        if( RegionVerify( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &verify, PHY_FREQUENCY ) == false )
         {
             status &= 0xFE; // Channel frequency KO
         }
     }
 
     verify.DatarateParams.Datarate = datarate;
-    verify.DatarateParams.DownlinkDwellTime = Ctx.LoRaMacClassBParams.LoRaMacParams->DownlinkDwellTime;
+    verify.DatarateParams.DownlinkDwellTime = Ctx->LoRaMacClassBParams.LoRaMacParams->DownlinkDwellTime;
 
-    if( RegionVerify( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &verify, PHY_RX_DR ) == false )
+    if( RegionVerify( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &verify, PHY_RX_DR ) == false )
     {
         status &= 0xFD; // Datarate range KO
     }
@@ -1588,15 +1680,15 @@ uint8_t LoRaMacClassBPingSlotChannelReq( uint8_t datarate, uint32_t frequency )
     {
         if( isCustomFreq == true )
         {
-            Ctx.NvmCtx->PingSlotCtx.Ctrl.CustomFreq = 1;
-            Ctx.NvmCtx->PingSlotCtx.Frequency = frequency;
+            Ctx->NvmCtx->PingSlotCtx.Ctrl.CustomFreq = 1;
+            Ctx->NvmCtx->PingSlotCtx.Frequency = frequency;
         }
         else
         {
-            Ctx.NvmCtx->PingSlotCtx.Ctrl.CustomFreq = 0;
-            Ctx.NvmCtx->PingSlotCtx.Frequency = 0;
+            Ctx->NvmCtx->PingSlotCtx.Ctrl.CustomFreq = 0;
+            Ctx->NvmCtx->PingSlotCtx.Frequency = 0;
         }
-        Ctx.NvmCtx->PingSlotCtx.Datarate = datarate;
+        Ctx->NvmCtx->PingSlotCtx.Datarate = datarate;
         NvmContextChange( );
     }
 
@@ -1609,28 +1701,28 @@ uint8_t LoRaMacClassBPingSlotChannelReq( uint8_t datarate, uint32_t frequency )
 void LoRaMacClassBBeaconTimingAns( uint16_t beaconTimingDelay, uint8_t beaconTimingChannel, TimerTime_t lastRxDone )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    Ctx.BeaconCtx.BeaconTimingDelay = ( CLASSB_BEACON_DELAY_BEACON_TIMING_ANS * beaconTimingDelay );
-    Ctx.BeaconCtx.BeaconTimingChannel = beaconTimingChannel;
+    Ctx->BeaconCtx.BeaconTimingDelay = ( CLASSB_BEACON_DELAY_BEACON_TIMING_ANS * beaconTimingDelay );
+    Ctx->BeaconCtx.BeaconTimingChannel = beaconTimingChannel;
 
     if( LoRaMacConfirmQueueIsCmdActive( MLME_BEACON_TIMING ) == true )
     {
-        if( Ctx.BeaconCtx.BeaconTimingDelay > CLASSB_BEACON_INTERVAL )
+        if( Ctx->BeaconCtx.BeaconTimingDelay > CLASSB_BEACON_INTERVAL )
         {
             // We missed the beacon already
-            Ctx.BeaconCtx.BeaconTimingDelay = 0;
-            Ctx.BeaconCtx.BeaconTimingChannel = 0;
+            Ctx->BeaconCtx.BeaconTimingDelay = 0;
+            Ctx->BeaconCtx.BeaconTimingChannel = 0;
             LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_BEACON_NOT_FOUND, MLME_BEACON_TIMING );
         }
         else
         {
-            Ctx.BeaconCtx.Ctrl.BeaconDelaySet = 1;
-            Ctx.BeaconCtx.Ctrl.BeaconChannelSet = 1;
-            Ctx.BeaconCtx.NextBeaconRx = SysTimeFromMs( lastRxDone + Ctx.BeaconCtx.BeaconTimingDelay );
+            Ctx->BeaconCtx.Ctrl.BeaconDelaySet = 1;
+            Ctx->BeaconCtx.Ctrl.BeaconChannelSet = 1;
+            Ctx->BeaconCtx.NextBeaconRx = SysTimeFromMs( lastRxDone + Ctx->BeaconCtx.BeaconTimingDelay );
             LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_BEACON_TIMING );
         }
 
-        Ctx.LoRaMacClassBParams.MlmeConfirm->BeaconTimingDelay = Ctx.BeaconCtx.BeaconTimingDelay;
-        Ctx.LoRaMacClassBParams.MlmeConfirm->BeaconTimingChannel = Ctx.BeaconCtx.BeaconTimingChannel;
+        Ctx->LoRaMacClassBParams.MlmeConfirm->BeaconTimingDelay = Ctx->BeaconCtx.BeaconTimingDelay;
+        Ctx->LoRaMacClassBParams.MlmeConfirm->BeaconTimingChannel = Ctx->BeaconCtx.BeaconTimingChannel;
     }
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -1645,26 +1737,26 @@ void LoRaMacClassBDeviceTimeAns( void )
     nextBeacon.Seconds = nextBeacon.Seconds + ( 128 - ( nextBeacon.Seconds % 128 ) );
     nextBeacon.SubSeconds = 0;
 
-    Ctx.BeaconCtx.NextBeaconRx = nextBeacon;
-    Ctx.BeaconCtx.LastBeaconRx = SysTimeSub( Ctx.BeaconCtx.NextBeaconRx, ( SysTime_t ){ .Seconds = CLASSB_BEACON_INTERVAL / 1000, .SubSeconds = 0 } );
+    Ctx->BeaconCtx.NextBeaconRx = nextBeacon;
+    Ctx->BeaconCtx.LastBeaconRx = SysTimeSub( Ctx->BeaconCtx.NextBeaconRx, ( SysTime_t ){ .Seconds = CLASSB_BEACON_INTERVAL / 1000, .SubSeconds = 0 } );
 
     if( LoRaMacConfirmQueueIsCmdActive( MLME_DEVICE_TIME ) == true )
     {
-        if( currentTimeMs > SysTimeToMs( Ctx.BeaconCtx.NextBeaconRx ) )
+        if( currentTimeMs > SysTimeToMs( Ctx->BeaconCtx.NextBeaconRx ) )
         {
             // We missed the beacon already
-            Ctx.BeaconCtx.LastBeaconRx.Seconds = 0;
-            Ctx.BeaconCtx.LastBeaconRx.SubSeconds = 0;
-            Ctx.BeaconCtx.NextBeaconRx.Seconds = 0;
-            Ctx.BeaconCtx.NextBeaconRx.SubSeconds = 0;
+            Ctx->BeaconCtx.LastBeaconRx.Seconds = 0;
+            Ctx->BeaconCtx.LastBeaconRx.SubSeconds = 0;
+            Ctx->BeaconCtx.NextBeaconRx.Seconds = 0;
+            Ctx->BeaconCtx.NextBeaconRx.SubSeconds = 0;
             LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_BEACON_NOT_FOUND, MLME_DEVICE_TIME );
         }
         else
         {
-            Ctx.BeaconCtx.Ctrl.BeaconDelaySet = 1;
-            Ctx.BeaconCtx.BeaconTimingDelay = SysTimeToMs( Ctx.BeaconCtx.NextBeaconRx ) - currentTimeMs;
-            Ctx.BeaconCtx.BeaconTime.Seconds = nextBeacon.Seconds - UNIX_GPS_EPOCH_OFFSET - 128;
-            Ctx.BeaconCtx.BeaconTime.SubSeconds = 0;
+            Ctx->BeaconCtx.Ctrl.BeaconDelaySet = 1;
+            Ctx->BeaconCtx.BeaconTimingDelay = SysTimeToMs( Ctx->BeaconCtx.NextBeaconRx ) - currentTimeMs;
+            Ctx->BeaconCtx.BeaconTime.Seconds = nextBeacon.Seconds - UNIX_GPS_EPOCH_OFFSET - 128;
+            Ctx->BeaconCtx.BeaconTime.SubSeconds = 0;
             LoRaMacConfirmQueueSetStatus( LORAMAC_EVENT_INFO_STATUS_OK, MLME_DEVICE_TIME );
         }
     }
@@ -1680,17 +1772,17 @@ bool LoRaMacClassBBeaconFreqReq( uint32_t frequency )
     {
         verify.Frequency = frequency;
 
-        if( RegionVerify( *Ctx.LoRaMacClassBParams.LoRaMacRegion, &verify, PHY_FREQUENCY ) == true )
+        if( RegionVerify( *Ctx->LoRaMacClassBParams.LoRaMacRegion, &verify, PHY_FREQUENCY ) == true )
         {
-            Ctx.NvmCtx->BeaconCtx.Ctrl.CustomFreq = 1;
-            Ctx.NvmCtx->BeaconCtx.Frequency = frequency;
+            Ctx->NvmCtx->BeaconCtx.Ctrl.CustomFreq = 1;
+            Ctx->NvmCtx->BeaconCtx.Frequency = frequency;
             NvmContextChange( );
             return true;
         }
     }
     else
     {
-        Ctx.NvmCtx->BeaconCtx.Ctrl.CustomFreq = 0;
+        Ctx->NvmCtx->BeaconCtx.Ctrl.CustomFreq = 0;
         NvmContextChange( );
         return true;
     }
@@ -1705,12 +1797,12 @@ TimerTime_t LoRaMacClassBIsUplinkCollision( TimerTime_t txTimeOnAir )
 #ifdef LORAMAC_CLASSB_ENABLED
     TimerTime_t currentTime = TimerGetCurrentTime( );
     TimerTime_t beaconReserved = 0;
-    TimerTime_t nextBeacon = SysTimeToMs( Ctx.BeaconCtx.NextBeaconRx );
+    TimerTime_t nextBeacon = SysTimeToMs( Ctx->BeaconCtx.NextBeaconRx );
 
     beaconReserved = nextBeacon -
                      CLASSB_BEACON_GUARD -
-                     Ctx.LoRaMacClassBParams.LoRaMacParams->ReceiveDelay1 -
-                     Ctx.LoRaMacClassBParams.LoRaMacParams->ReceiveDelay2 -
+                     Ctx->LoRaMacClassBParams.LoRaMacParams->ReceiveDelay1 -
+                     Ctx->LoRaMacClassBParams.LoRaMacParams->ReceiveDelay2 -
                      txTimeOnAir;
 
     // Check if the next beacon will be received during the next uplink.
@@ -1727,12 +1819,12 @@ TimerTime_t LoRaMacClassBIsUplinkCollision( TimerTime_t txTimeOnAir )
 void LoRaMacClassBStopRxSlots( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    TimerStop( &Ctx.PingSlotTimer );
-    TimerStop( &Ctx.MulticastSlotTimer );
+    TimerStop( &Ctx->PingSlotTimer );
+    TimerStop( &Ctx->MulticastSlotTimer );
 
     CRITICAL_SECTION_BEGIN( );
-    LoRaMacClassBEvents.Events.PingSlot = 0;
-    LoRaMacClassBEvents.Events.MulticastSlot = 0;
+    Ctx->Events.Events.PingSlot = 0;
+    Ctx->Events.Events.MulticastSlot = 0;
     CRITICAL_SECTION_END( );
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -1740,15 +1832,15 @@ void LoRaMacClassBStopRxSlots( void )
 void LoRaMacClassBStartRxSlots( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
-    if( Ctx.NvmCtx->PingSlotCtx.Ctrl.Assigned == 1 )
+    if( Ctx->NvmCtx->PingSlotCtx.Ctrl.Assigned == 1 )
     {
-        Ctx.PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
-        TimerSetValue( &Ctx.PingSlotTimer, 1 );
-        TimerStart( &Ctx.PingSlotTimer );
+        Ctx->PingSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+        TimerSetValue( &Ctx->PingSlotTimer, 1 );
+        TimerStart( &Ctx->PingSlotTimer );
 
-        Ctx.MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
-        TimerSetValue( &Ctx.MulticastSlotTimer, 1 );
-        TimerStart( &Ctx.MulticastSlotTimer );
+        Ctx->MulticastSlotState = PINGSLOT_STATE_CALC_PING_OFFSET;
+        TimerSetValue( &Ctx->MulticastSlotTimer, 1 );
+        TimerStart( &Ctx->MulticastSlotTimer );
     }
 #endif // LORAMAC_CLASSB_ENABLED
 }
@@ -1764,14 +1856,47 @@ void LoRaMacClassBSetMulticastPeriodicity( MulticastCtx_t* multicastChannel )
 #endif // LORAMAC_CLASSB_ENABLED
 }
 
+void LoRaMacClassBGetNextDeadline( LoRaMacDeadline_t* deadline )
+{
+#ifdef LORAMAC_CLASSB_ENABLED
+    TimerEvent_t* timers[] = { &Ctx->BeaconTimer, &Ctx->PingSlotTimer, &Ctx->MulticastSlotTimer };
+    LoRaMacDeadlineOwner_t owners[] = { LORAMAC_DEADLINE_CLASS_B_BEACON, LORAMAC_DEADLINE_CLASS_B_PING_SLOT, LORAMAC_DEADLINE_CLASS_B_MULTICAST_SLOT };
+    uint32_t wakeupTime = Radio.GetWakeupTime( );
+
+    if( Ctx->Events.Value != 0 )
+    {
+        deadline->Owner = LORAMAC_DEADLINE_PROCESS;
+        deadline->Time = 0;
+        deadline->LeadTime = 0;
+        deadline->CanRunLate = false;
+        return;
+    }
+
+    for( uint8_t i = 0; i < ( sizeof( timers ) / sizeof( timers[0] ) ); i++ )
+    {
+        TimerTime_t remainingTime = TimerGetRemainingTime( timers[i] );
+
+        // The slot timers already expire the radio wake up time ahead of the slot
+        if( ( remainingTime != TIMERTIME_T_MAX ) &&
+            ( ( deadline->Owner == LORAMAC_DEADLINE_NONE ) || ( remainingTime < ( deadline->Time - deadline->LeadTime ) ) ) )
+        {
+            deadline->Owner = owners[i];
+            deadline->Time = remainingTime + wakeupTime;
+            deadline->LeadTime = wakeupTime;
+            deadline->CanRunLate = false;
+        }
+    }
+#endif // LORAMAC_CLASSB_ENABLED
+}
+
 void LoRaMacClassBProcess( void )
 {
 #ifdef LORAMAC_CLASSB_ENABLED
     LoRaMacClassBEvents_t events;
 
     CRITICAL_SECTION_BEGIN( );
-    events = LoRaMacClassBEvents;
-    LoRaMacClassBEvents.Value = 0;
+    events = Ctx->Events;
+    Ctx->Events.Value = 0;
     CRITICAL_SECTION_END( );
 
     if( events.Value != 0 )
@@ -240,6 +240,11 @@ typedef struct sLoRaMacClassBCallback
      *\warning  Runs in a IRQ context. Should only change variables state.
      */
     void ( *MacProcessNotify )( void );
+    /*!
+     *\brief    Will be called each time a class b reception is about to be
+     *          started on the radio.
+     */
+    void ( *RadioRxStart )( void );
 }LoRaMacClassBCallback_t;
 
 /*!
@@ -314,6 +319,29 @@ bool LoRaMacClassBRestoreNvmCtx( void* classBNvmCtx );
  */
 void* LoRaMacClassBGetNvmCtx( size_t* classBNvmCtxSize );
 
+/*!
+ * Returns a pointer to the internal volatile context.
+ *
+ * \param [IN]     classBCtxSize - Size of the module volatile context
+ *
+ * \retval                    - Points to a structure where the module store its volatile context
+ */
+void* LoRaMacClassBGetCtx( size_t* classBCtxSize );
+
+/*!
+ * Uses the passed storages as volatile and non-volatile contexts, without
+ * copying them. Used to switch between the contexts of several LoRaMac
+ * instances. The class B timers are part of the volatile context.
+ *
+ * \param [IN]     classBCtx     - Storage of at least the size returned by
+ *                                 LoRaMacClassBGetCtx. NULL binds the module
+ *                                 storages again.
+ *
+ * \param [IN]     classBNvmCtx  - Storage of at least the size returned by
+ *                                 LoRaMacClassBGetNvmCtx.
+ */
+void LoRaMacClassBBindCtxs( void* classBCtx, void* classBNvmCtx );
+
 /*!
  * \brief Set the state of the beacon state machine
  *
@@ -530,6 +558,14 @@ void LoRaMacClassBStartRxSlots( void );
  */
 void LoRaMacClassBSetMulticastPeriodicity( MulticastCtx_t* multicastChannel );
 
+/*!
+ * \brief Updates the next deadline with the class B timers and events
+ *
+ * \param [IN/OUT] deadline Next deadline of the LoRaMAC. Replaced when a class
+ *                          B slot or event is due before it.
+ */
+void LoRaMacClassBGetNextDeadline( LoRaMacDeadline_t* deadline );
+
 void LoRaMacClassBProcess( void );
 
 #ifdef __cplusplus
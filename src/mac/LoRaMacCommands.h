@@ -144,6 +144,16 @@ LoRaMacCommandStatus_t LoRaMacCommandsRestoreNvmCtx( void* commandsNvmCtx );
  */
 void* LoRaMacCommandsGetNvmCtx( size_t* commandsNvmCtxSize );
 
+/*!
+ * Uses the passed storage as non-volatile context, without copying it.
+ * Used to switch between the contexts of several LoRaMac instances.
+ *
+ * \param[IN]     commandsNvmCtx - Storage of at least the size returned by
+ *                                 LoRaMacCommandsGetNvmCtx. NULL binds the
+ *                                 module storage again.
+ */
+void LoRaMacCommandsBindNvmCtx( void* commandsNvmCtx );
+
 /*!
  * \brief Adds a new MAC command to be sent.
  *
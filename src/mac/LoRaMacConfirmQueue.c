@@ -76,19 +76,25 @@ typedef struct sLoRaMacConfirmQueueCtx
 /*
  * Non-volatile module context.
  */
-static LoRaMacConfirmQueueNvmCtx_t ConfirmQueueNvmCtx;
+static LoRaMacConfirmQueueNvmCtx_t DefaultConfirmQueueNvmCtx;
 
 /*
  * Module context.
  */
-static LoRaMacConfirmQueueCtx_t ConfirmQueueCtx;
+static LoRaMacConfirmQueueCtx_t DefaultConfirmQueueCtx = { .ConfirmQueueNvmCtx = &DefaultConfirmQueueNvmCtx };
+
+/*
+ * Module context in use. Bound to the contexts of the selected LoRaMac
+ * instance by LoRaMacConfirmQueueBindCtxs.
+ */
+static LoRaMacConfirmQueueCtx_t* ConfirmQueueCtx = &DefaultConfirmQueueCtx;
 
 static MlmeConfirmQueue_t* IncreaseBufferPointer( MlmeConfirmQueue_t* bufferPointer )
 {
-    if( bufferPointer == &ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1] )
+    if( bufferPointer == &ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1] )
     {
         // Reset to the first element
-        bufferPointer = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue;
+        bufferPointer = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue;
     }
     else
     {
@@ -100,10 +106,10 @@ static MlmeConfirmQueue_t* IncreaseBufferPointer( MlmeConfirmQueue_t* bufferPoin
 
 static MlmeConfirmQueue_t* DecreaseBufferPointer( MlmeConfirmQueue_t* bufferPointer )
 {
-    if( bufferPointer == ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue )
+    if( bufferPointer == ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue )
     {
         // Reset to the last element
-        bufferPointer = &ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1];
+        bufferPointer = &ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue[LORA_MAC_MLME_CONFIRM_QUEUE_LEN - 1];
     }
     else
     {
@@ -134,12 +140,12 @@ static MlmeConfirmQueue_t* GetElement( Mlme_t request, MlmeConfirmQueue_t* buffe
 {
     MlmeConfirmQueue_t* element = bufferStart;
 
-    if( IsListEmpty( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
+    if( IsListEmpty( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
     {
         return NULL;
     }
 
-    for( uint8_t elementCnt = 0; elementCnt < ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt; elementCnt++ )
+    for( uint8_t elementCnt = 0; elementCnt < ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt; elementCnt++ )
     {
         if( element->Request == request )
         {
@@ -154,25 +160,22 @@ static MlmeConfirmQueue_t* GetElement( Mlme_t request, MlmeConfirmQueue_t* buffe
 
 void LoRaMacConfirmQueueInit( LoRaMacPrimitives_t* primitives, LoRaMacConfirmQueueNvmEvent confirmQueueNvmCtxChanged )
 {
-    ConfirmQueueCtx.Primitives = primitives;
-
-    // Assign nvm context
-    ConfirmQueueCtx.ConfirmQueueNvmCtx = &ConfirmQueueNvmCtx;
+    ConfirmQueueCtx->Primitives = primitives;
 
     // Init counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt = 0;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt = 0;
 
     // Init buffer
-    ConfirmQueueCtx.BufferStart = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue;
-    ConfirmQueueCtx.BufferEnd = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue;
+    ConfirmQueueCtx->BufferStart = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue;
+    ConfirmQueueCtx->BufferEnd = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue;
 
-    memset1( ( uint8_t* )ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue, 0xFF, sizeof( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueue ) );
+    memset1( ( uint8_t* )ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue, 0xFF, sizeof( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueue ) );
 
     // Common status
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->CommonStatus = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->CommonStatus = LORAMAC_EVENT_INFO_STATUS_ERROR;
 
     // Assign callback
-    ConfirmQueueCtx.LoRaMacConfirmQueueNvmEvent = confirmQueueNvmCtxChanged;
+    ConfirmQueueCtx->LoRaMacConfirmQueueNvmEvent = confirmQueueNvmCtxChanged;
 }
 
 bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx )
@@ -180,7 +183,7 @@ bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx )
     // Restore module context
     if( confirmQueueNvmCtx != NULL )
     {
-        memcpy1( ( uint8_t* )&ConfirmQueueNvmCtx, ( uint8_t* ) confirmQueueNvmCtx, sizeof( ConfirmQueueNvmCtx ) );
+        memcpy1( ( uint8_t* )ConfirmQueueCtx->ConfirmQueueNvmCtx, ( uint8_t* ) confirmQueueNvmCtx, sizeof( LoRaMacConfirmQueueNvmCtx_t ) );
         return true;
     }
     else
@@ -191,57 +194,76 @@ bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx )
 
 void* LoRaMacConfirmQueueGetNvmCtx( size_t* confirmQueueNvmCtxSize )
 {
-    *confirmQueueNvmCtxSize = sizeof( ConfirmQueueNvmCtx );
-    return &ConfirmQueueNvmCtx;
+    *confirmQueueNvmCtxSize = sizeof( LoRaMacConfirmQueueNvmCtx_t );
+    return ConfirmQueueCtx->ConfirmQueueNvmCtx;
+}
+
+void* LoRaMacConfirmQueueGetCtx( size_t* confirmQueueCtxSize )
+{
+    *confirmQueueCtxSize = sizeof( LoRaMacConfirmQueueCtx_t );
+    return ConfirmQueueCtx;
+}
+
+void LoRaMacConfirmQueueBindCtxs( void* confirmQueueCtx, void* confirmQueueNvmCtx )
+{
+    if( ( confirmQueueCtx != NULL ) && ( confirmQueueNvmCtx != NULL ) )
+    {
+        ConfirmQueueCtx = ( LoRaMacConfirmQueueCtx_t* )confirmQueueCtx;
+        ConfirmQueueCtx->ConfirmQueueNvmCtx = ( LoRaMacConfirmQueueNvmCtx_t* )confirmQueueNvmCtx;
+    }
+    else
+    {
+        ConfirmQueueCtx = &DefaultConfirmQueueCtx;
+    }
 }
 
 bool LoRaMacConfirmQueueAdd( MlmeConfirmQueue_t* mlmeConfirm )
 {
-    if( IsListFull( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
+    if( IsListFull( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
     {
         // Protect the buffer against overwrites
         return false;
     }
 
     // Add the element to the ring buffer
-    ConfirmQueueCtx.BufferEnd->Request = mlmeConfirm->Request;
-    ConfirmQueueCtx.BufferEnd->Status = mlmeConfirm->Status;
-    ConfirmQueueCtx.BufferEnd->RestrictCommonReadyToHandle = mlmeConfirm->RestrictCommonReadyToHandle;
-    ConfirmQueueCtx.BufferEnd->ReadyToHandle = false;
+    ConfirmQueueCtx->BufferEnd->Request = mlmeConfirm->Request;
+    ConfirmQueueCtx->BufferEnd->Status = mlmeConfirm->Status;
+    ConfirmQueueCtx->BufferEnd->RestrictCommonReadyToHandle = mlmeConfirm->RestrictCommonReadyToHandle;
+    ConfirmQueueCtx->BufferEnd->ReadyToHandle = false;
     // Increase counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt++;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt++;
     // Update end pointer
-    ConfirmQueueCtx.BufferEnd = IncreaseBufferPointer( ConfirmQueueCtx.BufferEnd );
+    ConfirmQueueCtx->BufferEnd = IncreaseBufferPointer( ConfirmQueueCtx->BufferEnd );
 
     return true;
 }
 
 bool LoRaMacConfirmQueueRemoveLast( void )
 {
-    if( IsListEmpty( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
+    if( IsListEmpty( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
     {
         return false;
     }
 
     // Increase counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
     // Update start pointer
-    ConfirmQueueCtx.BufferEnd = DecreaseBufferPointer( ConfirmQueueCtx.BufferEnd );
+    ConfirmQueueCtx->BufferEnd = DecreaseBufferPointer( ConfirmQueueCtx->BufferEnd );
 
     return true;
 }
 
 bool LoRaMacConfirmQueueRemoveFirst( void )
 {
-    if( IsListEmpty( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
+    if( IsListEmpty( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
     {
         return false;
     }
 
     // Increase counter
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt--;
     // Update start pointer
-    ConfirmQueueCtx.BufferStart = IncreaseBufferPointer( ConfirmQueueCtx.BufferStart );
+    ConfirmQueueCtx->BufferStart = IncreaseBufferPointer( ConfirmQueueCtx->BufferStart );
 
     return true;
 }
@@ -250,9 +272,9 @@ void LoRaMacConfirmQueueSetStatus( LoRaMacEventInfoStatus_t status, Mlme_t reque
 {
     MlmeConfirmQueue_t* element = NULL;
 
-    if( IsListEmpty( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == false )
+    if( IsListEmpty( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == false )
     {
-        element = GetElement( request, ConfirmQueueCtx.BufferStart, ConfirmQueueCtx.BufferEnd );
+        element = GetElement( request, ConfirmQueueCtx->BufferStart, ConfirmQueueCtx->BufferEnd );
         if( element != NULL )
         {
             element->Status = status;
@@ -265,9 +287,9 @@ LoRaMacEventInfoStatus_t LoRaMacConfirmQueueGetStatus( Mlme_t request )
 {
     MlmeConfirmQueue_t* element = NULL;
 
-    if( IsListEmpty( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == false )
+    if( IsListEmpty( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == false )
     {
-        element = GetElement( request, ConfirmQueueCtx.BufferStart, ConfirmQueueCtx.BufferEnd );
+        element = GetElement( request, ConfirmQueueCtx->BufferStart, ConfirmQueueCtx->BufferEnd );
         if( element != NULL )
         {
             return element->Status;
@@ -278,11 +300,11 @@ LoRaMacEventInfoStatus_t LoRaMacConfirmQueueGetStatus( Mlme_t request )
 
 void LoRaMacConfirmQueueSetStatusCmn( LoRaMacEventInfoStatus_t status )
 {
-    MlmeConfirmQueue_t* element = ConfirmQueueCtx.BufferStart;
+    MlmeConfirmQueue_t* element = ConfirmQueueCtx->BufferStart;
 
-    ConfirmQueueCtx.ConfirmQueueNvmCtx->CommonStatus = status;
+    ConfirmQueueCtx->ConfirmQueueNvmCtx->CommonStatus = status;
 
-    if( IsListEmpty( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == false )
+    if( IsListEmpty( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == false )
     {
         do
         {
@@ -294,18 +316,18 @@ void LoRaMacConfirmQueueSetStatusCmn( LoRaMacEventInfoStatus_t status )
                 element->ReadyToHandle = true;
             }
             element = IncreaseBufferPointer( element );
-        }while( element != ConfirmQueueCtx.BufferEnd );
+        }while( element != ConfirmQueueCtx->BufferEnd );
     }
 }
 
 LoRaMacEventInfoStatus_t LoRaMacConfirmQueueGetStatusCmn( void )
 {
-    return ConfirmQueueCtx.ConfirmQueueNvmCtx->CommonStatus;
+    return ConfirmQueueCtx->ConfirmQueueNvmCtx->CommonStatus;
 }
 
 bool LoRaMacConfirmQueueIsCmdActive( Mlme_t request )
 {
-    if( GetElement( request, ConfirmQueueCtx.BufferStart, ConfirmQueueCtx.BufferEnd ) != NULL )
+    if( GetElement( request, ConfirmQueueCtx->BufferStart, ConfirmQueueCtx->BufferEnd ) != NULL )
     {
         return true;
     }
@@ -314,26 +336,26 @@ bool LoRaMacConfirmQueueIsCmdActive( Mlme_t request )
 
 void LoRaMacConfirmQueueHandleCb( MlmeConfirm_t* mlmeConfirm )
 {
-    uint8_t nbElements = ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
+    uint8_t nbElements = ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
     bool readyToHandle = false;
     MlmeConfirmQueue_t mlmeConfirmToStore;
 
     for( uint8_t i = 0; i < nbElements; i++ )
     {
-        mlmeConfirm->MlmeRequest = ConfirmQueueCtx.BufferStart->Request;
-        mlmeConfirm->Status = ConfirmQueueCtx.BufferStart->Status;
-        readyToHandle = ConfirmQueueCtx.BufferStart->ReadyToHandle;
+        mlmeConfirm->MlmeRequest = ConfirmQueueCtx->BufferStart->Request;
+        mlmeConfirm->Status = ConfirmQueueCtx->BufferStart->Status;
+        readyToHandle = ConfirmQueueCtx->BufferStart->ReadyToHandle;
 
         if( readyToHandle == true )
         {
-            ConfirmQueueCtx.Primitives->MacMlmeConfirm( mlmeConfirm );
+            ConfirmQueueCtx->Primitives->MacMlmeConfirm( mlmeConfirm );
         }
         else
         {
             // The request is not processed yet. Store the state.
-            mlmeConfirmToStore.Request = ConfirmQueueCtx.BufferStart->Request;
-            mlmeConfirmToStore.Status = ConfirmQueueCtx.BufferStart->Status;
-            mlmeConfirmToStore.RestrictCommonReadyToHandle = ConfirmQueueCtx.BufferStart->RestrictCommonReadyToHandle;
+            mlmeConfirmToStore.Request = ConfirmQueueCtx->BufferStart->Request;
+            mlmeConfirmToStore.Status = ConfirmQueueCtx->BufferStart->Status;
+            mlmeConfirmToStore.RestrictCommonReadyToHandle = ConfirmQueueCtx->BufferStart->RestrictCommonReadyToHandle;
         }
 
         // Increase the pointer afterwards to prevent overwrites
@@ -349,12 +371,12 @@ void LoRaMacConfirmQueueHandleCb( MlmeConfirm_t* mlmeConfirm )
 
 uint8_t LoRaMacConfirmQueueGetCnt( void )
 {
-    return ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
+    return ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt;
 }
 
 bool LoRaMacConfirmQueueIsFull( void )
 {
-    if( IsListFull( ConfirmQueueCtx.ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
+    if( IsListFull( ConfirmQueueCtx->ConfirmQueueNvmCtx->MlmeConfirmQueueCnt ) == true )
     {
         return true;
     }
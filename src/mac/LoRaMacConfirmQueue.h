@@ -112,6 +112,29 @@ bool LoRaMacConfirmQueueRestoreNvmCtx( void* confirmQueueNvmCtx );
  */
 void* LoRaMacConfirmQueueGetNvmCtx( size_t* confirmQueueNvmCtxSize );
 
+/*!
+ * Returns a pointer to the internal volatile context.
+ *
+ * \param   [IN] confirmQueueCtxSize - Size of the module volatile context
+ *
+ * \retval  - Points to a structure where the module store its volatile context
+ */
+void* LoRaMacConfirmQueueGetCtx( size_t* confirmQueueCtxSize );
+
+/*!
+ * Uses the passed storages as volatile and non-volatile contexts, without
+ * copying them. Used to switch between the contexts of several LoRaMac
+ * instances.
+ *
+ * \param   [IN] confirmQueueCtx - Storage of at least the size returned by
+ *                                LoRaMacConfirmQueueGetCtx. NULL binds the
+ *                                module storages again.
+ *
+ * \param   [IN] confirmQueueNvmCtx - Storage of at least the size returned by
+ *                                   LoRaMacConfirmQueueGetNvmCtx.
+ */
+void LoRaMacConfirmQueueBindCtxs( void* confirmQueueCtx, void* confirmQueueNvmCtx );
+
 /*!
  * \brief   Adds an element to the confirm queue.
  *
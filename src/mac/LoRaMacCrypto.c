@@ -81,6 +81,11 @@
  */
 #define CRYPTO_BUFFER_SIZE              CRYPTO_MAXMESSAGE_SIZE + MIC_BLOCK_BX_SIZE
 
+/*
+ * Number of key stream blocks encrypted by a single secure element request
+ */
+#define CRYPTO_KEY_STREAM_BLOCKS        4
+
 /*!
  * LoRaWAN Frame counter list.
  */
@@ -158,6 +163,12 @@ typedef struct sLoRaMacCryptoNvmCtx
      * This information is needed to compute ConfFCnt in B1 block for the MIC.
      */
     uint32_t* LastDownFCnt;
+#if( USE_LRWAN_1_1_X_CRYPTO == 1 )
+    /*
+     * RJcount0 is a counter incremented with every Type 0 or 2 Rejoin frame transmitted.
+     */
+    uint16_t RJcount0;
+#endif
 }LoRaMacCryptoNvmCtx_t;
 
 /*
@@ -165,12 +176,6 @@ typedef struct sLoRaMacCryptoNvmCtx
  */
 typedef struct sLoRaMacCryptoCtx
 {
-#if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-    /*
-     * RJcount0 is a counter incremented with every Type 0 or 2 Rejoin frame transmitted.
-     */
-    uint16_t RJcount0;
-#endif
     /*
      * Non volatile module context structure
      */
@@ -204,16 +209,64 @@ typedef struct sKeyAddr
     KeyIdentifier_t RootKey;
 }KeyAddr_t;
 
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
 /*
- *Crypto module context.
+ * Asynchronous unsecure steps
+ */
+typedef enum eCryptoAsyncStep
+{
+    CRYPTO_ASYNC_STEP_VERIFY_MIC,
+    CRYPTO_ASYNC_STEP_DECRYPT_PAYLOAD,
+    CRYPTO_ASYNC_STEP_DECRYPT_FOPTS,
+}CryptoAsyncStep_t;
+
+/*
+ * Asynchronous unsecure context
  */
-static LoRaMacCryptoCtx_t CryptoCtx;
+typedef struct sLoRaMacCryptoAsyncCtx
+{
+    /*
+     * Secure element job of the current step
+     */
+    SecureElementJob_t Job;
+    CryptoAsyncStep_t Step;
+    bool IsBusy;
+    AddressIdentifier_t AddrID;
+    uint32_t Address;
+    FCntIdentifier_t FCntID;
+    uint32_t FCntDown;
+    LoRaMacMessageData_t* MacMsg;
+    KeyIdentifier_t PayloadKeyID;
+    /*
+     * Payload A block template, next block counter and next payload index
+     */
+    uint8_t ABlock[16];
+    uint16_t Ctr;
+    uint16_t BufferIndex;
+    /*
+     * B0 | msg for the MIC verification, then A blocks and key stream
+     */
+    uint8_t Buffer[CRYPTO_BUFFER_SIZE];
+    LoRaMacCryptoAsyncCallback Callback;
+    void* Context;
+}LoRaMacCryptoAsyncCtx_t;
+
+/*
+ * Asynchronous unsecure context
+ */
+static LoRaMacCryptoAsyncCtx_t CryptoAsyncCtx;
+#endif
 
 /*
  * Non volatile module context.
  */
 static LoRaMacCryptoNvmCtx_t NvmCryptoCtx;
 
+/*
+ *Crypto module context.
+ */
+static LoRaMacCryptoCtx_t CryptoCtx = { .NvmCtx = &NvmCryptoCtx };
+
 /*
  * Key-Address list
  */
@@ -231,27 +284,16 @@ static KeyAddr_t KeyAddrList[NUM_OF_SEC_CTX] =
  */
 
 /*
- * Encrypts the payload
+ * Prepares the A block template of the payload encryption
  *
- * \param[IN]  keyID            - Key identifier
  * \param[IN]  address          - Address
  * \param[IN]  dir              - Frame direction ( Uplink or Downlink )
  * \param[IN]  frameCounter     - Frame counter
- * \param[IN]  size             - Size of data
- * \param[IN/OUT]  buffer       - Data buffer
- * \retval                      - Status of the operation
+ * \param[OUT] aBlock           - A block, without block counter
  */
-static LoRaMacCryptoStatus_t PayloadEncrypt( uint8_t* buffer, int16_t size, KeyIdentifier_t keyID, uint32_t address, uint8_t dir, uint32_t frameCounter )
+static void PreparePayloadABlock( uint32_t address, uint8_t dir, uint32_t frameCounter, uint8_t* aBlock )
 {
-    if( buffer == 0 )
-    {
-        return LORAMAC_CRYPTO_ERROR_NPE;
-    }
-
-    uint8_t bufferIndex = 0;
-    uint16_t ctr = 1;
-    uint8_t sBlock[16] = { 0 };
-    uint8_t aBlock[16] = { 0 };
+    memset1( aBlock, 0, 16 );
 
     aBlock[0] = 0x01;
 
@@ -266,40 +308,53 @@ static LoRaMacCryptoStatus_t PayloadEncrypt( uint8_t* buffer, int16_t size, KeyI
     aBlock[11] = ( frameCounter >> 8 ) & 0xFF;
     aBlock[12] = ( frameCounter >> 16 ) & 0xFF;
     aBlock[13] = ( frameCounter >> 24 ) & 0xFF;
+}
 
-    while( size > 0 )
-    {
-        aBlock[15] = ctr & 0xFF;
-        ctr++;
-        if( SecureElementAesEncrypt( aBlock, 16, keyID, sBlock ) != SECURE_ELEMENT_SUCCESS )
-        {
-            return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
-        }
+/*
+ * Prepares the A blocks of the next key stream batch
+ *
+ * \param[IN]  aBlock           - A block template
+ * \param[IN]  ctr              - Block counter of the first block
+ * \param[IN]  size             - Remaining data size
+ * \param[OUT] aBlocks          - A blocks, up to CRYPTO_KEY_STREAM_BLOCKS
+ * \retval                      - Number of prepared blocks
+ */
+static uint8_t PrepareKeyStreamBlocks( uint8_t* aBlock, uint16_t ctr, int16_t size, uint8_t* aBlocks )
+{
+    uint8_t nbBlocks = 0;
 
-        for( uint8_t i = 0; i < ( ( size > 16 ) ? 16 : size ); i++ )
-        {
-            buffer[bufferIndex + i] = buffer[bufferIndex + i] ^ sBlock[i];
-        }
+    for( ; ( nbBlocks < CRYPTO_KEY_STREAM_BLOCKS ) && ( size > 0 ); nbBlocks++ )
+    {
+        memcpy1( aBlocks + ( nbBlocks * 16 ), aBlock, 15 );
+        aBlocks[( nbBlocks * 16 ) + 15] = ( ctr + nbBlocks ) & 0xFF;
         size -= 16;
-        bufferIndex += 16;
     }
+    return nbBlocks;
+}
 
-    return LORAMAC_CRYPTO_SUCCESS;
+/*
+ * Xors the data with the key stream
+ */
+static void ApplyKeyStream( uint8_t* buffer, uint8_t* keyStream, uint16_t size )
+{
+    for( uint16_t i = 0; i < size; i++ )
+    {
+        buffer[i] = buffer[i] ^ keyStream[i];
+    }
 }
 
-#if( USE_LRWAN_1_1_X_CRYPTO == 1 )
 /*
- * Encrypts the FOpts
+ * Encrypts the payload
  *
+ * \param[IN]  keyID            - Key identifier
  * \param[IN]  address          - Address
  * \param[IN]  dir              - Frame direction ( Uplink or Downlink )
- * \param[IN]  fCntID           - Frame counter identifier
  * \param[IN]  frameCounter     - Frame counter
  * \param[IN]  size             - Size of data
  * \param[IN/OUT]  buffer       - Data buffer
  * \retval                      - Status of the operation
  */
-static LoRaMacCryptoStatus_t FOptsEncrypt( uint16_t size, uint32_t address, uint8_t dir, FCntIdentifier_t fCntID, uint32_t frameCounter, uint8_t* buffer )
+static LoRaMacCryptoStatus_t PayloadEncrypt( uint8_t* buffer, int16_t size, KeyIdentifier_t keyID, uint32_t address, uint8_t dir, uint32_t frameCounter )
 {
     if( buffer == 0 )
     {
@@ -307,8 +362,46 @@ static LoRaMacCryptoStatus_t FOptsEncrypt( uint16_t size, uint32_t address, uint
     }
 
     uint8_t bufferIndex = 0;
-    uint8_t sBlock[16] = { 0 };
-    uint8_t aBlock[16] = { 0 };
+    uint16_t ctr = 1;
+    uint8_t nbBlocks = 0;
+    uint8_t aBlock[16];
+    uint8_t aBlocks[CRYPTO_KEY_STREAM_BLOCKS * 16];
+    uint8_t sBlocks[CRYPTO_KEY_STREAM_BLOCKS * 16];
+
+    PreparePayloadABlock( address, dir, frameCounter, aBlock );
+
+    while( size > 0 )
+    {
+        // Several blocks are encrypted by a single secure element request
+        nbBlocks = PrepareKeyStreamBlocks( aBlock, ctr, size, aBlocks );
+        if( SecureElementAesEncrypt( aBlocks, nbBlocks * 16, keyID, sBlocks ) != SECURE_ELEMENT_SUCCESS )
+        {
+            return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
+        }
+
+        ApplyKeyStream( buffer + bufferIndex, sBlocks, MIN( size, nbBlocks * 16 ) );
+        ctr += nbBlocks;
+        size -= nbBlocks * 16;
+        bufferIndex += nbBlocks * 16;
+    }
+
+    return LORAMAC_CRYPTO_SUCCESS;
+}
+
+#if( USE_LRWAN_1_1_X_CRYPTO == 1 )
+/*
+ * Prepares the A block of the FOpts encryption
+ *
+ * \param[IN]  address          - Address
+ * \param[IN]  dir              - Frame direction ( Uplink or Downlink )
+ * \param[IN]  fCntID           - Frame counter identifier
+ * \param[IN]  frameCounter     - Frame counter
+ * \param[OUT] aBlock           - A block
+ * \retval                      - Status of the operation
+ */
+static LoRaMacCryptoStatus_t PrepareFOptsABlock( uint32_t address, uint8_t dir, FCntIdentifier_t fCntID, uint32_t frameCounter, uint8_t* aBlock )
+{
+    memset1( aBlock, 0, 16 );
 
     aBlock[0] = 0x01;
 
@@ -355,16 +448,43 @@ static LoRaMacCryptoStatus_t FOptsEncrypt( uint16_t size, uint32_t address, uint
         aBlock[15] = 0x01;
     }
 
+    return LORAMAC_CRYPTO_SUCCESS;
+}
+
+/*
+ * Encrypts the FOpts
+ *
+ * \param[IN]  address          - Address
+ * \param[IN]  dir              - Frame direction ( Uplink or Downlink )
+ * \param[IN]  fCntID           - Frame counter identifier
+ * \param[IN]  frameCounter     - Frame counter
+ * \param[IN]  size             - Size of data
+ * \param[IN/OUT]  buffer       - Data buffer
+ * \retval                      - Status of the operation
+ */
+static LoRaMacCryptoStatus_t FOptsEncrypt( uint16_t size, uint32_t address, uint8_t dir, FCntIdentifier_t fCntID, uint32_t frameCounter, uint8_t* buffer )
+{
+    if( buffer == 0 )
+    {
+        return LORAMAC_CRYPTO_ERROR_NPE;
+    }
+
+    uint8_t sBlock[16] = { 0 };
+    uint8_t aBlock[16] = { 0 };
+    LoRaMacCryptoStatus_t retval = PrepareFOptsABlock( address, dir, fCntID, frameCounter, aBlock );
+
+    if( retval != LORAMAC_CRYPTO_SUCCESS )
+    {
+        return retval;
+    }
+
     if( size > 0 )
     {
         if( SecureElementAesEncrypt( aBlock, 16, NWK_S_ENC_KEY, sBlock ) != SECURE_ELEMENT_SUCCESS )
         {
             return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
         }
-        for( uint8_t i = 0; i < size; i++ )
-        {
-            buffer[bufferIndex + i] = buffer[bufferIndex + i] ^ sBlock[i];
-        }
+        ApplyKeyStream( buffer, sBlock, size );
     }
 
     return LORAMAC_CRYPTO_SUCCESS;
@@ -913,9 +1033,6 @@ static void DummyCB( void )
 
 LoRaMacCryptoStatus_t LoRaMacCryptoInit( LoRaMacCryptoNvmEvent cryptoNvmCtxChanged )
 {
-    // Assign non volatile context
-    CryptoCtx.NvmCtx = &NvmCryptoCtx;
-
     // Assign callback
     if( cryptoNvmCtxChanged != 0 )
     {
@@ -952,7 +1069,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoRestoreNvmCtx( void* cryptoNvmCtx )
     // Restore module context
     if( cryptoNvmCtx != 0 )
     {
-        memcpy1( ( uint8_t* )&NvmCryptoCtx, ( uint8_t* )cryptoNvmCtx, CRYPTO_NVM_CTX_SIZE );
+        memcpy1( ( uint8_t* )CryptoCtx.NvmCtx, ( uint8_t* )cryptoNvmCtx, CRYPTO_NVM_CTX_SIZE );
         return LORAMAC_CRYPTO_SUCCESS;
     }
     else
@@ -964,7 +1081,19 @@ LoRaMacCryptoStatus_t LoRaMacCryptoRestoreNvmCtx( void* cryptoNvmCtx )
 void* LoRaMacCryptoGetNvmCtx( size_t* cryptoNvmCtxSize )
 {
     *cryptoNvmCtxSize = CRYPTO_NVM_CTX_SIZE;
-    return &NvmCryptoCtx;
+    return CryptoCtx.NvmCtx;
+}
+
+void LoRaMacCryptoBindNvmCtx( void* cryptoNvmCtx )
+{
+    if( cryptoNvmCtx != NULL )
+    {
+        CryptoCtx.NvmCtx = ( LoRaMacCryptoNvmCtx_t* )cryptoNvmCtx;
+    }
+    else
+    {
+        CryptoCtx.NvmCtx = &NvmCryptoCtx;
+    }
 }
 
 LoRaMacCryptoStatus_t LoRaMacCryptoGetFCntUp( uint32_t* currentUp )
@@ -1043,7 +1172,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoGetRJcount( FCntIdentifier_t fCntID, uint16_t
     switch( fCntID )
     {
         case RJ_COUNT_0:
-            *rJcount = CryptoCtx.RJcount0 + 1;
+            *rJcount = CryptoCtx.NvmCtx->RJcount0 + 1;
             break;
         case RJ_COUNT_1:
             *rJcount = CryptoCtx.NvmCtx->FCntList.RJcount1 + 1;
@@ -1191,7 +1320,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareReJoinType0or2( LoRaMacMessageReJoinTy
     }
 
     // Check for RJcount0 overflow
-    if( CryptoCtx.RJcount0 == 65535 )
+    if( CryptoCtx.NvmCtx->RJcount0 == 65535 )
     {
         return LORAMAC_CRYPTO_FAIL_RJCOUNT0_OVERFLOW;
     }
@@ -1216,7 +1345,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoPrepareReJoinType0or2( LoRaMacMessageReJoinTy
     }
 
     // Increment RJcount0
-    CryptoCtx.RJcount0++;
+    CryptoCtx.NvmCtx->RJcount0++;
 
     return LORAMAC_CRYPTO_SUCCESS;
 }
@@ -1236,9 +1365,9 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
 
     // Nonce selection depending on JoinReqType
     // JOIN_REQ     : CryptoCtx.NvmCtx->DevNonce
-    // REJOIN_REQ_0 : CryptoCtx.RJcount0
+    // REJOIN_REQ_0 : CryptoCtx.NvmCtx->RJcount0
     // REJOIN_REQ_1 : CryptoCtx.RJcount1
-    // REJOIN_REQ_2 : CryptoCtx.RJcount0
+    // REJOIN_REQ_2 : CryptoCtx.NvmCtx->RJcount0
     if( joinReqType == JOIN_REQ )
     {
         // Nothing to be done
@@ -1249,7 +1378,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
         // If Join-accept is a reply to a rejoin, the RJcount(0 or 1) replaces DevNonce in the key derivation process.
         if( ( joinReqType == REJOIN_REQ_0 ) || ( joinReqType == REJOIN_REQ_2 ) )
         {
-            nonce = ( uint8_t* )&CryptoCtx.RJcount0;
+            nonce = ( uint8_t* )&CryptoCtx.NvmCtx->RJcount0;
         }
         else
         {
@@ -1380,7 +1509,7 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
 
     // Reset frame counters
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
-    CryptoCtx.RJcount0 = 0;
+    CryptoCtx.NvmCtx->RJcount0 = 0;
 #endif
     CryptoCtx.NvmCtx->FCntList.FCntUp = 0;
     CryptoCtx.NvmCtx->FCntList.FCntDown = FCNT_DOWN_INITAL_VALUE;
@@ -1392,12 +1521,12 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
     return LORAMAC_CRYPTO_SUCCESS;
 }
 
-LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg )
+LoRaMacCryptoStatus_t LoRaMacCryptoPrepareSecureMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg, LoRaMacCryptoPreparedMsg_t* preparedMsg )
 {
     LoRaMacCryptoStatus_t retval = LORAMAC_CRYPTO_ERROR;
     KeyIdentifier_t payloadDecryptionKeyID = APP_S_KEY;
 
-    if( macMsg == NULL )
+    if( ( macMsg == NULL ) || ( preparedMsg == NULL ) )
     {
         return LORAMAC_CRYPTO_ERROR_NPE;
     }
@@ -1407,6 +1536,9 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
         return LORAMAC_CRYPTO_FAIL_FCNT_SMALLER;
     }
 
+    preparedMsg->IsValid = false;
+    preparedMsg->IsCmacSValid = false;
+
     // Encrypt payload
     if( macMsg->FPort == 0 )
     {
@@ -1441,45 +1573,91 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
         return LORAMAC_CRYPTO_ERROR_SERIALIZER;
     }
 
-    // Compute mic
+    // Compute the data rate and channel independent mic part
 #if( USE_LRWAN_1_1_X_CRYPTO == 1 )
     if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
     {
-        uint32_t cmacS = 0;
-        uint32_t cmacF = 0;
-
-        // cmacS  = aes128_cmac(SNwkSIntKey, B1 | msg)
-        retval = ComputeCmacB1( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), S_NWK_S_INT_KEY, macMsg->FHDR.FCtrl.Bits.Ack, txDr, txCh, macMsg->FHDR.DevAddr, fCntUp, &cmacS );
+        //cmacF = aes128_cmac(FNwkSIntKey, B0 | msg)
+        retval = ComputeCmacB0( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), F_NWK_S_INT_KEY, macMsg->FHDR.FCtrl.Bits.Ack, UPLINK, macMsg->FHDR.DevAddr, fCntUp, &preparedMsg->CmacF );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
         }
-        //cmacF = aes128_cmac(FNwkSIntKey, B0 | msg)
-        retval = ComputeCmacB0( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), F_NWK_S_INT_KEY, macMsg->FHDR.FCtrl.Bits.Ack, UPLINK, macMsg->FHDR.DevAddr, fCntUp, &cmacF );
+        // cmacS  = aes128_cmac(SNwkSIntKey, B1 | msg) for the expected data rate and channel
+        retval = ComputeCmacB1( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), S_NWK_S_INT_KEY, macMsg->FHDR.FCtrl.Bits.Ack, txDr, txCh, macMsg->FHDR.DevAddr, fCntUp, &preparedMsg->CmacS );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
         }
-        // MIC = cmacS[0..1] | cmacF[0..1]
-        macMsg->MIC = ( ( cmacF << 16 ) & 0xFFFF0000 ) | ( cmacS & 0x0000FFFF );
+        preparedMsg->TxDr = txDr;
+        preparedMsg->TxCh = txCh;
+        preparedMsg->IsCmacSValid = true;
     }
     else
 #endif
     {
         // MIC = cmacF[0..3]
         // The IsAck parameter is every time false since the ConfFCnt field is not used in legacy mode.
-        retval = ComputeCmacB0( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), NWK_S_ENC_KEY, false, UPLINK, macMsg->FHDR.DevAddr, fCntUp, &macMsg->MIC );
+        retval = ComputeCmacB0( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), NWK_S_ENC_KEY, false, UPLINK, macMsg->FHDR.DevAddr, fCntUp, &preparedMsg->CmacF );
         if( retval != LORAMAC_CRYPTO_SUCCESS )
         {
             return retval;
         }
     }
 
-    // Re-serialize message to add the MIC
-    if( LoRaMacSerializerData( macMsg ) != LORAMAC_SERIALIZER_SUCCESS )
+    preparedMsg->FCntUp = fCntUp;
+    preparedMsg->IsValid = true;
+
+    return LORAMAC_CRYPTO_SUCCESS;
+}
+
+LoRaMacCryptoStatus_t LoRaMacCryptoSecurePreparedMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg, LoRaMacCryptoPreparedMsg_t* preparedMsg )
+{
+    uint8_t* mic = NULL;
+
+    if( ( macMsg == NULL ) || ( preparedMsg == NULL ) )
     {
-        return LORAMAC_CRYPTO_ERROR_SERIALIZER;
+        return LORAMAC_CRYPTO_ERROR_NPE;
+    }
+
+    if( ( preparedMsg->IsValid == false ) || ( preparedMsg->FCntUp != fCntUp ) )
+    {
+        return LORAMAC_CRYPTO_FAIL_PARAM;
+    }
+
+    // Compute mic
+#if( USE_LRWAN_1_1_X_CRYPTO == 1 )
+    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 )
+    {
+        if( ( preparedMsg->IsCmacSValid == false ) ||
+            ( preparedMsg->TxDr != txDr ) || ( preparedMsg->TxCh != txCh ) )
+        {
+            // cmacS  = aes128_cmac(SNwkSIntKey, B1 | msg)
+            preparedMsg->IsCmacSValid = false;
+            LoRaMacCryptoStatus_t retval = ComputeCmacB1( macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), S_NWK_S_INT_KEY, macMsg->FHDR.FCtrl.Bits.Ack, txDr, txCh, macMsg->FHDR.DevAddr, fCntUp, &preparedMsg->CmacS );
+            if( retval != LORAMAC_CRYPTO_SUCCESS )
+            {
+                return retval;
+            }
+            preparedMsg->TxDr = txDr;
+            preparedMsg->TxCh = txCh;
+            preparedMsg->IsCmacSValid = true;
+        }
+        // MIC = cmacS[0..1] | cmacF[0..1]
+        macMsg->MIC = ( ( preparedMsg->CmacF << 16 ) & 0xFFFF0000 ) | ( preparedMsg->CmacS & 0x0000FFFF );
     }
+    else
+#endif
+    {
+        macMsg->MIC = preparedMsg->CmacF;
+    }
+
+    // The message has already been serialized. Only the MIC field is updated.
+    mic = macMsg->Buffer + macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE;
+    mic[0] = macMsg->MIC & 0xFF;
+    mic[1] = ( macMsg->MIC >> 8 ) & 0xFF;
+    mic[2] = ( macMsg->MIC >> 16 ) & 0xFF;
+    mic[3] = ( macMsg->MIC >> 24 ) & 0xFF;
 
     CryptoCtx.NvmCtx->FCntList.FCntUp = fCntUp;
     CryptoCtx.EventCryptoNvmCtxChanged( );
@@ -1487,6 +1665,18 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
     return LORAMAC_CRYPTO_SUCCESS;
 }
 
+LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg )
+{
+    LoRaMacCryptoPreparedMsg_t preparedMsg;
+    LoRaMacCryptoStatus_t retval = LoRaMacCryptoPrepareSecureMessage( fCntUp, txDr, txCh, macMsg, &preparedMsg );
+
+    if( retval != LORAMAC_CRYPTO_SUCCESS )
+    {
+        return retval;
+    }
+    return LoRaMacCryptoSecurePreparedMessage( fCntUp, txDr, txCh, macMsg, &preparedMsg );
+}
+
 LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessage( AddressIdentifier_t addrID, uint32_t address, FCntIdentifier_t fCntID, uint32_t fCntDown, LoRaMacMessageData_t* macMsg )
 {
     if( macMsg == 0 )
@@ -1573,6 +1763,226 @@ LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessage( AddressIdentifier_t addrID,
     return LORAMAC_CRYPTO_SUCCESS;
 }
 
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+/*
+ * Completes the asynchronous unsecure
+ */
+static void UnsecureMessageAsyncDone( LoRaMacCryptoStatus_t status )
+{
+    if( status == LORAMAC_CRYPTO_SUCCESS )
+    {
+        UpdateFCntDown( CryptoAsyncCtx.FCntID, CryptoAsyncCtx.FCntDown );
+    }
+    CryptoAsyncCtx.IsBusy = false;
+    CryptoAsyncCtx.Callback( status, CryptoAsyncCtx.Context );
+}
+
+/*
+ * Submits the encryption of the next key stream batch
+ */
+static void UnsecureMessageAsyncSubmitKeyStream( void )
+{
+    SecureElementJob_t* job = &CryptoAsyncCtx.Job;
+    uint8_t nbBlocks = PrepareKeyStreamBlocks( CryptoAsyncCtx.ABlock, CryptoAsyncCtx.Ctr,
+                                               CryptoAsyncCtx.MacMsg->FRMPayloadSize - CryptoAsyncCtx.BufferIndex, CryptoAsyncCtx.Buffer );
+
+    job->Type = SECURE_ELEMENT_JOB_AES_ENCRYPT;
+    job->KeyID = CryptoAsyncCtx.PayloadKeyID;
+    job->Buffer = CryptoAsyncCtx.Buffer;
+    job->Size = nbBlocks * 16;
+    job->EncBuffer = CryptoAsyncCtx.Buffer + ( CRYPTO_KEY_STREAM_BLOCKS * 16 );
+    if( SecureElementSubmitJob( job ) != SECURE_ELEMENT_SUCCESS )
+    {
+        UnsecureMessageAsyncDone( LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC );
+    }
+}
+
+/*
+ * Starts the FOpts decryption, last step of the asynchronous unsecure
+ */
+static void UnsecureMessageAsyncDecryptFOpts( void )
+{
+#if( USE_LRWAN_1_1_X_CRYPTO == 1 )
+    SecureElementJob_t* job = &CryptoAsyncCtx.Job;
+
+    if( ( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 1 ) && ( CryptoAsyncCtx.AddrID == UNICAST_DEV_ADDR ) &&
+        ( CryptoAsyncCtx.MacMsg->FHDR.FCtrl.Bits.FOptsLen > 0 ) )
+    {
+        LoRaMacCryptoStatus_t retval = PrepareFOptsABlock( CryptoAsyncCtx.Address, DOWNLINK, CryptoAsyncCtx.FCntID, CryptoAsyncCtx.FCntDown, CryptoAsyncCtx.Buffer );
+        if( retval != LORAMAC_CRYPTO_SUCCESS )
+        {
+            UnsecureMessageAsyncDone( retval );
+            return;
+        }
+        CryptoAsyncCtx.Step = CRYPTO_ASYNC_STEP_DECRYPT_FOPTS;
+        job->Type = SECURE_ELEMENT_JOB_AES_ENCRYPT;
+        job->KeyID = NWK_S_ENC_KEY;
+        job->Buffer = CryptoAsyncCtx.Buffer;
+        job->Size = 16;
+        job->EncBuffer = CryptoAsyncCtx.Buffer + 16;
+        if( SecureElementSubmitJob( job ) != SECURE_ELEMENT_SUCCESS )
+        {
+            UnsecureMessageAsyncDone( LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC );
+        }
+        return;
+    }
+#endif
+    UnsecureMessageAsyncDone( LORAMAC_CRYPTO_SUCCESS );
+}
+
+/*
+ * Continues the asynchronous unsecure once a secure element job completes
+ */
+static void UnsecureMessageAsyncStep( SecureElementJob_t* job )
+{
+    LoRaMacMessageData_t* macMsg = CryptoAsyncCtx.MacMsg;
+
+    if( job->Status != SECURE_ELEMENT_SUCCESS )
+    {
+        if( ( CryptoAsyncCtx.Step == CRYPTO_ASYNC_STEP_VERIFY_MIC ) && ( job->Status == SECURE_ELEMENT_FAIL_CMAC ) )
+        {
+            UnsecureMessageAsyncDone( LORAMAC_CRYPTO_FAIL_MIC );
+        }
+        else
+        {
+            UnsecureMessageAsyncDone( LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC );
+        }
+        return;
+    }
+
+    switch( CryptoAsyncCtx.Step )
+    {
+        case CRYPTO_ASYNC_STEP_VERIFY_MIC:
+        {
+            // Decrypt payload
+            CryptoAsyncCtx.PayloadKeyID = ( macMsg->FPort == 0 ) ? NWK_S_ENC_KEY : CryptoAsyncCtx.PayloadKeyID;
+            PreparePayloadABlock( CryptoAsyncCtx.Address, DOWNLINK, CryptoAsyncCtx.FCntDown, CryptoAsyncCtx.ABlock );
+            CryptoAsyncCtx.Ctr = 1;
+            CryptoAsyncCtx.BufferIndex = 0;
+            CryptoAsyncCtx.Step = CRYPTO_ASYNC_STEP_DECRYPT_PAYLOAD;
+            if( macMsg->FRMPayloadSize > 0 )
+            {
+                UnsecureMessageAsyncSubmitKeyStream( );
+            }
+            else
+            {
+                UnsecureMessageAsyncDecryptFOpts( );
+            }
+            break;
+        }
+        case CRYPTO_ASYNC_STEP_DECRYPT_PAYLOAD:
+        {
+            ApplyKeyStream( macMsg->FRMPayload + CryptoAsyncCtx.BufferIndex, job->EncBuffer,
+                            MIN( job->Size, macMsg->FRMPayloadSize - CryptoAsyncCtx.BufferIndex ) );
+            CryptoAsyncCtx.Ctr += job->Size / 16;
+            CryptoAsyncCtx.BufferIndex += job->Size;
+            if( CryptoAsyncCtx.BufferIndex < macMsg->FRMPayloadSize )
+            {
+                UnsecureMessageAsyncSubmitKeyStream( );
+            }
+            else
+            {
+                UnsecureMessageAsyncDecryptFOpts( );
+            }
+            break;
+        }
+        case CRYPTO_ASYNC_STEP_DECRYPT_FOPTS:
+        {
+            ApplyKeyStream( macMsg->FHDR.FOpts, job->EncBuffer, macMsg->FHDR.FCtrl.Bits.FOptsLen );
+            UnsecureMessageAsyncDone( LORAMAC_CRYPTO_SUCCESS );
+            break;
+        }
+        default:
+            UnsecureMessageAsyncDone( LORAMAC_CRYPTO_ERROR );
+            break;
+    }
+}
+
+LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessageAsync( AddressIdentifier_t addrID, uint32_t address, FCntIdentifier_t fCntID, uint32_t fCntDown, LoRaMacMessageData_t* macMsg,
+                                                         LoRaMacCryptoAsyncCallback callback, void* context )
+{
+    if( ( macMsg == NULL ) || ( callback == NULL ) )
+    {
+        return LORAMAC_CRYPTO_ERROR_NPE;
+    }
+
+    if( CryptoAsyncCtx.IsBusy == true )
+    {
+        return LORAMAC_CRYPTO_ERROR;
+    }
+
+    if( CheckFCntDown( fCntID, fCntDown ) == false )
+    {
+        return LORAMAC_CRYPTO_FAIL_FCNT_SMALLER;
+    }
+
+    LoRaMacCryptoStatus_t retval = LORAMAC_CRYPTO_ERROR;
+    KeyAddr_t* curItem;
+    SecureElementJob_t* job = &CryptoAsyncCtx.Job;
+
+    // Parse the message
+    if( LoRaMacParserData( macMsg ) != LORAMAC_PARSER_SUCCESS )
+    {
+        return LORAMAC_CRYPTO_ERROR_PARSER;
+    }
+
+    // Determine current security context
+    retval = GetKeyAddrItem( addrID, &curItem );
+    if( retval != LORAMAC_CRYPTO_SUCCESS )
+    {
+        return retval;
+    }
+
+    // Check if it is our address
+    if( address != macMsg->FHDR.DevAddr )
+    {
+        return LORAMAC_CRYPTO_FAIL_ADDRESS;
+    }
+
+    if( ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ) > CRYPTO_MAXMESSAGE_SIZE )
+    {
+        return LORAMAC_CRYPTO_ERROR_BUF_SIZE;
+    }
+
+    CryptoAsyncCtx.AddrID = addrID;
+    CryptoAsyncCtx.Address = address;
+    CryptoAsyncCtx.FCntID = fCntID;
+    CryptoAsyncCtx.FCntDown = fCntDown;
+    CryptoAsyncCtx.MacMsg = macMsg;
+    CryptoAsyncCtx.PayloadKeyID = curItem->AppSkey;
+    CryptoAsyncCtx.Callback = callback;
+    CryptoAsyncCtx.Context = context;
+
+    // Compute mic
+    bool isAck = macMsg->FHDR.FCtrl.Bits.Ack;
+    if( CryptoCtx.NvmCtx->LrWanVersion.Fields.Minor == 0 )
+    {
+        // In legacy mode the IsAck parameter is forced to be false since the ConfFCnt field is not used.
+        isAck = false;
+    }
+
+    // Verify mic on B0 | msg
+    PrepareB0( ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ), curItem->NwkSkey, isAck, DOWNLINK, address, fCntDown, CryptoAsyncCtx.Buffer );
+    memcpy1( ( CryptoAsyncCtx.Buffer + MIC_BLOCK_BX_SIZE ), macMsg->Buffer, ( macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE ) );
+
+    CryptoAsyncCtx.Step = CRYPTO_ASYNC_STEP_VERIFY_MIC;
+    job->Type = SECURE_ELEMENT_JOB_AES_CMAC_VERIFY;
+    job->KeyID = curItem->NwkSkey;
+    job->Buffer = CryptoAsyncCtx.Buffer;
+    job->Size = macMsg->BufSize - LORAMAC_MIC_FIELD_SIZE + MIC_BLOCK_BX_SIZE;
+    job->Cmac = macMsg->MIC;
+    job->Callback = UnsecureMessageAsyncStep;
+    job->Context = NULL;
+    if( SecureElementSubmitJob( job ) != SECURE_ELEMENT_SUCCESS )
+    {
+        return LORAMAC_CRYPTO_ERROR_SECURE_ELEMENT_FUNC;
+    }
+    CryptoAsyncCtx.IsBusy = true;
+
+    return LORAMAC_CRYPTO_SUCCESS;
+}
+#endif
+
 LoRaMacCryptoStatus_t LoRaMacCryptoDeriveMcRootKey( KeyIdentifier_t keyID )
 {
     // Prevent other keys than AppKey
@@ -164,6 +164,50 @@ typedef enum eLoRaMacCryptoStatus
  */
 typedef void ( *LoRaMacCryptoNvmEvent )( void );
 
+/*!
+ * Signature of callback function to be called by the LoRaMac Crypto module when an
+ * asynchronous operation completes.
+ *
+ * \param[IN]     status          - Status of the operation
+ * \param[IN]     context         - Context given when the operation has been started
+ */
+typedef void ( *LoRaMacCryptoAsyncCallback )( LoRaMacCryptoStatus_t status, void* context );
+
+/*!
+ * Uplink secured ahead of its transmission by \ref LoRaMacCryptoPrepareSecureMessage
+ */
+typedef struct sLoRaMacCryptoPreparedMsg
+{
+    /*!
+     * Set when the prepared fields belong to the current uplink
+     */
+    bool IsValid;
+    /*!
+     * Uplink sequence counter used to prepare the message
+     */
+    uint32_t FCntUp;
+    /*!
+     * Data rate and channel independent MIC part. Complete MIC in LoRaWAN 1.0.x mode.
+     */
+    uint32_t CmacF;
+    /*!
+     * Set when CmacS holds the B1 MIC part computed for TxDr and TxCh
+     */
+    bool IsCmacSValid;
+    /*!
+     * Data rate used to compute CmacS
+     */
+    uint8_t TxDr;
+    /*!
+     * Index of the channel used to compute CmacS
+     */
+    uint8_t TxCh;
+    /*!
+     * Data rate and channel dependent MIC part ( LoRaWAN 1.1.x only )
+     */
+    uint32_t CmacS;
+}LoRaMacCryptoPreparedMsg_t;
+
 /*!
  * Initialization of LoRaMac Crypto module
  * It sets initial values of volatile variables and assigns the non-volatile context.
@@ -201,6 +245,16 @@ LoRaMacCryptoStatus_t LoRaMacCryptoRestoreNvmCtx( void* cryptoNvmCtx );
  */
 void* LoRaMacCryptoGetNvmCtx( size_t* cryptoNvmCtxSize );
 
+/*!
+ * Uses the passed storage as non-volatile context, without copying it.
+ * Used to switch between the contexts of several LoRaMac instances.
+ *
+ * \param[IN]     cryptoNvmCtx     - Storage of at least the size returned by
+ *                                   LoRaMacCryptoGetNvmCtx. NULL binds the
+ *                                   module storage again.
+ */
+void LoRaMacCryptoBindNvmCtx( void* cryptoNvmCtx );
+
 /*!
  * Returns updated fCntID downlink counter value.
  *
@@ -287,6 +341,38 @@ LoRaMacCryptoStatus_t LoRaMacCryptoHandleJoinAccept( JoinReqIdentifier_t joinReq
  */
 LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg );
 
+/*!
+ * Secures a message ahead of its transmission. Encrypts the FRMPayload and
+ * FOpts fields, serializes the message and computes the MIC parts which don't
+ * depend on the transmission data rate and channel. For LoRaWAN 1.1.x the
+ * remaining part is precomputed for the expected data rate and channel.
+ *
+ * \remark The message must be completed by \ref LoRaMacCryptoSecurePreparedMessage
+ *         without being modified in between.
+ *
+ * \param[IN]     fCntUp          - Uplink sequence counter
+ * \param[IN]     txDr            - Expected data rate of the transmission
+ * \param[IN]     txCh            - Expected index of the channel of the transmission
+ * \param[IN/OUT] macMsg          - Data message object
+ * \param[OUT]    preparedMsg     - Prepared message state
+ * \retval                        - Status of the operation
+ */
+LoRaMacCryptoStatus_t LoRaMacCryptoPrepareSecureMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg, LoRaMacCryptoPreparedMsg_t* preparedMsg );
+
+/*!
+ * Completes the integrity of a message prepared by \ref LoRaMacCryptoPrepareSecureMessage.
+ * Only the LoRaWAN 1.1.x B1 MIC part is computed, unless it has been precomputed
+ * for txDr and txCh. Can be called again for the retransmissions of the message.
+ *
+ * \param[IN]     fCntUp          - Uplink sequence counter
+ * \param[IN]     txDr            - Data rate used for the transmission
+ * \param[IN]     txCh            - Index of the channel used for the transmission
+ * \param[IN/OUT] macMsg          - Data message object
+ * \param[IN/OUT] preparedMsg     - Prepared message state
+ * \retval                        - Status of the operation
+ */
+LoRaMacCryptoStatus_t LoRaMacCryptoSecurePreparedMessage( uint32_t fCntUp, uint8_t txDr, uint8_t txCh, LoRaMacMessageData_t* macMsg, LoRaMacCryptoPreparedMsg_t* preparedMsg );
+
 /*!
  * Unsecures a message (decryption + integrity verification).
  *
@@ -299,6 +385,28 @@ LoRaMacCryptoStatus_t LoRaMacCryptoSecureMessage( uint32_t fCntUp, uint8_t txDr,
  */
 LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessage( AddressIdentifier_t addrID, uint32_t address, FCntIdentifier_t fCntID, uint32_t fCntDown, LoRaMacMessageData_t* macMsg );
 
+#if defined( SECURE_ELEMENT_ASYNC_ENABLED )
+/*!
+ * Unsecures a message (decryption + integrity verification) with asynchronous
+ * secure element jobs. The key stream blocks are batched, several blocks per job.
+ *
+ * \remark The callback is called from SecureElementProcess once the message has
+ *         been unsecured. It isn't called when an error status is returned.
+ *         A single message is unsecured at a time.
+ *
+ * \param[IN]     addrID          - Address identifier
+ * \param[IN]     address         - Address
+ * \param[IN]     fCntID          - Frame counter identifier
+ * \param[IN]     fCntDown        - Downlink sequence counter
+ * \param[IN/OUT] macMsg          - Data message object. Must stay valid until the callback.
+ * \param[IN]     callback        - Function called when the operation completes
+ * \param[IN]     context         - Context given to the callback
+ * \retval                        - Status of the operation start
+ */
+LoRaMacCryptoStatus_t LoRaMacCryptoUnsecureMessageAsync( AddressIdentifier_t addrID, uint32_t address, FCntIdentifier_t fCntID, uint32_t fCntDown, LoRaMacMessageData_t* macMsg,
+                                                         LoRaMacCryptoAsyncCallback callback, void* context );
+#endif
+
 /*!
  * Derives the McRootKey from the AppKey.
  *
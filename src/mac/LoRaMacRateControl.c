@@ -0,0 +1,406 @@
+/*!
+ * \file      LoRaMacRateControl.c
+ *
+ * \brief     LoRa MAC device side datarate and TX power selection
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "utilities.h"
+#include "region/Region.h"
+#include "LoRaMacRateControl.h"
+
+/*!
+ * Target ratio of acknowledged transmissions in percent
+ */
+#ifndef RATE_CONTROL_TARGET_DELIVERY
+#define RATE_CONTROL_TARGET_DELIVERY                90
+#endif
+
+/*!
+ * Minimum link margin in dB above the demodulation SNR floor, used while the
+ * delivery statistics of a datarate are insufficient
+ */
+#ifndef RATE_CONTROL_MIN_MARGIN
+#define RATE_CONTROL_MIN_MARGIN                     6
+#endif
+
+/*!
+ * Number of confirmed transmissions needed before the delivery ratio of a
+ * datarate overrides its link margin estimate
+ */
+#define RATE_CONTROL_MIN_SAMPLES                    4
+
+/*!
+ * Number of uplinks after which the statistics of an unused datarate, or the
+ * link SNR without any downlink, are considered outdated
+ */
+#define RATE_CONTROL_MAX_AGE                        32
+
+/*!
+ * Uplink loss in dB added for each transmission of a confirmed uplink not
+ * acknowledged although its TX power kept a positive link margin
+ */
+#define RATE_CONTROL_UPLINK_LOSS_STEP               2
+
+/*!
+ * Uplink loss in 1/16 dB removed for each confirmed uplink acknowledged on its
+ * first transmission
+ */
+#define RATE_CONTROL_UPLINK_LOSS_DECAY              2
+
+/*!
+ * Maximum uplink loss in dB
+ */
+#define RATE_CONTROL_MAX_UPLINK_LOSS                20
+
+/*!
+ * Receiver noise floor in dBm for a 125 kHz bandwidth and a 6 dB noise figure
+ */
+#define RATE_CONTROL_NOISE_FLOOR                    -117
+
+/*!
+ * SNR in dB above which the radio SNR estimate saturates. The link SNR is then
+ * derived from the RSSI.
+ */
+#define RATE_CONTROL_SNR_SATURATION                 5
+
+/*!
+ * TX power step in dB between two consecutive TX power indexes
+ */
+#define RATE_CONTROL_TX_POWER_STEP                  2
+
+/*!
+ * Converts dB to the 1/16 dB fixed point unit used by the engine
+ */
+#define RATE_CONTROL_DB( x )                        ( ( int16_t )( ( x ) * 16 ) )
+
+/*!
+ * Delivery ratio of 100 % in the Q8 fixed point unit used by the engine
+ */
+#define RATE_CONTROL_DELIVERY_MAX                   256
+
+/*!
+ * \brief Gets the spreading factor and the bandwidth of a LoRa datarate
+ *
+ * \param [IN]  ctx      Engine instance context
+ * \param [IN]  datarate Datarate
+ * \param [OUT] sf       Spreading factor
+ * \param [OUT] bw       Bandwidth index [0: 125 kHz, 1: 250 kHz, 2: 500 kHz]
+ *
+ * \retval status [true: LoRa datarate, false: other modulation]
+ */
+static bool GetLoRaParams( RateControlLinkMarginCtx_t* ctx, int8_t datarate, uint8_t* sf, uint8_t* bw )
+{
+    GetPhyParams_t getPhy;
+    PhyParam_t phyParam;
+
+    getPhy.Datarate = datarate;
+    getPhy.Attribute = PHY_SF_FROM_DR;
+    phyParam = RegionGetPhyParam( ctx->Region, &getPhy );
+    *sf = phyParam.Value;
+
+    getPhy.Attribute = PHY_BW_FROM_DR;
+    phyParam = RegionGetPhyParam( ctx->Region, &getPhy );
+    *bw = phyParam.Value;
+
+    return ( *sf >= 5 ) && ( *sf <= 12 ) && ( *bw <= 2 );
+}
+
+/*!
+ * \brief Gets the demodulation SNR floor of a spreading factor
+ *
+ * \param [IN] sf Spreading factor
+ *
+ * \retval snr SNR floor in 1/16 dB
+ */
+static int16_t GetRequiredSnr( uint8_t sf )
+{
+    if( sf <= 6 )
+    {
+        return RATE_CONTROL_DB( -5 );
+    }
+    // -7.5 dB at SF7, 2.5 dB less per spreading factor increment
+    return -( RATE_CONTROL_DB( 7.5 ) + ( RATE_CONTROL_DB( 2.5 ) * ( sf - 7 ) ) );
+}
+
+/*!
+ * \brief Estimates the uplink link margin of a datarate at a TX power
+ *
+ * \param [IN]  ctx      Engine instance context
+ * \param [IN]  datarate Datarate
+ * \param [IN]  txPower  TX power index
+ * \param [OUT] margin   Margin above the demodulation SNR floor in 1/16 dB
+ *
+ * \retval status [true: margin estimated, false: other modulation]
+ */
+static bool GetMargin( RateControlLinkMarginCtx_t* ctx, int8_t datarate, int8_t txPower, int16_t* margin )
+{
+    uint8_t sf = 0;
+    uint8_t bw = 0;
+
+    if( GetLoRaParams( ctx, datarate, &sf, &bw ) == false )
+    {
+        return false;
+    }
+    *margin = ctx->LinkSnr - ctx->UplinkLoss - RATE_CONTROL_DB( 3 * bw ) - GetRequiredSnr( sf ) -
+              RATE_CONTROL_DB( RATE_CONTROL_TX_POWER_STEP * ( txPower - ctx->MaxTxPower ) );
+    return true;
+}
+
+/*!
+ * \brief Ages the statistics not refreshed by the last uplink and clears the
+ *        outdated ones
+ *
+ * \param [IN] stats Statistics
+ */
+static void AgeStats( RateControlStats_t* stats )
+{
+    if( stats->Age < RATE_CONTROL_MAX_AGE )
+    {
+        stats->Age++;
+    }
+    else
+    {
+        // Outdated, fall back on the link margin estimate
+        stats->Delivery = RATE_CONTROL_DELIVERY_MAX;
+        stats->Samples = 0;
+    }
+}
+
+/*!
+ * \brief Adds the transmissions of a confirmed uplink to the statistics
+ *
+ * \param [IN] stats       Statistics
+ * \param [IN] ackReceived Set to true when the uplink was acknowledged
+ * \param [IN] nbTrials    Number of transmissions of the uplink
+ */
+static void AddStats( RateControlStats_t* stats, bool ackReceived, uint8_t nbTrials )
+{
+    nbTrials = MAX( nbTrials, 1 );
+    for( uint8_t i = 0; i < nbTrials; i++ )
+    {
+        // Only the last transmission may have been acknowledged
+        int16_t delivered = ( ( ackReceived == true ) && ( i == ( nbTrials - 1 ) ) ) ? RATE_CONTROL_DELIVERY_MAX : 0;
+
+        stats->Delivery += ( delivered - stats->Delivery ) / 8;
+    }
+    stats->Samples = MIN( stats->Samples + nbTrials, UINT8_MAX );
+}
+
+/*!
+ * \brief Checks the delivery ratio of the statistics against the target
+ *
+ * \param [IN] stats Statistics
+ *
+ * \retval status [true: target met or not enough samples, false: target missed]
+ */
+static bool IsDeliveryMet( RateControlStats_t* stats )
+{
+    if( stats->Samples < RATE_CONTROL_MIN_SAMPLES )
+    {
+        return true;
+    }
+    return ( stats->Delivery * 100 ) >= ( RATE_CONTROL_TARGET_DELIVERY * RATE_CONTROL_DELIVERY_MAX );
+}
+
+static void Init( void* context, LoRaMacRegion_t region )
+{
+    RateControlLinkMarginCtx_t* ctx = ( RateControlLinkMarginCtx_t* )context;
+    GetPhyParams_t getPhy;
+    PhyParam_t phyParam;
+
+    memset1( ( uint8_t* )ctx, 0, sizeof( RateControlLinkMarginCtx_t ) );
+    ctx->Region = region;
+
+    getPhy.Attribute = PHY_DEF_UPLINK_DWELL_TIME;
+    phyParam = RegionGetPhyParam( region, &getPhy );
+    ctx->UplinkDwellTime = phyParam.Value;
+
+    getPhy.UplinkDwellTime = ctx->UplinkDwellTime;
+    getPhy.Attribute = PHY_MAX_TX_POWER;
+    phyParam = RegionGetPhyParam( region, &getPhy );
+    ctx->MaxTxPower = phyParam.Value;
+
+    for( uint8_t i = 0; i < RATE_CONTROL_NB_DATARATES; i++ )
+    {
+        ctx->Stats[i].Delivery = RATE_CONTROL_DELIVERY_MAX;
+    }
+}
+
+static void OnUplinkDone( void* context, int8_t datarate, int8_t txPower, bool ackRequested, bool ackReceived, uint8_t nbTrials )
+{
+    RateControlLinkMarginCtx_t* ctx = ( RateControlLinkMarginCtx_t* )context;
+    int16_t margin = 0;
+
+    if( ( datarate < 0 ) || ( datarate >= RATE_CONTROL_NB_DATARATES ) )
+    {
+        return;
+    }
+
+    if( ( ackRequested == true ) && ( ctx->LinkSnrSamples != 0 ) &&
+        ( GetMargin( ctx, datarate, txPower, &margin ) == true ) )
+    {
+        uint8_t nbLost = MAX( nbTrials, 1 ) - ( ( ackReceived == true ) ? 1 : 0 );
+
+        if( nbLost == 0 )
+        {
+            ctx->UplinkLoss = MAX( ctx->UplinkLoss - RATE_CONTROL_UPLINK_LOSS_DECAY, 0 );
+        }
+        else if( margin >= 0 )
+        {
+            // Lost although the link margin at this TX power was positive,
+            // the uplink is weaker than the downlinks tell
+            ctx->UplinkLoss = MIN( ctx->UplinkLoss + ( nbLost * RATE_CONTROL_DB( RATE_CONTROL_UPLINK_LOSS_STEP ) ),
+                                   RATE_CONTROL_DB( RATE_CONTROL_MAX_UPLINK_LOSS ) );
+        }
+    }
+
+    for( uint8_t i = 0; i < RATE_CONTROL_NB_DATARATES; i++ )
+    {
+        AgeStats( &ctx->Stats[i] );
+    }
+    if( ctx->LinkSnrAge < RATE_CONTROL_MAX_AGE )
+    {
+        ctx->LinkSnrAge++;
+    }
+    else
+    {
+        ctx->LinkSnrSamples = 0;
+    }
+
+    ctx->Stats[datarate].Age = 0;
+    if( ackRequested == false )
+    {
+        // Unconfirmed uplinks don't tell if they were delivered
+        return;
+    }
+    AddStats( &ctx->Stats[datarate], ackReceived, nbTrials );
+}
+
+static void OnDownlink( void* context, int8_t datarate, int16_t rssi, int8_t snr )
+{
+    RateControlLinkMarginCtx_t* ctx = ( RateControlLinkMarginCtx_t* )context;
+    int16_t linkSnr = RATE_CONTROL_DB( snr );
+    uint8_t sf = 0;
+    uint8_t bw = 0;
+
+    if( GetLoRaParams( ctx, datarate, &sf, &bw ) == false )
+    {
+        return;
+    }
+
+    if( snr >= RATE_CONTROL_SNR_SATURATION )
+    {
+        linkSnr = MAX( linkSnr, RATE_CONTROL_DB( rssi - RATE_CONTROL_NOISE_FLOOR - ( 3 * bw ) ) );
+    }
+    // Normalize to 125 kHz, the noise power doubles with the bandwidth
+    linkSnr += RATE_CONTROL_DB( 3 * bw );
+
+    if( ctx->LinkSnrSamples == 0 )
+    {
+        ctx->LinkSnr = linkSnr;
+    }
+    else
+    {
+        ctx->LinkSnr += ( linkSnr - ctx->LinkSnr ) / 4;
+    }
+    if( ctx->LinkSnrSamples < UINT8_MAX )
+    {
+        ctx->LinkSnrSamples++;
+    }
+    ctx->LinkSnrAge = 0;
+}
+
+static bool GetNext( void* context, int8_t* datarate, int8_t* txPower )
+{
+    RateControlLinkMarginCtx_t* ctx = ( RateControlLinkMarginCtx_t* )context;
+    GetPhyParams_t getPhy;
+    PhyParam_t phyParam;
+    VerifyParams_t verify;
+    int8_t minDatarate = 0;
+    int16_t margin = 0;
+    int16_t steps = 0;
+    bool found = false;
+
+    if( ctx->LinkSnrSamples == 0 )
+    {
+        return false;
+    }
+
+    getPhy.UplinkDwellTime = ctx->UplinkDwellTime;
+    getPhy.Attribute = PHY_MIN_TX_DR;
+    phyParam = RegionGetPhyParam( ctx->Region, &getPhy );
+    minDatarate = phyParam.Value;
+
+    // Fallback when no datarate meets the target
+    *datarate = minDatarate;
+    *txPower = ctx->MaxTxPower;
+
+    // Fastest datarate first. The region validates the datarates.
+    for( int8_t dr = RATE_CONTROL_NB_DATARATES - 1; dr >= minDatarate; dr-- )
+    {
+        bool isSuitable = false;
+
+        verify.DatarateParams.Datarate = dr;
+        verify.DatarateParams.UplinkDwellTime = ctx->UplinkDwellTime;
+        if( ( RegionVerify( ctx->Region, &verify, PHY_TX_DR ) == false ) ||
+            ( GetMargin( ctx, dr, ctx->MaxTxPower, &margin ) == false ) )
+        {
+            continue;
+        }
+
+        if( ctx->Stats[dr].Samples >= RATE_CONTROL_MIN_SAMPLES )
+        {
+            isSuitable = IsDeliveryMet( &ctx->Stats[dr] );
+        }
+        else
+        {
+            isSuitable = ( margin >= RATE_CONTROL_DB( RATE_CONTROL_MIN_MARGIN ) );
+        }
+        if( isSuitable == true )
+        {
+            *datarate = dr;
+            found = true;
+            break;
+        }
+    }
+    if( found == false )
+    {
+        // The most robust datarate is used at the maximum power
+        return true;
+    }
+
+    // Lowest TX power keeping the minimum margin
+    steps = ( margin - RATE_CONTROL_DB( RATE_CONTROL_MIN_MARGIN ) ) / RATE_CONTROL_DB( RATE_CONTROL_TX_POWER_STEP );
+    for( int8_t power = ctx->MaxTxPower + MAX( steps, 0 ); power > ctx->MaxTxPower; power-- )
+    {
+        verify.TxPower = power;
+        if( RegionVerify( ctx->Region, &verify, PHY_TX_POWER ) == true )
+        {
+            *txPower = power;
+            break;
+        }
+    }
+    return true;
+}
+
+const LoRaMacRateControl_t LoRaMacRateControlLinkMargin =
+{
+    .Init = Init,
+    .OnUplinkDone = OnUplinkDone,
+    .OnDownlink = OnDownlink,
+    .GetNext = GetNext,
+};
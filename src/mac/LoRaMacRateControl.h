@@ -0,0 +1,173 @@
+/*!
+ * \file      LoRaMacRateControl.h
+ *
+ * \brief     LoRa MAC device side datarate and TX power selection
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \defgroup  LORAMACRATECONTROL LoRa MAC device side rate control
+ *            Selects the uplink datarate and TX power when the network ADR is
+ *            off, e.g. on mobile devices. The engine is pluggable: the upper
+ *            layer feeds it with the uplink results and the downlink link
+ *            quality and queries it before each uplink.
+ * \{
+ */
+#ifndef __LORAMAC_RATE_CONTROL_H__
+#define __LORAMAC_RATE_CONTROL_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "LoRaMac.h"
+
+/*!
+ * Rate control engine. The hooks operate on the context of the engine instance
+ * given to \ref LmHandlerSetRateControl, one context per device.
+ */
+typedef struct sLoRaMacRateControl
+{
+    /*!
+     * \brief Initializes the engine and clears its statistics
+     *
+     * \param [IN] ctx    Engine instance context
+     * \param [IN] region Active region
+     */
+    void ( *Init )( void* ctx, LoRaMacRegion_t region );
+    /*!
+     * \brief Notifies the result of an uplink. To be called on MCPS-Confirm.
+     *
+     * \param [IN] ctx          Engine instance context
+     * \param [IN] datarate     Datarate of the uplink
+     * \param [IN] txPower      TX power index of the uplink
+     * \param [IN] ackRequested Set to true for a confirmed uplink
+     * \param [IN] ackReceived  Set to true when the uplink was acknowledged
+     * \param [IN] nbTrials     Number of transmissions of the uplink
+     */
+    void ( *OnUplinkDone )( void* ctx, int8_t datarate, int8_t txPower, bool ackRequested, bool ackReceived, uint8_t nbTrials );
+    /*!
+     * \brief Notifies the reception of a downlink. To be called on
+     *        MCPS-Indication.
+     *
+     * \param [IN] ctx      Engine instance context
+     * \param [IN] datarate Datarate of the downlink
+     * \param [IN] rssi     RSSI of the downlink in dBm
+     * \param [IN] snr      SNR of the downlink in dB
+     */
+    void ( *OnDownlink )( void* ctx, int8_t datarate, int16_t rssi, int8_t snr );
+    /*!
+     * \brief Selects the datarate and TX power of the next uplink
+     *
+     * \param [IN]  ctx      Engine instance context
+     * \param [OUT] datarate Datarate of the next uplink
+     * \param [OUT] txPower  TX power index of the next uplink
+     *
+     * \retval status [true: datarate and txPower selected,
+     *                 false: not enough statistics, keep the current ones]
+     */
+    bool ( *GetNext )( void* ctx, int8_t* datarate, int8_t* txPower );
+}LoRaMacRateControl_t;
+
+/*!
+ * Maximum number of datarates tracked by \ref LoRaMacRateControlLinkMargin
+ */
+#define RATE_CONTROL_NB_DATARATES                   16
+
+/*!
+ * Delivery statistics of a datarate
+ */
+typedef struct sRateControlStats
+{
+    /*!
+     * Moving average of the acknowledged transmissions ratio, Q8
+     */
+    int16_t Delivery;
+    /*!
+     * Number of confirmed transmissions in the average
+     */
+    uint8_t Samples;
+    /*!
+     * Number of uplinks since the datarate was used
+     */
+    uint8_t Age;
+}RateControlStats_t;
+
+/*!
+ * \ref LoRaMacRateControlLinkMargin instance context
+ */
+typedef struct sRateControlLinkMarginCtx
+{
+    /*!
+     * Active region
+     */
+    LoRaMacRegion_t Region;
+    /*!
+     * Uplink dwell time of the region
+     */
+    uint8_t UplinkDwellTime;
+    /*!
+     * Maximum TX power index of the region
+     */
+    int8_t MaxTxPower;
+    /*!
+     * Moving average of the link SNR normalized to 125 kHz, 1/16 dB
+     */
+    int16_t LinkSnr;
+    /*!
+     * Number of downlinks in the link SNR average
+     */
+    uint8_t LinkSnrSamples;
+    /*!
+     * Number of uplinks since the last downlink
+     */
+    uint8_t LinkSnrAge;
+    /*!
+     * Per datarate statistics
+     */
+    RateControlStats_t Stats[RATE_CONTROL_NB_DATARATES];
+    /*!
+     * Uplink loss not seen on the downlinks, 1/16 dB. Learned from the
+     * acknowledgements of the uplinks at their TX power.
+     */
+    int16_t UplinkLoss;
+}RateControlLinkMarginCtx_t;
+
+/*!
+ * Link margin rate control engine, operating on a \ref RateControlLinkMarginCtx_t
+ *
+ * Estimates the link SNR from the downlinks and tracks per datarate the ratio
+ * of acknowledged transmissions of the confirmed uplinks. Selects the fastest
+ * datarate whose delivery ratio meets \ref RATE_CONTROL_TARGET_DELIVERY or,
+ * without enough acknowledgement statistics, whose link margin meets
+ * \ref RATE_CONTROL_MIN_MARGIN, then the lowest TX power keeping that margin.
+ * The region limits are queried with \ref RegionGetPhyParam.
+ *
+ * \remark The uplink SNR at the gateway is estimated from the downlink SNR at
+ *         the device, minus the uplink loss learned from the confirmed
+ *         uplinks lost or retransmitted at the selected TX power.
+ */
+extern const LoRaMacRateControl_t LoRaMacRateControlLinkMargin;
+
+/*! \} defgroup LORAMACRATECONTROL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LORAMAC_RATE_CONTROL_H__
@@ -0,0 +1,950 @@
+/*!
+ * \file      LoRaMacReplay.c
+ *
+ * \brief     LoRa MAC replay of recorded radio, timer and request events
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include "LoRaMacReplay.h"
+
+#if defined( EVENT_LOG_REPLAY_ENABLED )
+
+#if !defined( EVENT_LOG_ENABLED )
+#error "The replay driver checks the records of the replayed LoRaMAC, EVENT_LOG_ENABLED must be defined"
+#endif
+
+#include <string.h>
+#include <time.h>
+#include "utilities.h"
+#include "eventlog.h"
+#include "timer.h"
+#include "rtc-board.h"
+#include "radio.h"
+#include "secure-element.h"
+#include "LoRaMac.h"
+
+/*!
+ * Minimum alarm timeout of the virtual RTC in ticks
+ */
+#define REPLAY_RTC_MIN_TIMEOUT                      3
+
+/*!
+ * Maximum number of process function calls after an event
+ */
+#define REPLAY_MAX_PROCESS_CALLS                    16
+
+/*!
+ * Size of the buffer holding the records produced during the replay until
+ * they are checked
+ */
+#define REPLAY_OUTPUT_BUFFER_SIZE                   ( EVENT_LOG_BUFFER_SIZE + EVENT_LOG_HEADER_SIZE )
+
+/*!
+ * Replay driver context
+ */
+typedef struct sReplayCtx
+{
+    /*!
+     * Recorded log. Offset points to the next record to be replayed or
+     * matched.
+     */
+    EventLogReader_t Log;
+    /*!
+     * Next random number record to be returned by the virtual radio
+     */
+    EventLogReader_t Random;
+    /*!
+     * Records produced during the replay which aren't checked yet
+     */
+    uint8_t Output[REPLAY_OUTPUT_BUFFER_SIZE];
+    uint16_t OutputSize;
+    /*!
+     * RTC timer value of the last checked record. Valid once the header of
+     * the produced log is checked.
+     */
+    uint32_t OutputTime;
+    bool IsOutputStarted;
+    /*!
+     * Time tolerance in ticks
+     */
+    uint32_t Tolerance;
+    /*!
+     * Virtual RTC
+     */
+    struct
+    {
+        uint32_t Now;
+        uint32_t Context;
+        uint32_t Alarm;
+        bool IsAlarmArmed;
+        uint32_t Backup[2];
+    }Rtc;
+    /*!
+     * Virtual radio
+     */
+    struct
+    {
+        RadioEvents_t* Events;
+        RadioState_t State;
+        bool RxContinuous;
+        uint32_t WakeupTime;
+        uint8_t Buffer[256];
+    }Radio;
+    /*!
+     * Buffers of the injected MCPS and MLME requests
+     */
+    uint8_t RequestBuffer[256];
+    uint8_t RequestEui[SE_EUI_SIZE];
+    LoRaMacReplayStats_t Stats;
+}ReplayCtx_t;
+
+static ReplayCtx_t Ctx;
+
+static uint32_t ReplayGetUint32( const uint8_t* buffer )
+{
+    return ( uint32_t )buffer[0] | ( ( uint32_t )buffer[1] << 8 ) |
+           ( ( uint32_t )buffer[2] << 16 ) | ( ( uint32_t )buffer[3] << 24 );
+}
+
+static uint64_t ReplayGetHostTime( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( ( uint64_t )ts.tv_sec * 1000000000UL ) + ts.tv_nsec;
+}
+
+static void ReplayDivergence( void )
+{
+    if( Ctx.Stats.Divergences == 0 )
+    {
+        Ctx.Stats.FirstDivergence = Ctx.Log.Offset;
+    }
+    Ctx.Stats.Divergences++;
+}
+
+/*!
+ * \brief Checks if a record is injected by the replay driver. The other
+ *        records are produced by the LoRaMAC and checked.
+ */
+static bool ReplayIsInput( EventLogType_t type )
+{
+    switch( type )
+    {
+        case EVENT_LOG_MCPS_REQUEST:
+        case EVENT_LOG_MLME_REQUEST:
+        case EVENT_LOG_RADIO_TX_DONE:
+        case EVENT_LOG_RADIO_RX_DONE:
+        case EVENT_LOG_RADIO_TX_TIMEOUT:
+        case EVENT_LOG_RADIO_RX_TIMEOUT:
+        case EVENT_LOG_RADIO_RX_ERROR:
+        case EVENT_LOG_RADIO_CHANNEL_FREE_DONE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*!
+ * \brief Checks a record produced during the replay against the next record
+ *        of the log
+ */
+static void ReplayCheck( EventLogRecord_t* record )
+{
+    EventLogReader_t next = Ctx.Log;
+    EventLogRecord_t expected;
+    uint32_t delta = 0;
+
+    if( EventLogReaderNext( &next, &expected ) == false )
+    {
+        // Produced after the end of the log
+        ReplayDivergence( );
+        return;
+    }
+
+    delta = ( record->Time > expected.Time ) ? ( record->Time - expected.Time ) : ( expected.Time - record->Time );
+    if( ( record->Type != expected.Type ) || ( record->Size != expected.Size ) ||
+        ( memcmp( record->Data, expected.Data, record->Size ) != 0 ) || ( delta > Ctx.Tolerance ) )
+    {
+        ReplayDivergence( );
+        if( record->Type != expected.Type )
+        {
+            // Unexpected record, keep waiting for the expected one
+            return;
+        }
+    }
+    Ctx.Log = next;
+    Ctx.Stats.Records++;
+}
+
+static void ReplayWrite( const uint8_t* data, uint16_t size )
+{
+    if( size > ( REPLAY_OUTPUT_BUFFER_SIZE - Ctx.OutputSize ) )
+    {
+        // Can't happen, the buffer holds the whole capture buffer
+        ReplayDivergence( );
+        size = REPLAY_OUTPUT_BUFFER_SIZE - Ctx.OutputSize;
+    }
+    memcpy1( Ctx.Output + Ctx.OutputSize, data, size );
+    Ctx.OutputSize += size;
+}
+
+/*!
+ * \brief Checks the records produced since the previous call
+ */
+static void ReplayFlush( void )
+{
+    EventLogReader_t reader;
+    EventLogRecord_t record;
+
+    EventLogProcess( );
+
+    if( Ctx.IsOutputStarted == false )
+    {
+        if( EventLogReaderInit( &reader, Ctx.Output, Ctx.OutputSize ) == false )
+        {
+            return;
+        }
+        Ctx.IsOutputStarted = true;
+    }
+    else
+    {
+        reader.Buffer = Ctx.Output;
+        reader.Size = Ctx.OutputSize;
+        reader.Offset = 0;
+        reader.Time = Ctx.OutputTime;
+        reader.Frequency = Ctx.Log.Frequency;
+    }
+
+    while( EventLogReaderNext( &reader, &record ) == true )
+    {
+        ReplayCheck( &record );
+    }
+
+    // Keep the incomplete record
+    Ctx.OutputTime = reader.Time;
+    Ctx.OutputSize -= reader.Offset;
+    memmove( Ctx.Output, Ctx.Output + reader.Offset, Ctx.OutputSize );
+}
+
+/*!
+ * \brief Calls the process function while the LoRaMAC has pending work
+ */
+static void ReplayProcess( void ( *process )( void ) )
+{
+    LoRaMacDeadline_t deadline;
+
+    for( uint8_t i = 0; i < REPLAY_MAX_PROCESS_CALLS; i++ )
+    {
+        process( );
+        if( ( LoRaMacGetNextDeadline( &deadline ) != LORAMAC_STATUS_OK ) ||
+            ( deadline.Owner != LORAMAC_DEADLINE_PROCESS ) )
+        {
+            break;
+        }
+    }
+}
+
+static void ReplayAddProcessTime( uint64_t start )
+{
+    uint64_t duration = ReplayGetHostTime( ) - start;
+
+    Ctx.Stats.ProcessTime += duration;
+    if( duration > Ctx.Stats.MaxProcessTime )
+    {
+        Ctx.Stats.MaxProcessTime = ( uint32_t )MIN( duration, UINT32_MAX );
+    }
+}
+
+/*!
+ * \brief Fires the virtual RTC alarm if it expires at limit at the latest
+ *
+ * \retval status [true: alarm fired, false: no alarm until limit]
+ */
+static bool ReplayFireAlarm( uint32_t limit, void ( *process )( void ) )
+{
+    uint64_t start = 0;
+
+    if( ( Ctx.Rtc.IsAlarmArmed == false ) || ( ( int32_t )( Ctx.Rtc.Alarm - limit ) > 0 ) )
+    {
+        return false;
+    }
+    if( ( int32_t )( Ctx.Rtc.Alarm - Ctx.Rtc.Now ) > 0 )
+    {
+        Ctx.Rtc.Now = Ctx.Rtc.Alarm;
+    }
+    Ctx.Rtc.IsAlarmArmed = false;
+
+    start = ReplayGetHostTime( );
+    TimerIrqHandler( );
+    ReplayProcess( process );
+    ReplayAddProcessTime( start );
+
+    ReplayFlush( );
+    return true;
+}
+
+static void ReplayMcpsRequest( const EventLogRecord_t* record )
+{
+    McpsReq_t mcpsReq;
+    uint16_t fBufferSize = 0;
+
+    if( record->Size < 4 )
+    {
+        return;
+    }
+    fBufferSize = record->Size - 4;
+    memcpy1( Ctx.RequestBuffer, record->Data + 4, MIN( fBufferSize, sizeof( Ctx.RequestBuffer ) ) );
+
+    memset1( ( uint8_t* )&mcpsReq, 0, sizeof( mcpsReq ) );
+    mcpsReq.Type = ( Mcps_t )record->Data[0];
+    switch( mcpsReq.Type )
+    {
+        case MCPS_UNCONFIRMED:
+        {
+            mcpsReq.Req.Unconfirmed.fPort = record->Data[1];
+            mcpsReq.Req.Unconfirmed.Datarate = ( int8_t )record->Data[2];
+            mcpsReq.Req.Unconfirmed.fBuffer = ( fBufferSize != 0 ) ? Ctx.RequestBuffer : NULL;
+            mcpsReq.Req.Unconfirmed.fBufferSize = fBufferSize;
+            break;
+        }
+        case MCPS_CONFIRMED:
+        {
+            mcpsReq.Req.Confirmed.fPort = record->Data[1];
+            mcpsReq.Req.Confirmed.Datarate = ( int8_t )record->Data[2];
+            mcpsReq.Req.Confirmed.NbTrials = record->Data[3];
+            mcpsReq.Req.Confirmed.fBuffer = ( fBufferSize != 0 ) ? Ctx.RequestBuffer : NULL;
+            mcpsReq.Req.Confirmed.fBufferSize = fBufferSize;
+            break;
+        }
+        case MCPS_PROPRIETARY:
+        {
+            mcpsReq.Req.Proprietary.Datarate = ( int8_t )record->Data[2];
+            mcpsReq.Req.Proprietary.fBuffer = ( fBufferSize != 0 ) ? Ctx.RequestBuffer : NULL;
+            mcpsReq.Req.Proprietary.fBufferSize = fBufferSize;
+            break;
+        }
+        default:
+            break;
+    }
+    LoRaMacMcpsRequest( &mcpsReq );
+}
+
+static void ReplayMlmeRequest( const EventLogRecord_t* record )
+{
+    MlmeReq_t mlmeReq;
+    const uint8_t* data = record->Data + 1;
+
+    if( record->Size < 1 )
+    {
+        return;
+    }
+    memset1( ( uint8_t* )&mlmeReq, 0, sizeof( mlmeReq ) );
+    mlmeReq.Type = ( Mlme_t )record->Data[0];
+    switch( mlmeReq.Type )
+    {
+        case MLME_JOIN:
+        {
+            mlmeReq.Req.Join.Datarate = data[0];
+            break;
+        }
+        case MLME_TXCW:
+        {
+            mlmeReq.Req.TxCw.Timeout = data[0] | ( data[1] << 8 );
+            mlmeReq.Req.TxCw.Frequency = ReplayGetUint32( data + 2 );
+            mlmeReq.Req.TxCw.Power = data[6];
+            break;
+        }
+        case MLME_PING_SLOT_INFO:
+        {
+            mlmeReq.Req.PingSlotInfo.PingSlot.Value = data[0];
+            break;
+        }
+        case MLME_DERIVE_MC_KE_KEY:
+        {
+            mlmeReq.Req.DeriveMcKEKey.KeyID = ( KeyIdentifier_t )data[0];
+            mlmeReq.Req.DeriveMcKEKey.Nonce = data[1] | ( data[2] << 8 );
+            if( record->Size >= ( 4 + SE_EUI_SIZE ) )
+            {
+                memcpy1( Ctx.RequestEui, data + 3, SE_EUI_SIZE );
+                mlmeReq.Req.DeriveMcKEKey.DevEUI = Ctx.RequestEui;
+            }
+            break;
+        }
+        case MLME_DERIVE_MC_KEY_PAIR:
+        {
+            mlmeReq.Req.DeriveMcSessionKeyPair.GroupID = ( AddressIdentifier_t )data[0];
+            break;
+        }
+        default:
+            break;
+    }
+    LoRaMacMlmeRequest( &mlmeReq );
+}
+
+/*!
+ * \brief Delivers a radio event to the LoRaMAC
+ */
+static void ReplayRadioEvent( const EventLogRecord_t* record )
+{
+    RadioEvents_t* events = Ctx.Radio.Events;
+
+    if( events == NULL )
+    {
+        return;
+    }
+    if( Ctx.Radio.RxContinuous == false )
+    {
+        Ctx.Radio.State = RF_IDLE;
+    }
+    switch( record->Type )
+    {
+        case EVENT_LOG_RADIO_TX_DONE:
+        {
+            Ctx.Radio.State = RF_IDLE;
+            if( events->TxDone != NULL )
+            {
+                events->TxDone( );
+            }
+            break;
+        }
+        case EVENT_LOG_RADIO_RX_DONE:
+        {
+            uint16_t size = 0;
+
+            if( ( record->Size < 3 ) || ( events->RxDone == NULL ) )
+            {
+                break;
+            }
+            // The LoRaMAC keeps a pointer to the payload until it's processed
+            size = MIN( ( uint16_t )( record->Size - 3 ), ( uint16_t )sizeof( Ctx.Radio.Buffer ) );
+            memcpy1( Ctx.Radio.Buffer, record->Data + 3, size );
+            events->RxDone( Ctx.Radio.Buffer, size, ( int16_t )( record->Data[0] | ( record->Data[1] << 8 ) ), ( int8_t )record->Data[2] );
+            break;
+        }
+        case EVENT_LOG_RADIO_TX_TIMEOUT:
+        {
+            Ctx.Radio.State = RF_IDLE;
+            if( events->TxTimeout != NULL )
+            {
+                events->TxTimeout( );
+            }
+            break;
+        }
+        case EVENT_LOG_RADIO_RX_TIMEOUT:
+        {
+            if( events->RxTimeout != NULL )
+            {
+                events->RxTimeout( );
+            }
+            break;
+        }
+        case EVENT_LOG_RADIO_RX_ERROR:
+        {
+            if( events->RxError != NULL )
+            {
+                events->RxError( );
+            }
+            break;
+        }
+        case EVENT_LOG_RADIO_CHANNEL_FREE_DONE:
+        {
+            if( ( record->Size >= 1 ) && ( events->ChannelFreeDone != NULL ) )
+            {
+                events->ChannelFreeDone( record->Data[0] != 0 );
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool LoRaMacReplayInit( const uint8_t* log, uint32_t size )
+{
+    memset1( ( uint8_t* )&Ctx, 0, sizeof( Ctx ) );
+    if( EventLogReaderInit( &Ctx.Log, log, size ) == false )
+    {
+        return false;
+    }
+    Ctx.Random = Ctx.Log;
+    Ctx.Stats.FirstDivergence = UINT32_MAX;
+    Ctx.Tolerance = ( uint32_t )( ( ( uint64_t )LORAMAC_REPLAY_TIME_TOLERANCE * Ctx.Log.Frequency ) / 1000 );
+    Ctx.Rtc.Now = Ctx.Log.Time;
+    Ctx.Rtc.Context = Ctx.Log.Time;
+    Ctx.Radio.State = RF_IDLE;
+
+    // Records produced during the replay are checked by ReplayFlush
+    EventLogInit( ReplayWrite );
+    return true;
+}
+
+bool LoRaMacReplayRun( void ( *process )( void ), LoRaMacReplayStats_t* stats )
+{
+    uint32_t start = Ctx.Log.Time;
+    EventLogReader_t next;
+    EventLogRecord_t record;
+
+    if( ( process == NULL ) || ( stats == NULL ) )
+    {
+        return false;
+    }
+
+    // Records of the initialization
+    ReplayFlush( );
+
+    while( true )
+    {
+        next = Ctx.Log;
+        if( EventLogReaderNext( &next, &record ) == false )
+        {
+            break;
+        }
+
+        if( record.Type == EVENT_LOG_GAP )
+        {
+            // The recording device dropped records, the replay diverges from here
+            Ctx.Stats.Gaps++;
+            if( record.Size >= 4 )
+            {
+                Ctx.Stats.LostRecords += ReplayGetUint32( record.Data );
+            }
+            Ctx.Log = next;
+        }
+        else if( ReplayIsInput( record.Type ) == true )
+        {
+            uint64_t hostTime = 0;
+
+            // Timers expiring ahead of the event
+            while( ReplayFireAlarm( record.Time - 1, process ) == true )
+            {
+            }
+            if( ( int32_t )( record.Time - Ctx.Rtc.Now ) > 0 )
+            {
+                Ctx.Rtc.Now = record.Time;
+            }
+
+            hostTime = ReplayGetHostTime( );
+            if( record.Type == EVENT_LOG_MCPS_REQUEST )
+            {
+                ReplayMcpsRequest( &record );
+            }
+            else if( record.Type == EVENT_LOG_MLME_REQUEST )
+            {
+                ReplayMlmeRequest( &record );
+            }
+            else
+            {
+                ReplayRadioEvent( &record );
+            }
+            ReplayProcess( process );
+            ReplayAddProcessTime( hostTime );
+
+            // The injected event is recorded again by the LoRaMAC
+            ReplayFlush( );
+            if( Ctx.Log.Offset < next.Offset )
+            {
+                ReplayDivergence( );
+                Ctx.Log = next;
+            }
+        }
+        else if( ReplayFireAlarm( record.Time + Ctx.Tolerance, process ) == false )
+        {
+            // The LoRaMAC doesn't produce the record in time
+            ReplayDivergence( );
+            Ctx.Log = next;
+        }
+    }
+
+    Ctx.Stats.VirtualTime = RtcTick2Ms( Ctx.Rtc.Now - start );
+    *stats = Ctx.Stats;
+    return ( Ctx.Stats.Divergences == 0 ) && ( Ctx.Stats.Gaps == 0 );
+}
+
+/*
+ * Virtual RTC. The timer value only changes when the replay driver moves it
+ * to the next event or alarm.
+ */
+
+void RtcInit( void )
+{
+}
+
+uint32_t RtcGetMinimumTimeout( void )
+{
+    return REPLAY_RTC_MIN_TIMEOUT;
+}
+
+uint32_t RtcMs2Tick( TimerTime_t milliseconds )
+{
+    return ( uint32_t )( ( ( uint64_t )milliseconds * Ctx.Log.Frequency ) / 1000 );
+}
+
+TimerTime_t RtcTick2Ms( uint32_t tick )
+{
+    return ( TimerTime_t )( ( ( uint64_t )tick * 1000 ) / Ctx.Log.Frequency );
+}
+
+void RtcDelayMs( TimerTime_t milliseconds )
+{
+    Ctx.Rtc.Now += RtcMs2Tick( milliseconds );
+}
+
+void RtcSetMcuWakeUpTime( void )
+{
+}
+
+int16_t RtcGetMcuWakeUpTime( void )
+{
+    return 0;
+}
+
+void RtcSetAlarm( uint32_t timeout )
+{
+    RtcStartAlarm( timeout );
+}
+
+void RtcStopAlarm( void )
+{
+    Ctx.Rtc.IsAlarmArmed = false;
+}
+
+void RtcStartAlarm( uint32_t timeout )
+{
+    Ctx.Rtc.Alarm = Ctx.Rtc.Context + timeout;
+    Ctx.Rtc.IsAlarmArmed = true;
+}
+
+uint32_t RtcSetTimerContext( void )
+{
+    Ctx.Rtc.Context = Ctx.Rtc.Now;
+    return Ctx.Rtc.Context;
+}
+
+uint32_t RtcGetTimerContext( void )
+{
+    return Ctx.Rtc.Context;
+}
+
+uint32_t RtcGetCalendarTime( uint16_t *milliseconds )
+{
+    *milliseconds = ( uint16_t )( ( ( uint64_t )( Ctx.Rtc.Now % Ctx.Log.Frequency ) * 1000 ) / Ctx.Log.Frequency );
+    return Ctx.Rtc.Now / Ctx.Log.Frequency;
+}
+
+uint32_t RtcGetTimerValue( void )
+{
+    return Ctx.Rtc.Now;
+}
+
+uint32_t RtcGetTimerElapsedTime( void )
+{
+    return Ctx.Rtc.Now - Ctx.Rtc.Context;
+}
+
+void RtcBkupWrite( uint32_t data0, uint32_t data1 )
+{
+    Ctx.Rtc.Backup[0] = data0;
+    Ctx.Rtc.Backup[1] = data1;
+}
+
+void RtcBkupRead( uint32_t* data0, uint32_t* data1 )
+{
+    *data0 = Ctx.Rtc.Backup[0];
+    *data1 = Ctx.Rtc.Backup[1];
+}
+
+void RtcProcess( void )
+{
+}
+
+TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
+{
+    return period;
+}
+
+/*
+ * Board critical sections. The replay runs in a single thread.
+ */
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+/*
+ * Virtual radio. The events come from the log.
+ */
+
+static void RadioInit( RadioEvents_t *events )
+{
+    Ctx.Radio.Events = events;
+}
+
+static RadioState_t RadioGetStatus( void )
+{
+    return Ctx.Radio.State;
+}
+
+static void RadioSetModem( RadioModems_t modem )
+{
+}
+
+static void RadioSetChannel( uint32_t freq )
+{
+}
+
+static bool RadioIsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime )
+{
+    // The LoRaMAC uses the non-blocking carrier sense, whose result is logged
+    return true;
+}
+
+static uint32_t RadioRandom( void )
+{
+    EventLogRecord_t record;
+
+    // The consumers of the random numbers, LoRaMacInitialization and the
+    // secure element included, record them after the call
+    while( EventLogReaderNext( &Ctx.Random, &record ) == true )
+    {
+        if( ( record.Type == EVENT_LOG_MAC_INIT ) && ( record.Size >= 8 ) )
+        {
+            Ctx.Radio.WakeupTime = ReplayGetUint32( record.Data + 4 );
+            return ReplayGetUint32( record.Data );
+        }
+        if( ( record.Type == EVENT_LOG_RADIO_RANDOM ) && ( record.Size >= 4 ) )
+        {
+            return ReplayGetUint32( record.Data );
+        }
+    }
+    ReplayDivergence( );
+    return 0;
+}
+
+static void RadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth,
+                              uint32_t datarate, uint8_t coderate,
+                              uint32_t bandwidthAfc, uint16_t preambleLen,
+                              uint16_t symbTimeout, bool fixLen,
+                              uint8_t payloadLen,
+                              bool crcOn, bool freqHopOn, uint8_t hopPeriod,
+                              bool iqInverted, bool rxContinuous )
+{
+    Ctx.Radio.RxContinuous = rxContinuous;
+}
+
+static void RadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
+                              uint32_t bandwidth, uint32_t datarate,
+                              uint8_t coderate, uint16_t preambleLen,
+                              bool fixLen, bool crcOn, bool freqHopOn,
+                              uint8_t hopPeriod, bool iqInverted, uint32_t timeout )
+{
+}
+
+static bool RadioCheckRfFrequency( uint32_t frequency )
+{
+    return true;
+}
+
+/*!
+ * \brief Computes the time on air as the SX126x driver does
+ */
+static uint32_t RadioTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
+                                uint32_t datarate, uint8_t coderate,
+                                uint16_t preambleLen, bool fixLen, uint8_t payloadLen,
+                                bool crcOn )
+{
+    uint32_t numerator = 0;
+    uint32_t denominator = 1;
+
+    if( modem == MODEM_FSK )
+    {
+        // Preamble, length field, 3 bytes sync word, payload and CRC
+        numerator = 1000U * ( ( preambleLen << 3 ) + ( ( fixLen == false ) ? 8 : 0 ) + ( 3 << 3 ) +
+                              ( ( payloadLen + ( ( crcOn == true ) ? 2 : 0 ) ) << 3 ) );
+        denominator = datarate;
+    }
+    else
+    {
+        int32_t crDenom = coderate + 4;
+        bool lowDatareOptimize = ( ( bandwidth == 0 ) && ( ( datarate == 11 ) || ( datarate == 12 ) ) ) ||
+                                 ( ( bandwidth == 1 ) && ( datarate == 12 ) );
+        int32_t ceilDenominator = 4 * datarate;
+        int32_t ceilNumerator = ( payloadLen << 3 ) + ( crcOn ? 16 : 0 ) - ( 4 * datarate ) + ( fixLen ? 0 : 20 );
+        int32_t intermediate = 0;
+
+        if( ( ( datarate == 5 ) || ( datarate == 6 ) ) && ( preambleLen < 12 ) )
+        {
+            preambleLen = 12;
+        }
+        if( datarate > 6 )
+        {
+            ceilNumerator += 8;
+            if( lowDatareOptimize == true )
+            {
+                ceilDenominator = 4 * ( datarate - 2 );
+            }
+        }
+        if( ceilNumerator < 0 )
+        {
+            ceilNumerator = 0;
+        }
+        intermediate = ( ( ceilNumerator + ceilDenominator - 1 ) / ceilDenominator ) * crDenom + preambleLen + 12;
+        if( datarate <= 6 )
+        {
+            intermediate += 2;
+        }
+        numerator = 1000U * ( uint32_t )( ( 4 * intermediate + 1 ) * ( 1 << ( datarate - 2 ) ) );
+        denominator = 125000UL << MIN( bandwidth, 2 );
+    }
+    return ( numerator + denominator - 1 ) / denominator;
+}
+
+static void RadioSend( uint8_t *buffer, uint8_t size )
+{
+    // The frame is recorded by the LoRaMAC
+    Ctx.Radio.State = RF_TX_RUNNING;
+}
+
+static void RadioSleep( void )
+{
+    Ctx.Radio.State = RF_IDLE;
+}
+
+static void RadioStandby( void )
+{
+    Ctx.Radio.State = RF_IDLE;
+}
+
+static void RadioRx( uint32_t timeout )
+{
+    Ctx.Radio.State = RF_RX_RUNNING;
+}
+
+static void RadioStartCad( void )
+{
+    Ctx.Radio.State = RF_CAD;
+}
+
+static void RadioSetTxContinuousWave( uint32_t freq, int8_t power, uint16_t time )
+{
+    Ctx.Radio.State = RF_TX_RUNNING;
+}
+
+static int16_t RadioRssi( RadioModems_t modem )
+{
+    return -120;
+}
+
+static void RadioWrite( uint32_t addr, uint8_t data )
+{
+}
+
+static uint8_t RadioRead( uint32_t addr )
+{
+    return 0;
+}
+
+static void RadioWriteBuffer( uint32_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void RadioReadBuffer( uint32_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void RadioSetMaxPayloadLength( RadioModems_t modem, uint8_t max )
+{
+}
+
+static void RadioSetPublicNetwork( bool enable )
+{
+}
+
+static uint32_t RadioGetWakeupTime( void )
+{
+    return Ctx.Radio.WakeupTime;
+}
+
+static void RadioIrqProcess( void )
+{
+}
+
+static void RadioRxBoosted( uint32_t timeout )
+{
+    Ctx.Radio.State = RF_RX_RUNNING;
+}
+
+static void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime )
+{
+    Ctx.Radio.State = RF_RX_RUNNING;
+}
+
+static void RadioStartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+{
+    Ctx.Radio.State = RF_RX_RUNNING;
+}
+
+const struct Radio_s Radio =
+{
+    .Init = RadioInit,
+    .GetStatus = RadioGetStatus,
+    .SetModem = RadioSetModem,
+    .SetChannel = RadioSetChannel,
+    .IsChannelFree = RadioIsChannelFree,
+    .Random = RadioRandom,
+    .SetRxConfig = RadioSetRxConfig,
+    .SetTxConfig = RadioSetTxConfig,
+    .CheckRfFrequency = RadioCheckRfFrequency,
+    .TimeOnAir = RadioTimeOnAir,
+    .Send = RadioSend,
+    .Sleep = RadioSleep,
+    .Standby = RadioStandby,
+    .Rx = RadioRx,
+    .StartCad = RadioStartCad,
+    .SetTxContinuousWave = RadioSetTxContinuousWave,
+    .Rssi = RadioRssi,
+    .Write = RadioWrite,
+    .Read = RadioRead,
+    .WriteBuffer = RadioWriteBuffer,
+    .ReadBuffer = RadioReadBuffer,
+    .SetMaxPayloadLength = RadioSetMaxPayloadLength,
+    .SetPublicNetwork = RadioSetPublicNetwork,
+    .GetWakeupTime = RadioGetWakeupTime,
+    .IrqProcess = RadioIrqProcess,
+    .RxBoosted = RadioRxBoosted,
+    .SetRxDutyCycle = RadioSetRxDutyCycle,
+    .StartChannelFree = RadioStartChannelFree,
+};
+
+#else
+
+bool LoRaMacReplayInit( const uint8_t* log, uint32_t size )
+{
+    return false;
+}
+
+bool LoRaMacReplayRun( void ( *process )( void ), LoRaMacReplayStats_t* stats )
+{
+    return false;
+}
+
+#endif
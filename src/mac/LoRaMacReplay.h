@@ -0,0 +1,150 @@
+/*!
+ * \file      LoRaMacReplay.h
+ *
+ * \brief     LoRa MAC replay of recorded radio, timer and request events
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \defgroup  LORAMACREPLAY LoRa MAC replay
+ *            Replays a log captured by the event log ( see eventlog.h ) on a
+ *            host build of the LoRaMAC, e.g. to reproduce a field issue or to
+ *            time the MAC processing of a long session in CI.
+ *
+ *            The replay driver is compiled only when EVENT_LOG_REPLAY_ENABLED
+ *            and EVENT_LOG_ENABLED are defined. It then replaces the board:
+ *            it implements the RTC board API on a virtual clock, the Radio
+ *            driver and the board critical sections. The host build links the
+ *            mac, system and soft-se sources with it, without any board or
+ *            radio driver sources.
+ *
+ *            The recorded radio events, MCPS requests and MLME requests are
+ *            injected at their recorded time. The virtual clock jumps from one
+ *            event or timer expiry to the next, so the replay runs faster than
+ *            real time. The records produced by the LoRaMAC during the replay,
+ *            frames handed to the radio and timer expiries included, are
+ *            checked against the log: the data must match bit for bit and the
+ *            time within \ref LORAMAC_REPLAY_TIME_TOLERANCE.
+ *
+ *            The host application initializes the LoRaMAC as the recorded
+ *            one ( same region, keys, NVM contexts and MIB settings ), but
+ *            doesn't issue MCPS or MLME requests itself:
+ *
+ * \code
+ *            LoRaMacReplayInit( log, logSize );
+ *            LoRaMacInitialization( &primitives, &callbacks, region );
+ *            // Same MIB settings as the recorded application
+ *            LoRaMacStart( );
+ *            LoRaMacReplayRun( LoRaMacProcess, &stats );
+ * \endcode
+ *
+ *            tools/mac-replay builds a recorder against a simulated radio and
+ *            network server, and replays a recorded log as a regression test.
+ * \{
+ */
+#ifndef __LORAMAC_REPLAY_H__
+#define __LORAMAC_REPLAY_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Maximum difference in ms between the time of a record produced during the
+ * replay and the recorded one. The processing time of the recording device
+ * isn't replayed.
+ */
+#ifndef LORAMAC_REPLAY_TIME_TOLERANCE
+#define LORAMAC_REPLAY_TIME_TOLERANCE               10
+#endif
+
+/*!
+ * Replay statistics
+ */
+typedef struct sLoRaMacReplayStats
+{
+    /*!
+     * Number of log records replayed or matched
+     */
+    uint32_t Records;
+    /*!
+     * Number of log records which didn't match the replay
+     */
+    uint32_t Divergences;
+    /*!
+     * Log offset of the first record which didn't match the replay.
+     * UINT32_MAX when the replay matches the log.
+     */
+    uint32_t FirstDivergence;
+    /*!
+     * Replayed duration in ms
+     */
+    uint32_t VirtualTime;
+    /*!
+     * Host time in ns spent in the LoRaMAC: injected events, timer interrupts
+     * and process function calls
+     */
+    uint64_t ProcessTime;
+    /*!
+     * Longest host time in ns spent in the LoRaMAC for a single event
+     */
+    uint32_t MaxProcessTime;
+    /*!
+     * Number of gaps in the log, see \ref EVENT_LOG_GAP. The replay of a log
+     * with gaps fails.
+     */
+    uint32_t Gaps;
+    /*!
+     * Number of records the recording device dropped in the gaps
+     */
+    uint32_t LostRecords;
+}LoRaMacReplayStats_t;
+
+/*!
+ * \brief Starts the replay of a log. Must be called before
+ *        LoRaMacInitialization.
+ *
+ * \param [IN] log  Log bytes, header included
+ * \param [IN] size Number of bytes
+ *
+ * \retval status [true: replay ready, false: invalid log or replay driver
+ *                 disabled]
+ */
+bool LoRaMacReplayInit( const uint8_t* log, uint32_t size );
+
+/*!
+ * \brief Replays the log until its end
+ *
+ * \param [IN]  process Main loop process function, e.g. LoRaMacProcess. Called
+ *                      after each injected event and timer interrupt while the
+ *                      LoRaMAC has pending work.
+ * \param [OUT] stats   Replay statistics
+ *
+ * \retval status [true: the replay matches the log, false: divergences or
+ *                 gaps in the log]
+ */
+bool LoRaMacReplayRun( void ( *process )( void ), LoRaMacReplayStats_t* stats );
+
+/*! \} defgroup LORAMACREPLAY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LORAMAC_REPLAY_H__
@@ -254,6 +254,10 @@ typedef enum eKeyIdentifier
      * Zero key for slot randomization in class B
      */
     SLOT_RAND_ZERO_KEY,
+    /*!
+     * AES-CMAC key of the fragmentation session files
+     */
+    FILE_CMAC_KEY,
     /*!
      * No Key
      */
@@ -52,6 +52,7 @@
 #define AS923_DL_CHANNEL_REQ( )                    AS923_CASE { return RegionAS923DlChannelReq( dlChannelReq ); }
 #define AS923_ALTERNATE_DR( )                      AS923_CASE { return RegionAS923AlternateDr( currentDr, type ); }
 #define AS923_NEXT_CHANNEL( )                      AS923_CASE { return RegionAS923NextChannel( nextChanParams, channel, time, aggregatedTimeOff ); }
+#define AS923_CARRIER_SENSE_DONE( )               AS923_CASE { return RegionAS923CarrierSenseDone( channelIsFree, channel ); }
 #define AS923_CHANNEL_ADD( )                       AS923_CASE { return RegionAS923ChannelAdd( channelAdd ); }
 #define AS923_CHANNEL_REMOVE( )                    AS923_CASE { return RegionAS923ChannelsRemove( channelRemove ); }
 #define AS923_SET_CONTINUOUS_WAVE( )               AS923_CASE { RegionAS923SetContinuousWave( continuousWave ); break; }
@@ -76,6 +77,7 @@
 #define AS923_DL_CHANNEL_REQ( )
 #define AS923_ALTERNATE_DR( )
 #define AS923_NEXT_CHANNEL( )
+#define AS923_CARRIER_SENSE_DONE( )
 #define AS923_CHANNEL_ADD( )
 #define AS923_CHANNEL_REMOVE( )
 #define AS923_SET_CONTINUOUS_WAVE( )
@@ -364,6 +366,7 @@
 #define KR920_DL_CHANNEL_REQ( )                    KR920_CASE { return RegionKR920DlChannelReq( dlChannelReq ); }
 #define KR920_ALTERNATE_DR( )                      KR920_CASE { return RegionKR920AlternateDr( currentDr, type ); }
 #define KR920_NEXT_CHANNEL( )                      KR920_CASE { return RegionKR920NextChannel( nextChanParams, channel, time, aggregatedTimeOff ); }
+#define KR920_CARRIER_SENSE_DONE( )               KR920_CASE { return RegionKR920CarrierSenseDone( channelIsFree, channel ); }
 #define KR920_CHANNEL_ADD( )                       KR920_CASE { return RegionKR920ChannelAdd( channelAdd ); }
 #define KR920_CHANNEL_REMOVE( )                    KR920_CASE { return RegionKR920ChannelsRemove( channelRemove ); }
 #define KR920_SET_CONTINUOUS_WAVE( )               KR920_CASE { RegionKR920SetContinuousWave( continuousWave ); break; }
@@ -388,6 +391,7 @@
 #define KR920_DL_CHANNEL_REQ( )
 #define KR920_ALTERNATE_DR( )
 #define KR920_NEXT_CHANNEL( )
+#define KR920_CARRIER_SENSE_DONE( )
 #define KR920_CHANNEL_ADD( )
 #define KR920_CHANNEL_REMOVE( )
 #define KR920_SET_CONTINUOUS_WAVE( )
@@ -930,6 +934,19 @@ LoRaMacStatus_t RegionNextChannel( LoRaMacRegion_t region, NextChanParams_t* nex
     }
 }
 
+LoRaMacStatus_t RegionCarrierSenseDone( LoRaMacRegion_t region, bool channelIsFree, uint8_t* channel )
+{
+    switch( region )
+    {
+        AS923_CARRIER_SENSE_DONE( );
+        KR920_CARRIER_SENSE_DONE( );
+        default:
+        {
+            return LORAMAC_STATUS_REGION_NOT_SUPPORTED;
+        }
+    }
+}
+
 LoRaMacStatus_t RegionChannelAdd( LoRaMacRegion_t region, ChannelAddParams_t* channelAdd )
 {
     switch( region )
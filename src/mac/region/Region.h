@@ -706,9 +706,13 @@ typedef enum ePhyAttribute
      */
     PHY_MAX_NB_CHANNELS,
     /*!
-     * Channels.
+     * Channels. NULL for the regions with a computed channel plan.
      */
     PHY_CHANNELS,
+    /*!
+     * Parameters of a single channel, available in all regions.
+     */
+    PHY_CHANNEL,
     /*!
      * Default value of the uplink dwell time.
      */
@@ -850,7 +854,13 @@ typedef enum eInitType
     /*!
      * Restores internal context from passed pointer.
      */
-    INIT_TYPE_RESTORE_CTX
+    INIT_TYPE_RESTORE_CTX,
+    /*!
+     * Uses the passed pointer as internal context storage, without copying
+     * it. The storage must stay valid while bound. NULL binds the module
+     * storage again.
+     */
+    INIT_TYPE_BIND_CTX
 }InitType_t;
 
 typedef enum eChannelsMask
@@ -905,6 +915,10 @@ typedef union uPhyParam
      * Pointer to the channels.
      */
     ChannelParams_t* Channels;
+    /*!
+     * Parameters of a single channel.
+     */
+    ChannelParams_t Channel;
     /*!
      * Beacon format
      */
@@ -945,9 +959,9 @@ typedef struct sGetPhyParams
      */
     uint8_t DownlinkDwellTime;
     /*!
-     * Specification of the downlink channel. Used in Class B only.
+     * Specification of the channel.
      * The parameter is needed for the following queries:
-     * PHY_BEACON_CHANNEL_FREQ, PHY_PING_SLOT_CHANNEL_FREQ
+     * PHY_CHANNEL, PHY_BEACON_CHANNEL_FREQ, PHY_PING_SLOT_CHANNEL_FREQ
      */
     uint8_t Channel;
 }GetPhyParams_t;
@@ -1056,6 +1070,10 @@ typedef struct sApplyCFListParams
      * Size of the payload.
      */
     uint8_t Size;
+    /*!
+     * Channel of the accepted join request.
+     */
+    uint8_t JoinChannel;
 }ApplyCFListParams_t;
 
 /*!
@@ -1103,9 +1121,13 @@ typedef struct sRxConfigParams
      */
      uint32_t WindowTimeout;
     /*!
-     * RX window offset
+     * RX window offset [us]
      */
     int32_t WindowOffset;
+    /*!
+     * Symbol time in us of the RX datarate. Byte time for FSK.
+     */
+    uint32_t SymbolTime;
     /*!
      * Downlink dwell time.
      */
@@ -1310,6 +1332,10 @@ typedef struct sNextChanParams
      * Payload length of the next frame
      */
     uint16_t PktLen;
+    /*!
+     * Carrier sense mode of the listen before talk procedure
+     */
+    RadioCarrierSenseModes_t CarrierSenseMode;
 }NextChanParams_t;
 
 /*!
@@ -1651,6 +1677,21 @@ int8_t RegionAlternateDr( LoRaMacRegion_t region, int8_t currentDr, AlternateDrT
  */
 LoRaMacStatus_t RegionNextChannel( LoRaMacRegion_t region, NextChanParams_t* nextChanParams, uint8_t* channel, TimerTime_t* time, TimerTime_t* aggregatedTimeOff );
 
+/*!
+ * \brief Continues the listen before talk procedure after RegionNextChannel
+ *        returned LORAMAC_STATUS_CARRIER_SENSE_ONGOING.
+ *
+ * \param [IN] region LoRaWAN region.
+ *
+ * \param [IN] channelIsFree Result of the carrier sense signaled by the radio.
+ *
+ * \param [OUT] channel Next channel to use for TX.
+ *
+ * \retval Status of the operation. LORAMAC_STATUS_CARRIER_SENSE_ONGOING while
+ *         further channels are being sensed.
+ */
+LoRaMacStatus_t RegionCarrierSenseDone( LoRaMacRegion_t region, bool channelIsFree, uint8_t* channel );
+
 /*!
  * \brief Adds a channel.
  *
@@ -127,7 +127,21 @@ typedef struct sRegionAS923NvmCtx
 /*
  * Non-volatile module context.
  */
-static RegionAS923NvmCtx_t NvmCtx;
+static RegionAS923NvmCtx_t DefaultNvmCtx;
+
+/*
+ * Non-volatile module context in use. Bound to the context of the selected
+ * LoRaMac instance by INIT_TYPE_BIND_CTX.
+ */
+static RegionAS923NvmCtx_t* NvmCtx = &DefaultNvmCtx;
+
+#if ( REGION_AS923_DEFAULT_CHANNEL_PLAN == CHANNEL_PLAN_GROUP_AS923_1_JP )
+/*
+ * Listen before talk context. Not saved to NVM, a single procedure runs at a
+ * time, for the LoRaMac instance driving the radio.
+ */
+static RegionCommonCarrierSense_t CarrierSense;
+#endif
 
 // Static functions
 static int8_t GetNextLowerTxDr( int8_t dr, int8_t minDr )
@@ -337,12 +351,12 @@ PhyParam_t RegionAS923GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsMask;
             break;
         }
         case PHY_CHANNELS_DEFAULT_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsDefaultMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsDefaultMask;
             break;
         }
         case PHY_MAX_NB_CHANNELS:
@@ -352,7 +366,15 @@ PhyParam_t RegionAS923GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS:
         {
-            phyParam.Channels = NvmCtx.Channels;
+            phyParam.Channels = NvmCtx->Channels;
+            break;
+        }
+        case PHY_CHANNEL:
+        {
+            if( getPhy->Channel < AS923_MAX_NB_CHANNELS )
+            {
+                phyParam.Channel = NvmCtx->Channels[getPhy->Channel];
+            }
             break;
         }
         case PHY_DEF_UPLINK_DWELL_TIME:
@@ -423,7 +445,7 @@ PhyParam_t RegionAS923GetPhyParam( GetPhyParams_t* getPhy )
 
 void RegionAS923SetBandTxDone( SetBandTxDoneParams_t* txDone )
 {
-    RegionCommonSetBandTxDone( &NvmCtx.Bands[NvmCtx.Channels[txDone->Channel].Band],
+    RegionCommonSetBandTxDone( &NvmCtx->Bands[NvmCtx->Channels[txDone->Channel].Band],
                                txDone->LastTxAirTime, txDone->Joined, txDone->ElapsedTimeSinceStartUp );
 }
 
@@ -439,39 +461,51 @@ void RegionAS923InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_DEFAULTS:
         {
             // Default bands
-            memcpy1( ( uint8_t* )NvmCtx.Bands, ( uint8_t* )bands, sizeof( Band_t ) * AS923_MAX_NB_BANDS );
+            memcpy1( ( uint8_t* )NvmCtx->Bands, ( uint8_t* )bands, sizeof( Band_t ) * AS923_MAX_NB_BANDS );
 
             // Default channels
-            NvmCtx.Channels[0] = ( ChannelParams_t ) AS923_LC1;
-            NvmCtx.Channels[1] = ( ChannelParams_t ) AS923_LC2;
+            NvmCtx->Channels[0] = ( ChannelParams_t ) AS923_LC1;
+            NvmCtx->Channels[1] = ( ChannelParams_t ) AS923_LC2;
 
             // Default ChannelsMask
-            NvmCtx.ChannelsDefaultMask[0] = LC( 1 ) + LC( 2 );
+            NvmCtx->ChannelsDefaultMask[0] = LC( 1 ) + LC( 2 );
 
             // Update the channels mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
             break;
         }
         case INIT_TYPE_RESET_TO_DEFAULT_CHANNELS:
         {
             // Reset Channels Rx1Frequency to default 0
-            NvmCtx.Channels[0].Rx1Frequency = 0;
-            NvmCtx.Channels[1].Rx1Frequency = 0;
+            NvmCtx->Channels[0].Rx1Frequency = 0;
+            NvmCtx->Channels[1].Rx1Frequency = 0;
             // Update the channels mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
             break;
         }
         case INIT_TYPE_ACTIVATE_DEFAULT_CHANNELS:
         {
             // Activate channels default mask
-            NvmCtx.ChannelsMask[0] |= NvmCtx.ChannelsDefaultMask[0];
+            NvmCtx->ChannelsMask[0] |= NvmCtx->ChannelsDefaultMask[0];
             break;
         }
         case INIT_TYPE_RESTORE_CTX:
         {
             if( params->NvmCtx != 0 )
             {
-                memcpy1( (uint8_t*) &NvmCtx, (uint8_t*) params->NvmCtx, sizeof( NvmCtx ) );
+                memcpy1( (uint8_t*) NvmCtx, (uint8_t*) params->NvmCtx, sizeof( RegionAS923NvmCtx_t ) );
+            }
+            break;
+        }
+        case INIT_TYPE_BIND_CTX:
+        {
+            if( params->NvmCtx != 0 )
+            {
+                NvmCtx = ( RegionAS923NvmCtx_t* )params->NvmCtx;
+            }
+            else
+            {
+                NvmCtx = &DefaultNvmCtx;
             }
             break;
         }
@@ -485,7 +519,7 @@ void RegionAS923InitDefaults( InitDefaultsParams_t* params )
 void* RegionAS923GetNvmCtx( GetNvmCtxParams_t* params )
 {
     params->nvmCtxSize = sizeof( RegionAS923NvmCtx_t );
-    return &NvmCtx;
+    return NvmCtx;
 }
 
 bool RegionAS923Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
@@ -602,12 +636,12 @@ bool RegionAS923ChanMaskSet( ChanMaskSetParams_t* chanMaskSet )
     {
         case CHANNELS_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, chanMaskSet->ChannelsMaskIn, 1 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, chanMaskSet->ChannelsMaskIn, 1 );
             break;
         }
         case CHANNELS_DEFAULT_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 1 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 1 );
             break;
         }
         default:
@@ -634,6 +668,7 @@ void RegionAS923ComputeRxWindowParameters( int8_t datarate, uint8_t minRxSymbols
     }
 
     RegionCommonComputeRxWindowParameters( tSymbol, minRxSymbols, rxError, Radio.GetWakeupTime( ), &rxConfigParams->WindowTimeout, &rxConfigParams->WindowOffset );
+    rxConfigParams->SymbolTime = ( uint32_t )( tSymbol * 1000 );
 }
 
 bool RegionAS923RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
@@ -651,11 +686,11 @@ bool RegionAS923RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
     if( rxConfig->RxSlot == RX_SLOT_WIN_1 )
     {
         // Apply window 1 frequency
-        frequency = NvmCtx.Channels[rxConfig->Channel].Frequency;
+        frequency = NvmCtx->Channels[rxConfig->Channel].Frequency;
         // Apply the alternative RX 1 window frequency, if it is available
-        if( NvmCtx.Channels[rxConfig->Channel].Rx1Frequency != 0 )
+        if( NvmCtx->Channels[rxConfig->Channel].Rx1Frequency != 0 )
         {
-            frequency = NvmCtx.Channels[rxConfig->Channel].Rx1Frequency;
+            frequency = NvmCtx->Channels[rxConfig->Channel].Rx1Frequency;
         }
     }
 
@@ -686,7 +721,7 @@ bool RegionAS923TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime
 {
     RadioModems_t modem;
     int8_t phyDr = DataratesAS923[txConfig->Datarate];
-    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx.Bands[NvmCtx.Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx->Bands[NvmCtx->Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx->ChannelsMask );
     uint32_t bandwidth = GetBandwidth( txConfig->Datarate );
     int8_t phyTxPower = 0;
 
@@ -694,7 +729,7 @@ bool RegionAS923TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, txConfig->MaxEirp, txConfig->AntennaGain );
 
     // Setup the radio frequency
-    Radio.SetChannel( NvmCtx.Channels[txConfig->Channel].Frequency );
+    Radio.SetChannel( NvmCtx->Channels[txConfig->Channel].Frequency );
 
     if( txConfig->Datarate == DR_7 )
     { // High Speed FSK channel
@@ -762,7 +797,7 @@ uint8_t RegionAS923LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
             {
                 if( linkAdrParams.ChMaskCtrl == 6 )
                 {
-                    if( NvmCtx.Channels[i].Frequency != 0 )
+                    if( NvmCtx->Channels[i].Frequency != 0 )
                     {
                         chMask |= 1 << i;
                     }
@@ -770,7 +805,7 @@ uint8_t RegionAS923LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
                 else
                 {
                     if( ( ( chMask & ( 1 << i ) ) != 0 ) &&
-                        ( NvmCtx.Channels[i].Frequency == 0 ) )
+                        ( NvmCtx->Channels[i].Frequency == 0 ) )
                     {// Trying to enable an undefined channel
                         status &= 0xFE; // Channel mask KO
                     }
@@ -796,7 +831,7 @@ uint8_t RegionAS923LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     linkAdrVerifyParams.ChannelsMask = &chMask;
     linkAdrVerifyParams.MinDatarate = ( int8_t )phyParam.Value;
     linkAdrVerifyParams.MaxDatarate = AS923_TX_MAX_DATARATE;
-    linkAdrVerifyParams.Channels = NvmCtx.Channels;
+    linkAdrVerifyParams.Channels = NvmCtx->Channels;
     linkAdrVerifyParams.MinTxPower = AS923_MIN_TX_POWER;
     linkAdrVerifyParams.MaxTxPower = AS923_MAX_TX_POWER;
     linkAdrVerifyParams.Version = linkAdrReq->Version;
@@ -808,9 +843,9 @@ uint8_t RegionAS923LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     if( status == 0x07 )
     {
         // Set the channels mask to a default value
-        memset1( ( uint8_t* ) NvmCtx.ChannelsMask, 0, sizeof( NvmCtx.ChannelsMask ) );
+        memset1( ( uint8_t* ) NvmCtx->ChannelsMask, 0, sizeof( NvmCtx->ChannelsMask ) );
         // Update the channels mask
-        NvmCtx.ChannelsMask[0] = chMask;
+        NvmCtx->ChannelsMask[0] = chMask;
     }
 
     // Update status variables
@@ -917,7 +952,7 @@ uint8_t RegionAS923DlChannelReq( DlChannelReqParams_t* dlChannelReq )
     }
 
     // Verify if an uplink frequency exists
-    if( NvmCtx.Channels[dlChannelReq->ChannelId].Frequency == 0 )
+    if( NvmCtx->Channels[dlChannelReq->ChannelId].Frequency == 0 )
     {
         status &= 0xFD;
     }
@@ -925,7 +960,7 @@ uint8_t RegionAS923DlChannelReq( DlChannelReqParams_t* dlChannelReq )
     // Apply Rx1 frequency, if the status is OK
     if( status == 0x03 )
     {
-        NvmCtx.Channels[dlChannelReq->ChannelId].Rx1Frequency = dlChannelReq->Rx1Frequency;
+        NvmCtx->Channels[dlChannelReq->ChannelId].Rx1Frequency = dlChannelReq->Rx1Frequency;
     }
 
     return status;
@@ -946,17 +981,17 @@ LoRaMacStatus_t RegionAS923NextChannel( NextChanParams_t* nextChanParams, uint8_
     RegionCommonCountNbOfEnabledChannelsParams_t countChannelsParams;
     LoRaMacStatus_t status = LORAMAC_STATUS_NO_CHANNEL_FOUND;
 
-    if( RegionCommonCountChannels( NvmCtx.ChannelsMask, 0, 1 ) == 0 )
+    if( RegionCommonCountChannels( NvmCtx->ChannelsMask, 0, 1 ) == 0 )
     { // Reactivate default channels
-        NvmCtx.ChannelsMask[0] |= LC( 1 ) + LC( 2 );
+        NvmCtx->ChannelsMask[0] |= LC( 1 ) + LC( 2 );
     }
 
     // Search how many channels are enabled
     countChannelsParams.Joined = nextChanParams->Joined;
     countChannelsParams.Datarate = nextChanParams->Datarate;
-    countChannelsParams.ChannelsMask = NvmCtx.ChannelsMask;
-    countChannelsParams.Channels = NvmCtx.Channels;
-    countChannelsParams.Bands = NvmCtx.Bands;
+    countChannelsParams.ChannelsMask = NvmCtx->ChannelsMask;
+    countChannelsParams.Channels = NvmCtx->Channels;
+    countChannelsParams.Bands = NvmCtx->Bands;
     countChannelsParams.MaxNbChannels = AS923_MAX_NB_CHANNELS;
     countChannelsParams.JoinChannels = AS923_JOIN_CHANNELS;
 
@@ -978,25 +1013,27 @@ LoRaMacStatus_t RegionAS923NextChannel( NextChanParams_t* nextChanParams, uint8_
     {
 #if ( REGION_AS923_DEFAULT_CHANNEL_PLAN == CHANNEL_PLAN_GROUP_AS923_1_JP )
         // Executes the LBT algorithm when operating in Japan
-        uint8_t channelNext = 0;
-
-        for( uint8_t  i = 0, j = randr( 0, nbEnabledChannels - 1 ); i < AS923_MAX_NB_CHANNELS; i++ )
+        CarrierSense.Channels = NvmCtx->Channels;
+        CarrierSense.NbEnabledChannels = nbEnabledChannels;
+        memcpy1( CarrierSense.EnabledChannels, enabledChannels, nbEnabledChannels );
+        CarrierSense.Index = randr( 0, nbEnabledChannels - 1 );
+        CarrierSense.NbAttempts = 0;
+        CarrierSense.MaxNbAttempts = AS923_MAX_NB_CHANNELS;
+        CarrierSense.RxBandwidth = AS923_LBT_RX_BANDWIDTH;
+        CarrierSense.RssiFreeThreshold = AS923_RSSI_FREE_TH;
+        CarrierSense.CarrierSenseTime = AS923_CARRIER_SENSE_TIME;
+        CarrierSense.Mode = nextChanParams->CarrierSenseMode;
+        CarrierSense.CadDatarate = DataratesAS923[nextChanParams->Datarate];
+        CarrierSense.CadBandwidth = GetBandwidth( nextChanParams->Datarate );
+        if( nextChanParams->Datarate == DR_7 )
         {
-            channelNext = enabledChannels[j];
-            j = ( j + 1 ) % nbEnabledChannels;
-
-            // Perform carrier sense for AS923_CARRIER_SENSE_TIME
-            // If the channel is free, we can stop the LBT mechanism
-            if( Radio.IsChannelFree( NvmCtx.Channels[channelNext].Frequency, AS923_LBT_RX_BANDWIDTH, AS923_RSSI_FREE_TH, AS923_CARRIER_SENSE_TIME ) == true )
-            {
-                // Free channel found
-                *channel = channelNext;
-                return LORAMAC_STATUS_OK;
-            }
+            // CAD only senses the LoRa modulations
+            CarrierSense.Mode = RADIO_CARRIER_SENSE_RSSI;
         }
-        // Even if one or more channels are available according to the channel plan, no free channel
-        // was found during the LBT procedure.
-        status = LORAMAC_STATUS_NO_FREE_CHANNEL_FOUND;
+
+        // Perform carrier sense for AS923_CARRIER_SENSE_TIME on each channel until a free one
+        // is found. The procedure completes asynchronously when the radio supports it.
+        status = RegionCommonCarrierSenseStart( &CarrierSense, channel );
 #else
         // We found a valid channel
         *channel = enabledChannels[randr( 0, nbEnabledChannels - 1 )];
@@ -1005,11 +1042,21 @@ LoRaMacStatus_t RegionAS923NextChannel( NextChanParams_t* nextChanParams, uint8_
     else if( status == LORAMAC_STATUS_NO_CHANNEL_FOUND )
     {
         // Datarate not supported by any channel, restore defaults
-        NvmCtx.ChannelsMask[0] |= LC( 1 ) + LC( 2 );
+        NvmCtx->ChannelsMask[0] |= LC( 1 ) + LC( 2 );
     }
     return status;
 }
 
+LoRaMacStatus_t RegionAS923CarrierSenseDone( bool channelIsFree, uint8_t* channel )
+{
+#if ( REGION_AS923_DEFAULT_CHANNEL_PLAN == CHANNEL_PLAN_GROUP_AS923_1_JP )
+    return RegionCommonCarrierSenseDone( &CarrierSense, channelIsFree, channel );
+#else
+    // No listen before talk procedure outside of Japan
+    return LORAMAC_STATUS_ERROR;
+#endif
+}
+
 LoRaMacStatus_t RegionAS923ChannelAdd( ChannelAddParams_t* channelAdd )
 {
     bool drInvalid = false;
@@ -1063,9 +1110,9 @@ LoRaMacStatus_t RegionAS923ChannelAdd( ChannelAddParams_t* channelAdd )
         return LORAMAC_STATUS_FREQUENCY_INVALID;
     }
 
-    memcpy1( ( uint8_t* ) &(NvmCtx.Channels[id]), ( uint8_t* ) channelAdd->NewChannel, sizeof( NvmCtx.Channels[id] ) );
-    NvmCtx.Channels[id].Band = 0;
-    NvmCtx.ChannelsMask[0] |= ( 1 << id );
+    memcpy1( ( uint8_t* ) &(NvmCtx->Channels[id]), ( uint8_t* ) channelAdd->NewChannel, sizeof( NvmCtx->Channels[id] ) );
+    NvmCtx->Channels[id].Band = 0;
+    NvmCtx->ChannelsMask[0] |= ( 1 << id );
     return LORAMAC_STATUS_OK;
 }
 
@@ -1079,16 +1126,16 @@ bool RegionAS923ChannelsRemove( ChannelRemoveParams_t* channelRemove  )
     }
 
     // Remove the channel from the list of channels
-    NvmCtx.Channels[id] = ( ChannelParams_t ){ 0, 0, { 0 }, 0 };
+    NvmCtx->Channels[id] = ( ChannelParams_t ){ 0, 0, { 0 }, 0 };
 
-    return RegionCommonChanDisable( NvmCtx.ChannelsMask, id, AS923_MAX_NB_CHANNELS );
+    return RegionCommonChanDisable( NvmCtx->ChannelsMask, id, AS923_MAX_NB_CHANNELS );
 }
 
 void RegionAS923SetContinuousWave( ContinuousWaveParams_t* continuousWave )
 {
-    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx.Bands[NvmCtx.Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx->Bands[NvmCtx->Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx->ChannelsMask );
     int8_t phyTxPower = 0;
-    uint32_t frequency = NvmCtx.Channels[continuousWave->Channel].Frequency;
+    uint32_t frequency = NvmCtx->Channels[continuousWave->Channel].Frequency;
 
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, continuousWave->MaxEirp, continuousWave->AntennaGain );
@@ -516,6 +516,17 @@ int8_t RegionAS923AlternateDr( int8_t currentDr, AlternateDrType_t type );
  */
 LoRaMacStatus_t RegionAS923NextChannel( NextChanParams_t* nextChanParams, uint8_t* channel, TimerTime_t* time, TimerTime_t* aggregatedTimeOff );
 
+/*!
+ * \brief Continues the listen before talk procedure started by RegionAS923NextChannel.
+ *
+ * \param [IN] channelIsFree Result of the carrier sense signaled by the radio.
+ *
+ * \param [OUT] channel Next channel to use for TX.
+ *
+ * \retval Status of the operation.
+ */
+LoRaMacStatus_t RegionAS923CarrierSenseDone( bool channelIsFree, uint8_t* channel );
+
 /*!
  * \brief Adds a channel.
  *
@@ -44,10 +44,6 @@
  */
 typedef struct sRegionAU915NvmCtx
 {
-    /*!
-     * LoRaMAC channels
-     */
-    ChannelParams_t Channels[ AU915_MAX_NB_CHANNELS ];
     /*!
      * LoRaMac bands
      */
@@ -64,12 +60,39 @@ typedef struct sRegionAU915NvmCtx
      * LoRaMac channels default mask
      */
     uint16_t ChannelsDefaultMask[ CHANNELS_MASK_SIZE ];
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    /*!
+     * Sub-bands and channel which got the join accepts
+     */
+    RegionCommonJoinLearning_t JoinLearning;
+#endif
 }RegionAU915NvmCtx_t;
 
 /*
  * Non-volatile module context.
  */
-static RegionAU915NvmCtx_t NvmCtx;
+static RegionAU915NvmCtx_t DefaultNvmCtx;
+
+/*
+ * Non-volatile module context in use. Bound to the context of the selected
+ * LoRaMac instance by INIT_TYPE_BIND_CTX.
+ */
+static RegionAU915NvmCtx_t* NvmCtx = &DefaultNvmCtx;
+
+/*!
+ * Channel plan: 64 channels of 125 kHz followed by 8 channels of 500 kHz
+ */
+static const RegionCommonChannelRange_t ChannelRanges[] =
+{
+    { 915200000,  200000, AU915_MAX_NB_CHANNELS - 8, { .Value = ( DR_5 << 4 ) | DR_0 }, 0 },
+    { 915900000, 1600000, 8,                         { .Value = ( DR_6 << 4 ) | DR_6 }, 0 },
+};
+
+static const RegionCommonChannelPlan_t ChannelPlan =
+{
+    .Ranges = ChannelRanges,
+    .NbRanges = 2,
+};
 
 // Static functions
 static int8_t GetNextLowerTxDr( int8_t dr, int8_t minDr )
@@ -284,12 +307,12 @@ PhyParam_t RegionAU915GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsMask;
             break;
         }
         case PHY_CHANNELS_DEFAULT_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsDefaultMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsDefaultMask;
             break;
         }
         case PHY_MAX_NB_CHANNELS:
@@ -299,7 +322,13 @@ PhyParam_t RegionAU915GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS:
         {
-            phyParam.Channels = NvmCtx.Channels;
+            // The channels are computed from the channel plan
+            phyParam.Channels = NULL;
+            break;
+        }
+        case PHY_CHANNEL:
+        {
+            RegionCommonChannelPlanGetChannel( &ChannelPlan, getPhy->Channel, &phyParam.Channel );
             break;
         }
         case PHY_DEF_UPLINK_DWELL_TIME:
@@ -380,7 +409,10 @@ PhyParam_t RegionAU915GetPhyParam( GetPhyParams_t* getPhy )
 
 void RegionAU915SetBandTxDone( SetBandTxDoneParams_t* txDone )
 {
-    RegionCommonSetBandTxDone( &NvmCtx.Bands[NvmCtx.Channels[txDone->Channel].Band],
+    ChannelParams_t channel;
+
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, txDone->Channel, &channel );
+    RegionCommonSetBandTxDone( &NvmCtx->Bands[channel.Band],
                                txDone->LastTxAirTime, txDone->Joined, txDone->ElapsedTimeSinceStartUp );
 }
 
@@ -396,37 +428,25 @@ void RegionAU915InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_DEFAULTS:
         {
             // Default bands
-            memcpy1( ( uint8_t* )NvmCtx.Bands, ( uint8_t* )bands, sizeof( Band_t ) * AU915_MAX_NB_BANDS );
-
-            // Channels
-            for( uint8_t i = 0; i < AU915_MAX_NB_CHANNELS - 8; i++ )
-            {
-                // 125 kHz channels
-                NvmCtx.Channels[i].Frequency = 915200000 + i * 200000;
-                NvmCtx.Channels[i].DrRange.Value = ( DR_5 << 4 ) | DR_0;
-                NvmCtx.Channels[i].Band = 0;
-            }
-            for( uint8_t i = AU915_MAX_NB_CHANNELS - 8; i < AU915_MAX_NB_CHANNELS; i++ )
-            {
-                // 500 kHz channels
-                NvmCtx.Channels[i].Frequency = 915900000 + ( i - ( AU915_MAX_NB_CHANNELS - 8 ) ) * 1600000;
-                NvmCtx.Channels[i].DrRange.Value = ( DR_6 << 4 ) | DR_6;
-                NvmCtx.Channels[i].Band = 0;
-            }
+            memcpy1( ( uint8_t* )NvmCtx->Bands, ( uint8_t* )bands, sizeof( Band_t ) * AU915_MAX_NB_BANDS );
 
             // Initialize channels default mask
-            NvmCtx.ChannelsDefaultMask[0] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[1] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[2] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[3] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[4] = 0x00FF;
-            NvmCtx.ChannelsDefaultMask[5] = 0x0000;
+            NvmCtx->ChannelsDefaultMask[0] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[1] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[2] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[3] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[4] = 0x00FF;
+            NvmCtx->ChannelsDefaultMask[5] = 0x0000;
 
             // Copy channels default mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
 
             // Copy into channels mask remaining
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMaskRemaining, NvmCtx.ChannelsMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMaskRemaining, NvmCtx->ChannelsMask, CHANNELS_MASK_SIZE );
+
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+            RegionCommonJoinLearningInit( &NvmCtx->JoinLearning );
+#endif
             break;
         }
         case INIT_TYPE_RESET_TO_DEFAULT_CHANNELS:
@@ -436,11 +456,11 @@ void RegionAU915InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_ACTIVATE_DEFAULT_CHANNELS:
         {
             // Copy channels default mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
 
             for( uint8_t i = 0; i < CHANNELS_MASK_SIZE; i++ )
             { // Copy-And the channels mask
-                NvmCtx.ChannelsMaskRemaining[i] &= NvmCtx.ChannelsMask[i];
+                NvmCtx->ChannelsMaskRemaining[i] &= NvmCtx->ChannelsMask[i];
             }
             break;
         }
@@ -448,7 +468,19 @@ void RegionAU915InitDefaults( InitDefaultsParams_t* params )
         {
             if( params->NvmCtx != 0 )
             {
-                memcpy1( (uint8_t*) &NvmCtx, (uint8_t*) params->NvmCtx, sizeof( NvmCtx ) );
+                memcpy1( (uint8_t*) NvmCtx, (uint8_t*) params->NvmCtx, sizeof( RegionAU915NvmCtx_t ) );
+            }
+            break;
+        }
+        case INIT_TYPE_BIND_CTX:
+        {
+            if( params->NvmCtx != 0 )
+            {
+                NvmCtx = ( RegionAU915NvmCtx_t* )params->NvmCtx;
+            }
+            else
+            {
+                NvmCtx = &DefaultNvmCtx;
             }
             break;
         }
@@ -462,7 +494,7 @@ void RegionAU915InitDefaults( InitDefaultsParams_t* params )
 void* RegionAU915GetNvmCtx( GetNvmCtxParams_t* params )
 {
     params->nvmCtxSize = sizeof( RegionAU915NvmCtx_t );
-    return &NvmCtx;
+    return NvmCtx;
 }
 
 bool RegionAU915Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
@@ -513,6 +545,11 @@ bool RegionAU915Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
 
 void RegionAU915ApplyCFList( ApplyCFListParams_t* applyCFList )
 {
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    // Only called on join accept
+    RegionCommonJoinLearningJoinAccept( &NvmCtx->JoinLearning, applyCFList->JoinChannel );
+#endif
+
     // Size of the optional CF list must be 16 byte
     if( applyCFList->Size != 16 )
     {
@@ -528,14 +565,14 @@ void RegionAU915ApplyCFList( ApplyCFListParams_t* applyCFList )
     // ChMask0 - ChMask4 must be set (every ChMask has 16 bit)
     for( uint8_t chMaskItr = 0, cntPayload = 0; chMaskItr <= 4; chMaskItr++, cntPayload+=2 )
     {
-        NvmCtx.ChannelsMask[chMaskItr] = (uint16_t) (0x00FF & applyCFList->Payload[cntPayload]);
-        NvmCtx.ChannelsMask[chMaskItr] |= (uint16_t) (applyCFList->Payload[cntPayload+1] << 8);
+        NvmCtx->ChannelsMask[chMaskItr] = (uint16_t) (0x00FF & applyCFList->Payload[cntPayload]);
+        NvmCtx->ChannelsMask[chMaskItr] |= (uint16_t) (applyCFList->Payload[cntPayload+1] << 8);
         if( chMaskItr == 4 )
         {
-            NvmCtx.ChannelsMask[chMaskItr] = NvmCtx.ChannelsMask[chMaskItr] & CHANNELS_MASK_500KHZ_MASK;
+            NvmCtx->ChannelsMask[chMaskItr] = NvmCtx->ChannelsMask[chMaskItr] & CHANNELS_MASK_500KHZ_MASK;
         }
         // Set the channel mask to the remaining
-        NvmCtx.ChannelsMaskRemaining[chMaskItr] &= NvmCtx.ChannelsMask[chMaskItr];
+        NvmCtx->ChannelsMaskRemaining[chMaskItr] &= NvmCtx->ChannelsMask[chMaskItr];
     }
 }
 
@@ -545,20 +582,20 @@ bool RegionAU915ChanMaskSet( ChanMaskSetParams_t* chanMaskSet )
     {
         case CHANNELS_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, chanMaskSet->ChannelsMaskIn, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, chanMaskSet->ChannelsMaskIn, 6 );
 
-            NvmCtx.ChannelsDefaultMask[4] = NvmCtx.ChannelsDefaultMask[4] & CHANNELS_MASK_500KHZ_MASK;
-            NvmCtx.ChannelsDefaultMask[5] = 0x0000;
+            NvmCtx->ChannelsDefaultMask[4] = NvmCtx->ChannelsDefaultMask[4] & CHANNELS_MASK_500KHZ_MASK;
+            NvmCtx->ChannelsDefaultMask[5] = 0x0000;
 
             for( uint8_t i = 0; i < 6; i++ )
             { // Copy-And the channels mask
-                NvmCtx.ChannelsMaskRemaining[i] &= NvmCtx.ChannelsMask[i];
+                NvmCtx->ChannelsMaskRemaining[i] &= NvmCtx->ChannelsMask[i];
             }
             break;
         }
         case CHANNELS_DEFAULT_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 6 );
             break;
         }
         default:
@@ -578,6 +615,7 @@ void RegionAU915ComputeRxWindowParameters( int8_t datarate, uint8_t minRxSymbols
     tSymbol = RegionCommonComputeSymbolTimeLoRa( DataratesAU915[rxConfigParams->Datarate], BandwidthsAU915[rxConfigParams->Datarate] );
 
     RegionCommonComputeRxWindowParameters( tSymbol, minRxSymbols, rxError, Radio.GetWakeupTime( ), &rxConfigParams->WindowTimeout, &rxConfigParams->WindowOffset );
+    rxConfigParams->SymbolTime = ( uint32_t )( tSymbol * 1000 );
 }
 
 bool RegionAU915RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
@@ -613,16 +651,20 @@ bool RegionAU915RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
 
 bool RegionAU915TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime_t* txTimeOnAir )
 {
+    ChannelParams_t channel;
     int8_t phyDr = DataratesAU915[txConfig->Datarate];
-    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx.Bands[NvmCtx.Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = 0;
     uint32_t bandwidth = GetBandwidth( txConfig->Datarate );
     int8_t phyTxPower = 0;
 
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, txConfig->Channel, &channel );
+    txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx->Bands[channel.Band].TxMaxPower, txConfig->Datarate, NvmCtx->ChannelsMask );
+
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, txConfig->MaxEirp, txConfig->AntennaGain );
 
     // Setup the radio frequency
-    Radio.SetChannel( NvmCtx.Channels[txConfig->Channel].Frequency );
+    Radio.SetChannel( channel.Frequency );
 
     Radio.SetTxConfig( MODEM_LORA, phyTxPower, 0, bandwidth, phyDr, 1, 8, false, true, 0, 0, false, 4000 );
 
@@ -647,7 +689,7 @@ uint8_t RegionAU915LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     RegionCommonLinkAdrReqVerifyParams_t linkAdrVerifyParams;
 
     // Initialize local copy of channels mask
-    RegionCommonChanMaskCopy( channelsMask, NvmCtx.ChannelsMask, 6 );
+    RegionCommonChanMaskCopy( channelsMask, NvmCtx->ChannelsMask, 6 );
 
     while( bytesProcessed < linkAdrReq->PayloadSize )
     {
@@ -765,7 +807,8 @@ uint8_t RegionAU915LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     linkAdrVerifyParams.ChannelsMask = channelsMask;
     linkAdrVerifyParams.MinDatarate = ( int8_t )phyParam.Value;
     linkAdrVerifyParams.MaxDatarate = AU915_TX_MAX_DATARATE;
-    linkAdrVerifyParams.Channels = NvmCtx.Channels;
+    linkAdrVerifyParams.Channels = NULL;
+    linkAdrVerifyParams.ChannelPlan = &ChannelPlan;
     linkAdrVerifyParams.MinTxPower = AU915_MIN_TX_POWER;
     linkAdrVerifyParams.MaxTxPower = AU915_MAX_TX_POWER;
     linkAdrVerifyParams.Version = linkAdrReq->Version;
@@ -777,14 +820,14 @@ uint8_t RegionAU915LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     if( status == 0x07 )
     {
         // Copy Mask
-        RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, channelsMask, 6 );
-
-        NvmCtx.ChannelsMaskRemaining[0] &= NvmCtx.ChannelsMask[0];
-        NvmCtx.ChannelsMaskRemaining[1] &= NvmCtx.ChannelsMask[1];
-        NvmCtx.ChannelsMaskRemaining[2] &= NvmCtx.ChannelsMask[2];
-        NvmCtx.ChannelsMaskRemaining[3] &= NvmCtx.ChannelsMask[3];
-        NvmCtx.ChannelsMaskRemaining[4] = NvmCtx.ChannelsMask[4];
-        NvmCtx.ChannelsMaskRemaining[5] = NvmCtx.ChannelsMask[5];
+        RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, channelsMask, 6 );
+
+        NvmCtx->ChannelsMaskRemaining[0] &= NvmCtx->ChannelsMask[0];
+        NvmCtx->ChannelsMaskRemaining[1] &= NvmCtx->ChannelsMask[1];
+        NvmCtx->ChannelsMaskRemaining[2] &= NvmCtx->ChannelsMask[2];
+        NvmCtx->ChannelsMaskRemaining[3] &= NvmCtx->ChannelsMask[3];
+        NvmCtx->ChannelsMaskRemaining[4] = NvmCtx->ChannelsMask[4];
+        NvmCtx->ChannelsMaskRemaining[5] = NvmCtx->ChannelsMask[5];
     }
 
     // Update status variables
@@ -848,7 +891,7 @@ int8_t RegionAU915AlternateDr( int8_t currentDr, AlternateDrType_t type )
     static int8_t trialsCount = 0;
 
     // Re-enable 500 kHz default channels
-    NvmCtx.ChannelsMask[4] = CHANNELS_MASK_500KHZ_MASK;
+    NvmCtx->ChannelsMask[4] = CHANNELS_MASK_500KHZ_MASK;
 
     if( ( trialsCount & 0x01 ) == 0x01 )
     {
@@ -872,25 +915,33 @@ LoRaMacStatus_t RegionAU915NextChannel( NextChanParams_t* nextChanParams, uint8_
     LoRaMacStatus_t status = LORAMAC_STATUS_NO_CHANNEL_FOUND;
 
     // Count 125kHz channels
-    if( RegionCommonCountChannels( NvmCtx.ChannelsMaskRemaining, 0, 4 ) == 0 )
+    if( RegionCommonCountChannels( NvmCtx->ChannelsMaskRemaining, 0, 4 ) == 0 )
     { // Reactivate default channels
-        RegionCommonChanMaskCopy( NvmCtx.ChannelsMaskRemaining, NvmCtx.ChannelsMask, 4  );
+        RegionCommonChanMaskCopy( NvmCtx->ChannelsMaskRemaining, NvmCtx->ChannelsMask, 4  );
     }
     // Check other channels
     if( nextChanParams->Datarate >= DR_6 )
     {
-        if( ( NvmCtx.ChannelsMaskRemaining[4] & CHANNELS_MASK_500KHZ_MASK ) == 0 )
+        if( ( NvmCtx->ChannelsMaskRemaining[4] & CHANNELS_MASK_500KHZ_MASK ) == 0 )
         {
-            NvmCtx.ChannelsMaskRemaining[4] = NvmCtx.ChannelsMask[4];
+            NvmCtx->ChannelsMaskRemaining[4] = NvmCtx->ChannelsMask[4];
         }
     }
 
     // Search how many channels are enabled
     countChannelsParams.Joined = nextChanParams->Joined;
     countChannelsParams.Datarate = nextChanParams->Datarate;
-    countChannelsParams.ChannelsMask = NvmCtx.ChannelsMaskRemaining;
-    countChannelsParams.Channels = NvmCtx.Channels;
-    countChannelsParams.Bands = NvmCtx.Bands;
+    countChannelsParams.ChannelsMask = NvmCtx->ChannelsMaskRemaining;
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    if( ( nextChanParams->Joined == false ) && ( RegionCommonJoinLearningIsLearned( &NvmCtx->JoinLearning ) == true ) )
+    {
+        // The learned sub-bands are probed again before all the channels got used
+        countChannelsParams.ChannelsMask = NvmCtx->ChannelsMask;
+    }
+#endif
+    countChannelsParams.Channels = NULL;
+    countChannelsParams.ChannelPlan = &ChannelPlan;
+    countChannelsParams.Bands = NvmCtx->Bands;
     countChannelsParams.MaxNbChannels = AU915_MAX_NB_CHANNELS;
     countChannelsParams.JoinChannels = 0;
 
@@ -910,10 +961,24 @@ LoRaMacStatus_t RegionAU915NextChannel( NextChanParams_t* nextChanParams, uint8_
 
     if( status == LORAMAC_STATUS_OK )
     {
-        // We found a valid channel
-        *channel = enabledChannels[randr( 0, nbEnabledChannels - 1 )];
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+        if( nextChanParams->Joined == false )
+        {
+            // Probe the sub-bands which got the join accepts first
+            if( RegionCommonJoinLearningNextChannel( &NvmCtx->JoinLearning, enabledChannels, nbEnabledChannels, channel ) == false )
+            {
+                *channel = enabledChannels[randr( 0, nbEnabledChannels - 1 )];
+            }
+            RegionCommonJoinLearningJoinRequest( &NvmCtx->JoinLearning, *channel );
+        }
+        else
+#endif
+        {
+            // We found a valid channel
+            *channel = enabledChannels[randr( 0, nbEnabledChannels - 1 )];
+        }
         // Disable the channel in the mask
-        RegionCommonChanDisable( NvmCtx.ChannelsMaskRemaining, *channel, AU915_MAX_NB_CHANNELS - 8 );
+        RegionCommonChanDisable( NvmCtx->ChannelsMaskRemaining, *channel, AU915_MAX_NB_CHANNELS - 8 );
     }
     return status;
 }
@@ -930,9 +995,14 @@ bool RegionAU915ChannelsRemove( ChannelRemoveParams_t* channelRemove  )
 
 void RegionAU915SetContinuousWave( ContinuousWaveParams_t* continuousWave )
 {
-    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx.Bands[NvmCtx.Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx.ChannelsMask );
+    ChannelParams_t channel;
+    int8_t txPowerLimited = 0;
     int8_t phyTxPower = 0;
-    uint32_t frequency = NvmCtx.Channels[continuousWave->Channel].Frequency;
+    uint32_t frequency = 0;
+
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, continuousWave->Channel, &channel );
+    txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx->Bands[channel.Band].TxMaxPower, continuousWave->Datarate, NvmCtx->ChannelsMask );
+    frequency = channel.Frequency;
 
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, continuousWave->MaxEirp, continuousWave->AntennaGain );
@@ -41,10 +41,6 @@
  */
 typedef struct sRegionCN470NvmCtx
 {
-    /*!
-     * LoRaMAC channels
-     */
-    ChannelParams_t Channels[ CN470_MAX_NB_CHANNELS ];
     /*!
      * LoRaMac bands
      */
@@ -62,7 +58,27 @@ typedef struct sRegionCN470NvmCtx
 /*
  * Non-volatile module context.
  */
-static RegionCN470NvmCtx_t NvmCtx;
+static RegionCN470NvmCtx_t DefaultNvmCtx;
+
+/*
+ * Non-volatile module context in use. Bound to the context of the selected
+ * LoRaMac instance by INIT_TYPE_BIND_CTX.
+ */
+static RegionCN470NvmCtx_t* NvmCtx = &DefaultNvmCtx;
+
+/*!
+ * Channel plan: 96 channels of 125 kHz
+ */
+static const RegionCommonChannelRange_t ChannelRanges[] =
+{
+    { 470300000, 200000, CN470_MAX_NB_CHANNELS, { .Value = ( DR_5 << 4 ) | DR_0 }, 0 },
+};
+
+static const RegionCommonChannelPlan_t ChannelPlan =
+{
+    .Ranges = ChannelRanges,
+    .NbRanges = 1,
+};
 
 // Static functions
 static int8_t GetNextLowerTxDr( int8_t dr, int8_t minDr )
@@ -244,12 +260,12 @@ PhyParam_t RegionCN470GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsMask;
             break;
         }
         case PHY_CHANNELS_DEFAULT_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsDefaultMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsDefaultMask;
             break;
         }
         case PHY_MAX_NB_CHANNELS:
@@ -259,7 +275,13 @@ PhyParam_t RegionCN470GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS:
         {
-            phyParam.Channels = NvmCtx.Channels;
+            // The channels are computed from the channel plan
+            phyParam.Channels = NULL;
+            break;
+        }
+        case PHY_CHANNEL:
+        {
+            RegionCommonChannelPlanGetChannel( &ChannelPlan, getPhy->Channel, &phyParam.Channel );
             break;
         }
         case PHY_DEF_UPLINK_DWELL_TIME:
@@ -336,7 +358,10 @@ PhyParam_t RegionCN470GetPhyParam( GetPhyParams_t* getPhy )
 
 void RegionCN470SetBandTxDone( SetBandTxDoneParams_t* txDone )
 {
-    RegionCommonSetBandTxDone( &NvmCtx.Bands[NvmCtx.Channels[txDone->Channel].Band],
+    ChannelParams_t channel;
+
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, txDone->Channel, &channel );
+    RegionCommonSetBandTxDone( &NvmCtx->Bands[channel.Band],
                                txDone->LastTxAirTime, txDone->Joined, txDone->ElapsedTimeSinceStartUp );
 }
 
@@ -352,27 +377,18 @@ void RegionCN470InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_DEFAULTS:
         {
             // Default bands
-            memcpy1( ( uint8_t* )NvmCtx.Bands, ( uint8_t* )bands, sizeof( Band_t ) * CN470_MAX_NB_BANDS );
-
-            // Channels
-            for( uint8_t i = 0; i < CN470_MAX_NB_CHANNELS; i++ )
-            {
-                // 125 kHz channels
-                NvmCtx.Channels[i].Frequency = 470300000 + i * 200000;
-                NvmCtx.Channels[i].DrRange.Value = ( DR_5 << 4 ) | DR_0;
-                NvmCtx.Channels[i].Band = 0;
-            }
+            memcpy1( ( uint8_t* )NvmCtx->Bands, ( uint8_t* )bands, sizeof( Band_t ) * CN470_MAX_NB_BANDS );
 
             // Initialize channels default mask
-            NvmCtx.ChannelsDefaultMask[0] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[1] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[2] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[3] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[4] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[5] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[0] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[1] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[2] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[3] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[4] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[5] = 0xFFFF;
 
             // Copy channels default mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
             break;
         }
         case INIT_TYPE_RESET_TO_DEFAULT_CHANNELS:
@@ -382,14 +398,26 @@ void RegionCN470InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_ACTIVATE_DEFAULT_CHANNELS:
         {
             // Copy channels default mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
             break;
         }
         case INIT_TYPE_RESTORE_CTX:
         {
             if( params->NvmCtx != 0 )
             {
-                memcpy1( (uint8_t*) &NvmCtx, (uint8_t*) params->NvmCtx, sizeof( NvmCtx ) );
+                memcpy1( (uint8_t*) NvmCtx, (uint8_t*) params->NvmCtx, sizeof( RegionCN470NvmCtx_t ) );
+            }
+            break;
+        }
+        case INIT_TYPE_BIND_CTX:
+        {
+            if( params->NvmCtx != 0 )
+            {
+                NvmCtx = ( RegionCN470NvmCtx_t* )params->NvmCtx;
+            }
+            else
+            {
+                NvmCtx = &DefaultNvmCtx;
             }
             break;
         }
@@ -403,7 +431,7 @@ void RegionCN470InitDefaults( InitDefaultsParams_t* params )
 void* RegionCN470GetNvmCtx( GetNvmCtxParams_t* params )
 {
     params->nvmCtxSize = sizeof( RegionCN470NvmCtx_t );
-    return &NvmCtx;
+    return NvmCtx;
 }
 
 bool RegionCN470Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
@@ -455,8 +483,8 @@ void RegionCN470ApplyCFList( ApplyCFListParams_t* applyCFList )
     // ChMask0 - ChMask5 must be set (every ChMask has 16 bit)
     for( uint8_t chMaskItr = 0, cntPayload = 0; chMaskItr <= 5; chMaskItr++, cntPayload+=2 )
     {
-        NvmCtx.ChannelsMask[chMaskItr] = (uint16_t) (0x00FF & applyCFList->Payload[cntPayload]);
-        NvmCtx.ChannelsMask[chMaskItr] |= (uint16_t) (applyCFList->Payload[cntPayload+1] << 8);
+        NvmCtx->ChannelsMask[chMaskItr] = (uint16_t) (0x00FF & applyCFList->Payload[cntPayload]);
+        NvmCtx->ChannelsMask[chMaskItr] |= (uint16_t) (applyCFList->Payload[cntPayload+1] << 8);
     }
 }
 
@@ -466,12 +494,12 @@ bool RegionCN470ChanMaskSet( ChanMaskSetParams_t* chanMaskSet )
     {
         case CHANNELS_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, chanMaskSet->ChannelsMaskIn, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, chanMaskSet->ChannelsMaskIn, 6 );
             break;
         }
         case CHANNELS_DEFAULT_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 6 );
             break;
         }
         default:
@@ -491,6 +519,7 @@ void RegionCN470ComputeRxWindowParameters( int8_t datarate, uint8_t minRxSymbols
     tSymbol = RegionCommonComputeSymbolTimeLoRa( DataratesCN470[rxConfigParams->Datarate], BandwidthsCN470[rxConfigParams->Datarate] );
 
     RegionCommonComputeRxWindowParameters( tSymbol, minRxSymbols, rxError, Radio.GetWakeupTime( ), &rxConfigParams->WindowTimeout, &rxConfigParams->WindowOffset );
+    rxConfigParams->SymbolTime = ( uint32_t )( tSymbol * 1000 );
 }
 
 bool RegionCN470RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
@@ -526,15 +555,19 @@ bool RegionCN470RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
 
 bool RegionCN470TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime_t* txTimeOnAir )
 {
+    ChannelParams_t channel;
     int8_t phyDr = DataratesCN470[txConfig->Datarate];
-    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx.Bands[NvmCtx.Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = 0;
     int8_t phyTxPower = 0;
 
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, txConfig->Channel, &channel );
+    txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx->Bands[channel.Band].TxMaxPower, txConfig->Datarate, NvmCtx->ChannelsMask );
+
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, txConfig->MaxEirp, txConfig->AntennaGain );
 
     // Setup the radio frequency
-    Radio.SetChannel( NvmCtx.Channels[txConfig->Channel].Frequency );
+    Radio.SetChannel( channel.Frequency );
 
     Radio.SetTxConfig( MODEM_LORA, phyTxPower, 0, 0, phyDr, 1, 8, false, true, 0, 0, false, 4000 );
     // Setup maximum payload lenght of the radio driver
@@ -556,9 +589,10 @@ uint8_t RegionCN470LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     GetPhyParams_t getPhy;
     PhyParam_t phyParam;
     RegionCommonLinkAdrReqVerifyParams_t linkAdrVerifyParams;
+    ChannelParams_t channel;
 
     // Initialize local copy of channels mask
-    RegionCommonChanMaskCopy( channelsMask, NvmCtx.ChannelsMask, 6 );
+    RegionCommonChanMaskCopy( channelsMask, NvmCtx->ChannelsMask, 6 );
 
     while( bytesProcessed < linkAdrReq->PayloadSize )
     {
@@ -592,8 +626,9 @@ uint8_t RegionCN470LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
         {
             for( uint8_t i = 0; i < 16; i++ )
             {
+                RegionCommonChannelPlanGetChannel( &ChannelPlan, linkAdrParams.ChMaskCtrl * 16 + i, &channel );
                 if( ( ( linkAdrParams.ChMask & ( 1 << i ) ) != 0 ) &&
-                    ( NvmCtx.Channels[linkAdrParams.ChMaskCtrl * 16 + i].Frequency == 0 ) )
+                    ( channel.Frequency == 0 ) )
                 {// Trying to enable an undefined channel
                     status &= 0xFE; // Channel mask KO
                 }
@@ -619,7 +654,8 @@ uint8_t RegionCN470LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     linkAdrVerifyParams.ChannelsMask = channelsMask;
     linkAdrVerifyParams.MinDatarate = ( int8_t )phyParam.Value;
     linkAdrVerifyParams.MaxDatarate = CN470_TX_MAX_DATARATE;
-    linkAdrVerifyParams.Channels = NvmCtx.Channels;
+    linkAdrVerifyParams.Channels = NULL;
+    linkAdrVerifyParams.ChannelPlan = &ChannelPlan;
     linkAdrVerifyParams.MinTxPower = CN470_MIN_TX_POWER;
     linkAdrVerifyParams.MaxTxPower = CN470_MAX_TX_POWER;
     linkAdrVerifyParams.Version = linkAdrReq->Version;
@@ -631,7 +667,7 @@ uint8_t RegionCN470LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     if( status == 0x07 )
     {
         // Copy Mask
-        RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, channelsMask, 6 );
+        RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, channelsMask, 6 );
     }
 
     // Update status variables
@@ -699,22 +735,23 @@ LoRaMacStatus_t RegionCN470NextChannel( NextChanParams_t* nextChanParams, uint8_
     LoRaMacStatus_t status = LORAMAC_STATUS_NO_CHANNEL_FOUND;
 
     // Count 125kHz channels
-    if( RegionCommonCountChannels( NvmCtx.ChannelsMask, 0, 6 ) == 0 )
+    if( RegionCommonCountChannels( NvmCtx->ChannelsMask, 0, 6 ) == 0 )
     { // Reactivate default channels
-        NvmCtx.ChannelsMask[0] = 0xFFFF;
-        NvmCtx.ChannelsMask[1] = 0xFFFF;
-        NvmCtx.ChannelsMask[2] = 0xFFFF;
-        NvmCtx.ChannelsMask[3] = 0xFFFF;
-        NvmCtx.ChannelsMask[4] = 0xFFFF;
-        NvmCtx.ChannelsMask[5] = 0xFFFF;
+        NvmCtx->ChannelsMask[0] = 0xFFFF;
+        NvmCtx->ChannelsMask[1] = 0xFFFF;
+        NvmCtx->ChannelsMask[2] = 0xFFFF;
+        NvmCtx->ChannelsMask[3] = 0xFFFF;
+        NvmCtx->ChannelsMask[4] = 0xFFFF;
+        NvmCtx->ChannelsMask[5] = 0xFFFF;
     }
 
     // Search how many channels are enabled
     countChannelsParams.Joined = nextChanParams->Joined;
     countChannelsParams.Datarate = nextChanParams->Datarate;
-    countChannelsParams.ChannelsMask = NvmCtx.ChannelsMask;
-    countChannelsParams.Channels = NvmCtx.Channels;
-    countChannelsParams.Bands = NvmCtx.Bands;
+    countChannelsParams.ChannelsMask = NvmCtx->ChannelsMask;
+    countChannelsParams.Channels = NULL;
+    countChannelsParams.ChannelPlan = &ChannelPlan;
+    countChannelsParams.Bands = NvmCtx->Bands;
     countChannelsParams.MaxNbChannels = CN470_MAX_NB_CHANNELS;
     countChannelsParams.JoinChannels = 0;
 
@@ -752,9 +789,14 @@ bool RegionCN470ChannelsRemove( ChannelRemoveParams_t* channelRemove  )
 
 void RegionCN470SetContinuousWave( ContinuousWaveParams_t* continuousWave )
 {
-    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx.Bands[NvmCtx.Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx.ChannelsMask );
+    ChannelParams_t channel;
+    int8_t txPowerLimited = 0;
     int8_t phyTxPower = 0;
-    uint32_t frequency = NvmCtx.Channels[continuousWave->Channel].Frequency;
+    uint32_t frequency = 0;
+
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, continuousWave->Channel, &channel );
+    txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx->Bands[channel.Band].TxMaxPower, continuousWave->Datarate, NvmCtx->ChannelsMask );
+    frequency = channel.Frequency;
 
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, continuousWave->MaxEirp, continuousWave->AntennaGain );
@@ -62,7 +62,13 @@ typedef struct sRegionCN779NvmCtx
 /*
  * Non-volatile module context.
  */
-static RegionCN779NvmCtx_t NvmCtx;
+static RegionCN779NvmCtx_t DefaultNvmCtx;
+
+/*
+ * Non-volatile module context in use. Bound to the context of the selected
+ * LoRaMac instance by INIT_TYPE_BIND_CTX.
+ */
+static RegionCN779NvmCtx_t* NvmCtx = &DefaultNvmCtx;
 
 // Static functions
 static int8_t GetNextLowerTxDr( int8_t dr, int8_t minDr )
@@ -244,12 +250,12 @@ PhyParam_t RegionCN779GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsMask;
             break;
         }
         case PHY_CHANNELS_DEFAULT_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsDefaultMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsDefaultMask;
             break;
         }
         case PHY_MAX_NB_CHANNELS:
@@ -259,7 +265,15 @@ PhyParam_t RegionCN779GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS:
         {
-            phyParam.Channels = NvmCtx.Channels;
+            phyParam.Channels = NvmCtx->Channels;
+            break;
+        }
+        case PHY_CHANNEL:
+        {
+            if( getPhy->Channel < CN779_MAX_NB_CHANNELS )
+            {
+                phyParam.Channel = NvmCtx->Channels[getPhy->Channel];
+            }
             break;
         }
         case PHY_DEF_UPLINK_DWELL_TIME:
@@ -326,7 +340,7 @@ PhyParam_t RegionCN779GetPhyParam( GetPhyParams_t* getPhy )
 
 void RegionCN779SetBandTxDone( SetBandTxDoneParams_t* txDone )
 {
-    RegionCommonSetBandTxDone( &NvmCtx.Bands[NvmCtx.Channels[txDone->Channel].Band],
+    RegionCommonSetBandTxDone( &NvmCtx->Bands[NvmCtx->Channels[txDone->Channel].Band],
                                txDone->LastTxAirTime, txDone->Joined, txDone->ElapsedTimeSinceStartUp );
 }
 
@@ -342,41 +356,53 @@ void RegionCN779InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_DEFAULTS:
         {
             // Default bands
-            memcpy1( ( uint8_t* )NvmCtx.Bands, ( uint8_t* )bands, sizeof( Band_t ) * CN779_MAX_NB_BANDS );
+            memcpy1( ( uint8_t* )NvmCtx->Bands, ( uint8_t* )bands, sizeof( Band_t ) * CN779_MAX_NB_BANDS );
 
             // Default channels
-            NvmCtx.Channels[0] = ( ChannelParams_t ) CN779_LC1;
-            NvmCtx.Channels[1] = ( ChannelParams_t ) CN779_LC2;
-            NvmCtx.Channels[2] = ( ChannelParams_t ) CN779_LC3;
+            NvmCtx->Channels[0] = ( ChannelParams_t ) CN779_LC1;
+            NvmCtx->Channels[1] = ( ChannelParams_t ) CN779_LC2;
+            NvmCtx->Channels[2] = ( ChannelParams_t ) CN779_LC3;
 
             // Default ChannelsMask
-            NvmCtx.ChannelsDefaultMask[0] = LC( 1 ) + LC( 2 ) + LC( 3 );
+            NvmCtx->ChannelsDefaultMask[0] = LC( 1 ) + LC( 2 ) + LC( 3 );
 
             // Update the channels mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
             break;
         }
         case INIT_TYPE_RESET_TO_DEFAULT_CHANNELS:
         {
             // Reset Channels Rx1Frequency to default 0
-            NvmCtx.Channels[0].Rx1Frequency = 0;
-            NvmCtx.Channels[1].Rx1Frequency = 0;
-            NvmCtx.Channels[2].Rx1Frequency = 0;
+            NvmCtx->Channels[0].Rx1Frequency = 0;
+            NvmCtx->Channels[1].Rx1Frequency = 0;
+            NvmCtx->Channels[2].Rx1Frequency = 0;
             // Update the channels mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, CHANNELS_MASK_SIZE );
             break;
         }
         case INIT_TYPE_ACTIVATE_DEFAULT_CHANNELS:
         {
             // Restore channels default mask
-            NvmCtx.ChannelsMask[0] |= NvmCtx.ChannelsDefaultMask[0];
+            NvmCtx->ChannelsMask[0] |= NvmCtx->ChannelsDefaultMask[0];
             break;
         }
         case INIT_TYPE_RESTORE_CTX:
         {
             if( params->NvmCtx != 0 )
             {
-                memcpy1( (uint8_t*) &NvmCtx, (uint8_t*) params->NvmCtx, sizeof( NvmCtx ) );
+                memcpy1( (uint8_t*) NvmCtx, (uint8_t*) params->NvmCtx, sizeof( RegionCN779NvmCtx_t ) );
+            }
+            break;
+        }
+        case INIT_TYPE_BIND_CTX:
+        {
+            if( params->NvmCtx != 0 )
+            {
+                NvmCtx = ( RegionCN779NvmCtx_t* )params->NvmCtx;
+            }
+            else
+            {
+                NvmCtx = &DefaultNvmCtx;
             }
             break;
         }
@@ -390,7 +416,7 @@ void RegionCN779InitDefaults( InitDefaultsParams_t* params )
 void* RegionCN779GetNvmCtx( GetNvmCtxParams_t* params )
 {
     params->nvmCtxSize = sizeof( RegionCN779NvmCtx_t );
-    return &NvmCtx;
+    return NvmCtx;
 }
 
 bool RegionCN779Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
@@ -493,12 +519,12 @@ bool RegionCN779ChanMaskSet( ChanMaskSetParams_t* chanMaskSet )
     {
         case CHANNELS_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, chanMaskSet->ChannelsMaskIn, 1 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, chanMaskSet->ChannelsMaskIn, 1 );
             break;
         }
         case CHANNELS_DEFAULT_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 1 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, 1 );
             break;
         }
         default:
@@ -525,6 +551,7 @@ void RegionCN779ComputeRxWindowParameters( int8_t datarate, uint8_t minRxSymbols
     }
 
     RegionCommonComputeRxWindowParameters( tSymbol, minRxSymbols, rxError, Radio.GetWakeupTime( ), &rxConfigParams->WindowTimeout, &rxConfigParams->WindowOffset );
+    rxConfigParams->SymbolTime = ( uint32_t )( tSymbol * 1000 );
 }
 
 bool RegionCN779RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
@@ -542,11 +569,11 @@ bool RegionCN779RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
     if( rxConfig->RxSlot == RX_SLOT_WIN_1 )
     {
         // Apply window 1 frequency
-        frequency = NvmCtx.Channels[rxConfig->Channel].Frequency;
+        frequency = NvmCtx->Channels[rxConfig->Channel].Frequency;
         // Apply the alternative RX 1 window frequency, if it is available
-        if( NvmCtx.Channels[rxConfig->Channel].Rx1Frequency != 0 )
+        if( NvmCtx->Channels[rxConfig->Channel].Rx1Frequency != 0 )
         {
-            frequency = NvmCtx.Channels[rxConfig->Channel].Rx1Frequency;
+            frequency = NvmCtx->Channels[rxConfig->Channel].Rx1Frequency;
         }
     }
 
@@ -577,7 +604,7 @@ bool RegionCN779TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime
 {
     RadioModems_t modem;
     int8_t phyDr = DataratesCN779[txConfig->Datarate];
-    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx.Bands[NvmCtx.Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx->Bands[NvmCtx->Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx->ChannelsMask );
     uint32_t bandwidth = GetBandwidth( txConfig->Datarate );
     int8_t phyTxPower = 0;
 
@@ -585,7 +612,7 @@ bool RegionCN779TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, txConfig->MaxEirp, txConfig->AntennaGain );
 
     // Setup the radio frequency
-    Radio.SetChannel( NvmCtx.Channels[txConfig->Channel].Frequency );
+    Radio.SetChannel( NvmCtx->Channels[txConfig->Channel].Frequency );
 
     if( txConfig->Datarate == DR_7 )
     { // High Speed FSK channel
@@ -653,7 +680,7 @@ uint8_t RegionCN779LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
             {
                 if( linkAdrParams.ChMaskCtrl == 6 )
                 {
-                    if( NvmCtx.Channels[i].Frequency != 0 )
+                    if( NvmCtx->Channels[i].Frequency != 0 )
                     {
                         chMask |= 1 << i;
                     }
@@ -661,7 +688,7 @@ uint8_t RegionCN779LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
                 else
                 {
                     if( ( ( chMask & ( 1 << i ) ) != 0 ) &&
-                        ( NvmCtx.Channels[i].Frequency == 0 ) )
+                        ( NvmCtx->Channels[i].Frequency == 0 ) )
                     {// Trying to enable an undefined channel
                         status &= 0xFE; // Channel mask KO
                     }
@@ -687,7 +714,7 @@ uint8_t RegionCN779LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     linkAdrVerifyParams.ChannelsMask = &chMask;
     linkAdrVerifyParams.MinDatarate = ( int8_t )phyParam.Value;
     linkAdrVerifyParams.MaxDatarate = CN779_TX_MAX_DATARATE;
-    linkAdrVerifyParams.Channels = NvmCtx.Channels;
+    linkAdrVerifyParams.Channels = NvmCtx->Channels;
     linkAdrVerifyParams.MinTxPower = CN779_MIN_TX_POWER;
     linkAdrVerifyParams.MaxTxPower = CN779_MAX_TX_POWER;
     linkAdrVerifyParams.Version = linkAdrReq->Version;
@@ -699,9 +726,9 @@ uint8_t RegionCN779LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     if( status == 0x07 )
     {
         // Set the channels mask to a default value
-        memset1( ( uint8_t* ) NvmCtx.ChannelsMask, 0, sizeof( NvmCtx.ChannelsMask ) );
+        memset1( ( uint8_t* ) NvmCtx->ChannelsMask, 0, sizeof( NvmCtx->ChannelsMask ) );
         // Update the channels mask
-        NvmCtx.ChannelsMask[0] = chMask;
+        NvmCtx->ChannelsMask[0] = chMask;
     }
 
     // Update status variables
@@ -807,7 +834,7 @@ uint8_t RegionCN779DlChannelReq( DlChannelReqParams_t* dlChannelReq )
     }
 
     // Verify if an uplink frequency exists
-    if( NvmCtx.Channels[dlChannelReq->ChannelId].Frequency == 0 )
+    if( NvmCtx->Channels[dlChannelReq->ChannelId].Frequency == 0 )
     {
         status &= 0xFD;
     }
@@ -815,7 +842,7 @@ uint8_t RegionCN779DlChannelReq( DlChannelReqParams_t* dlChannelReq )
     // Apply Rx1 frequency, if the status is OK
     if( status == 0x03 )
     {
-        NvmCtx.Channels[dlChannelReq->ChannelId].Rx1Frequency = dlChannelReq->Rx1Frequency;
+        NvmCtx->Channels[dlChannelReq->ChannelId].Rx1Frequency = dlChannelReq->Rx1Frequency;
     }
 
     return status;
@@ -835,17 +862,17 @@ LoRaMacStatus_t RegionCN779NextChannel( NextChanParams_t* nextChanParams, uint8_
     RegionCommonCountNbOfEnabledChannelsParams_t countChannelsParams;
     LoRaMacStatus_t status = LORAMAC_STATUS_NO_CHANNEL_FOUND;
 
-    if( RegionCommonCountChannels( NvmCtx.ChannelsMask, 0, 1 ) == 0 )
+    if( RegionCommonCountChannels( NvmCtx->ChannelsMask, 0, 1 ) == 0 )
     { // Reactivate default channels
-        NvmCtx.ChannelsMask[0] |= LC( 1 ) + LC( 2 ) + LC( 3 );
+        NvmCtx->ChannelsMask[0] |= LC( 1 ) + LC( 2 ) + LC( 3 );
     }
 
     // Search how many channels are enabled
     countChannelsParams.Joined = nextChanParams->Joined;
     countChannelsParams.Datarate = nextChanParams->Datarate;
-    countChannelsParams.ChannelsMask = NvmCtx.ChannelsMask;
-    countChannelsParams.Channels = NvmCtx.Channels;
-    countChannelsParams.Bands = NvmCtx.Bands;
+    countChannelsParams.ChannelsMask = NvmCtx->ChannelsMask;
+    countChannelsParams.Channels = NvmCtx->Channels;
+    countChannelsParams.Bands = NvmCtx->Bands;
     countChannelsParams.MaxNbChannels = CN779_MAX_NB_CHANNELS;
     countChannelsParams.JoinChannels = CN779_JOIN_CHANNELS;
 
@@ -871,7 +898,7 @@ LoRaMacStatus_t RegionCN779NextChannel( NextChanParams_t* nextChanParams, uint8_
     else if( status == LORAMAC_STATUS_NO_CHANNEL_FOUND )
     {
         // Datarate not supported by any channel, restore defaults
-        NvmCtx.ChannelsMask[0] |= LC( 1 ) + LC( 2 ) + LC( 3 );
+        NvmCtx->ChannelsMask[0] |= LC( 1 ) + LC( 2 ) + LC( 3 );
     }
     return status;
 }
@@ -929,9 +956,9 @@ LoRaMacStatus_t RegionCN779ChannelAdd( ChannelAddParams_t* channelAdd )
         return LORAMAC_STATUS_FREQUENCY_INVALID;
     }
 
-    memcpy1( ( uint8_t* ) &(NvmCtx.Channels[id]), ( uint8_t* ) channelAdd->NewChannel, sizeof( NvmCtx.Channels[id] ) );
-    NvmCtx.Channels[id].Band = 0;
-    NvmCtx.ChannelsMask[0] |= ( 1 << id );
+    memcpy1( ( uint8_t* ) &(NvmCtx->Channels[id]), ( uint8_t* ) channelAdd->NewChannel, sizeof( NvmCtx->Channels[id] ) );
+    NvmCtx->Channels[id].Band = 0;
+    NvmCtx->ChannelsMask[0] |= ( 1 << id );
     return LORAMAC_STATUS_OK;
 }
 
@@ -945,16 +972,16 @@ bool RegionCN779ChannelsRemove( ChannelRemoveParams_t* channelRemove  )
     }
 
     // Remove the channel from the list of channels
-    NvmCtx.Channels[id] = ( ChannelParams_t ){ 0, 0, { 0 }, 0 };
+    NvmCtx->Channels[id] = ( ChannelParams_t ){ 0, 0, { 0 }, 0 };
 
-    return RegionCommonChanDisable( NvmCtx.ChannelsMask, id, CN779_MAX_NB_CHANNELS );
+    return RegionCommonChanDisable( NvmCtx->ChannelsMask, id, CN779_MAX_NB_CHANNELS );
 }
 
 void RegionCN779SetContinuousWave( ContinuousWaveParams_t* continuousWave )
 {
-    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx.Bands[NvmCtx.Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx->Bands[NvmCtx->Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx->ChannelsMask );
     int8_t phyTxPower = 0;
-    uint32_t frequency = NvmCtx.Channels[continuousWave->Channel].Frequency;
+    uint32_t frequency = NvmCtx->Channels[continuousWave->Channel].Frequency;
 
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, continuousWave->MaxEirp, continuousWave->AntennaGain );
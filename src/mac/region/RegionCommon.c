@@ -32,6 +32,7 @@
 #include "radio.h"
 #include "utilities.h"
 #include "RegionCommon.h"
+#include "tracepoint.h"
 
 #define BACKOFF_DC_1_HOUR                   100
 #define BACKOFF_DC_10_HOURS                 1000
@@ -169,8 +170,36 @@ uint16_t RegionCommonGetJoinDc( SysTime_t elapsedTime )
     return dutyCycle;
 }
 
-bool RegionCommonChanVerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_t dr, int8_t minDr, int8_t maxDr, ChannelParams_t* channels )
+/*!
+ * \brief Gets the parameters of a channel, either from the channels array or
+ *        from the channel plan.
+ *
+ * \param [IN] channels The channels of the region, NULL when the region uses
+ *                      a channel plan.
+ *
+ * \param [IN] channelPlan The channel plan of the region.
+ *
+ * \param [IN] id Channel index.
+ *
+ * \param [OUT] channel Channel parameters.
+ */
+static void GetChannel( ChannelParams_t* channels, const RegionCommonChannelPlan_t* channelPlan, uint8_t id, ChannelParams_t* channel )
+{
+    if( channels != NULL )
+    {
+        *channel = channels[id];
+    }
+    else
+    {
+        RegionCommonChannelPlanGetChannel( channelPlan, id, channel );
+    }
+}
+
+static bool VerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_t dr, int8_t minDr, int8_t maxDr,
+                      ChannelParams_t* channels, const RegionCommonChannelPlan_t* channelPlan )
 {
+    ChannelParams_t channel;
+
     if( RegionCommonValueInRange( dr, minDr, maxDr ) == 0 )
     {
         return false;
@@ -182,8 +211,9 @@ bool RegionCommonChanVerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_
         {
             if( ( ( channelsMask[k] & ( 1 << j ) ) != 0 ) )
             {// Check datarate validity for enabled channels
-                if( RegionCommonValueInRange( dr, ( channels[i + j].DrRange.Fields.Min & 0x0F ),
-                                                  ( channels[i + j].DrRange.Fields.Max & 0x0F ) ) == 1 )
+                GetChannel( channels, channelPlan, i + j, &channel );
+                if( RegionCommonValueInRange( dr, ( channel.DrRange.Fields.Min & 0x0F ),
+                                                  ( channel.DrRange.Fields.Max & 0x0F ) ) == 1 )
                 {
                     // At least 1 channel has been found we can return OK.
                     return true;
@@ -194,6 +224,33 @@ bool RegionCommonChanVerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_
     return false;
 }
 
+bool RegionCommonChanVerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_t dr, int8_t minDr, int8_t maxDr, ChannelParams_t* channels )
+{
+    return VerifyDr( nbChannels, channelsMask, dr, minDr, maxDr, channels, NULL );
+}
+
+void RegionCommonChannelPlanGetChannel( const RegionCommonChannelPlan_t* channelPlan, uint8_t id, ChannelParams_t* channel )
+{
+    channel->Frequency = 0;
+    channel->Rx1Frequency = 0;
+    channel->DrRange.Value = 0;
+    channel->Band = 0;
+
+    for( uint8_t i = 0; i < channelPlan->NbRanges; i++ )
+    {
+        const RegionCommonChannelRange_t* range = &channelPlan->Ranges[i];
+
+        if( id < range->NbChannels )
+        {
+            channel->Frequency = range->Frequency + id * range->Spacing;
+            channel->DrRange = range->DrRange;
+            channel->Band = range->Band;
+            return;
+        }
+        id -= range->NbChannels;
+    }
+}
+
 uint8_t RegionCommonValueInRange( int8_t value, int8_t min, int8_t max )
 {
     if( ( value >= min ) && ( value <= max ) )
@@ -372,8 +429,8 @@ uint8_t RegionCommonLinkAdrReqVerifyParams( RegionCommonLinkAdrReqVerifyParams_t
     if( status != 0 )
     {
         // Verify datarate. The variable phyParam. Value contains the minimum allowed datarate.
-        if( RegionCommonChanVerifyDr( verifyParams->NbChannels, verifyParams->ChannelsMask, datarate,
-                                      verifyParams->MinDatarate, verifyParams->MaxDatarate, verifyParams->Channels  ) == false )
+        if( VerifyDr( verifyParams->NbChannels, verifyParams->ChannelsMask, datarate,
+                      verifyParams->MinDatarate, verifyParams->MaxDatarate, verifyParams->Channels, verifyParams->ChannelPlan ) == false )
         {
             status &= 0xFD; // Datarate KO
         }
@@ -423,7 +480,7 @@ double RegionCommonComputeSymbolTimeFsk( uint8_t phyDr )
 void RegionCommonComputeRxWindowParameters( double tSymbol, uint8_t minRxSymbols, uint32_t rxError, uint32_t wakeUpTime, uint32_t* windowTimeout, int32_t* windowOffset )
 {
     *windowTimeout = MAX( ( uint32_t )ceil( ( ( 2 * minRxSymbols - 8 ) * tSymbol + 2 * rxError ) / tSymbol ), minRxSymbols ); // Computed number of symbols
-    *windowOffset = ( int32_t )ceil( ( 4.0 * tSymbol ) - ( ( *windowTimeout * tSymbol ) / 2.0 ) - wakeUpTime );
+    *windowOffset = ( int32_t )ceil( ( ( 4.0 * tSymbol ) - ( ( *windowTimeout * tSymbol ) / 2.0 ) - wakeUpTime ) * 1000.0 );
 }
 
 int8_t RegionCommonComputeTxPower( int8_t txPowerIndex, float maxEirp, float antennaGain )
@@ -468,6 +525,7 @@ void RegionCommonCountNbOfEnabledChannels( RegionCommonCountNbOfEnabledChannelsP
 {
     uint8_t nbChannelCount = 0;
     uint8_t nbRestrictedChannelsCount = 0;
+    ChannelParams_t channel;
 
     for( uint8_t i = 0, k = 0; i < countNbOfEnabledChannelsParams->MaxNbChannels; i += 16, k++ )
     {
@@ -475,7 +533,8 @@ void RegionCommonCountNbOfEnabledChannels( RegionCommonCountNbOfEnabledChannelsP
         {
             if( ( countNbOfEnabledChannelsParams->ChannelsMask[k] & ( 1 << j ) ) != 0 )
             {
-                if( countNbOfEnabledChannelsParams->Channels[i + j].Frequency == 0 )
+                GetChannel( countNbOfEnabledChannelsParams->Channels, countNbOfEnabledChannelsParams->ChannelPlan, i + j, &channel );
+                if( channel.Frequency == 0 )
                 { // Check if the channel is enabled
                     continue;
                 }
@@ -488,12 +547,11 @@ void RegionCommonCountNbOfEnabledChannels( RegionCommonCountNbOfEnabledChannelsP
                     }
                 }
                 if( RegionCommonValueInRange( countNbOfEnabledChannelsParams->Datarate,
-                                              countNbOfEnabledChannelsParams->Channels[i + j].DrRange.Fields.Min,
-                                              countNbOfEnabledChannelsParams->Channels[i + j].DrRange.Fields.Max ) == false )
+                                              channel.DrRange.Fields.Min, channel.DrRange.Fields.Max ) == false )
                 { // Check if the current channel selection supports the given datarate
                     continue;
                 }
-                if( countNbOfEnabledChannelsParams->Bands[countNbOfEnabledChannelsParams->Channels[i + j].Band].ReadyForTransmission == false )
+                if( countNbOfEnabledChannelsParams->Bands[channel.Band].ReadyForTransmission == false )
                 { // Check if the band is available for transmission
                     nbRestrictedChannelsCount++;
                     continue;
@@ -511,6 +569,10 @@ LoRaMacStatus_t RegionCommonIdentifyChannels( RegionCommonIdentifyChannelsParam_
                                               uint8_t* nbEnabledChannels, uint8_t* nbRestrictedChannels,
                                               TimerTime_t* nextTxDelay )
 {
+    LoRaMacStatus_t status = LORAMAC_STATUS_NO_CHANNEL_FOUND;
+
+    TRACE_POINT_BEGIN( TRACE_POINT_IDENTIFY_CHANNELS );
+
     TimerTime_t elapsed = TimerGetElapsedTime( identifyChannelsParam->LastAggrTx );
     *nextTxDelay = identifyChannelsParam->AggrTimeOff - elapsed;
     *nbRestrictedChannels = 1;
@@ -538,14 +600,236 @@ LoRaMacStatus_t RegionCommonIdentifyChannels( RegionCommonIdentifyChannelsParam_
     if( *nbEnabledChannels > 0 )
     {
         *nextTxDelay = 0;
-        return LORAMAC_STATUS_OK;
+        status = LORAMAC_STATUS_OK;
     }
     else if( *nbRestrictedChannels > 0 )
     {
-        return LORAMAC_STATUS_DUTYCYCLE_RESTRICTED;
+        status = LORAMAC_STATUS_DUTYCYCLE_RESTRICTED;
     }
-    else
+
+    TRACE_POINT_END( TRACE_POINT_IDENTIFY_CHANNELS );
+    return status;
+}
+
+static void CarrierSenseNextChannel( RegionCommonCarrierSense_t* carrierSense )
+{
+    carrierSense->NbAttempts++;
+    carrierSense->Index = ( carrierSense->Index + 1 ) % carrierSense->NbEnabledChannels;
+}
+
+LoRaMacStatus_t RegionCommonCarrierSenseStart( RegionCommonCarrierSense_t* carrierSense, uint8_t* channel )
+{
+    ChannelParams_t* chan = NULL;
+
+    if( ( carrierSense == NULL ) || ( channel == NULL ) || ( carrierSense->NbEnabledChannels == 0 ) )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    if( Radio.StartChannelFree == NULL )
+    {
+        // The radio driver only provides the blocking carrier sense
+        while( carrierSense->NbAttempts < carrierSense->MaxNbAttempts )
+        {
+            chan = &carrierSense->Channels[carrierSense->EnabledChannels[carrierSense->Index]];
+            if( Radio.IsChannelFree( chan->Frequency, carrierSense->RxBandwidth,
+                                     carrierSense->RssiFreeThreshold, carrierSense->CarrierSenseTime ) == true )
+            {
+                // Free channel found
+                *channel = carrierSense->EnabledChannels[carrierSense->Index];
+                return LORAMAC_STATUS_OK;
+            }
+            CarrierSenseNextChannel( carrierSense );
+        }
+        // Even if one or more channels are available according to the channel plan, no free channel
+        // was found during the LBT procedure.
+        return LORAMAC_STATUS_NO_FREE_CHANNEL_FOUND;
+    }
+
+    if( carrierSense->NbAttempts >= carrierSense->MaxNbAttempts )
+    {
+        return LORAMAC_STATUS_NO_FREE_CHANNEL_FOUND;
+    }
+
+    chan = &carrierSense->Channels[carrierSense->EnabledChannels[carrierSense->Index]];
+    if( carrierSense->Mode == RADIO_CARRIER_SENSE_CAD )
+    {
+        // CAD detects the modulation setup for the reception
+        Radio.SetRxConfig( MODEM_LORA, carrierSense->CadBandwidth, carrierSense->CadDatarate,
+                           1, 0, 8, 0, false, 0, false, 0, 0, false, false );
+    }
+    Radio.StartChannelFree( chan->Frequency, carrierSense->RxBandwidth, carrierSense->RssiFreeThreshold,
+                            carrierSense->CarrierSenseTime, carrierSense->Mode );
+    return LORAMAC_STATUS_CARRIER_SENSE_ONGOING;
+}
+
+LoRaMacStatus_t RegionCommonCarrierSenseDone( RegionCommonCarrierSense_t* carrierSense, bool channelIsFree, uint8_t* channel )
+{
+    if( ( carrierSense == NULL ) || ( channel == NULL ) || ( carrierSense->NbEnabledChannels == 0 ) )
+    {
+        return LORAMAC_STATUS_PARAMETER_INVALID;
+    }
+
+    if( channelIsFree == true )
+    {
+        // Free channel found
+        *channel = carrierSense->EnabledChannels[carrierSense->Index];
+        return LORAMAC_STATUS_OK;
+    }
+    CarrierSenseNextChannel( carrierSense );
+    return RegionCommonCarrierSenseStart( carrierSense, channel );
+}
+
+/*!
+ * \brief Gets the sub-band of a channel of the 64 + 8 channels plans.
+ *
+ * \param [IN] channel Channel index.
+ *
+ * \retval Sub-band index.
+ */
+static uint8_t JoinLearningGetSubBand( uint8_t channel )
+{
+    if( channel < ( REGION_COMMON_JOIN_NB_SUB_BANDS * 8 ) )
+    {
+        return channel / 8;
+    }
+    return ( channel - ( REGION_COMMON_JOIN_NB_SUB_BANDS * 8 ) ) % REGION_COMMON_JOIN_NB_SUB_BANDS;
+}
+
+/*!
+ * \brief Adds a score to a sub-band, saturated to REGION_COMMON_JOIN_MAX_SCORE.
+ *
+ * \param [IN] learning A pointer to the join channel learning context.
+ *
+ * \param [IN] subBand Sub-band index.
+ *
+ * \param [IN] score Score to be added.
+ */
+static void JoinLearningAddScore( RegionCommonJoinLearning_t* learning, uint8_t subBand, uint8_t score )
+{
+    learning->Scores[subBand] = MIN( learning->Scores[subBand] + score, REGION_COMMON_JOIN_MAX_SCORE );
+}
+
+void RegionCommonJoinLearningInit( RegionCommonJoinLearning_t* learning )
+{
+    memset1( learning->Scores, 0, REGION_COMMON_JOIN_NB_SUB_BANDS );
+    learning->LastAcceptedChannel = 0xFF;
+    learning->PendingChannel = 0xFF;
+    learning->NbTrials = 0;
+}
+
+bool RegionCommonJoinLearningIsLearned( RegionCommonJoinLearning_t* learning )
+{
+    if( learning->LastAcceptedChannel != 0xFF )
+    {
+        return true;
+    }
+    for( uint8_t i = 0; i < REGION_COMMON_JOIN_NB_SUB_BANDS; i++ )
+    {
+        if( learning->Scores[i] != 0 )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RegionCommonJoinLearningNextChannel( RegionCommonJoinLearning_t* learning, uint8_t* enabledChannels,
+                                          uint8_t nbEnabledChannels, uint8_t* channel )
+{
+    uint8_t order[REGION_COMMON_JOIN_NB_SUB_BANDS];
+    uint8_t distances[REGION_COMMON_JOIN_NB_SUB_BANDS];
+    // 8 channels of 125 kHz and one of 500 kHz per sub-band
+    uint8_t subBandChannels[8 + 1];
+    uint8_t nbSubBandChannels = 0;
+    uint8_t lastSubBand = 0;
+    uint8_t position = 0;
+    bool isFirstTrial = ( learning->NbTrials == 0 );
+
+    if( ( RegionCommonJoinLearningIsLearned( learning ) == false ) || ( nbEnabledChannels == 0 ) )
+    {
+        return false;
+    }
+
+    // Sorts the sub-bands by decreasing score, then increasing distance to the
+    // last accepted channel
+    if( learning->LastAcceptedChannel != 0xFF )
+    {
+        lastSubBand = JoinLearningGetSubBand( learning->LastAcceptedChannel );
+    }
+    for( uint8_t i = 0; i < REGION_COMMON_JOIN_NB_SUB_BANDS; i++ )
+    {
+        uint8_t j = i;
+
+        distances[i] = ( i > lastSubBand ) ? ( i - lastSubBand ) : ( lastSubBand - i );
+        while( ( j > 0 ) &&
+               ( ( learning->Scores[order[j - 1]] < learning->Scores[i] ) ||
+                 ( ( learning->Scores[order[j - 1]] == learning->Scores[i] ) && ( distances[order[j - 1]] > distances[i] ) ) ) )
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    // Every other join request probes the best sub-band
+    if( ( learning->NbTrials % 2 ) != 0 )
+    {
+        position = 1 + ( ( learning->NbTrials / 2 ) % ( REGION_COMMON_JOIN_NB_SUB_BANDS - 1 ) );
+    }
+    learning->NbTrials++;
+
+    // Falls back to the next sub-bands in order when no channel is available
+    for( uint8_t i = 0; ( i < REGION_COMMON_JOIN_NB_SUB_BANDS ) && ( nbSubBandChannels == 0 ); i++ )
+    {
+        uint8_t subBand = order[( position + i ) % REGION_COMMON_JOIN_NB_SUB_BANDS];
+
+        for( uint8_t j = 0; j < nbEnabledChannels; j++ )
+        {
+            if( JoinLearningGetSubBand( enabledChannels[j] ) == subBand )
+            {
+                if( ( isFirstTrial == true ) && ( enabledChannels[j] == learning->LastAcceptedChannel ) )
+                {
+                    *channel = enabledChannels[j];
+                    return true;
+                }
+                subBandChannels[nbSubBandChannels++] = enabledChannels[j];
+            }
+        }
+    }
+    *channel = subBandChannels[randr( 0, nbSubBandChannels - 1 )];
+    return true;
+}
+
+void RegionCommonJoinLearningJoinRequest( RegionCommonJoinLearning_t* learning, uint8_t channel )
+{
+    if( learning->PendingChannel != 0xFF )
+    {
+        uint8_t subBand = JoinLearningGetSubBand( learning->PendingChannel );
+
+        // Unanswered join request, the score decays
+        if( learning->Scores[subBand] > 0 )
+        {
+            learning->Scores[subBand] -= ( learning->Scores[subBand] >> 2 ) + 1;
+        }
+    }
+    learning->PendingChannel = channel;
+}
+
+void RegionCommonJoinLearningJoinAccept( RegionCommonJoinLearning_t* learning, uint8_t channel )
+{
+    uint8_t subBand = JoinLearningGetSubBand( channel );
+
+    JoinLearningAddScore( learning, subBand, REGION_COMMON_JOIN_ACCEPT_SCORE );
+    if( subBand > 0 )
+    {
+        JoinLearningAddScore( learning, subBand - 1, REGION_COMMON_JOIN_NEIGHBOUR_SCORE );
+    }
+    if( subBand < ( REGION_COMMON_JOIN_NB_SUB_BANDS - 1 ) )
     {
-        return LORAMAC_STATUS_NO_CHANNEL_FOUND;
+        JoinLearningAddScore( learning, subBand + 1, REGION_COMMON_JOIN_NEIGHBOUR_SCORE );
     }
+    learning->LastAcceptedChannel = channel;
+    learning->PendingChannel = 0xFF;
+    learning->NbTrials = 0;
 }
@@ -54,6 +54,32 @@ extern "C"
  */
 #define REGION_COMMON_DEFAULT_PING_SLOT_PERIODICITY     7
 
+/*!
+ * Maximum number of channels a listen before talk procedure iterates on
+ */
+#define REGION_COMMON_LBT_MAX_NB_CHANNELS               16
+
+/*!
+ * Number of 8 channel sub-bands of the 64 + 8 channels plans. 125 kHz channel
+ * n belongs to sub-band n / 8, 500 kHz channel 64 + n to sub-band n.
+ */
+#define REGION_COMMON_JOIN_NB_SUB_BANDS                 8
+
+/*!
+ * Score added to a sub-band when one of its channels gets a join accept
+ */
+#define REGION_COMMON_JOIN_ACCEPT_SCORE                 16
+
+/*!
+ * Score added to the neighbours of a sub-band which got a join accept
+ */
+#define REGION_COMMON_JOIN_NEIGHBOUR_SCORE              4
+
+/*!
+ * Maximum score of a sub-band
+ */
+#define REGION_COMMON_JOIN_MAX_SCORE                    64
+
 typedef struct sRegionCommonLinkAdrParams
 {
     /*!
@@ -78,6 +104,50 @@ typedef struct sRegionCommonLinkAdrParams
     uint16_t ChMask;
 }RegionCommonLinkAdrParams_t;
 
+/*!
+ * Range of channels whose parameters are computed from the channel index
+ */
+typedef struct sRegionCommonChannelRange
+{
+    /*!
+     * Frequency of the first channel of the range in Hz.
+     */
+    uint32_t Frequency;
+    /*!
+     * Frequency spacing between two channels of the range in Hz.
+     */
+    uint32_t Spacing;
+    /*!
+     * Number of channels of the range.
+     */
+    uint8_t NbChannels;
+    /*!
+     * Data rate range of the channels.
+     */
+    DrRange_t DrRange;
+    /*!
+     * Band index of the channels.
+     */
+    uint8_t Band;
+}RegionCommonChannelRange_t;
+
+/*!
+ * Channel plan made of consecutive channel ranges, replacing the
+ * ChannelParams_t array of the regions whose channels are all fixed.
+ */
+typedef struct sRegionCommonChannelPlan
+{
+    /*!
+     * Pointer to the channel ranges, channel 0 is the first channel of the
+     * first range.
+     */
+    const RegionCommonChannelRange_t* Ranges;
+    /*!
+     * Number of channel ranges.
+     */
+    uint8_t NbRanges;
+}RegionCommonChannelPlan_t;
+
 typedef struct sRegionCommonLinkAdrReqVerifyParams
 {
     /*!
@@ -136,6 +206,10 @@ typedef struct sRegionCommonLinkAdrReqVerifyParams
      * Pointer to the channels.
      */
     ChannelParams_t* Channels;
+    /*!
+     * Pointer to the channel plan, used when Channels is NULL.
+     */
+    const RegionCommonChannelPlan_t* ChannelPlan;
     /*!
      * The minimum possible TX power.
      */
@@ -196,6 +270,10 @@ typedef struct sRegionCommonCountNbOfEnabledChannelsParams
      * A pointer to the channels.
      */
     ChannelParams_t* Channels;
+    /*!
+     * A pointer to the channel plan, used when Channels is NULL.
+     */
+    const RegionCommonChannelPlan_t* ChannelPlan;
     /*!
      * A pointer to the bands.
      */
@@ -246,6 +324,79 @@ typedef struct sRegionCommonIdentifyChannelsParam
     RegionCommonCountNbOfEnabledChannelsParams_t* CountNbOfEnabledChannelsParam;
 }RegionCommonIdentifyChannelsParam_t;
 
+typedef struct sRegionCommonCarrierSense
+{
+    /*!
+     * A pointer to the channels.
+     */
+    ChannelParams_t* Channels;
+    /*!
+     * Channels which are available according to the channel plan.
+     */
+    uint8_t EnabledChannels[REGION_COMMON_LBT_MAX_NB_CHANNELS];
+    /*!
+     * Number of entries in EnabledChannels.
+     */
+    uint8_t NbEnabledChannels;
+    /*!
+     * Index into EnabledChannels of the channel currently sensed.
+     */
+    uint8_t Index;
+    /*!
+     * Number of carrier sense attempts already performed.
+     */
+    uint8_t NbAttempts;
+    /*!
+     * Maximum number of carrier sense attempts.
+     */
+    uint8_t MaxNbAttempts;
+    /*!
+     * Rx bandwidth used during carrier sense [Hz].
+     */
+    uint32_t RxBandwidth;
+    /*!
+     * RSSI threshold below which the channel is considered free [dBm].
+     */
+    int16_t RssiFreeThreshold;
+    /*!
+     * Carrier sense time for one channel [ms].
+     */
+    uint32_t CarrierSenseTime;
+    /*!
+     * Carrier sense mode used by the non-blocking procedure.
+     */
+    RadioCarrierSenseModes_t Mode;
+    /*!
+     * LoRa spreading factor sensed by RADIO_CARRIER_SENSE_CAD.
+     */
+    int8_t CadDatarate;
+    /*!
+     * LoRa bandwidth sensed by RADIO_CARRIER_SENSE_CAD [0: 125 kHz, 1: 250 kHz, 2: 500 kHz].
+     */
+    uint32_t CadBandwidth;
+}RegionCommonCarrierSense_t;
+
+typedef struct sRegionCommonJoinLearning
+{
+    /*!
+     * Score of each sub-band. Raised by the join accepts received on the
+     * sub-band and its neighbours, lowered by the unanswered join requests.
+     */
+    uint8_t Scores[REGION_COMMON_JOIN_NB_SUB_BANDS];
+    /*!
+     * Channel of the last accepted join request, 0xFF when none.
+     */
+    uint8_t LastAcceptedChannel;
+    /*!
+     * Channel of the last join request, 0xFF when it got a join accept.
+     */
+    uint8_t PendingChannel;
+    /*!
+     * Number of join requests sent in the learned probing order.
+     */
+    uint8_t NbTrials;
+}RegionCommonJoinLearning_t;
+
 typedef struct sRegionCommonSetDutyCycleParams
 {
     /*!
@@ -307,6 +458,18 @@ uint8_t RegionCommonValueInRange( int8_t value, int8_t min, int8_t max );
 bool RegionCommonChanVerifyDr( uint8_t nbChannels, uint16_t* channelsMask, int8_t dr,
                             int8_t minDr, int8_t maxDr, ChannelParams_t* channels );
 
+/*!
+ * \brief Gets the parameters of a channel of a channel plan.
+ *
+ * \param [IN] channelPlan The channel plan of the region.
+ *
+ * \param [IN] id Channel index.
+ *
+ * \param [OUT] channel Channel parameters. The frequency is 0 when the channel
+ *                      index is out of the channel plan.
+ */
+void RegionCommonChannelPlanGetChannel( const RegionCommonChannelPlan_t* channelPlan, uint8_t id, ChannelParams_t* channel );
+
 /*!
  * \brief Disables a channel in a given channels mask.
  *        This is a generic function and valid for all regions.
@@ -452,7 +615,7 @@ double RegionCommonComputeSymbolTimeFsk( uint8_t phyDr );
  *
  * \param [OUT] windowTimeout RX window timeout.
  *
- * \param [OUT] windowOffset RX window time offset to be applied to the RX delay.
+ * \param [OUT] windowOffset RX window time offset to be applied to the RX delay [us].
  */
 void RegionCommonComputeRxWindowParameters( double tSymbol, uint8_t minRxSymbols, uint32_t rxError, uint32_t wakeUpTime, uint32_t* windowTimeout, int32_t* windowOffset );
 
@@ -522,6 +685,98 @@ LoRaMacStatus_t RegionCommonIdentifyChannels( RegionCommonIdentifyChannelsParam_
                                               uint8_t* nbEnabledChannels, uint8_t* nbRestrictedChannels,
                                               TimerTime_t* nextTxDelay );
 
+/*!
+ * \brief Starts the listen before talk procedure on the channels stored in
+ *        carrierSense, beginning with carrierSense->EnabledChannels[carrierSense->Index].
+ *
+ * \remark When the radio driver does not provide Radio.StartChannelFree the
+ *         procedure runs to completion using the blocking Radio.IsChannelFree.
+ *
+ * \param [IN] carrierSense A pointer to the carrier sense context. Must remain
+ *                          valid until the procedure has completed.
+ *
+ * \param [OUT] channel The free channel, valid on LORAMAC_STATUS_OK.
+ *
+ * \retval Status of the operation. LORAMAC_STATUS_CARRIER_SENSE_ONGOING when
+ *         the result will be signaled through RadioEvents_t.ChannelFreeDone.
+ */
+LoRaMacStatus_t RegionCommonCarrierSenseStart( RegionCommonCarrierSense_t* carrierSense, uint8_t* channel );
+
+/*!
+ * \brief Continues the listen before talk procedure once the radio signaled
+ *        the result of the ongoing carrier sense.
+ *
+ * \param [IN] carrierSense A pointer to the carrier sense context.
+ *
+ * \param [IN] channelIsFree Result reported by RadioEvents_t.ChannelFreeDone.
+ *
+ * \param [OUT] channel The free channel, valid on LORAMAC_STATUS_OK.
+ *
+ * \retval Status of the operation. LORAMAC_STATUS_CARRIER_SENSE_ONGOING when
+ *         the next channel is being sensed.
+ */
+LoRaMacStatus_t RegionCommonCarrierSenseDone( RegionCommonCarrierSense_t* carrierSense, bool channelIsFree, uint8_t* channel );
+
+/*!
+ * \brief Resets the join channel learning of the 64 + 8 channels plans.
+ *
+ * \param [IN] learning A pointer to the join channel learning context.
+ */
+void RegionCommonJoinLearningInit( RegionCommonJoinLearning_t* learning );
+
+/*!
+ * \brief Checks if a join accept got recorded since the last reset.
+ *
+ * \param [IN] learning A pointer to the join channel learning context.
+ *
+ * \retval Returns true when the join requests follow the learned probing
+ *         order.
+ */
+bool RegionCommonJoinLearningIsLearned( RegionCommonJoinLearning_t* learning );
+
+/*!
+ * \brief Selects the channel of the next join request in the learned
+ *        probing order.
+ *
+ * \remark Join requests alternate between the best scored sub-band and the
+ *         other ones, from the best scored to the worst scored. Sub-bands
+ *         with equal scores are probed from the nearest to the farthest from
+ *         the last accepted channel. The first join request uses the last
+ *         accepted channel when available.
+ *
+ * \param [IN] learning A pointer to the join channel learning context.
+ *
+ * \param [IN] enabledChannels Channels available for the join request.
+ *
+ * \param [IN] nbEnabledChannels Number of entries in enabledChannels.
+ *
+ * \param [OUT] channel Selected channel.
+ *
+ * \retval Returns true when a channel got selected, false when nothing got
+ *         learned yet.
+ */
+bool RegionCommonJoinLearningNextChannel( RegionCommonJoinLearning_t* learning, uint8_t* enabledChannels,
+                                          uint8_t nbEnabledChannels, uint8_t* channel );
+
+/*!
+ * \brief Records a join request. The previous one, if still pending, gets
+ *        accounted as unanswered.
+ *
+ * \param [IN] learning A pointer to the join channel learning context.
+ *
+ * \param [IN] channel Channel of the join request.
+ */
+void RegionCommonJoinLearningJoinRequest( RegionCommonJoinLearning_t* learning, uint8_t channel );
+
+/*!
+ * \brief Records a join accept.
+ *
+ * \param [IN] learning A pointer to the join channel learning context.
+ *
+ * \param [IN] channel Channel of the accepted join request.
+ */
+void RegionCommonJoinLearningJoinAccept( RegionCommonJoinLearning_t* learning, uint8_t channel );
+
 /*! \} defgroup REGIONCOMMON */
 
 #ifdef __cplusplus
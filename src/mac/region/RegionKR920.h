@@ -469,6 +469,17 @@ int8_t RegionKR920AlternateDr( int8_t currentDr, AlternateDrType_t type );
  */
 LoRaMacStatus_t RegionKR920NextChannel( NextChanParams_t* nextChanParams, uint8_t* channel, TimerTime_t* time, TimerTime_t* aggregatedTimeOff );
 
+/*!
+ * \brief Continues the listen before talk procedure started by RegionKR920NextChannel.
+ *
+ * \param [IN] channelIsFree Result of the carrier sense signaled by the radio.
+ *
+ * \param [OUT] channel Next channel to use for TX.
+ *
+ * \retval Status of the operation.
+ */
+LoRaMacStatus_t RegionKR920CarrierSenseDone( bool channelIsFree, uint8_t* channel );
+
 /*!
  * \brief Adds a channel.
  *
@@ -44,10 +44,6 @@
  */
 typedef struct sRegionUS915NvmCtx
 {
-    /*!
-     * LoRaMAC channels
-     */
-    ChannelParams_t Channels[ US915_MAX_NB_CHANNELS ];
     /*!
      * LoRaMac bands
      */
@@ -72,12 +68,39 @@ typedef struct sRegionUS915NvmCtx
      * Counter of join trials needed to alternate between DR0 and DR4, see \ref RegionUS915AlternateDr
      */
     uint8_t JoinTrialsCounter;
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    /*!
+     * Sub-bands and channel which got the join accepts
+     */
+    RegionCommonJoinLearning_t JoinLearning;
+#endif
 }RegionUS915NvmCtx_t;
 
 /*
  * Non-volatile module context.
  */
-static RegionUS915NvmCtx_t NvmCtx;
+static RegionUS915NvmCtx_t DefaultNvmCtx;
+
+/*
+ * Non-volatile module context in use. Bound to the context of the selected
+ * LoRaMac instance by INIT_TYPE_BIND_CTX.
+ */
+static RegionUS915NvmCtx_t* NvmCtx = &DefaultNvmCtx;
+
+/*!
+ * Channel plan: 64 channels of 125 kHz followed by 8 channels of 500 kHz
+ */
+static const RegionCommonChannelRange_t ChannelRanges[] =
+{
+    { 902300000,  200000, US915_MAX_NB_CHANNELS - 8, { .Value = ( DR_3 << 4 ) | DR_0 }, 0 },
+    { 903000000, 1600000, 8,                         { .Value = ( DR_4 << 4 ) | DR_4 }, 0 },
+};
+
+static const RegionCommonChannelPlan_t ChannelPlan =
+{
+    .Ranges = ChannelRanges,
+    .NbRanges = 2,
+};
 
 // Static functions
 static int8_t GetNextLowerTxDr( int8_t dr, int8_t minDr )
@@ -144,7 +167,7 @@ static LoRaMacStatus_t ComputeNext125kHzJoinChannel( uint8_t* newChannelIndex )
     uint16_t channelMaskRemaining;
     uint8_t findAvailableChannelsIndex[8] = { 0 };
     uint8_t availableChannels = 0;
-    uint8_t startIndex = NvmCtx.JoinChannelGroupsCurrentIndex;
+    uint8_t startIndex = NvmCtx->JoinChannelGroupsCurrentIndex;
 
     // Null pointer check
     if( newChannelIndex == NULL )
@@ -159,11 +182,11 @@ static LoRaMacStatus_t ComputeNext125kHzJoinChannel( uint8_t* newChannelIndex )
         // For even numbers we need the 8 LSBs and for uneven the 8 MSBs
         if( ( startIndex % 2 ) == 0 )
         {
-            channelMaskRemaining = ( NvmCtx.ChannelsMaskRemaining[currentChannelsMaskRemainingIndex] & 0x00FF );
+            channelMaskRemaining = ( NvmCtx->ChannelsMaskRemaining[currentChannelsMaskRemainingIndex] & 0x00FF );
         }
         else
         {
-            channelMaskRemaining = ( ( NvmCtx.ChannelsMaskRemaining[currentChannelsMaskRemainingIndex] >> 8 ) & 0x00FF );
+            channelMaskRemaining = ( ( NvmCtx->ChannelsMaskRemaining[currentChannelsMaskRemainingIndex] >> 8 ) & 0x00FF );
         }
 
 
@@ -184,11 +207,11 @@ static LoRaMacStatus_t ComputeNext125kHzJoinChannel( uint8_t* newChannelIndex )
         {
             startIndex = 0;
         }
-    } while( ( availableChannels == 0 ) && ( startIndex != NvmCtx.JoinChannelGroupsCurrentIndex ) );
+    } while( ( availableChannels == 0 ) && ( startIndex != NvmCtx->JoinChannelGroupsCurrentIndex ) );
 
     if ( availableChannels > 0 )
     {
-        NvmCtx.JoinChannelGroupsCurrentIndex = startIndex;
+        NvmCtx->JoinChannelGroupsCurrentIndex = startIndex;
         return LORAMAC_STATUS_OK;
     }
 
@@ -370,12 +393,12 @@ PhyParam_t RegionUS915GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsMask;
             break;
         }
         case PHY_CHANNELS_DEFAULT_MASK:
         {
-            phyParam.ChannelsMask = NvmCtx.ChannelsDefaultMask;
+            phyParam.ChannelsMask = NvmCtx->ChannelsDefaultMask;
             break;
         }
         case PHY_MAX_NB_CHANNELS:
@@ -385,7 +408,13 @@ PhyParam_t RegionUS915GetPhyParam( GetPhyParams_t* getPhy )
         }
         case PHY_CHANNELS:
         {
-            phyParam.Channels = NvmCtx.Channels;
+            // The channels are computed from the channel plan
+            phyParam.Channels = NULL;
+            break;
+        }
+        case PHY_CHANNEL:
+        {
+            RegionCommonChannelPlanGetChannel( &ChannelPlan, getPhy->Channel, &phyParam.Channel );
             break;
         }
         case PHY_DEF_UPLINK_DWELL_TIME:
@@ -462,7 +491,10 @@ PhyParam_t RegionUS915GetPhyParam( GetPhyParams_t* getPhy )
 
 void RegionUS915SetBandTxDone( SetBandTxDoneParams_t* txDone )
 {
-    RegionCommonSetBandTxDone( &NvmCtx.Bands[NvmCtx.Channels[txDone->Channel].Band],
+    ChannelParams_t channel;
+
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, txDone->Channel, &channel );
+    RegionCommonSetBandTxDone( &NvmCtx->Bands[channel.Band],
                                txDone->LastTxAirTime, txDone->Joined, txDone->ElapsedTimeSinceStartUp );
 }
 
@@ -478,43 +510,31 @@ void RegionUS915InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_DEFAULTS:
         {
             // Initialize 8 bit channel groups index
-            NvmCtx.JoinChannelGroupsCurrentIndex = 0;
+            NvmCtx->JoinChannelGroupsCurrentIndex = 0;
 
             // Initialize the join trials counter
-            NvmCtx.JoinTrialsCounter = 0;
+            NvmCtx->JoinTrialsCounter = 0;
 
             // Default bands
-            memcpy1( ( uint8_t* )NvmCtx.Bands, ( uint8_t* )bands, sizeof( Band_t ) * US915_MAX_NB_BANDS );
-
-            // Default channels
-            for( uint8_t i = 0; i < US915_MAX_NB_CHANNELS - 8; i++ )
-            {
-                // 125 kHz channels
-                NvmCtx.Channels[i].Frequency = 902300000 + i * 200000;
-                NvmCtx.Channels[i].DrRange.Value = ( DR_3 << 4 ) | DR_0;
-                NvmCtx.Channels[i].Band = 0;
-            }
-            for( uint8_t i = US915_MAX_NB_CHANNELS - 8; i < US915_MAX_NB_CHANNELS; i++ )
-            {
-                // 500 kHz channels
-                NvmCtx.Channels[i].Frequency = 903000000 + ( i - ( US915_MAX_NB_CHANNELS - 8 ) ) * 1600000;
-                NvmCtx.Channels[i].DrRange.Value = ( DR_4 << 4 ) | DR_4;
-                NvmCtx.Channels[i].Band = 0;
-            }
+            memcpy1( ( uint8_t* )NvmCtx->Bands, ( uint8_t* )bands, sizeof( Band_t ) * US915_MAX_NB_BANDS );
 
             // Default ChannelsMask
-            NvmCtx.ChannelsDefaultMask[0] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[1] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[2] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[3] = 0xFFFF;
-            NvmCtx.ChannelsDefaultMask[4] = 0x00FF;
-            NvmCtx.ChannelsDefaultMask[5] = 0x0000;
+            NvmCtx->ChannelsDefaultMask[0] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[1] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[2] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[3] = 0xFFFF;
+            NvmCtx->ChannelsDefaultMask[4] = 0x00FF;
+            NvmCtx->ChannelsDefaultMask[5] = 0x0000;
 
             // Copy channels default mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, 6 );
 
             // Copy into channels mask remaining
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMaskRemaining, NvmCtx.ChannelsMask, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMaskRemaining, NvmCtx->ChannelsMask, 6 );
+
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+            RegionCommonJoinLearningInit( &NvmCtx->JoinLearning );
+#endif
             break;
         }
         case INIT_TYPE_RESET_TO_DEFAULT_CHANNELS:
@@ -524,11 +544,11 @@ void RegionUS915InitDefaults( InitDefaultsParams_t* params )
         case INIT_TYPE_ACTIVATE_DEFAULT_CHANNELS:
         {
             // Copy channels default mask
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, NvmCtx.ChannelsDefaultMask, 6 );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, NvmCtx->ChannelsDefaultMask, 6 );
 
             for( uint8_t i = 0; i < 6; i++ )
             { // Copy-And the channels mask
-                NvmCtx.ChannelsMaskRemaining[i] &= NvmCtx.ChannelsMask[i];
+                NvmCtx->ChannelsMaskRemaining[i] &= NvmCtx->ChannelsMask[i];
             }
             break;
         }
@@ -536,7 +556,19 @@ void RegionUS915InitDefaults( InitDefaultsParams_t* params )
         {
             if( params->NvmCtx != 0 )
             {
-                memcpy1( (uint8_t*) &NvmCtx, (uint8_t*) params->NvmCtx, sizeof( NvmCtx ) );
+                memcpy1( (uint8_t*) NvmCtx, (uint8_t*) params->NvmCtx, sizeof( RegionUS915NvmCtx_t ) );
+            }
+            break;
+        }
+        case INIT_TYPE_BIND_CTX:
+        {
+            if( params->NvmCtx != 0 )
+            {
+                NvmCtx = ( RegionUS915NvmCtx_t* )params->NvmCtx;
+            }
+            else
+            {
+                NvmCtx = &DefaultNvmCtx;
             }
             break;
         }
@@ -550,7 +582,7 @@ void RegionUS915InitDefaults( InitDefaultsParams_t* params )
 void* RegionUS915GetNvmCtx( GetNvmCtxParams_t* params )
 {
     params->nvmCtxSize = sizeof( RegionUS915NvmCtx_t );
-    return &NvmCtx;
+    return NvmCtx;
 }
 
 bool RegionUS915Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
@@ -590,6 +622,11 @@ bool RegionUS915Verify( VerifyParams_t* verify, PhyAttribute_t phyAttribute )
 
 void RegionUS915ApplyCFList( ApplyCFListParams_t* applyCFList )
 {
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    // Only called on join accept
+    RegionCommonJoinLearningJoinAccept( &NvmCtx->JoinLearning, applyCFList->JoinChannel );
+#endif
+
     // Size of the optional CF list must be 16 byte
     if( applyCFList->Size != 16 )
     {
@@ -605,14 +642,14 @@ void RegionUS915ApplyCFList( ApplyCFListParams_t* applyCFList )
     // ChMask0 - ChMask4 must be set (every ChMask has 16 bit)
     for( uint8_t chMaskItr = 0, cntPayload = 0; chMaskItr <= 4; chMaskItr++, cntPayload+=2 )
     {
-        NvmCtx.ChannelsMask[chMaskItr] = (uint16_t) (0x00FF & applyCFList->Payload[cntPayload]);
-        NvmCtx.ChannelsMask[chMaskItr] |= (uint16_t) (applyCFList->Payload[cntPayload+1] << 8);
+        NvmCtx->ChannelsMask[chMaskItr] = (uint16_t) (0x00FF & applyCFList->Payload[cntPayload]);
+        NvmCtx->ChannelsMask[chMaskItr] |= (uint16_t) (applyCFList->Payload[cntPayload+1] << 8);
         if( chMaskItr == 4 )
         {
-            NvmCtx.ChannelsMask[chMaskItr] = NvmCtx.ChannelsMask[chMaskItr] & CHANNELS_MASK_500KHZ_MASK;
+            NvmCtx->ChannelsMask[chMaskItr] = NvmCtx->ChannelsMask[chMaskItr] & CHANNELS_MASK_500KHZ_MASK;
         }
         // Set the channel mask to the remaining
-        NvmCtx.ChannelsMaskRemaining[chMaskItr] &= NvmCtx.ChannelsMask[chMaskItr];
+        NvmCtx->ChannelsMaskRemaining[chMaskItr] &= NvmCtx->ChannelsMask[chMaskItr];
     }
 }
 
@@ -631,20 +668,20 @@ bool RegionUS915ChanMaskSet( ChanMaskSetParams_t* chanMaskSet )
     {
         case CHANNELS_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, chanMaskSet->ChannelsMaskIn, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, chanMaskSet->ChannelsMaskIn, CHANNELS_MASK_SIZE );
 
-            NvmCtx.ChannelsDefaultMask[4] = NvmCtx.ChannelsDefaultMask[4] & CHANNELS_MASK_500KHZ_MASK;
-            NvmCtx.ChannelsDefaultMask[5] = 0x0000;
+            NvmCtx->ChannelsDefaultMask[4] = NvmCtx->ChannelsDefaultMask[4] & CHANNELS_MASK_500KHZ_MASK;
+            NvmCtx->ChannelsDefaultMask[5] = 0x0000;
 
             for( uint8_t i = 0; i < CHANNELS_MASK_SIZE; i++ )
             { // Copy-And the channels mask
-                NvmCtx.ChannelsMaskRemaining[i] &= NvmCtx.ChannelsMask[i];
+                NvmCtx->ChannelsMaskRemaining[i] &= NvmCtx->ChannelsMask[i];
             }
             break;
         }
         case CHANNELS_DEFAULT_MASK:
         {
-            RegionCommonChanMaskCopy( NvmCtx.ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, CHANNELS_MASK_SIZE );
+            RegionCommonChanMaskCopy( NvmCtx->ChannelsDefaultMask, chanMaskSet->ChannelsMaskIn, CHANNELS_MASK_SIZE );
             break;
         }
         default:
@@ -664,6 +701,7 @@ void RegionUS915ComputeRxWindowParameters( int8_t datarate, uint8_t minRxSymbols
     tSymbol = RegionCommonComputeSymbolTimeLoRa( DataratesUS915[rxConfigParams->Datarate], BandwidthsUS915[rxConfigParams->Datarate] );
 
     RegionCommonComputeRxWindowParameters( tSymbol, minRxSymbols, rxError, Radio.GetWakeupTime( ), &rxConfigParams->WindowTimeout, &rxConfigParams->WindowOffset );
+    rxConfigParams->SymbolTime = ( uint32_t )( tSymbol * 1000 );
 }
 
 bool RegionUS915RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
@@ -699,16 +737,20 @@ bool RegionUS915RxConfig( RxConfigParams_t* rxConfig, int8_t* datarate )
 
 bool RegionUS915TxConfig( TxConfigParams_t* txConfig, int8_t* txPower, TimerTime_t* txTimeOnAir )
 {
+    ChannelParams_t channel;
     int8_t phyDr = DataratesUS915[txConfig->Datarate];
-    int8_t txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx.Bands[NvmCtx.Channels[txConfig->Channel].Band].TxMaxPower, txConfig->Datarate, NvmCtx.ChannelsMask );
+    int8_t txPowerLimited = 0;
     uint32_t bandwidth = GetBandwidth( txConfig->Datarate );
     int8_t phyTxPower = 0;
 
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, txConfig->Channel, &channel );
+    txPowerLimited = LimitTxPower( txConfig->TxPower, NvmCtx->Bands[channel.Band].TxMaxPower, txConfig->Datarate, NvmCtx->ChannelsMask );
+
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, US915_DEFAULT_MAX_ERP, 0 );
 
     // Setup the radio frequency
-    Radio.SetChannel( NvmCtx.Channels[txConfig->Channel].Frequency );
+    Radio.SetChannel( channel.Frequency );
 
     Radio.SetTxConfig( MODEM_LORA, phyTxPower, 0, bandwidth, phyDr, 1, 8, false, true, 0, 0, false, 4000 );
 
@@ -734,7 +776,7 @@ uint8_t RegionUS915LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     RegionCommonLinkAdrReqVerifyParams_t linkAdrVerifyParams;
 
     // Initialize local copy of channels mask
-    RegionCommonChanMaskCopy( channelsMask, NvmCtx.ChannelsMask, 6 );
+    RegionCommonChanMaskCopy( channelsMask, NvmCtx->ChannelsMask, 6 );
 
     while( bytesProcessed < linkAdrReq->PayloadSize )
     {
@@ -852,7 +894,8 @@ uint8_t RegionUS915LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     linkAdrVerifyParams.ChannelsMask = channelsMask;
     linkAdrVerifyParams.MinDatarate = ( int8_t )phyParam.Value;
     linkAdrVerifyParams.MaxDatarate = US915_TX_MAX_DATARATE;
-    linkAdrVerifyParams.Channels = NvmCtx.Channels;
+    linkAdrVerifyParams.Channels = NULL;
+    linkAdrVerifyParams.ChannelPlan = &ChannelPlan;
     linkAdrVerifyParams.MinTxPower = US915_MIN_TX_POWER;
     linkAdrVerifyParams.MaxTxPower = US915_MAX_TX_POWER;
     linkAdrVerifyParams.Version = linkAdrReq->Version;
@@ -864,14 +907,14 @@ uint8_t RegionUS915LinkAdrReq( LinkAdrReqParams_t* linkAdrReq, int8_t* drOut, in
     if( status == 0x07 )
     {
         // Copy Mask
-        RegionCommonChanMaskCopy( NvmCtx.ChannelsMask, channelsMask, 6 );
-
-        NvmCtx.ChannelsMaskRemaining[0] &= NvmCtx.ChannelsMask[0];
-        NvmCtx.ChannelsMaskRemaining[1] &= NvmCtx.ChannelsMask[1];
-        NvmCtx.ChannelsMaskRemaining[2] &= NvmCtx.ChannelsMask[2];
-        NvmCtx.ChannelsMaskRemaining[3] &= NvmCtx.ChannelsMask[3];
-        NvmCtx.ChannelsMaskRemaining[4] = NvmCtx.ChannelsMask[4];
-        NvmCtx.ChannelsMaskRemaining[5] = NvmCtx.ChannelsMask[5];
+        RegionCommonChanMaskCopy( NvmCtx->ChannelsMask, channelsMask, 6 );
+
+        NvmCtx->ChannelsMaskRemaining[0] &= NvmCtx->ChannelsMask[0];
+        NvmCtx->ChannelsMaskRemaining[1] &= NvmCtx->ChannelsMask[1];
+        NvmCtx->ChannelsMaskRemaining[2] &= NvmCtx->ChannelsMask[2];
+        NvmCtx->ChannelsMaskRemaining[3] &= NvmCtx->ChannelsMask[3];
+        NvmCtx->ChannelsMaskRemaining[4] = NvmCtx->ChannelsMask[4];
+        NvmCtx->ChannelsMaskRemaining[5] = NvmCtx->ChannelsMask[5];
     }
 
     // Update status variables
@@ -935,14 +978,14 @@ int8_t RegionUS915AlternateDr( int8_t currentDr, AlternateDrType_t type )
     // Eight times a 125kHz DR_0 and then one 500kHz DR_4 channel
     if( type == ALTERNATE_DR )
     {
-        NvmCtx.JoinTrialsCounter++;
+        NvmCtx->JoinTrialsCounter++;
     }
     else
     {
-        NvmCtx.JoinTrialsCounter--;
+        NvmCtx->JoinTrialsCounter--;
     }
 
-    if( NvmCtx.JoinTrialsCounter % 9 == 0 )
+    if( NvmCtx->JoinTrialsCounter % 9 == 0 )
     {
         // Use DR_4 every 9th times.
         currentDr = DR_4;
@@ -965,27 +1008,35 @@ LoRaMacStatus_t RegionUS915NextChannel( NextChanParams_t* nextChanParams, uint8_
     LoRaMacStatus_t status = LORAMAC_STATUS_NO_CHANNEL_FOUND;
 
     // Count 125kHz channels
-    if( RegionCommonCountChannels( NvmCtx.ChannelsMaskRemaining, 0, 4 ) == 0 )
+    if( RegionCommonCountChannels( NvmCtx->ChannelsMaskRemaining, 0, 4 ) == 0 )
     { // Reactivate default channels
-        RegionCommonChanMaskCopy( NvmCtx.ChannelsMaskRemaining, NvmCtx.ChannelsMask, 4  );
+        RegionCommonChanMaskCopy( NvmCtx->ChannelsMaskRemaining, NvmCtx->ChannelsMask, 4  );
 
-        NvmCtx.JoinChannelGroupsCurrentIndex = 0;
+        NvmCtx->JoinChannelGroupsCurrentIndex = 0;
     }
     // Check other channels
     if( nextChanParams->Datarate >= DR_4 )
     {
-        if( ( NvmCtx.ChannelsMaskRemaining[4] & CHANNELS_MASK_500KHZ_MASK ) == 0 )
+        if( ( NvmCtx->ChannelsMaskRemaining[4] & CHANNELS_MASK_500KHZ_MASK ) == 0 )
         {
-            NvmCtx.ChannelsMaskRemaining[4] = NvmCtx.ChannelsMask[4];
+            NvmCtx->ChannelsMaskRemaining[4] = NvmCtx->ChannelsMask[4];
         }
     }
 
     // Search how many channels are enabled
     countChannelsParams.Joined = nextChanParams->Joined;
     countChannelsParams.Datarate = nextChanParams->Datarate;
-    countChannelsParams.ChannelsMask = NvmCtx.ChannelsMaskRemaining;
-    countChannelsParams.Channels = NvmCtx.Channels;
-    countChannelsParams.Bands = NvmCtx.Bands;
+    countChannelsParams.ChannelsMask = NvmCtx->ChannelsMaskRemaining;
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    if( ( nextChanParams->Joined == false ) && ( RegionCommonJoinLearningIsLearned( &NvmCtx->JoinLearning ) == true ) )
+    {
+        // The learned sub-bands are probed again before all the channels got used
+        countChannelsParams.ChannelsMask = NvmCtx->ChannelsMask;
+    }
+#endif
+    countChannelsParams.Channels = NULL;
+    countChannelsParams.ChannelPlan = &ChannelPlan;
+    countChannelsParams.Bands = NvmCtx->Bands;
     countChannelsParams.MaxNbChannels = US915_MAX_NB_CHANNELS;
     countChannelsParams.JoinChannels = 0;
 
@@ -1017,30 +1068,39 @@ LoRaMacStatus_t RegionUS915NextChannel( NextChanParams_t* nextChanParams, uint8_
             // group of eight 125 kHz channels followed by probing one 500 kHz channel each pass.
             // Each time a 125 kHz channel will be selected from another group.
 
-            // 125kHz Channels (0 - 63) DR0
-            if( nextChanParams->Datarate == DR_0 )
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+            // Once learned, the sub-bands which got the join accepts are probed first
+            if( RegionCommonJoinLearningNextChannel( &NvmCtx->JoinLearning, enabledChannels, nbEnabledChannels, channel ) == false )
+#endif
             {
-                if( ComputeNext125kHzJoinChannel( &newChannelIndex ) == LORAMAC_STATUS_PARAMETER_INVALID )
+                // 125kHz Channels (0 - 63) DR0
+                if( nextChanParams->Datarate == DR_0 )
                 {
-                    return LORAMAC_STATUS_PARAMETER_INVALID;
+                    if( ComputeNext125kHzJoinChannel( &newChannelIndex ) == LORAMAC_STATUS_PARAMETER_INVALID )
+                    {
+                        return LORAMAC_STATUS_PARAMETER_INVALID;
+                    }
+                    *channel = newChannelIndex;
                 }
-                *channel = newChannelIndex;
-            }
-            // 500kHz Channels (64 - 71) DR4
-            else
-            {
-                // Choose the next available channel
-                uint8_t i = 0;
-                while( ( ( NvmCtx.ChannelsMaskRemaining[4] & CHANNELS_MASK_500KHZ_MASK ) & ( 1 << i ) ) == 0 )
+                // 500kHz Channels (64 - 71) DR4
+                else
                 {
-                    i++;
+                    // Choose the next available channel
+                    uint8_t i = 0;
+                    while( ( ( NvmCtx->ChannelsMaskRemaining[4] & CHANNELS_MASK_500KHZ_MASK ) & ( 1 << i ) ) == 0 )
+                    {
+                        i++;
+                    }
+                    *channel = 64 + i;
                 }
-                *channel = 64 + i;
             }
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+            RegionCommonJoinLearningJoinRequest( &NvmCtx->JoinLearning, *channel );
+#endif
         }
 
         // Disable the channel in the mask
-        RegionCommonChanDisable( NvmCtx.ChannelsMaskRemaining, *channel, US915_MAX_NB_CHANNELS );
+        RegionCommonChanDisable( NvmCtx->ChannelsMaskRemaining, *channel, US915_MAX_NB_CHANNELS );
     }
     return status;
 }
@@ -1057,9 +1117,14 @@ bool RegionUS915ChannelsRemove( ChannelRemoveParams_t* channelRemove  )
 
 void RegionUS915SetContinuousWave( ContinuousWaveParams_t* continuousWave )
 {
-    int8_t txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx.Bands[NvmCtx.Channels[continuousWave->Channel].Band].TxMaxPower, continuousWave->Datarate, NvmCtx.ChannelsMask );
+    ChannelParams_t channel;
+    int8_t txPowerLimited = 0;
     int8_t phyTxPower = 0;
-    uint32_t frequency = NvmCtx.Channels[continuousWave->Channel].Frequency;
+    uint32_t frequency = 0;
+
+    RegionCommonChannelPlanGetChannel( &ChannelPlan, continuousWave->Channel, &channel );
+    txPowerLimited = LimitTxPower( continuousWave->TxPower, NvmCtx->Bands[channel.Band].TxMaxPower, continuousWave->Datarate, NvmCtx->ChannelsMask );
+    frequency = channel.Frequency;
 
     // Calculate physical TX power
     phyTxPower = RegionCommonComputeTxPower( txPowerLimited, US915_DEFAULT_MAX_ERP, 0 );
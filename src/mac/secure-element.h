@@ -44,6 +44,7 @@ extern "C"
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "LoRaMacCrypto.h"
 
 /*!
@@ -56,6 +57,11 @@ extern "C"
  */
 #define SE_EUI_SIZE             8
 
+/*!
+ * Secure-element full AES-CMAC size in bytes
+ */
+#define SE_CMAC_SIZE            16
+
 /*!
  * Secure-element pin size in bytes
  */
@@ -100,6 +106,108 @@ typedef enum eSecureElementStatus
     SECURE_ELEMENT_FAIL_ENCRYPT,
 }SecureElementStatus_t;
 
+
+/*!
+ * Asynchronous job types
+ */
+typedef enum eSecureElementJobType
+{
+    /*!
+     * Computes a CMAC. See \ref SecureElementComputeAesCmac
+     */
+    SECURE_ELEMENT_JOB_AES_CMAC,
+    /*!
+     * Verifies a CMAC. See \ref SecureElementVerifyAesCmac
+     */
+    SECURE_ELEMENT_JOB_AES_CMAC_VERIFY,
+    /*!
+     * Encrypts one or several blocks. See \ref SecureElementAesEncrypt
+     */
+    SECURE_ELEMENT_JOB_AES_ENCRYPT,
+    /*!
+     * Derives and stores a key. See \ref SecureElementDeriveAndStoreKey
+     */
+    SECURE_ELEMENT_JOB_DERIVE_KEY,
+}SecureElementJobType_t;
+
+typedef struct sSecureElementJob SecureElementJob_t;
+
+/*!
+ * Signature of the function called when an asynchronous job completes
+ *
+ * \param[IN]     job             - Completed job. Its Status field holds the result.
+ */
+typedef void ( *SecureElementJobCallback )( SecureElementJob_t* job );
+
+/*!
+ * Asynchronous job. The job and the buffers it points to are owned by the
+ * Secure Element driver until the job callback is called.
+ */
+struct sSecureElementJob
+{
+    SecureElementJobType_t Type;
+    /*!
+     * Key identifier. Root key identifier for SECURE_ELEMENT_JOB_DERIVE_KEY.
+     */
+    KeyIdentifier_t KeyID;
+    /*!
+     * Key identifier of the derived key for SECURE_ELEMENT_JOB_DERIVE_KEY
+     */
+    KeyIdentifier_t TargetKeyID;
+    /*!
+     * LoRaWAN specification version for SECURE_ELEMENT_JOB_DERIVE_KEY
+     */
+    Version_t Version;
+    /*!
+     * Initial Bx block for SECURE_ELEMENT_JOB_AES_CMAC. May be NULL.
+     */
+    uint8_t* MicBxBuffer;
+    /*!
+     * Input data. SECURE_ELEMENT_JOB_AES_ENCRYPT batches Size / 16 blocks.
+     */
+    uint8_t* Buffer;
+    uint16_t Size;
+    /*!
+     * Encrypted blocks for SECURE_ELEMENT_JOB_AES_ENCRYPT
+     */
+    uint8_t* EncBuffer;
+    /*!
+     * Computed cmac for SECURE_ELEMENT_JOB_AES_CMAC, expected cmac for
+     * SECURE_ELEMENT_JOB_AES_CMAC_VERIFY
+     */
+    uint32_t Cmac;
+    /*!
+     * Status of the operation, valid in the job callback
+     */
+    SecureElementStatus_t Status;
+    SecureElementJobCallback Callback;
+    /*!
+     * User context, not used by the Secure Element driver
+     */
+    void* Context;
+    /*!
+     * Next job of the queue. Internal use only.
+     */
+    SecureElementJob_t* Next;
+};
+
+/*!
+ * Incremental AES-CMAC context, see \ref SecureElementCmacInit
+ */
+typedef struct sSecureElementCmacCtx
+{
+    KeyIdentifier_t KeyID;
+    /*!
+     * CBC-MAC of the processed blocks
+     */
+    uint8_t Mac[16];
+    /*!
+     * Last block, processed once known not to be the final one
+     */
+    uint8_t Block[16];
+    uint8_t BlockLen;
+}SecureElementCmacCtx_t;
+
 /*!
  * Signature of callback function to be called by the Secure Element driver when the
  * non volatile context have to be stored.
@@ -132,6 +240,20 @@ SecureElementStatus_t SecureElementRestoreNvmCtx( void* seNvmCtx );
  */
 void* SecureElementGetNvmCtx( size_t* seNvmCtxSize );
 
+/*!
+ * Uses the passed storage as non-volatile context, without copying it.
+ * Used to switch between the contexts of several LoRaMac instances.
+ *
+ * \remark Secure elements keeping the keys in the chip only support their
+ *         own storage and return SECURE_ELEMENT_ERROR.
+ *
+ * \param[IN]     seNvmCtx        - Storage of at least the size returned by
+ *                                  SecureElementGetNvmCtx. NULL binds the
+ *                                  module storage again.
+ * \retval                        - Status of the operation
+ */
+SecureElementStatus_t SecureElementBindNvmCtx( void* seNvmCtx );
+
 /*!
  * Sets a key
  *
@@ -255,6 +377,60 @@ SecureElementStatus_t SecureElementSetPin( uint8_t* pin );
  */
 uint8_t* SecureElementGetPin( void );
 
+/*!
+ * Starts an incremental AES-CMAC ( RFC 4493 ). The blocks are encrypted with
+ * \ref SecureElementAesEncrypt, the key never leaves the Secure Element.
+ *
+ * \param[IN]  ctx            - Pointer to the CMAC context
+ * \param[IN]  keyID          - Key identifier to determine the AES key to be used
+ * \retval                    - Status of the operation
+ */
+SecureElementStatus_t SecureElementCmacInit( SecureElementCmacCtx_t* ctx, KeyIdentifier_t keyID );
+
+/*!
+ * Adds data to an incremental AES-CMAC
+ *
+ * \param[IN]  ctx            - Pointer to the CMAC context
+ * \param[IN]  buffer         - Data buffer
+ * \param[IN]  size           - Data buffer size
+ * \retval                    - Status of the operation
+ */
+SecureElementStatus_t SecureElementCmacUpdate( SecureElementCmacCtx_t* ctx, const uint8_t* buffer, uint32_t size );
+
+/*!
+ * Computes the full AES-CMAC. The context must be started again before
+ * being reused.
+ *
+ * \param[IN]  ctx            - Pointer to the CMAC context
+ * \param[OUT] cmac           - Computed cmac [SE_CMAC_SIZE bytes]
+ * \retval                    - Status of the operation
+ */
+SecureElementStatus_t SecureElementCmacFinal( SecureElementCmacCtx_t* ctx, uint8_t* cmac );
+
+/*!
+ * Submits an asynchronous job. The jobs are executed in submission order.
+ *
+ * \remark The job callback is called from \ref SecureElementProcess. It may
+ *         submit new jobs.
+ *
+ * \param[IN]  job            - Job to be executed
+ * \retval                    - Status of the operation
+ */
+SecureElementStatus_t SecureElementSubmitJob( SecureElementJob_t* job );
+
+/*!
+ * Processes the asynchronous jobs. To be called from the main loop. The
+ * LoRaMAC calls it from LoRaMacProcess.
+ */
+void SecureElementProcess( void );
+
+/*!
+ * Checks if asynchronous jobs are waiting for their completion
+ *
+ * \retval                    - true when jobs are pending
+ */
+bool SecureElementIsJobPending( void );
+
 /*! \} defgroup SECUREELEMENT */
 
 #ifdef __cplusplus
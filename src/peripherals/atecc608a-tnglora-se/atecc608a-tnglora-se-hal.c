@@ -44,12 +44,16 @@
 #include "delay.h"
 
 #include "radio.h"
+#include "eventlog.h"
 
 #include "atecc608a-tnglora-se-hal.h"
 
 uint32_t ATECC608ASeHalGetRandomNumber( void )
 {
-    return Radio.Random( );
+    uint32_t random = Radio.Random( );
+
+    EVENT_LOG_RECORD_RANDOM( random );
+    return random;
 }
 
 /** @brief This function delays for a number of microseconds.
@@ -357,6 +357,16 @@ void* SecureElementGetNvmCtx( size_t* seNvmCtxSize )
     return &SeNvmCtx;
 }
 
+SecureElementStatus_t SecureElementBindNvmCtx( void* seNvmCtx )
+{
+    if( seNvmCtx != NULL )
+    {
+        // The keys are stored in the secure element itself
+        return SECURE_ELEMENT_ERROR;
+    }
+    return SECURE_ELEMENT_SUCCESS;
+}
+
 SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
 {
     // No key setting for HW SE, can only derive keys
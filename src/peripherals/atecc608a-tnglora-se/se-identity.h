@@ -241,6 +241,17 @@ extern "C" {
             .KeySlotNumber = 0,                                                                                        \
             .KeyBlockIndex = 0,                                                                                        \
         },                                                                                                             \
+        {                                                                                                              \
+            /*!                                                                                                        \
+             * Fragmentation session files AES-CMAC key                                                                \
+             * WARNING: NOT CURRENTLY SUPPORTED BY ATECC608A                                                           \
+             * TODO: Add support                                                                                       \
+             *       SE should provide a slot for FILE_CMAC_KEY.                                                       \
+             */                                                                                                        \
+            .KeyID         = FILE_CMAC_KEY,                                                                            \
+            .KeySlotNumber = 0,                                                                                        \
+            .KeyBlockIndex = 0,                                                                                        \
+        },                                                                                                             \
     },
 
 #ifdef __cplusplus
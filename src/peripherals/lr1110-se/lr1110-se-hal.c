@@ -25,6 +25,7 @@
  */
 #include "board.h"
 #include "radio.h"
+#include "eventlog.h"
 
 #include "lr1110-se-hal.h"
 
@@ -35,5 +36,8 @@ void LR1110SeHalGetUniqueId( uint8_t *id )
 
 uint32_t LR1110SeHalGetRandomNumber( void )
 {
-    return Radio.Random( );
+    uint32_t random = Radio.Random( );
+
+    EVENT_LOG_RECORD_RANDOM( random );
+    return random;
 }
@@ -167,6 +167,16 @@ void* SecureElementGetNvmCtx( size_t* seNvmCtxSize )
     return &SeContext;
 }
 
+SecureElementStatus_t SecureElementBindNvmCtx( void* seNvmCtx )
+{
+    if( seNvmCtx != NULL )
+    {
+        // The keys are stored in the secure element itself
+        return SECURE_ELEMENT_ERROR;
+    }
+    return SECURE_ELEMENT_SUCCESS;
+}
+
 SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
 {
     if( key == NULL )
@@ -498,6 +508,9 @@ static lr1110_crypto_keys_idx_t convert_key_id_from_se_to_lr1110( KeyIdentifier_
         case SLOT_RAND_ZERO_KEY:
             id = LR1110_CRYPTO_KEYS_IDX_GP0;
             break;
+        case FILE_CMAC_KEY:
+            id = LR1110_CRYPTO_KEYS_IDX_GP1;
+            break;
         default:
             id = LR1110_CRYPTO_KEYS_IDX_GP1;
             break;
@@ -0,0 +1,177 @@
+/*!
+ * \file      secure-element-async.c
+ *
+ * \brief     Secure Element asynchronous jobs queue
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \remark    The jobs are executed from \ref SecureElementProcess with the
+ *            blocking Secure Element functions of the selected implementation.
+ *            The jobs submitted by the job callbacks are executed by the same
+ *            \ref SecureElementProcess call.
+ *
+ *            When SECURE_ELEMENT_SIMULATED_LATENCY is defined, each job only
+ *            completes after SECURE_ELEMENT_SIMULATED_LATENCY milliseconds per
+ *            processed AES block. This emulates a slow external secure element
+ *            with the software implementation.
+ */
+#include <stddef.h>
+
+#include "utilities.h"
+#include "secure-element.h"
+
+#if defined( SECURE_ELEMENT_SIMULATED_LATENCY )
+#include "timer.h"
+#endif
+
+/*!
+ * Jobs queue
+ */
+static SecureElementJob_t* JobQueueHead = NULL;
+static SecureElementJob_t* JobQueueTail = NULL;
+
+#if defined( SECURE_ELEMENT_SIMULATED_LATENCY )
+/*!
+ * Simulated latency timer
+ */
+static TimerEvent_t SimulatedLatencyTimer;
+static bool SimulatedLatencyTimerInitialized = false;
+
+/*!
+ * Simulated latency states of the queue head job
+ */
+static bool IsJobStarted = false;
+static volatile bool IsJobDone = false;
+
+static void OnSimulatedLatencyTimerEvent( void* context )
+{
+    IsJobDone = true;
+}
+
+/*!
+ * \brief Gets the number of AES blocks processed by a job
+ */
+static uint16_t GetJobBlocks( SecureElementJob_t* job )
+{
+    switch( job->Type )
+    {
+        case SECURE_ELEMENT_JOB_AES_CMAC:
+            return ( ( job->MicBxBuffer != NULL ) ? 1 : 0 ) + ( ( job->Size + 15 ) / 16 );
+        case SECURE_ELEMENT_JOB_AES_CMAC_VERIFY:
+            return ( job->Size + 15 ) / 16;
+        case SECURE_ELEMENT_JOB_AES_ENCRYPT:
+            return job->Size / 16;
+        case SECURE_ELEMENT_JOB_DERIVE_KEY:
+        default:
+            return 1;
+    }
+}
+#endif
+
+/*!
+ * \brief Executes a job with the blocking Secure Element functions
+ */
+static SecureElementStatus_t ExecuteJob( SecureElementJob_t* job )
+{
+    switch( job->Type )
+    {
+        case SECURE_ELEMENT_JOB_AES_CMAC:
+            return SecureElementComputeAesCmac( job->MicBxBuffer, job->Buffer, job->Size, job->KeyID, &job->Cmac );
+        case SECURE_ELEMENT_JOB_AES_CMAC_VERIFY:
+            return SecureElementVerifyAesCmac( job->Buffer, job->Size, job->Cmac, job->KeyID );
+        case SECURE_ELEMENT_JOB_AES_ENCRYPT:
+            return SecureElementAesEncrypt( job->Buffer, job->Size, job->KeyID, job->EncBuffer );
+        case SECURE_ELEMENT_JOB_DERIVE_KEY:
+            return SecureElementDeriveAndStoreKey( job->Version, job->Buffer, job->KeyID, job->TargetKeyID );
+        default:
+            return SECURE_ELEMENT_ERROR;
+    }
+}
+
+SecureElementStatus_t SecureElementSubmitJob( SecureElementJob_t* job )
+{
+    if( ( job == NULL ) || ( job->Callback == NULL ) )
+    {
+        return SECURE_ELEMENT_ERROR_NPE;
+    }
+
+    job->Status = SECURE_ELEMENT_ERROR;
+    job->Next = NULL;
+
+    CRITICAL_SECTION_BEGIN( );
+    if( JobQueueTail == NULL )
+    {
+        JobQueueHead = job;
+    }
+    else
+    {
+        JobQueueTail->Next = job;
+    }
+    JobQueueTail = job;
+    CRITICAL_SECTION_END( );
+
+    return SECURE_ELEMENT_SUCCESS;
+}
+
+void SecureElementProcess( void )
+{
+    SecureElementJob_t* job = NULL;
+
+    while( JobQueueHead != NULL )
+    {
+        job = JobQueueHead;
+
+#if defined( SECURE_ELEMENT_SIMULATED_LATENCY )
+        if( IsJobStarted == false )
+        {
+            if( SimulatedLatencyTimerInitialized == false )
+            {
+                TimerInit( &SimulatedLatencyTimer, OnSimulatedLatencyTimerEvent );
+                SimulatedLatencyTimerInitialized = true;
+            }
+            // The timer interrupt wakes up the main loop once the job is done
+            IsJobStarted = true;
+            IsJobDone = false;
+            TimerSetValue( &SimulatedLatencyTimer, MAX( 1, SECURE_ELEMENT_SIMULATED_LATENCY * GetJobBlocks( job ) ) );
+            TimerStart( &SimulatedLatencyTimer );
+            return;
+        }
+        if( IsJobDone == false )
+        {
+            return;
+        }
+        IsJobStarted = false;
+#endif
+
+        job->Status = ExecuteJob( job );
+
+        // Dequeue before the callback, which may submit new jobs
+        CRITICAL_SECTION_BEGIN( );
+        JobQueueHead = job->Next;
+        if( JobQueueHead == NULL )
+        {
+            JobQueueTail = NULL;
+        }
+        CRITICAL_SECTION_END( );
+
+        job->Callback( job );
+    }
+}
+
+bool SecureElementIsJobPending( void )
+{
+    return ( JobQueueHead != NULL );
+}
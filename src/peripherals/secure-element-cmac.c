@@ -0,0 +1,147 @@
+/*!
+ * \file      secure-element-cmac.c
+ *
+ * \brief     Secure Element incremental AES-CMAC
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2020 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \remark    SecureElementComputeAesCmac only processes a RAM buffer of up to
+ *            65535 bytes and returns the first 32 bits of the CMAC. This
+ *            implementation chains the blocks itself and only relies on
+ *            \ref SecureElementAesEncrypt, which every Secure Element
+ *            implementation provides, so that large files can be
+ *            authenticated while they are received.
+ */
+#include <stddef.h>
+
+#include "utilities.h"
+#include "secure-element.h"
+
+/*!
+ * AES block size in bytes
+ */
+#define CMAC_BLOCK_SIZE                             16
+
+/*!
+ * \brief Encrypts the block xored with the current MAC
+ *
+ * \param[IN]  ctx            - Pointer to the CMAC context
+ * \param[IN]  block          - Block to be processed
+ * \retval                    - Status of the operation
+ */
+static SecureElementStatus_t CmacProcessBlock( SecureElementCmacCtx_t* ctx, const uint8_t* block )
+{
+    uint8_t input[CMAC_BLOCK_SIZE];
+
+    for( uint8_t i = 0; i < CMAC_BLOCK_SIZE; i++ )
+    {
+        input[i] = ctx->Mac[i] ^ block[i];
+    }
+    return SecureElementAesEncrypt( input, CMAC_BLOCK_SIZE, ctx->KeyID, ctx->Mac );
+}
+
+/*!
+ * \brief Doubles a subkey in GF(2^128)
+ *
+ * \param[IN/OUT] key         - Subkey
+ */
+static void CmacDoubleKey( uint8_t* key )
+{
+    uint8_t carry = key[0] >> 7;
+
+    for( uint8_t i = 0; i < ( CMAC_BLOCK_SIZE - 1 ); i++ )
+    {
+        key[i] = ( key[i] << 1 ) | ( key[i + 1] >> 7 );
+    }
+    key[CMAC_BLOCK_SIZE - 1] = ( key[CMAC_BLOCK_SIZE - 1] << 1 ) ^ ( ( carry != 0 ) ? 0x87 : 0x00 );
+}
+
+SecureElementStatus_t SecureElementCmacInit( SecureElementCmacCtx_t* ctx, KeyIdentifier_t keyID )
+{
+    if( ctx == NULL )
+    {
+        return SECURE_ELEMENT_ERROR_NPE;
+    }
+    memset1( ( uint8_t* )ctx, 0, sizeof( SecureElementCmacCtx_t ) );
+    ctx->KeyID = keyID;
+    return SECURE_ELEMENT_SUCCESS;
+}
+
+SecureElementStatus_t SecureElementCmacUpdate( SecureElementCmacCtx_t* ctx, const uint8_t* buffer, uint32_t size )
+{
+    if( ( ctx == NULL ) || ( ( buffer == NULL ) && ( size != 0 ) ) )
+    {
+        return SECURE_ELEMENT_ERROR_NPE;
+    }
+    while( size > 0 )
+    {
+        uint8_t length;
+
+        // The buffered block is only processed once more data follows it, the
+        // final block is processed with a subkey.
+        if( ctx->BlockLen == CMAC_BLOCK_SIZE )
+        {
+            SecureElementStatus_t status = CmacProcessBlock( ctx, ctx->Block );
+
+            if( status != SECURE_ELEMENT_SUCCESS )
+            {
+                return status;
+            }
+            ctx->BlockLen = 0;
+        }
+        length = MIN( CMAC_BLOCK_SIZE - ctx->BlockLen, size );
+        memcpy1( &ctx->Block[ctx->BlockLen], buffer, length );
+        ctx->BlockLen += length;
+        buffer += length;
+        size -= length;
+    }
+    return SECURE_ELEMENT_SUCCESS;
+}
+
+SecureElementStatus_t SecureElementCmacFinal( SecureElementCmacCtx_t* ctx, uint8_t* cmac )
+{
+    uint8_t zero[CMAC_BLOCK_SIZE] = { 0 };
+    uint8_t subkey[CMAC_BLOCK_SIZE];
+    SecureElementStatus_t status;
+
+    if( ( ctx == NULL ) || ( cmac == NULL ) )
+    {
+        return SECURE_ELEMENT_ERROR_NPE;
+    }
+    status = SecureElementAesEncrypt( zero, CMAC_BLOCK_SIZE, ctx->KeyID, subkey );
+    if( status != SECURE_ELEMENT_SUCCESS )
+    {
+        return status;
+    }
+    CmacDoubleKey( subkey );
+    if( ctx->BlockLen < CMAC_BLOCK_SIZE )
+    {
+        // Padded final block
+        CmacDoubleKey( subkey );
+        ctx->Block[ctx->BlockLen] = 0x80;
+        memset1( &ctx->Block[ctx->BlockLen + 1], 0, CMAC_BLOCK_SIZE - ctx->BlockLen - 1 );
+    }
+    for( uint8_t i = 0; i < CMAC_BLOCK_SIZE; i++ )
+    {
+        ctx->Block[i] ^= subkey[i];
+    }
+    status = CmacProcessBlock( ctx, ctx->Block );
+    if( status == SECURE_ELEMENT_SUCCESS )
+    {
+        memcpy1( cmac, ctx->Mac, SE_CMAC_SIZE );
+    }
+    return status;
+}
@@ -288,6 +288,14 @@ extern "C" {
             .KeyValue = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
                           0x00 },                                                                                   \
         },                                                                                                          \
+        {                                                                                                           \
+            /*!                                                                                                     \
+             * Fragmentation session files AES-CMAC key (Provisioned)                                               \
+             */                                                                                                     \
+            .KeyID    = FILE_CMAC_KEY,                                                                              \
+            .KeyValue = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                          0x00 },                                                                                   \
+        },                                                                                                          \
     },
 
 #ifdef __cplusplus
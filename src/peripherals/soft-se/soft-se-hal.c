@@ -25,6 +25,7 @@
  */
 #include "board.h"
 #include "radio.h"
+#include "eventlog.h"
 
 #include "soft-se-hal.h"
 
@@ -35,5 +36,8 @@ void SoftSeHalGetUniqueId( uint8_t *id )
 
 uint32_t SoftSeHalGetRandomNumber( void )
 {
-    return Radio.Random( );
+    uint32_t random = Radio.Random( );
+
+    EVENT_LOG_RECORD_RANDOM( random );
+    return random;
 }
@@ -39,7 +39,7 @@
 /*!
  * Number of supported crypto keys
  */
-#define NUM_OF_KEYS 23
+#define NUM_OF_KEYS 24
 
 /*!
  * Identifier value pair type for Keys
@@ -80,9 +80,9 @@ typedef struct sSecureElementNvCtx
 } SecureElementNvCtx_t;
 
 /*!
- * Secure element context
+ * Secure element context defaults
  */
-static SecureElementNvCtx_t SeNvmCtx = {
+static const SecureElementNvCtx_t SeNvmCtxDefaults = {
     /*!
      * end-device IEEE EUI (big endian)
      *
@@ -104,6 +104,17 @@ static SecureElementNvCtx_t SeNvmCtx = {
     .KeyList = SOFT_SE_KEY_LIST
 };
 
+/*!
+ * Secure element context
+ */
+static SecureElementNvCtx_t DefaultSeNvmCtx;
+
+/*!
+ * Secure element context in use. Bound to the context of the selected
+ * LoRaMac instance by SecureElementBindNvmCtx.
+ */
+static SecureElementNvCtx_t* SeNvmCtx = &DefaultSeNvmCtx;
+
 static SecureElementNvmEvent SeNvmCtxChanged;
 
 /*
@@ -121,9 +132,9 @@ static SecureElementStatus_t GetKeyByID( KeyIdentifier_t keyID, Key_t** keyItem
 {
     for( uint8_t i = 0; i < NUM_OF_KEYS; i++ )
     {
-        if( SeNvmCtx.KeyList[i].KeyID == keyID )
+        if( SeNvmCtx->KeyList[i].KeyID == keyID )
         {
-            *keyItem = &( SeNvmCtx.KeyList[i] );
+            *keyItem = &( SeNvmCtx->KeyList[i] );
             return SECURE_ELEMENT_SUCCESS;
         }
     }
@@ -203,10 +214,13 @@ SecureElementStatus_t SecureElementInit( SecureElementNvmEvent seNvmCtxChanged )
         SeNvmCtxChanged = DummyCB;
     }
 
+    // Load the provisioned identity and keys
+    memcpy1( ( uint8_t* ) SeNvmCtx, ( const uint8_t* ) &SeNvmCtxDefaults, sizeof( SecureElementNvCtx_t ) );
+
 #if !defined( SECURE_ELEMENT_PRE_PROVISIONED )
 #if( STATIC_DEVICE_EUI == 0 )
     // Get a DevEUI from MCU unique ID
-    SoftSeHalGetUniqueId( SeNvmCtx.DevEui );
+    SoftSeHalGetUniqueId( SeNvmCtx->DevEui );
 #endif
 #endif
 
@@ -220,7 +234,7 @@ SecureElementStatus_t SecureElementRestoreNvmCtx( void* seNvmCtx )
     // Restore nvm context
     if( seNvmCtx != 0 )
     {
-        memcpy1( ( uint8_t* ) &SeNvmCtx, ( uint8_t* ) seNvmCtx, sizeof( SeNvmCtx ) );
+        memcpy1( ( uint8_t* ) SeNvmCtx, ( uint8_t* ) seNvmCtx, sizeof( SecureElementNvCtx_t ) );
         return SECURE_ELEMENT_SUCCESS;
     }
     else
@@ -231,8 +245,21 @@ SecureElementStatus_t SecureElementRestoreNvmCtx( void* seNvmCtx )
 
 void* SecureElementGetNvmCtx( size_t* seNvmCtxSize )
 {
-    *seNvmCtxSize = sizeof( SeNvmCtx );
-    return &SeNvmCtx;
+    *seNvmCtxSize = sizeof( SecureElementNvCtx_t );
+    return SeNvmCtx;
+}
+
+SecureElementStatus_t SecureElementBindNvmCtx( void* seNvmCtx )
+{
+    if( seNvmCtx != NULL )
+    {
+        SeNvmCtx = ( SecureElementNvCtx_t* )seNvmCtx;
+    }
+    else
+    {
+        SeNvmCtx = &DefaultSeNvmCtx;
+    }
+    return SECURE_ELEMENT_SUCCESS;
 }
 
 SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
@@ -244,7 +271,7 @@ SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
 
     for( uint8_t i = 0; i < NUM_OF_KEYS; i++ )
     {
-        if( SeNvmCtx.KeyList[i].KeyID == keyID )
+        if( SeNvmCtx->KeyList[i].KeyID == keyID )
         {
             if( ( keyID == MC_KEY_0 ) || ( keyID == MC_KEY_1 ) || ( keyID == MC_KEY_2 ) || ( keyID == MC_KEY_3 ) )
             {  // Decrypt the key if its a Mckey
@@ -253,14 +280,14 @@ SecureElementStatus_t SecureElementSetKey( KeyIdentifier_t keyID, uint8_t* key )
 
                 retval = SecureElementAesEncrypt( key, 16, MC_KE_KEY, decryptedKey );
 
-                memcpy1( SeNvmCtx.KeyList[i].KeyValue, decryptedKey, SE_KEY_SIZE );
+                memcpy1( SeNvmCtx->KeyList[i].KeyValue, decryptedKey, SE_KEY_SIZE );
                 SeNvmCtxChanged( );
 
                 return retval;
             }
             else
             {
-                memcpy1( SeNvmCtx.KeyList[i].KeyValue, key, SE_KEY_SIZE );
+                memcpy1( SeNvmCtx->KeyList[i].KeyValue, key, SE_KEY_SIZE );
                 SeNvmCtxChanged( );
                 return SECURE_ELEMENT_SUCCESS;
             }
@@ -493,14 +520,14 @@ SecureElementStatus_t SecureElementSetDevEui( uint8_t* devEui )
     {
         return SECURE_ELEMENT_ERROR_NPE;
     }
-    memcpy1( SeNvmCtx.DevEui, devEui, SE_EUI_SIZE );
+    memcpy1( SeNvmCtx->DevEui, devEui, SE_EUI_SIZE );
     SeNvmCtxChanged( );
     return SECURE_ELEMENT_SUCCESS;
 }
 
 uint8_t* SecureElementGetDevEui( void )
 {
-    return SeNvmCtx.DevEui;
+    return SeNvmCtx->DevEui;
 }
 
 SecureElementStatus_t SecureElementSetJoinEui( uint8_t* joinEui )
@@ -509,14 +536,14 @@ SecureElementStatus_t SecureElementSetJoinEui( uint8_t* joinEui )
     {
         return SECURE_ELEMENT_ERROR_NPE;
     }
-    memcpy1( SeNvmCtx.JoinEui, joinEui, SE_EUI_SIZE );
+    memcpy1( SeNvmCtx->JoinEui, joinEui, SE_EUI_SIZE );
     SeNvmCtxChanged( );
     return SECURE_ELEMENT_SUCCESS;
 }
 
 uint8_t* SecureElementGetJoinEui( void )
 {
-    return SeNvmCtx.JoinEui;
+    return SeNvmCtx->JoinEui;
 }
 
 SecureElementStatus_t SecureElementSetPin( uint8_t* pin )
@@ -526,12 +553,12 @@ SecureElementStatus_t SecureElementSetPin( uint8_t* pin )
         return SECURE_ELEMENT_ERROR_NPE;
     }
 
-    memcpy1( SeNvmCtx.Pin, pin, SE_PIN_SIZE );
+    memcpy1( SeNvmCtx->Pin, pin, SE_PIN_SIZE );
     SeNvmCtxChanged( );
     return SECURE_ELEMENT_SUCCESS;
 }
 
 uint8_t* SecureElementGetPin( void )
 {
-    return SeNvmCtx.Pin;
+    return SeNvmCtx->Pin;
 }
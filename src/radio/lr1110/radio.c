@@ -24,6 +24,7 @@
 #include "timer.h"
 #include "delay.h"
 #include "radio.h"
+#include "radio-filter.h"
 #include "lr1110.h"
 #include "lr1110_hal.h"
 #include "lr1110_radio.h"
@@ -328,8 +329,8 @@ void RadioRxBoosted( uint32_t timeout );
 /*!
  * \brief Sets the Rx duty cycle management parameters
  *
- * \param [in]  rxTime        Structure describing reception timeout value
- * \param [in]  sleepTime     Structure describing sleep timeout value
+ * \param [in]  rxTime        Reception window duration [us]
+ * \param [in]  sleepTime     Sleep period duration [us]
  */
 void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime );
 
@@ -365,6 +366,9 @@ const struct Radio_s Radio = {
     // Available on LR1110 only
     RadioRxBoosted,
     RadioSetRxDutyCycle,
+    NULL, // void ( *StartChannelFree )( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+    RadioRxFilterSet,
+    RadioRxFilterGetStats,
 };
 
 /*
@@ -400,6 +404,19 @@ uint32_t RxTimeout = 0;
 
 bool RxContinuous = false;
 
+/*!
+ * Fixed length reception. The reception filter only applies to variable
+ * length frames.
+ */
+bool RxFixLen = false;
+
+/*!
+ * Reception duty cycle periods in RTC steps of 1/32768 s, used to restart the
+ * duty cycle after a frame dropped by the reception filter
+ */
+uint32_t RxDutyCycleRxTime    = 0;
+uint32_t RxDutyCycleSleepTime = 0;
+
 lr1110_radio_packet_status_lora_t lora_packet_status;
 lr1110_radio_packet_status_gfsk_t gfsk_packet_status;
 uint8_t                           RadioRxPayload[255];
@@ -604,6 +621,7 @@ void RadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth, uint32_t datarat
                        bool rxContinuous )
 {
     RxContinuous = rxContinuous;
+    RxFixLen     = fixLen;
     if( rxContinuous == true )
     {
         symbTimeout = 0;
@@ -1061,7 +1079,15 @@ void RadioRxBoosted( uint32_t timeout )
 
 void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime )
 {
-    lr1110_radio_set_rx_dutycycle( &LR1110, rxTime, sleepTime, 0 );
+    lr1110_system_set_dio_irq_params(
+        &LR1110,
+        LR1110_SYSTEM_IRQ_ALL_MASK,  // LR1110_SYSTEM_IRQ_RXDONE_MASK | LR1110_SYSTEM_IRQ_TIMEOUT_MASK,
+        LR1110_SYSTEM_IRQ_NONE_MASK );
+
+    // Durations in RTC steps of 1/32768 s
+    RxDutyCycleRxTime    = ( uint32_t )( ( ( uint64_t )rxTime << 15 ) / 1000000 );
+    RxDutyCycleSleepTime = ( uint32_t )( ( ( uint64_t )sleepTime << 15 ) / 1000000 );
+    lr1110_radio_set_rx_dutycycle( &LR1110, RxDutyCycleRxTime, RxDutyCycleSleepTime, 0 );
     lr1110_hal_set_operating_mode( &LR1110, LR1110_HAL_OP_MODE_RX_DC );
 }
 
@@ -1241,6 +1267,8 @@ void RadioIrqProcess( void )
         CRITICAL_SECTION_END( );
 
         uint32_t irqRegs;
+        // The operating mode is updated while processing the interrupts
+        bool isRxDutyCycle = ( lr1110_hal_get_operating_mode( &LR1110 ) == LR1110_HAL_OP_MODE_RX_DC );
         // Get Status
         lr1110_system_irq_process( &LR1110, &irqRegs );
 
@@ -1257,30 +1285,56 @@ void RadioIrqProcess( void )
         {
             lr1110_radio_packet_types_t    packet_type;
             lr1110_radio_rxbuffer_status_t rxbuffer_status;
+            uint8_t                        header_size;
 
-            TimerStop( &RxTimeoutTimer );
-
+            // Only the MAC header is read until the frame is accepted
             lr1110_radio_get_rxbuffer_status( &LR1110, &rxbuffer_status );
-            lr1110_regmem_read_buffer8( &LR1110, RadioRxPayload, rxbuffer_status.rx_start_buffer_pointer,
-                                        rxbuffer_status.rx_payload_length );
+            header_size = MIN( rxbuffer_status.rx_payload_length, RADIO_RX_FILTER_HEADER_SIZE );
+            lr1110_regmem_read_buffer8( &LR1110, RadioRxPayload, rxbuffer_status.rx_start_buffer_pointer, header_size );
 
-            lr1110_radio_get_packet_type( &LR1110, &packet_type );
-            if( packet_type == LR1110_RADIO_PACKET_LORA )
+            if( ( RxFixLen == false ) &&
+                ( RadioRxFilterCheck( RadioRxPayload, rxbuffer_status.rx_payload_length ) == false ) )
             {
-                lr1110_radio_get_packet_status_lora( &LR1110, &lora_packet_status );
-                if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
+                if( isRxDutyCycle == true )
+                {
+                    lr1110_radio_set_rx_dutycycle( &LR1110, RxDutyCycleRxTime, RxDutyCycleSleepTime, 0 );
+                    lr1110_hal_set_operating_mode( &LR1110, LR1110_HAL_OP_MODE_RX_DC );
+                }
+                else if( RxContinuous == false )
                 {
-                    RadioEvents->RxDone( RadioRxPayload, rxbuffer_status.rx_payload_length,
-                                         lora_packet_status.rssi_packet_in_dbm, lora_packet_status.snr_packet_in_db );
+                    TimerStop( &RxTimeoutTimer );
+                    if( ( RadioEvents != NULL ) && ( RadioEvents->RxTimeout != NULL ) )
+                    {
+                        RadioEvents->RxTimeout( );
+                    }
                 }
             }
             else
             {
-                lr1110_radio_get_packet_status_gfsk( &LR1110, &gfsk_packet_status );
-                if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
+                TimerStop( &RxTimeoutTimer );
+
+                lr1110_regmem_read_buffer8( &LR1110, RadioRxPayload + header_size,
+                                            rxbuffer_status.rx_start_buffer_pointer + header_size,
+                                            rxbuffer_status.rx_payload_length - header_size );
+
+                lr1110_radio_get_packet_type( &LR1110, &packet_type );
+                if( packet_type == LR1110_RADIO_PACKET_LORA )
+                {
+                    lr1110_radio_get_packet_status_lora( &LR1110, &lora_packet_status );
+                    if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
+                    {
+                        RadioEvents->RxDone( RadioRxPayload, rxbuffer_status.rx_payload_length,
+                                             lora_packet_status.rssi_packet_in_dbm, lora_packet_status.snr_packet_in_db );
+                    }
+                }
+                else
                 {
-                    RadioEvents->RxDone( RadioRxPayload, rxbuffer_status.rx_payload_length,
-                                         gfsk_packet_status.rssi_avg_in_dbm, 0 );
+                    lr1110_radio_get_packet_status_gfsk( &LR1110, &gfsk_packet_status );
+                    if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
+                    {
+                        RadioEvents->RxDone( RadioRxPayload, rxbuffer_status.rx_payload_length,
+                                             gfsk_packet_status.rssi_avg_in_dbm, 0 );
+                    }
                 }
             }
         }
@@ -0,0 +1,112 @@
+/*!
+ * \file      radio-filter.c
+ *
+ * \brief     Radio driver reception filter
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include "utilities.h"
+#include "radio-filter.h"
+
+/*!
+ * Reception filter context
+ */
+static struct
+{
+    bool IsEnabled;
+    RadioRxFilter_t Filter;
+    RadioRxFilterStats_t Stats;
+}RxFilter;
+
+void RadioRxFilterSet( const RadioRxFilter_t* filter )
+{
+    CRITICAL_SECTION_BEGIN( );
+    if( filter != NULL )
+    {
+        RxFilter.Filter = *filter;
+        if( RxFilter.Filter.NbAddresses > RADIO_RX_FILTER_MAX_ADDRESSES )
+        {
+            RxFilter.Filter.NbAddresses = RADIO_RX_FILTER_MAX_ADDRESSES;
+        }
+        RxFilter.IsEnabled = true;
+    }
+    else
+    {
+        RxFilter.IsEnabled = false;
+    }
+    CRITICAL_SECTION_END( );
+}
+
+void RadioRxFilterGetStats( RadioRxFilterStats_t* stats )
+{
+    CRITICAL_SECTION_BEGIN( );
+    *stats = RxFilter.Stats;
+    CRITICAL_SECTION_END( );
+}
+
+bool RadioRxFilterCheck( const uint8_t* header, uint8_t size )
+{
+    uint8_t mTypeBit = 0;
+    uint32_t address = 0;
+
+    if( RxFilter.IsEnabled == false )
+    {
+        return true;
+    }
+
+    if( size == 0 )
+    {
+        RxFilter.Stats.DroppedSize++;
+        return false;
+    }
+
+    // MType is held by the 3 most significant bits of the MHDR
+    mTypeBit = 1 << ( header[0] >> 5 );
+    if( ( RxFilter.Filter.MTypeMask & mTypeBit ) == 0 )
+    {
+        RxFilter.Stats.DroppedMType++;
+        return false;
+    }
+
+    if( ( RxFilter.Filter.AddressMTypeMask & mTypeBit ) != 0 )
+    {
+        if( ( size < RADIO_RX_FILTER_HEADER_SIZE ) || ( size < RxFilter.Filter.MinSize ) )
+        {
+            RxFilter.Stats.DroppedSize++;
+            return false;
+        }
+
+        address = ( uint32_t )header[1];
+        address |= ( ( uint32_t )header[2] << 8 );
+        address |= ( ( uint32_t )header[3] << 16 );
+        address |= ( ( uint32_t )header[4] << 24 );
+
+        for( uint8_t i = 0; i < RxFilter.Filter.NbAddresses; i++ )
+        {
+            if( RxFilter.Filter.Addresses[i] == address )
+            {
+                RxFilter.Stats.Accepted++;
+                return true;
+            }
+        }
+        RxFilter.Stats.DroppedAddress++;
+        return false;
+    }
+
+    RxFilter.Stats.Accepted++;
+    return true;
+}
@@ -0,0 +1,66 @@
+/*!
+ * \file      radio-filter.h
+ *
+ * \brief     Radio driver reception filter
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __RADIO_FILTER_H__
+#define __RADIO_FILTER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "radio.h"
+
+/*!
+ * \brief Installs the reception filter. Implements Radio.SetRxFilter for
+ *        the radio drivers.
+ *
+ * \param [IN] filter Filter to be installed, NULL to disable the filtering
+ */
+void RadioRxFilterSet( const RadioRxFilter_t* filter );
+
+/*!
+ * \brief Gets the reception filter counters. Implements
+ *        Radio.GetRxFilterStats for the radio drivers.
+ *
+ * \param [OUT] stats Reception filter counters
+ */
+void RadioRxFilterGetStats( RadioRxFilterStats_t* stats );
+
+/*!
+ * \brief Evaluates the reception filter on the first bytes of a received
+ *        frame and updates the counters
+ *
+ * \param [IN] header First bytes of the frame. At least
+ *                    RADIO_RX_FILTER_HEADER_SIZE bytes or the frame size when
+ *                    smaller.
+ * \param [IN] size   Frame size
+ *
+ * \retval accepted [true: frame accepted or filter disabled, false: frame dropped]
+ */
+bool RadioRxFilterCheck( const uint8_t* header, uint8_t size );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RADIO_FILTER_H__
@@ -51,6 +51,77 @@ typedef enum
     RF_CAD,        //!< The radio is doing channel activity detection
 }RadioState_t;
 
+/*!
+ * Radio driver carrier sense (listen before talk) modes
+ */
+typedef enum
+{
+    RADIO_CARRIER_SENSE_RSSI = 0, //!< RSSI sampled with the FSK modem against a threshold
+    RADIO_CARRIER_SENSE_CAD,      //!< LoRa channel activity detection
+}RadioCarrierSenseModes_t;
+
+/*!
+ * Maximum number of addresses of the reception filter
+ */
+#define RADIO_RX_FILTER_MAX_ADDRESSES               5
+
+/*!
+ * Number of bytes the reception filter evaluates: MHDR and DevAddr
+ */
+#define RADIO_RX_FILTER_HEADER_SIZE                 5
+
+/*!
+ * Radio driver reception filter, evaluated on the LoRaWAN MAC header of the
+ * received frames before their payload is read
+ */
+typedef struct sRadioRxFilter
+{
+    /*!
+     * Accepted MTypes. Bit n set: MType n accepted.
+     */
+    uint8_t MTypeMask;
+    /*!
+     * MTypes followed by a DevAddr which must match one of the Addresses.
+     * Bit n set: MType n checked.
+     */
+    uint8_t AddressMTypeMask;
+    /*!
+     * Minimum size of the frames whose MType is set in AddressMTypeMask
+     */
+    uint8_t MinSize;
+    /*!
+     * Number of valid Addresses
+     */
+    uint8_t NbAddresses;
+    /*!
+     * Accepted unicast and multicast addresses
+     */
+    uint32_t Addresses[RADIO_RX_FILTER_MAX_ADDRESSES];
+}RadioRxFilter_t;
+
+/*!
+ * Radio driver reception filter counters
+ */
+typedef struct sRadioRxFilterStats
+{
+    /*!
+     * Number of frames passed to the RxDone callback
+     */
+    uint32_t Accepted;
+    /*!
+     * Number of frames dropped because of their size
+     */
+    uint32_t DroppedSize;
+    /*!
+     * Number of frames dropped because of their MType
+     */
+    uint32_t DroppedMType;
+    /*!
+     * Number of frames dropped because of their DevAddr
+     */
+    uint32_t DroppedAddress;
+}RadioRxFilterStats_t;
+
 /*!
  * \brief Radio driver callback functions
  */
@@ -106,6 +177,13 @@ typedef struct
      * \brief  Gnss Done Done callback prototype.
     */
     void    ( *WifiDone )( void );
+
+    /*!
+     * \brief Carrier sense done callback prototype.
+     *
+     * \param [IN] channelIsFree  Channel has been found free during the carrier sense
+     */
+    void    ( *ChannelFreeDone )( bool channelIsFree );
 }RadioEvents_t;
 
 /*!
@@ -392,14 +470,66 @@ struct Radio_s
      */
     void    ( *RxBoosted )( uint32_t timeout );
     /*!
-     * \brief Sets the Rx duty cycle management parameters
+     * \brief Starts the reception duty cycle: the radio alternates reception
+     *        windows and sleep periods until a packet is received.
      *
-     * \remark Available on SX126x radios only.
+     * \remark Available on SX126x and LR1110 radios only, NULL otherwise.
+     *         The radio extends the reception window when it detects a
+     *         preamble. The reception ends with the RxDone, RxError or
+     *         RxTimeout event, the duty cycle must then be restarted.
      *
-     * \param [in]  rxTime        Structure describing reception timeout value
-     * \param [in]  sleepTime     Structure describing sleep timeout value
+     * \remark The durations are in microseconds whatever the radio. The
+     *         drivers convert them to the steps of their radio, 15.625 us
+     *         on SX126x and 1/32768 s on LR1110. They used to be passed in
+     *         SX126x steps.
+     *
+     * \param [in]  rxTime        Reception window duration [us]
+     * \param [in]  sleepTime     Sleep period duration [us]
      */
     void ( *SetRxDutyCycle ) ( uint32_t rxTime, uint32_t sleepTime );
+    /*!
+     * \brief Starts a non-blocking carrier sense on the given channel.
+     *
+     * \remark The result is notified through the RadioEvents_t.ChannelFreeDone
+     *         callback and the radio is put in sleep mode once done.
+     *         RADIO_CARRIER_SENSE_RSSI uses the FSK modem and samples the RSSI
+     *         from a timer, the MCU may sleep in between.
+     *         RADIO_CARRIER_SENSE_CAD repeats LoRa CAD with the LoRa modem and
+     *         modulation previously setup by SetRxConfig, the driver sets the
+     *         CAD detection parameters. rxBandwidth and rssiThresh are not used.
+     *
+     * \remark Set to NULL by drivers not supporting it. Use IsChannelFree instead.
+     *
+     * \param [IN] freq                Channel RF frequency in Hertz
+     * \param [IN] rxBandwidth         Rx bandwidth in Hertz
+     * \param [IN] rssiThresh          RSSI threshold in dBm
+     * \param [IN] maxCarrierSenseTime Max time in milliseconds while the channel is sensed
+     * \param [IN] mode                Carrier sense mode [RADIO_CARRIER_SENSE_RSSI, RADIO_CARRIER_SENSE_CAD]
+     */
+    void    ( *StartChannelFree )( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode );
+    /*!
+     * \brief Installs the reception filter. The driver reads the first bytes
+     *        of the received frames and drops the frames the filter rejects
+     *        without reading their payload nor calling RxDone.
+     *
+     * \remark Frames received with a fixed length, e.g. the class B beacons,
+     *         aren't filtered. After a dropped frame, continuous and duty
+     *         cycled receptions go on and single receptions end with the
+     *         RxTimeout event.
+     *
+     * \remark Set to NULL by drivers not supporting it.
+     *
+     * \param [IN] filter Filter to be installed, NULL to disable the filtering
+     */
+    void    ( *SetRxFilter )( const RadioRxFilter_t* filter );
+    /*!
+     * \brief Gets the reception filter counters
+     *
+     * \remark Set to NULL by drivers not supporting it.
+     *
+     * \param [OUT] stats Reception filter counters
+     */
+    void    ( *GetRxFilterStats )( RadioRxFilterStats_t* stats );
 };
 
 /*!
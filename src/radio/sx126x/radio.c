@@ -24,8 +24,10 @@
 #include <string.h>
 #include "utilities.h"
 #include "timer.h"
+#include "tracepoint.h"
 #include "delay.h"
 #include "radio.h"
+#include "radio-filter.h"
 #include "sx126x.h"
 #include "sx126x-board.h"
 #include "board.h"
@@ -72,6 +74,19 @@ void RadioSetChannel( uint32_t freq );
  */
 bool RadioIsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime );
 
+/*!
+ * \brief Starts a non-blocking carrier sense on the given channel
+ *
+ * \remark The result is notified through the RadioEvents_t.ChannelFreeDone callback.
+ *
+ * \param [IN] freq                Channel RF frequency in Hertz
+ * \param [IN] rxBandwidth         Rx bandwidth in Hertz
+ * \param [IN] rssiThresh          RSSI threshold in dBm
+ * \param [IN] maxCarrierSenseTime Max time in milliseconds while the channel is sensed
+ * \param [IN] mode                Carrier sense mode [RADIO_CARRIER_SENSE_RSSI, RADIO_CARRIER_SENSE_CAD]
+ */
+void RadioStartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode );
+
 /*!
  * \brief Generates a 32 bits random value based on the RSSI readings
  *
@@ -331,8 +346,8 @@ void RadioRxBoosted( uint32_t timeout );
 /*!
  * \brief Sets the Rx duty cycle management parameters
  *
- * \param [in]  rxTime        Structure describing reception timeout value
- * \param [in]  sleepTime     Structure describing sleep timeout value
+ * \param [in]  rxTime        Reception window duration [us]
+ * \param [in]  sleepTime     Sleep period duration [us]
  */
 void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime );
 
@@ -368,7 +383,10 @@ const struct Radio_s Radio =
     RadioIrqProcess,
     // Available on SX126x only
     RadioRxBoosted,
-    RadioSetRxDutyCycle
+    RadioSetRxDutyCycle,
+    RadioStartChannelFree,
+    RadioRxFilterSet,
+    RadioRxFilterGetStats
 };
 
 /*
@@ -423,12 +441,30 @@ uint32_t RxTimeout = 0;
 
 bool RxContinuous = false;
 
+/*!
+ * Fixed length reception. The reception filter only applies to variable
+ * length frames.
+ */
+bool RxFixLen = false;
+
+/*!
+ * Reception duty cycle periods in steps of 15.625 us, used to restart the
+ * duty cycle after a frame dropped by the reception filter
+ */
+uint32_t RxDutyCycleRxTime = 0;
+uint32_t RxDutyCycleSleepTime = 0;
 
 PacketStatus_t RadioPktStatus;
 uint8_t RadioRxPayload[255];
 
 bool IrqFired = false;
 
+/*!
+ * Set by the carrier sense sampling timer. The RSSI is read over SPI by
+ * RadioIrqProcess, out of the timer interrupt.
+ */
+bool CarrierSenseSampleFired = false;
+
 /*
  * SX126x DIO IRQ callback functions prototype
  */
@@ -448,6 +484,30 @@ void RadioOnTxTimeoutIrq( void* context );
  */
 void RadioOnRxTimeoutIrq( void* context );
 
+/*!
+ * \brief Carrier sense sampling timer callback
+ */
+void RadioOnCarrierSenseTimerIrq( void* context );
+
+/*!
+ * \brief Ends the carrier sense procedure and notifies the upper layer
+ *
+ * \param [IN] channelIsFree Carrier sense result
+ */
+static void RadioCarrierSenseDone( bool channelIsFree );
+
+/*!
+ * \brief Takes one carrier sense RSSI sample, then ends or reschedules the
+ *        procedure
+ */
+static void RadioCarrierSenseSample( void );
+
+/*!
+ * \brief Called from the BUSY pin falling edge interrupt once the radio has
+ *        processed the last command of a configuration sequence
+ */
+static void RadioOnConfigDone( void );
+
 /*
  * Private global variables
  */
@@ -464,6 +524,36 @@ typedef struct
 
 static RadioPublicNetwork_t RadioPublicNetwork = { false };
 
+/*!
+ * Carrier sense RSSI sampling period [ms]
+ */
+#define RADIO_CARRIER_SENSE_SAMPLING_PERIOD         1
+
+/*!
+ * CAD detection peak of the carrier sense, indexed by spreading factor from
+ * SF5. 2 symbols CAD, values from the SX126x CAD performance application note
+ */
+static const uint8_t RadioCadDetPeaks[] = { 22, 22, 22, 22, 23, 24, 25, 28 };
+
+/*!
+ * CAD detection minimum of the carrier sense
+ */
+#define RADIO_CARRIER_SENSE_CAD_DET_MIN             10
+
+/*!
+ * Holds the state of the non-blocking carrier sense procedure
+ */
+typedef struct
+{
+    bool                     Running;
+    RadioCarrierSenseModes_t Mode;
+    int16_t                  RssiThresh;
+    uint32_t                 MaxCarrierSenseTime;
+    TimerTime_t              StartTime;
+}RadioCarrierSense_t;
+
+static RadioCarrierSense_t RadioCarrierSense = { .Running = false };
+
 /*!
  * Radio callbacks variable
  */
@@ -484,6 +574,11 @@ SX126x_t SX126x;
 TimerEvent_t TxTimeoutTimer;
 TimerEvent_t RxTimeoutTimer;
 
+/*!
+ * Carrier sense RSSI sampling timer
+ */
+TimerEvent_t CarrierSenseTimer;
+
 /*!
  * Returns the known FSK bandwidth registers value
  *
@@ -525,8 +620,10 @@ void RadioInit( RadioEvents_t *events )
     // Initialize driver timeout timers
     TimerInit( &TxTimeoutTimer, RadioOnTxTimeoutIrq );
     TimerInit( &RxTimeoutTimer, RadioOnRxTimeoutIrq );
+    TimerInit( &CarrierSenseTimer, RadioOnCarrierSenseTimerIrq );
 
     IrqFired = false;
+    CarrierSenseSampleFired = false;
 }
 
 RadioState_t RadioGetStatus( void )
@@ -536,6 +633,7 @@ RadioState_t RadioGetStatus( void )
         case MODE_TX:
             return RF_TX_RUNNING;
         case MODE_RX:
+        case MODE_RX_DC:
             return RF_RX_RUNNING;
         case MODE_CAD:
             return RF_CAD;
@@ -606,6 +704,59 @@ bool RadioIsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh
     return status;
 }
 
+void RadioStartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+{
+    RadioCarrierSense.Running = true;
+    RadioCarrierSense.Mode = mode;
+    RadioCarrierSense.RssiThresh = rssiThresh;
+    RadioCarrierSense.MaxCarrierSenseTime = maxCarrierSenseTime;
+
+    if( mode == RADIO_CARRIER_SENSE_CAD )
+    {
+        // The LoRa modem and modulation are setup by the caller through SetRxConfig
+        RadioSetChannel( freq );
+        SX126xSetCadParams( LORA_CAD_02_SYMBOL,
+                            RadioCadDetPeaks[SX126x.ModulationParams.Params.LoRa.SpreadingFactor - LORA_SF5],
+                            RADIO_CARRIER_SENSE_CAD_DET_MIN, LORA_CAD_ONLY, 0 );
+        RadioCarrierSense.StartTime = TimerGetCurrentTime( );
+        RadioStartCad( );
+        return;
+    }
+
+    RadioSetModem( MODEM_FSK );
+
+    RadioSetChannel( freq );
+
+    // Set Rx bandwidth. Other parameters are not used.
+    RadioSetRxConfig( MODEM_FSK, rxBandwidth, 600, 0, rxBandwidth, 3, 0, false,
+                      0, false, 0, 0, false, true );
+    RadioRx( 0 );
+
+    // First sample is taken once the RSSI is settled
+    RadioCarrierSense.MaxCarrierSenseTime += RADIO_CARRIER_SENSE_SAMPLING_PERIOD;
+    RadioCarrierSense.StartTime = TimerGetCurrentTime( );
+    TimerSetValue( &CarrierSenseTimer, RADIO_CARRIER_SENSE_SAMPLING_PERIOD );
+    TimerStart( &CarrierSenseTimer );
+}
+
+static void RadioOnConfigDone( void )
+{
+    // Nothing to do, the next command waits for BUSY low in
+    // SX126xCheckDeviceReady
+}
+
+static void RadioCarrierSenseDone( bool channelIsFree )
+{
+    TimerStop( &CarrierSenseTimer );
+    RadioCarrierSense.Running = false;
+    RadioSleep( );
+
+    if( ( RadioEvents != NULL ) && ( RadioEvents->ChannelFreeDone != NULL ) )
+    {
+        RadioEvents->ChannelFreeDone( channelIsFree );
+    }
+}
+
 uint32_t RadioRandom( void )
 {
     uint32_t rnd = 0;
@@ -632,8 +783,11 @@ void RadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth,
                          bool crcOn, bool freqHopOn, uint8_t hopPeriod,
                          bool iqInverted, bool rxContinuous )
 {
+    // Radio BUSY state is only checked before each command is sent
+    SX126xCmdQueueBegin( );
 
     RxContinuous = rxContinuous;
+    RxFixLen = fixLen;
     if( rxContinuous == true )
     {
         symbTimeout = 0;
@@ -750,6 +904,9 @@ void RadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth,
 
             break;
     }
+
+    // Returns without waiting for the radio to process the last command
+    SX126xCmdQueueEnd( RadioOnConfigDone );
 }
 
 void RadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
@@ -758,6 +915,8 @@ void RadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
                         bool fixLen, bool crcOn, bool freqHopOn,
                         uint8_t hopPeriod, bool iqInverted, uint32_t timeout )
 {
+    // Radio BUSY state is only checked before each command is sent
+    SX126xCmdQueueBegin( );
 
     switch( modem )
     {
@@ -856,6 +1015,9 @@ void RadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
 
     SX126xSetRfTxPower( power );
     TxTimeout = timeout;
+
+    // Returns without waiting for the radio to process the last command
+    SX126xCmdQueueEnd( RadioOnConfigDone );
 }
 
 bool RadioCheckRfFrequency( uint32_t frequency )
@@ -994,6 +1156,8 @@ uint32_t RadioTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
     uint32_t numerator = 0;
     uint32_t denominator = 1;
 
+    TRACE_POINT_BEGIN( TRACE_POINT_TIME_ON_AIR );
+
     switch( modem )
     {
     case MODEM_FSK:
@@ -1014,7 +1178,10 @@ uint32_t RadioTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
         break;
     }
     // Perform integral ceil()
-    return ( numerator + denominator - 1 ) / denominator;
+    uint32_t timeOnAir = ( numerator + denominator - 1 ) / denominator;
+
+    TRACE_POINT_END( TRACE_POINT_TIME_ON_AIR );
+    return timeOnAir;
 }
 
 void RadioSend( uint8_t *buffer, uint8_t size )
@@ -1102,7 +1269,17 @@ void RadioRxBoosted( uint32_t timeout )
 
 void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime )
 {
-    SX126xSetRxDutyCycle( rxTime, sleepTime );
+    // The preamble detected interrupt must be enabled for the radio to extend
+    // the reception window on preamble detection
+    SX126xSetDioIrqParams( IRQ_RADIO_ALL, //IRQ_RX_DONE | IRQ_RX_TX_TIMEOUT,
+                           IRQ_RADIO_ALL, //IRQ_RX_DONE | IRQ_RX_TX_TIMEOUT,
+                           IRQ_RADIO_NONE,
+                           IRQ_RADIO_NONE );
+
+    // Durations in steps of 15.625 us
+    RxDutyCycleRxTime = ( uint32_t )( ( ( uint64_t )rxTime << 6 ) / 1000 );
+    RxDutyCycleSleepTime = ( uint32_t )( ( ( uint64_t )sleepTime << 6 ) / 1000 );
+    SX126xSetRxDutyCycle( RxDutyCycleRxTime, RxDutyCycleSleepTime );
 }
 
 void RadioStartCad( void )
@@ -1205,6 +1382,31 @@ void RadioOnRxTimeoutIrq( void* context )
     }
 }
 
+void RadioOnCarrierSenseTimerIrq( void* context )
+{
+    CarrierSenseSampleFired = true;
+}
+
+static void RadioCarrierSenseSample( void )
+{
+    if( ( RadioCarrierSense.Running == false ) || ( RadioCarrierSense.Mode != RADIO_CARRIER_SENSE_RSSI ) )
+    {
+        return;
+    }
+    if( RadioRssi( MODEM_FSK ) > RadioCarrierSense.RssiThresh )
+    {
+        RadioCarrierSenseDone( false );
+    }
+    else if( TimerGetElapsedTime( RadioCarrierSense.StartTime ) >= RadioCarrierSense.MaxCarrierSenseTime )
+    {
+        RadioCarrierSenseDone( true );
+    }
+    else
+    {
+        TimerStart( &CarrierSenseTimer );
+    }
+}
+
 void RadioOnDioIrq( void* context )
 {
     IrqFired = true;
@@ -1212,6 +1414,16 @@ void RadioOnDioIrq( void* context )
 
 void RadioIrqProcess( void )
 {
+    if( CarrierSenseSampleFired == true )
+    {
+        CRITICAL_SECTION_BEGIN( );
+        // Clear carrier sense sample flag
+        CarrierSenseSampleFired = false;
+        CRITICAL_SECTION_END( );
+
+        RadioCarrierSenseSample( );
+    }
+
     if( IrqFired == true )
     {
         CRITICAL_SECTION_BEGIN( );
@@ -1237,7 +1449,7 @@ void RadioIrqProcess( void )
         {
             if( ( irqRegs & IRQ_CRC_ERROR ) == IRQ_CRC_ERROR )
             {
-                if( RxContinuous == false )
+                if( ( RxContinuous == false ) || ( SX126xGetOperatingMode( ) == MODE_RX_DC ) )
                 {
                     //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
                     SX126xSetOperatingMode( MODE_STDBY_RC );
@@ -1250,25 +1462,51 @@ void RadioIrqProcess( void )
             else
             {
                 uint8_t size;
-
-                TimerStop( &RxTimeoutTimer );
-                if( RxContinuous == false )
+                uint8_t offset;
+                uint8_t headerSize;
+
+                // Only the MAC header is read until the frame is accepted
+                SX126xGetRxBufferStatus( &size, &offset );
+                headerSize = MIN( size, RADIO_RX_FILTER_HEADER_SIZE );
+                SX126xReadBuffer( offset, RadioRxPayload, headerSize );
+                if( ( RxFixLen == false ) && ( RadioRxFilterCheck( RadioRxPayload, size ) == false ) )
                 {
-                    //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
-                    SX126xSetOperatingMode( MODE_STDBY_RC );
-
-                    // WORKAROUND - Implicit Header Mode Timeout Behavior, see DS_SX1261-2_V1.2 datasheet chapter 15.3
-                    // RegRtcControl = @address 0x0902
-                    SX126xWriteRegister( 0x0902, 0x00 );
-                    // RegEventMask = @address 0x0944
-                    SX126xWriteRegister( 0x0944, SX126xReadRegister( 0x0944 ) | ( 1 << 1 ) );
-                    // WORKAROUND END
+                    if( SX126xGetOperatingMode( ) == MODE_RX_DC )
+                    {
+                        SX126xSetRxDutyCycle( RxDutyCycleRxTime, RxDutyCycleSleepTime );
+                    }
+                    else if( RxContinuous == false )
+                    {
+                        TimerStop( &RxTimeoutTimer );
+                        //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
+                        SX126xSetOperatingMode( MODE_STDBY_RC );
+                        if( ( RadioEvents != NULL ) && ( RadioEvents->RxTimeout != NULL ) )
+                        {
+                            RadioEvents->RxTimeout( );
+                        }
+                    }
                 }
-                SX126xGetPayload( RadioRxPayload, &size , 255 );
-                SX126xGetPacketStatus( &RadioPktStatus );
-                if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
+                else
                 {
-                    RadioEvents->RxDone( RadioRxPayload, size, RadioPktStatus.Params.LoRa.RssiPkt, RadioPktStatus.Params.LoRa.SnrPkt );
+                    TimerStop( &RxTimeoutTimer );
+                    if( ( RxContinuous == false ) || ( SX126xGetOperatingMode( ) == MODE_RX_DC ) )
+                    {
+                        //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
+                        SX126xSetOperatingMode( MODE_STDBY_RC );
+
+                        // WORKAROUND - Implicit Header Mode Timeout Behavior, see DS_SX1261-2_V1.2 datasheet chapter 15.3
+                        // RegRtcControl = @address 0x0902
+                        SX126xWriteRegister( 0x0902, 0x00 );
+                        // RegEventMask = @address 0x0944
+                        SX126xWriteRegister( 0x0944, SX126xReadRegister( 0x0944 ) | ( 1 << 1 ) );
+                        // WORKAROUND END
+                    }
+                    SX126xReadBuffer( offset + headerSize, RadioRxPayload + headerSize, size - headerSize );
+                    SX126xGetPacketStatus( &RadioPktStatus );
+                    if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
+                    {
+                        RadioEvents->RxDone( RadioRxPayload, size, RadioPktStatus.Params.LoRa.RssiPkt, RadioPktStatus.Params.LoRa.SnrPkt );
+                    }
                 }
             }
         }
@@ -1277,7 +1515,22 @@ void RadioIrqProcess( void )
         {
             //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
             SX126xSetOperatingMode( MODE_STDBY_RC );
-            if( ( RadioEvents != NULL ) && ( RadioEvents->CadDone != NULL ) )
+            if( ( RadioCarrierSense.Running == true ) && ( RadioCarrierSense.Mode == RADIO_CARRIER_SENSE_CAD ) )
+            {
+                if( ( irqRegs & IRQ_CAD_ACTIVITY_DETECTED ) == IRQ_CAD_ACTIVITY_DETECTED )
+                {
+                    RadioCarrierSenseDone( false );
+                }
+                else if( TimerGetElapsedTime( RadioCarrierSense.StartTime ) >= RadioCarrierSense.MaxCarrierSenseTime )
+                {
+                    RadioCarrierSenseDone( true );
+                }
+                else
+                {
+                    RadioStartCad( );
+                }
+            }
+            else if( ( RadioEvents != NULL ) && ( RadioEvents->CadDone != NULL ) )
             {
                 RadioEvents->CadDone( ( ( irqRegs & IRQ_CAD_ACTIVITY_DETECTED ) == IRQ_CAD_ACTIVITY_DETECTED ) );
             }
@@ -1295,8 +1548,10 @@ void RadioIrqProcess( void )
                     RadioEvents->TxTimeout( );
                 }
             }
-            else if( SX126xGetOperatingMode( ) == MODE_RX )
+            else if( ( SX126xGetOperatingMode( ) == MODE_RX ) || ( SX126xGetOperatingMode( ) == MODE_RX_DC ) )
             {
+                // The reception duty cycle ends with a timeout when a detected
+                // preamble isn't followed by a frame
                 TimerStop( &RxTimeoutTimer );
                 //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
                 SX126xSetOperatingMode( MODE_STDBY_RC );
@@ -1325,7 +1580,7 @@ void RadioIrqProcess( void )
         if( ( irqRegs & IRQ_HEADER_ERROR ) == IRQ_HEADER_ERROR )
         {
             TimerStop( &RxTimeoutTimer );
-            if( RxContinuous == false )
+            if( ( RxContinuous == false ) || ( SX126xGetOperatingMode( ) == MODE_RX_DC ) )
             {
                 //!< Update operating mode state to a value lower than \ref MODE_STDBY_XOSC
                 SX126xSetOperatingMode( MODE_STDBY_RC );
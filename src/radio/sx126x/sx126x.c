@@ -57,6 +57,17 @@ volatile uint32_t FrequencyError = 0;
  */
 static bool ImageCalibrated = false;
 
+/*!
+ * \brief Indicates if a deferred command sequence is ongoing
+ */
+static bool CmdQueueActive = false;
+
+/*!
+ * \brief Callback to be called when the radio has completed the last command
+ *        of a deferred command sequence
+ */
+static SX126xCmdQueueDone_t CmdQueueDone = NULL;
+
 /*
  * SX126x DIO IRQ callback functions prototype
  */
@@ -81,6 +92,11 @@ void SX126xSetInterruptMode( void );
  */
 void SX126xProcessIrqs( void );
 
+/*!
+ * \brief BUSY pin falling edge IRQ callback
+ */
+static void SX126xOnBusyIrq( void* context );
+
 void SX126xInit( DioIrqHandler dioIrq )
 {
     SX126xReset( );
@@ -110,6 +126,56 @@ void SX126xCheckDeviceReady( void )
     SX126xWaitOnBusy( );
 }
 
+void SX126xCmdQueueBegin( void )
+{
+    CmdQueueActive = true;
+}
+
+void SX126xCmdQueueEnd( SX126xCmdQueueDone_t onDone )
+{
+    CmdQueueActive = false;
+
+    if( onDone == NULL )
+    {
+        SX126xWaitOnBusy( );
+        return;
+    }
+
+    CRITICAL_SECTION_BEGIN( );
+    CmdQueueDone = onDone;
+    SX126xIoBusyIrqInit( SX126xOnBusyIrq );
+    if( GpioRead( &SX126x.BUSY ) == 1 )
+    {
+        // Completion is notified by the BUSY pin falling edge
+        CRITICAL_SECTION_END( );
+        return;
+    }
+    // The radio has already processed the whole sequence
+    SX126xIoBusyIrqInit( NULL );
+    CmdQueueDone = NULL;
+    CRITICAL_SECTION_END( );
+
+    onDone( );
+}
+
+bool SX126xCmdQueueIsActive( void )
+{
+    return CmdQueueActive;
+}
+
+static void SX126xOnBusyIrq( void* context )
+{
+    SX126xCmdQueueDone_t onDone = CmdQueueDone;
+
+    SX126xIoBusyIrqInit( NULL );
+    CmdQueueDone = NULL;
+
+    if( onDone != NULL )
+    {
+        onDone( );
+    }
+}
+
 void SX126xSetPayload( uint8_t *payload, uint8_t size )
 {
     SX126xWriteBuffer( 0x00, payload, size );
@@ -692,6 +692,11 @@ typedef struct SX126x_s
  */
 typedef void ( DioIrqHandler )( void* context );
 
+/*!
+ * \brief Command sequence completion callback prototype.
+ */
+typedef void ( *SX126xCmdQueueDone_t )( void );
+
 /*!
  * SX126x definitions
  */
@@ -862,8 +867,8 @@ void SX126xSetRxBoosted( uint32_t timeout );
 /*!
  * \brief Sets the Rx duty cycle management parameters
  *
- * \param [in]  rxTime        Structure describing reception timeout value
- * \param [in]  sleepTime     Structure describing sleep timeout value
+ * \param [in]  rxTime        Reception window duration [15.625 us steps]
+ * \param [in]  sleepTime     Sleep period duration [15.625 us steps]
  */
 void SX126xSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime );
 
@@ -1127,6 +1132,37 @@ void SX126xClearDeviceErrors( void );
  */
 void SX126xClearIrqStatus( uint16_t irq );
 
+/*!
+ * \brief Starts a deferred command sequence (command queue mode)
+ *
+ * \remark While the sequence is active the write primitives don't wait for
+ *         the BUSY pin to go low after releasing NSS. BUSY is only checked by
+ *         \ref SX126xCheckDeviceReady right before the next NSS assertion, so
+ *         the MCU prepares the next command while the radio still processes
+ *         the previous one.
+ */
+void SX126xCmdQueueBegin( void );
+
+/*!
+ * \brief Ends a deferred command sequence
+ *
+ * \param [in]  onDone        Callback to be called once the radio has
+ *                            processed the last command of the sequence.
+ *                            When NULL the function blocks until BUSY is low.
+ *
+ * \remark When a callback is given it is either called from the BUSY pin
+ *         falling edge interrupt or directly from this function if the radio
+ *         is already ready.
+ */
+void SX126xCmdQueueEnd( SX126xCmdQueueDone_t onDone );
+
+/*!
+ * \brief Checks if a deferred command sequence is ongoing
+ *
+ * \retval isActive [true: BUSY wait is deferred, false: BUSY wait after each command]
+ */
+bool SX126xCmdQueueIsActive( void );
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,7 +24,9 @@
 #include <string.h>
 #include "utilities.h"
 #include "timer.h"
+#include "tracepoint.h"
 #include "radio.h"
+#include "radio-filter.h"
 #include "delay.h"
 #include "sx1272.h"
 #include "sx1272-board.h"
@@ -80,6 +82,29 @@ static void SX1272WriteFifo( uint8_t *buffer, uint8_t size );
  */
 static void SX1272ReadFifo( uint8_t *buffer, uint8_t size );
 
+/*!
+ * \brief Moves FSK packet bytes between the packet buffer and the FIFO, from
+ *        the current packet position
+ *
+ * \param [IN] size Number of bytes, SX1272_FIFO_SIZE max
+ * \param [IN] isTx [true: packet buffer to FIFO, false: FIFO to packet buffer]
+ */
+static void SX1272FskFifoTransfer( uint16_t size, bool isTx );
+
+/*!
+ * \brief Sets the FSK payload length register, 11 bits
+ *
+ * \param [IN] size Payload length
+ */
+static void SX1272SetFskPayloadLength( uint16_t size );
+
+/*!
+ * \brief Gets the FSK payload length register, 11 bits
+ *
+ * \retval size Payload length
+ */
+static uint16_t SX1272GetFskPayloadLength( void );
+
 /*!
  * \brief Sets the SX1272 operating mode
  *
@@ -175,6 +200,24 @@ static void SX1272OnDio4Irq( void* context );
  */
 static void SX1272OnTimeoutIrq( void* context );
 
+/*!
+ * \brief Carrier sense sampling timer callback
+ */
+static void SX1272OnCarrierSenseTimerIrq( void* context );
+
+/*!
+ * \brief Takes one carrier sense RSSI sample, then ends or reschedules the
+ *        procedure
+ */
+static void SX1272CarrierSenseSample( void );
+
+/*!
+ * \brief Ends the carrier sense procedure and notifies the upper layer
+ *
+ * \param [IN] channelIsFree Carrier sense result
+ */
+static void SX1272CarrierSenseDone( bool channelIsFree );
+
 /*
  * Private global constants
  */
@@ -229,11 +272,52 @@ const FskBandwidth_t FskBandwidths[] =
  */
 static RadioEvents_t *RadioEvents;
 
+/*!
+ * Carrier sense RSSI sampling period [ms]
+ */
+#define RADIO_CARRIER_SENSE_SAMPLING_PERIOD         1
+
+/*!
+ * Holds the state of the non-blocking carrier sense procedure
+ */
+typedef struct
+{
+    bool                     Running;
+    RadioCarrierSenseModes_t Mode;
+    int16_t                  RssiThresh;
+    uint32_t                 MaxCarrierSenseTime;
+    TimerTime_t              StartTime;
+}RadioCarrierSense_t;
+
+static RadioCarrierSense_t RadioCarrierSense = { .Running = false };
+
+/*!
+ * Set by the carrier sense sampling timer. The RSSI is read over SPI by
+ * SX1272IrqProcess, out of the timer interrupt.
+ */
+static bool CarrierSenseSampleFired = false;
+
 /*!
  * Reception buffer
  */
 static uint8_t RxTxBuffer[RX_BUFFER_SIZE];
 
+/*!
+ * FSK packet buffer of SX1272Send and of the receptions outside of the
+ * streaming mode
+ */
+static SX1272FskStream_t FskBuffer = { .Buffer = RxTxBuffer, .Size = RX_BUFFER_SIZE, .GetChunk = NULL };
+
+/*!
+ * FSK streaming mode packet buffer. Size is 0 when the mode is disabled.
+ */
+static SX1272FskStream_t FskStream = { .Buffer = NULL, .Size = 0, .GetChunk = NULL };
+
+/*!
+ * FSK packet buffer of the ongoing transmission or reception
+ */
+static SX1272FskStream_t *FskPacket = &FskBuffer;
+
 /*
  * Public global variables
  */
@@ -257,6 +341,11 @@ TimerEvent_t TxTimeoutTimer;
 TimerEvent_t RxTimeoutTimer;
 TimerEvent_t RxTimeoutSyncWord;
 
+/*!
+ * Carrier sense RSSI sampling timer
+ */
+TimerEvent_t CarrierSenseTimer;
+
 /*
  * Radio driver functions implementation
  */
@@ -271,6 +360,8 @@ void SX1272Init( RadioEvents_t *events )
     TimerInit( &TxTimeoutTimer, SX1272OnTimeoutIrq );
     TimerInit( &RxTimeoutTimer, SX1272OnTimeoutIrq );
     TimerInit( &RxTimeoutSyncWord, SX1272OnTimeoutIrq );
+    TimerInit( &CarrierSenseTimer, SX1272OnCarrierSenseTimerIrq );
+    CarrierSenseSampleFired = false;
 
     SX1272Reset( );
 
@@ -339,6 +430,55 @@ bool SX1272IsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThres
     return status;
 }
 
+void SX1272StartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+{
+    RadioCarrierSense.Running = true;
+    RadioCarrierSense.Mode = mode;
+    RadioCarrierSense.RssiThresh = rssiThresh;
+    RadioCarrierSense.MaxCarrierSenseTime = maxCarrierSenseTime;
+
+    if( mode == RADIO_CARRIER_SENSE_CAD )
+    {
+        // The LoRa modem and modulation are setup by the caller through
+        // SX1272SetRxConfig, CAD has no other parameter on this radio
+        SX1272SetModem( MODEM_LORA );
+        SX1272SetChannel( freq );
+        RadioCarrierSense.StartTime = TimerGetCurrentTime( );
+        SX1272StartCad( );
+        return;
+    }
+
+    SX1272SetSleep( );
+
+    SX1272SetModem( MODEM_FSK );
+
+    SX1272SetChannel( freq );
+
+    SX1272Write( REG_RXBW, GetFskBandwidthRegValue( rxBandwidth ) );
+    SX1272Write( REG_AFCBW, GetFskBandwidthRegValue( rxBandwidth ) );
+
+    SX1272SetOpMode( RF_OPMODE_RECEIVER );
+    SX1272.Settings.State = RF_RX_RUNNING;
+
+    // First sample is taken once the RSSI is settled
+    RadioCarrierSense.MaxCarrierSenseTime += RADIO_CARRIER_SENSE_SAMPLING_PERIOD;
+    RadioCarrierSense.StartTime = TimerGetCurrentTime( );
+    TimerSetValue( &CarrierSenseTimer, RADIO_CARRIER_SENSE_SAMPLING_PERIOD );
+    TimerStart( &CarrierSenseTimer );
+}
+
+static void SX1272CarrierSenseDone( bool channelIsFree )
+{
+    TimerStop( &CarrierSenseTimer );
+    RadioCarrierSense.Running = false;
+    SX1272SetSleep( );
+
+    if( ( RadioEvents != NULL ) && ( RadioEvents->ChannelFreeDone != NULL ) )
+    {
+        RadioEvents->ChannelFreeDone( channelIsFree );
+    }
+}
+
 uint32_t SX1272Random( void )
 {
     uint8_t i;
@@ -412,11 +552,11 @@ void SX1272SetRxConfig( RadioModems_t modem, uint32_t bandwidth,
 
             if( fixLen == 1 )
             {
-                SX1272Write( REG_PAYLOADLENGTH, payloadLen );
+                SX1272SetFskPayloadLength( payloadLen );
             }
             else
             {
-                SX1272Write( REG_PAYLOADLENGTH, 0xFF ); // Set payload length to the maximum
+                SX1272SetFskPayloadLength( 0xFF ); // Set payload length to the maximum
             }
 
             SX1272Write( REG_PACKETCONFIG1,
@@ -651,6 +791,8 @@ uint32_t SX1272GetTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
     uint32_t numerator = 0;
     uint32_t denominator = 1;
 
+    TRACE_POINT_BEGIN( TRACE_POINT_TIME_ON_AIR );
+
     switch( modem )
     {
     case MODEM_FSK:
@@ -668,7 +810,10 @@ uint32_t SX1272GetTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
         break;
     }
     // Perform integral ceil()
-    return ( numerator + denominator - 1 ) / denominator;
+    uint32_t timeOnAir = ( numerator + denominator - 1 ) / denominator;
+
+    TRACE_POINT_END( TRACE_POINT_TIME_ON_AIR );
+    return timeOnAir;
 }
 
 void SX1272Send( uint8_t *buffer, uint8_t size )
@@ -679,6 +824,7 @@ void SX1272Send( uint8_t *buffer, uint8_t size )
     {
     case MODEM_FSK:
         {
+            FskPacket = &FskBuffer;
             SX1272.Settings.FskPacketHandler.NbBytes = 0;
             SX1272.Settings.FskPacketHandler.Size = size;
 
@@ -688,7 +834,7 @@ void SX1272Send( uint8_t *buffer, uint8_t size )
             }
             else
             {
-                SX1272Write( REG_PAYLOADLENGTH, size );
+                SX1272SetFskPayloadLength( size );
             }
 
             if( ( size > 0 ) && ( size <= 64 ) )
@@ -745,6 +891,52 @@ void SX1272Send( uint8_t *buffer, uint8_t size )
     SX1272SetTx( txTimeout );
 }
 
+void SX1272SetFskStream( const SX1272FskStream_t *stream )
+{
+    if( ( stream == NULL ) || ( stream->Size == 0 ) || ( stream->Size > SX1272_FSK_STREAM_MAX_SIZE ) ||
+        ( ( stream->Buffer == NULL ) && ( stream->GetChunk == NULL ) ) )
+    {
+        FskStream.Size = 0;
+        return;
+    }
+    FskStream = *stream;
+}
+
+void SX1272SendStream( uint16_t size )
+{
+    uint8_t lengthSize = 0;
+
+    if( ( SX1272.Settings.Modem != MODEM_FSK ) || ( FskStream.Size == 0 ) || ( size == 0 ) ||
+        ( size > SX1272_FSK_STREAM_MAX_SIZE ) ||
+        ( ( SX1272.Settings.Fsk.FixLen == false ) && ( size > UINT8_MAX ) ) ||
+        ( ( FskStream.GetChunk == NULL ) && ( size > FskStream.Size ) ) )
+    {
+        return;
+    }
+
+    FskPacket = &FskStream;
+    SX1272.Settings.FskPacketHandler.NbBytes = 0;
+    SX1272.Settings.FskPacketHandler.Size = size;
+
+    if( SX1272.Settings.Fsk.FixLen == false )
+    {
+        uint8_t length = size;
+
+        SX1272WriteFifo( &length, 1 );
+        lengthSize = 1;
+    }
+    else
+    {
+        SX1272SetFskPayloadLength( size );
+    }
+
+    // The FifoEmpty interrupt refills the whole FIFO
+    SX1272.Settings.FskPacketHandler.ChunkSize = SX1272_FIFO_SIZE;
+    SX1272FskFifoTransfer( MIN( size, SX1272_FIFO_SIZE - lengthSize ), true );
+
+    SX1272SetTx( SX1272.Settings.Fsk.TxTimeout );
+}
+
 void SX1272SetSleep( void )
 {
     TimerStop( &RxTimeoutTimer );
@@ -798,6 +990,15 @@ void SX1272SetRx( uint32_t timeout )
                                                                             RF_DIOMAPPING2_DIO4_11 |
                                                                             RF_DIOMAPPING2_MAP_PREAMBLEDETECT );
 
+            FskPacket = ( FskStream.Size != 0 ) ? &FskStream : &FskBuffer;
+            if( SX1272.Settings.Fsk.FixLen == true )
+            {
+                SX1272SetFskPayloadLength( ( FskStream.Size != 0 ) ? FskStream.Size : SX1272.Settings.Fsk.PayloadLen );
+            }
+
+            // Larger FIFO offloads in streaming mode
+            SX1272Write( REG_FIFOTHRESH, ( SX1272Read( REG_FIFOTHRESH ) & RF_FIFOTHRESH_FIFOTHRESHOLD_MASK ) |
+                                         ( ( FskStream.Size != 0 ) ? SX1272_FSK_STREAM_FIFO_THRESH : RF_FIFOTHRESH_FIFOTHRESHOLD_THRESHOLD ) );
             SX1272.Settings.FskPacketHandler.FifoThresh = SX1272Read( REG_FIFOTHRESH ) & 0x3F;
 
             SX1272Write( REG_RXCONFIG, RF_RXCONFIG_AFCAUTO_ON | RF_RXCONFIG_AGCAUTO_ON | RF_RXCONFIG_RXTRIGER_PREAMBLEDETECT );
@@ -1154,6 +1355,64 @@ static void SX1272ReadFifo( uint8_t *buffer, uint8_t size )
     SX1272ReadBuffer( 0, buffer, size );
 }
 
+static void SX1272FskFifoTransfer( uint16_t size, bool isTx )
+{
+    uint8_t discard[16];
+
+    while( size > 0 )
+    {
+        uint16_t offset = SX1272.Settings.FskPacketHandler.NbBytes;
+        uint16_t chunkSize = size;
+        uint8_t *chunk = NULL;
+
+        if( FskPacket->GetChunk != NULL )
+        {
+            chunk = FskPacket->GetChunk( offset, &chunkSize );
+            chunkSize = MIN( chunkSize, size );
+        }
+        else if( offset < FskPacket->Size )
+        {
+            chunk = FskPacket->Buffer + offset;
+            chunkSize = MIN( chunkSize, FskPacket->Size - offset );
+        }
+
+        if( ( chunk == NULL ) || ( chunkSize == 0 ) )
+        {
+            if( isTx == true )
+            {
+                return;
+            }
+            // No room for the received bytes
+            chunk = discard;
+            chunkSize = MIN( size, sizeof( discard ) );
+        }
+
+        if( isTx == true )
+        {
+            SX1272WriteFifo( chunk, chunkSize );
+        }
+        else
+        {
+            SX1272ReadFifo( chunk, chunkSize );
+        }
+        SX1272.Settings.FskPacketHandler.NbBytes += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+static void SX1272SetFskPayloadLength( uint16_t size )
+{
+    SX1272Write( REG_PACKETCONFIG2, ( SX1272Read( REG_PACKETCONFIG2 ) & RF_PACKETCONFIG2_PAYLOADLENGTH_MSB_MASK ) |
+                                    ( ( size >> 8 ) & ~RF_PACKETCONFIG2_PAYLOADLENGTH_MSB_MASK ) );
+    SX1272Write( REG_PAYLOADLENGTH, ( uint8_t )size );
+}
+
+static uint16_t SX1272GetFskPayloadLength( void )
+{
+    return ( ( uint16_t )( SX1272Read( REG_PACKETCONFIG2 ) & ~RF_PACKETCONFIG2_PAYLOADLENGTH_MSB_MASK ) << 8 ) |
+           SX1272Read( REG_PAYLOADLENGTH );
+}
+
 void SX1272SetMaxPayloadLength( RadioModems_t modem, uint8_t max )
 {
     SX1272SetModem( modem );
@@ -1163,7 +1422,7 @@ void SX1272SetMaxPayloadLength( RadioModems_t modem, uint8_t max )
     case MODEM_FSK:
         if( SX1272.Settings.Fsk.FixLen == false )
         {
-            SX1272Write( REG_PAYLOADLENGTH, max );
+            SX1272SetFskPayloadLength( max );
         }
         break;
     case MODEM_LORA:
@@ -1308,6 +1567,44 @@ static uint32_t SX1272GetLoRaTimeOnAirNumerator( uint32_t bandwidth,
     return ( uint32_t )( ( 4 * intermediate + 1 ) * ( 1 << ( datarate - 2 ) ) );
 }
 
+static void SX1272OnCarrierSenseTimerIrq( void* context )
+{
+    CarrierSenseSampleFired = true;
+}
+
+void SX1272IrqProcess( void )
+{
+    if( CarrierSenseSampleFired == true )
+    {
+        CRITICAL_SECTION_BEGIN( );
+        // Clear carrier sense sample flag
+        CarrierSenseSampleFired = false;
+        CRITICAL_SECTION_END( );
+
+        SX1272CarrierSenseSample( );
+    }
+}
+
+static void SX1272CarrierSenseSample( void )
+{
+    if( ( RadioCarrierSense.Running == false ) || ( RadioCarrierSense.Mode != RADIO_CARRIER_SENSE_RSSI ) )
+    {
+        return;
+    }
+    if( SX1272ReadRssi( MODEM_FSK ) > RadioCarrierSense.RssiThresh )
+    {
+        SX1272CarrierSenseDone( false );
+    }
+    else if( TimerGetElapsedTime( RadioCarrierSense.StartTime ) >= RadioCarrierSense.MaxCarrierSenseTime )
+    {
+        SX1272CarrierSenseDone( true );
+    }
+    else
+    {
+        TimerStart( &CarrierSenseTimer );
+    }
+}
+
 static void SX1272OnTimeoutIrq( void* context )
 {
     switch( SX1272.Settings.State )
@@ -1438,16 +1735,10 @@ static void SX1272OnDio0Irq( void* context )
                     }
                     else
                     {
-                        SX1272.Settings.FskPacketHandler.Size = SX1272Read( REG_PAYLOADLENGTH );
+                        SX1272.Settings.FskPacketHandler.Size = SX1272GetFskPayloadLength( );
                     }
-                    SX1272ReadFifo( RxTxBuffer + SX1272.Settings.FskPacketHandler.NbBytes, SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
-                    SX1272.Settings.FskPacketHandler.NbBytes += ( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
-                }
-                else
-                {
-                    SX1272ReadFifo( RxTxBuffer + SX1272.Settings.FskPacketHandler.NbBytes, SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
-                    SX1272.Settings.FskPacketHandler.NbBytes += ( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
                 }
+                SX1272FskFifoTransfer( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes, false );
 
                 TimerStop( &RxTimeoutTimer );
 
@@ -1464,7 +1755,7 @@ static void SX1272OnDio0Irq( void* context )
 
                 if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
                 {
-                    RadioEvents->RxDone( RxTxBuffer, SX1272.Settings.FskPacketHandler.Size, SX1272.Settings.FskPacketHandler.RssiValue, 0 );
+                    RadioEvents->RxDone( FskPacket->Buffer, SX1272.Settings.FskPacketHandler.Size, SX1272.Settings.FskPacketHandler.RssiValue, 0 );
                 }
                 SX1272.Settings.FskPacketHandler.PreambleDetected = false;
                 SX1272.Settings.FskPacketHandler.SyncWordDetected = false;
@@ -1473,6 +1764,8 @@ static void SX1272OnDio0Irq( void* context )
                 break;
             case MODEM_LORA:
                 {
+                    uint8_t headerSize;
+
                     // Clear Irq
                     SX1272Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_RXDONE );
 
@@ -1495,6 +1788,27 @@ static void SX1272OnDio0Irq( void* context )
                         break;
                     }
 
+                    // Only the MAC header is read until the frame is accepted
+                    SX1272.Settings.LoRaPacketHandler.Size = SX1272Read( REG_LR_RXNBBYTES );
+                    SX1272Write( REG_LR_FIFOADDRPTR, SX1272Read( REG_LR_FIFORXCURRENTADDR ) );
+                    headerSize = MIN( SX1272.Settings.LoRaPacketHandler.Size, RADIO_RX_FILTER_HEADER_SIZE );
+                    SX1272ReadFifo( RxTxBuffer, headerSize );
+                    if( ( SX1272.Settings.LoRa.FixLen == false ) &&
+                        ( RadioRxFilterCheck( RxTxBuffer, SX1272.Settings.LoRaPacketHandler.Size ) == false ) )
+                    {
+                        if( SX1272.Settings.LoRa.RxContinuous == false )
+                        {
+                            SX1272.Settings.State = RF_IDLE;
+                            TimerStop( &RxTimeoutTimer );
+
+                            if( ( RadioEvents != NULL ) && ( RadioEvents->RxTimeout != NULL ) )
+                            {
+                                RadioEvents->RxTimeout( );
+                            }
+                        }
+                        break;
+                    }
+
                     // Returns SNR value [dB] rounded to the nearest integer value
                     SX1272.Settings.LoRaPacketHandler.SnrValue = ( ( ( int8_t )SX1272Read( REG_LR_PKTSNRVALUE ) ) + 2 ) >> 2;
 
@@ -1509,9 +1823,7 @@ static void SX1272OnDio0Irq( void* context )
                         SX1272.Settings.LoRaPacketHandler.RssiValue = RSSI_OFFSET + rssi + ( rssi >> 4 );
                     }
 
-                    SX1272.Settings.LoRaPacketHandler.Size = SX1272Read( REG_LR_RXNBBYTES );
-                    SX1272Write( REG_LR_FIFOADDRPTR, SX1272Read( REG_LR_FIFORXCURRENTADDR ) );
-                    SX1272ReadFifo( RxTxBuffer, SX1272.Settings.LoRaPacketHandler.Size );
+                    SX1272ReadFifo( RxTxBuffer + headerSize, SX1272.Settings.LoRaPacketHandler.Size - headerSize );
 
                     if( SX1272.Settings.LoRa.RxContinuous == false )
                     {
@@ -1574,7 +1886,7 @@ static void SX1272OnDio1Irq( void* context )
                     }
                     else
                     {
-                        SX1272.Settings.FskPacketHandler.Size = SX1272Read( REG_PAYLOADLENGTH );
+                        SX1272.Settings.FskPacketHandler.Size = SX1272GetFskPayloadLength( );
                     }
                 }
                 // ERRATA 3.1 - PayloadReady Set for 31.25ns if FIFO is Empty
@@ -1586,13 +1898,11 @@ static void SX1272OnDio1Irq( void* context )
                 //              when FifoLevel fires
                 if( ( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes ) >= SX1272.Settings.FskPacketHandler.FifoThresh )
                 {
-                    SX1272ReadFifo( ( RxTxBuffer + SX1272.Settings.FskPacketHandler.NbBytes ), SX1272.Settings.FskPacketHandler.FifoThresh - 1 );
-                    SX1272.Settings.FskPacketHandler.NbBytes += SX1272.Settings.FskPacketHandler.FifoThresh - 1;
+                    SX1272FskFifoTransfer( SX1272.Settings.FskPacketHandler.FifoThresh - 1, false );
                 }
                 else
                 {
-                    SX1272ReadFifo( ( RxTxBuffer + SX1272.Settings.FskPacketHandler.NbBytes ), SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
-                    SX1272.Settings.FskPacketHandler.NbBytes += ( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
+                    SX1272FskFifoTransfer( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes, false );
                 }
                 break;
             case MODEM_LORA:
@@ -1618,14 +1928,12 @@ static void SX1272OnDio1Irq( void* context )
                 // FifoEmpty interrupt
                 if( ( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes ) > SX1272.Settings.FskPacketHandler.ChunkSize )
                 {
-                    SX1272WriteFifo( ( RxTxBuffer + SX1272.Settings.FskPacketHandler.NbBytes ), SX1272.Settings.FskPacketHandler.ChunkSize );
-                    SX1272.Settings.FskPacketHandler.NbBytes += SX1272.Settings.FskPacketHandler.ChunkSize;
+                    SX1272FskFifoTransfer( SX1272.Settings.FskPacketHandler.ChunkSize, true );
                 }
                 else
                 {
                     // Write the last chunk of data
-                    SX1272WriteFifo( RxTxBuffer + SX1272.Settings.FskPacketHandler.NbBytes, SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes );
-                    SX1272.Settings.FskPacketHandler.NbBytes += SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes;
+                    SX1272FskFifoTransfer( SX1272.Settings.FskPacketHandler.Size - SX1272.Settings.FskPacketHandler.NbBytes, true );
                 }
                 break;
             case MODEM_LORA:
@@ -1716,7 +2024,29 @@ static void SX1272OnDio3Irq( void* context )
     case MODEM_FSK:
         break;
     case MODEM_LORA:
-        if( ( SX1272Read( REG_LR_IRQFLAGS ) & RFLR_IRQFLAGS_CADDETECTED ) == RFLR_IRQFLAGS_CADDETECTED )
+        if( ( RadioCarrierSense.Running == true ) && ( RadioCarrierSense.Mode == RADIO_CARRIER_SENSE_CAD ) )
+        {
+            if( ( SX1272Read( REG_LR_IRQFLAGS ) & RFLR_IRQFLAGS_CADDETECTED ) == RFLR_IRQFLAGS_CADDETECTED )
+            {
+                // Clear Irq
+                SX1272Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_CADDETECTED | RFLR_IRQFLAGS_CADDONE );
+                SX1272CarrierSenseDone( false );
+            }
+            else
+            {
+                // Clear Irq
+                SX1272Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_CADDONE );
+                if( TimerGetElapsedTime( RadioCarrierSense.StartTime ) >= RadioCarrierSense.MaxCarrierSenseTime )
+                {
+                    SX1272CarrierSenseDone( true );
+                }
+                else
+                {
+                    SX1272StartCad( );
+                }
+            }
+        }
+        else if( ( SX1272Read( REG_LR_IRQFLAGS ) & RFLR_IRQFLAGS_CADDETECTED ) == RFLR_IRQFLAGS_CADDETECTED )
         {
             // Clear Irq
             SX1272Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_CADDETECTED | RFLR_IRQFLAGS_CADDONE );
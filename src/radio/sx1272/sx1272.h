@@ -162,6 +162,60 @@ typedef void ( DioIrqHandler )( void* context );
 
 #define RX_BUFFER_SIZE                              256
 
+/*!
+ * FIFO size in bytes
+ */
+#define SX1272_FIFO_SIZE                            64
+
+/*!
+ * Maximum packet size of the FSK streaming mode, fixed length packet format
+ */
+#define SX1272_FSK_STREAM_MAX_SIZE                  2047
+
+/*!
+ * FIFO threshold of the FSK streaming mode. The FifoLevel interrupt offloads
+ * ( SX1272_FSK_STREAM_FIFO_THRESH - 1 ) bytes at once and leaves
+ * ( SX1272_FIFO_SIZE - SX1272_FSK_STREAM_FIFO_THRESH ) bytes of margin for the
+ * interrupt latency.
+ */
+#ifndef SX1272_FSK_STREAM_FIFO_THRESH
+#define SX1272_FSK_STREAM_FIFO_THRESH               48
+#endif
+
+/*!
+ * \brief FSK streaming mode chunk callback. Called from the DIO interrupts
+ *        each time the FIFO is serviced.
+ *
+ * \param [IN]     offset Offset of the chunk in the packet
+ * \param [IN/OUT] size   Number of bytes the driver moves. May be reduced to
+ *                        the number of contiguous bytes at the returned address.
+ *
+ * \retval chunk Bytes to be sent or where to store the received ones. NULL
+ *               discards the received bytes and stops the transmission
+ *               refills, the transmission then ends with a TX timeout.
+ */
+typedef uint8_t* ( *SX1272FskStreamChunk_t )( uint16_t offset, uint16_t *size );
+
+/*!
+ * FSK streaming mode packet buffer
+ */
+typedef struct
+{
+    /*!
+     * Caller owned packet buffer. Used when GetChunk is NULL.
+     */
+    uint8_t                *Buffer;
+    /*!
+     * Buffer size. Size of the received packets in fixed length packet
+     * format. [1: SX1272_FSK_STREAM_MAX_SIZE]
+     */
+    uint16_t               Size;
+    /*!
+     * Chunk callback, replaces Buffer when not NULL
+     */
+    SX1272FskStreamChunk_t GetChunk;
+}SX1272FskStream_t;
+
 /*!
  * ============================================================================
  * Public functions prototypes
@@ -210,6 +264,19 @@ void SX1272SetChannel( uint32_t freq );
  */
 bool SX1272IsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime );
 
+/*!
+ * \brief Starts a non-blocking carrier sense on the given channel
+ *
+ * \remark The result is notified through the RadioEvents_t.ChannelFreeDone callback.
+ *
+ * \param [IN] freq                Channel RF frequency in Hertz
+ * \param [IN] rxBandwidth         Rx bandwidth in Hertz
+ * \param [IN] rssiThresh          RSSI threshold in dBm
+ * \param [IN] maxCarrierSenseTime Max time in milliseconds while the channel is sensed
+ * \param [IN] mode                Carrier sense mode [RADIO_CARRIER_SENSE_RSSI, RADIO_CARRIER_SENSE_CAD]
+ */
+void SX1272StartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode );
+
 /*!
  * \brief Generates a 32 bits random value based on the RSSI readings
  *
@@ -222,6 +289,14 @@ bool SX1272IsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThres
  */
 uint32_t SX1272Random( void );
 
+/*!
+ * \brief Process the radio events deferred out of the interrupts, the
+ *        carrier sense RSSI sampling
+ *
+ * \remark Must be called from the application main loop.
+ */
+void SX1272IrqProcess( void );
+
 /*!
  * \brief Sets the reception parameters
  *
@@ -350,6 +425,34 @@ uint32_t SX1272GetTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
  */
 void SX1272Send( uint8_t *buffer, uint8_t size );
 
+/*!
+ * \brief Enables the FSK streaming mode. The packets are moved between the
+ *        FIFO and the caller buffer or chunk callback without any copy, up to
+ *        SX1272_FSK_STREAM_MAX_SIZE bytes with the fixed length packet
+ *        format and 255 bytes with the variable length one.
+ *
+ * \remark Must be called while the radio is idle. Applies to the receptions
+ *         started by SX1272SetRx and the transmissions started by
+ *         SX1272SendStream. The RxDone payload is the stream Buffer, NULL
+ *         with a chunk callback. The TX timeout set by SX1272SetTxConfig
+ *         must cover the time on air of the largest packet.
+ *
+ * \param [IN] stream Packet buffer, copied by the driver. NULL disables the
+ *                    streaming mode.
+ */
+void SX1272SetFskStream( const SX1272FskStream_t *stream );
+
+/*!
+ * \brief Sends a packet of the FSK streaming mode. The packet is read from the
+ *        stream buffer or chunk callback while it is transmitted.
+ *
+ * \remark Ignored when the streaming mode is disabled or size exceeds the
+ *         limits of the packet format or the stream buffer
+ *
+ * \param [IN]: size       Packet size
+ */
+void SX1272SendStream( uint16_t size );
+
 /*!
  * \brief Sets the radio in sleep mode
  */
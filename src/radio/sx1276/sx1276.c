@@ -26,7 +26,9 @@
 #include <string.h>
 #include "utilities.h"
 #include "timer.h"
+#include "tracepoint.h"
 #include "radio.h"
+#include "radio-filter.h"
 #include "delay.h"
 #include "sx1276.h"
 #include "sx1276-board.h"
@@ -88,6 +90,29 @@ static void SX1276WriteFifo( uint8_t *buffer, uint8_t size );
  */
 static void SX1276ReadFifo( uint8_t *buffer, uint8_t size );
 
+/*!
+ * \brief Moves FSK packet bytes between the packet buffer and the FIFO, from
+ *        the current packet position
+ *
+ * \param [IN] size Number of bytes, SX1276_FIFO_SIZE max
+ * \param [IN] isTx [true: packet buffer to FIFO, false: FIFO to packet buffer]
+ */
+static void SX1276FskFifoTransfer( uint16_t size, bool isTx );
+
+/*!
+ * \brief Sets the FSK payload length register, 11 bits
+ *
+ * \param [IN] size Payload length
+ */
+static void SX1276SetFskPayloadLength( uint16_t size );
+
+/*!
+ * \brief Gets the FSK payload length register, 11 bits
+ *
+ * \retval size Payload length
+ */
+static uint16_t SX1276GetFskPayloadLength( void );
+
 /*!
  * \brief Sets the SX1276 operating mode
  *
@@ -183,6 +208,24 @@ static void SX1276OnDio4Irq( void* context );
  */
 static void SX1276OnTimeoutIrq( void* context );
 
+/*!
+ * \brief Carrier sense sampling timer callback
+ */
+static void SX1276OnCarrierSenseTimerIrq( void* context );
+
+/*!
+ * \brief Takes one carrier sense RSSI sample, then ends or reschedules the
+ *        procedure
+ */
+static void SX1276CarrierSenseSample( void );
+
+/*!
+ * \brief Ends the carrier sense procedure and notifies the upper layer
+ *
+ * \param [IN] channelIsFree Carrier sense result
+ */
+static void SX1276CarrierSenseDone( bool channelIsFree );
+
 /*
  * Private global constants
  */
@@ -238,11 +281,52 @@ const FskBandwidth_t FskBandwidths[] =
  */
 static RadioEvents_t *RadioEvents;
 
+/*!
+ * Carrier sense RSSI sampling period [ms]
+ */
+#define RADIO_CARRIER_SENSE_SAMPLING_PERIOD         1
+
+/*!
+ * Holds the state of the non-blocking carrier sense procedure
+ */
+typedef struct
+{
+    bool                     Running;
+    RadioCarrierSenseModes_t Mode;
+    int16_t                  RssiThresh;
+    uint32_t                 MaxCarrierSenseTime;
+    TimerTime_t              StartTime;
+}RadioCarrierSense_t;
+
+static RadioCarrierSense_t RadioCarrierSense = { .Running = false };
+
+/*!
+ * Set by the carrier sense sampling timer. The RSSI is read over SPI by
+ * SX1276IrqProcess, out of the timer interrupt.
+ */
+static bool CarrierSenseSampleFired = false;
+
 /*!
  * Reception buffer
  */
 static uint8_t RxTxBuffer[RX_BUFFER_SIZE];
 
+/*!
+ * FSK packet buffer of SX1276Send and of the receptions outside of the
+ * streaming mode
+ */
+static SX1276FskStream_t FskBuffer = { .Buffer = RxTxBuffer, .Size = RX_BUFFER_SIZE, .GetChunk = NULL };
+
+/*!
+ * FSK streaming mode packet buffer. Size is 0 when the mode is disabled.
+ */
+static SX1276FskStream_t FskStream = { .Buffer = NULL, .Size = 0, .GetChunk = NULL };
+
+/*!
+ * FSK packet buffer of the ongoing transmission or reception
+ */
+static SX1276FskStream_t *FskPacket = &FskBuffer;
+
 /*
  * Public global variables
  */
@@ -266,6 +350,11 @@ TimerEvent_t TxTimeoutTimer;
 TimerEvent_t RxTimeoutTimer;
 TimerEvent_t RxTimeoutSyncWord;
 
+/*!
+ * Carrier sense RSSI sampling timer
+ */
+TimerEvent_t CarrierSenseTimer;
+
 /*
  * Radio driver functions implementation
  */
@@ -280,6 +369,8 @@ void SX1276Init( RadioEvents_t *events )
     TimerInit( &TxTimeoutTimer, SX1276OnTimeoutIrq );
     TimerInit( &RxTimeoutTimer, SX1276OnTimeoutIrq );
     TimerInit( &RxTimeoutSyncWord, SX1276OnTimeoutIrq );
+    TimerInit( &CarrierSenseTimer, SX1276OnCarrierSenseTimerIrq );
+    CarrierSenseSampleFired = false;
 
     SX1276Reset( );
 
@@ -350,6 +441,55 @@ bool SX1276IsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThres
     return status;
 }
 
+void SX1276StartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+{
+    RadioCarrierSense.Running = true;
+    RadioCarrierSense.Mode = mode;
+    RadioCarrierSense.RssiThresh = rssiThresh;
+    RadioCarrierSense.MaxCarrierSenseTime = maxCarrierSenseTime;
+
+    if( mode == RADIO_CARRIER_SENSE_CAD )
+    {
+        // The LoRa modem and modulation are setup by the caller through
+        // SX1276SetRxConfig, CAD has no other parameter on this radio
+        SX1276SetModem( MODEM_LORA );
+        SX1276SetChannel( freq );
+        RadioCarrierSense.StartTime = TimerGetCurrentTime( );
+        SX1276StartCad( );
+        return;
+    }
+
+    SX1276SetSleep( );
+
+    SX1276SetModem( MODEM_FSK );
+
+    SX1276SetChannel( freq );
+
+    SX1276Write( REG_RXBW, GetFskBandwidthRegValue( rxBandwidth ) );
+    SX1276Write( REG_AFCBW, GetFskBandwidthRegValue( rxBandwidth ) );
+
+    SX1276SetOpMode( RF_OPMODE_RECEIVER );
+    SX1276.Settings.State = RF_RX_RUNNING;
+
+    // First sample is taken once the RSSI is settled
+    RadioCarrierSense.MaxCarrierSenseTime += RADIO_CARRIER_SENSE_SAMPLING_PERIOD;
+    RadioCarrierSense.StartTime = TimerGetCurrentTime( );
+    TimerSetValue( &CarrierSenseTimer, RADIO_CARRIER_SENSE_SAMPLING_PERIOD );
+    TimerStart( &CarrierSenseTimer );
+}
+
+static void SX1276CarrierSenseDone( bool channelIsFree )
+{
+    TimerStop( &CarrierSenseTimer );
+    RadioCarrierSense.Running = false;
+    SX1276SetSleep( );
+
+    if( ( RadioEvents != NULL ) && ( RadioEvents->ChannelFreeDone != NULL ) )
+    {
+        RadioEvents->ChannelFreeDone( channelIsFree );
+    }
+}
+
 uint32_t SX1276Random( void )
 {
     uint8_t i;
@@ -462,11 +602,11 @@ void SX1276SetRxConfig( RadioModems_t modem, uint32_t bandwidth,
 
             if( fixLen == 1 )
             {
-                SX1276Write( REG_PAYLOADLENGTH, payloadLen );
+                SX1276SetFskPayloadLength( payloadLen );
             }
             else
             {
-                SX1276Write( REG_PAYLOADLENGTH, 0xFF ); // Set payload length to the maximum
+                SX1276SetFskPayloadLength( 0xFF ); // Set payload length to the maximum
             }
 
             SX1276Write( REG_PACKETCONFIG1,
@@ -736,6 +876,8 @@ uint32_t SX1276GetTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
     uint32_t numerator = 0;
     uint32_t denominator = 1;
 
+    TRACE_POINT_BEGIN( TRACE_POINT_TIME_ON_AIR );
+
     switch( modem )
     {
     case MODEM_FSK:
@@ -753,7 +895,10 @@ uint32_t SX1276GetTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
         break;
     }
     // Perform integral ceil()
-    return ( numerator + denominator - 1 ) / denominator;
+    uint32_t timeOnAir = ( numerator + denominator - 1 ) / denominator;
+
+    TRACE_POINT_END( TRACE_POINT_TIME_ON_AIR );
+    return timeOnAir;
 }
 
 void SX1276Send( uint8_t *buffer, uint8_t size )
@@ -764,6 +909,7 @@ void SX1276Send( uint8_t *buffer, uint8_t size )
     {
     case MODEM_FSK:
         {
+            FskPacket = &FskBuffer;
             SX1276.Settings.FskPacketHandler.NbBytes = 0;
             SX1276.Settings.FskPacketHandler.Size = size;
 
@@ -773,7 +919,7 @@ void SX1276Send( uint8_t *buffer, uint8_t size )
             }
             else
             {
-                SX1276Write( REG_PAYLOADLENGTH, size );
+                SX1276SetFskPayloadLength( size );
             }
 
             if( ( size > 0 ) && ( size <= 64 ) )
@@ -830,6 +976,52 @@ void SX1276Send( uint8_t *buffer, uint8_t size )
     SX1276SetTx( txTimeout );
 }
 
+void SX1276SetFskStream( const SX1276FskStream_t *stream )
+{
+    if( ( stream == NULL ) || ( stream->Size == 0 ) || ( stream->Size > SX1276_FSK_STREAM_MAX_SIZE ) ||
+        ( ( stream->Buffer == NULL ) && ( stream->GetChunk == NULL ) ) )
+    {
+        FskStream.Size = 0;
+        return;
+    }
+    FskStream = *stream;
+}
+
+void SX1276SendStream( uint16_t size )
+{
+    uint8_t lengthSize = 0;
+
+    if( ( SX1276.Settings.Modem != MODEM_FSK ) || ( FskStream.Size == 0 ) || ( size == 0 ) ||
+        ( size > SX1276_FSK_STREAM_MAX_SIZE ) ||
+        ( ( SX1276.Settings.Fsk.FixLen == false ) && ( size > UINT8_MAX ) ) ||
+        ( ( FskStream.GetChunk == NULL ) && ( size > FskStream.Size ) ) )
+    {
+        return;
+    }
+
+    FskPacket = &FskStream;
+    SX1276.Settings.FskPacketHandler.NbBytes = 0;
+    SX1276.Settings.FskPacketHandler.Size = size;
+
+    if( SX1276.Settings.Fsk.FixLen == false )
+    {
+        uint8_t length = size;
+
+        SX1276WriteFifo( &length, 1 );
+        lengthSize = 1;
+    }
+    else
+    {
+        SX1276SetFskPayloadLength( size );
+    }
+
+    // The FifoEmpty interrupt refills the whole FIFO
+    SX1276.Settings.FskPacketHandler.ChunkSize = SX1276_FIFO_SIZE;
+    SX1276FskFifoTransfer( MIN( size, SX1276_FIFO_SIZE - lengthSize ), true );
+
+    SX1276SetTx( SX1276.Settings.Fsk.TxTimeout );
+}
+
 void SX1276SetSleep( void )
 {
     TimerStop( &RxTimeoutTimer );
@@ -883,6 +1075,15 @@ void SX1276SetRx( uint32_t timeout )
                                                                             RF_DIOMAPPING2_DIO4_11 |
                                                                             RF_DIOMAPPING2_MAP_PREAMBLEDETECT );
 
+            FskPacket = ( FskStream.Size != 0 ) ? &FskStream : &FskBuffer;
+            if( SX1276.Settings.Fsk.FixLen == true )
+            {
+                SX1276SetFskPayloadLength( ( FskStream.Size != 0 ) ? FskStream.Size : SX1276.Settings.Fsk.PayloadLen );
+            }
+
+            // Larger FIFO offloads in streaming mode
+            SX1276Write( REG_FIFOTHRESH, ( SX1276Read( REG_FIFOTHRESH ) & RF_FIFOTHRESH_FIFOTHRESHOLD_MASK ) |
+                                         ( ( FskStream.Size != 0 ) ? SX1276_FSK_STREAM_FIFO_THRESH : RF_FIFOTHRESH_FIFOTHRESHOLD_THRESHOLD ) );
             SX1276.Settings.FskPacketHandler.FifoThresh = SX1276Read( REG_FIFOTHRESH ) & 0x3F;
 
             SX1276Write( REG_RXCONFIG, RF_RXCONFIG_AFCAUTO_ON | RF_RXCONFIG_AGCAUTO_ON | RF_RXCONFIG_RXTRIGER_PREAMBLEDETECT );
@@ -1293,6 +1494,64 @@ static void SX1276ReadFifo( uint8_t *buffer, uint8_t size )
     SX1276ReadBuffer( 0, buffer, size );
 }
 
+static void SX1276FskFifoTransfer( uint16_t size, bool isTx )
+{
+    uint8_t discard[16];
+
+    while( size > 0 )
+    {
+        uint16_t offset = SX1276.Settings.FskPacketHandler.NbBytes;
+        uint16_t chunkSize = size;
+        uint8_t *chunk = NULL;
+
+        if( FskPacket->GetChunk != NULL )
+        {
+            chunk = FskPacket->GetChunk( offset, &chunkSize );
+            chunkSize = MIN( chunkSize, size );
+        }
+        else if( offset < FskPacket->Size )
+        {
+            chunk = FskPacket->Buffer + offset;
+            chunkSize = MIN( chunkSize, FskPacket->Size - offset );
+        }
+
+        if( ( chunk == NULL ) || ( chunkSize == 0 ) )
+        {
+            if( isTx == true )
+            {
+                return;
+            }
+            // No room for the received bytes
+            chunk = discard;
+            chunkSize = MIN( size, sizeof( discard ) );
+        }
+
+        if( isTx == true )
+        {
+            SX1276WriteFifo( chunk, chunkSize );
+        }
+        else
+        {
+            SX1276ReadFifo( chunk, chunkSize );
+        }
+        SX1276.Settings.FskPacketHandler.NbBytes += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+static void SX1276SetFskPayloadLength( uint16_t size )
+{
+    SX1276Write( REG_PACKETCONFIG2, ( SX1276Read( REG_PACKETCONFIG2 ) & RF_PACKETCONFIG2_PAYLOADLENGTH_MSB_MASK ) |
+                                    ( ( size >> 8 ) & ~RF_PACKETCONFIG2_PAYLOADLENGTH_MSB_MASK ) );
+    SX1276Write( REG_PAYLOADLENGTH, ( uint8_t )size );
+}
+
+static uint16_t SX1276GetFskPayloadLength( void )
+{
+    return ( ( uint16_t )( SX1276Read( REG_PACKETCONFIG2 ) & ~RF_PACKETCONFIG2_PAYLOADLENGTH_MSB_MASK ) << 8 ) |
+           SX1276Read( REG_PAYLOADLENGTH );
+}
+
 void SX1276SetMaxPayloadLength( RadioModems_t modem, uint8_t max )
 {
     SX1276SetModem( modem );
@@ -1302,7 +1561,7 @@ void SX1276SetMaxPayloadLength( RadioModems_t modem, uint8_t max )
     case MODEM_FSK:
         if( SX1276.Settings.Fsk.FixLen == false )
         {
-            SX1276Write( REG_PAYLOADLENGTH, max );
+            SX1276SetFskPayloadLength( max );
         }
         break;
     case MODEM_LORA:
@@ -1447,6 +1706,44 @@ static uint32_t SX1276GetLoRaTimeOnAirNumerator( uint32_t bandwidth,
     return ( uint32_t )( ( 4 * intermediate + 1 ) * ( 1 << ( datarate - 2 ) ) );
 }
 
+static void SX1276OnCarrierSenseTimerIrq( void* context )
+{
+    CarrierSenseSampleFired = true;
+}
+
+void SX1276IrqProcess( void )
+{
+    if( CarrierSenseSampleFired == true )
+    {
+        CRITICAL_SECTION_BEGIN( );
+        // Clear carrier sense sample flag
+        CarrierSenseSampleFired = false;
+        CRITICAL_SECTION_END( );
+
+        SX1276CarrierSenseSample( );
+    }
+}
+
+static void SX1276CarrierSenseSample( void )
+{
+    if( ( RadioCarrierSense.Running == false ) || ( RadioCarrierSense.Mode != RADIO_CARRIER_SENSE_RSSI ) )
+    {
+        return;
+    }
+    if( SX1276ReadRssi( MODEM_FSK ) > RadioCarrierSense.RssiThresh )
+    {
+        SX1276CarrierSenseDone( false );
+    }
+    else if( TimerGetElapsedTime( RadioCarrierSense.StartTime ) >= RadioCarrierSense.MaxCarrierSenseTime )
+    {
+        SX1276CarrierSenseDone( true );
+    }
+    else
+    {
+        TimerStart( &CarrierSenseTimer );
+    }
+}
+
 static void SX1276OnTimeoutIrq( void* context )
 {
     switch( SX1276.Settings.State )
@@ -1580,16 +1877,10 @@ static void SX1276OnDio0Irq( void* context )
                     }
                     else
                     {
-                        SX1276.Settings.FskPacketHandler.Size = SX1276Read( REG_PAYLOADLENGTH );
+                        SX1276.Settings.FskPacketHandler.Size = SX1276GetFskPayloadLength( );
                     }
-                    SX1276ReadFifo( RxTxBuffer + SX1276.Settings.FskPacketHandler.NbBytes, SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
-                    SX1276.Settings.FskPacketHandler.NbBytes += ( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
-                }
-                else
-                {
-                    SX1276ReadFifo( RxTxBuffer + SX1276.Settings.FskPacketHandler.NbBytes, SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
-                    SX1276.Settings.FskPacketHandler.NbBytes += ( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
                 }
+                SX1276FskFifoTransfer( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes, false );
 
                 TimerStop( &RxTimeoutTimer );
 
@@ -1606,7 +1897,7 @@ static void SX1276OnDio0Irq( void* context )
 
                 if( ( RadioEvents != NULL ) && ( RadioEvents->RxDone != NULL ) )
                 {
-                    RadioEvents->RxDone( RxTxBuffer, SX1276.Settings.FskPacketHandler.Size, SX1276.Settings.FskPacketHandler.RssiValue, 0 );
+                    RadioEvents->RxDone( FskPacket->Buffer, SX1276.Settings.FskPacketHandler.Size, SX1276.Settings.FskPacketHandler.RssiValue, 0 );
                 }
                 SX1276.Settings.FskPacketHandler.PreambleDetected = false;
                 SX1276.Settings.FskPacketHandler.SyncWordDetected = false;
@@ -1615,6 +1906,8 @@ static void SX1276OnDio0Irq( void* context )
                 break;
             case MODEM_LORA:
                 {
+                    uint8_t headerSize;
+
                     // Clear Irq
                     SX1276Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_RXDONE );
 
@@ -1637,6 +1930,27 @@ static void SX1276OnDio0Irq( void* context )
                         break;
                     }
 
+                    // Only the MAC header is read until the frame is accepted
+                    SX1276.Settings.LoRaPacketHandler.Size = SX1276Read( REG_LR_RXNBBYTES );
+                    SX1276Write( REG_LR_FIFOADDRPTR, SX1276Read( REG_LR_FIFORXCURRENTADDR ) );
+                    headerSize = MIN( SX1276.Settings.LoRaPacketHandler.Size, RADIO_RX_FILTER_HEADER_SIZE );
+                    SX1276ReadFifo( RxTxBuffer, headerSize );
+                    if( ( SX1276.Settings.LoRa.FixLen == false ) &&
+                        ( RadioRxFilterCheck( RxTxBuffer, SX1276.Settings.LoRaPacketHandler.Size ) == false ) )
+                    {
+                        if( SX1276.Settings.LoRa.RxContinuous == false )
+                        {
+                            SX1276.Settings.State = RF_IDLE;
+                            TimerStop( &RxTimeoutTimer );
+
+                            if( ( RadioEvents != NULL ) && ( RadioEvents->RxTimeout != NULL ) )
+                            {
+                                RadioEvents->RxTimeout( );
+                            }
+                        }
+                        break;
+                    }
+
                     // Returns SNR value [dB] rounded to the nearest integer value
                     SX1276.Settings.LoRaPacketHandler.SnrValue = ( ( ( int8_t )SX1276Read( REG_LR_PKTSNRVALUE ) ) + 2 ) >> 2;
 
@@ -1666,9 +1980,7 @@ static void SX1276OnDio0Irq( void* context )
                         }
                     }
 
-                    SX1276.Settings.LoRaPacketHandler.Size = SX1276Read( REG_LR_RXNBBYTES );
-                    SX1276Write( REG_LR_FIFOADDRPTR, SX1276Read( REG_LR_FIFORXCURRENTADDR ) );
-                    SX1276ReadFifo( RxTxBuffer, SX1276.Settings.LoRaPacketHandler.Size );
+                    SX1276ReadFifo( RxTxBuffer + headerSize, SX1276.Settings.LoRaPacketHandler.Size - headerSize );
 
                     if( SX1276.Settings.LoRa.RxContinuous == false )
                     {
@@ -1731,7 +2043,7 @@ static void SX1276OnDio1Irq( void* context )
                     }
                     else
                     {
-                        SX1276.Settings.FskPacketHandler.Size = SX1276Read( REG_PAYLOADLENGTH );
+                        SX1276.Settings.FskPacketHandler.Size = SX1276GetFskPayloadLength( );
                     }
                 }
 
@@ -1744,13 +2056,11 @@ static void SX1276OnDio1Irq( void* context )
                 //              when FifoLevel fires
                 if( ( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes ) >= SX1276.Settings.FskPacketHandler.FifoThresh )
                 {
-                    SX1276ReadFifo( ( RxTxBuffer + SX1276.Settings.FskPacketHandler.NbBytes ), SX1276.Settings.FskPacketHandler.FifoThresh - 1 );
-                    SX1276.Settings.FskPacketHandler.NbBytes += SX1276.Settings.FskPacketHandler.FifoThresh - 1;
+                    SX1276FskFifoTransfer( SX1276.Settings.FskPacketHandler.FifoThresh - 1, false );
                 }
                 else
                 {
-                    SX1276ReadFifo( ( RxTxBuffer + SX1276.Settings.FskPacketHandler.NbBytes ), SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
-                    SX1276.Settings.FskPacketHandler.NbBytes += ( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
+                    SX1276FskFifoTransfer( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes, false );
                 }
                 break;
             case MODEM_LORA:
@@ -1776,14 +2086,12 @@ static void SX1276OnDio1Irq( void* context )
                 // FifoEmpty interrupt
                 if( ( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes ) > SX1276.Settings.FskPacketHandler.ChunkSize )
                 {
-                    SX1276WriteFifo( ( RxTxBuffer + SX1276.Settings.FskPacketHandler.NbBytes ), SX1276.Settings.FskPacketHandler.ChunkSize );
-                    SX1276.Settings.FskPacketHandler.NbBytes += SX1276.Settings.FskPacketHandler.ChunkSize;
+                    SX1276FskFifoTransfer( SX1276.Settings.FskPacketHandler.ChunkSize, true );
                 }
                 else
                 {
                     // Write the last chunk of data
-                    SX1276WriteFifo( RxTxBuffer + SX1276.Settings.FskPacketHandler.NbBytes, SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes );
-                    SX1276.Settings.FskPacketHandler.NbBytes += SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes;
+                    SX1276FskFifoTransfer( SX1276.Settings.FskPacketHandler.Size - SX1276.Settings.FskPacketHandler.NbBytes, true );
                 }
                 break;
             case MODEM_LORA:
@@ -1874,7 +2182,29 @@ static void SX1276OnDio3Irq( void* context )
     case MODEM_FSK:
         break;
     case MODEM_LORA:
-        if( ( SX1276Read( REG_LR_IRQFLAGS ) & RFLR_IRQFLAGS_CADDETECTED ) == RFLR_IRQFLAGS_CADDETECTED )
+        if( ( RadioCarrierSense.Running == true ) && ( RadioCarrierSense.Mode == RADIO_CARRIER_SENSE_CAD ) )
+        {
+            if( ( SX1276Read( REG_LR_IRQFLAGS ) & RFLR_IRQFLAGS_CADDETECTED ) == RFLR_IRQFLAGS_CADDETECTED )
+            {
+                // Clear Irq
+                SX1276Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_CADDETECTED | RFLR_IRQFLAGS_CADDONE );
+                SX1276CarrierSenseDone( false );
+            }
+            else
+            {
+                // Clear Irq
+                SX1276Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_CADDONE );
+                if( TimerGetElapsedTime( RadioCarrierSense.StartTime ) >= RadioCarrierSense.MaxCarrierSenseTime )
+                {
+                    SX1276CarrierSenseDone( true );
+                }
+                else
+                {
+                    SX1276StartCad( );
+                }
+            }
+        }
+        else if( ( SX1276Read( REG_LR_IRQFLAGS ) & RFLR_IRQFLAGS_CADDETECTED ) == RFLR_IRQFLAGS_CADDETECTED )
         {
             // Clear Irq
             SX1276Write( REG_LR_IRQFLAGS, RFLR_IRQFLAGS_CADDETECTED | RFLR_IRQFLAGS_CADDONE );
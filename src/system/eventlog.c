@@ -0,0 +1,291 @@
+/*!
+ * \file      eventlog.c
+ *
+ * \brief     Radio, timer and MAC request events capture for record/replay
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include "eventlog.h"
+
+/*!
+ * Maximum size of a varint encoded 32 bits value
+ */
+#define EVENT_LOG_VARINT_MAX_SIZE                   5
+
+static const uint8_t EventLogMagic[4] = { 'L', 'M', 'E', 'L' };
+
+/*!
+ * \brief Decodes a varint
+ *
+ * \param [IN]  buffer Encoded bytes
+ * \param [IN]  size   Number of available bytes
+ * \param [OUT] value  Decoded value
+ *
+ * \retval size Number of decoded bytes. 0 when truncated or invalid.
+ */
+static uint8_t EventLogGetVarint( const uint8_t* buffer, uint32_t size, uint32_t* value )
+{
+    *value = 0;
+    for( uint8_t i = 0; ( i < size ) && ( i < EVENT_LOG_VARINT_MAX_SIZE ); i++ )
+    {
+        *value |= ( uint32_t )( buffer[i] & 0x7F ) << ( 7 * i );
+        if( ( buffer[i] & 0x80 ) == 0 )
+        {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static uint32_t EventLogGetUint32( const uint8_t* buffer )
+{
+    return ( uint32_t )buffer[0] | ( ( uint32_t )buffer[1] << 8 ) |
+           ( ( uint32_t )buffer[2] << 16 ) | ( ( uint32_t )buffer[3] << 24 );
+}
+
+bool EventLogReaderInit( EventLogReader_t* reader, const uint8_t* buffer, uint32_t size )
+{
+    if( ( size < EVENT_LOG_HEADER_SIZE ) ||
+        ( buffer[0] != EventLogMagic[0] ) || ( buffer[1] != EventLogMagic[1] ) ||
+        ( buffer[2] != EventLogMagic[2] ) || ( buffer[3] != EventLogMagic[3] ) ||
+        ( buffer[4] != EVENT_LOG_VERSION ) )
+    {
+        return false;
+    }
+    reader->Buffer = buffer;
+    reader->Size = size;
+    reader->Frequency = EventLogGetUint32( buffer + 5 );
+    reader->Time = EventLogGetUint32( buffer + 9 );
+    reader->Offset = EVENT_LOG_HEADER_SIZE;
+    return true;
+}
+
+bool EventLogReaderNext( EventLogReader_t* reader, EventLogRecord_t* record )
+{
+    uint32_t offset = reader->Offset;
+    uint32_t delta = 0;
+    uint32_t size = 0;
+    uint8_t length = 0;
+
+    if( offset >= reader->Size )
+    {
+        return false;
+    }
+    record->Type = ( EventLogType_t )reader->Buffer[offset++];
+
+    length = EventLogGetVarint( reader->Buffer + offset, reader->Size - offset, &delta );
+    if( length == 0 )
+    {
+        return false;
+    }
+    offset += length;
+
+    length = EventLogGetVarint( reader->Buffer + offset, reader->Size - offset, &size );
+    if( ( length == 0 ) || ( size > UINT16_MAX ) || ( size > ( reader->Size - offset - length ) ) )
+    {
+        return false;
+    }
+    offset += length;
+
+    record->Time = reader->Time + delta;
+    record->Data = reader->Buffer + offset;
+    record->Size = size;
+
+    reader->Time = record->Time;
+    reader->Offset = offset + size;
+    return true;
+}
+
+#if defined( EVENT_LOG_ENABLED )
+
+#include "utilities.h"
+#include "rtc-board.h"
+#include "ringbuffer.h"
+
+static uint8_t EventLogBuffer[EVENT_LOG_BUFFER_SIZE];
+static RingBuffer_t EventLogRing;
+static EventLogWrite_t EventLogWrite;
+static uint32_t EventLogTime;
+static uint32_t EventLogDropped;
+/*!
+ * Dropped records not reported by a gap record yet
+ */
+static uint32_t EventLogPendingDropped;
+
+/*!
+ * \brief Encodes a varint
+ *
+ * \param [OUT] buffer Encoded bytes, at least EVENT_LOG_VARINT_MAX_SIZE bytes
+ * \param [IN]  value  Value to be encoded
+ *
+ * \retval size Number of encoded bytes
+ */
+static uint8_t EventLogPutVarint( uint8_t* buffer, uint32_t value )
+{
+    uint8_t size = 0;
+
+    while( value >= 0x80 )
+    {
+        buffer[size++] = ( uint8_t )( value | 0x80 );
+        value >>= 7;
+    }
+    buffer[size++] = ( uint8_t )value;
+    return size;
+}
+
+static void EventLogPutUint32( uint8_t* buffer, uint32_t value )
+{
+    buffer[0] = ( uint8_t )value;
+    buffer[1] = ( uint8_t )( value >> 8 );
+    buffer[2] = ( uint8_t )( value >> 16 );
+    buffer[3] = ( uint8_t )( value >> 24 );
+}
+
+void EventLogInit( EventLogWrite_t write )
+{
+    uint8_t header[EVENT_LOG_HEADER_SIZE];
+
+    CRITICAL_SECTION_BEGIN( );
+    RingBufferInit( &EventLogRing, EventLogBuffer, EVENT_LOG_BUFFER_SIZE );
+    EventLogWrite = write;
+    EventLogTime = RtcGetTimerValue( );
+    EventLogDropped = 0;
+    EventLogPendingDropped = 0;
+
+    memcpy1( header, EventLogMagic, sizeof( EventLogMagic ) );
+    header[4] = EVENT_LOG_VERSION;
+    EventLogPutUint32( header + 5, RtcMs2Tick( 1000 ) );
+    EventLogPutUint32( header + 9, EventLogTime );
+    RingBufferPushN( &EventLogRing, header, sizeof( header ) );
+    CRITICAL_SECTION_END( );
+}
+
+/*!
+ * \brief Pushes a record to the capture buffer. Must be called in a critical
+ *        section.
+ *
+ * \retval status [true: record pushed, false: capture buffer full]
+ */
+static bool EventLogPush( EventLogType_t type, const uint8_t* header, uint8_t headerSize, const uint8_t* data, uint16_t size )
+{
+    uint8_t prefix[1 + ( 2 * EVENT_LOG_VARINT_MAX_SIZE )];
+    uint8_t prefixSize = 0;
+    uint32_t now = RtcGetTimerValue( );
+
+    prefix[prefixSize++] = type;
+    prefixSize += EventLogPutVarint( prefix + prefixSize, now - EventLogTime );
+    prefixSize += EventLogPutVarint( prefix + prefixSize, headerSize + size );
+
+    if( ( EVENT_LOG_BUFFER_SIZE - RingBufferCount( &EventLogRing ) ) < ( prefixSize + headerSize + size ) )
+    {
+        return false;
+    }
+    RingBufferPushN( &EventLogRing, prefix, prefixSize );
+    RingBufferPushN( &EventLogRing, header, headerSize );
+    RingBufferPushN( &EventLogRing, data, size );
+    EventLogTime = now;
+    return true;
+}
+
+/*!
+ * \brief Pushes the gap record of the records dropped since the last one, if
+ *        any. Must be called in a critical section.
+ */
+static void EventLogPushGap( void )
+{
+    uint8_t count[4];
+
+    if( EventLogPendingDropped == 0 )
+    {
+        return;
+    }
+    EventLogPutUint32( count, EventLogPendingDropped );
+    if( EventLogPush( EVENT_LOG_GAP, count, sizeof( count ), NULL, 0 ) == true )
+    {
+        EventLogPendingDropped = 0;
+    }
+}
+
+void EventLogRecord( EventLogType_t type, const uint8_t* header, uint8_t headerSize, const uint8_t* data, uint16_t size )
+{
+    if( EventLogWrite == NULL )
+    {
+        return;
+    }
+
+    // The critical section serializes the producers, interrupts and main loop
+    CRITICAL_SECTION_BEGIN( );
+    EventLogPushGap( );
+    // The record can't be pushed ahead of a pending gap record
+    if( ( EventLogPendingDropped != 0 ) || ( EventLogPush( type, header, headerSize, data, size ) == false ) )
+    {
+        // The timestamp delta of the next record includes the dropped one
+        EventLogDropped++;
+        EventLogPendingDropped++;
+    }
+    CRITICAL_SECTION_END( );
+}
+
+void EventLogProcess( void )
+{
+    uint8_t* data = NULL;
+    uint16_t size = 0;
+
+    if( EventLogWrite == NULL )
+    {
+        return;
+    }
+    do
+    {
+        while( ( size = RingBufferPeek( &EventLogRing, &data ) ) != 0 )
+        {
+            EventLogWrite( data, size );
+            RingBufferSkip( &EventLogRing, size );
+        }
+
+        // Reports the dropped records now that the capture buffer is empty
+        CRITICAL_SECTION_BEGIN( );
+        EventLogPushGap( );
+        CRITICAL_SECTION_END( );
+    } while( RingBufferCount( &EventLogRing ) != 0 );
+}
+
+uint32_t EventLogGetDropped( void )
+{
+    return EventLogDropped;
+}
+
+#else
+
+void EventLogInit( EventLogWrite_t write )
+{
+}
+
+void EventLogRecord( EventLogType_t type, const uint8_t* header, uint8_t headerSize, const uint8_t* data, uint16_t size )
+{
+}
+
+void EventLogProcess( void )
+{
+}
+
+uint32_t EventLogGetDropped( void )
+{
+    return 0;
+}
+
+#endif
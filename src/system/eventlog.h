@@ -0,0 +1,271 @@
+/*!
+ * \file      eventlog.h
+ *
+ * \brief     Radio, timer and MAC request events capture for record/replay
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \remark    The capture is compiled only when EVENT_LOG_ENABLED is defined.
+ *            Otherwise \ref EVENT_LOG_RECORD expands to nothing. The log
+ *            reader is always available.
+ *
+ *            Log format, multi-byte fields are little endian:
+ *            - Header: "LMEL", version, RTC ticks per second ( 4 bytes ),
+ *              RTC timer value at \ref EventLogInit ( 4 bytes )
+ *            - Records: type ( 1 byte ), RTC ticks since the previous record
+ *              ( varint ), data size ( varint ), data
+ *
+ *            Varints are LEB128 encoded: 7 bits per byte, least significant
+ *            group first, bit 7 set on all bytes but the last one.
+ *
+ *            Usage: call \ref EventLogInit before LoRaMacInitialization and
+ *            \ref EventLogProcess from the main loop. The log is fed to the
+ *            host replay driver, see LoRaMacReplay.h.
+ */
+#ifndef __EVENTLOG_H__
+#define __EVENTLOG_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * Size of the capture buffer holding the records until \ref EventLogProcess
+ * writes them. Must be a power of 2.
+ *
+ * \remark This parameter has an impact on the memory footprint.
+ */
+#ifndef EVENT_LOG_BUFFER_SIZE
+#define EVENT_LOG_BUFFER_SIZE                       1024
+#endif
+
+/*!
+ * Log format version
+ */
+#define EVENT_LOG_VERSION                           1
+
+/*!
+ * Log header size
+ */
+#define EVENT_LOG_HEADER_SIZE                       13
+
+/*!
+ * Events types
+ */
+typedef enum eEventLogType
+{
+    /*!
+     * LoRaMacInitialization. Data: random seed returned by the radio ( 4 bytes ),
+     * radio wakeup time in ms ( 4 bytes )
+     */
+    EVENT_LOG_MAC_INIT,
+    /*!
+     * LoRaMacMcpsRequest. Data: type, port, datarate, number of trials,
+     * application payload
+     */
+    EVENT_LOG_MCPS_REQUEST,
+    /*!
+     * LoRaMacMlmeRequest. Data: type followed by the parameters of the type
+     */
+    EVENT_LOG_MLME_REQUEST,
+    /*!
+     * Frame handed to the radio. Data: channel index, datarate, TX power,
+     * frame
+     */
+    EVENT_LOG_RADIO_SEND,
+    /*!
+     * Radio TX done event
+     */
+    EVENT_LOG_RADIO_TX_DONE,
+    /*!
+     * Radio RX done event. Data: RSSI ( 2 bytes ), SNR, frame
+     */
+    EVENT_LOG_RADIO_RX_DONE,
+    /*!
+     * Radio TX timeout event
+     */
+    EVENT_LOG_RADIO_TX_TIMEOUT,
+    /*!
+     * Radio RX timeout event
+     */
+    EVENT_LOG_RADIO_RX_TIMEOUT,
+    /*!
+     * Radio RX error event
+     */
+    EVENT_LOG_RADIO_RX_ERROR,
+    /*!
+     * Radio channel free done event. Data: channel is free
+     */
+    EVENT_LOG_RADIO_CHANNEL_FREE_DONE,
+    /*!
+     * Expiry of a LoRaMAC timer. Data: LoRaMacDeadlineOwner_t of the timer
+     */
+    EVENT_LOG_TIMER,
+    /*!
+     * Random number returned by the radio after LoRaMacInitialization, e.g.
+     * the join reseed or a random DevNonce. Data: random number ( 4 bytes )
+     */
+    EVENT_LOG_RADIO_RANDOM,
+    /*!
+     * Records dropped because the capture buffer was full, written once space
+     * is available again. Data: number of dropped records ( 4 bytes )
+     */
+    EVENT_LOG_GAP,
+    /*!
+     * Number of events types
+     */
+    EVENT_LOG_TYPE_MAX,
+}EventLogType_t;
+
+/*!
+ * Decoded record
+ */
+typedef struct sEventLogRecord
+{
+    EventLogType_t Type;
+    /*!
+     * RTC timer value of the record
+     */
+    uint32_t Time;
+    /*!
+     * Record data. Points into the log buffer.
+     */
+    const uint8_t* Data;
+    uint16_t Size;
+}EventLogRecord_t;
+
+/*!
+ * Log reader
+ */
+typedef struct sEventLogReader
+{
+    const uint8_t* Buffer;
+    uint32_t Size;
+    /*!
+     * Offset of the next record
+     */
+    uint32_t Offset;
+    /*!
+     * RTC timer value of the previous record
+     */
+    uint32_t Time;
+    /*!
+     * RTC ticks per second of the recording device
+     */
+    uint32_t Frequency;
+}EventLogReader_t;
+
+/*!
+ * Log writer, e.g. an UART or an external flash. Called from
+ * \ref EventLogProcess.
+ *
+ * \param [IN] data Log bytes
+ * \param [IN] size Number of bytes
+ */
+typedef void ( *EventLogWrite_t )( const uint8_t* data, uint16_t size );
+
+#if defined( EVENT_LOG_ENABLED )
+
+/*!
+ * Records an event
+ */
+#define EVENT_LOG_RECORD( type, header, headerSize, data, size )    EventLogRecord( type, header, headerSize, data, size )
+
+#else
+
+#define EVENT_LOG_RECORD( type, header, headerSize, data, size )
+
+#endif
+
+/*!
+ * Records a random number returned by the radio, replayed by the host replay
+ * driver
+ */
+#define EVENT_LOG_RECORD_RANDOM( value )                                            \
+    EVENT_LOG_RECORD( EVENT_LOG_RADIO_RANDOM,                                       \
+                      ( ( uint8_t[] ){ ( uint8_t )( value ),                        \
+                                       ( uint8_t )( ( value ) >> 8 ),               \
+                                       ( uint8_t )( ( value ) >> 16 ),              \
+                                       ( uint8_t )( ( value ) >> 24 ) } ), 4, NULL, 0 )
+
+/*!
+ * \brief Starts a new log. The header is written first.
+ *
+ * \param [IN] write Log writer
+ */
+void EventLogInit( EventLogWrite_t write );
+
+/*!
+ * \brief Records an event. Can be called from interrupt context. The record
+ *        data is the concatenation of header and data.
+ *
+ * \remark The record is dropped when the capture buffer is full. A
+ *         \ref EVENT_LOG_GAP record holding the number of dropped records is
+ *         written once space is available again.
+ *
+ * \param [IN] type       Event type
+ * \param [IN] header     Fixed size fields of the record. May be NULL.
+ * \param [IN] headerSize Number of bytes of header
+ * \param [IN] data       Variable size payload of the record. May be NULL.
+ * \param [IN] size       Number of bytes of data
+ */
+void EventLogRecord( EventLogType_t type, const uint8_t* header, uint8_t headerSize, const uint8_t* data, uint16_t size );
+
+/*!
+ * \brief Writes the captured records. To be called from the main loop.
+ */
+void EventLogProcess( void );
+
+/*!
+ * \brief Gets the number of records dropped because the capture buffer was
+ *        full
+ *
+ * \retval count Number of dropped records
+ */
+uint32_t EventLogGetDropped( void );
+
+/*!
+ * \brief Initializes a log reader
+ *
+ * \param [OUT] reader Log reader
+ * \param [IN]  buffer Log bytes, header included
+ * \param [IN]  size   Number of bytes
+ *
+ * \retval status [true: valid header, false: not a log or unknown version]
+ */
+bool EventLogReaderInit( EventLogReader_t* reader, const uint8_t* buffer, uint32_t size );
+
+/*!
+ * \brief Decodes the next record of a log
+ *
+ * \param [IN]  reader Log reader
+ * \param [OUT] record Decoded record
+ *
+ * \retval status [true: record decoded, false: end of the log or truncated
+ *                 record, the reader isn't advanced]
+ */
+bool EventLogReaderNext( EventLogReader_t* reader, EventLogRecord_t* record );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __EVENTLOG_H__
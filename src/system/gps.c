@@ -21,10 +21,7 @@
  * \author    Gregory Cristian ( Semtech )
  */
 #include <stdint.h>
-#include <stdlib.h>
-#include <math.h>
-#include <stdio.h>
-#include <string.h>
+#include <stdbool.h>
 #include "utilities.h"
 #include "board.h"
 #include "rtc-board.h"
@@ -33,28 +30,114 @@
 
 #define TRIGGER_GPS_CNT                             10
 
-/* Various type of NMEA data we can receive with the Gps */
-const char NmeaDataTypeGPGGA[] = "GPGGA";
-const char NmeaDataTypeGPGSA[] = "GPGSA";
-const char NmeaDataTypeGPGSV[] = "GPGSV";
-const char NmeaDataTypeGPRMC[] = "GPRMC";
-
-/* Value used for the conversion of the position from DMS to decimal */
+/* Value used for the conversion of the position from degrees to binary */
 const int32_t MaxNorthPosition = 8388607;       // 2^23 - 1
 const int32_t MaxSouthPosition = 8388608;       // -2^23
 const int32_t MaxEastPosition = 8388607;        // 2^23 - 1
 const int32_t MaxWestPosition = 8388608;        // -2^23
 
-NmeaGpsData_t NmeaGpsData;
+/*!
+ * Number of 1e-7 degrees units in one degree
+ */
+#define NMEA_DEGREE_SCALE                           10000000
+
+/*!
+ * Number of fractional digits kept for the NMEA minutes. 1e-5 minutes are
+ * about 2 cm at the equator.
+ */
+#define NMEA_MINUTES_FRAC_DIGITS                    5
 
-static double HasFix = false;
-static double Latitude = 0;
-static double Longitude = 0;
+/*!
+ * Largest value the field accumulator accepts before multiplying it by 10
+ */
+#define NMEA_FIELD_VALUE_MAX                        ( ( UINT32_MAX - 9 ) / 10 )
 
-static int32_t LatitudeBinary = 0;
-static int32_t LongitudeBinary = 0;
+/*!
+ * NMEA streaming parser states
+ */
+typedef enum eNmeaParserState
+{
+    /*!
+     * Waiting for the '$' sentence start
+     */
+    NMEA_PARSER_STATE_IDLE,
+    /*!
+     * Receiving the comma separated fields
+     */
+    NMEA_PARSER_STATE_FIELDS,
+    /*!
+     * Receiving the checksum upper nibble
+     */
+    NMEA_PARSER_STATE_CHECKSUM_HIGH,
+    /*!
+     * Receiving the checksum lower nibble
+     */
+    NMEA_PARSER_STATE_CHECKSUM_LOW,
+}NmeaParserState_t;
+
+/*!
+ * NMEA streaming parser context. The current field is never buffered, its
+ * digits are accumulated as an integer and its first character is kept for
+ * the single character fields.
+ */
+typedef struct sNmeaParser
+{
+    NmeaParserState_t State;
+    /*!
+     * Sentence type, known once the address field has been received
+     */
+    NmeaSentence_t Sentence;
+    /*!
+     * Running XOR of the characters between '$' and '*'
+     */
+    uint8_t Checksum;
+    /*!
+     * Checksum received after '*'
+     */
+    uint8_t ReceivedChecksum;
+    /*!
+     * Index of the current field. The address field is the field 0.
+     */
+    uint8_t FieldIndex;
+    /*!
+     * Number of characters received in the current field
+     */
+    uint8_t FieldLength;
+    /*!
+     * Last 3 characters of the address field, the sentence formatter
+     */
+    char Formatter[3];
+    /*!
+     * First character of the current field
+     */
+    char FieldChar;
+    /*!
+     * Digits of the current field, without the decimal point
+     */
+    uint32_t FieldValue;
+    /*!
+     * Number of digits accumulated after the decimal point
+     */
+    uint8_t FieldFracDigits;
+    bool FieldHasDot;
+    bool FieldIsNegative;
+    /*!
+     * Some digits didn't fit the accumulator. The integer part is invalid.
+     */
+    bool FieldOverflow;
+    /*!
+     * Fix being updated by the current sentence. Committed once the checksum
+     * has been validated.
+     */
+    GpsFix_t Fix;
+}NmeaParser_t;
+
+static NmeaParser_t NmeaParser;
 
-static int16_t Altitude = ( int16_t )0xFFFF;
+/*!
+ * Latest fix decoded from sentences with a valid checksum
+ */
+static GpsFix_t GpsFix;
 
 static uint32_t PpsCnt = 0;
 
@@ -76,6 +159,8 @@ void GpsPpsHandler( bool *parseData )
 void GpsInit( void )
 {
     PpsDetected = false;
+    NmeaParser.State = NMEA_PARSER_STATE_IDLE;
+    GpsResetPosition( );
     GpsMcuInit( );
 }
 
@@ -107,87 +192,24 @@ bool GpsGetPpsDetectedState( void )
 
 bool GpsHasFix( void )
 {
-    return HasFix;
-}
-
-void GpsConvertPositionIntoBinary( void )
-{
-    long double temp;
-
-    if( Latitude >= 0 ) // North
-    {
-        temp = Latitude * MaxNorthPosition;
-        LatitudeBinary = temp / 90;
-    }
-    else                // South
-    {
-        temp = Latitude * MaxSouthPosition;
-        LatitudeBinary = temp / 90;
-    }
-
-    if( Longitude >= 0 ) // East
-    {
-        temp = Longitude * MaxEastPosition;
-        LongitudeBinary = temp / 180;
-    }
-    else                // West
-    {
-        temp = Longitude * MaxWestPosition;
-        LongitudeBinary = temp / 180;
-    }
+    return GpsFix.HasFix;
 }
 
-void GpsConvertPositionFromStringToNumerical( void )
+void GpsGetLatestFix( GpsFix_t *fix )
 {
-    int i;
-
-    double valueTmp1;
-    double valueTmp2;
-    double valueTmp3;
-    double valueTmp4;
-
-    // Convert the latitude from ASCII to uint8_t values
-    for( i = 0 ; i < 10 ; i++ )
-    {
-        NmeaGpsData.NmeaLatitude[i] = NmeaGpsData.NmeaLatitude[i] & 0xF;
-    }
-    // Convert latitude from degree/minute/second (DMS) format into decimal
-    valueTmp1 = ( double )NmeaGpsData.NmeaLatitude[0] * 10.0 + ( double )NmeaGpsData.NmeaLatitude[1];
-    valueTmp2 = ( double )NmeaGpsData.NmeaLatitude[2] * 10.0 + ( double )NmeaGpsData.NmeaLatitude[3];
-    valueTmp3 = ( double )NmeaGpsData.NmeaLatitude[5] * 1000.0 + ( double )NmeaGpsData.NmeaLatitude[6] * 100.0 +
-                ( double )NmeaGpsData.NmeaLatitude[7] * 10.0 + ( double )NmeaGpsData.NmeaLatitude[8];
-
-    Latitude = valueTmp1 + ( ( valueTmp2 + ( valueTmp3 * 0.0001 ) ) / 60.0 );
-
-    if( NmeaGpsData.NmeaLatitudePole[0] == 'S' )
-    {
-        Latitude *= -1;
-    }
-
-    // Convert the longitude from ASCII to uint8_t values
-    for( i = 0 ; i < 10 ; i++ )
-    {
-        NmeaGpsData.NmeaLongitude[i] = NmeaGpsData.NmeaLongitude[i] & 0xF;
-    }
-    // Convert longitude from degree/minute/second (DMS) format into decimal
-    valueTmp1 = ( double )NmeaGpsData.NmeaLongitude[0] * 100.0 + ( double )NmeaGpsData.NmeaLongitude[1] * 10.0 + ( double )NmeaGpsData.NmeaLongitude[2];
-    valueTmp2 = ( double )NmeaGpsData.NmeaLongitude[3] * 10.0 + ( double )NmeaGpsData.NmeaLongitude[4];
-    valueTmp3 = ( double )NmeaGpsData.NmeaLongitude[6] * 1000.0 + ( double )NmeaGpsData.NmeaLongitude[7] * 100;
-    valueTmp4 = ( double )NmeaGpsData.NmeaLongitude[8] * 10.0 + ( double )NmeaGpsData.NmeaLongitude[9];
-
-    Longitude = valueTmp1 + ( valueTmp2 / 60.0 ) + ( ( ( valueTmp3 + valueTmp4 ) * 0.0001 ) / 60.0 );
-
-    if( NmeaGpsData.NmeaLongitudePole[0] == 'W' )
-    {
-        Longitude *= -1;
-    }
+    CRITICAL_SECTION_BEGIN( );
+    *fix = GpsFix;
+    CRITICAL_SECTION_END( );
 }
 
-
 uint8_t GpsGetLatestGpsPositionDouble( double *lati, double *longi )
 {
     uint8_t status = FAIL;
-    if( HasFix == true )
+    int32_t latitude;
+    int32_t longitude;
+
+    CRITICAL_SECTION_BEGIN( );
+    if( GpsFix.HasFix == true )
     {
         status = SUCCESS;
     }
@@ -195,17 +217,23 @@ uint8_t GpsGetLatestGpsPositionDouble( double *lati, double *longi )
     {
         GpsResetPosition( );
     }
-    *lati = Latitude;
-    *longi = Longitude;
+    latitude = GpsFix.Latitude;
+    longitude = GpsFix.Longitude;
+    CRITICAL_SECTION_END( );
+
+    *lati = ( double )latitude / NMEA_DEGREE_SCALE;
+    *longi = ( double )longitude / NMEA_DEGREE_SCALE;
     return status;
 }
 
 uint8_t GpsGetLatestGpsPositionBinary( int32_t *latiBin, int32_t *longiBin )
 {
     uint8_t status = FAIL;
+    int32_t latitude;
+    int32_t longitude;
 
     CRITICAL_SECTION_BEGIN( );
-    if( HasFix == true )
+    if( GpsFix.HasFix == true )
     {
         status = SUCCESS;
     }
@@ -213,446 +241,461 @@ uint8_t GpsGetLatestGpsPositionBinary( int32_t *latiBin, int32_t *longiBin )
     {
         GpsResetPosition( );
     }
-    *latiBin = LatitudeBinary;
-    *longiBin = LongitudeBinary;
+    latitude = GpsFix.Latitude;
+    longitude = GpsFix.Longitude;
     CRITICAL_SECTION_END( );
+
+    *latiBin = ( int32_t )( ( int64_t )latitude * ( ( latitude >= 0 ) ? MaxNorthPosition : MaxSouthPosition ) / ( 90LL * NMEA_DEGREE_SCALE ) );
+    *longiBin = ( int32_t )( ( int64_t )longitude * ( ( longitude >= 0 ) ? MaxEastPosition : MaxWestPosition ) / ( 180LL * NMEA_DEGREE_SCALE ) );
     return status;
 }
 
 int16_t GpsGetLatestGpsAltitude( void )
 {
+    int16_t altitude = ( int16_t )0xFFFF;
+
     CRITICAL_SECTION_BEGIN( );
-    if( HasFix == true )
-    {
-        Altitude = atoi( NmeaGpsData.NmeaAltitude );
-    }
-    else
+    if( GpsFix.HasFix == true )
     {
-        Altitude = ( int16_t )0xFFFF;
+        altitude = ( int16_t )( GpsFix.Altitude / 10 );
     }
     CRITICAL_SECTION_END( );
 
-    return Altitude;
+    return altitude;
 }
 
 /*!
- * Calculates the checksum for a NMEA sentence
+ * \brief Converts an hexadecimal character into its value
  *
- * Skip the first '$' if necessary and calculate checksum until '*' character is
- * reached (or buffSize exceeded).
- *
- * \retval chkPosIdx Position of the checksum in the sentence
+ * \retval value [0..15], -1 for non hexadecimal characters
  */
-int32_t GpsNmeaChecksum( int8_t *nmeaStr, int32_t nmeaStrSize, int8_t * checksum )
+static int8_t NmeaHexCharToNibble( uint8_t c )
 {
-    int i = 0;
-    uint8_t checkNum = 0;
-
-    // Check input parameters
-    if( ( nmeaStr == NULL ) || ( checksum == NULL ) || ( nmeaStrSize <= 1 ) )
+    if( ( c >= '0' ) && ( c <= '9' ) )
     {
-        return -1;
+        return c - '0';
     }
-
-    // Skip the first '$' if necessary
-    if( nmeaStr[i] == '$' )
+    if( ( c >= 'A' ) && ( c <= 'F' ) )
     {
-        i += 1;
+        return c - 'A' + 10;
     }
-
-    // XOR until '*' or max length is reached
-    while( nmeaStr[i] != '*' )
+    if( ( c >= 'a' ) && ( c <= 'f' ) )
     {
-        checkNum ^= nmeaStr[i];
-        i += 1;
-        if( i >= nmeaStrSize )
-        {
-            return -1;
-        }
+        return c - 'a' + 10;
     }
-
-    // Convert checksum value to 2 hexadecimal characters
-    checksum[0] = Nibble2HexChar( checkNum / 16 ); // upper nibble
-    checksum[1] = Nibble2HexChar( checkNum % 16 ); // lower nibble
-
-    return i + 1;
+    return -1;
 }
 
 /*!
- * Calculate the checksum of a NMEA frame and compare it to the checksum that is
- * present at the end of it.
- * Return true if it matches
+ * \brief Gets the current field value with the given number of fractional
+ *        digits. Extra digits are truncated, missing digits are zero padded.
+ *
+ * \param [IN]  fracDigits Number of fractional digits of the result
+ * \param [OUT] value      Scaled absolute value of the field
+ *
+ * \retval status [true: valid number, false: empty or invalid field]
  */
-static bool GpsNmeaValidateChecksum( int8_t *serialBuff, int32_t buffSize )
+static bool NmeaGetFieldValue( uint8_t fracDigits, uint32_t *value )
 {
-    int32_t checksumIndex;
-    int8_t checksum[2]; // 2 characters to calculate NMEA checksum
-
-    checksumIndex = GpsNmeaChecksum( serialBuff, buffSize, checksum );
+    uint32_t v = NmeaParser.FieldValue;
+    uint8_t digits = NmeaParser.FieldFracDigits;
 
-    // could we calculate a verification checksum ?
-    if( checksumIndex < 0 )
+    if( ( NmeaParser.FieldLength == 0 ) || ( NmeaParser.FieldOverflow == true ) )
     {
         return false;
     }
-
-    // check if there are enough char in the serial buffer to read checksum
-    if( checksumIndex >= ( buffSize - 2 ) )
+    for( ; digits > fracDigits; digits-- )
     {
-        return false;
+        v /= 10;
     }
+    for( ; digits < fracDigits; digits++ )
+    {
+        if( v > ( UINT32_MAX / 10 ) )
+        {
+            return false;
+        }
+        v *= 10;
+    }
+    *value = v;
+    return true;
+}
 
-    // check the checksum
-    if( ( serialBuff[checksumIndex] == checksum[0] ) && ( serialBuff[checksumIndex + 1] == checksum[1] ) )
+/*!
+ * \brief Converts the current ( d )ddmm.mmmm field into 1e-7 degrees
+ *
+ * \param [OUT] position Absolute position in 1e-7 degrees
+ *
+ * \retval status [true: valid position, false: empty or invalid field]
+ */
+static bool NmeaGetFieldPosition( int32_t *position )
+{
+    uint32_t v;
+    uint32_t degrees;
+    uint32_t minutes;
+
+    if( NmeaGetFieldValue( NMEA_MINUTES_FRAC_DIGITS, &v ) == false )
     {
-        return true;
+        return false;
     }
-    else
+    // 100 minutes units per degree in the integer part
+    degrees = v / 10000000;
+    minutes = v % 10000000;
+    if( ( degrees > 180 ) || ( minutes >= 6000000 ) )
     {
         return false;
     }
+    // 1e-5 minutes to 1e-7 degrees: * 100 / 60, rounded
+    *position = ( int32_t )( degrees * NMEA_DEGREE_SCALE + ( minutes * 5 + 1 ) / 3 );
+    return true;
 }
 
-uint8_t GpsParseGpsData( int8_t *rxBuffer, int32_t rxBufferSize )
+/*!
+ * \brief Identifies the sentence from the address field formatter
+ */
+static NmeaSentence_t NmeaGetSentence( void )
 {
-    uint8_t i = 1;
-    uint8_t j = 0;
-    uint8_t fieldSize = 0;
-
-    if( rxBuffer[0] != '$' )
+    static const struct
     {
-        GpsMcuInvertPpsTrigger( );
-        return FAIL;
+        char Formatter[3];
+        NmeaSentence_t Sentence;
+    }sentences[] =
+    {
+        { { 'G', 'G', 'A' }, NMEA_SENTENCE_GGA },
+        { { 'R', 'M', 'C' }, NMEA_SENTENCE_RMC },
+        { { 'G', 'S', 'A' }, NMEA_SENTENCE_GSA },
+        { { 'V', 'T', 'G' }, NMEA_SENTENCE_VTG },
+    };
+
+    // The talker identifier is ignored. GP, GL, GA, GB and GN talkers are accepted.
+    if( NmeaParser.FieldLength != 5 )
+    {
+        return NMEA_SENTENCE_NONE;
     }
-
-    if( GpsNmeaValidateChecksum( rxBuffer, rxBufferSize ) == false )
+    for( uint8_t i = 0; i < ( sizeof( sentences ) / sizeof( sentences[0] ) ); i++ )
     {
-        return FAIL;
+        if( ( NmeaParser.Formatter[0] == sentences[i].Formatter[0] ) &&
+            ( NmeaParser.Formatter[1] == sentences[i].Formatter[1] ) &&
+            ( NmeaParser.Formatter[2] == sentences[i].Formatter[2] ) )
+        {
+            return sentences[i].Sentence;
+        }
     }
+    return NMEA_SENTENCE_NONE;
+}
 
-    fieldSize = 0;
-    while( rxBuffer[i + fieldSize++] != ',' )
+/*!
+ * \brief Decodes a latitude or longitude field pair. The position field is
+ *        immediately followed by its hemisphere field.
+ *
+ * \param [IN] positionField Index of the position field
+ * \param [IN] negativePole  Hemisphere character of the negative positions
+ * \param [IN] position      Position to be updated
+ */
+static void NmeaDecodePosition( uint8_t positionField, char negativePole, int32_t *position )
+{
+    if( NmeaParser.FieldIndex == positionField )
     {
-        if( fieldSize > 6 )
+        if( NmeaGetFieldPosition( position ) == false )
         {
-            return FAIL;
+            *position = 0;
         }
     }
-    for( j = 0; j < fieldSize; j++, i++ )
+    else if( ( NmeaParser.FieldIndex == ( positionField + 1 ) ) && ( NmeaParser.FieldChar == negativePole ) )
     {
-        NmeaGpsData.NmeaDataType[j] = rxBuffer[i];
+        *position = -*position;
     }
-    // Parse the GPGGA data
-    if( strncmp( ( const char* )NmeaGpsData.NmeaDataType, ( const char* )NmeaDataTypeGPGGA, 5 ) == 0 )
+}
+
+/*!
+ * \brief Decodes the field which has just been received into the pending fix
+ */
+static void NmeaDecodeField( void )
+{
+    GpsFix_t *fix = &NmeaParser.Fix;
+    uint32_t value = 0;
+
+    if( NmeaParser.FieldIndex == 0 )
     {
-        // NmeaUtcTime
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 11 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaUtcTime[j] = rxBuffer[i];
-        }
-        // NmeaLatitude
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 10 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLatitude[j] = rxBuffer[i];
-        }
-        // NmeaLatitudePole
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLatitudePole[j] = rxBuffer[i];
-        }
-        // NmeaLongitude
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 11 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLongitude[j] = rxBuffer[i];
-        }
-        // NmeaLongitudePole
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLongitudePole[j] = rxBuffer[i];
-        }
-        // NmeaFixQuality
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaFixQuality[j] = rxBuffer[i];
-        }
-        // NmeaSatelliteTracked
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 3 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaSatelliteTracked[j] = rxBuffer[i];
-        }
-        // NmeaHorizontalDilution
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 6 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaHorizontalDilution[j] = rxBuffer[i];
-        }
-        // NmeaAltitude
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
+        NmeaParser.Sentence = NmeaGetSentence( );
+        return;
+    }
+
+    switch( NmeaParser.Sentence )
+    {
+        case NMEA_SENTENCE_GGA:
         {
-            if( fieldSize > 8 )
+            NmeaDecodePosition( 2, 'S', &fix->Latitude );
+            NmeaDecodePosition( 4, 'W', &fix->Longitude );
+            switch( NmeaParser.FieldIndex )
             {
-                return FAIL;
+                case 1:
+                    if( NmeaGetFieldValue( 0, &value ) == true )
+                    {
+                        fix->UtcTime = value;
+                    }
+                    break;
+                case 6:
+                    fix->FixQuality = ( NmeaParser.FieldLength != 0 ) ? ( NmeaParser.FieldChar - '0' ) : 0;
+                    fix->HasFix = ( fix->FixQuality > 0 ) ? true : false;
+                    break;
+                case 7:
+                    fix->SatellitesTracked = ( NmeaGetFieldValue( 0, &value ) == true ) ? value : 0;
+                    break;
+                case 8:
+                    fix->Hdop = ( NmeaGetFieldValue( 2, &value ) == true ) ? value : 0;
+                    break;
+                case 9:
+                    fix->Altitude = ( NmeaGetFieldValue( 1, &value ) == true ) ? ( int32_t )value : 0;
+                    if( NmeaParser.FieldIsNegative == true )
+                    {
+                        fix->Altitude = -fix->Altitude;
+                    }
+                    break;
+                default:
+                    break;
             }
+            break;
         }
-        for( j = 0; j < fieldSize; j++, i++ )
+        case NMEA_SENTENCE_RMC:
         {
-            NmeaGpsData.NmeaAltitude[j] = rxBuffer[i];
-        }
-        // NmeaAltitudeUnit
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
+            NmeaDecodePosition( 3, 'S', &fix->Latitude );
+            NmeaDecodePosition( 5, 'W', &fix->Longitude );
+            switch( NmeaParser.FieldIndex )
             {
-                return FAIL;
+                case 1:
+                    if( NmeaGetFieldValue( 0, &value ) == true )
+                    {
+                        fix->UtcTime = value;
+                    }
+                    break;
+                case 2:
+                    fix->HasFix = ( NmeaParser.FieldChar == 'A' ) ? true : false;
+                    break;
+                case 7:
+                    // Knots to 0.1 km/h
+                    fix->Speed = ( NmeaGetFieldValue( 2, &value ) == true ) ? ( value * 1852 + 5000 ) / 10000 : 0;
+                    break;
+                case 8:
+                    fix->Course = ( NmeaGetFieldValue( 2, &value ) == true ) ? value : 0;
+                    break;
+                case 9:
+                    if( NmeaGetFieldValue( 0, &value ) == true )
+                    {
+                        fix->Date = value;
+                    }
+                    break;
+                default:
+                    break;
             }
+            break;
         }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaAltitudeUnit[j] = rxBuffer[i];
-        }
-        // NmeaHeightGeoid
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
+        case NMEA_SENTENCE_GSA:
         {
-            if( fieldSize > 8 )
+            switch( NmeaParser.FieldIndex )
             {
-                return FAIL;
+                case 2:
+                    fix->FixMode = ( NmeaParser.FieldLength != 0 ) ? ( NmeaParser.FieldChar - '0' ) : 0;
+                    break;
+                case 15:
+                    fix->Pdop = ( NmeaGetFieldValue( 2, &value ) == true ) ? value : 0;
+                    break;
+                case 16:
+                    fix->Hdop = ( NmeaGetFieldValue( 2, &value ) == true ) ? value : 0;
+                    break;
+                case 17:
+                    fix->Vdop = ( NmeaGetFieldValue( 2, &value ) == true ) ? value : 0;
+                    break;
+                default:
+                    break;
             }
+            break;
         }
-        for( j = 0; j < fieldSize; j++, i++ )
+        case NMEA_SENTENCE_VTG:
         {
-            NmeaGpsData.NmeaHeightGeoid[j] = rxBuffer[i];
-        }
-        // NmeaHeightGeoidUnit
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
+            switch( NmeaParser.FieldIndex )
             {
-                return FAIL;
+                case 1:
+                    fix->Course = ( NmeaGetFieldValue( 2, &value ) == true ) ? value : 0;
+                    break;
+                case 7:
+                    fix->Speed = ( NmeaGetFieldValue( 1, &value ) == true ) ? value : 0;
+                    break;
+                default:
+                    break;
             }
+            break;
         }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaHeightGeoidUnit[j] = rxBuffer[i];
-        }
+        default:
+            break;
+    }
+}
+
+/*!
+ * \brief Starts the reception of a new field
+ */
+static void NmeaStartField( void )
+{
+    NmeaParser.FieldLength = 0;
+    NmeaParser.FieldChar = 0;
+    NmeaParser.FieldValue = 0;
+    NmeaParser.FieldFracDigits = 0;
+    NmeaParser.FieldHasDot = false;
+    NmeaParser.FieldIsNegative = false;
+    NmeaParser.FieldOverflow = false;
+}
 
-        GpsFormatGpsData( );
-        return SUCCESS;
+/*!
+ * \brief Accumulates a character of the current field
+ */
+static void NmeaAddFieldChar( uint8_t c )
+{
+    if( NmeaParser.FieldLength == 0 )
+    {
+        NmeaParser.FieldChar = c;
     }
-    else if ( strncmp( ( const char* )NmeaGpsData.NmeaDataType, ( const char* )NmeaDataTypeGPRMC, 5 ) == 0 )
+    if( NmeaParser.FieldLength < UINT8_MAX )
     {
-        // NmeaUtcTime
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 11 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaUtcTime[j] = rxBuffer[i];
-        }
-        // NmeaDataStatus
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaDataStatus[j] = rxBuffer[i];
-        }
-        // NmeaLatitude
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 10 )
-            {
-                return FAIL;
-            }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLatitude[j] = rxBuffer[i];
-        }
-        // NmeaLatitudePole
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
+        NmeaParser.FieldLength++;
+    }
+
+    if( NmeaParser.FieldIndex == 0 )
+    {
+        // Keep the last 3 characters of the address field
+        NmeaParser.Formatter[0] = NmeaParser.Formatter[1];
+        NmeaParser.Formatter[1] = NmeaParser.Formatter[2];
+        NmeaParser.Formatter[2] = c;
+    }
+    else if( ( c >= '0' ) && ( c <= '9' ) )
+    {
+        if( NmeaParser.FieldValue <= NMEA_FIELD_VALUE_MAX )
         {
-            if( fieldSize > 2 )
+            NmeaParser.FieldValue = NmeaParser.FieldValue * 10 + ( c - '0' );
+            if( NmeaParser.FieldHasDot == true )
             {
-                return FAIL;
+                NmeaParser.FieldFracDigits++;
             }
         }
-        for( j = 0; j < fieldSize; j++, i++ )
+        else if( NmeaParser.FieldHasDot == false )
         {
-            NmeaGpsData.NmeaLatitudePole[j] = rxBuffer[i];
+            NmeaParser.FieldOverflow = true;
         }
-        // NmeaLongitude
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
+    }
+    else if( c == '.' )
+    {
+        NmeaParser.FieldHasDot = true;
+    }
+    else if( ( c == '-' ) && ( NmeaParser.FieldLength == 1 ) )
+    {
+        NmeaParser.FieldIsNegative = true;
+    }
+}
+
+NmeaSentence_t GpsParseByte( uint8_t data )
+{
+    int8_t nibble;
+
+    if( data == '$' )
+    {
+        // A sentence start always resynchronizes the parser
+        NmeaParser.State = NMEA_PARSER_STATE_FIELDS;
+        NmeaParser.Sentence = NMEA_SENTENCE_NONE;
+        NmeaParser.Checksum = 0;
+        NmeaParser.FieldIndex = 0;
+        NmeaParser.Fix = GpsFix;
+        NmeaStartField( );
+        return NMEA_SENTENCE_NONE;
+    }
+
+    switch( NmeaParser.State )
+    {
+        case NMEA_PARSER_STATE_FIELDS:
         {
-            if( fieldSize > 11 )
+            if( ( data == ',' ) || ( data == '*' ) )
             {
-                return FAIL;
+                NmeaDecodeField( );
+                if( ( NmeaParser.FieldIndex == 0 ) && ( NmeaParser.Sentence == NMEA_SENTENCE_NONE ) )
+                {
+                    // Unsupported sentence. Skip it.
+                    NmeaParser.State = NMEA_PARSER_STATE_IDLE;
+                    break;
+                }
+                if( data == '*' )
+                {
+                    NmeaParser.State = NMEA_PARSER_STATE_CHECKSUM_HIGH;
+                    break;
+                }
+                if( NmeaParser.FieldIndex < UINT8_MAX )
+                {
+                    NmeaParser.FieldIndex++;
+                }
+                NmeaParser.Checksum ^= data;
+                NmeaStartField( );
             }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLongitude[j] = rxBuffer[i];
-        }
-        // NmeaLongitudePole
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 2 )
+            else if( ( data < ' ' ) || ( data > '~' ) )
             {
-                return FAIL;
+                // Line ended without checksum or corrupted character
+                NmeaParser.State = NMEA_PARSER_STATE_IDLE;
             }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaLongitudePole[j] = rxBuffer[i];
-        }
-        // NmeaSpeed
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 8 )
+            else
             {
-                return FAIL;
+                NmeaParser.Checksum ^= data;
+                NmeaAddFieldChar( data );
             }
+            break;
         }
-        for( j = 0; j < fieldSize; j++, i++ )
+        case NMEA_PARSER_STATE_CHECKSUM_HIGH:
         {
-            NmeaGpsData.NmeaSpeed[j] = rxBuffer[i];
-        }
-        // NmeaDetectionAngle
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
-        {
-            if( fieldSize > 8 )
+            nibble = NmeaHexCharToNibble( data );
+            if( nibble < 0 )
             {
-                return FAIL;
+                NmeaParser.State = NMEA_PARSER_STATE_IDLE;
+                break;
             }
+            NmeaParser.ReceivedChecksum = nibble << 4;
+            NmeaParser.State = NMEA_PARSER_STATE_CHECKSUM_LOW;
+            break;
         }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaDetectionAngle[j] = rxBuffer[i];
-        }
-        // NmeaDate
-        fieldSize = 0;
-        while( rxBuffer[i + fieldSize++] != ',' )
+        case NMEA_PARSER_STATE_CHECKSUM_LOW:
         {
-            if( fieldSize > 8 )
+            nibble = NmeaHexCharToNibble( data );
+            NmeaParser.State = NMEA_PARSER_STATE_IDLE;
+            if( ( nibble < 0 ) || ( ( NmeaParser.ReceivedChecksum | nibble ) != NmeaParser.Checksum ) )
             {
-                return FAIL;
+                break;
             }
-        }
-        for( j = 0; j < fieldSize; j++, i++ )
-        {
-            NmeaGpsData.NmeaDate[j] = rxBuffer[i];
-        }
-
-        GpsFormatGpsData( );
-        return SUCCESS;
-    }
-    else
-    {
-        return FAIL;
+            CRITICAL_SECTION_BEGIN( );
+            GpsFix = NmeaParser.Fix;
+            CRITICAL_SECTION_END( );
+            return NmeaParser.Sentence;
+        }
+        case NMEA_PARSER_STATE_IDLE:
+        default:
+            break;
     }
+    return NMEA_SENTENCE_NONE;
 }
 
-void GpsFormatGpsData( void )
+uint8_t GpsParseGpsData( int8_t *rxBuffer, int32_t rxBufferSize )
 {
-    if( strncmp( ( const char* )NmeaGpsData.NmeaDataType, ( const char* )NmeaDataTypeGPGGA, 5 ) == 0 )
+    if( rxBuffer[0] != '$' )
     {
-        HasFix = ( NmeaGpsData.NmeaFixQuality[0] > 0x30 ) ? true : false;
+        GpsMcuInvertPpsTrigger( );
+        return FAIL;
     }
-    else if ( strncmp( ( const char* )NmeaGpsData.NmeaDataType, ( const char* )NmeaDataTypeGPRMC, 5 ) == 0 )
+
+    for( int32_t i = 0; i < rxBufferSize; i++ )
     {
-        HasFix = ( NmeaGpsData.NmeaDataStatus[0] == 0x41 ) ? true : false;
+        if( GpsParseByte( ( uint8_t )rxBuffer[i] ) != NMEA_SENTENCE_NONE )
+        {
+            return SUCCESS;
+        }
     }
-    GpsConvertPositionFromStringToNumerical( );
-    GpsConvertPositionIntoBinary( );
+    return FAIL;
 }
 
 void GpsResetPosition( void )
 {
-    Altitude = ( int16_t )0xFFFF;
-    Latitude = 0;
-    Longitude = 0;
-    LatitudeBinary = 0;
-    LongitudeBinary = 0;
+    GpsFix.Latitude = 0;
+    GpsFix.Longitude = 0;
+    GpsFix.Altitude = 0;
 }
@@ -31,27 +31,80 @@ extern "C"
 #include <stdint.h>
 #include <stdbool.h>
 
-/* Structure to handle the GPS parsed data in ASCII */
-typedef struct
+/*!
+ * NMEA sentences decoded by the parser
+ */
+typedef enum eNmeaSentence
 {
-    char NmeaDataType[6];
-    char NmeaUtcTime[11];
-    char NmeaDataStatus[2];
-    char NmeaLatitude[10];
-    char NmeaLatitudePole[2];
-    char NmeaLongitude[11];
-    char NmeaLongitudePole[2];
-    char NmeaFixQuality[2];
-    char NmeaSatelliteTracked[3];
-    char NmeaHorizontalDilution[6];
-    char NmeaAltitude[8];
-    char NmeaAltitudeUnit[2];
-    char NmeaHeightGeoid[8];
-    char NmeaHeightGeoidUnit[2];
-    char NmeaSpeed[8];
-    char NmeaDetectionAngle[8];
-    char NmeaDate[8];
-}NmeaGpsData_t;
+    NMEA_SENTENCE_NONE,
+    /*!
+     * Fix data: time, position, fix quality, satellites, HDOP and altitude
+     */
+    NMEA_SENTENCE_GGA,
+    /*!
+     * Recommended minimum data: time, status, position, speed, course, date
+     */
+    NMEA_SENTENCE_RMC,
+    /*!
+     * DOP and active satellites: fix mode, PDOP, HDOP and VDOP
+     */
+    NMEA_SENTENCE_GSA,
+    /*!
+     * Course over ground and ground speed
+     */
+    NMEA_SENTENCE_VTG,
+}NmeaSentence_t;
+
+/*!
+ * GPS fix decoded from the NMEA sentences, in fixed-point units
+ */
+typedef struct sGpsFix
+{
+    /*!
+     * Latitude in 1e-7 degrees. Positive towards north.
+     */
+    int32_t Latitude;
+    /*!
+     * Longitude in 1e-7 degrees. Positive towards east.
+     */
+    int32_t Longitude;
+    /*!
+     * Altitude above mean sea level in decimeters
+     */
+    int32_t Altitude;
+    /*!
+     * UTC time formatted as hhmmss
+     */
+    uint32_t UtcTime;
+    /*!
+     * UTC date formatted as ddmmyy
+     */
+    uint32_t Date;
+    /*!
+     * Speed over ground in 0.1 km/h
+     */
+    uint16_t Speed;
+    /*!
+     * Course over ground in 0.01 degrees
+     */
+    uint16_t Course;
+    /*!
+     * Dilutions of precision in 0.01 units
+     */
+    uint16_t Hdop;
+    uint16_t Pdop;
+    uint16_t Vdop;
+    /*!
+     * GGA fix quality. 0 when there is no fix.
+     */
+    uint8_t FixQuality;
+    /*!
+     * GSA fix mode [1: No fix, 2: 2D fix, 3: 3D fix]
+     */
+    uint8_t FixMode;
+    uint8_t SatellitesTracked;
+    bool HasFix;
+}GpsFix_t;
 
 /*!
  * \brief Initializes the handling of the GPS receiver
@@ -93,16 +146,11 @@ bool GpsGetPpsDetectedState( void );
 bool GpsHasFix( void );
 
 /*!
- * \brief Converts the latest Position (latitude and longitude) into a binary
- *        number
- */
-void GpsConvertPositionIntoBinary( void );
-
-/*!
- * \brief Converts the latest Position (latitude and Longitude) from ASCII into
- *        DMS numerical format
+ * \brief Gets the latest fix decoded from the NMEA sentences
+ *
+ * \param [OUT] fix Latest fix
  */
-void GpsConvertPositionFromStringToNumerical( void );
+void GpsGetLatestFix( GpsFix_t *fix );
 
 /*!
  * \brief Gets the latest Position (latitude and Longitude) as two double values
@@ -127,9 +175,24 @@ uint8_t GpsGetLatestGpsPositionDouble ( double *lati, double *longi );
 uint8_t GpsGetLatestGpsPositionBinary ( int32_t *latiBin, int32_t *longiBin );
 
 /*!
- * \brief Parses the NMEA sentence.
+ * \brief Parses the NMEA data one byte at a time. Can be called from the UART
+ *        interrupt handler.
+ *
+ * \remark The sentence fields are decoded as they are received. The latest fix
+ *         is only updated once the sentence checksum has been validated.
+ *         GGA, RMC, GSA and VTG sentences are decoded, from any talker.
+ *
+ * \param [IN] data Received byte
+ *
+ * \retval sentence Type of the sentence which has just been validated,
+ *                  NMEA_SENTENCE_NONE otherwise
+ */
+NmeaSentence_t GpsParseByte( uint8_t data );
+
+/*!
+ * \brief Parses a buffer holding an NMEA sentence.
  *
- * \remark Only parses GPGGA and GPRMC sentences
+ * \remark Only parses GGA, RMC, GSA and VTG sentences
  *
  * \param [IN] rxBuffer Data buffer to be parsed
  * \param [IN] rxBufferSize Size of data buffer
@@ -145,11 +208,6 @@ uint8_t GpsParseGpsData( int8_t *rxBuffer, int32_t rxBufferSize );
  */
 int16_t GpsGetLatestGpsAltitude( void );
 
-/*!
- * \brief Format GPS data into numeric and binary formats
- */
-void GpsFormatGpsData( void );
-
 /*!
  * \brief Resets the GPS position variables
  */
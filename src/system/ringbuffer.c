@@ -0,0 +1,160 @@
+/*!
+ * \file      ringbuffer.c
+ *
+ * \brief     Lock-free single producer single consumer ring buffer
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \author    Gregory Cristian ( Semtech )
+ */
+#include "utilities.h"
+#include "ringbuffer.h"
+
+/*
+ * The producer publishes the written bytes with a release store of Head and
+ * the consumer publishes the freed bytes with a release store of Tail. Each
+ * side reads the other side counter with an acquire load.
+ */
+
+bool RingBufferInit( RingBuffer_t *rb, uint8_t *buffer, uint16_t size )
+{
+    if( ( size == 0 ) || ( ( size & ( size - 1 ) ) != 0 ) )
+    {
+        return false;
+    }
+    rb->Data = buffer;
+    rb->Size = size;
+    rb->Mask = size - 1;
+    atomic_store_explicit( &rb->Head, 0, memory_order_relaxed );
+    atomic_store_explicit( &rb->Tail, 0, memory_order_release );
+    return true;
+}
+
+bool RingBufferPush( RingBuffer_t *rb, uint8_t data )
+{
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_relaxed );
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_acquire );
+
+    if( ( head - tail ) >= rb->Size )
+    {
+        return false;
+    }
+    rb->Data[head & rb->Mask] = data;
+    atomic_store_explicit( &rb->Head, head + 1, memory_order_release );
+    return true;
+}
+
+uint16_t RingBufferPushN( RingBuffer_t *rb, const uint8_t *data, uint16_t size )
+{
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_relaxed );
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_acquire );
+    uint16_t offset = head & rb->Mask;
+    uint16_t first = 0;
+
+    size = MIN( size, rb->Size - ( head - tail ) );
+    first = MIN( size, rb->Size - offset );
+
+    memcpy1( rb->Data + offset, data, first );
+    memcpy1( rb->Data, data + first, size - first );
+
+    atomic_store_explicit( &rb->Head, head + size, memory_order_release );
+    return size;
+}
+
+bool RingBufferPop( RingBuffer_t *rb, uint8_t *data )
+{
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_relaxed );
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_acquire );
+
+    if( head == tail )
+    {
+        return false;
+    }
+    *data = rb->Data[tail & rb->Mask];
+    atomic_store_explicit( &rb->Tail, tail + 1, memory_order_release );
+    return true;
+}
+
+uint16_t RingBufferPopN( RingBuffer_t *rb, uint8_t *data, uint16_t size )
+{
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_relaxed );
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_acquire );
+    uint16_t offset = tail & rb->Mask;
+    uint16_t first = 0;
+
+    size = MIN( size, head - tail );
+    first = MIN( size, rb->Size - offset );
+
+    memcpy1( data, rb->Data + offset, first );
+    memcpy1( data + first, rb->Data, size - first );
+
+    atomic_store_explicit( &rb->Tail, tail + size, memory_order_release );
+    return size;
+}
+
+uint16_t RingBufferPeek( RingBuffer_t *rb, uint8_t **data )
+{
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_relaxed );
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_acquire );
+    uint16_t offset = tail & rb->Mask;
+
+    *data = rb->Data + offset;
+    return MIN( head - tail, ( uint32_t )( rb->Size - offset ) );
+}
+
+uint16_t RingBufferSkip( RingBuffer_t *rb, uint16_t size )
+{
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_relaxed );
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_acquire );
+
+    size = MIN( size, head - tail );
+    atomic_store_explicit( &rb->Tail, tail + size, memory_order_release );
+    return size;
+}
+
+void RingBufferSetWriteIndex( RingBuffer_t *rb, uint16_t writeIndex )
+{
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_relaxed );
+
+    // Advance by the number of bytes written since the previous call
+    head += ( uint16_t )( writeIndex - head ) & rb->Mask;
+    atomic_store_explicit( &rb->Head, head, memory_order_release );
+}
+
+void RingBufferFlush( RingBuffer_t *rb )
+{
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_acquire );
+
+    atomic_store_explicit( &rb->Tail, head, memory_order_release );
+}
+
+uint16_t RingBufferCount( RingBuffer_t *rb )
+{
+    uint32_t tail = atomic_load_explicit( &rb->Tail, memory_order_acquire );
+    uint32_t head = atomic_load_explicit( &rb->Head, memory_order_acquire );
+
+    return head - tail;
+}
+
+bool IsRingBufferEmpty( RingBuffer_t *rb )
+{
+    return ( RingBufferCount( rb ) == 0 );
+}
+
+bool IsRingBufferFull( RingBuffer_t *rb )
+{
+    return ( RingBufferCount( rb ) >= rb->Size );
+}
@@ -0,0 +1,193 @@
+/*!
+ * \file      ringbuffer.h
+ *
+ * \brief     Lock-free single producer single consumer ring buffer
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \author    Gregory Cristian ( Semtech )
+ *
+ * \remark    One producer and one consumer, typically an interrupt handler
+ *            and the main loop, may use the ring buffer concurrently without
+ *            critical sections. The producer only calls the push functions
+ *            and \ref RingBufferSetWriteIndex. The consumer only calls the
+ *            pop, peek, skip and flush functions.
+ *
+ *            The buffer size must be a power of 2. All the bytes of the
+ *            buffer can be used.
+ */
+#ifndef __RINGBUFFER_H__
+#define __RINGBUFFER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*!
+ * Ring buffer structure
+ */
+typedef struct sRingBuffer
+{
+    /*!
+     * Free running write counter. Only updated by the producer.
+     */
+    _Atomic uint32_t Head;
+    /*!
+     * Free running read counter. Only updated by the consumer.
+     */
+    _Atomic uint32_t Tail;
+    uint8_t *Data;
+    uint16_t Size;
+    uint16_t Mask;
+}RingBuffer_t;
+
+/*!
+ * \brief Initializes the ring buffer
+ *
+ * \param [IN] rb     Pointer to the ring buffer object
+ * \param [IN] buffer Buffer to be used as ring buffer
+ * \param [IN] size   Size of the buffer. Must be a power of 2.
+ *
+ * \retval status     [true: Success, false: size isn't a power of 2]
+ */
+bool RingBufferInit( RingBuffer_t *rb, uint8_t *buffer, uint16_t size );
+
+/*!
+ * \brief Pushes one byte to the ring buffer
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ * \param [IN] data Byte to be pushed
+ *
+ * \retval status   [true: Pushed, false: Ring buffer full]
+ */
+bool RingBufferPush( RingBuffer_t *rb, uint8_t data );
+
+/*!
+ * \brief Pushes as many bytes as possible to the ring buffer
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ * \param [IN] data Bytes to be pushed
+ * \param [IN] size Number of bytes to be pushed
+ *
+ * \retval count    Number of pushed bytes
+ */
+uint16_t RingBufferPushN( RingBuffer_t *rb, const uint8_t *data, uint16_t size );
+
+/*!
+ * \brief Pops one byte from the ring buffer
+ *
+ * \param [IN]  rb   Pointer to the ring buffer object
+ * \param [OUT] data Popped byte
+ *
+ * \retval status    [true: Popped, false: Ring buffer empty]
+ */
+bool RingBufferPop( RingBuffer_t *rb, uint8_t *data );
+
+/*!
+ * \brief Pops up to size bytes from the ring buffer
+ *
+ * \param [IN]  rb   Pointer to the ring buffer object
+ * \param [OUT] data Buffer receiving the popped bytes
+ * \param [IN]  size Maximum number of bytes to be popped
+ *
+ * \retval count     Number of popped bytes
+ */
+uint16_t RingBufferPopN( RingBuffer_t *rb, uint8_t *data, uint16_t size );
+
+/*!
+ * \brief Gets the largest contiguous span of stored bytes, without popping
+ *        them. Used for zero-copy parsing. The bytes are released by
+ *        \ref RingBufferSkip.
+ *
+ * \remark When the stored bytes wrap around the end of the buffer, a second
+ *         call after \ref RingBufferSkip returns the remaining bytes.
+ *
+ * \param [IN]  rb   Pointer to the ring buffer object
+ * \param [OUT] data Points to the first stored byte
+ *
+ * \retval count     Number of contiguous bytes available at data
+ */
+uint16_t RingBufferPeek( RingBuffer_t *rb, uint8_t **data );
+
+/*!
+ * \brief Pops and discards up to size bytes
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ * \param [IN] size Number of bytes to be discarded
+ *
+ * \retval count    Number of discarded bytes
+ */
+uint16_t RingBufferSkip( RingBuffer_t *rb, uint16_t size );
+
+/*!
+ * \brief Adopts the buffer of a circular DMA transfer. The DMA controller is
+ *        the producer and writes the buffer by itself. To be called from the
+ *        DMA half transfer, transfer complete and UART idle interrupts.
+ *
+ * \remark Must be called at least once per DMA buffer wrap. The DMA controller
+ *         overwrites the bytes which have not been popped in time.
+ *
+ * \param [IN] rb         Pointer to the ring buffer object
+ * \param [IN] writeIndex Index of the next byte written by the DMA controller,
+ *                        usually the buffer size minus the DMA remaining
+ *                        transfer count
+ */
+void RingBufferSetWriteIndex( RingBuffer_t *rb, uint16_t writeIndex );
+
+/*!
+ * \brief Discards all the stored bytes
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ */
+void RingBufferFlush( RingBuffer_t *rb );
+
+/*!
+ * \brief Gets the number of stored bytes
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ *
+ * \retval count    Number of stored bytes
+ */
+uint16_t RingBufferCount( RingBuffer_t *rb );
+
+/*!
+ * \brief Checks if the ring buffer is empty
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ *
+ * \retval isEmpty  true: Ring buffer is empty, false Ring buffer is not empty
+ */
+bool IsRingBufferEmpty( RingBuffer_t *rb );
+
+/*!
+ * \brief Checks if the ring buffer is full
+ *
+ * \param [IN] rb   Pointer to the ring buffer object
+ *
+ * \retval isFull   true: Ring buffer is full, false Ring buffer is not full
+ */
+bool IsRingBufferFull( RingBuffer_t *rb );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RINGBUFFER_H__
@@ -0,0 +1,167 @@
+/*!
+ * \file      sha256.c
+ *
+ * \brief     SHA-256 hash implementation ( FIPS 180-4 )
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "sha256.h"
+
+#define ROTR( x, n )                                ( ( ( x ) >> ( n ) ) | ( ( x ) << ( 32 - ( n ) ) ) )
+
+static const uint32_t K[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/*!
+ * Processes one 64 bytes block
+ *
+ * \param [IN] ctx    Pointer to the hashing context
+ * \param [IN] block  Block to be processed
+ */
+static void Sha256Transform( Sha256Ctx_t *ctx, const uint8_t *block )
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+
+    for( uint8_t i = 0; i < 16; i++ )
+    {
+        w[i] = ( ( uint32_t )block[4 * i] << 24 ) | ( ( uint32_t )block[4 * i + 1] << 16 ) |
+               ( ( uint32_t )block[4 * i + 2] << 8 ) | ( ( uint32_t )block[4 * i + 3] );
+    }
+    for( uint8_t i = 16; i < 64; i++ )
+    {
+        uint32_t s0 = ROTR( w[i - 15], 7 ) ^ ROTR( w[i - 15], 18 ) ^ ( w[i - 15] >> 3 );
+        uint32_t s1 = ROTR( w[i - 2], 17 ) ^ ROTR( w[i - 2], 19 ) ^ ( w[i - 2] >> 10 );
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = ctx->State[0];
+    b = ctx->State[1];
+    c = ctx->State[2];
+    d = ctx->State[3];
+    e = ctx->State[4];
+    f = ctx->State[5];
+    g = ctx->State[6];
+    h = ctx->State[7];
+
+    for( uint8_t i = 0; i < 64; i++ )
+    {
+        uint32_t s1 = ROTR( e, 6 ) ^ ROTR( e, 11 ) ^ ROTR( e, 25 );
+        uint32_t ch = ( e & f ) ^ ( ~e & g );
+        uint32_t t1 = h + s1 + ch + K[i] + w[i];
+        uint32_t s0 = ROTR( a, 2 ) ^ ROTR( a, 13 ) ^ ROTR( a, 22 );
+        uint32_t maj = ( a & b ) ^ ( a & c ) ^ ( b & c );
+        uint32_t t2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    ctx->State[0] += a;
+    ctx->State[1] += b;
+    ctx->State[2] += c;
+    ctx->State[3] += d;
+    ctx->State[4] += e;
+    ctx->State[5] += f;
+    ctx->State[6] += g;
+    ctx->State[7] += h;
+}
+
+void Sha256Init( Sha256Ctx_t *ctx )
+{
+    ctx->State[0] = 0x6A09E667;
+    ctx->State[1] = 0xBB67AE85;
+    ctx->State[2] = 0x3C6EF372;
+    ctx->State[3] = 0xA54FF53A;
+    ctx->State[4] = 0x510E527F;
+    ctx->State[5] = 0x9B05688C;
+    ctx->State[6] = 0x1F83D9AB;
+    ctx->State[7] = 0x5BE0CD19;
+    ctx->Length = 0;
+    ctx->BlockLen = 0;
+}
+
+void Sha256Update( Sha256Ctx_t *ctx, const uint8_t *data, uint32_t size )
+{
+    ctx->Length += size;
+
+    while( size > 0 )
+    {
+        if( ( ctx->BlockLen == 0 ) && ( size >= SHA256_BLOCK_SIZE ) )
+        {
+            // Hash full blocks in place
+            Sha256Transform( ctx, data );
+            data += SHA256_BLOCK_SIZE;
+            size -= SHA256_BLOCK_SIZE;
+            continue;
+        }
+        ctx->Block[ctx->BlockLen++] = *data++;
+        size--;
+        if( ctx->BlockLen == SHA256_BLOCK_SIZE )
+        {
+            Sha256Transform( ctx, ctx->Block );
+            ctx->BlockLen = 0;
+        }
+    }
+}
+
+void Sha256Final( Sha256Ctx_t *ctx, uint8_t *digest )
+{
+    uint64_t bitLength = ctx->Length * 8;
+
+    ctx->Block[ctx->BlockLen++] = 0x80;
+    if( ctx->BlockLen > ( SHA256_BLOCK_SIZE - 8 ) )
+    {
+        while( ctx->BlockLen < SHA256_BLOCK_SIZE )
+        {
+            ctx->Block[ctx->BlockLen++] = 0x00;
+        }
+        Sha256Transform( ctx, ctx->Block );
+        ctx->BlockLen = 0;
+    }
+    while( ctx->BlockLen < ( SHA256_BLOCK_SIZE - 8 ) )
+    {
+        ctx->Block[ctx->BlockLen++] = 0x00;
+    }
+    for( int8_t i = 7; i >= 0; i-- )
+    {
+        ctx->Block[ctx->BlockLen++] = ( uint8_t )( bitLength >> ( 8 * i ) );
+    }
+    Sha256Transform( ctx, ctx->Block );
+
+    for( uint8_t i = 0; i < 8; i++ )
+    {
+        digest[4 * i]     = ( uint8_t )( ctx->State[i] >> 24 );
+        digest[4 * i + 1] = ( uint8_t )( ctx->State[i] >> 16 );
+        digest[4 * i + 2] = ( uint8_t )( ctx->State[i] >> 8 );
+        digest[4 * i + 3] = ( uint8_t )( ctx->State[i] );
+    }
+}
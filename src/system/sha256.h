@@ -0,0 +1,81 @@
+/*!
+ * \file      sha256.h
+ *
+ * \brief     SHA-256 hash implementation ( FIPS 180-4 )
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __SHA256_H__
+#define __SHA256_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*!
+ * SHA-256 digest size in bytes
+ */
+#define SHA256_DIGEST_SIZE                          32
+
+/*!
+ * SHA-256 block size in bytes
+ */
+#define SHA256_BLOCK_SIZE                           64
+
+/*!
+ * SHA-256 incremental hashing context
+ */
+typedef struct Sha256Ctx_s
+{
+    uint32_t State[8];
+    uint64_t Length;
+    uint8_t Block[SHA256_BLOCK_SIZE];
+    uint8_t BlockLen;
+}Sha256Ctx_t;
+
+/*!
+ * Initializes the hashing context
+ *
+ * \param [IN] ctx    Pointer to the hashing context
+ */
+void Sha256Init( Sha256Ctx_t *ctx );
+
+/*!
+ * Hashes the given data
+ *
+ * \param [IN] ctx    Pointer to the hashing context
+ * \param [IN] data   Data to be hashed
+ * \param [IN] size   Size of the data
+ */
+void Sha256Update( Sha256Ctx_t *ctx, const uint8_t *data, uint32_t size );
+
+/*!
+ * Computes the final digest. The context must be initialized again before
+ * being reused.
+ *
+ * \param [IN]  ctx    Pointer to the hashing context
+ * \param [OUT] digest SHA-256 digest [SHA256_DIGEST_SIZE bytes]
+ */
+void Sha256Final( Sha256Ctx_t *ctx, uint8_t *digest );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SHA256_H__
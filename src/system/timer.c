@@ -24,6 +24,7 @@
 #include "board.h"
 #include "rtc-board.h"
 #include "timer.h"
+#include "tracepoint.h"
 
 /*!
  * Safely execute call back
@@ -46,6 +47,23 @@
  */
 static TimerEvent_t *TimerListHead = NULL;
 
+/*!
+ * Software extension of the 32 bits RTC timer value to 64 bits
+ */
+static struct
+{
+    uint32_t LastTimerValue;
+    uint32_t NbWraps;
+    /*!
+     * RTC ticks per second, 0 until first needed
+     */
+    uint32_t Frequency;
+    /*!
+     * log2( Frequency ) when the frequency is a power of 2, -1 otherwise
+     */
+    int8_t FrequencyShift;
+}TimerTicksCtx;
+
 /*!
  * \brief Adds or replace the head timer of the list.
  *
@@ -185,6 +203,11 @@ void TimerIrqHandler( void )
     TimerEvent_t* cur;
     TimerEvent_t* next;
 
+    TRACE_POINT_BEGIN( TRACE_POINT_TIMER_IRQ );
+
+    // Keeps track of the RTC timer wrap arounds
+    TimerGetCurrentTicks( );
+
     uint32_t old =  RtcGetTimerContext( );
     uint32_t now =  RtcSetTimerContext( );
     uint32_t deltaContext = now - old; // intentional wrap around
@@ -230,6 +253,8 @@ void TimerIrqHandler( void )
     {
         TimerSetTimeout( TimerListHead );
     }
+
+    TRACE_POINT_END( TRACE_POINT_TIMER_IRQ );
 }
 
 void TimerStop( TimerEvent_t *obj )
@@ -349,6 +374,107 @@ TimerTime_t TimerGetCurrentTime( void )
     return  RtcTick2Ms( now );
 }
 
+TimerTicks_t TimerGetCurrentTicks( void )
+{
+    TimerTicks_t ticks = 0;
+
+    CRITICAL_SECTION_BEGIN( );
+    uint32_t now = RtcGetTimerValue( );
+
+    if( now < TimerTicksCtx.LastTimerValue )
+    {
+        TimerTicksCtx.NbWraps++;
+    }
+    TimerTicksCtx.LastTimerValue = now;
+    ticks = ( ( TimerTicks_t )TimerTicksCtx.NbWraps << 32 ) | now;
+    CRITICAL_SECTION_END( );
+
+    return ticks;
+}
+
+void TimerStartAt( TimerEvent_t *obj, TimerTicks_t deadline )
+{
+    uint32_t ticks = RtcGetMinimumTimeout( );
+
+    TimerStop( obj );
+
+    CRITICAL_SECTION_BEGIN( );
+    TimerTicks_t now = TimerGetCurrentTicks( );
+
+    if( deadline > ( now + ticks ) )
+    {
+        ticks = ( uint32_t )MIN( deadline - now, UINT32_MAX );
+    }
+    obj->Timestamp = ticks;
+    obj->ReloadValue = ticks;
+    TimerStart( obj );
+    CRITICAL_SECTION_END( );
+}
+
+/*!
+ * \brief Gets the RTC timer frequency
+ *
+ * \retval frequency RTC ticks per second
+ */
+static uint32_t TimerGetTicksFrequency( void )
+{
+    if( TimerTicksCtx.Frequency == 0 )
+    {
+        uint32_t frequency = RtcMs2Tick( 1000 );
+
+        TimerTicksCtx.FrequencyShift = -1;
+        if( ( frequency & ( frequency - 1 ) ) == 0 )
+        {
+            TimerTicksCtx.FrequencyShift = 0;
+            while( ( 1UL << TimerTicksCtx.FrequencyShift ) < frequency )
+            {
+                TimerTicksCtx.FrequencyShift++;
+            }
+        }
+        TimerTicksCtx.Frequency = frequency;
+    }
+    return TimerTicksCtx.Frequency;
+}
+
+TimerTicks_t TimerUs2Ticks( uint64_t us )
+{
+    uint32_t frequency = TimerGetTicksFrequency( );
+
+    // Split the conversion to avoid overflowing 64 bits
+    return ( ( us / 1000000 ) * frequency ) + ( ( ( us % 1000000 ) * frequency ) / 1000000 );
+}
+
+uint64_t TimerTicks2Us( TimerTicks_t ticks )
+{
+    uint32_t frequency = TimerGetTicksFrequency( );
+
+    if( TimerTicksCtx.FrequencyShift >= 0 )
+    {
+        return ( ( ticks >> TimerTicksCtx.FrequencyShift ) * 1000000 ) +
+               ( ( ( ticks & ( frequency - 1 ) ) * 1000000 ) >> TimerTicksCtx.FrequencyShift );
+    }
+    return ( ( ticks / frequency ) * 1000000 ) + ( ( ( ticks % frequency ) * 1000000 ) / frequency );
+}
+
+TimerTicks_t TimerMs2Ticks( uint64_t ms )
+{
+    uint32_t frequency = TimerGetTicksFrequency( );
+
+    return ( ( ms / 1000 ) * frequency ) + ( ( ( ms % 1000 ) * frequency ) / 1000 );
+}
+
+uint64_t TimerTicks2Ms( TimerTicks_t ticks )
+{
+    uint32_t frequency = TimerGetTicksFrequency( );
+
+    if( TimerTicksCtx.FrequencyShift >= 0 )
+    {
+        return ( ( ticks >> TimerTicksCtx.FrequencyShift ) * 1000 ) +
+               ( ( ( ticks & ( frequency - 1 ) ) * 1000 ) >> TimerTicksCtx.FrequencyShift );
+    }
+    return ( ( ticks / frequency ) * 1000 ) + ( ( ( ticks % frequency ) * 1000 ) / frequency );
+}
+
 TimerTime_t TimerGetElapsedTime( TimerTime_t past )
 {
     if ( past == 0 )
@@ -362,6 +488,47 @@ TimerTime_t TimerGetElapsedTime( TimerTime_t past )
     return RtcTick2Ms( nowInTicks - pastInTicks );
 }
 
+TimerTime_t TimerGetRemainingTime( TimerEvent_t *obj )
+{
+    uint32_t elapsedTime = 0;
+    uint32_t remainingTime = 0;
+
+    CRITICAL_SECTION_BEGIN( );
+    if( ( obj == NULL ) || ( obj->IsStarted == false ) || ( TimerExists( obj ) == false ) )
+    {
+        CRITICAL_SECTION_END( );
+        return TIMERTIME_T_MAX;
+    }
+
+    // Timestamps are relative to the timer context
+    elapsedTime = RtcGetTimerElapsedTime( );
+    if( obj->Timestamp > elapsedTime )
+    {
+        remainingTime = obj->Timestamp - elapsedTime;
+    }
+    CRITICAL_SECTION_END( );
+
+    return RtcTick2Ms( remainingTime );
+}
+
+TimerTime_t TimerGetNextExpiry( TimerEvent_t **obj )
+{
+    TimerTime_t remainingTime = TIMERTIME_T_MAX;
+
+    CRITICAL_SECTION_BEGIN( );
+    if( obj != NULL )
+    {
+        *obj = TimerListHead;
+    }
+    if( TimerListHead != NULL )
+    {
+        remainingTime = TimerGetRemainingTime( TimerListHead );
+    }
+    CRITICAL_SECTION_END( );
+
+    return remainingTime;
+}
+
 static void TimerSetTimeout( TimerEvent_t *obj )
 {
     int32_t minTicks= RtcGetMinimumTimeout( );
@@ -382,5 +549,7 @@ TimerTime_t TimerTempCompensation( TimerTime_t period, float temperature )
 
 void TimerProcess( void )
 {
+    // Keeps track of the RTC timer wrap arounds
+    TimerGetCurrentTicks( );
     RtcProcess( );
 }
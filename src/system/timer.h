@@ -54,6 +54,11 @@ typedef uint32_t TimerTime_t;
 #define TIMERTIME_T_MAX                             ( ( uint32_t )~0 )
 #endif
 
+/*!
+ * \brief Monotonic timer time in RTC ticks. Doesn't wrap around.
+ */
+typedef uint64_t TimerTicks_t;
+
 /*!
  * \brief Initializes the timer object
  *
@@ -124,6 +129,63 @@ void TimerSetValue( TimerEvent_t *obj, uint32_t value );
  */
 TimerTime_t TimerGetCurrentTime( void );
 
+/*!
+ * \brief Reads the current time in RTC ticks
+ *
+ * \remark The 32 bits RTC timer value is extended in software. The RTC timer
+ *         must not wrap around twice between two calls, which the timer IRQ
+ *         handler and \ref TimerProcess ensure as long as one of them runs
+ *         once per RTC timer period.
+ *
+ * \retval ticks Monotonic time in RTC ticks
+ */
+TimerTicks_t TimerGetCurrentTicks( void );
+
+/*!
+ * \brief Starts the timer object so that it expires at an absolute time
+ *
+ * \remark Unlike \ref TimerSetValue followed by \ref TimerStart, the time
+ *         spent between the computation of the deadline and the timer start
+ *         doesn't delay the expiry. A deadline already passed expires after
+ *         the minimum RTC timeout.
+ *
+ * \param [IN] obj      Structure containing the timer object parameters
+ * \param [IN] deadline Expiry time in RTC ticks, see \ref TimerGetCurrentTicks
+ */
+void TimerStartAt( TimerEvent_t *obj, TimerTicks_t deadline );
+
+/*!
+ * \brief Converts a duration in us to RTC ticks, rounded down
+ *
+ * \param [IN] us Duration in us
+ * \retval ticks  Duration in RTC ticks
+ */
+TimerTicks_t TimerUs2Ticks( uint64_t us );
+
+/*!
+ * \brief Converts a duration in RTC ticks to us, rounded down
+ *
+ * \param [IN] ticks Duration in RTC ticks
+ * \retval us        Duration in us
+ */
+uint64_t TimerTicks2Us( TimerTicks_t ticks );
+
+/*!
+ * \brief Converts a duration in ms to RTC ticks, rounded down
+ *
+ * \param [IN] ms Duration in ms
+ * \retval ticks  Duration in RTC ticks
+ */
+TimerTicks_t TimerMs2Ticks( uint64_t ms );
+
+/*!
+ * \brief Converts a duration in RTC ticks to ms, rounded down
+ *
+ * \param [IN] ticks Duration in RTC ticks
+ * \retval ms        Duration in ms
+ */
+uint64_t TimerTicks2Ms( TimerTicks_t ticks );
+
 /*!
  * \brief Return the Time elapsed since a fix moment in Time
  *
@@ -134,6 +196,26 @@ TimerTime_t TimerGetCurrentTime( void );
  */
 TimerTime_t TimerGetElapsedTime( TimerTime_t past );
 
+/*!
+ * \brief Gets the time remaining before a timer expires
+ *
+ * \param [IN] obj Structure containing the timer object parameters
+ *
+ * \retval time    Remaining time in ms. TIMERTIME_T_MAX when the timer isn't
+ *                 started
+ */
+TimerTime_t TimerGetRemainingTime( TimerEvent_t *obj );
+
+/*!
+ * \brief Gets the next timer to expire
+ *
+ * \param [OUT] obj Next timer to expire. NULL when no timer is started
+ *
+ * \retval time     Remaining time in ms. TIMERTIME_T_MAX when no timer is
+ *                  started
+ */
+TimerTime_t TimerGetNextExpiry( TimerEvent_t **obj );
+
 /*!
  * \brief Computes the temperature compensation for a period of time on a
  *        specific temperature.
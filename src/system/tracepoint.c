@@ -0,0 +1,576 @@
+/*!
+ * \file      tracepoint.c
+ *
+ * \brief     Hot path execution time tracepoints
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stddef.h>
+#include "tracepoint.h"
+
+#if defined( TRACE_POINT_ENABLED )
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include "utilities.h"
+
+#if defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ )
+/*!
+ * Cortex-M3/M4 DWT cycle counter registers
+ */
+#define TRACE_POINT_DEMCR                           ( *( volatile uint32_t* )0xE000EDFC )
+#define TRACE_POINT_DEMCR_TRCENA                    ( 1UL << 24 )
+#define TRACE_POINT_DWT_CTRL                        ( *( volatile uint32_t* )0xE0001000 )
+#define TRACE_POINT_DWT_CTRL_CYCCNTENA              ( 1UL << 0 )
+#define TRACE_POINT_DWT_CYCCNT                      ( *( volatile uint32_t* )0xE0001004 )
+
+/*!
+ * Core clock frequency, maintained by the CMSIS system file
+ */
+extern uint32_t SystemCoreClock;
+#elif defined( __ARM_ARCH_6M__ )
+#include "rtc-board.h"
+
+/*!
+ * Cortex-M0+ SysTick and interrupt control registers
+ */
+#define TRACE_POINT_SYST_CSR                        ( *( volatile uint32_t* )0xE000E010 )
+#define TRACE_POINT_SYST_CSR_TICKINT                ( 1UL << 1 )
+#define TRACE_POINT_SYST_RVR                        ( *( volatile uint32_t* )0xE000E014 )
+#define TRACE_POINT_SYST_CVR                        ( *( volatile uint32_t* )0xE000E018 )
+#define TRACE_POINT_ICSR                            ( *( volatile uint32_t* )0xE000ED04 )
+#define TRACE_POINT_ICSR_PENDSTSET                  ( 1UL << 26 )
+
+/*!
+ * Core clock frequency, maintained by the CMSIS system file
+ */
+extern uint32_t SystemCoreClock;
+
+/*!
+ * Number of SysTick wrap arounds. Only updated by the SysTick interrupt.
+ */
+static volatile uint32_t TracePointSysTickWraps;
+#elif defined( __arm__ )
+#include "rtc-board.h"
+#else
+#include <time.h>
+#endif
+
+static const char* TracePointNames[TRACE_POINT_MAX] =
+{
+    "RadioRxDone",
+    "UnsecureMessage",
+    "MacCommands",
+    "ScheduleTx",
+    "SecureFrame",
+    "NextChannel",
+    "TimerIrq",
+    "Rx1Latency",
+    "Rx2Latency",
+    "ParserData",
+    "SerializerData",
+    "SecureMessage",
+    "IdentifyChannels",
+    "TimeOnAir",
+    "FragDecoder",
+};
+
+/*!
+ * Events ring buffer with a single producer and a single consumer
+ */
+typedef struct sTracePointRing
+{
+    /*!
+     * Free running write counter. Only updated by the producer.
+     */
+    _Atomic uint32_t Head;
+    /*!
+     * Free running read counter. Only updated by the consumer.
+     */
+    _Atomic uint32_t Tail;
+    /*!
+     * Events dropped because the ring was full. Only updated by the producer.
+     */
+    uint32_t Dropped;
+}TracePointRing_t;
+
+/*!
+ * Statistics and events ring, only updated by the outermost writer
+ */
+static TracePointStats_t TracePointStats[TRACE_POINT_MAX];
+static TracePointRing_t TracePointRing;
+static TracePointEvent_t TracePointRingEvents[TRACE_POINT_RING_SIZE];
+
+/*!
+ * Events recorded by the writers which preempted the outermost writer, one
+ * ring per nesting level. Drained by the outermost writer before it returns.
+ */
+static TracePointRing_t TracePointPending[TRACE_POINT_NESTING_MAX];
+static TracePointEvent_t TracePointPendingEvents[TRACE_POINT_NESTING_MAX][TRACE_POINT_PENDING_SIZE];
+
+/*!
+ * Nesting depth of the running writers. The interrupts preempt the writers
+ * in strictly nested order: a preempting writer has returned, and restored
+ * the depth, before the preempted writer resumes. The depth is therefore
+ * updated with plain loads and stores, Cortex-M0+ has no exclusive access
+ * instructions.
+ */
+static _Atomic uint32_t TracePointDepth;
+
+/*!
+ * \brief Increments the writers nesting depth
+ *
+ * \retval depth Depth before the increment. 0 when the caller is the outermost
+ *               writer.
+ */
+static uint32_t TracePointEnter( void )
+{
+    uint32_t depth = atomic_load_explicit( &TracePointDepth, memory_order_relaxed );
+
+    atomic_store_explicit( &TracePointDepth, depth + 1, memory_order_relaxed );
+    // Keeps the shared data accesses after the depth update
+    atomic_signal_fence( memory_order_seq_cst );
+    return depth;
+}
+
+/*!
+ * \brief Pushes an event to a ring buffer. Only called by its producer.
+ */
+static void TracePointPush( TracePointRing_t *ring, TracePointEvent_t *events, uint16_t size, const TracePointEvent_t *event )
+{
+    uint32_t head = atomic_load_explicit( &ring->Head, memory_order_relaxed );
+    uint32_t tail = atomic_load_explicit( &ring->Tail, memory_order_acquire );
+
+    if( ( head - tail ) == size )
+    {
+        // Ring buffer full. Drop the event.
+        ring->Dropped++;
+        return;
+    }
+    events[head & ( size - 1 )] = *event;
+    atomic_store_explicit( &ring->Head, head + 1, memory_order_release );
+}
+
+/*!
+ * \brief Gets the oldest event of a ring buffer without removing it. Only
+ *        called by its consumer.
+ *
+ * \retval event Oldest event, NULL when the ring buffer is empty
+ */
+static const TracePointEvent_t* TracePointPeek( TracePointRing_t *ring, const TracePointEvent_t *events, uint16_t size )
+{
+    uint32_t tail = atomic_load_explicit( &ring->Tail, memory_order_relaxed );
+    uint32_t head = atomic_load_explicit( &ring->Head, memory_order_acquire );
+
+    if( head == tail )
+    {
+        return NULL;
+    }
+    return &events[tail & ( size - 1 )];
+}
+
+/*!
+ * \brief Removes the oldest event of a ring buffer. Only called by its
+ *        consumer, after \ref TracePointPeek.
+ */
+static void TracePointSkip( TracePointRing_t *ring )
+{
+    uint32_t tail = atomic_load_explicit( &ring->Tail, memory_order_relaxed );
+
+    atomic_store_explicit( &ring->Tail, tail + 1, memory_order_release );
+}
+
+/*!
+ * \brief Adds an event to the statistics and to the events ring. Only called
+ *        by the outermost writer.
+ */
+static void TracePointCommit( const TracePointEvent_t *event )
+{
+    TracePointStats_t *stats = &TracePointStats[event->Id];
+    uint8_t bucket = 0;
+
+    // Log2 bucket
+    for( uint32_t v = event->Value; ( v != 0 ) && ( bucket < ( TRACE_POINT_HISTOGRAM_SIZE - 1 ) ); v >>= 1 )
+    {
+        bucket++;
+    }
+
+    stats->Count++;
+    stats->Sum += event->Value;
+    if( event->Value < stats->Min )
+    {
+        stats->Min = event->Value;
+    }
+    if( event->Value > stats->Max )
+    {
+        stats->Max = event->Value;
+    }
+    if( stats->Histogram[bucket] < UINT16_MAX )
+    {
+        stats->Histogram[bucket]++;
+    }
+
+    TracePointPush( &TracePointRing, TracePointRingEvents, TRACE_POINT_RING_SIZE, event );
+}
+
+/*!
+ * \brief Commits the event of the outermost writer and the pending events,
+ *        oldest first, and leaves the outermost writer role
+ *
+ * \param [IN] event Event of the outermost writer. May be NULL.
+ */
+static void TracePointLeave( const TracePointEvent_t *event )
+{
+    const TracePointEvent_t *oldest = NULL;
+    const TracePointEvent_t *pending = NULL;
+    uint8_t oldestLevel = 0;
+    bool isPending = false;
+
+    do
+    {
+        // Each level is in order, but a deeper level may hold older events
+        for( ;; )
+        {
+            oldest = event;
+            oldestLevel = TRACE_POINT_NESTING_MAX;
+            for( uint8_t i = 0; i < TRACE_POINT_NESTING_MAX; i++ )
+            {
+                pending = TracePointPeek( &TracePointPending[i], TracePointPendingEvents[i], TRACE_POINT_PENDING_SIZE );
+                if( ( pending != NULL ) &&
+                    ( ( oldest == NULL ) || ( ( int32_t )( pending->Timestamp - oldest->Timestamp ) < 0 ) ) )
+                {
+                    oldest = pending;
+                    oldestLevel = i;
+                }
+            }
+            if( oldest == NULL )
+            {
+                break;
+            }
+            TracePointCommit( oldest );
+            if( oldestLevel < TRACE_POINT_NESTING_MAX )
+            {
+                TracePointSkip( &TracePointPending[oldestLevel] );
+            }
+            else
+            {
+                event = NULL;
+            }
+        }
+
+        atomic_signal_fence( memory_order_seq_cst );
+        atomic_store_explicit( &TracePointDepth, 0, memory_order_relaxed );
+        atomic_signal_fence( memory_order_seq_cst );
+
+        // A writer may have preempted the drain after its level was emptied
+        isPending = false;
+        for( uint8_t i = 0; i < TRACE_POINT_NESTING_MAX; i++ )
+        {
+            if( atomic_load_explicit( &TracePointPending[i].Head, memory_order_acquire ) !=
+                atomic_load_explicit( &TracePointPending[i].Tail, memory_order_relaxed ) )
+            {
+                isPending = true;
+            }
+        }
+        if( isPending == true )
+        {
+            // Take the role back. The depth is 0 again once the preempting
+            // writers have returned.
+            TracePointEnter( );
+        }
+    }while( isPending == true );
+}
+
+void TracePointInit( void )
+{
+#if defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ )
+    TRACE_POINT_DEMCR |= TRACE_POINT_DEMCR_TRCENA;
+    TRACE_POINT_DWT_CYCCNT = 0;
+    TRACE_POINT_DWT_CTRL |= TRACE_POINT_DWT_CTRL_CYCCNTENA;
+#endif
+
+    // Take the outermost writer role. The writers preempting the reset keep
+    // their events pending.
+    TracePointEnter( );
+    memset1( ( uint8_t* )TracePointStats, 0, sizeof( TracePointStats ) );
+    for( uint8_t i = 0; i < TRACE_POINT_MAX; i++ )
+    {
+        TracePointStats[i].Min = UINT32_MAX;
+    }
+    atomic_store_explicit( &TracePointRing.Tail, atomic_load_explicit( &TracePointRing.Head, memory_order_acquire ), memory_order_release );
+    TracePointRing.Dropped = 0;
+    for( uint8_t i = 0; i < TRACE_POINT_NESTING_MAX; i++ )
+    {
+        TracePointPending[i].Dropped = 0;
+    }
+    TracePointLeave( NULL );
+}
+
+uint32_t TracePointGetTicks( void )
+{
+#if defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ )
+    return TRACE_POINT_DWT_CYCCNT;
+#elif defined( __ARM_ARCH_6M__ )
+    uint32_t period = 0;
+    uint32_t wraps = 0;
+    uint32_t isWrapPending = 0;
+    uint32_t value = 0;
+
+    if( ( TRACE_POINT_SYST_CSR & TRACE_POINT_SYST_CSR_TICKINT ) == 0 )
+    {
+        // SysTick doesn't run periodically, e.g. it times busy wait delays
+        return RtcGetTimerValue( );
+    }
+
+    // Read again when the SysTick interrupt ran or the counter wrapped
+    // around in between
+    do
+    {
+        wraps = TracePointSysTickWraps;
+        isWrapPending = TRACE_POINT_ICSR & TRACE_POINT_ICSR_PENDSTSET;
+        value = TRACE_POINT_SYST_CVR;
+    }while( ( wraps != TracePointSysTickWraps ) ||
+            ( isWrapPending != ( TRACE_POINT_ICSR & TRACE_POINT_ICSR_PENDSTSET ) ) );
+
+    if( isWrapPending != 0 )
+    {
+        // The SysTick interrupt is masked or preempted
+        wraps++;
+    }
+    period = TRACE_POINT_SYST_RVR + 1;
+    return wraps * period + ( period - 1 - value );
+#elif defined( __arm__ )
+    return RtcGetTimerValue( );
+#else
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( uint32_t )( ( uint64_t )ts.tv_sec * 1000000000UL + ts.tv_nsec );
+#endif
+}
+
+uint32_t TracePointGetFrequency( void )
+{
+#if defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ )
+    return SystemCoreClock;
+#elif defined( __ARM_ARCH_6M__ )
+    if( ( TRACE_POINT_SYST_CSR & TRACE_POINT_SYST_CSR_TICKINT ) == 0 )
+    {
+        return RtcMs2Tick( 1000 );
+    }
+    return SystemCoreClock;
+#elif defined( __arm__ )
+    return RtcMs2Tick( 1000 );
+#else
+    return 1000000000UL;
+#endif
+}
+
+void TracePointSysTickHandler( void )
+{
+#if defined( __ARM_ARCH_6M__ )
+    TracePointSysTickWraps++;
+#endif
+}
+
+void TracePointRecord( TracePointId_t id, uint32_t value )
+{
+    TracePointEvent_t event;
+    uint32_t depth = 0;
+
+    if( id >= TRACE_POINT_MAX )
+    {
+        return;
+    }
+
+    depth = TracePointEnter( );
+    event.Timestamp = TracePointGetTicks( );
+    event.Value = value;
+    event.Id = id;
+
+    if( depth == 0 )
+    {
+        TracePointLeave( &event );
+        return;
+    }
+
+    // A writer has been preempted while updating the statistics. Only the
+    // writers of this nesting level push to its pending ring.
+    if( depth <= TRACE_POINT_NESTING_MAX )
+    {
+        TracePointPush( &TracePointPending[depth - 1], TracePointPendingEvents[depth - 1], TRACE_POINT_PENDING_SIZE, &event );
+    }
+    atomic_signal_fence( memory_order_seq_cst );
+    atomic_store_explicit( &TracePointDepth, depth, memory_order_relaxed );
+}
+
+const TracePointStats_t* TracePointGetStats( void )
+{
+    return TracePointStats;
+}
+
+uint32_t TracePointGetPercentile( TracePointId_t id, uint8_t percentile )
+{
+    uint32_t total = 0;
+    uint32_t count = 0;
+
+    if( id >= TRACE_POINT_MAX )
+    {
+        return 0;
+    }
+    for( uint8_t i = 0; i < TRACE_POINT_HISTOGRAM_SIZE; i++ )
+    {
+        total += TracePointStats[id].Histogram[i];
+    }
+    if( total == 0 )
+    {
+        return 0;
+    }
+    for( uint8_t i = 0; i < TRACE_POINT_HISTOGRAM_SIZE; i++ )
+    {
+        count += TracePointStats[id].Histogram[i];
+        if( ( count * 100 ) >= ( total * MIN( percentile, 100 ) ) )
+        {
+            if( i == ( TRACE_POINT_HISTOGRAM_SIZE - 1 ) )
+            {
+                return TracePointStats[id].Max;
+            }
+            return MIN( ( 1UL << i ) - 1, TracePointStats[id].Max );
+        }
+    }
+    return TracePointStats[id].Max;
+}
+
+uint8_t TracePointPopEvent( TracePointEvent_t *event )
+{
+    const TracePointEvent_t *oldest = TracePointPeek( &TracePointRing, TracePointRingEvents, TRACE_POINT_RING_SIZE );
+
+    if( oldest == NULL )
+    {
+        return 0;
+    }
+    *event = *oldest;
+    TracePointSkip( &TracePointRing );
+    return 1;
+}
+
+uint32_t TracePointGetDropped( void )
+{
+    uint32_t dropped = TracePointRing.Dropped;
+
+    for( uint8_t i = 0; i < TRACE_POINT_NESTING_MAX; i++ )
+    {
+        dropped += TracePointPending[i].Dropped;
+    }
+    return dropped;
+}
+
+void TracePointDump( void )
+{
+    printf( "###### ========== TRACEPOINTS =========== ######\n" );
+    printf( "Ticks/s     : %lu\n", ( unsigned long )TracePointGetFrequency( ) );
+    printf( "Dropped     : %lu\n", ( unsigned long )TracePointGetDropped( ) );
+    printf( "%-16s %8s %10s %10s %10s %10s %10s\n", "Name", "Count", "Min", "Avg", "P50", "P99", "Max" );
+    for( uint8_t i = 0; i < TRACE_POINT_MAX; i++ )
+    {
+        TracePointStats_t *stats = &TracePointStats[i];
+
+        if( stats->Count == 0 )
+        {
+            continue;
+        }
+        printf( "%-16s %8lu %10lu %10lu %10lu %10lu %10lu\n", TracePointNames[i],
+                ( unsigned long )stats->Count,
+                ( unsigned long )stats->Min,
+                ( unsigned long )( stats->Sum / stats->Count ),
+                ( unsigned long )TracePointGetPercentile( ( TracePointId_t )i, 50 ),
+                ( unsigned long )TracePointGetPercentile( ( TracePointId_t )i, 99 ),
+                ( unsigned long )stats->Max );
+    }
+}
+
+void TracePointDumpCsv( void )
+{
+    printf( "name,count,min,avg,p50,p99,max,ticks_per_s\n" );
+    for( uint8_t i = 0; i < TRACE_POINT_MAX; i++ )
+    {
+        TracePointStats_t *stats = &TracePointStats[i];
+
+        printf( "%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", TracePointNames[i],
+                ( unsigned long )stats->Count,
+                ( unsigned long )( ( stats->Count != 0 ) ? stats->Min : 0 ),
+                ( unsigned long )( ( stats->Count != 0 ) ? ( stats->Sum / stats->Count ) : 0 ),
+                ( unsigned long )TracePointGetPercentile( ( TracePointId_t )i, 50 ),
+                ( unsigned long )TracePointGetPercentile( ( TracePointId_t )i, 99 ),
+                ( unsigned long )stats->Max,
+                ( unsigned long )TracePointGetFrequency( ) );
+    }
+}
+
+#else
+
+void TracePointInit( void )
+{
+}
+
+uint32_t TracePointGetTicks( void )
+{
+    return 0;
+}
+
+uint32_t TracePointGetFrequency( void )
+{
+    return 0;
+}
+
+void TracePointSysTickHandler( void )
+{
+}
+
+void TracePointRecord( TracePointId_t id, uint32_t value )
+{
+}
+
+const TracePointStats_t* TracePointGetStats( void )
+{
+    return NULL;
+}
+
+uint32_t TracePointGetPercentile( TracePointId_t id, uint8_t percentile )
+{
+    return 0;
+}
+
+uint8_t TracePointPopEvent( TracePointEvent_t *event )
+{
+    return 0;
+}
+
+uint32_t TracePointGetDropped( void )
+{
+    return 0;
+}
+
+void TracePointDump( void )
+{
+}
+
+void TracePointDumpCsv( void )
+{
+}
+
+#endif
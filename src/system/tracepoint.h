@@ -0,0 +1,301 @@
+/*!
+ * \file      tracepoint.h
+ *
+ * \brief     Hot path execution time tracepoints
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ *
+ * \remark    The tracepoints are compiled only when TRACE_POINT_ENABLED is
+ *            defined. Otherwise \ref TRACE_POINT_BEGIN, \ref TRACE_POINT_END
+ *            and \ref TRACE_POINT_VALUE expand to nothing.
+ *
+ *            Durations are measured in trace ticks:
+ *            - Cortex-M3/M4: DWT cycle counter ( core clock cycles )
+ *            - Cortex-M0+:   SysTick counter ( core clock cycles ) extended
+ *                            by the wrap arounds counted by
+ *                            \ref TracePointSysTickHandler. RTC timer ticks
+ *                            when the SysTick interrupt isn't enabled.
+ *            - Host builds:  CLOCK_MONOTONIC nanoseconds
+ *
+ *            The recording doesn't mask the interrupts. The outermost writer
+ *            updates the statistics and the events ring buffer. The writers
+ *            preempting it push their events to a ring buffer of their
+ *            nesting level, committed by the outermost writer before it
+ *            returns.
+ */
+#ifndef __TRACEPOINT_H__
+#define __TRACEPOINT_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*!
+ * Number of events kept by the trace ring buffer. Must be a power of 2.
+ *
+ * \remark This parameter has an impact on the memory footprint.
+ */
+#define TRACE_POINT_RING_SIZE                       64
+
+/*!
+ * Number of nesting levels of the writers preempting another writer. Must be
+ * at least the number of interrupt priority levels recording tracepoints,
+ * the events of deeper writers are dropped without being counted.
+ */
+#define TRACE_POINT_NESTING_MAX                     4
+
+/*!
+ * Number of events kept per nesting level until the preempted writer
+ * commits them. Must be a power of 2.
+ *
+ * \remark This parameter has an impact on the memory footprint.
+ */
+#define TRACE_POINT_PENDING_SIZE                    4
+
+/*!
+ * Number of histogram buckets. Bucket n counts the durations in
+ * [2^(n-1), 2^n[ trace ticks. The last bucket counts all longer durations.
+ */
+#define TRACE_POINT_HISTOGRAM_SIZE                  24
+
+/*!
+ * Tracepoints identifiers
+ */
+typedef enum eTracePointId
+{
+    /*!
+     * ProcessRadioRxDone execution time
+     */
+    TRACE_POINT_RADIO_RX_DONE,
+    /*!
+     * LoRaMacCryptoUnsecureMessage execution time
+     */
+    TRACE_POINT_UNSECURE_MESSAGE,
+    /*!
+     * ProcessMacCommands execution time
+     */
+    TRACE_POINT_MAC_COMMANDS,
+    /*!
+     * ScheduleTx execution time
+     */
+    TRACE_POINT_SCHEDULE_TX,
+    /*!
+     * SecureFrame execution time
+     */
+    TRACE_POINT_SECURE_FRAME,
+    /*!
+     * RegionNextChannel execution time
+     */
+    TRACE_POINT_NEXT_CHANNEL,
+    /*!
+     * TimerIrqHandler execution time
+     */
+    TRACE_POINT_TIMER_IRQ,
+    /*!
+     * Delay between the expected and the actual RX1 window opening
+     */
+    TRACE_POINT_RX_WINDOW_1_LATENCY,
+    /*!
+     * Delay between the expected and the actual RX2 window opening
+     */
+    TRACE_POINT_RX_WINDOW_2_LATENCY,
+    /*!
+     * LoRaMacParserData execution time
+     */
+    TRACE_POINT_PARSER_DATA,
+    /*!
+     * LoRaMacSerializerData execution time
+     */
+    TRACE_POINT_SERIALIZER_DATA,
+    /*!
+     * LoRaMacCryptoSecureMessage execution time
+     */
+    TRACE_POINT_SECURE_MESSAGE,
+    /*!
+     * RegionCommonIdentifyChannels execution time
+     */
+    TRACE_POINT_IDENTIFY_CHANNELS,
+    /*!
+     * Radio TimeOnAir execution time
+     */
+    TRACE_POINT_TIME_ON_AIR,
+    /*!
+     * FragDecoderProcess execution time
+     */
+    TRACE_POINT_FRAG_DECODER,
+    /*!
+     * Number of tracepoints
+     */
+    TRACE_POINT_MAX,
+}TracePointId_t;
+
+/*!
+ * Trace ring buffer event
+ */
+typedef struct sTracePointEvent
+{
+    /*!
+     * Trace ticks counter value at the end of the traced section
+     */
+    uint32_t Timestamp;
+    /*!
+     * Measured value in trace ticks
+     */
+    uint32_t Value;
+    /*!
+     * Tracepoint identifier
+     */
+    uint8_t Id;
+}TracePointEvent_t;
+
+/*!
+ * Tracepoint statistics
+ */
+typedef struct sTracePointStats
+{
+    uint32_t Count;
+    uint32_t Min;
+    uint32_t Max;
+    uint64_t Sum;
+    /*!
+     * Log2 histogram of the measured values. Saturates at UINT16_MAX.
+     */
+    uint16_t Histogram[TRACE_POINT_HISTOGRAM_SIZE];
+}TracePointStats_t;
+
+#if defined( TRACE_POINT_ENABLED )
+
+/*!
+ * Starts the measurement of a section. Must be used in the scope of the
+ * matching \ref TRACE_POINT_END.
+ */
+#define TRACE_POINT_BEGIN( id )                     uint32_t tracePointStart##id = TracePointGetTicks( )
+
+/*!
+ * Ends the measurement of a section and records its duration
+ */
+#define TRACE_POINT_END( id )                       TracePointRecord( id, TracePointGetTicks( ) - tracePointStart##id )
+
+/*!
+ * Records a value measured by the caller
+ */
+#define TRACE_POINT_VALUE( id, value )              TracePointRecord( id, value )
+
+#else
+
+#define TRACE_POINT_BEGIN( id )
+#define TRACE_POINT_END( id )
+#define TRACE_POINT_VALUE( id, value )
+
+#endif
+
+/*!
+ * \brief Initializes the trace ticks counter and clears the statistics
+ *
+ * \remark Must be called from the context popping the events
+ */
+void TracePointInit( void );
+
+/*!
+ * \brief Gets the current trace ticks counter value
+ *
+ * \retval ticks Trace ticks counter value
+ */
+uint32_t TracePointGetTicks( void );
+
+/*!
+ * \brief Gets the trace ticks counter frequency
+ *
+ * \retval frequency Number of trace ticks per second
+ */
+uint32_t TracePointGetFrequency( void );
+
+/*!
+ * \brief Counts a SysTick wrap around. Must be called by the SysTick interrupt
+ *        handler of the Cortex-M0+ boards.
+ */
+void TracePointSysTickHandler( void );
+
+/*!
+ * \brief Records a tracepoint value. Can be called from interrupt context.
+ *
+ * \remark Lock-free, the interrupts are not masked
+ *
+ * \param [IN] id    Tracepoint identifier
+ * \param [IN] value Measured value in trace ticks
+ */
+void TracePointRecord( TracePointId_t id, uint32_t value );
+
+/*!
+ * \brief Gets the statistics of all tracepoints
+ *
+ * \retval stats Array of TRACE_POINT_MAX tracepoint statistics. NULL when
+ *               the tracepoints are disabled.
+ */
+const TracePointStats_t* TracePointGetStats( void );
+
+/*!
+ * \brief Computes a percentile from a tracepoint histogram
+ *
+ * \param [IN] id         Tracepoint identifier
+ * \param [IN] percentile Percentile [0..100]
+ *
+ * \retval value Upper bound of the histogram bucket holding the percentile
+ */
+uint32_t TracePointGetPercentile( TracePointId_t id, uint8_t percentile );
+
+/*!
+ * \brief Pops the oldest event of the trace ring buffer. The events recorded
+ *        while the ring buffer is full are dropped.
+ *
+ * \remark Must always be called from the same context
+ *
+ * \param [OUT] event Popped event
+ *
+ * \retval status [0: Empty ring buffer, 1: Event popped]
+ */
+uint8_t TracePointPopEvent( TracePointEvent_t *event );
+
+/*!
+ * \brief Gets the number of dropped events
+ *
+ * \remark The events dropped by a nesting level are missing from the
+ *         statistics as well
+ *
+ * \retval dropped Events dropped because the trace ring buffer or a nesting
+ *                 level ring buffer was full
+ */
+uint32_t TracePointGetDropped( void );
+
+/*!
+ * \brief Prints the tracepoints statistics
+ */
+void TracePointDump( void );
+
+/*!
+ * \brief Prints the tracepoints statistics as CSV records, one per
+ *        tracepoint, for regression tracking. The first line is a header.
+ */
+void TracePointDumpCsv( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TRACEPOINT_H__
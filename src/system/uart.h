@@ -28,7 +28,7 @@ extern "C"
 {
 #endif
 
-#include "fifo.h"
+#include "ringbuffer.h"
 #include "gpio.h"
 
 /*!
@@ -59,8 +59,8 @@ typedef struct
     bool IsInitialized;
     Gpio_t Tx;
     Gpio_t Rx;
-    Fifo_t FifoTx;
-    Fifo_t FifoRx;
+    RingBuffer_t FifoTx;
+    RingBuffer_t FifoRx;
     /*!
      * IRQ user notification callback prototype.
      */
@@ -0,0 +1,291 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host known answer tests of the SHA-256 implementation and of the
+ *            Secure Element incremental AES-CMAC.
+ *
+ *            - SHA-256: FIPS 180-4 examples, see the NIST SHA-256 example
+ *              values, and the SHA-256 vectors of the NIST secure hash
+ *              standard validation system
+ *            - AES-CMAC: RFC 4493 section 4 examples, over the soft-se
+ *              Secure Element
+ *
+ *            Each message is processed in chunks of several sizes to cover
+ *            the block boundaries of the incremental implementations.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utilities.h"
+#include "sha256.h"
+#include "secure-element.h"
+#include "soft-se-hal.h"
+
+/*!
+ * Known answer test vector
+ */
+typedef struct sKatVector
+{
+    const char* Name;
+    /*!
+     * Message, repeated NbRepeats times
+     */
+    const uint8_t* Message;
+    uint32_t Size;
+    uint32_t NbRepeats;
+    const char* Expected;
+}KatVector_t;
+
+/*!
+ * Chunk sizes of the incremental updates. 0 processes the message at once.
+ */
+static const uint32_t ChunkSizes[] = { 0, 1, 3, 15, 16, 17, 55, 63, 64, 65, 1000 };
+
+static const KatVector_t Sha256Vectors[] =
+{
+    {
+        .Name = "empty message",
+        .Message = ( const uint8_t* )"",
+        .Size = 0,
+        .NbRepeats = 1,
+        .Expected = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+    },
+    {
+        .Name = "one block message",
+        .Message = ( const uint8_t* )"abc",
+        .Size = 3,
+        .NbRepeats = 1,
+        .Expected = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+    },
+    {
+        .Name = "two block message",
+        .Message = ( const uint8_t* )"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+        .Size = 56,
+        .NbRepeats = 1,
+        .Expected = "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+    },
+    {
+        .Name = "896-bit message",
+        .Message = ( const uint8_t* )"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+                                     "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+        .Size = 112,
+        .NbRepeats = 1,
+        .Expected = "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1",
+    },
+    {
+        .Name = "one million 'a'",
+        .Message = ( const uint8_t* )"aaaaaaaaaa",
+        .Size = 10,
+        .NbRepeats = 100000,
+        .Expected = "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+    },
+};
+
+/*!
+ * RFC 4493 key and message
+ */
+static const uint8_t CmacKey[SE_KEY_SIZE] =
+{
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+
+static const uint8_t CmacMessage[64] =
+{
+    0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+    0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+    0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+    0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+};
+
+static const KatVector_t CmacVectors[] =
+{
+    {
+        .Name = "example 1, empty message",
+        .Message = CmacMessage,
+        .Size = 0,
+        .NbRepeats = 1,
+        .Expected = "bb1d6929e95937287fa37d129b756746",
+    },
+    {
+        .Name = "example 2, 16 bytes",
+        .Message = CmacMessage,
+        .Size = 16,
+        .NbRepeats = 1,
+        .Expected = "070a16b46b4d4144f79bdd9dd04a287c",
+    },
+    {
+        .Name = "example 3, 40 bytes",
+        .Message = CmacMessage,
+        .Size = 40,
+        .NbRepeats = 1,
+        .Expected = "dfa66747de9ae63030ca32611497c827",
+    },
+    {
+        .Name = "example 4, 64 bytes",
+        .Message = CmacMessage,
+        .Size = 64,
+        .NbRepeats = 1,
+        .Expected = "51f0bebf7e3b9d92fc49741779363cfe",
+    },
+};
+
+/*!
+ * Number of failed tests
+ */
+static uint32_t NbFailures = 0;
+
+/*
+ * soft-se HAL, the unique identifier and random numbers are not used by the
+ * tests
+ */
+void SoftSeHalGetUniqueId( uint8_t *id )
+{
+    memset( id, 0, SE_EUI_SIZE );
+}
+
+uint32_t SoftSeHalGetRandomNumber( void )
+{
+    return 0;
+}
+
+/*!
+ * \brief Gets the next chunk of a repeated message
+ *
+ * \param [IN]  vector    Test vector
+ * \param [IN]  pos       Position in the repeated message
+ * \param [IN]  chunkSize Chunk size, 0 for the whole message
+ * \param [OUT] chunk     Chunk buffer
+ *
+ * \retval size Chunk size
+ */
+static uint32_t GetChunk( const KatVector_t* vector, uint32_t pos, uint32_t chunkSize, uint8_t* chunk )
+{
+    uint32_t total = vector->Size * vector->NbRepeats;
+    uint32_t size = ( chunkSize == 0 ) ? total : chunkSize;
+
+    size = MIN( size, total - pos );
+    size = MIN( size, 1000 );
+    for( uint32_t i = 0; i < size; i++ )
+    {
+        chunk[i] = vector->Message[( pos + i ) % vector->Size];
+    }
+    return size;
+}
+
+static void Check( const char* algorithm, const KatVector_t* vector, uint32_t chunkSize, const uint8_t* result, uint8_t size )
+{
+    char hex[2 * SHA256_DIGEST_SIZE + 1];
+
+    for( uint8_t i = 0; i < size; i++ )
+    {
+        snprintf( &hex[2 * i], 3, "%02x", result[i] );
+    }
+    if( strcmp( hex, vector->Expected ) != 0 )
+    {
+        printf( "FAIL %s %s, chunks of %u bytes: %s\n", algorithm, vector->Name, chunkSize, hex );
+        NbFailures++;
+    }
+}
+
+static void TestSha256( const KatVector_t* vector, uint32_t chunkSize )
+{
+    Sha256Ctx_t ctx;
+    uint8_t chunk[1000];
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    uint32_t total = vector->Size * vector->NbRepeats;
+    uint32_t pos = 0;
+
+    Sha256Init( &ctx );
+    while( pos < total )
+    {
+        uint32_t size = GetChunk( vector, pos, chunkSize, chunk );
+
+        Sha256Update( &ctx, chunk, size );
+        pos += size;
+    }
+    Sha256Final( &ctx, digest );
+    Check( "SHA-256", vector, chunkSize, digest, SHA256_DIGEST_SIZE );
+}
+
+static void TestCmac( const KatVector_t* vector, uint32_t chunkSize )
+{
+    SecureElementCmacCtx_t ctx;
+    uint8_t chunk[1000];
+    uint8_t cmac[SE_CMAC_SIZE];
+    uint32_t cmac32 = 0;
+    uint32_t pos = 0;
+
+    if( SecureElementCmacInit( &ctx, APP_KEY ) != SECURE_ELEMENT_SUCCESS )
+    {
+        NbFailures++;
+        return;
+    }
+    while( pos < vector->Size )
+    {
+        uint32_t size = GetChunk( vector, pos, chunkSize, chunk );
+
+        if( SecureElementCmacUpdate( &ctx, chunk, size ) != SECURE_ELEMENT_SUCCESS )
+        {
+            NbFailures++;
+            return;
+        }
+        pos += size;
+    }
+    if( SecureElementCmacFinal( &ctx, cmac ) != SECURE_ELEMENT_SUCCESS )
+    {
+        NbFailures++;
+        return;
+    }
+    Check( "AES-CMAC", vector, chunkSize, cmac, SE_CMAC_SIZE );
+
+    // The one-shot CMAC returns the first 32 bits
+    SecureElementComputeAesCmac( NULL, ( uint8_t* )vector->Message, vector->Size, APP_KEY, &cmac32 );
+    if( cmac32 != ( ( uint32_t )cmac[3] << 24 | ( uint32_t )cmac[2] << 16 | ( uint32_t )cmac[1] << 8 | cmac[0] ) )
+    {
+        printf( "FAIL AES-CMAC %s: SecureElementComputeAesCmac mismatch\n", vector->Name );
+        NbFailures++;
+    }
+}
+
+/**
+ * Main application entry point.
+ */
+int main( void )
+{
+    uint32_t nbTests = 0;
+
+    SecureElementInit( NULL );
+    SecureElementSetKey( APP_KEY, ( uint8_t* )CmacKey );
+
+    for( uint8_t c = 0; c < sizeof( ChunkSizes ) / sizeof( ChunkSizes[0] ); c++ )
+    {
+        for( uint8_t v = 0; v < sizeof( Sha256Vectors ) / sizeof( Sha256Vectors[0] ); v++ )
+        {
+            TestSha256( &Sha256Vectors[v], ChunkSizes[c] );
+            nbTests++;
+        }
+        for( uint8_t v = 0; v < sizeof( CmacVectors ) / sizeof( CmacVectors[0] ); v++ )
+        {
+            TestCmac( &CmacVectors[v], ChunkSizes[c] );
+            nbTests++;
+        }
+    }
+    printf( "%u tests, %u failures\n", nbTests, NbFailures );
+    return ( NbFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
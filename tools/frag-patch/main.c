@@ -0,0 +1,286 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host round trip of the FragPatch streaming delta patch applier.
+ *
+ *            Sends a patch generated by tools/fragpatch.py as the fragments
+ *            of a session. The fragments are stored in the session storage
+ *            and applied by FragPatchOnProgress, as by the fragmentation
+ *            package. A first session is aborted half way and restarted
+ *            with FragPatchReset. The progress of another session is
+ *            notified along and must be ignored. Every given number of fragments one of them is lost
+ *            and only written, as if recovered by the decoder, once all the
+ *            others are received. FragPatchFinalize then applies the rest of
+ *            the patch. The new image written by the applier is compared to
+ *            the expected one.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utilities.h"
+#include "FragPatch.h"
+
+/*!
+ * Default fragment size
+ */
+#define SIM_FRAG_SIZE                               50
+
+/*!
+ * Fragmentation session receiving the patch
+ */
+#define SIM_FRAG_INDEX                              1
+
+/*!
+ * Reference, patch and expected new images
+ */
+static uint8_t* Reference;
+static uint32_t ReferenceSize;
+static uint8_t* Patch;
+static uint32_t PatchSize;
+static uint8_t* Expected;
+static uint32_t ExpectedSize;
+
+/*!
+ * Session storage of the patch, a whole number of fragments
+ */
+static uint8_t* Storage;
+static uint32_t StorageSize;
+
+/*!
+ * New image written by the applier
+ */
+static uint8_t* Image;
+static uint32_t ImageSize;
+
+/*!
+ * Set when the applier wrote the new image out of order
+ */
+static bool IsOutOfOrder = false;
+
+static uint8_t StorageWrite( uint32_t addr, uint8_t *data, uint32_t size )
+{
+    if( ( addr + size ) > StorageSize )
+    {
+        return -1; // Fail
+    }
+    memcpy( Storage + addr, data, size );
+    return 0; // Success
+}
+
+static uint8_t StorageRead( uint32_t addr, uint8_t *data, uint32_t size )
+{
+    if( ( addr + size ) > StorageSize )
+    {
+        return -1; // Fail
+    }
+    memcpy( data, Storage + addr, size );
+    return 0; // Success
+}
+
+static uint8_t ReferenceRead( uint32_t addr, uint8_t *data, uint32_t size )
+{
+    if( ( addr + size ) > ReferenceSize )
+    {
+        return -1; // Fail
+    }
+    memcpy( data, Reference + addr, size );
+    return 0; // Success
+}
+
+static uint8_t ImageWrite( uint32_t addr, uint8_t *data, uint32_t size )
+{
+    if( addr != ImageSize )
+    {
+        IsOutOfOrder = true;
+    }
+    if( ( addr + size ) > ExpectedSize )
+    {
+        return -1; // Fail
+    }
+    memcpy( Image + addr, data, size );
+    ImageSize = addr + size;
+    return 0; // Success
+}
+
+static FragPatchParams_t FragPatchParams =
+{
+    .PatchCallbacks =
+    {
+        .FragDecoderWrite = StorageWrite,
+        .FragDecoderRead = StorageRead,
+    },
+    .FragIndex = SIM_FRAG_INDEX,
+    .ReferenceRead = ReferenceRead,
+    .ImageWrite = ImageWrite,
+};
+
+static FragPatch_t FragPatch;
+
+/*!
+ * \brief Sets up the fragmentation session, as on FragSessionSetupReq
+ */
+static void OnFragSetup( void )
+{
+    // FragDecoderInit erases the storage
+    for( uint32_t i = 0; i < StorageSize; i++ )
+    {
+        uint8_t erased = 0xFF;
+
+        StorageWrite( i, &erased, 1 );
+    }
+    ImageSize = 0;
+    FragPatchReset( &FragPatch );
+}
+
+/*!
+ * \brief Receives a fragment of the session
+ *
+ * \param [IN] fragCounter Fragment counter
+ * \param [IN] fragNb      Number of fragments
+ * \param [IN] fragSize    Size of fragments
+ * \param [IN] fragNbLost  Number of lost fragments
+ */
+static void OnFragRx( uint16_t fragCounter, uint16_t fragNb, uint8_t fragSize, uint16_t fragNbLost )
+{
+    uint8_t frag[UINT8_MAX] = { 0 };
+    uint32_t addr = ( uint32_t )( fragCounter - 1 ) * fragSize;
+
+    memcpy( frag, Patch + addr, MIN( fragSize, PatchSize - addr ) );
+    StorageWrite( addr, frag, fragSize );
+    // Progress of another session, would apply the erased storage
+    FragPatchOnProgress( &FragPatch, SIM_FRAG_INDEX - 1, fragNb, fragNb, fragSize, 0 );
+    FragPatchOnProgress( &FragPatch, SIM_FRAG_INDEX, fragCounter, fragNb, fragSize, fragNbLost );
+}
+
+static uint8_t* LoadFile( const char* name, uint32_t* size )
+{
+    FILE* file = fopen( name, "rb" );
+    uint8_t* data;
+    long length;
+
+    if( file == NULL )
+    {
+        return NULL;
+    }
+    fseek( file, 0, SEEK_END );
+    length = ftell( file );
+    fseek( file, 0, SEEK_SET );
+    // Never NULL, even for an empty file
+    data = malloc( length + 1 );
+    if( ( data != NULL ) && ( fread( data, 1, length, file ) != ( size_t )length ) )
+    {
+        free( data );
+        data = NULL;
+    }
+    fclose( file );
+    *size = ( uint32_t )length;
+    return data;
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: frag-patch <reference> <patch> <new> [fragment size] [loss period]
+ *
+ * A loss period of N loses every Nth fragment, 0 loses none.
+ */
+int main( int argc, char *argv[] )
+{
+    uint8_t fragSize = SIM_FRAG_SIZE;
+    uint16_t lossPeriod = 0;
+    uint16_t fragNb;
+    uint16_t fragNbLost = 0;
+    uint32_t streamedSize;
+    int32_t status;
+
+    if( argc < 4 )
+    {
+        printf( "Usage: frag-patch <reference> <patch> <new> [fragment size] [loss period]\n" );
+        return EXIT_FAILURE;
+    }
+    if( argc > 4 )
+    {
+        fragSize = ( uint8_t )strtoul( argv[4], NULL, 0 );
+    }
+    if( argc > 5 )
+    {
+        lossPeriod = ( uint16_t )strtoul( argv[5], NULL, 0 );
+    }
+    Reference = LoadFile( argv[1], &ReferenceSize );
+    Patch = LoadFile( argv[2], &PatchSize );
+    Expected = LoadFile( argv[3], &ExpectedSize );
+    if( ( Reference == NULL ) || ( Patch == NULL ) || ( Expected == NULL ) || ( fragSize == 0 ) )
+    {
+        printf( "Invalid arguments\n" );
+        return EXIT_FAILURE;
+    }
+
+    fragNb = ( uint16_t )( ( PatchSize + fragSize - 1 ) / fragSize );
+    StorageSize = ( uint32_t )fragNb * fragSize;
+    Storage = calloc( StorageSize + 1, 1 );
+    Image = calloc( ExpectedSize + 1, 1 );
+
+    FragPatchParams.ReferenceSize = ReferenceSize;
+    FragPatchParams.ImageMaxSize = ExpectedSize;
+    FragPatchInit( &FragPatch, &FragPatchParams );
+
+    // Session aborted half way, restarted by the next setup
+    OnFragSetup( );
+    for( uint16_t fragCounter = 1; fragCounter <= ( fragNb / 2 ); fragCounter++ )
+    {
+        OnFragRx( fragCounter, fragNb, fragSize, 0 );
+    }
+
+    OnFragSetup( );
+    for( uint16_t fragCounter = 1; fragCounter <= fragNb; fragCounter++ )
+    {
+        if( ( lossPeriod != 0 ) && ( ( fragCounter % lossPeriod ) == 0 ) )
+        {
+            fragNbLost++;
+            continue;
+        }
+        OnFragRx( fragCounter, fragNb, fragSize, fragNbLost );
+    }
+    streamedSize = ImageSize;
+
+    // Rows recovered by the decoder
+    for( uint16_t fragCounter = lossPeriod; ( lossPeriod != 0 ) && ( fragCounter <= fragNb ); fragCounter += lossPeriod )
+    {
+        uint8_t frag[UINT8_MAX] = { 0 };
+        uint32_t addr = ( uint32_t )( fragCounter - 1 ) * fragSize;
+
+        memcpy( frag, Patch + addr, MIN( fragSize, PatchSize - addr ) );
+        StorageWrite( addr, frag, fragSize );
+    }
+    status = FragPatchFinalize( &FragPatch, PatchSize );
+
+    printf( "patch %u bytes, %u fragments of %u bytes, %u lost, new image %u bytes, %u written during the session\n",
+            PatchSize, fragNb, fragSize, fragNbLost, ExpectedSize, streamedSize );
+    if( status != ( int32_t )ExpectedSize )
+    {
+        printf( "FragPatchFinalize failed: %d\n", status );
+        return EXIT_FAILURE;
+    }
+    if( ( IsOutOfOrder == true ) || ( ImageSize != ExpectedSize ) || ( memcmp( Image, Expected, ExpectedSize ) != 0 ) )
+    {
+        printf( "New image mismatch\n" );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+#
+# \file      roundtrip.py
+#
+# \brief     Round trip test of tools/fragpatch.py and the FragPatch applier
+#
+# \copyright Revised BSD License, see section \ref LICENSE.
+#
+# \code
+#                ______                              _
+#               / _____)             _              | |
+#              ( (____  _____ ____ _| |_ _____  ____| |__
+#               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+#               _____) ) ____| | | || |_| ____( (___| | | |
+#              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+#              (C)2013-2018 Semtech
+#
+# \endcode
+#
+# Usage:
+#   roundtrip.py <frag-patch executable> <work directory>
+#
+# Generates pairs of reference and new images, diffs them with fragpatch.py
+# and applies the patches with the frag-patch host executable, with and
+# without lost fragments.
+#
+import os
+import random
+import subprocess
+import sys
+
+# Keeps the source tree clean
+sys.dont_write_bytecode = True
+sys.path.insert( 0, os.path.join( os.path.dirname( os.path.abspath( __file__ ) ), '..' ) )
+import fragpatch
+
+# Fragment size and loss period of the simulated sessions
+SESSIONS = ( ( 50, 0 ), ( 50, 7 ), ( 200, 3 ), ( 13, 1 ) )
+
+
+def firmware( rng, size ):
+    # Code like image: a small set of frequent instruction words, literal
+    # pools and zero padding
+    words = [ bytes( rng.randrange( 256 ) for _ in range( 2 ) ) for _ in range( 64 ) ]
+    out = bytearray( )
+    while len( out ) < size:
+        kind = rng.random( )
+        if kind < 0.85:
+            out += rng.choice( words )
+        elif kind < 0.95:
+            out += rng.randrange( 1 << 32 ).to_bytes( 4, 'little' )
+        else:
+            out += bytes( rng.randrange( 4, 32 ) )
+    return bytes( out[:size] )
+
+
+def relink( rng, image, shift ):
+    # Moves the addresses of the literal pools as a linker does when code is
+    # inserted
+    out = bytearray( image )
+    for pos in range( 0, len( out ) - 4, 4 ):
+        if rng.random( ) < 0.05:
+            value = int.from_bytes( out[pos:pos + 4], 'little' )
+            out[pos:pos + 4] = ( ( value + shift ) & 0xFFFFFFFF ).to_bytes( 4, 'little' )
+    return bytes( out )
+
+
+def cases( rng ):
+    ref = firmware( rng, 24 * 1024 )
+    yield 'identical', ref, ref
+    edited = bytearray( ref )
+    for _ in range( 20 ):
+        edited[rng.randrange( len( edited ) )] = rng.randrange( 256 )
+    yield 'byte edits', ref, bytes( edited )
+    pos = len( ref ) // 3
+    yield 'insertion', ref, relink( rng, ref[:pos] + firmware( rng, 700 ) + ref[pos:], 700 )
+    yield 'deletion', ref, relink( rng, ref[:pos] + ref[pos + 1500:], -1500 )
+    yield 'appended', ref, ref + firmware( rng, 3000 )
+    yield 'truncated', ref, ref[:len( ref ) // 2]
+    yield 'unrelated', ref, firmware( rng, 16 * 1024 )
+    yield 'empty', ref, b''
+    yield 'empty reference', b'', firmware( rng, 2000 )
+
+
+def main( argv ):
+    if len( argv ) != 3:
+        sys.stderr.write( 'usage: roundtrip.py <frag-patch executable> <work directory>\n' )
+        return 1
+    os.makedirs( argv[2], exist_ok=True )
+    ref_path = os.path.join( argv[2], 'reference.bin' )
+    new_path = os.path.join( argv[2], 'new.bin' )
+    patch_path = os.path.join( argv[2], 'patch.bin' )
+    failures = 0
+    for name, ref, new in cases( random.Random( 0x5EED ) ):
+        patch = fragpatch.diff( ref, new )
+        if fragpatch.apply( ref, patch ) != new:
+            sys.stdout.write( '%s: fragpatch.py apply mismatch\n' % name )
+            failures += 1
+            continue
+        for path, data in ( ( ref_path, ref ), ( new_path, new ), ( patch_path, patch ) ):
+            with open( path, 'wb' ) as f:
+                f.write( data )
+        sys.stdout.write( '%s: %s patch %d bytes, new image %d bytes\n' % ( name, patch[0:4].decode( ), len( patch ), len( new ) ) )
+        for frag_size, loss_period in SESSIONS:
+            result = subprocess.run( [ argv[1], ref_path, patch_path, new_path, str( frag_size ), str( loss_period ) ],
+                                     stdout=subprocess.PIPE, universal_newlines=True )
+            sys.stdout.write( '  ' + result.stdout.replace( '\n', '\n  ' ).rstrip( ' ' ) )
+            if result.returncode != 0:
+                failures += 1
+    if failures:
+        sys.stdout.write( '%d failures\n' % failures )
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit( main( sys.argv ) )
@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+#
+# \file      fragpatch.py
+#
+# \brief     Generates delta patches for the FragPatch streaming applier
+#
+# \copyright Revised BSD License, see section \ref LICENSE.
+#
+# \code
+#                ______                              _
+#               / _____)             _              | |
+#              ( (____  _____ ____ _| |_ _____  ____| |__
+#               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+#               _____) ) ____| | | || |_| ____( (___| | | |
+#              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+#              (C)2013-2018 Semtech
+#
+# \endcode
+#
+# Usage:
+#   fragpatch.py diff  <reference> <new> <patch>
+#   fragpatch.py apply <reference> <patch> <new>
+#
+# The patch format is described in
+# src/apps/LoRaMac/common/LmHandler/packages/FragPatch.h
+#
+import struct
+import sys
+
+MAGIC = b'LPD1'
+
+# Magic of the patches whose records are compressed with a sliding window
+MAGIC_LZ = b'LPD2'
+
+# Length of the blocks used to find matches in the reference image
+BLOCK_SIZE = 8
+
+# Minimum length of an exact match starting a diff region
+MIN_MATCH = 16
+
+# A diff region is extended while at least half of the bytes of the last
+# WINDOW bytes match the reference
+WINDOW = 16
+
+# Sliding window of the record compression, FRAG_PATCH_WINDOW_SIZE of the
+# applier
+LZ_WINDOW = 256
+
+LZ_MIN_MATCH = 3
+
+LZ_MAX_MATCH = LZ_MIN_MATCH + 255
+
+
+def varint( value ):
+    out = bytearray( )
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append( byte | 0x80 )
+        else:
+            out.append( byte )
+            return bytes( out )
+
+
+def zigzag( value ):
+    return ( value << 1 ) if value >= 0 else ( ( -value << 1 ) - 1 )
+
+
+def compress_diff( diff ):
+    out = bytearray( )
+    i = 0
+    while i < len( diff ):
+        if diff[i] != 0:
+            out.append( diff[i] )
+            i += 1
+            continue
+        run = 1
+        while ( i + run < len( diff ) ) and ( diff[i + run] == 0 ):
+            run += 1
+        out.append( 0 )
+        out += varint( run )
+        i += run
+    return bytes( out )
+
+
+def lz_compress( data ):
+    out = bytearray( )
+    chains = { }
+    flags_pos = 0
+    nb_tokens = 8
+    i = 0
+    while i < len( data ):
+        if nb_tokens == 8:
+            flags_pos = len( out )
+            out.append( 0 )
+            nb_tokens = 0
+        best_len = 0
+        best_dist = 0
+        key = data[i:i + LZ_MIN_MATCH]
+        for candidate in reversed( chains.get( key, [ ] ) ):
+            if i - candidate > LZ_WINDOW:
+                break
+            length = 0
+            while ( i + length < len( data ) ) and ( length < LZ_MAX_MATCH ) and \
+                  ( data[candidate + length] == data[i + length] ):
+                length += 1
+            if length > best_len:
+                best_len = length
+                best_dist = i - candidate
+        if best_len >= LZ_MIN_MATCH:
+            out += bytes( ( best_dist - 1, best_len - LZ_MIN_MATCH ) )
+            step = best_len
+        else:
+            out[flags_pos] |= 1 << nb_tokens
+            out.append( data[i] )
+            step = 1
+        nb_tokens += 1
+        for j in range( i, i + step ):
+            chain = chains.setdefault( data[j:j + LZ_MIN_MATCH], [ ] )
+            chain.append( j )
+            if len( chain ) > 32:
+                chain.pop( 0 )
+        i += step
+    return bytes( out )
+
+
+def lz_decompress( data ):
+    out = bytearray( )
+    pos = 0
+    while pos < len( data ):
+        flags = data[pos]
+        pos += 1
+        for _ in range( 8 ):
+            if pos >= len( data ):
+                break
+            if flags & 1:
+                out.append( data[pos] )
+                pos += 1
+            else:
+                dist = data[pos] + 1
+                length = data[pos + 1] + LZ_MIN_MATCH
+                pos += 2
+                if dist > len( out ):
+                    raise ValueError( 'bad match distance' )
+                for _ in range( length ):
+                    out.append( out[-dist] )
+            flags >>= 1
+    return bytes( out )
+
+
+def find_match( ref, new, pos, index ):
+    best_len = 0
+    best_ref = 0
+    for candidate in index.get( new[pos:pos + BLOCK_SIZE], ( ) ):
+        length = 0
+        while ( pos + length < len( new ) ) and ( candidate + length < len( ref ) ) and \
+              ( new[pos + length] == ref[candidate + length] ):
+            length += 1
+        if length > best_len:
+            best_len = length
+            best_ref = candidate
+    return best_ref, best_len
+
+
+def extend_match( ref, new, pos, ref_pos ):
+    # Extends an exact match with approximate matches, bsdiff style
+    length = 0
+    best = 0
+    score = 0
+    while ( pos + length < len( new ) ) and ( ref_pos + length < len( ref ) ):
+        if new[pos + length] == ref[ref_pos + length]:
+            score += 1
+        if length >= WINDOW and new[pos + length - WINDOW] == ref[ref_pos + length - WINDOW]:
+            score -= 1
+        length += 1
+        if new[pos + length - 1] == ref[ref_pos + length - 1]:
+            best = length
+        if length >= WINDOW and score * 2 < WINDOW:
+            break
+    return best
+
+
+def diff( ref, new ):
+    index = { }
+    for i in range( 0, max( 0, len( ref ) - BLOCK_SIZE + 1 ) ):
+        index.setdefault( ref[i:i + BLOCK_SIZE], [ ] ).append( i )
+        if len( index[ref[i:i + BLOCK_SIZE]] ) > 16:
+            index[ref[i:i + BLOCK_SIZE]].pop( 0 )
+
+    records = [ ]
+    ref_pos = 0
+    pos = 0
+    extra_start = 0
+    while pos <= len( new ):
+        match_ref, match_len = ( 0, 0 )
+        if pos < len( new ):
+            match_ref, match_len = find_match( ref, new, pos, index )
+        if ( match_len < MIN_MATCH ) and ( pos < len( new ) ):
+            pos += 1
+            continue
+        # Bytes between the previous diff region and this match are extra
+        # bytes of the previous record
+        if records:
+            records[-1][1] = new[extra_start:pos]
+        elif pos > 0:
+            records.append( [ b'', new[0:pos], 0 ] )
+        if pos == len( new ):
+            break
+        length = extend_match( ref, new, pos, match_ref )
+        delta = bytes( ( new[pos + i] - ref[match_ref + i] ) & 0xFF for i in range( length ) )
+        records.append( [ delta, b'', match_ref ] )
+        pos += length
+        extra_start = pos
+
+    header = struct.pack( '<II', len( new ), len( ref ) )
+    out = bytearray( )
+    for i, ( delta, extra, start ) in enumerate( records ):
+        # The seek moves the reference pointer to the start of the next diff
+        # region
+        end = start + len( delta ) if delta else ref_pos
+        next_start = records[i + 1][2] if ( i + 1 < len( records ) ) and records[i + 1][0] else end
+        out += varint( len( delta ) ) + varint( len( extra ) ) + varint( zigzag( next_start - end ) )
+        out += compress_diff( delta ) + extra
+        ref_pos = next_start
+    if not records:
+        out += varint( 0 ) + varint( 0 ) + varint( 0 )
+    # The extra bytes of new code and the records of short diff regions are
+    # left as is by the zero run coding. Keeps the smaller of both patches.
+    compressed = lz_compress( bytes( out ) )
+    if len( compressed ) < len( out ):
+        return MAGIC_LZ + header + compressed
+    return MAGIC + header + bytes( out )
+
+
+def read_varint( patch, pos ):
+    value = 0
+    shift = 0
+    while True:
+        byte = patch[pos]
+        pos += 1
+        value |= ( byte & 0x7F ) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def apply( ref, patch ):
+    if patch[0:4] not in ( MAGIC, MAGIC_LZ ):
+        raise ValueError( 'bad magic' )
+    new_size, ref_size = struct.unpack( '<II', patch[4:12] )
+    if patch[0:4] == MAGIC_LZ:
+        patch = patch[0:12] + lz_decompress( patch[12:] )
+    if ref_size != len( ref ):
+        raise ValueError( 'patch generated against another reference' )
+    new = bytearray( )
+    ref_pos = 0
+    pos = 12
+    while len( new ) < new_size:
+        diff_len, pos = read_varint( patch, pos )
+        extra_len, pos = read_varint( patch, pos )
+        seek, pos = read_varint( patch, pos )
+        seek = ( seek >> 1 ) ^ -( seek & 1 )
+        while diff_len > 0:
+            byte = patch[pos]
+            pos += 1
+            run = 1
+            if byte == 0:
+                run, pos = read_varint( patch, pos )
+            for _ in range( run ):
+                new.append( ( ref[ref_pos] + byte ) & 0xFF )
+                ref_pos += 1
+            diff_len -= run
+        new += patch[pos:pos + extra_len]
+        pos += extra_len
+        ref_pos += seek
+    return bytes( new )
+
+
+def main( argv ):
+    if len( argv ) != 5 or argv[1] not in ( 'diff', 'apply' ):
+        sys.stderr.write( __doc__ or 'usage: fragpatch.py diff|apply <in1> <in2> <out>\n' )
+        return 1
+    with open( argv[2], 'rb' ) as f:
+        ref = f.read( )
+    with open( argv[3], 'rb' ) as f:
+        data = f.read( )
+    if argv[1] == 'diff':
+        out = diff( ref, data )
+        if apply( ref, out ) != data:
+            raise RuntimeError( 'patch verification failed' )
+        sys.stdout.write( 'patch size: %d bytes ( %.1f%% of new image )\n' % ( len( out ), 100.0 * len( out ) / max( 1, len( data ) ) ) )
+    else:
+        out = apply( ref, data )
+    with open( argv[4], 'wb' ) as f:
+        f.write( out )
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit( main( sys.argv ) )
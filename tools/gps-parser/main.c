@@ -0,0 +1,253 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host test of the NMEA streaming parser, see gps.h
+ *
+ *            Feeds GGA and RMC sentences byte by byte to GpsParseByte, as
+ *            the UART interrupt handler does, and checks the decoded
+ *            fixed-point fix. A sentence with a wrong checksum or a corrupted
+ *            character must leave the latest fix unchanged. A sentence split
+ *            across two calls must only be committed once its checksum has
+ *            been received, and a sentence cut by a new '$' must be dropped.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "utilities.h"
+#include "gps-board.h"
+#include "gps.h"
+
+/*!
+ * Fix decoded from $GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,...
+ */
+static const GpsFix_t FixGga =
+{
+    .Latitude = 481173000,
+    .Longitude = 115166667,
+    .Altitude = 5454,
+    .UtcTime = 123519,
+    .Hdop = 90,
+    .FixQuality = 1,
+    .SatellitesTracked = 8,
+    .HasFix = true,
+};
+
+/*!
+ * Fix decoded from $GNRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,...
+ * The GGA only fields are kept.
+ */
+static const GpsFix_t FixRmc =
+{
+    .Latitude = -378608333,
+    .Longitude = 1451226667,
+    .Altitude = 5454,
+    .UtcTime = 81836,
+    .Date = 130998,
+    .Speed = 0,
+    .Course = 36000,
+    .Hdop = 90,
+    .FixQuality = 1,
+    .SatellitesTracked = 8,
+    .HasFix = true,
+};
+
+/*!
+ * Fix decoded from $GPGGA,235959.00,0000.00000,S,17959.99999,W,2,12,1.25,-12.5,...
+ * The RMC only fields are kept.
+ */
+static const GpsFix_t FixGgaWest =
+{
+    .Latitude = 0,
+    .Longitude = -1799999998,
+    .Altitude = -125,
+    .UtcTime = 235959,
+    .Date = 130998,
+    .Speed = 0,
+    .Course = 36000,
+    .Hdop = 125,
+    .FixQuality = 2,
+    .SatellitesTracked = 12,
+    .HasFix = true,
+};
+
+/*!
+ * Fix decoded from the same RMC sentence after FixGgaWest
+ */
+static const GpsFix_t FixRmcWest =
+{
+    .Latitude = -378608333,
+    .Longitude = 1451226667,
+    .Altitude = -125,
+    .UtcTime = 81836,
+    .Date = 130998,
+    .Speed = 0,
+    .Course = 36000,
+    .Hdop = 125,
+    .FixQuality = 2,
+    .SatellitesTracked = 12,
+    .HasFix = true,
+};
+
+/*!
+ * Chunk of the NMEA stream fed in one call, with the expected result
+ */
+typedef struct sTestStep
+{
+    const char* Name;
+    const char* Data;
+    /*!
+     * Sentence expected to be validated by the last bytes of the chunk
+     */
+    NmeaSentence_t Sentence;
+    /*!
+     * Expected latest fix after the chunk
+     */
+    const GpsFix_t* Fix;
+}TestStep_t;
+
+static const TestStep_t Steps[] =
+{
+    { "GGA",
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n",
+      NMEA_SENTENCE_GGA, &FixGga },
+    { "RMC, GN talker",
+      "$GNRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*7C\r\n",
+      NMEA_SENTENCE_RMC, &FixRmc },
+    { "GGA, wrong checksum",
+      "$GPGGA,235959.00,0000.00000,S,17959.99999,W,2,12,1.25,-12.5,M,,M,,*5C\r\n",
+      NMEA_SENTENCE_NONE, &FixRmc },
+    { "GGA, corrupted character",
+      "$GPGGA,235959.00,0000.00000,S,17959.99999,W,2,12,1.35,-12.5,M,,M,,*5B\r\n",
+      NMEA_SENTENCE_NONE, &FixRmc },
+    { "GGA, first part",
+      "$GPGGA,235959.00,0000.00000,S,179",
+      NMEA_SENTENCE_NONE, &FixRmc },
+    { "GGA, second part",
+      "59.99999,W,2,12,1.25,-12.5,M,,M,,*5B\r\n",
+      NMEA_SENTENCE_GGA, &FixGgaWest },
+    { "GGA, cut by a new sentence",
+      "$GPGGA,123519,4807.038,N,011",
+      NMEA_SENTENCE_NONE, &FixGgaWest },
+    { "RMC after the cut sentence",
+      "$GNRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E*7C\r\n",
+      NMEA_SENTENCE_RMC, &FixRmcWest },
+};
+
+#define TEST_NB_STEPS                               ( sizeof( Steps ) / sizeof( Steps[0] ) )
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+void GpsMcuInvertPpsTrigger( void )
+{
+}
+
+void GpsMcuInit( void )
+{
+}
+
+void GpsMcuStart( void )
+{
+}
+
+void GpsMcuStop( void )
+{
+}
+
+void GpsMcuProcess( void )
+{
+}
+
+/*!
+ * \brief Compares the latest fix with the expected one
+ *
+ * \retval nbErrors Number of fields which differ
+ */
+static uint32_t CheckFix( const GpsFix_t* fix, const GpsFix_t* expected )
+{
+    uint32_t nbErrors = 0;
+
+#define CHECK_FIX_FIELD( field )                                                    \
+    if( fix->field != expected->field )                                             \
+    {                                                                               \
+        printf( "  %s %ld, expected %ld\n", #field, ( long )fix->field, ( long )expected->field ); \
+        nbErrors++;                                                                 \
+    }
+
+    CHECK_FIX_FIELD( Latitude );
+    CHECK_FIX_FIELD( Longitude );
+    CHECK_FIX_FIELD( Altitude );
+    CHECK_FIX_FIELD( UtcTime );
+    CHECK_FIX_FIELD( Date );
+    CHECK_FIX_FIELD( Speed );
+    CHECK_FIX_FIELD( Course );
+    CHECK_FIX_FIELD( Hdop );
+    CHECK_FIX_FIELD( FixQuality );
+    CHECK_FIX_FIELD( SatellitesTracked );
+    CHECK_FIX_FIELD( HasFix );
+
+#undef CHECK_FIX_FIELD
+
+    return nbErrors;
+}
+
+int main( void )
+{
+    uint32_t nbFailures = 0;
+
+    GpsInit( );
+
+    for( uint8_t i = 0; i < TEST_NB_STEPS; i++ )
+    {
+        NmeaSentence_t sentence = NMEA_SENTENCE_NONE;
+        GpsFix_t fix;
+        uint32_t nbErrors = 0;
+
+        for( const char* c = Steps[i].Data; *c != '\0'; c++ )
+        {
+            NmeaSentence_t validated = GpsParseByte( ( uint8_t )*c );
+
+            if( validated != NMEA_SENTENCE_NONE )
+            {
+                sentence = validated;
+            }
+        }
+
+        GpsGetLatestFix( &fix );
+        if( sentence != Steps[i].Sentence )
+        {
+            printf( "  sentence %d, expected %d\n", sentence, Steps[i].Sentence );
+            nbErrors++;
+        }
+        nbErrors += CheckFix( &fix, Steps[i].Fix );
+        printf( "%-30s %s\n", Steps[i].Name, ( nbErrors == 0 ) ? "ok" : "FAIL" );
+        if( nbErrors != 0 )
+        {
+            nbFailures++;
+        }
+    }
+
+    printf( "%u steps, %lu failures\n", ( unsigned )TEST_NB_STEPS, ( unsigned long )nbFailures );
+    return ( nbFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
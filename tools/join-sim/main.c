@@ -0,0 +1,451 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host simulation of the US915 and AU915 join channel selection.
+ *            Compares the number of join requests and the time needed to
+ *            rejoin after a reboot with and without the join channel learning.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utilities.h"
+#include "timer.h"
+#include "radio.h"
+#include "RegionCommon.h"
+#include "RegionUS915.h"
+#include "RegionAU915.h"
+
+/*!
+ * Number of simulated devices per scenario
+ */
+#define SIM_NB_DEVICES                              500
+
+/*!
+ * Number of joins of each device. The device reboots before each of them,
+ * restoring its region context from the NVM.
+ */
+#define SIM_NB_JOINS                                8
+
+/*!
+ * A join gets abandoned after this number of join requests
+ */
+#define SIM_MAX_JOIN_REQUESTS                       250
+
+/*!
+ * Join request size: MHDR, JoinEUI, DevEUI, DevNonce and MIC
+ */
+#define SIM_JOIN_REQUEST_SIZE                       23
+
+/*!
+ * Time from the end of a join request to the end of the RX2 window, in ms
+ */
+#define SIM_JOIN_RX_WINDOWS_TIME                    7000
+
+/*!
+ * Time the device stays joined between two reboots, in ms
+ */
+#define SIM_UPTIME                                  ( 24 * 3600 * 1000UL )
+
+/*!
+ * Simulated gateways environment
+ */
+typedef struct sSimScenario
+{
+    const char* Name;
+    LoRaMacRegion_t Region;
+    /*!
+     * Sub-bands received by the gateways, bit n for sub-band n
+     */
+    uint8_t SubBands;
+    /*!
+     * Sub-bands received by the gateways once the device joined once. 0 when
+     * the gateways don't change.
+     */
+    uint8_t MovedSubBands;
+    /*!
+     * Probability in percent a join request on a received sub-band gets a
+     * join accept
+     */
+    uint8_t Delivery;
+}SimScenario_t;
+
+/*!
+ * Statistics of the rejoins of a scenario
+ */
+typedef struct sSimStats
+{
+    uint32_t NbJoins;
+    uint32_t NbFailures;
+    uint16_t Requests[SIM_NB_DEVICES * SIM_NB_JOINS];
+    uint32_t Latencies[SIM_NB_DEVICES * SIM_NB_JOINS];
+}SimStats_t;
+
+static const SimScenario_t Scenarios[] =
+{
+    { "US915 sub-band 2",                 LORAMAC_REGION_US915, 0x02, 0x00, 90 },
+    { "US915 sub-bands 1 and 2",          LORAMAC_REGION_US915, 0x03, 0x00, 90 },
+    { "US915 sub-band 2, lossy",          LORAMAC_REGION_US915, 0x02, 0x00, 40 },
+    { "US915 sub-band 7",                 LORAMAC_REGION_US915, 0x40, 0x00, 90 },
+    { "US915 sub-band 2 moved to 3",      LORAMAC_REGION_US915, 0x02, 0x04, 90 },
+    { "US915 sub-band 2 moved to 7",      LORAMAC_REGION_US915, 0x02, 0x40, 90 },
+    { "AU915 sub-band 2",                 LORAMAC_REGION_AU915, 0x02, 0x00, 90 },
+    { "AU915 sub-band 2 moved to 7",      LORAMAC_REGION_AU915, 0x02, 0x40, 90 },
+};
+
+static SimStats_t Stats;
+
+/*!
+ * Virtual clock in ms, monotonic across the simulated reboots
+ */
+static TimerTime_t Now = 1;
+
+/*!
+ * Region context saved in the NVM
+ */
+static uint8_t NvmCtx[1024];
+
+TimerTime_t TimerGetCurrentTime( void )
+{
+    return Now;
+}
+
+TimerTime_t TimerGetElapsedTime( TimerTime_t past )
+{
+    if( past == 0 )
+    {
+        return 0;
+    }
+    return Now - past;
+}
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+/*!
+ * \brief LoRa time on air in ms, the regions only need this radio function
+ */
+static uint32_t SimTimeOnAir( RadioModems_t modem, uint32_t bandwidth, uint32_t datarate, uint8_t coderate,
+                              uint16_t preambleLen, bool fixLen, uint8_t payloadLen, bool crcOn )
+{
+    uint32_t bw = 125000 << bandwidth;
+    bool lowDatareOptimize = ( ( bandwidth == 0 ) && ( datarate >= 11 ) ) ||
+                             ( ( bandwidth == 1 ) && ( datarate == 12 ) );
+    int32_t ceilNumerator = ( payloadLen << 3 ) - ( 4 * datarate ) + 28 + ( crcOn ? 16 : 0 ) - ( fixLen ? 20 : 0 );
+    int32_t ceilDenominator = 4 * ( datarate - ( lowDatareOptimize ? 2 : 0 ) );
+    uint32_t nbSymbols = 0;
+
+    if( ceilNumerator < 0 )
+    {
+        ceilNumerator = 0;
+    }
+    // Symbols in quarters: 4.25 preamble symbols overhead
+    nbSymbols = ( ( preambleLen + 8 ) * 4 + 17 ) +
+                ( ( ( ceilNumerator + ceilDenominator - 1 ) / ceilDenominator ) * ( coderate + 4 ) ) * 4;
+    return ( uint32_t )( ( ( uint64_t )nbSymbols * ( 1 << datarate ) * 1000 / 4 + bw - 1 ) / bw );
+}
+
+const struct Radio_s Radio =
+{
+    .TimeOnAir = SimTimeOnAir,
+};
+
+/*!
+ * \brief Gets the sub-band of a channel
+ */
+static uint8_t GetSubBand( uint8_t channel )
+{
+    return ( channel < 64 ) ? ( channel / 8 ) : ( channel - 64 );
+}
+
+/*!
+ * \brief Gets the time on air of a join request in ms
+ */
+static TimerTime_t GetJoinRequestTimeOnAir( LoRaMacRegion_t region, int8_t dr )
+{
+    const uint8_t* datarates = ( region == LORAMAC_REGION_US915 ) ? DataratesUS915 : DataratesAU915;
+    const uint32_t* bandwidths = ( region == LORAMAC_REGION_US915 ) ? BandwidthsUS915 : BandwidthsAU915;
+
+    return SimTimeOnAir( MODEM_LORA, bandwidths[dr] / 250000, datarates[dr], 1, 8, false, SIM_JOIN_REQUEST_SIZE, true );
+}
+
+static void RegionInit( LoRaMacRegion_t region, InitType_t type, void* nvmCtx )
+{
+    InitDefaultsParams_t params = { .NvmCtx = nvmCtx, .Type = type };
+
+    if( region == LORAMAC_REGION_US915 )
+    {
+        RegionUS915InitDefaults( &params );
+    }
+    else
+    {
+        RegionAU915InitDefaults( &params );
+    }
+}
+
+static void RegionSaveCtx( LoRaMacRegion_t region )
+{
+    GetNvmCtxParams_t params;
+    void* ctx = ( region == LORAMAC_REGION_US915 ) ? RegionUS915GetNvmCtx( &params ) : RegionAU915GetNvmCtx( &params );
+
+    memcpy( NvmCtx, ctx, params.nvmCtxSize );
+}
+
+/*!
+ * \brief Runs a join as the MAC layer does, from the reboot to the join accept
+ *
+ * \retval Number of join requests, 0 when the join failed
+ */
+static uint16_t Join( const SimScenario_t* scenario, uint8_t subBands )
+{
+    TimerTime_t bootTime = Now;
+    int8_t dr = DR_0;
+    uint16_t nbRequests = 0;
+
+    RegionInit( scenario->Region, INIT_TYPE_RESTORE_CTX, NvmCtx );
+
+    while( nbRequests < SIM_MAX_JOIN_REQUESTS )
+    {
+        NextChanParams_t nextChan;
+        SetBandTxDoneParams_t txDone;
+        ApplyCFListParams_t cfList;
+        LoRaMacStatus_t status;
+        TimerTime_t timeOnAir = 0;
+        TimerTime_t time = 0;
+        TimerTime_t aggregatedTimeOff = 0;
+        uint8_t channel = 0;
+
+        dr = ( scenario->Region == LORAMAC_REGION_US915 ) ? RegionUS915AlternateDr( dr, ALTERNATE_DR ) :
+                                                              RegionAU915AlternateDr( dr, ALTERNATE_DR );
+
+        memset( &nextChan, 0, sizeof( nextChan ) );
+        nextChan.Datarate = dr;
+        nextChan.DutyCycleEnabled = true;
+        nextChan.ElapsedTimeSinceStartUp.Seconds = ( Now - bootTime ) / 1000;
+        nextChan.ElapsedTimeSinceStartUp.SubSeconds = ( Now - bootTime ) % 1000;
+        nextChan.Joined = false;
+        nextChan.LastTxIsJoinRequest = ( nbRequests > 0 );
+        nextChan.PktLen = SIM_JOIN_REQUEST_SIZE;
+
+        status = ( scenario->Region == LORAMAC_REGION_US915 ) ?
+                 RegionUS915NextChannel( &nextChan, &channel, &time, &aggregatedTimeOff ) :
+                 RegionAU915NextChannel( &nextChan, &channel, &time, &aggregatedTimeOff );
+        if( status == LORAMAC_STATUS_DUTYCYCLE_RESTRICTED )
+        {
+            // Join back-off
+            Now += time;
+            continue;
+        }
+        if( status != LORAMAC_STATUS_OK )
+        {
+            printf( "NextChannel error %d\n", status );
+            exit( EXIT_FAILURE );
+        }
+
+        timeOnAir = GetJoinRequestTimeOnAir( scenario->Region, dr );
+        nbRequests++;
+
+        txDone.Channel = channel;
+        txDone.Joined = false;
+        txDone.LastTxAirTime = timeOnAir;
+        txDone.LastTxDoneTime = Now + timeOnAir;
+        txDone.ElapsedTimeSinceStartUp = nextChan.ElapsedTimeSinceStartUp;
+        if( scenario->Region == LORAMAC_REGION_US915 )
+        {
+            RegionUS915SetBandTxDone( &txDone );
+        }
+        else
+        {
+            RegionAU915SetBandTxDone( &txDone );
+        }
+        Now += timeOnAir + SIM_JOIN_RX_WINDOWS_TIME;
+
+        if( ( ( subBands & ( 1 << GetSubBand( channel ) ) ) != 0 ) && ( randr( 0, 99 ) < scenario->Delivery ) )
+        {
+            cfList.Payload = NULL;
+            cfList.Size = 0;
+            cfList.JoinChannel = channel;
+            if( scenario->Region == LORAMAC_REGION_US915 )
+            {
+                RegionUS915ApplyCFList( &cfList );
+            }
+            else
+            {
+                RegionAU915ApplyCFList( &cfList );
+            }
+            RegionSaveCtx( scenario->Region );
+            return nbRequests;
+        }
+    }
+    RegionSaveCtx( scenario->Region );
+    return 0;
+}
+
+static int CompareUint16( const void* a, const void* b )
+{
+    return ( int )*( const uint16_t* )a - ( int )*( const uint16_t* )b;
+}
+
+static int CompareUint32( const void* a, const void* b )
+{
+    uint32_t x = *( const uint32_t* )a;
+    uint32_t y = *( const uint32_t* )b;
+
+    return ( x > y ) - ( x < y );
+}
+
+/*!
+ * \brief Runs the rejoins of all the devices of a scenario and prints their
+ *        statistics
+ *
+ * \param [IN] scenario Scenario
+ *
+ * \retval mean Mean number of join requests per rejoin, 0 without rejoin
+ */
+static double RunScenario( const SimScenario_t* scenario )
+{
+    uint64_t requests = 0;
+    uint64_t latencies = 0;
+
+    memset( &Stats, 0, sizeof( Stats ) );
+    srand1( 0x1234 );
+
+    for( uint16_t device = 0; device < SIM_NB_DEVICES; device++ )
+    {
+        RegionInit( scenario->Region, INIT_TYPE_DEFAULTS, NULL );
+        RegionSaveCtx( scenario->Region );
+
+        for( uint8_t join = 0; join < SIM_NB_JOINS; join++ )
+        {
+            uint8_t subBands = ( ( join > 0 ) && ( scenario->MovedSubBands != 0 ) ) ? scenario->MovedSubBands :
+                                                                                      scenario->SubBands;
+            TimerTime_t start = Now;
+            uint16_t nbRequests = Join( scenario, subBands );
+
+            // The first join has nothing to learn from, only the rejoins count
+            if( join > 0 )
+            {
+                if( nbRequests == 0 )
+                {
+                    Stats.NbFailures++;
+                }
+                else
+                {
+                    Stats.Requests[Stats.NbJoins] = nbRequests;
+                    Stats.Latencies[Stats.NbJoins] = Now - start;
+                    Stats.NbJoins++;
+                    requests += nbRequests;
+                    latencies += Now - start;
+                }
+            }
+            Now += SIM_UPTIME;
+        }
+    }
+
+    if( Stats.NbJoins == 0 )
+    {
+        printf( "%-30s | no join\n", scenario->Name );
+        return 0.0;
+    }
+    qsort( Stats.Requests, Stats.NbJoins, sizeof( Stats.Requests[0] ), CompareUint16 );
+    qsort( Stats.Latencies, Stats.NbJoins, sizeof( Stats.Latencies[0] ), CompareUint32 );
+    printf( "%-30s | %8.2f %8u | %8.1f %8.1f | %u\n", scenario->Name,
+            ( double )requests / Stats.NbJoins, Stats.Requests[( Stats.NbJoins * 9 ) / 10],
+            ( double )latencies / Stats.NbJoins / 1000.0, Stats.Latencies[( Stats.NbJoins * 9 ) / 10] / 1000.0,
+            Stats.NbFailures );
+    return ( double )requests / Stats.NbJoins;
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: join-sim-default [means.txt]
+ *        join-sim-learning [means.txt]
+ *
+ * join-sim-default writes the mean number of join requests of each scenario
+ * to means.txt. join-sim-learning reads them and fails unless the learning
+ * lowers the mean number of join requests of every scenario.
+ */
+int main( int argc, char *argv[] )
+{
+    const uint8_t nbScenarios = sizeof( Scenarios ) / sizeof( Scenarios[0] );
+    double means[sizeof( Scenarios ) / sizeof( Scenarios[0] )];
+    FILE* file = NULL;
+    bool isSuccess = true;
+
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    printf( "Join channel learning\n" );
+#else
+    printf( "Default join channel sequence\n" );
+#endif
+    printf( "%-30s | %17s | %17s | %s\n", "", "Join requests", "Join time (s)", "Failed" );
+    printf( "%-30s | %8s %8s | %8s %8s |\n", "Scenario", "mean", "p90", "mean", "p90" );
+    for( uint8_t i = 0; i < nbScenarios; i++ )
+    {
+        means[i] = RunScenario( &Scenarios[i] );
+    }
+    if( argc < 2 )
+    {
+        return EXIT_SUCCESS;
+    }
+
+#if defined( LORAMAC_JOIN_ACCELERATION_ENABLED )
+    file = fopen( argv[1], "r" );
+    if( file == NULL )
+    {
+        printf( "Cannot open %s\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+    printf( "\n%-30s | %8s %8s\n", "Mean join requests", "default", "learning" );
+    for( uint8_t i = 0; i < nbScenarios; i++ )
+    {
+        double reference = 0.0;
+
+        if( fscanf( file, "%lf", &reference ) != 1 )
+        {
+            printf( "%s: %u means expected\n", argv[1], nbScenarios );
+            isSuccess = false;
+            break;
+        }
+        printf( "%-30s | %8.2f %8.2f\n", Scenarios[i].Name, reference, means[i] );
+        if( ( means[i] == 0.0 ) || ( means[i] >= reference ) )
+        {
+            printf( "  not lowered by the learning\n" );
+            isSuccess = false;
+        }
+    }
+#else
+    file = fopen( argv[1], "w" );
+    if( file == NULL )
+    {
+        printf( "Cannot open %s\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+    for( uint8_t i = 0; i < nbScenarios; i++ )
+    {
+        fprintf( file, "%f\n", means[i] );
+    }
+#endif
+    fclose( file );
+    return ( isSuccess == true ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
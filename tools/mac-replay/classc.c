@@ -0,0 +1,214 @@
+/*!
+ * \file      classc.c
+ *
+ * \brief     Checks the class C reception duty cycle against the simulated
+ *            radio
+ *
+ *            An ABP device listens in class C with MIB_RXC_DUTY_CYCLE
+ *            enabled. The MAC must switch the running reception to continuous
+ *            when a multicast channel is set up or MIB_RXC_FORCE_CONTINUOUS is
+ *            set, and back to the duty cycle when they go away. The duty
+ *            cycle durations are checked in microseconds against the RXC
+ *            datarate symbol time.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "utilities.h"
+#include "eventlog.h"
+#include "sim-board.h"
+#include "session.h"
+
+/*!
+ * Preamble length in symbols of the class C downlinks
+ */
+#define CLASSC_PREAMBLE_LENGTH                      64
+
+/*!
+ * Symbol time in us of the RXC datarate, EU868 DR0: SF12, 125 kHz
+ */
+#define CLASSC_SYMBOL_TIME                          32768
+
+/*!
+ * Wakeup time in us of the simulated radio
+ */
+#define CLASSC_WAKEUP_TIME                          1000
+
+/*!
+ * Multicast group set up during the class C reception
+ */
+#define CLASSC_MC_ADDRESS                           0x01FFFFFF
+
+static uint8_t McAppSKey[] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+static uint8_t McNwkSKey[] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3D };
+
+static uint32_t Errors = 0;
+
+static void McpsConfirm( McpsConfirm_t* mcpsConfirm )
+{
+}
+
+static void McpsIndication( McpsIndication_t* mcpsIndication )
+{
+}
+
+static void MlmeConfirm( MlmeConfirm_t* mlmeConfirm )
+{
+}
+
+static void MlmeIndication( MlmeIndication_t* mlmeIndication )
+{
+}
+
+static void LogWrite( const uint8_t* data, uint16_t size )
+{
+}
+
+/*!
+ * \brief Checks the running reception mode of the simulated radio
+ *
+ * \param [IN] name     Step name
+ * \param [IN] expected Expected reception mode
+ */
+static void CheckRxMode( const char* name, SimRadioRxMode_t expected )
+{
+    static const char* modes[] = { "off", "window", "continuous", "duty cycle" };
+    MibRequestConfirm_t mibReq;
+    uint32_t rxTime = 0;
+    uint32_t sleepTime = 0;
+    uint32_t expectedRxTime = 0;
+    SimRadioRxMode_t mode;
+
+    LoRaMacProcess( );
+    mode = SimRadioGetRxMode( &rxTime, &sleepTime );
+    printf( "%-28s %s", name, modes[mode] );
+    if( mode == SIM_RADIO_RX_DUTY_CYCLE )
+    {
+        printf( ", rx %lu us, sleep %lu us", ( unsigned long )rxTime, ( unsigned long )sleepTime );
+    }
+    printf( "\n" );
+    if( mode != expected )
+    {
+        printf( "  expected %s\n", modes[expected] );
+        Errors++;
+        return;
+    }
+    if( mode != SIM_RADIO_RX_DUTY_CYCLE )
+    {
+        return;
+    }
+
+    mibReq.Type = MIB_MIN_RX_SYMBOLS;
+    LoRaMacMibGetRequestConfirm( &mibReq );
+    expectedRxTime = mibReq.Param.MinRxSymbols * CLASSC_SYMBOL_TIME;
+    if( ( rxTime != expectedRxTime ) ||
+        ( sleepTime != ( ( CLASSC_PREAMBLE_LENGTH * CLASSC_SYMBOL_TIME ) - ( 2 * expectedRxTime ) - CLASSC_WAKEUP_TIME ) ) )
+    {
+        printf( "  durations not in us of the RXC symbol time\n" );
+        Errors++;
+    }
+}
+
+static LoRaMacStatus_t SetMib( MibRequestConfirm_t* mibReq )
+{
+    LoRaMacStatus_t status = LoRaMacMibSetRequestConfirm( mibReq );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        printf( "MIB %d not set: %d\n", mibReq->Type, status );
+        Errors++;
+    }
+    return status;
+}
+
+int main( int argc, char* argv[] )
+{
+    LoRaMacPrimitives_t primitives = { McpsConfirm, McpsIndication, MlmeConfirm, MlmeIndication };
+    LoRaMacCallback_t callbacks = { 0 };
+    McChannelParams_t channel = { 0 };
+    MibRequestConfirm_t mibReq;
+    LoRaMacStatus_t status = LORAMAC_STATUS_OK;
+
+    EventLogInit( LogWrite );
+    status = SessionInit( &primitives, &callbacks );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        printf( "LoRaMAC initialization failed: %d\n", status );
+        return EXIT_FAILURE;
+    }
+
+    mibReq.Type = MIB_DEV_ADDR;
+    mibReq.Param.DevAddr = 0x26011234;
+    SetMib( &mibReq );
+    mibReq.Type = MIB_NETWORK_ACTIVATION;
+    mibReq.Param.NetworkActivation = ACTIVATION_TYPE_ABP;
+    SetMib( &mibReq );
+
+    mibReq.Type = MIB_RXC_DUTY_CYCLE;
+    mibReq.Param.RxCDutyCycle.Enabled = true;
+    mibReq.Param.RxCDutyCycle.PreambleLength = CLASSC_PREAMBLE_LENGTH;
+    SetMib( &mibReq );
+
+    mibReq.Type = MIB_DEVICE_CLASS;
+    mibReq.Param.Class = CLASS_C;
+    SetMib( &mibReq );
+    CheckRxMode( "class C", SIM_RADIO_RX_DUTY_CYCLE );
+
+    channel.IsRemotelySetup = false;
+    channel.Class = CLASS_C;
+    channel.IsEnabled = true;
+    channel.GroupID = MULTICAST_0_ADDR;
+    channel.Address = CLASSC_MC_ADDRESS;
+    channel.McKeys.Session.McAppSKey = McAppSKey;
+    channel.McKeys.Session.McNwkSKey = McNwkSKey;
+    channel.FCountMin = 0;
+    channel.FCountMax = UINT32_MAX;
+    channel.RxParams.ClassC.Frequency = 869525000;
+    channel.RxParams.ClassC.Datarate = DR_0;
+    status = LoRaMacMcChannelSetup( &channel );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        printf( "Multicast channel setup failed: %d\n", status );
+        return EXIT_FAILURE;
+    }
+    CheckRxMode( "multicast channel setup", SIM_RADIO_RX_CONTINUOUS );
+
+    status = LoRaMacMcChannelDelete( MULTICAST_0_ADDR );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        printf( "Multicast channel delete failed: %d\n", status );
+        return EXIT_FAILURE;
+    }
+    CheckRxMode( "multicast channel delete", SIM_RADIO_RX_DUTY_CYCLE );
+
+    mibReq.Type = MIB_RXC_FORCE_CONTINUOUS;
+    mibReq.Param.RxCForceContinuous = true;
+    SetMib( &mibReq );
+    CheckRxMode( "continuous forced", SIM_RADIO_RX_CONTINUOUS );
+
+    mibReq.Param.RxCForceContinuous = false;
+    SetMib( &mibReq );
+    CheckRxMode( "continuous released", SIM_RADIO_RX_DUTY_CYCLE );
+
+    mibReq.Type = MIB_RXC_DUTY_CYCLE;
+    mibReq.Param.RxCDutyCycle.Enabled = false;
+    SetMib( &mibReq );
+    CheckRxMode( "duty cycle disabled", SIM_RADIO_RX_CONTINUOUS );
+
+    printf( "%lu errors\n", ( unsigned long )Errors );
+    return ( Errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
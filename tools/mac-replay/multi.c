@@ -0,0 +1,391 @@
+/*!
+ * \file      multi.c
+ *
+ * \brief     Runs two LoRaMAC instances against the simulated radio and
+ *            network server, LORAMAC_MULTI_INSTANCE_ENABLED
+ *
+ *            Both devices join, then send unconfirmed and confirmed uplinks
+ *            answered in RX1, in RX2 or not at all. Their requests alternate.
+ *            Fails when a request isn't confirmed as expected, a downlink is
+ *            lost or the devices don't get their own sessions.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utilities.h"
+#include "eventlog.h"
+#include "rtc-board.h"
+#include "sim-board.h"
+#include "netserver.h"
+#include "session.h"
+
+#if !defined( LORAMAC_MULTI_INSTANCE_ENABLED )
+#error "mac-multi requires LORAMAC_MULTI_INSTANCE_ENABLED"
+#endif
+
+/*!
+ * Number of simulated devices
+ */
+#define MULTI_NB_DEVICES                            2
+
+/*!
+ * Time in ms between the end of a request of a device and its next one
+ */
+#define MULTI_REQUEST_PERIOD                        30000
+
+/*!
+ * Time in ms between the requests of two devices
+ */
+#define MULTI_DEVICE_OFFSET                         10000
+
+/*!
+ * Maximum time in ms the LoRaMAC takes to confirm a request
+ */
+#define MULTI_REQUEST_TIMEOUT                       60000
+
+/*!
+ * Port of the uplinks
+ */
+#define MULTI_UPLINK_PORT                           2
+
+/*!
+ * Scenario steps, run by each device
+ */
+typedef enum eMultiStepType
+{
+    MULTI_STEP_JOIN,
+    MULTI_STEP_UNCONFIRMED,
+    MULTI_STEP_CONFIRMED,
+}MultiStepType_t;
+
+typedef struct sMultiStep
+{
+    MultiStepType_t Type;
+    /*!
+     * Window of the network answer. SIM_RADIO_NB_WINDOWS: no answer.
+     */
+    SimRadioWindow_t Window;
+}MultiStep_t;
+
+static const MultiStep_t Steps[] =
+{
+    { MULTI_STEP_JOIN,        SIM_RADIO_RX1 },
+    { MULTI_STEP_UNCONFIRMED, SIM_RADIO_RX1 },
+    { MULTI_STEP_CONFIRMED,   SIM_RADIO_RX2 },
+    { MULTI_STEP_UNCONFIRMED, SIM_RADIO_NB_WINDOWS },
+    { MULTI_STEP_CONFIRMED,   SIM_RADIO_RX1 },
+};
+
+#define MULTI_NB_STEPS                              ( sizeof( Steps ) / sizeof( Steps[0] ) )
+
+/*!
+ * Simulated device state
+ */
+typedef struct sMultiDevice
+{
+    LoRaMacInstance_t* Instance;
+    uint8_t Step;
+    bool IsRequestPending;
+    uint32_t NextRequestTime;
+    /*!
+     * Number of downlinks received and expected
+     */
+    uint8_t NbDownlinks;
+    uint8_t NbExpectedDownlinks;
+    uint32_t Errors;
+}MultiDevice_t;
+
+static MultiDevice_t Devices[MULTI_NB_DEVICES];
+
+/*!
+ * Storage of the second instance, the first one is the default instance
+ */
+#define MULTI_INSTANCE_STORAGE_SIZE                 8192
+
+static uint64_t InstanceStorage[MULTI_INSTANCE_STORAGE_SIZE / sizeof( uint64_t )];
+
+/*!
+ * DevEUI of the second device, the first one uses the board unique id
+ */
+static uint8_t SecondDevEui[] = { 0x00, 0x80, 0xE1, 0x15, 0x00, 0x0A, 0xBC, 0xDF };
+
+static MultiDevice_t* GetSelectedDevice( void )
+{
+    for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+    {
+        if( Devices[i].Instance == LoRaMacInstanceGetSelected( ) )
+        {
+            return &Devices[i];
+        }
+    }
+    return NULL;
+}
+
+/*!
+ * \brief Simulated network server, answers the device owning the radio
+ */
+static void OnUplink( const uint8_t* frame, uint8_t size )
+{
+    MultiDevice_t* device = GetSelectedDevice( );
+    const MultiStep_t* step = NULL;
+
+    if( ( device == NULL ) || ( device->IsRequestPending == false ) )
+    {
+        return;
+    }
+    step = &Steps[device->Step];
+    if( step->Window == SIM_RADIO_NB_WINDOWS )
+    {
+        return;
+    }
+    NetServerAnswer( frame, size, step->Window );
+}
+
+static void EndRequest( const char* name, LoRaMacEventInfoStatus_t status, LoRaMacEventInfoStatus_t expected )
+{
+    MultiDevice_t* device = GetSelectedDevice( );
+
+    if( device == NULL )
+    {
+        return;
+    }
+    printf( "%8lu ms  device %u  %-12s status %d\n", ( unsigned long )RtcTick2Ms( RtcGetTimerValue( ) ),
+            ( unsigned )( device - Devices ), name, status );
+    if( status != expected )
+    {
+        device->Errors++;
+    }
+    device->IsRequestPending = false;
+    device->NextRequestTime = RtcGetTimerValue( ) + RtcMs2Tick( MULTI_REQUEST_PERIOD );
+    device->Step++;
+}
+
+static void McpsConfirm( McpsConfirm_t* mcpsConfirm )
+{
+    MultiDevice_t* device = GetSelectedDevice( );
+    LoRaMacEventInfoStatus_t expected = LORAMAC_EVENT_INFO_STATUS_OK;
+
+    if( device == NULL )
+    {
+        return;
+    }
+    if( ( mcpsConfirm->McpsRequest == MCPS_CONFIRMED ) && ( Steps[device->Step].Window == SIM_RADIO_NB_WINDOWS ) )
+    {
+        expected = LORAMAC_EVENT_INFO_STATUS_ERROR;
+    }
+    EndRequest( ( mcpsConfirm->McpsRequest == MCPS_CONFIRMED ) ? "confirmed" : "unconfirmed", mcpsConfirm->Status, expected );
+}
+
+static void McpsIndication( McpsIndication_t* mcpsIndication )
+{
+    MultiDevice_t* device = GetSelectedDevice( );
+
+    if( ( device == NULL ) || ( mcpsIndication->Status != LORAMAC_EVENT_INFO_STATUS_OK ) )
+    {
+        return;
+    }
+    printf( "%8lu ms  device %u  downlink     port %u, %u bytes, ack %u\n", ( unsigned long )RtcTick2Ms( RtcGetTimerValue( ) ),
+            ( unsigned )( device - Devices ), mcpsIndication->Port, mcpsIndication->BufferSize, mcpsIndication->AckReceived );
+    if( ( mcpsIndication->Port == NET_SERVER_DOWNLINK_PORT ) && ( mcpsIndication->BufferSize == 4 ) &&
+        ( memcmp( mcpsIndication->Buffer, "down", 4 ) == 0 ) )
+    {
+        device->NbDownlinks++;
+    }
+}
+
+static void MlmeConfirm( MlmeConfirm_t* mlmeConfirm )
+{
+    if( mlmeConfirm->MlmeRequest == MLME_JOIN )
+    {
+        EndRequest( "join", mlmeConfirm->Status, LORAMAC_EVENT_INFO_STATUS_OK );
+    }
+}
+
+static void MlmeIndication( MlmeIndication_t* mlmeIndication )
+{
+}
+
+static void LogWrite( const uint8_t* data, uint16_t size )
+{
+    // The event log isn't replayed, the records of the instances would mix
+}
+
+static LoRaMacStatus_t Request( MultiDevice_t* device )
+{
+    static uint8_t payload[] = { 'u', 'p' };
+    const MultiStep_t* step = &Steps[device->Step];
+
+    if( step->Window != SIM_RADIO_NB_WINDOWS )
+    {
+        device->NbExpectedDownlinks += ( step->Type == MULTI_STEP_JOIN ) ? 0 : 1;
+    }
+    if( step->Type == MULTI_STEP_JOIN )
+    {
+        MlmeReq_t mlmeReq;
+
+        mlmeReq.Type = MLME_JOIN;
+        mlmeReq.Req.Join.Datarate = SESSION_DATARATE;
+        return LoRaMacInstanceMlmeRequest( device->Instance, &mlmeReq );
+    }
+    else
+    {
+        McpsReq_t mcpsReq;
+
+        if( step->Type == MULTI_STEP_CONFIRMED )
+        {
+            mcpsReq.Type = MCPS_CONFIRMED;
+            mcpsReq.Req.Confirmed.fPort = MULTI_UPLINK_PORT;
+            mcpsReq.Req.Confirmed.fBuffer = payload;
+            mcpsReq.Req.Confirmed.fBufferSize = sizeof( payload );
+            mcpsReq.Req.Confirmed.NbTrials = 2;
+            mcpsReq.Req.Confirmed.Datarate = SESSION_DATARATE;
+        }
+        else
+        {
+            mcpsReq.Type = MCPS_UNCONFIRMED;
+            mcpsReq.Req.Unconfirmed.fPort = MULTI_UPLINK_PORT;
+            mcpsReq.Req.Unconfirmed.fBuffer = payload;
+            mcpsReq.Req.Unconfirmed.fBufferSize = sizeof( payload );
+            mcpsReq.Req.Unconfirmed.Datarate = SESSION_DATARATE;
+        }
+        return LoRaMacInstanceMcpsRequest( device->Instance, &mcpsReq );
+    }
+}
+
+static bool IsRunning( void )
+{
+    for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+    {
+        if( ( Devices[i].Step < MULTI_NB_STEPS ) || ( Devices[i].IsRequestPending == true ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief Gets the RTC timer value of the next request or request timeout
+ */
+static uint32_t GetNextDeadline( void )
+{
+    uint32_t now = RtcGetTimerValue( );
+    uint32_t deadline = now + RtcMs2Tick( MULTI_REQUEST_TIMEOUT );
+
+    for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+    {
+        if( ( ( Devices[i].Step < MULTI_NB_STEPS ) || ( Devices[i].IsRequestPending == true ) ) &&
+            ( ( int32_t )( Devices[i].NextRequestTime - deadline ) < 0 ) )
+        {
+            deadline = Devices[i].NextRequestTime;
+        }
+    }
+    return deadline;
+}
+
+int main( int argc, char* argv[] )
+{
+    LoRaMacPrimitives_t primitives = { McpsConfirm, McpsIndication, MlmeConfirm, MlmeIndication };
+    LoRaMacCallback_t callbacks = { 0 };
+    LoRaMacStatus_t status = LORAMAC_STATUS_OK;
+    MibRequestConfirm_t mibReq;
+    uint32_t errors = 0;
+
+    if( LoRaMacInstanceGetSize( ) > sizeof( InstanceStorage ) )
+    {
+        printf( "Instance size %u too large\n", ( unsigned )LoRaMacInstanceGetSize( ) );
+        return EXIT_FAILURE;
+    }
+    Devices[0].Instance = LoRaMacInstanceGetSelected( );
+    Devices[1].Instance = ( LoRaMacInstance_t* )InstanceStorage;
+
+    EventLogInit( LogWrite );
+    SimRadioSetNetwork( OnUplink );
+    for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+    {
+        status = SessionInstanceInit( Devices[i].Instance, &primitives, &callbacks );
+        if( status != LORAMAC_STATUS_OK )
+        {
+            printf( "Device %u LoRaMAC initialization failed: %d\n", i, status );
+            return EXIT_FAILURE;
+        }
+        Devices[i].NextRequestTime = RtcGetTimerValue( ) + RtcMs2Tick( MULTI_REQUEST_PERIOD + ( i * MULTI_DEVICE_OFFSET ) );
+    }
+    mibReq.Type = MIB_DEV_EUI;
+    mibReq.Param.DevEui = SecondDevEui;
+    if( LoRaMacInstanceMibSetRequestConfirm( Devices[1].Instance, &mibReq ) != LORAMAC_STATUS_OK )
+    {
+        printf( "Device 1 DevEUI not set\n" );
+        return EXIT_FAILURE;
+    }
+
+    while( IsRunning( ) == true )
+    {
+        for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+        {
+            LoRaMacInstanceProcess( Devices[i].Instance );
+        }
+        EventLogProcess( );
+
+        if( SimBoardWaitForEvent( GetNextDeadline( ) ) == true )
+        {
+            continue;
+        }
+        for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+        {
+            MultiDevice_t* device = &Devices[i];
+
+            if( ( int32_t )( RtcGetTimerValue( ) - device->NextRequestTime ) < 0 )
+            {
+                continue;
+            }
+            if( device->IsRequestPending == true )
+            {
+                printf( "Device %u step %u not confirmed\n", i, device->Step );
+                return EXIT_FAILURE;
+            }
+            if( device->Step < MULTI_NB_STEPS )
+            {
+                device->IsRequestPending = true;
+                status = Request( device );
+                if( status != LORAMAC_STATUS_OK )
+                {
+                    printf( "Device %u step %u request failed: %d\n", i, device->Step, status );
+                    return EXIT_FAILURE;
+                }
+                device->NextRequestTime = RtcGetTimerValue( ) + RtcMs2Tick( MULTI_REQUEST_TIMEOUT );
+            }
+        }
+    }
+
+    for( uint8_t i = 0; i < MULTI_NB_DEVICES; i++ )
+    {
+        MultiDevice_t* device = &Devices[i];
+
+        mibReq.Type = MIB_DEV_ADDR;
+        LoRaMacInstanceMibGetRequestConfirm( device->Instance, &mibReq );
+        printf( "Device %u: DevAddr %08lX, %u/%u downlinks, %lu errors\n", i, ( unsigned long )mibReq.Param.DevAddr,
+                device->NbDownlinks, device->NbExpectedDownlinks, ( unsigned long )device->Errors );
+        if( ( mibReq.Param.DevAddr != ( NET_SERVER_DEV_ADDR + i ) ) ||
+            ( device->NbDownlinks != device->NbExpectedDownlinks ) || ( device->Errors != 0 ) )
+        {
+            errors++;
+        }
+    }
+    return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
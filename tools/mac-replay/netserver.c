@@ -0,0 +1,246 @@
+/*!
+ * \file      netserver.c
+ *
+ * \brief     Simulated network server answering the uplinks of the simulated
+ *            radio, LoRaWAN 1.0.x
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <string.h>
+#include "utilities.h"
+#include "aes.h"
+#include "cmac.h"
+#include "LoRaMac.h"
+#include "netserver.h"
+
+/*!
+ * Network root key of the soft secure element identity
+ */
+#define NET_SERVER_NWK_KEY                          { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, \
+                                                      0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C }
+
+/*!
+ * Session assigned by the join accept of the first device, the next ones get
+ * the following join nonces
+ */
+#define NET_SERVER_JOIN_NONCE                       0x000001
+#define NET_SERVER_NET_ID                           0x000013
+
+/*!
+ * Session of a device
+ */
+typedef struct sNetServerDevice
+{
+    uint8_t DevEui[8];
+    uint32_t DevAddr;
+    uint8_t NwkSKey[16];
+    uint8_t AppSKey[16];
+    uint32_t FCntDown;
+}NetServerDevice_t;
+
+/*!
+ * Network server state
+ */
+static struct
+{
+    NetServerDevice_t Devices[NET_SERVER_MAX_DEVICES];
+    uint8_t NbDevices;
+}NetServer;
+
+static const uint8_t NwkKey[16] = NET_SERVER_NWK_KEY;
+
+static void PutUint32( uint8_t* buffer, uint32_t value )
+{
+    buffer[0] = ( uint8_t )value;
+    buffer[1] = ( uint8_t )( value >> 8 );
+    buffer[2] = ( uint8_t )( value >> 16 );
+    buffer[3] = ( uint8_t )( value >> 24 );
+}
+
+static uint32_t GetUint32( const uint8_t* buffer )
+{
+    return ( uint32_t )buffer[0] | ( ( uint32_t )buffer[1] << 8 ) |
+           ( ( uint32_t )buffer[2] << 16 ) | ( ( uint32_t )buffer[3] << 24 );
+}
+
+static void ComputeCmac( const uint8_t* key, const uint8_t* b0, const uint8_t* buffer, uint8_t size, uint8_t* mic )
+{
+    AES_CMAC_CTX ctx;
+    uint8_t cmac[AES_CMAC_DIGEST_LENGTH];
+
+    AES_CMAC_Init( &ctx );
+    AES_CMAC_SetKey( &ctx, key );
+    if( b0 != NULL )
+    {
+        AES_CMAC_Update( &ctx, b0, 16 );
+    }
+    AES_CMAC_Update( &ctx, buffer, size );
+    AES_CMAC_Final( cmac, &ctx );
+    memcpy1( mic, cmac, 4 );
+}
+
+/*!
+ * \brief Encrypts a downlink FRMPayload, LoRaWAN 1.0.x
+ */
+static void EncryptPayload( const NetServerDevice_t* device, uint8_t* buffer, uint8_t size )
+{
+    aes_context ctx;
+    uint8_t a[16] = { 0x01, 0, 0, 0, 0, 0x01 };
+    uint8_t s[16];
+
+    aes_set_key( device->AppSKey, 16, &ctx );
+    PutUint32( a + 6, device->DevAddr );
+    PutUint32( a + 10, device->FCntDown );
+    for( uint8_t i = 0; i < size; i += 16 )
+    {
+        a[15] = ( i / 16 ) + 1;
+        aes_encrypt( a, s, &ctx );
+        for( uint8_t j = 0; ( j < 16 ) && ( ( i + j ) < size ); j++ )
+        {
+            buffer[i + j] ^= s[j];
+        }
+    }
+}
+
+/*!
+ * \brief Gets the device sending a join request, a new one for an unknown
+ *        DevEUI
+ */
+static NetServerDevice_t* GetJoiningDevice( const uint8_t* joinRequest )
+{
+    NetServerDevice_t* device = NULL;
+
+    for( uint8_t i = 0; i < NetServer.NbDevices; i++ )
+    {
+        if( memcmp( NetServer.Devices[i].DevEui, joinRequest + 9, 8 ) == 0 )
+        {
+            return &NetServer.Devices[i];
+        }
+    }
+    if( NetServer.NbDevices >= NET_SERVER_MAX_DEVICES )
+    {
+        return NULL;
+    }
+    device = &NetServer.Devices[NetServer.NbDevices];
+    memcpy1( device->DevEui, joinRequest + 9, 8 );
+    device->DevAddr = NET_SERVER_DEV_ADDR + NetServer.NbDevices;
+    NetServer.NbDevices++;
+    return device;
+}
+
+/*!
+ * \brief Builds the join accept and derives the session keys
+ */
+static void QueueJoinAccept( const uint8_t* joinRequest, SimRadioWindow_t window )
+{
+    uint8_t frame[17] = { FRAME_TYPE_JOIN_ACCEPT << 5 };
+    uint8_t block[16] = { 0 };
+    aes_context ctx;
+    NetServerDevice_t* device = GetJoiningDevice( joinRequest );
+
+    if( device == NULL )
+    {
+        return;
+    }
+
+    // JoinNonce, NetID, DevAddr, DLSettings, RxDelay
+    PutUint32( frame + 1, NET_SERVER_JOIN_NONCE + ( device - NetServer.Devices ) );
+    PutUint32( frame + 4, NET_SERVER_NET_ID );
+    PutUint32( frame + 7, device->DevAddr );
+    frame[11] = 0;
+    frame[12] = 1;
+    ComputeCmac( NwkKey, NULL, frame, 13, frame + 13 );
+
+    // Session keys: JoinNonce, NetID and the DevNonce of the join request
+    aes_set_key( NwkKey, 16, &ctx );
+    memcpy1( block + 1, frame + 1, 6 );
+    memcpy1( block + 7, joinRequest + 17, 2 );
+    block[0] = 0x01;
+    aes_encrypt( block, device->NwkSKey, &ctx );
+    block[0] = 0x02;
+    aes_encrypt( block, device->AppSKey, &ctx );
+    device->FCntDown = 0;
+
+    // The device decrypts the join accept with an AES encryption
+    aes_decrypt( frame + 1, frame + 1, &ctx );
+    SimRadioQueueDownlink( window, frame, sizeof( frame ) );
+}
+
+static void QueueDataDownlink( const uint8_t* uplink, SimRadioWindow_t window )
+{
+    static const uint8_t payload[] = { 'd', 'o', 'w', 'n' };
+    uint8_t frame[9 + sizeof( payload ) + 4] = { FRAME_TYPE_DATA_UNCONFIRMED_DOWN << 5 };
+    uint8_t b0[16] = { 0x49, 0, 0, 0, 0, 0x01 };
+    uint8_t size = 0;
+    uint32_t devAddr = GetUint32( uplink + 1 );
+    NetServerDevice_t* device = NULL;
+
+    for( uint8_t i = 0; i < NetServer.NbDevices; i++ )
+    {
+        if( NetServer.Devices[i].DevAddr == devAddr )
+        {
+            device = &NetServer.Devices[i];
+            break;
+        }
+    }
+    if( device == NULL )
+    {
+        return;
+    }
+
+    PutUint32( frame + 1, device->DevAddr );
+    frame[5] = ( ( uplink[0] >> 5 ) == FRAME_TYPE_DATA_CONFIRMED_UP ) ? 0x20 : 0x00;
+    frame[6] = ( uint8_t )device->FCntDown;
+    frame[7] = ( uint8_t )( device->FCntDown >> 8 );
+    frame[8] = NET_SERVER_DOWNLINK_PORT;
+    memcpy1( frame + 9, payload, sizeof( payload ) );
+    EncryptPayload( device, frame + 9, sizeof( payload ) );
+    size = 9 + sizeof( payload );
+
+    PutUint32( b0 + 6, device->DevAddr );
+    PutUint32( b0 + 10, device->FCntDown );
+    b0[15] = size;
+    ComputeCmac( device->NwkSKey, b0, frame, size, frame + size );
+
+    device->FCntDown++;
+    SimRadioQueueDownlink( window, frame, size + 4 );
+}
+
+void NetServerAnswer( const uint8_t* frame, uint8_t size, SimRadioWindow_t window )
+{
+    switch( frame[0] >> 5 )
+    {
+        case FRAME_TYPE_JOIN_REQ:
+        {
+            if( size == 23 )
+            {
+                QueueJoinAccept( frame, window );
+            }
+            break;
+        }
+        case FRAME_TYPE_DATA_UNCONFIRMED_UP:
+        case FRAME_TYPE_DATA_CONFIRMED_UP:
+        {
+            if( size >= 12 )
+            {
+                QueueDataDownlink( frame, window );
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
@@ -0,0 +1,64 @@
+/*!
+ * \file      netserver.h
+ *
+ * \brief     Simulated network server answering the uplinks of the simulated
+ *            radio. Each device joins with its own DevEUI and gets its own
+ *            session.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __NETSERVER_H__
+#define __NETSERVER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "sim-board.h"
+
+/*!
+ * Maximum number of devices joining the network server
+ */
+#define NET_SERVER_MAX_DEVICES                      2
+
+/*!
+ * Address of the first device to join, the next ones get the following
+ * addresses
+ */
+#define NET_SERVER_DEV_ADDR                         0x26011234
+
+/*!
+ * Port of the downlinks
+ */
+#define NET_SERVER_DOWNLINK_PORT                    3
+
+/*!
+ * \brief Answers an uplink: a join accept to a join request, a downlink to
+ *        a data uplink, acknowledging it when confirmed
+ *
+ * \param [IN] frame  Uplink frame
+ * \param [IN] size   Number of bytes
+ * \param [IN] window Receive window of the answer
+ */
+void NetServerAnswer( const uint8_t* frame, uint8_t size, SimRadioWindow_t window );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NETSERVER_H__
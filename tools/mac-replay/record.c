@@ -0,0 +1,292 @@
+/*!
+ * \file      record.c
+ *
+ * \brief     Records the event log of a LoRaMAC session against a simulated
+ *            radio and network server, see LoRaMacReplay.h
+ *
+ *            The session joins with a second join request, then sends
+ *            unconfirmed and confirmed uplinks answered in RX1, in RX2 or not
+ *            at all. The log is written to the file given as argument.
+ *
+ *            With RECORD_TX_AHEAD_OF_TIME defined the session switches
+ *            MIB_TX_AHEAD_OF_TIME from one request to the next. It covers
+ *            the retransmission of a frame secured ahead of time, a frame
+ *            secured at transmission time after one secured ahead of time
+ *            and a join request after a frame secured ahead of time.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "utilities.h"
+#include "eventlog.h"
+#include "rtc-board.h"
+#include "sim-board.h"
+#include "netserver.h"
+#include "session.h"
+
+/*!
+ * Time in ms between the end of a request and the next one
+ */
+#define RECORD_REQUEST_PERIOD                       30000
+
+/*!
+ * Maximum time in ms the LoRaMAC takes to confirm a request
+ */
+#define RECORD_REQUEST_TIMEOUT                      60000
+
+/*!
+ * Port of the uplinks
+ */
+#define RECORD_UPLINK_PORT                          2
+
+/*!
+ * Scenario steps
+ */
+typedef enum eRecordStepType
+{
+    RECORD_STEP_JOIN,
+    RECORD_STEP_UNCONFIRMED,
+    RECORD_STEP_CONFIRMED,
+}RecordStepType_t;
+
+typedef struct sRecordStep
+{
+    RecordStepType_t Type;
+    /*!
+     * Window of the network answer. SIM_RADIO_NB_WINDOWS: no answer.
+     */
+    SimRadioWindow_t Window;
+    /*!
+     * MIB_TX_AHEAD_OF_TIME value of the request
+     */
+    bool TxAheadOfTime;
+}RecordStep_t;
+
+#if defined( RECORD_TX_AHEAD_OF_TIME )
+static const RecordStep_t Steps[] =
+{
+    { RECORD_STEP_JOIN,        SIM_RADIO_RX1,        false },
+    { RECORD_STEP_UNCONFIRMED, SIM_RADIO_NB_WINDOWS, true },
+    // Retransmitted with the FCntUp it was secured with
+    { RECORD_STEP_CONFIRMED,   SIM_RADIO_NB_WINDOWS, true },
+    // The frame secured ahead of time is stale
+    { RECORD_STEP_UNCONFIRMED, SIM_RADIO_RX2,        false },
+    { RECORD_STEP_CONFIRMED,   SIM_RADIO_RX1,        true },
+    // Join request after a frame secured ahead of time
+    { RECORD_STEP_JOIN,        SIM_RADIO_RX1,        true },
+    { RECORD_STEP_CONFIRMED,   SIM_RADIO_RX2,        true },
+};
+#else
+static const RecordStep_t Steps[] =
+{
+    { RECORD_STEP_JOIN,        SIM_RADIO_NB_WINDOWS, false },
+    { RECORD_STEP_JOIN,        SIM_RADIO_RX1,        false },
+    { RECORD_STEP_UNCONFIRMED, SIM_RADIO_NB_WINDOWS, false },
+    { RECORD_STEP_CONFIRMED,   SIM_RADIO_RX1,        false },
+    { RECORD_STEP_UNCONFIRMED, SIM_RADIO_RX2,        false },
+    { RECORD_STEP_CONFIRMED,   SIM_RADIO_NB_WINDOWS, false },
+};
+#endif
+
+#define RECORD_NB_STEPS                             ( sizeof( Steps ) / sizeof( Steps[0] ) )
+
+/*!
+ * Recorder and simulated network server state
+ */
+static struct
+{
+    FILE* File;
+    uint8_t Step;
+    bool IsRequestPending;
+    uint32_t NextRequestTime;
+    uint32_t Errors;
+    uint32_t TimeOnAirErrors;
+}Record;
+
+/*!
+ * \brief Simulated network server
+ */
+static void OnUplink( const uint8_t* frame, uint8_t size )
+{
+    const RecordStep_t* step = &Steps[Record.Step];
+
+    if( ( Record.IsRequestPending == false ) || ( step->Window == SIM_RADIO_NB_WINDOWS ) )
+    {
+        return;
+    }
+    NetServerAnswer( frame, size, step->Window );
+}
+
+static void EndRequest( const char* name, LoRaMacEventInfoStatus_t status, TimerTime_t txTimeOnAir )
+{
+    printf( "%8lu ms  %-12s status %d\n", ( unsigned long )RtcTick2Ms( RtcGetTimerValue( ) ), name, status );
+    if( txTimeOnAir != SimRadioGetTxTimeOnAir( ) )
+    {
+        // Computed for another frame than the one sent
+        printf( "Time on air %lu ms, frame sent in %lu ms\n", ( unsigned long )txTimeOnAir,
+                ( unsigned long )SimRadioGetTxTimeOnAir( ) );
+        Record.TimeOnAirErrors++;
+    }
+    Record.IsRequestPending = false;
+    Record.NextRequestTime = RtcGetTimerValue( ) + RtcMs2Tick( RECORD_REQUEST_PERIOD );
+    Record.Step++;
+}
+
+static void McpsConfirm( McpsConfirm_t* mcpsConfirm )
+{
+    EndRequest( ( mcpsConfirm->McpsRequest == MCPS_CONFIRMED ) ? "confirmed" : "unconfirmed", mcpsConfirm->Status,
+                mcpsConfirm->TxTimeOnAir );
+}
+
+static void McpsIndication( McpsIndication_t* mcpsIndication )
+{
+    printf( "%8lu ms  downlink     port %u, %u bytes, ack %u\n", ( unsigned long )RtcTick2Ms( RtcGetTimerValue( ) ),
+            mcpsIndication->Port, mcpsIndication->BufferSize, mcpsIndication->AckReceived );
+}
+
+static void MlmeConfirm( MlmeConfirm_t* mlmeConfirm )
+{
+    if( mlmeConfirm->MlmeRequest == MLME_JOIN )
+    {
+        EndRequest( "join", mlmeConfirm->Status, mlmeConfirm->TxTimeOnAir );
+    }
+}
+
+static void MlmeIndication( MlmeIndication_t* mlmeIndication )
+{
+}
+
+static void RecordWrite( const uint8_t* data, uint16_t size )
+{
+    if( fwrite( data, 1, size, Record.File ) != size )
+    {
+        Record.Errors++;
+    }
+}
+
+static LoRaMacStatus_t Request( const RecordStep_t* step )
+{
+    static uint8_t payload[] = { 'u', 'p' };
+    MibRequestConfirm_t mibReq;
+
+    mibReq.Type = MIB_TX_AHEAD_OF_TIME;
+    mibReq.Param.TxAheadOfTime = step->TxAheadOfTime;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    if( step->Type == RECORD_STEP_JOIN )
+    {
+        MlmeReq_t mlmeReq;
+
+        mlmeReq.Type = MLME_JOIN;
+        mlmeReq.Req.Join.Datarate = SESSION_DATARATE;
+        return LoRaMacMlmeRequest( &mlmeReq );
+    }
+    else
+    {
+        McpsReq_t mcpsReq;
+
+        if( step->Type == RECORD_STEP_CONFIRMED )
+        {
+            mcpsReq.Type = MCPS_CONFIRMED;
+            mcpsReq.Req.Confirmed.fPort = RECORD_UPLINK_PORT;
+            mcpsReq.Req.Confirmed.fBuffer = payload;
+            mcpsReq.Req.Confirmed.fBufferSize = sizeof( payload );
+            mcpsReq.Req.Confirmed.NbTrials = 2;
+            mcpsReq.Req.Confirmed.Datarate = SESSION_DATARATE;
+        }
+        else
+        {
+            mcpsReq.Type = MCPS_UNCONFIRMED;
+            mcpsReq.Req.Unconfirmed.fPort = RECORD_UPLINK_PORT;
+            mcpsReq.Req.Unconfirmed.fBuffer = payload;
+            mcpsReq.Req.Unconfirmed.fBufferSize = sizeof( payload );
+            mcpsReq.Req.Unconfirmed.Datarate = SESSION_DATARATE;
+        }
+        return LoRaMacMcpsRequest( &mcpsReq );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    LoRaMacPrimitives_t primitives = { McpsConfirm, McpsIndication, MlmeConfirm, MlmeIndication };
+    LoRaMacCallback_t callbacks = { 0 };
+    LoRaMacStatus_t status = LORAMAC_STATUS_OK;
+
+    if( argc != 2 )
+    {
+        printf( "Usage: %s <log file>\n", argv[0] );
+        return EXIT_FAILURE;
+    }
+    Record.File = fopen( argv[1], "wb" );
+    if( Record.File == NULL )
+    {
+        printf( "Can't open %s\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+
+    EventLogInit( RecordWrite );
+    SimRadioSetNetwork( OnUplink );
+    status = SessionInit( &primitives, &callbacks );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        printf( "LoRaMAC initialization failed: %d\n", status );
+        return EXIT_FAILURE;
+    }
+
+    Record.NextRequestTime = RtcGetTimerValue( ) + RtcMs2Tick( RECORD_REQUEST_PERIOD );
+    while( ( Record.Step < RECORD_NB_STEPS ) || ( Record.IsRequestPending == true ) )
+    {
+        LoRaMacProcess( );
+        EventLogProcess( );
+
+        if( Record.IsRequestPending == true )
+        {
+            if( ( SimBoardWaitForEvent( Record.NextRequestTime ) == false ) &&
+                ( Record.IsRequestPending == true ) )
+            {
+                printf( "Step %u not confirmed\n", Record.Step );
+                return EXIT_FAILURE;
+            }
+        }
+        else if( ( Record.Step < RECORD_NB_STEPS ) && ( SimBoardWaitForEvent( Record.NextRequestTime ) == false ) )
+        {
+            Record.IsRequestPending = true;
+            status = Request( &Steps[Record.Step] );
+            if( status != LORAMAC_STATUS_OK )
+            {
+                printf( "Step %u request failed: %d\n", Record.Step, status );
+                return EXIT_FAILURE;
+            }
+            Record.NextRequestTime = RtcGetTimerValue( ) + RtcMs2Tick( RECORD_REQUEST_TIMEOUT );
+        }
+    }
+    LoRaMacProcess( );
+    EventLogProcess( );
+
+    fclose( Record.File );
+    if( ( Record.Errors != 0 ) || ( EventLogGetDropped( ) != 0 ) )
+    {
+        printf( "Incomplete log: %u write errors, %u dropped records\n", Record.Errors, EventLogGetDropped( ) );
+        return EXIT_FAILURE;
+    }
+    if( Record.TimeOnAirErrors != 0 )
+    {
+        printf( "%u requests confirmed with the time on air of another frame\n", Record.TimeOnAirErrors );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file      replay.c
+ *
+ * \brief     Replays a recorded LoRaMAC event log, see LoRaMacReplay.h. Exits
+ *            with a failure when the replayed LoRaMAC diverges from the log.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "LoRaMacReplay.h"
+#include "session.h"
+
+/*!
+ * Maximum log size
+ */
+#define REPLAY_LOG_MAX_SIZE                         65536
+
+static uint8_t Log[REPLAY_LOG_MAX_SIZE];
+
+static void McpsConfirm( McpsConfirm_t* mcpsConfirm )
+{
+}
+
+static void McpsIndication( McpsIndication_t* mcpsIndication )
+{
+}
+
+static void MlmeConfirm( MlmeConfirm_t* mlmeConfirm )
+{
+}
+
+static void MlmeIndication( MlmeIndication_t* mlmeIndication )
+{
+}
+
+int main( int argc, char* argv[] )
+{
+    LoRaMacPrimitives_t primitives = { McpsConfirm, McpsIndication, MlmeConfirm, MlmeIndication };
+    LoRaMacCallback_t callbacks = { 0 };
+    LoRaMacReplayStats_t stats;
+    LoRaMacStatus_t status = LORAMAC_STATUS_OK;
+    FILE* file = NULL;
+    size_t size = 0;
+
+    if( argc != 2 )
+    {
+        printf( "Usage: %s <log file>\n", argv[0] );
+        return EXIT_FAILURE;
+    }
+    file = fopen( argv[1], "rb" );
+    if( file == NULL )
+    {
+        printf( "Can't open %s\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+    size = fread( Log, 1, sizeof( Log ), file );
+    fclose( file );
+
+    if( LoRaMacReplayInit( Log, size ) == false )
+    {
+        printf( "Invalid log %s\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+    status = SessionInit( &primitives, &callbacks );
+    if( status != LORAMAC_STATUS_OK )
+    {
+        printf( "LoRaMAC initialization failed: %d\n", status );
+        return EXIT_FAILURE;
+    }
+
+    if( LoRaMacReplayRun( LoRaMacProcess, &stats ) == false )
+    {
+        if( stats.Gaps != 0 )
+        {
+            printf( "%s: incomplete log, %u records lost in %u gaps\n", argv[1], stats.LostRecords, stats.Gaps );
+        }
+        printf( "%s: %u divergences, first one at log offset %u\n", argv[1], stats.Divergences, stats.FirstDivergence );
+        return EXIT_FAILURE;
+    }
+    printf( "%s: %u records, %u s replayed in %.3f ms, longest event %.3f ms\n", argv[1], stats.Records,
+            stats.VirtualTime / 1000, stats.ProcessTime / 1e6, stats.MaxProcessTime / 1e6 );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/*!
+ * \file      session.c
+ *
+ * \brief     LoRaMAC setup shared by the recorder and the replay, the replay
+ *            initializes the LoRaMAC as the recorded one
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "utilities.h"
+#include "board.h"
+#include "session.h"
+
+/*!
+ * Device EUI, the soft secure element reads it from the board
+ */
+static const uint8_t SessionDevEui[] = { 0x00, 0x80, 0xE1, 0x15, 0x00, 0x0A, 0xBC, 0xDE };
+
+void BoardGetUniqueId( uint8_t *id )
+{
+    memcpy1( id, SessionDevEui, sizeof( SessionDevEui ) );
+}
+
+/*!
+ * \brief Configures and starts the selected LoRaMAC instance
+ */
+static LoRaMacStatus_t SessionStart( void )
+{
+    MibRequestConfirm_t mibReq;
+
+    mibReq.Type = MIB_PUBLIC_NETWORK;
+    mibReq.Param.EnablePublicNetwork = true;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+    mibReq.Type = MIB_ADR;
+    mibReq.Param.AdrEnable = false;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+
+#if defined( SESSION_TX_AHEAD_OF_TIME )
+    // The recorded frames must not depend on when they are secured
+    mibReq.Type = MIB_TX_AHEAD_OF_TIME;
+    mibReq.Param.TxAheadOfTime = true;
+    LoRaMacMibSetRequestConfirm( &mibReq );
+#endif
+
+    return LoRaMacStart( );
+}
+
+LoRaMacStatus_t SessionInit( LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks )
+{
+    LoRaMacStatus_t status = LoRaMacInitialization( primitives, callbacks, SESSION_REGION );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return SessionStart( );
+}
+
+LoRaMacStatus_t SessionInstanceInit( LoRaMacInstance_t* instance, LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks )
+{
+    LoRaMacStatus_t status = LoRaMacInstanceInitialization( instance, primitives, callbacks, SESSION_REGION );
+
+    if( status != LORAMAC_STATUS_OK )
+    {
+        return status;
+    }
+    return SessionStart( );
+}
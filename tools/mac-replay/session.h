@@ -0,0 +1,68 @@
+/*!
+ * \file      session.h
+ *
+ * \brief     LoRaMAC setup shared by the recorder and the replay, the replay
+ *            initializes the LoRaMAC as the recorded one
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __SESSION_H__
+#define __SESSION_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "LoRaMac.h"
+
+/*!
+ * Region of the recorded session
+ */
+#define SESSION_REGION                              LORAMAC_REGION_EU868
+
+/*!
+ * Datarate of the join requests and uplinks
+ */
+#define SESSION_DATARATE                            DR_5
+
+/*!
+ * \brief Initializes and starts the LoRaMAC
+ *
+ * \param [IN] primitives MCPS and MLME services callbacks
+ * \param [IN] callbacks  LoRaMAC callbacks
+ *
+ * \retval status Status of the initialization
+ */
+LoRaMacStatus_t SessionInit( LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks );
+
+/*!
+ * \brief Initializes and starts the given LoRaMAC instance, which stays
+ *        selected
+ *
+ * \param [IN] instance   LoRaMAC instance
+ * \param [IN] primitives MCPS and MLME services callbacks
+ * \param [IN] callbacks  LoRaMAC callbacks
+ *
+ * \retval status Status of the initialization
+ */
+LoRaMacStatus_t SessionInstanceInit( LoRaMacInstance_t* instance, LoRaMacPrimitives_t* primitives, LoRaMacCallback_t* callbacks );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SESSION_H__
@@ -0,0 +1,597 @@
+/*!
+ * \file      sim-board.c
+ *
+ * \brief     Simulated board of the LoRaMAC recorder: virtual RTC, critical
+ *            sections and radio
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "utilities.h"
+#include "board.h"
+#include "rtc-board.h"
+#include "timer.h"
+#include "radio.h"
+#include "sim-board.h"
+
+/*!
+ * Time in ms from the opening of a receive window to the end of a received
+ * downlink
+ */
+#define SIM_RADIO_RX_DONE_DELAY                     20
+
+/*!
+ * Time in ms from the opening of a receive window to its timeout when no
+ * downlink is received
+ */
+#define SIM_RADIO_RX_TIMEOUT_DELAY                  30
+
+/*!
+ * RSSI and SNR of the received downlinks
+ */
+#define SIM_RADIO_RSSI                              -60
+#define SIM_RADIO_SNR                               8
+
+/*!
+ * Simulated radio interrupts
+ */
+typedef enum eSimRadioIrq
+{
+    SIM_RADIO_IRQ_NONE,
+    SIM_RADIO_IRQ_TX_DONE,
+    SIM_RADIO_IRQ_RX_DONE,
+    SIM_RADIO_IRQ_RX_TIMEOUT,
+}SimRadioIrq_t;
+
+/*!
+ * Virtual RTC. The timer value only moves when the main loop waits for an
+ * event, the recording runs faster than real time.
+ */
+static struct
+{
+    uint32_t Now;
+    uint32_t Context;
+    uint32_t Alarm;
+    bool IsAlarmArmed;
+    uint32_t Backup[2];
+}Rtc;
+
+/*!
+ * Simulated radio
+ */
+static struct
+{
+    RadioEvents_t* Events;
+    RadioState_t State;
+    /*!
+     * Modem parameters of the last TX configuration
+     */
+    RadioModems_t Modem;
+    uint32_t Bandwidth;
+    uint32_t Datarate;
+    uint8_t Coderate;
+    uint16_t PreambleLen;
+    /*!
+     * Receive window of the next Radio.Rx call
+     */
+    uint8_t Window;
+    /*!
+     * Running reception mode and reception duty cycle durations in us
+     */
+    SimRadioRxMode_t RxMode;
+    uint32_t RxTime;
+    uint32_t SleepTime;
+    /*!
+     * Downlinks of the receive windows of the last uplink
+     */
+    struct
+    {
+        bool IsPending;
+        uint8_t Frame[UINT8_MAX];
+        uint8_t Size;
+    }Downlinks[SIM_RADIO_NB_WINDOWS];
+    /*!
+     * Buffer handed to the RxDone event, kept until the next reception
+     */
+    uint8_t RxBuffer[UINT8_MAX];
+    SimRadioIrq_t Irq;
+    uint32_t IrqTime;
+    /*!
+     * Time on air in ms of the last frame sent
+     */
+    uint32_t TxTimeOnAir;
+    RandState_t Rand;
+    void ( *OnUplink )( const uint8_t* frame, uint8_t size );
+}Sim;
+
+static void SimRadioIrq( void )
+{
+    SimRadioIrq_t irq = Sim.Irq;
+
+    Sim.Irq = SIM_RADIO_IRQ_NONE;
+    Sim.State = RF_IDLE;
+    Sim.RxMode = SIM_RADIO_RX_OFF;
+    switch( irq )
+    {
+        case SIM_RADIO_IRQ_TX_DONE:
+        {
+            if( ( Sim.Events != NULL ) && ( Sim.Events->TxDone != NULL ) )
+            {
+                Sim.Events->TxDone( );
+            }
+            break;
+        }
+        case SIM_RADIO_IRQ_RX_DONE:
+        {
+            SimRadioWindow_t window = ( SimRadioWindow_t )( Sim.Window - 1 );
+
+            Sim.Downlinks[window].IsPending = false;
+            memcpy1( Sim.RxBuffer, Sim.Downlinks[window].Frame, Sim.Downlinks[window].Size );
+            if( ( Sim.Events != NULL ) && ( Sim.Events->RxDone != NULL ) )
+            {
+                Sim.Events->RxDone( Sim.RxBuffer, Sim.Downlinks[window].Size, SIM_RADIO_RSSI, SIM_RADIO_SNR );
+            }
+            break;
+        }
+        case SIM_RADIO_IRQ_RX_TIMEOUT:
+        {
+            if( ( Sim.Events != NULL ) && ( Sim.Events->RxTimeout != NULL ) )
+            {
+                Sim.Events->RxTimeout( );
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool SimBoardWaitForEvent( uint32_t limit )
+{
+    if( ( Sim.Irq != SIM_RADIO_IRQ_NONE ) && ( ( int32_t )( Sim.IrqTime - limit ) <= 0 ) &&
+        ( ( Rtc.IsAlarmArmed == false ) || ( ( int32_t )( Sim.IrqTime - Rtc.Alarm ) <= 0 ) ) )
+    {
+        if( ( int32_t )( Sim.IrqTime - Rtc.Now ) > 0 )
+        {
+            Rtc.Now = Sim.IrqTime;
+        }
+        SimRadioIrq( );
+        return true;
+    }
+    if( ( Rtc.IsAlarmArmed == true ) && ( ( int32_t )( Rtc.Alarm - limit ) <= 0 ) )
+    {
+        if( ( int32_t )( Rtc.Alarm - Rtc.Now ) > 0 )
+        {
+            Rtc.Now = Rtc.Alarm;
+        }
+        Rtc.IsAlarmArmed = false;
+        TimerIrqHandler( );
+        return true;
+    }
+    if( ( int32_t )( limit - Rtc.Now ) > 0 )
+    {
+        Rtc.Now = limit;
+    }
+    return false;
+}
+
+void SimRadioSetNetwork( void ( *onUplink )( const uint8_t* frame, uint8_t size ) )
+{
+    Sim.OnUplink = onUplink;
+}
+
+void SimRadioQueueDownlink( SimRadioWindow_t window, const uint8_t* frame, uint8_t size )
+{
+    Sim.Downlinks[window].IsPending = true;
+    memcpy1( Sim.Downlinks[window].Frame, frame, size );
+    Sim.Downlinks[window].Size = size;
+}
+
+uint32_t SimRadioGetTxTimeOnAir( void )
+{
+    return Sim.TxTimeOnAir;
+}
+
+SimRadioRxMode_t SimRadioGetRxMode( uint32_t* rxTime, uint32_t* sleepTime )
+{
+    *rxTime = Sim.RxTime;
+    *sleepTime = Sim.SleepTime;
+    return Sim.RxMode;
+}
+
+/*
+ * Board
+ */
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+/*
+ * Virtual RTC
+ */
+
+void RtcInit( void )
+{
+}
+
+uint32_t RtcGetMinimumTimeout( void )
+{
+    return 1;
+}
+
+uint32_t RtcMs2Tick( TimerTime_t milliseconds )
+{
+    return ( uint32_t )( ( ( uint64_t )milliseconds * SIM_RTC_FREQUENCY ) / 1000 );
+}
+
+TimerTime_t RtcTick2Ms( uint32_t tick )
+{
+    return ( TimerTime_t )( ( ( uint64_t )tick * 1000 ) / SIM_RTC_FREQUENCY );
+}
+
+void RtcDelayMs( TimerTime_t milliseconds )
+{
+    Rtc.Now += RtcMs2Tick( milliseconds );
+}
+
+void RtcSetMcuWakeUpTime( void )
+{
+}
+
+int16_t RtcGetMcuWakeUpTime( void )
+{
+    return 0;
+}
+
+void RtcSetAlarm( uint32_t timeout )
+{
+    RtcStartAlarm( timeout );
+}
+
+void RtcStopAlarm( void )
+{
+    Rtc.IsAlarmArmed = false;
+}
+
+void RtcStartAlarm( uint32_t timeout )
+{
+    Rtc.Alarm = Rtc.Context + timeout;
+    Rtc.IsAlarmArmed = true;
+}
+
+uint32_t RtcSetTimerContext( void )
+{
+    Rtc.Context = Rtc.Now;
+    return Rtc.Context;
+}
+
+uint32_t RtcGetTimerContext( void )
+{
+    return Rtc.Context;
+}
+
+uint32_t RtcGetCalendarTime( uint16_t *milliseconds )
+{
+    *milliseconds = ( Rtc.Now % SIM_RTC_FREQUENCY ) * 1000 / SIM_RTC_FREQUENCY;
+    return Rtc.Now / SIM_RTC_FREQUENCY;
+}
+
+uint32_t RtcGetTimerValue( void )
+{
+    return Rtc.Now;
+}
+
+uint32_t RtcGetTimerElapsedTime( void )
+{
+    return Rtc.Now - Rtc.Context;
+}
+
+void RtcBkupWrite( uint32_t data0, uint32_t data1 )
+{
+    Rtc.Backup[0] = data0;
+    Rtc.Backup[1] = data1;
+}
+
+void RtcBkupRead( uint32_t* data0, uint32_t* data1 )
+{
+    *data0 = Rtc.Backup[0];
+    *data1 = Rtc.Backup[1];
+}
+
+void RtcProcess( void )
+{
+}
+
+TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
+{
+    return period;
+}
+
+/*
+ * Simulated radio
+ */
+
+static void RadioInit( RadioEvents_t *events )
+{
+    Sim.Events = events;
+    Sim.State = RF_IDLE;
+    RandInit( &Sim.Rand, 0x5EED );
+}
+
+static RadioState_t RadioGetStatus( void )
+{
+    return Sim.State;
+}
+
+static void RadioSetModem( RadioModems_t modem )
+{
+    Sim.Modem = modem;
+}
+
+static void RadioSetChannel( uint32_t freq )
+{
+}
+
+static bool RadioIsChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime )
+{
+    return true;
+}
+
+static uint32_t RadioRandom( void )
+{
+    return RandNext( &Sim.Rand );
+}
+
+static void RadioSetRxConfig( RadioModems_t modem, uint32_t bandwidth,
+                              uint32_t datarate, uint8_t coderate,
+                              uint32_t bandwidthAfc, uint16_t preambleLen,
+                              uint16_t symbTimeout, bool fixLen,
+                              uint8_t payloadLen,
+                              bool crcOn, bool freqHopOn, uint8_t hopPeriod,
+                              bool iqInverted, bool rxContinuous )
+{
+}
+
+static void RadioSetTxConfig( RadioModems_t modem, int8_t power, uint32_t fdev,
+                              uint32_t bandwidth, uint32_t datarate,
+                              uint8_t coderate, uint16_t preambleLen,
+                              bool fixLen, bool crcOn, bool freqHopOn,
+                              uint8_t hopPeriod, bool iqInverted, uint32_t timeout )
+{
+    Sim.Modem = modem;
+    Sim.Bandwidth = bandwidth;
+    Sim.Datarate = datarate;
+    Sim.Coderate = coderate;
+    Sim.PreambleLen = preambleLen;
+}
+
+static bool RadioCheckRfFrequency( uint32_t frequency )
+{
+    return true;
+}
+
+/*!
+ * \brief Computes the time on air as the SX126x driver does
+ */
+static uint32_t RadioTimeOnAir( RadioModems_t modem, uint32_t bandwidth,
+                                uint32_t datarate, uint8_t coderate,
+                                uint16_t preambleLen, bool fixLen, uint8_t payloadLen,
+                                bool crcOn )
+{
+    uint32_t numerator = 0;
+    uint32_t denominator = 1;
+
+    if( modem == MODEM_FSK )
+    {
+        // Preamble, length field, 3 bytes sync word, payload and CRC
+        numerator = 1000U * ( ( preambleLen << 3 ) + ( ( fixLen == false ) ? 8 : 0 ) + ( 3 << 3 ) +
+                              ( ( payloadLen + ( ( crcOn == true ) ? 2 : 0 ) ) << 3 ) );
+        denominator = datarate;
+    }
+    else
+    {
+        int32_t crDenom = coderate + 4;
+        bool lowDatareOptimize = ( ( bandwidth == 0 ) && ( ( datarate == 11 ) || ( datarate == 12 ) ) ) ||
+                                 ( ( bandwidth == 1 ) && ( datarate == 12 ) );
+        int32_t ceilDenominator = 4 * datarate;
+        int32_t ceilNumerator = ( payloadLen << 3 ) + ( crcOn ? 16 : 0 ) - ( 4 * datarate ) + ( fixLen ? 0 : 20 );
+        int32_t intermediate = 0;
+
+        if( ( ( datarate == 5 ) || ( datarate == 6 ) ) && ( preambleLen < 12 ) )
+        {
+            preambleLen = 12;
+        }
+        if( datarate > 6 )
+        {
+            ceilNumerator += 8;
+            if( lowDatareOptimize == true )
+            {
+                ceilDenominator = 4 * ( datarate - 2 );
+            }
+        }
+        if( ceilNumerator < 0 )
+        {
+            ceilNumerator = 0;
+        }
+        intermediate = ( ( ceilNumerator + ceilDenominator - 1 ) / ceilDenominator ) * crDenom + preambleLen + 12;
+        if( datarate <= 6 )
+        {
+            intermediate += 2;
+        }
+        numerator = 1000U * ( uint32_t )( ( 4 * intermediate + 1 ) * ( 1 << ( datarate - 2 ) ) );
+        denominator = 125000UL << MIN( bandwidth, 2 );
+    }
+    return ( numerator + denominator - 1 ) / denominator;
+}
+
+static void RadioSend( uint8_t *buffer, uint8_t size )
+{
+    Sim.State = RF_TX_RUNNING;
+    Sim.Irq = SIM_RADIO_IRQ_TX_DONE;
+    Sim.TxTimeOnAir = RadioTimeOnAir( Sim.Modem, Sim.Bandwidth, Sim.Datarate, Sim.Coderate, Sim.PreambleLen, false, size, true );
+    Sim.IrqTime = Rtc.Now + RtcMs2Tick( Sim.TxTimeOnAir );
+
+    // The network answers in the receive windows of this uplink
+    Sim.Window = SIM_RADIO_RX1;
+    Sim.Downlinks[SIM_RADIO_RX1].IsPending = false;
+    Sim.Downlinks[SIM_RADIO_RX2].IsPending = false;
+    if( Sim.OnUplink != NULL )
+    {
+        Sim.OnUplink( buffer, size );
+    }
+}
+
+static void RadioSleep( void )
+{
+    if( Sim.Irq != SIM_RADIO_IRQ_TX_DONE )
+    {
+        Sim.Irq = SIM_RADIO_IRQ_NONE;
+        Sim.State = RF_IDLE;
+        Sim.RxMode = SIM_RADIO_RX_OFF;
+    }
+}
+
+static void RadioStandby( void )
+{
+    RadioSleep( );
+}
+
+static void RadioRx( uint32_t timeout )
+{
+    Sim.State = RF_RX_RUNNING;
+    if( timeout == 0 )
+    {
+        // Class C continuous reception, no downlink is simulated outside the
+        // windows of the uplinks
+        Sim.RxMode = SIM_RADIO_RX_CONTINUOUS;
+        Sim.Irq = SIM_RADIO_IRQ_NONE;
+        return;
+    }
+    Sim.RxMode = SIM_RADIO_RX_WINDOW;
+    if( ( Sim.Window < SIM_RADIO_NB_WINDOWS ) && ( Sim.Downlinks[Sim.Window].IsPending == true ) )
+    {
+        Sim.Irq = SIM_RADIO_IRQ_RX_DONE;
+        Sim.IrqTime = Rtc.Now + RtcMs2Tick( SIM_RADIO_RX_DONE_DELAY );
+    }
+    else
+    {
+        Sim.Irq = SIM_RADIO_IRQ_RX_TIMEOUT;
+        Sim.IrqTime = Rtc.Now + RtcMs2Tick( SIM_RADIO_RX_TIMEOUT_DELAY );
+    }
+    Sim.Window++;
+}
+
+static void RadioStartCad( void )
+{
+}
+
+static void RadioSetTxContinuousWave( uint32_t freq, int8_t power, uint16_t time )
+{
+}
+
+static int16_t RadioRssi( RadioModems_t modem )
+{
+    return -120;
+}
+
+static void RadioWrite( uint32_t addr, uint8_t data )
+{
+}
+
+static uint8_t RadioRead( uint32_t addr )
+{
+    return 0;
+}
+
+static void RadioWriteBuffer( uint32_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void RadioReadBuffer( uint32_t addr, uint8_t *buffer, uint8_t size )
+{
+}
+
+static void RadioSetMaxPayloadLength( RadioModems_t modem, uint8_t max )
+{
+}
+
+static void RadioSetPublicNetwork( bool enable )
+{
+}
+
+static uint32_t RadioGetWakeupTime( void )
+{
+    return 1;
+}
+
+static void RadioIrqProcess( void )
+{
+}
+
+static void RadioRxBoosted( uint32_t timeout )
+{
+    RadioRx( timeout );
+}
+
+static void RadioSetRxDutyCycle( uint32_t rxTime, uint32_t sleepTime )
+{
+    Sim.State = RF_RX_RUNNING;
+    Sim.RxMode = SIM_RADIO_RX_DUTY_CYCLE;
+    Sim.RxTime = rxTime;
+    Sim.SleepTime = sleepTime;
+    Sim.Irq = SIM_RADIO_IRQ_NONE;
+}
+
+static void RadioStartChannelFree( uint32_t freq, uint32_t rxBandwidth, int16_t rssiThresh, uint32_t maxCarrierSenseTime, RadioCarrierSenseModes_t mode )
+{
+}
+
+const struct Radio_s Radio =
+{
+    .Init = RadioInit,
+    .GetStatus = RadioGetStatus,
+    .SetModem = RadioSetModem,
+    .SetChannel = RadioSetChannel,
+    .IsChannelFree = RadioIsChannelFree,
+    .Random = RadioRandom,
+    .SetRxConfig = RadioSetRxConfig,
+    .SetTxConfig = RadioSetTxConfig,
+    .CheckRfFrequency = RadioCheckRfFrequency,
+    .TimeOnAir = RadioTimeOnAir,
+    .Send = RadioSend,
+    .Sleep = RadioSleep,
+    .Standby = RadioStandby,
+    .Rx = RadioRx,
+    .StartCad = RadioStartCad,
+    .SetTxContinuousWave = RadioSetTxContinuousWave,
+    .Rssi = RadioRssi,
+    .Write = RadioWrite,
+    .Read = RadioRead,
+    .WriteBuffer = RadioWriteBuffer,
+    .ReadBuffer = RadioReadBuffer,
+    .SetMaxPayloadLength = RadioSetMaxPayloadLength,
+    .SetPublicNetwork = RadioSetPublicNetwork,
+    .GetWakeupTime = RadioGetWakeupTime,
+    .IrqProcess = RadioIrqProcess,
+    .RxBoosted = RadioRxBoosted,
+    .SetRxDutyCycle = RadioSetRxDutyCycle,
+    .StartChannelFree = RadioStartChannelFree,
+};
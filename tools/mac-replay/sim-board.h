@@ -0,0 +1,109 @@
+/*!
+ * \file      sim-board.h
+ *
+ * \brief     Simulated board of the LoRaMAC recorder: virtual RTC, critical
+ *            sections and radio
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __SIM_BOARD_H__
+#define __SIM_BOARD_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Virtual RTC ticks per second
+ */
+#define SIM_RTC_FREQUENCY                           1000
+
+/*!
+ * Receive windows of the simulated radio
+ */
+typedef enum eSimRadioWindow
+{
+    SIM_RADIO_RX1,
+    SIM_RADIO_RX2,
+    SIM_RADIO_NB_WINDOWS,
+}SimRadioWindow_t;
+
+/*!
+ * Reception modes of the simulated radio
+ */
+typedef enum eSimRadioRxMode
+{
+    SIM_RADIO_RX_OFF,
+    SIM_RADIO_RX_WINDOW,
+    SIM_RADIO_RX_CONTINUOUS,
+    SIM_RADIO_RX_DUTY_CYCLE,
+}SimRadioRxMode_t;
+
+/*!
+ * \brief Waits for the next event: moves the virtual RTC to the earliest of
+ *        the pending alarm and simulated radio interrupt, and runs it
+ *
+ * \param [IN] limit RTC timer value to wait for at most
+ *
+ * \retval status [true: interrupt run, false: no interrupt until limit, the
+ *                 RTC timer value is limit]
+ */
+bool SimBoardWaitForEvent( uint32_t limit );
+
+/*!
+ * \brief Sets the network server answering the frames sent by the simulated
+ *        radio
+ *
+ * \param [IN] onUplink Called with each frame sent. May queue downlinks with
+ *                      \ref SimRadioQueueDownlink.
+ */
+void SimRadioSetNetwork( void ( *onUplink )( const uint8_t* frame, uint8_t size ) );
+
+/*!
+ * \brief Queues a downlink frame, received in a window of the last uplink
+ *
+ * \param [IN] window Receive window
+ * \param [IN] frame  Frame bytes
+ * \param [IN] size   Number of bytes
+ */
+void SimRadioQueueDownlink( SimRadioWindow_t window, const uint8_t* frame, uint8_t size );
+
+/*!
+ * \brief Gets the time on air of the last frame sent
+ *
+ * \retval timeOnAir Time on air in ms
+ */
+uint32_t SimRadioGetTxTimeOnAir( void );
+
+/*!
+ * \brief Gets the running reception mode
+ *
+ * \param [OUT] rxTime    Reception window duration of the duty cycle [us]
+ * \param [OUT] sleepTime Sleep period duration of the duty cycle [us]
+ *
+ * \retval mode Reception mode
+ */
+SimRadioRxMode_t SimRadioGetRxMode( uint32_t* rxTime, uint32_t* sleepTime );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIM_BOARD_H__
@@ -0,0 +1,360 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host benchmark of the memcpy1, memcpyr and memset1 memory
+ *            functions against the former byte by byte implementations.
+ *
+ *            Checks the results for all sizes and alignments, then prints:
+ *            - host cycles per byte (time stamp counter on x86, ns elsewhere)
+ *            - Cortex-M0+ cycles per byte, from a model of the instructions
+ *              executed by each loop
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+#include "utilities.h"
+
+/*!
+ * Number of calls measured per configuration
+ */
+#define BENCH_NB_CALLS                              200000
+
+/*!
+ * Largest array of the correctness checks
+ */
+#define CHECK_MAX_SIZE                              80
+
+/*!
+ * Cortex-M0+ instruction timings, see the Cortex-M0+ technical reference
+ * manual: loads and stores take 2 cycles, taken branches 2 cycles, data
+ * processing instructions 1 cycle.
+ *
+ * Loop iterations, as compiled by GCC -Os:
+ * - byte copy:    ldrb, strb, adds, cmp, bne
+ * - byte reverse: ldrb, strb, adds, subs, cmp, bne
+ * - byte set:     strb, adds, cmp, bne
+ * - 4 words copy: 4 x ( ldr, str ), adds, adds, subs, cmp, bhi
+ * - word copy:    ldr, str, adds, adds, subs, cmp, bhi
+ * - word reverse: ldr, rev, str, subs, adds, subs, cmp, bhi
+ * - 4 words set:  4 x str, adds, subs, cmp, bhi
+ * - word set:     str, adds, subs, cmp, bhi
+ */
+#define M0P_BYTE_COPY                               8
+#define M0P_BYTE_REVERSE                            9
+#define M0P_BYTE_SET                                6
+#define M0P_4_WORDS_COPY                            22
+#define M0P_WORD_COPY                               10
+#define M0P_WORD_REVERSE                            11
+#define M0P_4_WORDS_SET                             13
+#define M0P_WORD_SET                                7
+/*!
+ * Call, return and size checks
+ */
+#define M0P_CALL                                    8
+/*!
+ * Additional alignment checks and pointer casts of the word-wise functions
+ */
+#define M0P_WORD_SETUP                              8
+
+typedef enum eBenchFunction
+{
+    BENCH_MEMCPY,
+    BENCH_MEMCPYR,
+    BENCH_MEMSET,
+}BenchFunction_t;
+
+static const char* FunctionNames[] = { "memcpy1", "memcpyr", "memset1" };
+
+/*!
+ * Benchmarked sizes: key, join request, maximum LoRaWAN frame, NVM contexts
+ */
+static const uint16_t Sizes[] = { 8, 16, 23, 64, 255, 1024 };
+
+static uint8_t SrcBuffer[2048 + 8];
+static uint8_t DstBuffer[2048 + 8];
+
+/*!
+ * Former implementations
+ */
+static void ByteMemcpy( uint8_t *dst, const uint8_t *src, uint16_t size )
+{
+    while( size-- )
+    {
+        *dst++ = *src++;
+    }
+}
+
+static void ByteMemcpyr( uint8_t *dst, const uint8_t *src, uint16_t size )
+{
+    dst = dst + ( size - 1 );
+    while( size-- )
+    {
+        *dst-- = *src++;
+    }
+}
+
+static void ByteMemset( uint8_t *dst, uint8_t value, uint16_t size )
+{
+    while( size-- )
+    {
+        *dst++ = value;
+    }
+}
+
+static void Run( BenchFunction_t function, bool isWordWise, uint8_t *dst, const uint8_t *src, uint16_t size )
+{
+    switch( function )
+    {
+        case BENCH_MEMCPY:
+            ( isWordWise == true ) ? memcpy1( dst, src, size ) : ByteMemcpy( dst, src, size );
+            break;
+        case BENCH_MEMCPYR:
+            ( isWordWise == true ) ? memcpyr( dst, src, size ) : ByteMemcpyr( dst, src, size );
+            break;
+        case BENCH_MEMSET:
+            ( isWordWise == true ) ? memset1( dst, src[0], size ) : ByteMemset( dst, src[0], size );
+            break;
+    }
+}
+
+/*!
+ * \brief Checks the word-wise functions against the former ones for all
+ *        sizes and alignments, including forward overlapping copies
+ *
+ * \retval status [true: same results, false: mismatch]
+ */
+static bool Check( void )
+{
+    static uint8_t ref[CHECK_MAX_SIZE + 16];
+    static uint8_t out[CHECK_MAX_SIZE + 16];
+    static uint8_t src[CHECK_MAX_SIZE + 16];
+
+    for( uint16_t i = 0; i < sizeof( src ); i++ )
+    {
+        src[i] = ( uint8_t )( i * 7 + 1 );
+    }
+    for( uint8_t function = BENCH_MEMCPY; function <= BENCH_MEMSET; function++ )
+    {
+        for( uint16_t size = 0; size <= CHECK_MAX_SIZE; size++ )
+        {
+            for( uint8_t dstOffset = 0; dstOffset < 4; dstOffset++ )
+            {
+                for( uint8_t srcOffset = 0; srcOffset < 4; srcOffset++ )
+                {
+                    memset( ref, 0xAA, sizeof( ref ) );
+                    memset( out, 0xAA, sizeof( out ) );
+                    Run( function, false, ref + dstOffset, src + srcOffset, size );
+                    Run( function, true, out + dstOffset, src + srcOffset, size );
+                    if( memcmp( ref, out, sizeof( ref ) ) != 0 )
+                    {
+                        printf( "%s mismatch: size %u, dst offset %u, src offset %u\n",
+                                FunctionNames[function], size, dstOffset, srcOffset );
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    // Forward overlapping copies, e.g. removing the head of a buffer
+    for( uint16_t size = 0; size <= CHECK_MAX_SIZE; size++ )
+    {
+        for( uint8_t shift = 1; shift < 12; shift++ )
+        {
+            memcpy( ref, src, sizeof( ref ) );
+            memcpy( out, src, sizeof( out ) );
+            ByteMemcpy( ref, ref + shift, size );
+            memcpy1( out, out + shift, size );
+            if( memcmp( ref, out, sizeof( ref ) ) != 0 )
+            {
+                printf( "memcpy1 overlap mismatch: size %u, shift %u\n", size, shift );
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static uint64_t GetTicks( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc( );
+#else
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( uint64_t )ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/*!
+ * \brief Measures a function on the host
+ *
+ * \retval Ticks per byte
+ */
+static double Measure( BenchFunction_t function, bool isWordWise, uint8_t dstOffset, uint8_t srcOffset, uint16_t size )
+{
+    uint64_t start = GetTicks( );
+
+    for( uint32_t i = 0; i < BENCH_NB_CALLS; i++ )
+    {
+        Run( function, isWordWise, DstBuffer + dstOffset, SrcBuffer + srcOffset, size );
+        // Keeps the compiler from removing or merging the calls
+        __asm__ volatile( "" : : "r"( DstBuffer ) : "memory" );
+    }
+    return ( double )( GetTicks( ) - start ) / BENCH_NB_CALLS / size;
+}
+
+/*!
+ * \brief Cortex-M0+ cycles of the former functions
+ */
+static uint32_t ModelByteWise( BenchFunction_t function, uint16_t size )
+{
+    uint32_t cycles[] = { M0P_BYTE_COPY, M0P_BYTE_REVERSE, M0P_BYTE_SET };
+
+    return M0P_CALL + size * cycles[function];
+}
+
+/*!
+ * \brief Cortex-M0+ cycles of the word-wise functions, following their
+ *        control flow
+ */
+static uint32_t ModelWordWise( BenchFunction_t function, uint8_t dstOffset, uint8_t srcOffset, uint16_t size )
+{
+    uint32_t cycles = M0P_CALL;
+    uint8_t head = 0;
+    bool isWordWise = false;
+
+    if( size >= 8 )
+    {
+        switch( function )
+        {
+            case BENCH_MEMCPY:
+                isWordWise = ( ( dstOffset ^ srcOffset ) & 3 ) == 0;
+                head = ( 4 - dstOffset ) & 3;
+                break;
+            case BENCH_MEMCPYR:
+                isWordWise = ( ( dstOffset + size - 1 + srcOffset + 1 ) & 3 ) == 0;
+                head = ( 4 - srcOffset ) & 3;
+                break;
+            case BENCH_MEMSET:
+                isWordWise = true;
+                head = ( 4 - dstOffset ) & 3;
+                break;
+        }
+    }
+    if( isWordWise == false )
+    {
+        return cycles + ModelByteWise( function, size ) - M0P_CALL;
+    }
+
+    cycles += M0P_WORD_SETUP;
+    switch( function )
+    {
+        case BENCH_MEMCPY:
+            cycles += head * M0P_BYTE_COPY;
+            size -= head;
+            cycles += ( size / 16 ) * M0P_4_WORDS_COPY;
+            size %= 16;
+            cycles += ( size / 4 ) * M0P_WORD_COPY;
+            cycles += ( size % 4 ) * M0P_BYTE_COPY;
+            break;
+        case BENCH_MEMCPYR:
+            cycles += head * M0P_BYTE_REVERSE;
+            size -= head;
+            cycles += ( size / 4 ) * M0P_WORD_REVERSE;
+            cycles += ( size % 4 ) * M0P_BYTE_REVERSE;
+            break;
+        case BENCH_MEMSET:
+            cycles += head * M0P_BYTE_SET;
+            size -= head;
+            cycles += ( size / 16 ) * M0P_4_WORDS_SET;
+            size %= 16;
+            cycles += ( size / 4 ) * M0P_WORD_SET;
+            cycles += ( size % 4 ) * M0P_BYTE_SET;
+            break;
+    }
+    return cycles;
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: mem-bench [check]
+ *
+ * Fails when the word-wise functions don't match the byte by byte ones.
+ * With check, returns after the correctness checks.
+ */
+int main( int argc, char *argv[] )
+{
+    /*!
+     * Benchmarked alignments: both arrays aligned, same misalignment and
+     * different alignments
+     */
+    static const uint8_t offsets[][2] = { { 0, 0 }, { 1, 1 }, { 0, 1 } };
+
+    for( uint16_t i = 0; i < sizeof( SrcBuffer ); i++ )
+    {
+        SrcBuffer[i] = ( uint8_t )i;
+    }
+    if( Check( ) == false )
+    {
+        return EXIT_FAILURE;
+    }
+    printf( "Results checked against the byte by byte functions\n\n" );
+    if( ( argc > 1 ) && ( strcmp( argv[1], "check" ) == 0 ) )
+    {
+        return EXIT_SUCCESS;
+    }
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+    printf( "Host: time stamp counter cycles per byte\n" );
+#else
+    printf( "Host: ns per byte\n" );
+#endif
+    printf( "%-8s %5s %7s | %8s %8s | %8s %8s\n", "", "", "", "Host", "", "M0+ model", "" );
+    printf( "%-8s %5s %7s | %8s %8s | %8s %8s\n", "Function", "Size", "dst/src", "byte", "word", "byte", "word" );
+    for( uint8_t function = BENCH_MEMCPY; function <= BENCH_MEMSET; function++ )
+    {
+        for( uint8_t i = 0; i < ( sizeof( Sizes ) / sizeof( Sizes[0] ) ); i++ )
+        {
+            for( uint8_t j = 0; j < ( sizeof( offsets ) / sizeof( offsets[0] ) ); j++ )
+            {
+                uint16_t size = Sizes[i];
+                uint8_t dstOffset = offsets[j][0];
+                uint8_t srcOffset = offsets[j][1];
+
+                if( ( function == BENCH_MEMSET ) && ( j == 2 ) )
+                {
+                    // memset1 has no source array
+                    continue;
+                }
+                printf( "%-8s %5u %4u/%-2u | %8.2f %8.2f | %8.2f %8.2f\n", FunctionNames[function], size, dstOffset, srcOffset,
+                        Measure( function, false, dstOffset, srcOffset, size ),
+                        Measure( function, true, dstOffset, srcOffset, size ),
+                        ( double )ModelByteWise( function, size ) / size,
+                        ( double )ModelWordWise( function, dstOffset, srcOffset, size ) / size );
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,182 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host test of the radio drivers reception filter, see
+ *            radio-filter.h
+ *
+ *            Installs the filter the LoRaMAC installs for a device with one
+ *            multicast channel, evaluates frames of each MType, address and
+ *            size, and checks the accept/drop decision and the counters.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "utilities.h"
+#include "LoRaMacTypes.h"
+#include "LoRaMacHeaderTypes.h"
+#include "radio-filter.h"
+
+/*!
+ * Device and multicast addresses of the installed filter
+ */
+#define TEST_DEV_ADDR                               0x26011234
+#define TEST_MC_ADDR                                0x01FFFFFF
+
+/*!
+ * Expected decision of a test frame
+ */
+typedef enum eTestResult
+{
+    TEST_ACCEPTED,
+    TEST_DROPPED_SIZE,
+    TEST_DROPPED_MTYPE,
+    TEST_DROPPED_ADDRESS,
+}TestResult_t;
+
+typedef struct sTestFrame
+{
+    const char* Name;
+    FType_t MType;
+    uint32_t Address;
+    uint8_t Size;
+    TestResult_t Expected;
+}TestFrame_t;
+
+static const TestFrame_t Frames[] =
+{
+    { "unicast data down",            FRAME_TYPE_DATA_UNCONFIRMED_DOWN, TEST_DEV_ADDR, 12, TEST_ACCEPTED },
+    { "confirmed data down",          FRAME_TYPE_DATA_CONFIRMED_DOWN,   TEST_DEV_ADDR, 64, TEST_ACCEPTED },
+    { "multicast data down",          FRAME_TYPE_DATA_UNCONFIRMED_DOWN, TEST_MC_ADDR,  20, TEST_ACCEPTED },
+    { "data down, other address",     FRAME_TYPE_DATA_UNCONFIRMED_DOWN, 0x26011235,    20, TEST_DROPPED_ADDRESS },
+    { "data down under minimum size", FRAME_TYPE_DATA_CONFIRMED_DOWN,   TEST_DEV_ADDR, 11, TEST_DROPPED_SIZE },
+    { "data down, header only",       FRAME_TYPE_DATA_UNCONFIRMED_DOWN, TEST_DEV_ADDR, 4,  TEST_DROPPED_SIZE },
+    { "join accept",                  FRAME_TYPE_JOIN_ACCEPT,           0,             17, TEST_ACCEPTED },
+    { "join accept, short",           FRAME_TYPE_JOIN_ACCEPT,           0,             3,  TEST_ACCEPTED },
+    { "proprietary",                  FRAME_TYPE_PROPRIETARY,           0,             30, TEST_ACCEPTED },
+    { "proprietary, 1 byte",          FRAME_TYPE_PROPRIETARY,           0,             1,  TEST_ACCEPTED },
+    { "proprietary, 6 bytes",         FRAME_TYPE_PROPRIETARY,           0,             6,  TEST_ACCEPTED },
+    { "join request",                 FRAME_TYPE_JOIN_REQ,              0,             23, TEST_DROPPED_MTYPE },
+    { "data up",                      FRAME_TYPE_DATA_UNCONFIRMED_UP,   TEST_DEV_ADDR, 20, TEST_DROPPED_MTYPE },
+    { "confirmed data up",            FRAME_TYPE_DATA_CONFIRMED_UP,     TEST_DEV_ADDR, 20, TEST_DROPPED_MTYPE },
+    { "RFU MType",                    ( FType_t )0x06,                  0,             19, TEST_DROPPED_MTYPE },
+    { "empty frame",                  FRAME_TYPE_JOIN_ACCEPT,           0,             0,  TEST_DROPPED_SIZE },
+};
+
+#define TEST_NB_FRAMES                              ( sizeof( Frames ) / sizeof( Frames[0] ) )
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+/*!
+ * \brief Installs the filter built by the LoRaMAC UpdateRxFilter
+ */
+static void InstallFilter( void )
+{
+    RadioRxFilter_t filter;
+
+    filter.MTypeMask = ( 1 << FRAME_TYPE_JOIN_ACCEPT ) | ( 1 << FRAME_TYPE_DATA_UNCONFIRMED_DOWN ) |
+                       ( 1 << FRAME_TYPE_DATA_CONFIRMED_DOWN ) | ( 1 << FRAME_TYPE_PROPRIETARY );
+    filter.AddressMTypeMask = ( 1 << FRAME_TYPE_DATA_UNCONFIRMED_DOWN ) | ( 1 << FRAME_TYPE_DATA_CONFIRMED_DOWN );
+    filter.MinSize = LORAMAC_FRAME_PAYLOAD_MIN_SIZE;
+    filter.NbAddresses = 0;
+    filter.Addresses[filter.NbAddresses++] = TEST_DEV_ADDR;
+    filter.Addresses[filter.NbAddresses++] = TEST_MC_ADDR;
+    RadioRxFilterSet( &filter );
+}
+
+/*!
+ * \brief Builds the first bytes of a frame: MHDR and DevAddr
+ */
+static void BuildHeader( const TestFrame_t* frame, uint8_t* header )
+{
+    memset1( header, 0, RADIO_RX_FILTER_HEADER_SIZE );
+    header[0] = ( uint8_t )( frame->MType << 5 );
+    header[1] = ( uint8_t )frame->Address;
+    header[2] = ( uint8_t )( frame->Address >> 8 );
+    header[3] = ( uint8_t )( frame->Address >> 16 );
+    header[4] = ( uint8_t )( frame->Address >> 24 );
+}
+
+int main( void )
+{
+    RadioRxFilterStats_t expected = { 0 };
+    RadioRxFilterStats_t stats;
+    uint8_t header[RADIO_RX_FILTER_HEADER_SIZE];
+    uint32_t nbFailures = 0;
+
+    // Disabled filter: everything accepted, no counter updated
+    RadioRxFilterSet( NULL );
+    for( uint8_t i = 0; i < TEST_NB_FRAMES; i++ )
+    {
+        BuildHeader( &Frames[i], header );
+        if( RadioRxFilterCheck( header, Frames[i].Size ) == false )
+        {
+            printf( "FAIL disabled filter dropped %s\n", Frames[i].Name );
+            nbFailures++;
+        }
+    }
+
+    InstallFilter( );
+    for( uint8_t i = 0; i < TEST_NB_FRAMES; i++ )
+    {
+        bool accepted = false;
+
+        BuildHeader( &Frames[i], header );
+        accepted = RadioRxFilterCheck( header, Frames[i].Size );
+        if( accepted != ( Frames[i].Expected == TEST_ACCEPTED ) )
+        {
+            printf( "FAIL %s, %u bytes: %s\n", Frames[i].Name, Frames[i].Size, ( accepted == true ) ? "accepted" : "dropped" );
+            nbFailures++;
+        }
+        switch( Frames[i].Expected )
+        {
+            case TEST_ACCEPTED:
+                expected.Accepted++;
+                break;
+            case TEST_DROPPED_SIZE:
+                expected.DroppedSize++;
+                break;
+            case TEST_DROPPED_MTYPE:
+                expected.DroppedMType++;
+                break;
+            case TEST_DROPPED_ADDRESS:
+                expected.DroppedAddress++;
+                break;
+        }
+    }
+
+    RadioRxFilterGetStats( &stats );
+    printf( "accepted %u, dropped size %u, mtype %u, address %u\n", stats.Accepted, stats.DroppedSize,
+            stats.DroppedMType, stats.DroppedAddress );
+    if( ( stats.Accepted != expected.Accepted ) || ( stats.DroppedSize != expected.DroppedSize ) ||
+        ( stats.DroppedMType != expected.DroppedMType ) || ( stats.DroppedAddress != expected.DroppedAddress ) )
+    {
+        printf( "FAIL counters, expected accepted %u, dropped size %u, mtype %u, address %u\n", expected.Accepted,
+                expected.DroppedSize, expected.DroppedMType, expected.DroppedAddress );
+        nbFailures++;
+    }
+
+    printf( "%u frames, %u failures\n", ( unsigned )TEST_NB_FRAMES, nbFailures );
+    return ( nbFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,241 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host simulation of the channel collisions of a fleet of devices
+ *            hopping with randr, against the former rand1 linear congruential
+ *            generator.
+ *
+ *            10000 devices send SIM_NB_UPLINKS uplinks in the same time slots,
+ *            e.g. after a power outage, each of them on randr( 0, N - 1 ).
+ *            For each number of channels N, prints:
+ *            - the probability for 2 devices to collide on an uplink
+ *            - the probability for 2 devices colliding on an uplink to
+ *              collide again on the next one
+ *            Both are 1 / N with independent uniform channels.
+ *
+ *            The devices are seeded either with 32-bit seeds or with weak
+ *            12-bit seeds, e.g. a poor Radio.Random source. The randr + mix
+ *            generator mixes a downlink RSSI and time every 8 uplinks.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utilities.h"
+
+/*!
+ * Number of simulated devices
+ */
+#define SIM_NB_DEVICES                              10000
+
+/*!
+ * Number of uplinks per device
+ */
+#define SIM_NB_UPLINKS                              64
+
+/*!
+ * Number of uplinks between 2 downlinks mixed into the generator
+ */
+#define SIM_MIX_PERIOD                              8
+
+/*!
+ * Largest number of channels
+ */
+#define SIM_MAX_CHANNELS                            64
+
+/*!
+ * Maximum deviation in percent of the probability of two colliding devices to
+ * collide again on their next uplink from the ideal 1/N
+ */
+#define SIM_MAX_REPEAT_DEVIATION                    15
+
+/*!
+ * Simulated generators
+ */
+typedef enum eSimGenerator
+{
+    SIM_GENERATOR_LCG,
+    SIM_GENERATOR_XOSHIRO,
+    SIM_GENERATOR_XOSHIRO_MIX,
+    SIM_NB_GENERATORS,
+}SimGenerator_t;
+
+static const char* GeneratorNames[SIM_NB_GENERATORS] =
+{
+    "rand1 LCG",
+    "randr",
+    "randr + mix",
+};
+
+/*!
+ * Device state, one instance of each generator
+ */
+typedef struct sSimDevice
+{
+    uint32_t LcgNext;
+    RandState_t Rand;
+    uint8_t Channel;
+}SimDevice_t;
+
+static SimDevice_t Devices[SIM_NB_DEVICES];
+
+/*!
+ * Number of devices per channel and per pair of consecutive channels
+ */
+static uint32_t ChannelCount[SIM_MAX_CHANNELS];
+static uint32_t PairCount[SIM_MAX_CHANNELS * SIM_MAX_CHANNELS];
+
+/*!
+ * Generator of the simulation itself: seeds, RSSI, times
+ */
+static RandState_t SimRand;
+
+/*!
+ * \brief Former randr implementation, 32-bit arithmetic as on the MCU
+ */
+static int32_t LcgRandr( uint32_t *next, int32_t min, int32_t max )
+{
+    *next = *next * 1103515245u + 12345u;
+    return ( int32_t )( *next % 2147483647u ) % ( max - min + 1 ) + min;
+}
+
+static uint8_t NextChannel( SimDevice_t *device, SimGenerator_t generator, uint8_t nbChannels, uint16_t uplink )
+{
+    if( generator == SIM_GENERATOR_LCG )
+    {
+        return ( uint8_t )LcgRandr( &device->LcgNext, 0, nbChannels - 1 );
+    }
+    if( ( generator == SIM_GENERATOR_XOSHIRO_MIX ) && ( uplink != 0 ) && ( ( uplink % SIM_MIX_PERIOD ) == 0 ) )
+    {
+        int16_t rssi = RandRange( &SimRand, -130, -40 );
+        int8_t snr = RandRange( &SimRand, -20, 10 );
+        uint32_t rxTime = RandNext( &SimRand );
+
+        RandMix( &device->Rand, ( ( uint32_t )( uint16_t )rssi << 16 ) ^ ( ( uint32_t )( uint8_t )snr << 8 ) ^ rxTime );
+    }
+    return ( uint8_t )RandRange( &device->Rand, 0, nbChannels - 1 );
+}
+
+static uint64_t CountPairs( const uint32_t *count, uint32_t nbBins )
+{
+    uint64_t pairs = 0;
+
+    for( uint32_t i = 0; i < nbBins; i++ )
+    {
+        if( count[i] > 1 )
+        {
+            pairs += ( uint64_t )count[i] * ( count[i] - 1 ) / 2;
+        }
+    }
+    return pairs;
+}
+
+/*!
+ * \brief Simulates the uplinks of all the devices on nbChannels channels
+ *
+ * \param [IN] generator  Generator of the devices
+ * \param [IN] seedMask   Mask of the seed bits
+ * \param [IN] nbChannels Number of channels
+ *
+ * \retval status [true: repeat probability within SIM_MAX_REPEAT_DEVIATION
+ *                 of 1/N, false: colliding devices collide again too often or
+ *                 too rarely]
+ */
+static bool Simulate( SimGenerator_t generator, uint32_t seedMask, uint8_t nbChannels )
+{
+    double repeat = 0.0;
+
+    uint64_t totalPairs = ( uint64_t )SIM_NB_DEVICES * ( SIM_NB_DEVICES - 1 ) / 2;
+    uint64_t collisions = 0;
+    // Pairs colliding on 2 consecutive uplinks, and on the first one of them
+    uint64_t repeats = 0;
+    uint64_t repeatCandidates = 0;
+
+    RandInit( &SimRand, 0x5EED );
+    for( uint32_t i = 0; i < SIM_NB_DEVICES; i++ )
+    {
+        uint32_t seed = RandNext( &SimRand ) & seedMask;
+
+        Devices[i].LcgNext = seed;
+        RandInit( &Devices[i].Rand, seed );
+    }
+
+    for( uint16_t uplink = 0; uplink < SIM_NB_UPLINKS; uplink++ )
+    {
+        memset( ChannelCount, 0, sizeof( ChannelCount ) );
+        memset( PairCount, 0, sizeof( PairCount ) );
+        for( uint32_t i = 0; i < SIM_NB_DEVICES; i++ )
+        {
+            uint8_t previous = Devices[i].Channel;
+
+            Devices[i].Channel = NextChannel( &Devices[i], generator, nbChannels, uplink );
+            ChannelCount[Devices[i].Channel]++;
+            PairCount[previous * nbChannels + Devices[i].Channel]++;
+        }
+        if( uplink != 0 )
+        {
+            repeatCandidates = collisions;
+            repeats += CountPairs( PairCount, nbChannels * nbChannels );
+        }
+        collisions += CountPairs( ChannelCount, nbChannels );
+    }
+    repeat = ( double )repeats / ( double )repeatCandidates;
+    printf( "  %-12s %-7s %3u   %8.5f  %8.5f   %8.5f\n",
+            GeneratorNames[generator], ( seedMask == 0xFFFFFFFF ) ? "32-bit" : "12-bit", nbChannels,
+            ( double )collisions / ( ( double )totalPairs * SIM_NB_UPLINKS ), repeat, 1.0 / nbChannels );
+    return ( ( repeat * nbChannels * 100 ) >= ( 100 - SIM_MAX_REPEAT_DEVIATION ) ) &&
+           ( ( repeat * nbChannels * 100 ) <= ( 100 + SIM_MAX_REPEAT_DEVIATION ) );
+}
+
+/**
+ * Main application entry point.
+ *
+ * Fails when the repeat probability of randr with 32-bit seeds, or of randr
+ * with mixing whatever the seeds, deviates from 1/N by more than
+ * SIM_MAX_REPEAT_DEVIATION percent. The rand1 LCG is the reference of a bad
+ * generator and plain randr with 12-bit seeds repeats the sequences of the
+ * devices sharing a seed, they aren't checked.
+ */
+int main( void )
+{
+    static const uint8_t nbChannels[] = { 3, 8, 16, 64 };
+    static const uint32_t seedMasks[] = { 0xFFFFFFFF, 0x00000FFF };
+    uint32_t errors = 0;
+
+    printf( "%u devices, %u synchronized uplinks\n\n", SIM_NB_DEVICES, SIM_NB_UPLINKS );
+    printf( "  generator    seeds   N    P(collide)  P(repeat)  ideal\n" );
+    for( uint8_t s = 0; s < sizeof( seedMasks ) / sizeof( seedMasks[0] ); s++ )
+    {
+        for( uint8_t n = 0; n < sizeof( nbChannels ); n++ )
+        {
+            for( uint8_t g = 0; g < SIM_NB_GENERATORS; g++ )
+            {
+                bool isChecked = ( g == SIM_GENERATOR_XOSHIRO_MIX ) ||
+                                 ( ( g == SIM_GENERATOR_XOSHIRO ) && ( seedMasks[s] == 0xFFFFFFFF ) );
+
+                if( ( Simulate( ( SimGenerator_t )g, seedMasks[s], nbChannels[n] ) == false ) && ( isChecked == true ) )
+                {
+                    printf( "    repeat probability off 1/N by more than %u%%\n", SIM_MAX_REPEAT_DEVIATION );
+                    errors++;
+                }
+            }
+        }
+        printf( "\n" );
+    }
+    return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
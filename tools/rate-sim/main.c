@@ -0,0 +1,351 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host simulation of the device side rate control. Replays link
+ *            traces and compares the LoRaMacRateControlLinkMargin engine
+ *            against fixed datarates at the maximum TX power.
+ *
+ *            A trace gives, for each uplink, the SNR at the gateway of a
+ *            125 kHz uplink at the maximum TX power, the matching RSSI and
+ *            optionally an uplink only loss making the link asymmetric.
+ *            Each transmission adds a fast fading drawn from a normal
+ *            distribution. One uplink in SIM_CONFIRMED_PERIOD is confirmed and
+ *            retransmitted until acknowledged, as LmHandler does. The
+ *            acknowledgement is received on RX1 at the uplink datarate.
+ *            For each policy, prints:
+ *            - the ratio of uplinks received by the gateway
+ *            - the mean airtime per uplink, retransmissions included
+ *            - the mean TX power and datarate
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utilities.h"
+#include "timer.h"
+#include "radio.h"
+#include "RegionCommon.h"
+#include "RegionEU868.h"
+#include "LoRaMacRateControl.h"
+
+/*!
+ * Maximum number of uplinks of a trace
+ */
+#define SIM_MAX_UPLINKS                             10000
+
+/*!
+ * Uplink size: MAC header, FPort and 12 bytes of application payload
+ */
+#define SIM_UPLINK_SIZE                             ( 13 + 12 )
+
+/*!
+ * One uplink in SIM_CONFIRMED_PERIOD is confirmed
+ */
+#define SIM_CONFIRMED_PERIOD                        4
+
+/*!
+ * Transmissions of a confirmed uplink, as requested by LmHandler
+ */
+#define SIM_CONFIRMED_NB_TRIALS                     8
+
+/*!
+ * Standard deviation of the fast fading in dB
+ */
+#define SIM_FADING                                  2.0
+
+/*!
+ * SNR reported by the radio saturates above this value, in dB
+ */
+#define SIM_SNR_SATURATION                          10
+
+/*!
+ * Minimum ratio of the uplinks delivered with the engine to the uplinks
+ * delivered at DR0, percent
+ */
+#define SIM_MIN_DELIVERY                            90
+
+/*!
+ * Link trace sample
+ */
+typedef struct sSimSample
+{
+    double Snr;
+    int16_t Rssi;
+    double UplinkLoss;
+}SimSample_t;
+
+/*!
+ * Results of a policy
+ */
+typedef struct sSimResult
+{
+    uint32_t NbDelivered;
+    uint32_t NbTransmissions;
+    uint64_t Airtime;
+    double TxPowerSum;
+    uint32_t DatarateSum;
+}SimResult_t;
+
+static SimSample_t Trace[SIM_MAX_UPLINKS];
+
+static uint32_t NbUplinks = 0;
+
+/*!
+ * Fast fading generator
+ */
+static RandState_t FadingRand;
+
+TimerTime_t TimerGetCurrentTime( void )
+{
+    return 0;
+}
+
+TimerTime_t TimerGetElapsedTime( TimerTime_t past )
+{
+    return 0;
+}
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+/*!
+ * \brief LoRa time on air in ms, the regions only need this radio function
+ */
+static uint32_t SimTimeOnAir( RadioModems_t modem, uint32_t bandwidth, uint32_t datarate, uint8_t coderate,
+                              uint16_t preambleLen, bool fixLen, uint8_t payloadLen, bool crcOn )
+{
+    uint32_t bw = 125000 << bandwidth;
+    bool lowDatareOptimize = ( ( bandwidth == 0 ) && ( datarate >= 11 ) ) ||
+                             ( ( bandwidth == 1 ) && ( datarate == 12 ) );
+    int32_t ceilNumerator = ( payloadLen << 3 ) - ( 4 * datarate ) + 28 + ( crcOn ? 16 : 0 ) - ( fixLen ? 20 : 0 );
+    int32_t ceilDenominator = 4 * ( datarate - ( lowDatareOptimize ? 2 : 0 ) );
+    uint32_t nbSymbols = 0;
+
+    if( ceilNumerator < 0 )
+    {
+        ceilNumerator = 0;
+    }
+    // Symbols in quarters: 4.25 preamble symbols overhead
+    nbSymbols = ( ( preambleLen + 8 ) * 4 + 17 ) +
+                ( ( ( ceilNumerator + ceilDenominator - 1 ) / ceilDenominator ) * ( coderate + 4 ) ) * 4;
+    return ( uint32_t )( ( ( uint64_t )nbSymbols * ( 1 << datarate ) * 1000 / 4 + bw - 1 ) / bw );
+}
+
+const struct Radio_s Radio =
+{
+    .TimeOnAir = SimTimeOnAir,
+};
+
+/*!
+ * \brief Demodulation SNR floor of a spreading factor, in dB
+ */
+static double GetRequiredSnr( uint8_t sf )
+{
+    return -7.5 - 2.5 * ( sf - 7 );
+}
+
+/*!
+ * \brief Draws a fast fading sample, Box-Muller transform
+ */
+static double GetFading( void )
+{
+    double u1 = ( RandNext( &FadingRand ) + 1.0 ) / 4294967297.0;
+    double u2 = RandNext( &FadingRand ) / 4294967296.0;
+
+    return SIM_FADING * sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+static bool LoadTrace( const char* path )
+{
+    FILE* file = fopen( path, "r" );
+    char line[128];
+
+    if( file == NULL )
+    {
+        printf( "Cannot open %s\n", path );
+        return false;
+    }
+    NbUplinks = 0;
+    while( ( fgets( line, sizeof( line ), file ) != NULL ) && ( NbUplinks < SIM_MAX_UPLINKS ) )
+    {
+        unsigned long time;
+        double snr;
+        int rssi;
+        double uplinkLoss = 0.0;
+
+        if( ( line[0] == '#' ) || ( sscanf( line, "%lu,%lf,%d,%lf", &time, &snr, &rssi, &uplinkLoss ) < 3 ) )
+        {
+            continue;
+        }
+        Trace[NbUplinks].Snr = snr;
+        Trace[NbUplinks].Rssi = rssi;
+        Trace[NbUplinks].UplinkLoss = uplinkLoss;
+        NbUplinks++;
+    }
+    fclose( file );
+    return NbUplinks != 0;
+}
+
+/*!
+ * \brief Replays the trace
+ *
+ * \param [IN]  isEngine Set to true to run the rate control engine, false to
+ *                       use a fixed datarate at the maximum TX power
+ * \param [IN]  fixedDr  Fixed datarate
+ * \param [OUT] result   Results of the policy
+ */
+static void Replay( bool isEngine, int8_t fixedDr, SimResult_t* result )
+{
+    const LoRaMacRateControl_t* engine = &LoRaMacRateControlLinkMargin;
+    RateControlLinkMarginCtx_t engineCtx;
+    int8_t datarate = isEngine ? EU868_DEFAULT_DATARATE : fixedDr;
+    int8_t txPower = EU868_DEFAULT_TX_POWER;
+
+    memset( result, 0, sizeof( SimResult_t ) );
+    RandInit( &FadingRand, 0x5EED );
+    engine->Init( &engineCtx, LORAMAC_REGION_EU868 );
+
+    for( uint32_t i = 0; i < NbUplinks; i++ )
+    {
+        bool isConfirmed = ( i % SIM_CONFIRMED_PERIOD ) == ( SIM_CONFIRMED_PERIOD - 1 );
+        uint8_t maxTrials = isConfirmed ? SIM_CONFIRMED_NB_TRIALS : 1;
+        uint8_t sf = DataratesEU868[datarate];
+        uint8_t bw = BandwidthsEU868[datarate] / 250000;
+        bool isDelivered = false;
+        bool isAcked = false;
+        uint8_t nbTrials = 0;
+
+        if( isEngine == true )
+        {
+            engine->GetNext( &engineCtx, &datarate, &txPower );
+            sf = DataratesEU868[datarate];
+            bw = BandwidthsEU868[datarate] / 250000;
+        }
+
+        while( ( nbTrials < maxTrials ) && ( isAcked == false ) )
+        {
+            // TX power indexes are 2 dB steps below the maximum EIRP
+            double snr = Trace[i].Snr - Trace[i].UplinkLoss - 2.0 * txPower - 3.0 * bw + GetFading( );
+
+            nbTrials++;
+            result->NbTransmissions++;
+            result->Airtime += SimTimeOnAir( MODEM_LORA, bw, sf, 1, 8, false, SIM_UPLINK_SIZE, true );
+            result->TxPowerSum += EU868_DEFAULT_MAX_EIRP - 2.0 * txPower;
+            result->DatarateSum += datarate;
+            if( snr < GetRequiredSnr( sf ) )
+            {
+                continue;
+            }
+            isDelivered = true;
+            if( isConfirmed == true )
+            {
+                // The gateway answers at the maximum TX power
+                double fading = GetFading( );
+                double dlSnr = Trace[i].Snr - 3.0 * bw + fading;
+
+                if( dlSnr >= GetRequiredSnr( sf ) )
+                {
+                    isAcked = true;
+                    if( isEngine == true )
+                    {
+                        engine->OnDownlink( &engineCtx, datarate, ( int16_t )lround( Trace[i].Rssi + fading ),
+                                            ( int8_t )lround( fmin( dlSnr, SIM_SNR_SATURATION ) ) );
+                    }
+                }
+            }
+        }
+        if( isEngine == true )
+        {
+            engine->OnUplinkDone( &engineCtx, datarate, txPower, isConfirmed, isAcked, nbTrials );
+        }
+        if( isDelivered == true )
+        {
+            result->NbDelivered++;
+        }
+    }
+}
+
+static void PrintResult( const char* name, const SimResult_t* result )
+{
+    // The airtime is averaged per uplink, the TX power and the datarate per
+    // transmission
+    printf( "  %-8s %9.1f %15.1f %9.1f %9.2f\n", name, 100.0 * result->NbDelivered / NbUplinks,
+            ( double )result->Airtime / NbUplinks, result->TxPowerSum / result->NbTransmissions,
+            ( double )result->DatarateSum / result->NbTransmissions );
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: rate-sim trace.csv [...]
+ *
+ * Fails when the engine delivers less than SIM_MIN_DELIVERY percent of the
+ * uplinks delivered at DR0, or uses more airtime than DR0.
+ */
+int main( int argc, char *argv[] )
+{
+    bool isSuccess = true;
+
+    if( argc < 2 )
+    {
+        printf( "Usage: rate-sim trace.csv [...]\n" );
+        return EXIT_FAILURE;
+    }
+
+    for( int t = 1; t < argc; t++ )
+    {
+        SimResult_t engine;
+        SimResult_t dr0;
+
+        if( LoadTrace( argv[t] ) == false )
+        {
+            return EXIT_FAILURE;
+        }
+        printf( "%s: %u uplinks, 1 in %u confirmed\n", argv[t], NbUplinks, SIM_CONFIRMED_PERIOD );
+        printf( "  policy   delivered  airtime/uplink  TX power  datarate\n" );
+        printf( "                 (%%)            (ms)     (dBm)    (mean)\n" );
+        Replay( true, 0, &engine );
+        PrintResult( "engine", &engine );
+        for( int8_t dr = DR_0; dr <= DR_5; dr++ )
+        {
+            SimResult_t result;
+            char name[16];
+
+            Replay( false, dr, &result );
+            snprintf( name, sizeof( name ), "DR%d", dr );
+            PrintResult( name, &result );
+            if( dr == DR_0 )
+            {
+                dr0 = result;
+            }
+        }
+        printf( "\n" );
+
+        if( ( ( engine.NbDelivered * 100 ) < ( SIM_MIN_DELIVERY * dr0.NbDelivered ) ) || ( engine.Airtime >= dr0.Airtime ) )
+        {
+            isSuccess = false;
+        }
+    }
+    return ( isSuccess == true ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,309 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host stress test of the lock-free single producer, single
+ *            consumer ring buffer.
+ *
+ *            A producer thread and a consumer thread transfer a byte
+ *            sequence through ring buffers of several sizes, with random
+ *            mixes of the push, pop, peek and skip functions. The producer
+ *            either pushes the bytes or writes them to the buffer and calls
+ *            RingBufferSetWriteIndex, as the circular DMA transfers do. The
+ *            consumer checks every byte and the stored bytes count.
+ *
+ *            Meant to be run under ThreadSanitizer as well, see
+ *            CMakeLists.txt.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "utilities.h"
+#include "ringbuffer.h"
+
+/*!
+ * Default number of bytes transferred per configuration
+ */
+#define STRESS_NB_BYTES                             4000000
+
+/*!
+ * Largest ring buffer size
+ */
+#define STRESS_MAX_SIZE                             256
+
+/*!
+ * Producer modes
+ */
+typedef enum eStressProducer
+{
+    STRESS_PRODUCER_PUSH,
+    STRESS_PRODUCER_DMA,
+}StressProducer_t;
+
+static const char* ProducerNames[] = { "push", "DMA" };
+
+/*!
+ * Stress test context, shared by both threads
+ */
+typedef struct sStress
+{
+    RingBuffer_t Rb;
+    uint8_t Buffer[STRESS_MAX_SIZE];
+    StressProducer_t Producer;
+    uint32_t NbBytes;
+    /*!
+     * Consumer results
+     */
+    uint32_t NbErrors;
+    uint32_t FirstError;
+    uint32_t NbCalls;
+}Stress_t;
+
+/*!
+ * \brief Byte of the transferred sequence. Depends on all the bits of the
+ *        position, detecting lost or repeated bytes as well as whole buffer
+ *        wraps.
+ */
+static uint8_t SequenceByte( uint32_t n )
+{
+    return ( uint8_t )( n ^ ( n >> 8 ) ^ ( n >> 16 ) ^ ( n >> 24 ) );
+}
+
+static void PushProducer( Stress_t *stress, RandState_t *rand )
+{
+    uint8_t data[2 * STRESS_MAX_SIZE];
+    uint32_t n = 0;
+
+    while( n < stress->NbBytes )
+    {
+        if( RandBelow( rand, 2 ) == 0 )
+        {
+            if( RingBufferPush( &stress->Rb, SequenceByte( n ) ) == true )
+            {
+                n++;
+                continue;
+            }
+        }
+        else
+        {
+            // Up to twice the buffer size, truncated when full
+            uint16_t size = RandRange( rand, 1, 2 * stress->Rb.Size );
+
+            size = MIN( size, stress->NbBytes - n );
+
+            for( uint16_t i = 0; i < size; i++ )
+            {
+                data[i] = SequenceByte( n + i );
+            }
+            size = RingBufferPushN( &stress->Rb, data, size );
+            if( size != 0 )
+            {
+                n += size;
+                continue;
+            }
+        }
+        sched_yield( );
+    }
+}
+
+static void DmaProducer( Stress_t *stress, RandState_t *rand )
+{
+    uint16_t writeIndex = 0;
+    uint32_t n = 0;
+
+    while( n < stress->NbBytes )
+    {
+        // A circular DMA transfer does not wait for the consumer. The
+        // producer only writes the free bytes, less than a whole buffer
+        // between 2 calls to RingBufferSetWriteIndex.
+        uint16_t free = stress->Rb.Size - RingBufferCount( &stress->Rb );
+        uint16_t size = MIN( MIN( free, stress->Rb.Size - 1 ), stress->NbBytes - n );
+
+        if( size == 0 )
+        {
+            sched_yield( );
+            continue;
+        }
+        size = RandRange( rand, 1, size );
+        for( uint16_t i = 0; i < size; i++ )
+        {
+            stress->Rb.Data[writeIndex] = SequenceByte( n++ );
+            writeIndex = ( writeIndex + 1 ) & stress->Rb.Mask;
+        }
+        RingBufferSetWriteIndex( &stress->Rb, writeIndex );
+    }
+}
+
+static void* ProducerThread( void *context )
+{
+    Stress_t *stress = context;
+    RandState_t rand;
+
+    RandInit( &rand, 1 );
+    if( stress->Producer == STRESS_PRODUCER_PUSH )
+    {
+        PushProducer( stress, &rand );
+    }
+    else
+    {
+        DmaProducer( stress, &rand );
+    }
+    return NULL;
+}
+
+static void Check( Stress_t *stress, uint32_t n, const uint8_t *data, uint16_t size )
+{
+    for( uint16_t i = 0; i < size; i++ )
+    {
+        if( data[i] != SequenceByte( n + i ) )
+        {
+            if( stress->NbErrors == 0 )
+            {
+                stress->FirstError = n + i;
+            }
+            stress->NbErrors++;
+        }
+    }
+}
+
+static void* ConsumerThread( void *context )
+{
+    Stress_t *stress = context;
+    uint8_t data[2 * STRESS_MAX_SIZE];
+    RandState_t rand;
+    uint32_t n = 0;
+
+    RandInit( &rand, 2 );
+    while( n < stress->NbBytes )
+    {
+        uint16_t size = 0;
+        uint8_t *span;
+
+        if( RingBufferCount( &stress->Rb ) > stress->Rb.Size )
+        {
+            stress->NbErrors++;
+        }
+        switch( RandBelow( &rand, 3 ) )
+        {
+            case 0:
+                size = ( RingBufferPop( &stress->Rb, data ) == true ) ? 1 : 0;
+                Check( stress, n, data, size );
+                break;
+            case 1:
+                size = RingBufferPopN( &stress->Rb, data, RandRange( &rand, 1, 2 * stress->Rb.Size ) );
+                Check( stress, n, data, size );
+                break;
+            default:
+                // Zero-copy parsing of a part of the contiguous span
+                size = RingBufferPeek( &stress->Rb, &span );
+                if( size != 0 )
+                {
+                    size = RandRange( &rand, 1, size );
+                    Check( stress, n, span, size );
+                    if( RingBufferSkip( &stress->Rb, size ) != size )
+                    {
+                        stress->NbErrors++;
+                    }
+                }
+                break;
+        }
+        stress->NbCalls++;
+        n += size;
+        if( size == 0 )
+        {
+            sched_yield( );
+        }
+    }
+    if( IsRingBufferEmpty( &stress->Rb ) == false )
+    {
+        stress->NbErrors++;
+    }
+    return NULL;
+}
+
+/*!
+ * \brief Transfers the byte sequence between 2 threads
+ *
+ * \retval status [true: all the bytes received in order, false: errors]
+ */
+static bool Run( Stress_t *stress, StressProducer_t producer, uint16_t size, uint32_t nbBytes )
+{
+    pthread_t producerThread;
+    pthread_t consumerThread;
+
+    RingBufferInit( &stress->Rb, stress->Buffer, size );
+    stress->Producer = producer;
+    stress->NbBytes = nbBytes;
+    stress->NbErrors = 0;
+    stress->FirstError = 0;
+    stress->NbCalls = 0;
+
+    if( ( pthread_create( &consumerThread, NULL, ConsumerThread, stress ) != 0 ) ||
+        ( pthread_create( &producerThread, NULL, ProducerThread, stress ) != 0 ) )
+    {
+        printf( "pthread_create failed\n" );
+        exit( EXIT_FAILURE );
+    }
+    pthread_join( producerThread, NULL );
+    pthread_join( consumerThread, NULL );
+
+    printf( "  %-5s %5u %10u %10u %8u", ProducerNames[producer], size, nbBytes, stress->NbCalls, stress->NbErrors );
+    if( stress->NbErrors != 0 )
+    {
+        printf( "   first error at byte %u", stress->FirstError );
+    }
+    printf( "\n" );
+    return stress->NbErrors == 0;
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: ringbuffer-stress [bytes per configuration]
+ */
+int main( int argc, char *argv[] )
+{
+    static const uint16_t sizes[] = { 1, 2, 16, STRESS_MAX_SIZE };
+    static Stress_t stress;
+    uint32_t nbBytes = STRESS_NB_BYTES;
+    bool isSuccess = true;
+
+    if( argc > 1 )
+    {
+        nbBytes = strtoul( argv[1], NULL, 0 );
+    }
+
+    printf( "  mode   size      bytes   consumer   errors\n" );
+    for( uint8_t producer = STRESS_PRODUCER_PUSH; producer <= STRESS_PRODUCER_DMA; producer++ )
+    {
+        for( uint8_t i = 0; i < ( sizeof( sizes ) / sizeof( sizes[0] ) ); i++ )
+        {
+            // A 1 byte DMA buffer cannot hold a transfer, see DmaProducer
+            if( ( producer == STRESS_PRODUCER_DMA ) && ( sizes[i] == 1 ) )
+            {
+                continue;
+            }
+            if( Run( &stress, ( StressProducer_t )producer, sizes[i], nbBytes ) == false )
+            {
+                isSuccess = false;
+            }
+        }
+    }
+    return ( isSuccess == true ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host benchmark of the SX126x deferred command sequences.
+ *
+ *            Runs the radio configuration functions against a simulated
+ *            board, once with the boards waiting for BUSY after each write and
+ *            once with the waits deferred by SX126xCmdQueueBegin/End. The MCU
+ *            then prepares and transfers the next command while the radio
+ *            still processes the previous one. The deferred sequences return
+ *            before the radio has processed their last command, which is
+ *            completed by the BUSY falling edge interrupt.
+ *
+ *            Prints one CSV line per sequence and BUSY time:
+ *            sequence,busy_ns,commands,blocking_ns,deferred_ns,gain_pct,return_ns
+ *
+ *            deferred_ns is the time until the radio has processed the last
+ *            command, return_ns the time until the deferred sequence returned.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "radio.h"
+#include "sim-board.h"
+
+/*!
+ * Default SPI byte time in ns: 8 MHz SPI clock and the byte per byte driver
+ * overhead
+ */
+#define SIM_BYTE_TIME                               2000
+
+/*!
+ * Default MCU time in ns spent preparing each command
+ */
+#define SIM_COMMAND_TIME                            5000
+
+/*!
+ * Simulated BUSY high times in ns after each command
+ */
+static const uint32_t BusyTimes[] = { 2000, 10000, 50000 };
+
+/*!
+ * Simulated command sequences
+ */
+typedef enum eSimSequence
+{
+    SIM_SEQUENCE_LORA_RX_CONFIG,
+    SIM_SEQUENCE_LORA_TX_CONFIG,
+    SIM_SEQUENCE_FSK_RX_CONFIG,
+    SIM_SEQUENCE_FSK_TX_CONFIG,
+    SIM_NB_SEQUENCES,
+}SimSequence_t;
+
+static const char* SequenceNames[SIM_NB_SEQUENCES] =
+{
+    "lora-rx-config",
+    "lora-tx-config",
+    "fsk-rx-config",
+    "fsk-tx-config",
+};
+
+static RadioEvents_t RadioEvents;
+
+static void RunSequence( SimSequence_t sequence )
+{
+    switch( sequence )
+    {
+        case SIM_SEQUENCE_LORA_RX_CONFIG:
+        {
+            Radio.SetRxConfig( MODEM_LORA, 0, 7, 1, 0, 8, 5, false, 0, true, false, 0, true, false );
+            break;
+        }
+        case SIM_SEQUENCE_LORA_TX_CONFIG:
+        {
+            Radio.SetTxConfig( MODEM_LORA, 14, 0, 0, 7, 1, 8, false, true, false, 0, false, 4000 );
+            break;
+        }
+        case SIM_SEQUENCE_FSK_RX_CONFIG:
+        {
+            Radio.SetRxConfig( MODEM_FSK, 50000, 50000, 0, 83333, 5, 0, false, 0, true, false, 0, false, false );
+            break;
+        }
+        case SIM_SEQUENCE_FSK_TX_CONFIG:
+        {
+            Radio.SetTxConfig( MODEM_FSK, 14, 25000, 0, 50000, 0, 5, false, true, false, 0, false, 4000 );
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static void Measure( SimBoardModel_t* model, SimSequence_t sequence, SimBoardStats_t* stats )
+{
+    SimBoardSetModel( model );
+    SimBoardResetStats( );
+    RunSequence( sequence );
+    SimBoardGetStats( stats );
+}
+
+/**
+ * Main application entry point.
+ *
+ * Usage: sx126x-bench [SPI byte time ns] [MCU time per command ns]
+ */
+int main( int argc, char *argv[] )
+{
+    SimBoardModel_t model =
+    {
+        .ByteTime = SIM_BYTE_TIME,
+        .CommandTime = SIM_COMMAND_TIME,
+    };
+    bool isSlower = false;
+    bool isIrqMissing = false;
+
+    if( argc > 1 )
+    {
+        model.ByteTime = strtoul( argv[1], NULL, 0 );
+    }
+    if( argc > 2 )
+    {
+        model.CommandTime = strtoul( argv[2], NULL, 0 );
+    }
+
+    SimBoardSetModel( &model );
+    Radio.Init( &RadioEvents );
+
+    printf( "sequence,busy_ns,commands,blocking_ns,deferred_ns,gain_pct,return_ns\n" );
+    for( uint8_t b = 0; b < sizeof( BusyTimes ) / sizeof( BusyTimes[0] ); b++ )
+    {
+        model.BusyTime = BusyTimes[b];
+        for( uint8_t s = 0; s < SIM_NB_SEQUENCES; s++ )
+        {
+            SimBoardStats_t blocking;
+            SimBoardStats_t deferred;
+
+            model.IsCmdQueueEnabled = false;
+            Measure( &model, ( SimSequence_t )s, &blocking );
+            model.IsCmdQueueEnabled = true;
+            Measure( &model, ( SimSequence_t )s, &deferred );
+
+            printf( "%s,%u,%u,%llu,%llu,%.1f,%llu\n", SequenceNames[s], BusyTimes[b], blocking.NbCommands,
+                    ( unsigned long long )blocking.Time, ( unsigned long long )deferred.Time,
+                    100.0 * ( ( double )blocking.Time - ( double )deferred.Time ) / ( double )blocking.Time,
+                    ( unsigned long long )deferred.ReturnTime );
+            if( ( deferred.Time > blocking.Time ) || ( deferred.NbCommands != blocking.NbCommands ) )
+            {
+                isSlower = true;
+            }
+            // The blocking sequence ends with BUSY low, the deferred one
+            // returns right after its last command and completes from the
+            // BUSY interrupt
+            if( ( blocking.NbBusyIrqs != 0 ) || ( deferred.NbBusyIrqs != 1 ) ||
+                ( deferred.ReturnTime >= deferred.Time ) )
+            {
+                isIrqMissing = true;
+            }
+        }
+    }
+    if( isSlower == true )
+    {
+        printf( "Deferred sequence slower than the blocking one\n" );
+        return EXIT_FAILURE;
+    }
+    if( isIrqMissing == true )
+    {
+        printf( "Deferred sequence not completed by the BUSY interrupt\n" );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
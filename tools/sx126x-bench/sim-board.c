@@ -0,0 +1,363 @@
+/*!
+ * \file      sim-board.c
+ *
+ * \brief     Simulated SX126x board of the command sequence benchmark. The
+ *            SPI primitives mirror the SX126x boards and advance a virtual
+ *            clock instead of driving the pins. BUSY goes high for a fixed
+ *            time each time NSS is released.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include "utilities.h"
+#include "delay-board.h"
+#include "rtc-board.h"
+#include "radio.h"
+#include "sx126x-board.h"
+#include "sim-board.h"
+
+/*!
+ * Simulated board state
+ */
+static struct
+{
+    SimBoardModel_t Model;
+    SimBoardStats_t Stats;
+    uint64_t Now;
+    uint64_t BusyEnd;
+    DioIrqHandler* BusyIrq;
+    uint32_t RtcContext;
+    RadioOperatingModes_t OperatingMode;
+}Sim;
+
+/*!
+ * \brief Simulates a SPI transaction: MCU preparation, NSS low, transfer of
+ *        the given number of bytes and NSS high, which raises BUSY
+ *
+ * \param [IN] size Number of bytes, opcode included
+ */
+static void SimSpiTransaction( uint16_t size )
+{
+    Sim.Now += ( uint64_t )size * Sim.Model.ByteTime;
+    Sim.BusyEnd = Sim.Now + Sim.Model.BusyTime;
+    Sim.Stats.NbCommands++;
+}
+
+/*!
+ * \brief Raises the BUSY falling edge interrupt when armed and BUSY is low
+ */
+static void SimCheckBusyIrq( void )
+{
+    if( ( Sim.BusyIrq != NULL ) && ( Sim.Now >= Sim.BusyEnd ) )
+    {
+        Sim.Stats.NbBusyIrqs++;
+        Sim.BusyIrq( NULL );
+    }
+}
+
+/*!
+ * \brief Simulates the MCU work preparing the next command
+ */
+static void SimPrepareCommand( void )
+{
+    Sim.Now += Sim.Model.CommandTime;
+    SimCheckBusyIrq( );
+}
+
+/*!
+ * \brief Checks if the board skips the BUSY wait after a write
+ */
+static bool SimIsWaitDeferred( void )
+{
+    return ( Sim.Model.IsCmdQueueEnabled == true ) && ( SX126xCmdQueueIsActive( ) == true );
+}
+
+void SimBoardSetModel( const SimBoardModel_t* model )
+{
+    Sim.Model = *model;
+}
+
+void SimBoardResetStats( void )
+{
+    SX126xWaitOnBusy( );
+    Sim.Stats.BusyWaitTime = 0;
+    Sim.Stats.NbCommands = 0;
+    Sim.Stats.NbBusyIrqs = 0;
+    Sim.Stats.Time = Sim.Now;
+}
+
+void SimBoardGetStats( SimBoardStats_t* stats )
+{
+    uint64_t start = Sim.Stats.Time;
+
+    stats->ReturnTime = Sim.Now - start;
+    // Let the radio process the last command
+    if( Sim.Now < Sim.BusyEnd )
+    {
+        Sim.Now = Sim.BusyEnd;
+    }
+    SimCheckBusyIrq( );
+
+    stats->Time = Sim.Now - start;
+    stats->BusyWaitTime = Sim.Stats.BusyWaitTime;
+    stats->NbCommands = Sim.Stats.NbCommands;
+    stats->NbBusyIrqs = Sim.Stats.NbBusyIrqs;
+}
+
+void SX126xIoInit( void )
+{
+}
+
+void SX126xIoIrqInit( DioIrqHandler dioIrq )
+{
+}
+
+void SX126xIoBusyIrqInit( DioIrqHandler busyIrq )
+{
+    Sim.BusyIrq = busyIrq;
+}
+
+void SX126xIoDeInit( void )
+{
+}
+
+void SX126xIoTcxoInit( void )
+{
+}
+
+void SX126xIoRfSwitchInit( void )
+{
+}
+
+void SX126xIoDbgInit( void )
+{
+}
+
+uint32_t SX126xGetBoardTcxoWakeupTime( void )
+{
+    return 0;
+}
+
+void SX126xReset( void )
+{
+    Sim.BusyEnd = Sim.Now;
+    Sim.OperatingMode = MODE_STDBY_RC;
+}
+
+void SX126xWaitOnBusy( void )
+{
+    if( Sim.Now < Sim.BusyEnd )
+    {
+        Sim.Stats.BusyWaitTime += Sim.BusyEnd - Sim.Now;
+        Sim.Now = Sim.BusyEnd;
+    }
+    SimCheckBusyIrq( );
+}
+
+uint32_t GpioRead( Gpio_t *obj )
+{
+    // Only the BUSY pin is read by the driver
+    return ( Sim.Now < Sim.BusyEnd ) ? 1 : 0;
+}
+
+void SX126xWakeup( void )
+{
+    SimSpiTransaction( 2 );
+    SX126xWaitOnBusy( );
+}
+
+void SX126xWriteCommand( RadioCommands_t command, uint8_t *buffer, uint16_t size )
+{
+    SimPrepareCommand( );
+    SX126xCheckDeviceReady( );
+    SimSpiTransaction( 1 + size );
+
+    if( ( command != RADIO_SET_SLEEP ) && ( SimIsWaitDeferred( ) == false ) )
+    {
+        SX126xWaitOnBusy( );
+    }
+}
+
+uint8_t SX126xReadCommand( RadioCommands_t command, uint8_t *buffer, uint16_t size )
+{
+    SimPrepareCommand( );
+    SX126xCheckDeviceReady( );
+    SimSpiTransaction( 2 + size );
+    memset1( buffer, 0, size );
+
+    SX126xWaitOnBusy( );
+    return 0;
+}
+
+void SX126xWriteRegisters( uint16_t address, uint8_t *buffer, uint16_t size )
+{
+    SimPrepareCommand( );
+    SX126xCheckDeviceReady( );
+    SimSpiTransaction( 3 + size );
+
+    if( SimIsWaitDeferred( ) == false )
+    {
+        SX126xWaitOnBusy( );
+    }
+}
+
+void SX126xWriteRegister( uint16_t address, uint8_t value )
+{
+    SX126xWriteRegisters( address, &value, 1 );
+}
+
+void SX126xReadRegisters( uint16_t address, uint8_t *buffer, uint16_t size )
+{
+    SimPrepareCommand( );
+    SX126xCheckDeviceReady( );
+    SimSpiTransaction( 4 + size );
+    memset1( buffer, 0, size );
+
+    SX126xWaitOnBusy( );
+}
+
+uint8_t SX126xReadRegister( uint16_t address )
+{
+    uint8_t data;
+    SX126xReadRegisters( address, &data, 1 );
+    return data;
+}
+
+void SX126xWriteBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
+{
+    SimPrepareCommand( );
+    SX126xCheckDeviceReady( );
+    SimSpiTransaction( 2 + size );
+
+    if( SimIsWaitDeferred( ) == false )
+    {
+        SX126xWaitOnBusy( );
+    }
+}
+
+void SX126xReadBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
+{
+    SimPrepareCommand( );
+    SX126xCheckDeviceReady( );
+    SimSpiTransaction( 3 + size );
+    memset1( buffer, 0, size );
+
+    SX126xWaitOnBusy( );
+}
+
+void SX126xSetRfTxPower( int8_t power )
+{
+    SX126xSetTxParams( power, RADIO_RAMP_40_US );
+}
+
+uint8_t SX126xGetDeviceId( void )
+{
+    return SX1262;
+}
+
+void SX126xAntSwOn( void )
+{
+}
+
+void SX126xAntSwOff( void )
+{
+}
+
+bool SX126xCheckRfFrequency( uint32_t frequency )
+{
+    return true;
+}
+
+RadioOperatingModes_t SX126xGetOperatingMode( void )
+{
+    return Sim.OperatingMode;
+}
+
+void SX126xSetOperatingMode( RadioOperatingModes_t mode )
+{
+    Sim.OperatingMode = mode;
+}
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+void DelayMsMcu( uint32_t ms )
+{
+    Sim.Now += ( uint64_t )ms * 1000000;
+}
+
+/*
+ * Virtual RTC for the timer module, 1 tick per ms of simulated time. The
+ * benchmark doesn't run the timers.
+ */
+
+uint32_t RtcGetMinimumTimeout( void )
+{
+    return 1;
+}
+
+uint32_t RtcMs2Tick( TimerTime_t milliseconds )
+{
+    return milliseconds;
+}
+
+TimerTime_t RtcTick2Ms( uint32_t tick )
+{
+    return tick;
+}
+
+void RtcSetAlarm( uint32_t timeout )
+{
+}
+
+void RtcStopAlarm( void )
+{
+}
+
+uint32_t RtcSetTimerContext( void )
+{
+    Sim.RtcContext = RtcGetTimerValue( );
+    return Sim.RtcContext;
+}
+
+uint32_t RtcGetTimerContext( void )
+{
+    return Sim.RtcContext;
+}
+
+uint32_t RtcGetTimerValue( void )
+{
+    return ( uint32_t )( Sim.Now / 1000000 );
+}
+
+uint32_t RtcGetTimerElapsedTime( void )
+{
+    return RtcGetTimerValue( ) - Sim.RtcContext;
+}
+
+void RtcProcess( void )
+{
+}
+
+TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
+{
+    return period;
+}
@@ -0,0 +1,108 @@
+/*!
+ * \file      sim-board.h
+ *
+ * \brief     Simulated SX126x board of the command sequence benchmark
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#ifndef __SIM_BOARD_H__
+#define __SIM_BOARD_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Timing model of the simulated board. All times in ns.
+ */
+typedef struct sSimBoardModel
+{
+    /*!
+     * Time to transfer one byte over SPI, including the driver overhead
+     */
+    uint32_t ByteTime;
+    /*!
+     * Time the MCU spends preparing each command before asserting NSS
+     */
+    uint32_t CommandTime;
+    /*!
+     * Time BUSY stays high after NSS is released
+     */
+    uint32_t BusyTime;
+    /*!
+     * The board primitives skip the BUSY wait after a write while a deferred
+     * command sequence is active. When false they always wait, as the boards
+     * did before the deferred sequences.
+     */
+    bool IsCmdQueueEnabled;
+}SimBoardModel_t;
+
+/*!
+ * Statistics of the simulated board
+ */
+typedef struct sSimBoardStats
+{
+    /*!
+     * Simulated time in ns until the radio has processed the last command
+     */
+    uint64_t Time;
+    /*!
+     * Simulated time in ns until the sequence returned to the caller
+     */
+    uint64_t ReturnTime;
+    /*!
+     * Time in ns spent waiting for BUSY to go low
+     */
+    uint64_t BusyWaitTime;
+    /*!
+     * Number of SPI transactions
+     */
+    uint32_t NbCommands;
+    /*!
+     * Number of BUSY falling edge interrupts delivered
+     */
+    uint32_t NbBusyIrqs;
+}SimBoardStats_t;
+
+/*!
+ * \brief Sets the timing model
+ *
+ * \param [IN] model Timing model
+ */
+void SimBoardSetModel( const SimBoardModel_t* model );
+
+/*!
+ * \brief Waits until BUSY is low and clears the statistics
+ */
+void SimBoardResetStats( void );
+
+/*!
+ * \brief Lets the radio process the last command and gets the statistics
+ *        since the last \ref SimBoardResetStats
+ *
+ * \param [OUT] stats Statistics
+ */
+void SimBoardGetStats( SimBoardStats_t* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SIM_BOARD_H__
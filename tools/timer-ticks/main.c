@@ -0,0 +1,246 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host test of the timer RTC tick time base, see timer.h
+ *
+ *            Checks the us/ms to RTC ticks conversions against an exact
+ *            reference, the 64 bits extension of the 32 bits RTC timer value
+ *            across wrap arounds and the deadlines armed by TimerStartAt.
+ *            The RTC is simulated at TEST_RTC_FREQUENCY.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "utilities.h"
+#include "board.h"
+#include "rtc-board.h"
+#include "timer.h"
+
+#ifndef TEST_RTC_FREQUENCY
+#define TEST_RTC_FREQUENCY                          32768
+#endif
+
+/*!
+ * Simulated RTC minimum alarm timeout [ticks]
+ */
+#define TEST_RTC_MIN_TIMEOUT                        3
+
+/*!
+ * Simulated RTC
+ */
+static struct
+{
+    uint32_t Now;
+    uint32_t Context;
+    uint32_t Alarm;
+    bool IsAlarmArmed;
+}Rtc;
+
+static uint32_t NbFailures = 0;
+
+#define CHECK( cond, ... )                                                     \
+    do                                                                         \
+    {                                                                          \
+        if( !( cond ) )                                                        \
+        {                                                                      \
+            printf( "FAIL line %d: ", __LINE__ );                              \
+            printf( __VA_ARGS__ );                                             \
+            printf( "\n" );                                                    \
+            NbFailures++;                                                      \
+        }                                                                      \
+    } while( 0 )
+
+void BoardCriticalSectionBegin( uint32_t *mask )
+{
+    *mask = 0;
+}
+
+void BoardCriticalSectionEnd( uint32_t *mask )
+{
+}
+
+uint32_t RtcGetMinimumTimeout( void )
+{
+    return TEST_RTC_MIN_TIMEOUT;
+}
+
+uint32_t RtcMs2Tick( TimerTime_t milliseconds )
+{
+    return ( uint32_t )( ( ( uint64_t )milliseconds * TEST_RTC_FREQUENCY ) / 1000 );
+}
+
+TimerTime_t RtcTick2Ms( uint32_t tick )
+{
+    return ( TimerTime_t )( ( ( uint64_t )tick * 1000 ) / TEST_RTC_FREQUENCY );
+}
+
+void RtcSetAlarm( uint32_t timeout )
+{
+    Rtc.Alarm = Rtc.Context + timeout;
+    Rtc.IsAlarmArmed = true;
+}
+
+void RtcStopAlarm( void )
+{
+    Rtc.IsAlarmArmed = false;
+}
+
+uint32_t RtcSetTimerContext( void )
+{
+    Rtc.Context = Rtc.Now;
+    return Rtc.Context;
+}
+
+uint32_t RtcGetTimerContext( void )
+{
+    return Rtc.Context;
+}
+
+uint32_t RtcGetTimerValue( void )
+{
+    return Rtc.Now;
+}
+
+uint32_t RtcGetTimerElapsedTime( void )
+{
+    return Rtc.Now - Rtc.Context;
+}
+
+void RtcProcess( void )
+{
+}
+
+TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
+{
+    return period;
+}
+
+/*!
+ * \brief Exact reference conversion, value * num / den rounded down
+ */
+static uint64_t Scale( uint64_t value, uint64_t num, uint64_t den )
+{
+    return ( uint64_t )( ( ( unsigned __int128 )value * num ) / den );
+}
+
+static void TestConversions( void )
+{
+    static const uint64_t values[] =
+    {
+        0, 1, 2, 29, 30, 31, 999, 1000, 1001, 32767, 32768, 999999, 1000000, 1000001,
+        UINT32_MAX, ( uint64_t )UINT32_MAX + 1, 1000000000000ULL, 4000000000000000ULL,
+    };
+
+    for( uint8_t i = 0; i < ( sizeof( values ) / sizeof( values[0] ) ); i++ )
+    {
+        uint64_t v = values[i];
+
+        CHECK( TimerUs2Ticks( v ) == Scale( v, TEST_RTC_FREQUENCY, 1000000 ),
+               "TimerUs2Ticks( %" PRIu64 " ) = %" PRIu64, v, TimerUs2Ticks( v ) );
+        CHECK( TimerMs2Ticks( v ) == Scale( v, TEST_RTC_FREQUENCY, 1000 ),
+               "TimerMs2Ticks( %" PRIu64 " ) = %" PRIu64, v, TimerMs2Ticks( v ) );
+        CHECK( TimerTicks2Us( v ) == Scale( v, 1000000, TEST_RTC_FREQUENCY ),
+               "TimerTicks2Us( %" PRIu64 " ) = %" PRIu64, v, TimerTicks2Us( v ) );
+        CHECK( TimerTicks2Ms( v ) == Scale( v, 1000, TEST_RTC_FREQUENCY ),
+               "TimerTicks2Ms( %" PRIu64 " ) = %" PRIu64, v, TimerTicks2Ms( v ) );
+    }
+
+    // Pseudo random values, including the low bits of the shift path
+    srand( 1 );
+    for( uint32_t i = 0; i < 100000; i++ )
+    {
+        uint64_t v = ( ( uint64_t )rand( ) << 31 ) ^ ( uint64_t )rand( );
+
+        CHECK( TimerUs2Ticks( v ) == Scale( v, TEST_RTC_FREQUENCY, 1000000 ), "TimerUs2Ticks( %" PRIu64 " )", v );
+        CHECK( TimerTicks2Us( v ) == Scale( v, 1000000, TEST_RTC_FREQUENCY ), "TimerTicks2Us( %" PRIu64 " )", v );
+        CHECK( TimerMs2Ticks( v ) == Scale( v, TEST_RTC_FREQUENCY, 1000 ), "TimerMs2Ticks( %" PRIu64 " )", v );
+        CHECK( TimerTicks2Ms( v ) == Scale( v, 1000, TEST_RTC_FREQUENCY ), "TimerTicks2Ms( %" PRIu64 " )", v );
+    }
+}
+
+static void TestWrapExtension( void )
+{
+    TimerTicks_t previous = 0;
+    TimerTicks_t ticks = 0;
+
+    Rtc.Now = 0xFFFFFF00;
+    previous = TimerGetCurrentTicks( );
+    CHECK( previous == 0xFFFFFF00, "ticks before the wrap %" PRIx64, previous );
+
+    // Several wrap arounds in steps shorter than a RTC timer period
+    for( uint32_t i = 0; i < 40; i++ )
+    {
+        Rtc.Now += 0x40000000;
+        ticks = TimerGetCurrentTicks( );
+        CHECK( ticks == ( previous + 0x40000000 ), "step %u ticks %" PRIx64 " previous %" PRIx64, i, ticks, previous );
+        previous = ticks;
+    }
+    CHECK( ( previous >> 32 ) == 10, "%" PRIu64 " wraps", previous >> 32 );
+
+    // The timer IRQ handler and TimerProcess refresh the extension
+    Rtc.Now += 0xC0000000;
+    TimerProcess( );
+    Rtc.Now += 0xC0000000;
+    ticks = TimerGetCurrentTicks( );
+    CHECK( ticks == ( previous + 0x180000000ULL ), "TimerProcess refresh ticks %" PRIx64, ticks );
+}
+
+static void OnTimerEvent( void* context )
+{
+}
+
+static void TestStartAt( void )
+{
+    TimerEvent_t timer;
+    TimerTicks_t now = 0;
+
+    TimerInit( &timer, OnTimerEvent );
+
+    // Deadline after the RTC timer wrap around
+    Rtc.Now = 0xFFFFFFF0;
+    now = TimerGetCurrentTicks( );
+    TimerStartAt( &timer, now + 0x100 );
+    CHECK( ( Rtc.IsAlarmArmed == true ) && ( Rtc.Alarm == 0xF0 ), "alarm %08" PRIx32 " across the wrap", Rtc.Alarm );
+    TimerStop( &timer );
+
+    // Deadline already passed
+    Rtc.Now += 0x1000;
+    now = TimerGetCurrentTicks( );
+    TimerStartAt( &timer, now - 10 );
+    CHECK( ( Rtc.IsAlarmArmed == true ) && ( ( uint32_t )( Rtc.Alarm - Rtc.Now ) == TEST_RTC_MIN_TIMEOUT ),
+           "passed deadline alarm in %" PRIu32 " ticks", Rtc.Alarm - Rtc.Now );
+    TimerStop( &timer );
+
+    // Deadline further than a RTC timer period
+    now = TimerGetCurrentTicks( );
+    TimerStartAt( &timer, now + 0x200000000ULL );
+    CHECK( ( Rtc.IsAlarmArmed == true ) && ( ( uint32_t )( Rtc.Alarm - Rtc.Now ) == UINT32_MAX ),
+           "far deadline alarm in %" PRIu32 " ticks", Rtc.Alarm - Rtc.Now );
+    TimerStop( &timer );
+}
+
+int main( void )
+{
+    TestConversions( );
+    TestWrapExtension( );
+    TestStartAt( );
+
+    printf( "RTC %u Hz, %u failures\n", TEST_RTC_FREQUENCY, NbFailures );
+    return ( NbFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
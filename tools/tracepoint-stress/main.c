@@ -0,0 +1,255 @@
+/*!
+ * \file      main.c
+ *
+ * \brief     Host stress test of the lock-free tracepoints recording, see
+ *            tracepoint.h
+ *
+ *            The main loop records a tracepoint continuously while two
+ *            timer signals record two other tracepoints. The signal
+ *            handlers preempt the main loop and each other in strictly
+ *            nested order, as the interrupts of a Cortex-M core do. Each
+ *            tracepoint records the sequence number of its writer. The main
+ *            loop statistics must be exact. The handlers records missing
+ *            from the statistics must all be counted as dropped, and the
+ *            popped events of a tracepoint must be in increasing order.
+ *
+ * \copyright Revised BSD License, see section \ref LICENSE.
+ *
+ * \code
+ *                ______                              _
+ *               / _____)             _              | |
+ *              ( (____  _____ ____ _| |_ _____  ____| |__
+ *               \____ \| ___ |    (_   _) ___ |/ ___)  _ \
+ *               _____) ) ____| | | || |_| ____( (___| | | |
+ *              (______/|_____)_|_|_| \__)_____)\____)_| |_|
+ *              (C)2013-2018 Semtech
+ *
+ * \endcode
+ *
+ * \author    Miguel Luis ( Semtech )
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include "utilities.h"
+#include "tracepoint.h"
+
+/*!
+ * Default number of records of the main loop
+ */
+#define STRESS_NB_RECORDS                           4000000
+
+/*!
+ * Writers: the main loop and the two signal handlers
+ */
+typedef struct sStressWriter
+{
+    const char* Name;
+    TracePointId_t Id;
+    int Signal;
+    /*!
+     * Signal period in ns
+     */
+    long Period;
+    /*!
+     * Number of records, also the last recorded value
+     */
+    volatile uint32_t NbRecords;
+    /*!
+     * Number of records made while the main loop was recording
+     */
+    volatile uint32_t NbPreemptions;
+    timer_t Timer;
+}StressWriter_t;
+
+static StressWriter_t Writers[] =
+{
+    { "main loop", TRACE_POINT_SCHEDULE_TX,   0,       0 },
+    { "SIGALRM",   TRACE_POINT_TIMER_IRQ,     SIGALRM, 23000 },
+    { "SIGUSR1",   TRACE_POINT_RADIO_RX_DONE, SIGUSR1, 37000 },
+};
+
+#define STRESS_NB_WRITERS                           ( sizeof( Writers ) / sizeof( Writers[0] ) )
+
+/*!
+ * Set while the main loop is in TracePointRecord
+ */
+static volatile sig_atomic_t IsMainRecording = 0;
+
+/*!
+ * Last popped value of each writer
+ */
+static uint32_t LastPopped[STRESS_NB_WRITERS];
+static uint32_t NbPopped = 0;
+static uint32_t NbOrderErrors = 0;
+
+static void OnSignal( int signal )
+{
+    for( uint8_t i = 1; i < STRESS_NB_WRITERS; i++ )
+    {
+        if( Writers[i].Signal == signal )
+        {
+            if( IsMainRecording != 0 )
+            {
+                Writers[i].NbPreemptions++;
+            }
+            Writers[i].NbRecords++;
+            TracePointRecord( Writers[i].Id, Writers[i].NbRecords );
+        }
+    }
+}
+
+/*!
+ * \brief Starts the periodic signal of a writer
+ *
+ * \retval status [true: Started, false: Timer creation failed]
+ */
+static bool StartTimer( StressWriter_t* writer )
+{
+    struct sigaction action = { 0 };
+    struct sigevent event = { 0 };
+    struct itimerspec spec = { 0 };
+
+    action.sa_handler = OnSignal;
+    sigemptyset( &action.sa_mask );
+    sigaction( writer->Signal, &action, NULL );
+
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = writer->Signal;
+    if( timer_create( CLOCK_MONOTONIC, &event, &writer->Timer ) != 0 )
+    {
+        return false;
+    }
+    spec.it_value.tv_nsec = writer->Period;
+    spec.it_interval.tv_nsec = writer->Period;
+    return ( timer_settime( writer->Timer, 0, &spec, NULL ) == 0 ) ? true : false;
+}
+
+static void StopTimer( StressWriter_t* writer )
+{
+    timer_delete( writer->Timer );
+}
+
+/*!
+ * \brief Pops the recorded events and checks their order
+ */
+static void PopEvents( void )
+{
+    TracePointEvent_t event;
+
+    while( TracePointPopEvent( &event ) == 1 )
+    {
+        NbPopped++;
+        for( uint8_t i = 0; i < STRESS_NB_WRITERS; i++ )
+        {
+            if( event.Id != Writers[i].Id )
+            {
+                continue;
+            }
+            // Dropped events leave gaps, but the values keep increasing
+            if( event.Value <= LastPopped[i] )
+            {
+                NbOrderErrors++;
+            }
+            LastPopped[i] = event.Value;
+        }
+    }
+}
+
+/*!
+ * \brief Checks the statistics of a writer
+ *
+ * \param [IN] writer  Writer
+ * \param [IN] isExact Set when none of the writer records may be dropped
+ *
+ * \retval nbErrors Number of wrong fields
+ */
+static uint32_t CheckStats( const StressWriter_t* writer, bool isExact )
+{
+    const TracePointStats_t* stats = &TracePointGetStats( )[writer->Id];
+    uint64_t n = writer->NbRecords;
+    uint32_t nbErrors = 0;
+
+    printf( "%-10s %9lu records, %7lu preempting the main loop, count %lu\n", writer->Name,
+            ( unsigned long )writer->NbRecords, ( unsigned long )writer->NbPreemptions, ( unsigned long )stats->Count );
+    if( ( stats->Count > n ) || ( ( isExact == true ) && ( stats->Count != n ) ) )
+    {
+        printf( "  count %lu, expected %lu\n", ( unsigned long )stats->Count, ( unsigned long )n );
+        nbErrors++;
+    }
+    if( ( stats->Sum > ( ( n * ( n + 1 ) ) / 2 ) ) || ( ( isExact == true ) && ( stats->Sum != ( ( n * ( n + 1 ) ) / 2 ) ) ) )
+    {
+        printf( "  sum %llu, expected %llu\n", ( unsigned long long )stats->Sum, ( unsigned long long )( ( n * ( n + 1 ) ) / 2 ) );
+        nbErrors++;
+    }
+    if( ( stats->Count != 0 ) && ( ( stats->Min < 1 ) || ( stats->Max > n ) ||
+                                   ( ( isExact == true ) && ( ( stats->Min != 1 ) || ( stats->Max != n ) ) ) ) )
+    {
+        printf( "  min %lu, max %lu, expected 1, %lu\n", ( unsigned long )stats->Min, ( unsigned long )stats->Max, ( unsigned long )n );
+        nbErrors++;
+    }
+    return nbErrors;
+}
+
+int main( int argc, char* argv[] )
+{
+    uint32_t nbRecords = STRESS_NB_RECORDS;
+    uint32_t nbErrors = 0;
+    uint32_t nbPreemptions = 0;
+    uint32_t nbMissing = 0;
+
+    if( argc > 1 )
+    {
+        nbRecords = strtoul( argv[1], NULL, 0 );
+    }
+
+    TracePointInit( );
+    for( uint8_t i = 1; i < STRESS_NB_WRITERS; i++ )
+    {
+        if( StartTimer( &Writers[i] ) == false )
+        {
+            printf( "%s timer creation failed\n", Writers[i].Name );
+            return EXIT_FAILURE;
+        }
+    }
+
+    for( uint32_t i = 1; i <= nbRecords; i++ )
+    {
+        IsMainRecording = 1;
+        TracePointRecord( Writers[0].Id, i );
+        IsMainRecording = 0;
+        Writers[0].NbRecords = i;
+        // Keep the events ring empty, only the nesting levels may drop events
+        PopEvents( );
+    }
+
+    for( uint8_t i = 1; i < STRESS_NB_WRITERS; i++ )
+    {
+        StopTimer( &Writers[i] );
+        nbPreemptions += Writers[i].NbPreemptions;
+    }
+    PopEvents( );
+
+    // The main loop is never nested
+    for( uint8_t i = 0; i < STRESS_NB_WRITERS; i++ )
+    {
+        nbErrors += CheckStats( &Writers[i], ( i == 0 ) ? true : false );
+        nbMissing += Writers[i].NbRecords - TracePointGetStats( )[Writers[i].Id].Count;
+    }
+    printf( "%lu events popped, %lu dropped, %lu out of order\n", ( unsigned long )NbPopped,
+            ( unsigned long )TracePointGetDropped( ), ( unsigned long )NbOrderErrors );
+    if( nbMissing != TracePointGetDropped( ) )
+    {
+        printf( "%lu records missing from the statistics\n", ( unsigned long )nbMissing );
+        nbErrors++;
+    }
+    nbErrors += NbOrderErrors;
+    if( nbPreemptions == 0 )
+    {
+        printf( "The signals never preempted the main loop recording\n" );
+        nbErrors++;
+    }
+    return ( nbErrors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}